@@ -4,6 +4,7 @@
 
 #include "ComputePlan.h"
 #include "FilterExecutor.h"
+#include "FusedFilterExecutor.h"
 #include "HashOneExecutor.h"
 #include "FlattenExecutor.h"
 #include "AtomicComputationClasses.h"
@@ -11,6 +12,8 @@
 #include "JoinCompBase.h"
 #include "Lexer.h"
 #include "Parser.h"
+#include <algorithm>
+#include <set>
 
 extern int yydebug;
 
@@ -255,6 +258,105 @@ inline SinkShufflerPtr ComputePlan::getShuffler(std::string sourceTupleSetName,
 }
 
 
+// collects all of the lambdas in a lambda tree
+inline void collectLambdas(GenericLambdaObjectPtr root, std::set<GenericLambdaObject*>& lambdas) {
+    lambdas.insert(root.get());
+    for (int i = 0; i < root->getNumChildren(); i++) {
+        collectLambdas(root->getChild(i), lambdas);
+    }
+}
+
+inline ComputeExecutorPtr ComputePlan::fusePredicate(std::vector<AtomicComputationPtr>& comps,
+                                                     size_t start,
+                                                     TupleSpec& inputSchema,
+                                                     std::map<std::string, ComputeInfoPtr>& params,
+                                                     size_t& end) {
+
+    // find the applies of one computation, and the filter that follows them
+    std::string computationName = comps[start]->getComputationName();
+    size_t filterPos = start;
+    while ((filterPos < comps.size()) && (comps[filterPos]->getAtomicComputationType() == "Apply") &&
+           (comps[filterPos]->getComputationName() == computationName)) {
+        filterPos++;
+    }
+    if ((filterPos == start) || (filterPos == comps.size())) {
+        return nullptr;
+    }
+    AtomicComputationPtr filter = comps[filterPos];
+    if ((filter->getAtomicComputationType() != "Filter") ||
+        (filter->getComputationName() != computationName)) {
+        return nullptr;
+    }
+
+    // the filter must run on the result of the last apply, which is the root of the lambda tree
+    AtomicComputationPtr root = comps[filterPos - 1];
+    std::vector<std::string>& filterAtts = filter->getInput().getAtts();
+    std::vector<std::string>& rootAtts = root->getOutput().getAtts();
+    if ((filterAtts.size() != 1) || (rootAtts.size() == 0) || (filterAtts[0] != rootAtts.back())) {
+        return nullptr;
+    }
+
+    // a parameter is sent to the executor of one computation, so we don't fuse those
+    for (size_t i = start; i <= filterPos; i++) {
+        if (params.count(comps[i]->getOutput().getSetName()) > 0) {
+            return nullptr;
+        }
+    }
+
+    // the whole tree must be able to run on one object at a time
+    ComputationNode& node = myPlan->getNode(computationName);
+    GenericLambdaObjectPtr rootLambda =
+        node.getLambda(((ApplyLambda*)root.get())->getLambdaToApply());
+    SimpleFilterPtr predicate = rootLambda->getPredicate();
+    if (predicate == nullptr) {
+        return nullptr;
+    }
+
+    // every apply must be a lambda in the tree, and the leaves must all run on the same objects
+    std::set<GenericLambdaObject*> lambdasInTree;
+    collectLambdas(rootLambda, lambdasInTree);
+    std::string objectAtt;
+    for (size_t i = start; i < filterPos; i++) {
+        GenericLambdaObjectPtr lambda =
+            node.getLambda(((ApplyLambda*)comps[i].get())->getLambdaToApply());
+        if (lambdasInTree.count(lambda.get()) == 0) {
+            return nullptr;
+        }
+        if (lambda->getNumChildren() > 0) {
+            continue;
+        }
+        std::vector<std::string>& leafAtts = comps[i]->getInput().getAtts();
+        if ((leafAtts.size() != 1) || ((objectAtt != "") && (objectAtt != leafAtts[0]))) {
+            return nullptr;
+        }
+        objectAtt = leafAtts[0];
+    }
+    if (objectAtt == "") {
+        return nullptr;
+    }
+
+    // the objects, and all of the attributes kept by the filter, must come from the input, so
+    // that none of the results of the applies is needed after the filter
+    std::vector<std::string>& inputAtts = inputSchema.getAtts();
+    if (std::find(inputAtts.begin(), inputAtts.end(), objectAtt) == inputAtts.end()) {
+        return nullptr;
+    }
+    for (auto& att : filter->getProjection().getAtts()) {
+        if (std::find(inputAtts.begin(), inputAtts.end(), att) == inputAtts.end()) {
+            return nullptr;
+        }
+    }
+
+    end = filterPos;
+    AttList objectAttList;
+    objectAttList.appendAttribute((char*)objectAtt.c_str());
+    TupleSpec objectSpec(inputSchema.getSetName(), objectAttList);
+    std::cout << "Fused " << filterPos - start << " applies into the filter producing "
+              << filter->getOutput().getSetName() << std::endl;
+    return std::make_shared<FusedFilterExecutor>(
+        inputSchema, objectSpec, filter->getProjection(), predicate);
+}
+
 // JiaNote: add a new buildPipeline method to avoid ambiguity
 inline PipelinePtr ComputePlan::buildPipeline(int threadId,
 		                              std::vector<std::string> buildTheseTupleSets,
@@ -418,6 +520,7 @@ inline PipelinePtr ComputePlan::buildPipeline(int threadId,
     AtomicComputationPtr lastOne =
         myPlan->getComputations().getProducingAtomicComputation(buildTheseTupleSets[0]);
 
+    std::vector<AtomicComputationPtr> listSoFar;
     for (int i = 1; i < buildTheseTupleSets.size(); i++) {
 
 
@@ -429,6 +532,22 @@ inline PipelinePtr ComputePlan::buildPipeline(int threadId,
             std::cout << "ERROR: We can't get producing computation and stop building" << std::endl;
             return nullptr;
         }
+        listSoFar.push_back(a);
+    }
+
+    for (size_t i = 0; i < listSoFar.size(); i++) {
+
+        AtomicComputationPtr a = listSoFar[i];
+
+        // a selection predicate is run as one executor, if possible
+        size_t end;
+        ComputeExecutorPtr fused = fusePredicate(listSoFar, i, lastOne->getOutput(), params, end);
+        if (fused != nullptr) {
+            returnVal->addStage(fused);
+            i = end;
+            lastOne = listSoFar[end];
+            continue;
+        }
 
 
         // if we have a filter, then just go ahead and create it
@@ -725,7 +844,19 @@ inline PipelinePtr ComputePlan::buildPipeline(int threadId,
     // add the operations to the pipeline
     AtomicComputationPtr lastOne =
         myPlan->getComputations().getProducingAtomicComputation(sourceTupleSetName);
-    for (auto& a : listSoFar) {
+    for (size_t i = 0; i < listSoFar.size(); i++) {
+
+        AtomicComputationPtr a = listSoFar[i];
+
+        // a selection predicate is run as one executor, if possible
+        size_t end;
+        ComputeExecutorPtr fused = fusePredicate(listSoFar, i, lastOne->getOutput(), params, end);
+        if (fused != nullptr) {
+            returnVal->addStage(fused);
+            i = end;
+            lastOne = listSoFar[end];
+            continue;
+        }
 
         // if we have a filter, then just go ahead and create it
         if (a->getAtomicComputationType() == "Filter") {
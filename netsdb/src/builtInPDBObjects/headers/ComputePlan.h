@@ -126,6 +126,18 @@ public:
                               std::function<void(void*)> discardTempPage,
                               std::function<void(void*)> writeBackPage);
 
+    // this tries to fuse the selection predicate that starts at comps[start] into one executor:
+    // if comps[start], comps[start + 1], ... are the applies of one lambda tree over the objects
+    // in one attribute of inputSchema, followed by the filter on the result of the tree, this
+    // returns an executor that runs the whole tree on each object and then filters, and sets end
+    // to the position of the filter.  Otherwise it returns nullptr, and the computations are
+    // added to the pipeline one at a time
+    ComputeExecutorPtr fusePredicate(std::vector<AtomicComputationPtr>& comps,
+                                     size_t start,
+                                     TupleSpec& inputSchema,
+                                     std::map<std::string, ComputeInfoPtr>& params,
+                                     size_t& end);
+
 
     // JiaNote: add this to get sink merger
     SinkMergerPtr getMerger(std::string sourceTupleSetName,
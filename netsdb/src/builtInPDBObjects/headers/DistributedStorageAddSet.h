@@ -6,6 +6,7 @@
 #include "PDBString.h"
 #include "Computation.h"
 #include "LambdaIdentifier.h"
+#include "DataTypes.h"
 
 
 // PRELOAD %DistributedStorageAddSet%
@@ -30,7 +31,8 @@ public:
                              size_t desiredSize = 1,
                              bool isMRU = false,
 			     bool isSharedTensorBlockSet = false,
-			     bool isModelSet = false)
+			     bool isModelSet = false,
+                             PageCompressionType compressionType = NoPageCompression)
         : dataBase(dataBase), setName(setName), typeName(typeName), pageSize(pageSize), createdJobId(createdJobId) {
 
         this->dispatchComputation = dispatchComputation;
@@ -39,6 +41,7 @@ public:
         this->isMRU = isMRU;
         this->isSharedTensorBlockSet = isSharedTensorBlockSet;
 	this->isModelSet = isModelSet;
+        this->compressionType = compressionType;
     }
 
 
@@ -114,6 +117,14 @@ public:
         this->isModelSet = isThisModelSet;
     }
 
+    PageCompressionType getCompressionType() {
+        return this->compressionType;
+    }
+
+    void setCompressionType(PageCompressionType compressionType) {
+        this->compressionType = compressionType;
+    }
+
     ENABLE_DEEP_COPY
 
 private:
@@ -128,6 +139,7 @@ private:
     bool isMRU;
     bool isSharedTensorBlockSet;
     bool isModelSet;
+    PageCompressionType compressionType;
 };
 }
 
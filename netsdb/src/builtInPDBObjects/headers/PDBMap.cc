@@ -66,18 +66,26 @@ Map<KeyType, ValueType>::Map(uint32_t initSize) {
         initSize = 2;
     }
 
+    // the number of slots is a power of two, so round up to one
+    uint32_t numSlots = 2;
+    while (numSlots < initSize) {
+        numSlots *= 2;
+    }
+
     // this way, we'll allocate extra bytes on the end of the array
     MapRecordClass<KeyType, ValueType> temp;
     size_t size = temp.getObjSize();
 
-    myArray = makeObjectWithExtraStorage<PairArray<KeyType, ValueType>>(size * initSize, initSize);
+    myArray = makeObjectWithExtraStorage<PairArray<KeyType, ValueType>>(
+        PairArray<KeyType, ValueType>::getStorageSize(size, numSlots), numSlots);
 }
 
 template <class KeyType, class ValueType>
 Map<KeyType, ValueType>::Map() {
     MapRecordClass<KeyType, ValueType> temp;
     size_t size = temp.getObjSize();
-    myArray = makeObjectWithExtraStorage<PairArray<KeyType, ValueType>>(size * 2, 2);
+    myArray = makeObjectWithExtraStorage<PairArray<KeyType, ValueType>>(
+        PairArray<KeyType, ValueType>::getStorageSize(size, 2), 2);
 }
 
 template <class KeyType, class ValueType>
@@ -96,13 +104,12 @@ ValueType& Map<KeyType, ValueType>::operator[](const KeyType& which) {
     // JiaNote: each time we increase size only when key doesn't exist.
     // so that we can make sure usedSlot < maxSlots each time before we invoke[] for insertion
     // and for read-only data, we will not invoke doubleArray(), if we always invoke count() before
-    // invoke []
-    if (myArray->count(which) == 0) {
-        if (myArray->isOverFull()) {
-            Handle<PairArray<KeyType, ValueType>> temp = myArray->doubleArray();
-            std::cout << "doubled the size of PairArray" << std::endl;
-            myArray = temp;
-        }
+    // invoke []; the key is only looked up here if the array is full, since otherwise the
+    // lookup below does it
+    if (myArray->isOverFull() && myArray->count(which) == 0) {
+        Handle<PairArray<KeyType, ValueType>> temp = myArray->doubleArray();
+        std::cout << "doubled the size of PairArray" << std::endl;
+        myArray = temp;
     }
     ValueType& res = (*myArray)[which];
     return res;
@@ -9,6 +9,10 @@
 #include <iterator>
 #include <type_traits>
 #include <cstring>
+#include <cstdint>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 #include "Handle.h"
 #include "Object.h"
@@ -115,7 +119,13 @@ public:
 };
 
 // the maximum fill factor before we double
-#define FILL_FACTOR .667
+#define FILL_FACTOR .875
+
+// the number of control bytes that are compared at once
+#define CONTROL_GROUP_SIZE 16
+
+// the control byte of an empty slot; the control byte of a used slot is in [0, 127]
+#define CONTROL_EMPTY ((int8_t)-128)
 
 // access keys, hashes, and data in the underlying array
 #define GET_HASH(data, i) (*((size_t*)(((char*)data) + (i * objSize))))
@@ -125,6 +135,38 @@ public:
 #define GET_KEY(data, i, type) (*((type*)(((char*)data) + sizeof(size_t) + (i * objSize))))
 #define GET_VALUE(data, i, type) (*((type*)(((char*)data) + valueOffset + (i * objSize))))
 
+// access the control bytes, which come after the numSlots records
+#define GET_CONTROL_PTR(data) ((int8_t*)(((char*)data) + ((size_t)objSize) * numSlots))
+
+// mixes the bits of a hash, so that both the slot, which is given by the low bits, and the
+// control byte, which is given by the high bits, depend on all bits of the hash
+inline size_t mixPairArrayHash(size_t hashVal) {
+    uint64_t k = hashVal;
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+// returns a bit mask of the control bytes in controls[0, CONTROL_GROUP_SIZE) that are equal to
+// control
+inline uint32_t matchControlGroup(const int8_t* controls, int8_t control) {
+#ifdef __SSE2__
+    __m128i group = _mm_loadu_si128((const __m128i*)controls);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(control)));
+#else
+    uint32_t matches = 0;
+    for (int i = 0; i < CONTROL_GROUP_SIZE; i++) {
+        if (controls[i] == control) {
+            matches |= (1U << i);
+        }
+    }
+    return matches;
+#endif
+}
+
 // Note: we need to write all operations in constructors, destructors, and assignment operators
 // WITHOUT using
 // the underlying type in any way (including assignment, initialization, destruction, size).
@@ -141,6 +183,23 @@ bool PairArray<KeyType, ValueType>::isDestructorDisabled() {
     return this->disableDestructor;
 }
 
+template <class KeyType, class ValueType>
+size_t PairArray<KeyType, ValueType>::getStorageSize(uint32_t objSize, uint32_t numSlots) {
+    return ((size_t)objSize) * numSlots + numSlots + CONTROL_GROUP_SIZE;
+}
+
+template <class KeyType, class ValueType>
+void PairArray<KeyType, ValueType>::setControl(uint32_t slot, int8_t control) {
+
+    // the control bytes of the first CONTROL_GROUP_SIZE slots are copied after the last slot, so
+    // that a group that starts at any slot can be loaded at once; if there are fewer slots than
+    // that, they are copied more than once
+    int8_t* controls = GET_CONTROL_PTR(data);
+    controls[slot] = control;
+    for (uint32_t i = slot + numSlots; i < numSlots + CONTROL_GROUP_SIZE; i += numSlots) {
+        controls[i] = control;
+    }
+}
 
 template <class KeyType, class ValueType>
 void PairArray<KeyType, ValueType>::setUpAndCopyFrom(void* target, void* source) const {
@@ -165,10 +224,18 @@ void PairArray<KeyType, ValueType>::setUpAndCopyFrom(void* target, void* source)
     toMe.valueOffset = fromMe.valueOffset;
     toMe.maxSlots = fromMe.maxSlots;
 
+    // these are needed to make the GET_HASH and other macros work correctly... they refer
+    // to variables objSize, valueOffset and numSlots... this.objSize and this.valueOffset are
+    // possibly undefined here.  By having local variables that shadow these, we get around
+    // potential problems
+    uint32_t objSize = toMe.objSize;
+    uint32_t valueOffset = toMe.valueOffset;
+    uint32_t numSlots = toMe.numSlots;
+
     // now we need to copy the array
     // if our types are fully primitive, just do a memmove
     if (!toMe.keyTypeInfo.descendsFromObject() && !toMe.valueTypeInfo.descendsFromObject()) {
-        memmove((void*)toMe.data, (void*)fromMe.data, ((size_t)toMe.objSize) * (toMe.numSlots));
+        memmove((void*)toMe.data, (void*)fromMe.data, getStorageSize(objSize, numSlots));
         return;
     }
 
@@ -178,57 +245,46 @@ void PairArray<KeyType, ValueType>::setUpAndCopyFrom(void* target, void* source)
     uint32_t keySize = (toMe.valueOffset - sizeof(size_t));
     uint32_t valueSize = (toMe.objSize - toMe.valueOffset);
 
-    // these are needed to make the GET_HASH and other macros work correctly... they refer
-    // to variables objSize and valueOffset... this.objSize and this.valueOffset are possibly
-    // undefined here.  By having local variables that shadow these, we get around potential
-    // problems
-    uint32_t objSize = toMe.objSize;
-    uint32_t valueOffset = toMe.valueOffset;
+    // copy over the control bytes first, and mark the slots that are not copied yet as empty
+    // if we run out of space
+    int8_t* toControls = GET_CONTROL_PTR(toMe.data);
+    int8_t* fromControls = GET_CONTROL_PTR(fromMe.data);
+    memmove(toControls, fromControls, numSlots + CONTROL_GROUP_SIZE);
 
     // loop through and do the deep copy
-    for (int i = 0; i < toMe.numSlots; i++) {
-
-        // copy over the hash for this guy
-        GET_HASH(toMe.data, i) = GET_HASH(fromMe.data, i);
+    for (uint32_t i = 0; i < numSlots; i++) {
 
         // don't copy over an unused slot
-        if (GET_HASH(fromMe.data, i) == UNUSED)
+        if (fromControls[i] == CONTROL_EMPTY)
             continue;
 
-        // deal with the key... use memmove on a non-object type
-        if (!toMe.keyTypeInfo.descendsFromObject()) {
-            memmove(GET_KEY_PTR(toMe.data, i), GET_KEY_PTR(fromMe.data, i), keySize);
-        } else {
-            try {
+        // copy over the hash for this guy
+        GET_HASH(toMe.data, i) = GET_HASH(fromMe.data, i);
+
+        try {
+            // deal with the key... use memmove on a non-object type
+            if (!toMe.keyTypeInfo.descendsFromObject()) {
+                memmove(GET_KEY_PTR(toMe.data, i), GET_KEY_PTR(fromMe.data, i), keySize);
+            } else {
                 toMe.keyTypeInfo.setUpAndCopyFromConstituentObject(GET_KEY_PTR(toMe.data, i),
                                                                    GET_KEY_PTR(fromMe.data, i));
-            } catch (NotEnoughSpace& n) {
-                // JiaNote: if data type is a handle, it may trigger NotEnoughSpace exception, so
-                // handle this here.
-                for (int j = i; j < toMe.numSlots; j++) {
-                    GET_HASH(toMe.data, j) = UNUSED;
-                }
-                toMe.setDisableDestructor(true);
-                throw n;
             }
-        }
 
-        // and now same thing on the value
-        if (!toMe.valueTypeInfo.descendsFromObject()) {
-            memmove(GET_VALUE_PTR(toMe.data, i), GET_VALUE_PTR(fromMe.data, i), valueSize);
-        } else {
-            try {
-                toMe.valueTypeInfo.setUpAndCopyFromConstituentObject(GET_VALUE_PTR(toMe.data, i),
-                                                                     GET_VALUE_PTR(fromMe.data, i));
-            } catch (NotEnoughSpace& n) {
-                // JiaNote: if data type is a handle, it may trigger NotEnoughSpace exception, so
-                // handle this here.
-                for (int j = i; j < toMe.numSlots; j++) {
-                    GET_HASH(toMe.data, j) = UNUSED;
-                }
-                toMe.setDisableDestructor(true);
-                throw n;
+            // and now same thing on the value
+            if (!toMe.valueTypeInfo.descendsFromObject()) {
+                memmove(GET_VALUE_PTR(toMe.data, i), GET_VALUE_PTR(fromMe.data, i), valueSize);
+            } else {
+                toMe.valueTypeInfo.setUpAndCopyFromConstituentObject(
+                    GET_VALUE_PTR(toMe.data, i), GET_VALUE_PTR(fromMe.data, i));
+            }
+        } catch (NotEnoughSpace& n) {
+            // JiaNote: if data type is a handle, it may trigger NotEnoughSpace exception, so
+            // handle this here.
+            for (uint32_t j = i; j < numSlots; j++) {
+                toMe.setControl(j, CONTROL_EMPTY);
             }
+            toMe.setDisableDestructor(true);
+            throw n;
         }
     }
 }
@@ -240,93 +296,111 @@ PairArray<KeyType, ValueType>::PairArray(const PairArray& toMe) {
 }
 
 template <class KeyType, class ValueType>
-int PairArray<KeyType, ValueType>::count(const KeyType& me) {
-
-    // hash this dude
-    size_t hashVal = Hasher<KeyType>::hash(me);
+uint32_t PairArray<KeyType, ValueType>::findSlot(const KeyType& me, size_t hashVal, bool& found) {
 
-
-
-    // figure out which slot he goes in
-    size_t slot = hashVal % (numSlots - 1);
+    // the low bits of the mixed hash give the slot where we start, and the high seven bits
+    // give the control byte
+    size_t mixed = mixPairArrayHash(hashVal);
+    int8_t control = (int8_t)(mixed >> 57);
+    uint32_t mask = numSlots - 1;
+    uint32_t slot = mixed & mask;
+    int8_t* controls = GET_CONTROL_PTR(data);
 
     // in the worst case, we can loop through the entire hash table looking.  :-(
-    for (size_t slotsChecked = 0; slotsChecked < numSlots; slotsChecked++) {
+    for (uint32_t slotsChecked = 0; slotsChecked < numSlots; slotsChecked += CONTROL_GROUP_SIZE) {
 
-        // if we found an empty slot, then this guy was not here
-        if (GET_HASH(data, slot) == UNUSED) {
-            return 0;
-        } else if (GET_HASH(data, slot) == hashVal) {
+        // the keys are probed in order, so the key is not after the first empty slot
+        uint32_t empties = matchControlGroup(controls + slot, CONTROL_EMPTY);
+        uint32_t matches = matchControlGroup(controls + slot, control);
+        if (empties != 0) {
+            matches &= (empties & (~empties + 1)) - 1;
+        }
 
-            // potential match!!
-            if (GET_KEY(data, slot, KeyType) == me) {
-                return 1;
+        // check the keys whose control byte matches
+        while (matches != 0) {
+            uint32_t matchSlot = (slot + __builtin_ctz(matches)) & mask;
+            if (GET_HASH(data, matchSlot) == hashVal && GET_KEY(data, matchSlot, KeyType) == me) {
+                found = true;
+                return matchSlot;
             }
+            matches &= matches - 1;
         }
 
-        // if we made it here, then it means that we found a non-empty slot, but no
-        // match... so we simply loop to the next iteration... if slot == (numSlots-1), it
-        // means we've made it to the end of the hash table... go to the beginning
-        if (slot == numSlots - 1)
-            slot = 0;
+        // if we found an empty slot, then this guy was not here
+        if (empties != 0) {
+            found = false;
+            return (slot + __builtin_ctz(empties)) & mask;
+        }
 
-        // otherwise, just go to the next slot
-        else
-            slot++;
+        // otherwise, go to the next group
+        slot = (slot + CONTROL_GROUP_SIZE) & mask;
     }
 
-    // we should never reach here
-    std::cout << "in count(): hashVal = " << hashVal << ", slot = " << slot
-              << ", numSlots =" << numSlots << ". Warning: Ran off the end of the hash table!!\n";
-    return 0;
+    found = false;
+    return numSlots;
 }
 
 template <class KeyType, class ValueType>
-void PairArray<KeyType, ValueType>::setUnused(const KeyType& me) {
-
-    // hash this dude
-    size_t hashVal = Hasher<KeyType>::hash(me);
+int PairArray<KeyType, ValueType>::count(const KeyType& me) {
 
-    // figure out which slot he goes in
-    size_t slot = hashVal % (numSlots - 1);
+    bool found;
+    uint32_t slot = findSlot(me, Hasher<KeyType>::hash(me), found);
+    if (found) {
+        return 1;
+    }
+    if (slot == numSlots) {
+        // we should never reach here
+        std::cout << "in count(): numSlots =" << numSlots
+                  << ". Warning: Ran off the end of the hash table!!\n";
+    }
+    return 0;
+}
 
-    // in the worst case, we can loop through the entire hash table looking.  :-(
-    for (size_t slotsChecked = 0; slotsChecked < numSlots; slotsChecked++) {
+template <class KeyType, class ValueType>
+void PairArray<KeyType, ValueType>::moveSlot(uint32_t from, uint32_t to) {
+
+    // the key and the value are copy constructed, which keeps the storage of a String or of the
+    // target of a Handle where it is, and the old ones are deleted
+    GET_HASH(data, to) = GET_HASH(data, from);
+    new (GET_KEY_PTR(data, to)) KeyType(GET_KEY(data, from, KeyType));
+    new (GET_VALUE_PTR(data, to)) ValueType(GET_VALUE(data, from, ValueType));
+    GET_KEY(data, from, KeyType).~KeyType();
+    GET_VALUE(data, from, ValueType).~ValueType();
+    setControl(to, GET_CONTROL_PTR(data)[from]);
+}
 
-        // if we found an empty slot, then this guy was not here
-        if (GET_HASH(data, slot) == UNUSED) {
-            std::cout << "WARNING: setUnused for an empty slot" << std::endl;
-            return;
+template <class KeyType, class ValueType>
+void PairArray<KeyType, ValueType>::setUnused(const KeyType& me) {
 
-            // found a non-empty slot; check for a match
-        } else if (GET_HASH(data, slot) == hashVal) {
+    bool found;
+    uint32_t slot = findSlot(me, Hasher<KeyType>::hash(me), found);
 
-            // potential match!!
-            if (GET_KEY(data, slot, KeyType) == me) {
+    // if we did not find him, then this guy was not here
+    if (!found) {
+        std::cout << "WARNING: setUnused for an empty slot" << std::endl;
+        return;
+    }
 
-                // destruct those guys
-                ((KeyType*)(GET_KEY_PTR(data, slot)))->~KeyType();
-                ((ValueType*)(GET_VALUE_PTR(data, slot)))->~ValueType();
-                GET_HASH(data, slot) = UNUSED;
-                return;
-            }
+    // destruct those guys
+    ((KeyType*)(GET_KEY_PTR(data, slot)))->~KeyType();
+    ((ValueType*)(GET_VALUE_PTR(data, slot)))->~ValueType();
+    usedSlots--;
+
+    // now, there is a hole at slot... move back each of the following keys that can be found
+    // from the hole, up to the next empty slot, so that no key is after an empty slot in its
+    // probe sequence; the key added last is never moved, since it went to the first empty slot
+    uint32_t mask = numSlots - 1;
+    int8_t* controls = GET_CONTROL_PTR(data);
+    uint32_t hole = slot;
+    for (uint32_t next = (hole + 1) & mask; controls[next] != CONTROL_EMPTY;
+         next = (next + 1) & mask) {
+        uint32_t home = mixPairArrayHash(GET_HASH(data, next)) & mask;
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            moveSlot(next, hole);
+            hole = next;
         }
-
-        // if we made it here, then it means that we found a non-empty slot, but no
-        // match... so we simply loop to the next iteration... if slot == numSlots - 1, it
-        // means we've made it to the end of the hash table... go to the beginning
-        if (slot == numSlots - 1)
-            slot = 0;
-
-        // otherwise, just go to the next slot
-        else
-            slot++;
     }
-
-    // we should never reach here
-    std::cout << "in setUnused(): hashVal = " << hashVal << ", slot = " << slot
-              << ", numSlots =" << numSlots << ". Warning: Ran off the end of the hash table!!\n";
-    // exit (1);
+    setControl(hole, CONTROL_EMPTY);
 }
 
 
@@ -339,98 +413,67 @@ ValueType& PairArray<KeyType, ValueType>::operator[](const KeyType& me) {
     // hash this dude
     size_t hashVal = Hasher<KeyType>::hash(me);
 
-    // figure out which slot he goes in
-    size_t slot = hashVal % (numSlots - 1);
-
-    // in the worst case, we can loop through the entire hash table looking.  :-(
-    for (size_t slotsChecked = 0; slotsChecked < numSlots; slotsChecked++) {
-
-        // if we found an empty slot, then this guy was not here
-        if (GET_HASH(data, slot) == UNUSED) {
-            try {
-                // construct the key and the value
-                new (GET_KEY_PTR(data, slot)) KeyType();
-                new (GET_VALUE_PTR(data, slot)) ValueType();
-            } catch (NotEnoughSpace& n) {
-                std::cout << "Not enough space when in placement new the key type and value type"
-                          << std::endl;
-                throw n;
-            }
-
-
-            // add the key
-            try {
-                GET_KEY(data, slot, KeyType) = me;
-
-                GET_HASH(data, slot) = hashVal;
-
-                // increment the number of used slots
-                usedSlots++;
-
-            } catch (NotEnoughSpace& n) {
-                throw n;
-            }
-
-            // and return the value
-            return GET_VALUE(data, slot, ValueType);
+    bool found;
+    uint32_t slot = findSlot(me, hashVal, found);
 
-            // found a non-empty slot; check for a match
-        } else if (GET_HASH(data, slot) == hashVal) {
+    // match!!
+    if (found) {
+        return GET_VALUE(data, slot, ValueType);
+    }
 
-            // potential match!!
-            if (GET_KEY(data, slot, KeyType) == me) {
+    // we should never reach here
+    if (slot == numSlots) {
+        std::cout << "Fatal Error: Ran off the end of the hash table!!\n";
+        exit(1);
+    }
 
-                // match!!
-                return GET_VALUE(data, slot, ValueType);
-            }
-        }
+    // we found an empty slot, so this guy was not here
+    try {
+        // construct the key and the value
+        new (GET_KEY_PTR(data, slot)) KeyType();
+        new (GET_VALUE_PTR(data, slot)) ValueType();
+    } catch (NotEnoughSpace& n) {
+        std::cout << "Not enough space when in placement new the key type and value type"
+                  << std::endl;
+        throw n;
+    }
 
-        // if we made it here, then it means that we found a non-empty slot, but no
-        // match... so we simply loop to the next iteration... if slot == numSlots - 1, it
-        // means we've made it to the end of the hash table... go to the beginning
-        if (slot == numSlots - 1)
-            slot = 0;
+    // add the key
+    GET_KEY(data, slot, KeyType) = me;
+    GET_HASH(data, slot) = hashVal;
+    setControl(slot, (int8_t)(mixPairArrayHash(hashVal) >> 57));
 
-        // otherwise, just go to the next slot
-        else
-            slot++;
-    }
+    // increment the number of used slots
+    usedSlots++;
 
-    // we should never reach here
-    std::cout << "Fatal Error: Ran off the end of the hash table!!\n";
-    exit(1);
+    // and return the value
+    return GET_VALUE(data, slot, ValueType);
 }
 
 template <class KeyType, class ValueType>
 PairArray<KeyType, ValueType>::PairArray(uint32_t numSlotsIn) : PairArray() {
-    // verify that we are a power of two
-    bool gotIt = false;
-    uint32_t val = 1;
-    for (unsigned int pow = 0; pow <= 31; pow++) {
-        if (val >= numSlotsIn) {
-            gotIt = true;
-            break;
-        }
-        val *= 2;
-    }
-
     setDisableDestructor(false);
 
-    // if we are not a power of two, exit
-    if (!gotIt) {
+    // if we do not have room for two slots, exit
+    if (numSlotsIn < 2) {
         std::cout << "Fatal Error: Bad: could not get the correct size  " << numSlotsIn
                   << " for the array\n";
         exit(1);
     }
 
+    // the number of slots must be a power of two, so round down to one; the storage at the end
+    // is always large enough for that many slots
+    uint32_t val = 2;
+    while (val <= numSlotsIn / 2) {
+        val *= 2;
+    }
+
     // remember the size
-    numSlots = numSlotsIn;
-    maxSlots = numSlotsIn * FILL_FACTOR;
+    numSlots = val;
+    maxSlots = numSlots * FILL_FACTOR;
 
     // set everyone to unused
-    for (int i = 0; i < numSlots; i++) {
-        GET_HASH(data, i) = UNUSED;
-    }
+    memset(GET_CONTROL_PTR(data), CONTROL_EMPTY, numSlots + CONTROL_GROUP_SIZE);
 }
 
 template <class KeyType, class ValueType>
@@ -475,8 +518,9 @@ PairArray<KeyType, ValueType>::~PairArray() {
         return;
 
     // now, delete each of the objects in there, if we have got an object type
+    int8_t* controls = GET_CONTROL_PTR(data);
     for (uint32_t i = 0; i < numSlots; i++) {
-        if (GET_HASH(data, i) != UNUSED) {
+        if (controls[i] != CONTROL_EMPTY) {
             if (keyTypeInfo.descendsFromObject())
                 keyTypeInfo.deleteConstituentObject(GET_KEY_PTR(data, i));
             if (valueTypeInfo.descendsFromObject())
@@ -492,24 +536,48 @@ Handle<PairArray<KeyType, ValueType>> PairArray<KeyType, ValueType>::doubleArray
 
     // allocate the new Array
     Handle<PairArray<KeyType, ValueType>> tempArray =
-        makeObjectWithExtraStorage<PairArray<KeyType, ValueType>>(objSize * howMany, howMany);
-    // first, set everything to unused
-    // now, re-hash everything
+        makeObjectWithExtraStorage<PairArray<KeyType, ValueType>>(
+            getStorageSize(objSize, howMany), howMany);
     PairArray<KeyType, ValueType>& newOne = *tempArray;
 
+    // now, move everything over; the hashes are stored, so the keys are not hashed again, and
+    // each key goes to the first empty slot from the slot given by its hash
+    int8_t* controls = GET_CONTROL_PTR(data);
+    int8_t* newControls = (int8_t*)(((char*)newOne.data) + ((size_t)objSize) * howMany);
+    uint32_t newMask = howMany - 1;
     for (uint32_t i = 0; i < numSlots; i++) {
 
-        if (GET_HASH(data, i) != UNUSED) {
+        if (controls[i] != CONTROL_EMPTY) {
+
+            uint32_t newSlot = mixPairArrayHash(GET_HASH(data, i)) & newMask;
+            while (newControls[newSlot] != CONTROL_EMPTY) {
+                newSlot = (newSlot + 1) & newMask;
+            }
 
-            // copy the dude over
-            newOne[GET_KEY(data, i, KeyType)] = GET_VALUE(data, i, ValueType);
+            // copy the dude over; if we run out of space, the new array deletes the ones
+            // already copied, and we are left as we were
+            GET_HASH(newOne.data, newSlot) = GET_HASH(data, i);
+            new (GET_KEY_PTR(newOne.data, newSlot)) KeyType(GET_KEY(data, i, KeyType));
+            try {
+                new (GET_VALUE_PTR(newOne.data, newSlot)) ValueType(GET_VALUE(data, i, ValueType));
+            } catch (NotEnoughSpace& n) {
+                GET_KEY(newOne.data, newSlot, KeyType).~KeyType();
+                throw n;
+            }
+            newOne.setControl(newSlot, controls[i]);
+            newOne.usedSlots++;
+        }
+    }
 
-            // and delete the old one
+    // and delete the old ones
+    for (uint32_t i = 0; i < numSlots; i++) {
+        if (controls[i] != CONTROL_EMPTY) {
             GET_KEY(data, i, KeyType).~KeyType();
             GET_VALUE(data, i, ValueType).~ValueType();
-            GET_HASH(data, i) = UNUSED;
+            setControl(i, CONTROL_EMPTY);
         }
     }
+    usedSlots = 0;
 
     // and return this guy
     return tempArray;
@@ -528,7 +596,7 @@ void PairArray<KeyType, ValueType>::deleteObject(void* deleteMe) {
 template <class KeyType, class ValueType>
 size_t PairArray<KeyType, ValueType>::getSize(void* forMe) {
     PairArray<KeyType, ValueType>& target = *((PairArray<KeyType, ValueType>*)forMe);
-    return sizeof(PairArray<Nothing>) + target.objSize * target.numSlots;
+    return sizeof(PairArray<Nothing>) + getStorageSize(target.objSize, target.numSlots);
 }
 
 template <class KeyType, class ValueType>
@@ -537,8 +605,10 @@ PDBMapIterator<KeyType, ValueType>::PDBMapIterator(
     : iterateMe(iterateMeIn) {
     slot = 0;
     done = false;
-    int objSize = iterateMe->objSize;
-    while (slot != iterateMe->numSlots && GET_HASH(iterateMe->data, slot) == UNUSED)
+    uint32_t objSize = iterateMe->objSize;
+    uint32_t numSlots = iterateMe->numSlots;
+    int8_t* controls = GET_CONTROL_PTR(iterateMe->data);
+    while (slot != numSlots && controls[slot] == CONTROL_EMPTY)
         slot++;
 
     if (slot == iterateMe->numSlots)
@@ -557,8 +627,10 @@ void PDBMapIterator<KeyType, ValueType>::operator++() {
     if (!done)
         slot++;
 
-    int objSize = iterateMe->objSize;
-    while (slot != iterateMe->numSlots && GET_HASH(iterateMe->data, slot) == UNUSED)
+    uint32_t objSize = iterateMe->objSize;
+    uint32_t numSlots = iterateMe->numSlots;
+    int8_t* controls = GET_CONTROL_PTR(iterateMe->data);
+    while (slot != numSlots && controls[slot] == CONTROL_EMPTY)
         slot++;
 
     if (slot == iterateMe->numSlots)
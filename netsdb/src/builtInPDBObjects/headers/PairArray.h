@@ -41,13 +41,14 @@ private:
     bool done;
 };
 
-// The Array type is the one type that we allow to be variable length.  This is accomplished
-// the the data[] array at the end of the class.  When an Array object is alllocated, it is
-// always allocated with some extra space at the end of the class to allow this array to
-// be used.
-//
-// Since the array class can be variable length, it is used as the key building block for
-// both the Vector and String classes.
+// The PairArray is the hash table behind pdb :: Map.  It is laid out as a Swiss table: the
+// (hash, KeyType, ValueType) records are stored in a power-of-two number of slots, followed by
+// one control byte for each slot, which is either empty or holds seven bits of the hash of the
+// key in the slot.  A lookup compares the control bytes of 16 slots at a time with the bits of
+// the hash it looks for, and only compares the keys of the slots that match.  Keys are found by
+// linear probing from the slot given by the hash, and a removed key is filled by moving back the
+// keys after it, so that there are no tombstones.  Everything is stored in the data[] array at
+// the end of the class, so that a PairArray can be moved to another page as it is.
 
 template <class KeyType, class ValueType = Nothing>
 class PairArray : public Object {
@@ -65,6 +66,10 @@ public:
     void deleteObject(void* deleteMe);
     size_t getSize(void* forMe);
 
+    // the number of bytes to allocate at the end of a PairArray with numSlots slots, each of
+    // which stores a record of objSize bytes
+    static size_t getStorageSize(uint32_t objSize, uint32_t numSlots);
+
 private:
     // and this gives us our info about TypeContained
     PDBTemplateBase keyTypeInfo;
@@ -85,12 +90,21 @@ private:
     // the max number of slots before doubling
     uint32_t maxSlots;
 
-    // the array of data
+    // delete flag to avoid to run destructor if the flag is set to true
+    bool disableDestructor;
+
+    // the array of data: numSlots records, followed by numSlots + CONTROL_GROUP_SIZE control bytes
     Nothing data[0];
 
+    // returns the slot of the key me with the hash hashVal and sets found to true if it is there;
+    // otherwise, returns the empty slot where it goes, or numSlots if there is no empty slot
+    uint32_t findSlot(const KeyType& me, size_t hashVal, bool& found);
 
-    // delete flag to avoid to run destructor if the flag is set to true
-    bool disableDestructor;
+    // sets the control byte of a slot, and its copy after the last slot
+    void setControl(uint32_t slot, int8_t control);
+
+    // moves the record in one slot to an empty slot
+    void moveSlot(uint32_t from, uint32_t to);
 
 public:
     // create a new PairArray via doubling
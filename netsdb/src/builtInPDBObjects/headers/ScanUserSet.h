@@ -109,7 +109,9 @@ public:
                 }
             },
 
-            this->batchSize
+            this->batchSize,
+
+            true
 
             );
         } else {
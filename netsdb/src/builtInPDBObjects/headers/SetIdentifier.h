@@ -6,6 +6,7 @@
 #include "Object.h"
 #include "Handle.h"
 #include "PDBString.h"
+#include "PDBVector.h"
 #include "DataTypes.h"
 
 // PRELOAD %SetIdentifier%
@@ -103,6 +104,16 @@ public:
         return this->pageSize;
     }
 
+    void setNumStoredBytes(size_t numStoredBytes) {
+        this->numStoredBytes = numStoredBytes;
+    }
+
+    // the number of bytes used by the set on disk, which is smaller than numPages * pageSize if
+    // the set is compressed
+    size_t getNumStoredBytes() {
+        return this->numStoredBytes;
+    }
+
     void setIndexInInputs (int indexInInputs) {
         this->indexInInputs = indexInInputs;
     }
@@ -127,6 +138,14 @@ public:
         return this->numHashKeys;
     }
 
+    void setJoinFilter (Handle<Vector<unsigned int>> joinFilter) {
+        this->joinFilter = joinFilter;
+    }
+
+    Handle<Vector<unsigned int>> getJoinFilter () {
+        return this->joinFilter;
+    }
+
     void setDesiredSize (size_t desiredSize) {
         this->desiredSize = desiredSize;
     }
@@ -154,8 +173,10 @@ private:
     bool isAggregationResultOrNot;
     size_t numPages;
     size_t pageSize;
+    size_t numStoredBytes = 0;
     int indexInInputs = 0;
     int numHashKeys = 0;
+    Handle<Vector<unsigned int>> joinFilter = nullptr;
     String dataType;
     size_t desiredSize;
 };
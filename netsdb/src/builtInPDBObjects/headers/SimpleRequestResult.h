@@ -5,6 +5,7 @@
 #include "Object.h"
 #include "Handle.h"
 #include "PDBString.h"
+#include "PDBVector.h"
 #include <utility>
 
 // PRELOAD %SimpleRequestResult%
@@ -31,6 +32,15 @@ public:
         return numHashKeys;
     }
 
+    // the words of the Bloom filter over the join hashes built by a join build stage
+    void setJoinFilter(Handle<Vector<unsigned int>> joinFilter) {
+        this->joinFilter = joinFilter;
+    }
+
+    Handle<Vector<unsigned int>> getJoinFilter() {
+        return joinFilter;
+    }
+
     std::pair<bool, std::string> getRes() {
         return std::make_pair(res, errMsg);
     }
@@ -39,6 +49,7 @@ private:
     bool res;
     String errMsg;
     int numHashKeys = 0;
+    Handle<Vector<unsigned int>> joinFilter = nullptr;
 };
 }
 
@@ -5,6 +5,7 @@
 #include "Object.h"
 #include "Handle.h"
 #include "PDBString.h"
+#include "DataTypes.h"
 
 // PRELOAD %StorageAddData%
 
@@ -81,6 +82,21 @@ public:
         return directPutOrNot;
     }
 
+    // the codec that the bytes after this request are compressed with, and their size before
+    // compression, which is 0 if it is not known (Snappy keeps it in the bytes)
+    void setCompression(PageCompressionType compressionType, size_t uncompressedSize) {
+        this->compressionType = compressionType;
+        this->uncompressedSize = uncompressedSize;
+    }
+
+    PageCompressionType getCompressionType() {
+        return (PageCompressionType)compressionType;
+    }
+
+    size_t getUncompressedSize() {
+        return uncompressedSize;
+    }
+
     ENABLE_DEEP_COPY
 
 private:
@@ -92,6 +108,9 @@ private:
     bool flushOrNot;
     bool compressedOrNot;
     bool directPutOrNot;
+    // the bytes of a request that is not compressed are objects, not bytes
+    int compressionType = SnappyPageCompression;
+    size_t uncompressedSize = 0;
 };
 }
 
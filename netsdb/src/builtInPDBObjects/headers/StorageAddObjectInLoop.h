@@ -5,6 +5,7 @@
 #include "Object.h"
 #include "Handle.h"
 #include "PDBString.h"
+#include "DataTypes.h"
 
 // PRELOAD %StorageAddObjectInLoop%
 
@@ -70,6 +71,21 @@ public:
         return loopEnded;
     }
 
+    // the codec that the bytes after this request are compressed with, and their size before
+    // compression, which is 0 if it is not known (Snappy keeps it in the bytes)
+    void setCompression(PageCompressionType compressionType, size_t uncompressedSize) {
+        this->compressionType = compressionType;
+        this->uncompressedSize = uncompressedSize;
+    }
+
+    PageCompressionType getCompressionType() {
+        return (PageCompressionType)compressionType;
+    }
+
+    size_t getUncompressedSize() {
+        return uncompressedSize;
+    }
+
     ENABLE_DEEP_COPY
 
 private:
@@ -79,6 +95,12 @@ private:
     int typeID;
     bool typeCheck;
     bool loopEnded = false;
+#ifdef ENABLE_COMPRESSION
+    int compressionType = SnappyPageCompression;
+#else
+    int compressionType = NoPageCompression;
+#endif
+    size_t uncompressedSize = 0;
 };
 }
 
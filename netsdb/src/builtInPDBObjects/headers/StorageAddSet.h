@@ -6,6 +6,7 @@
 #include "Handle.h"
 #include "PDBString.h"
 #include "Configuration.h"
+#include "DataTypes.h"
 
 // PRELOAD %StorageAddSet%
 
@@ -25,8 +26,9 @@ public:
                   size_t desiredSize = 1,
                   bool isMRU = true,
                   bool isTransient = true,
-		  bool isSharedTensorBlockSet = false)
-        : dataBase(dataBase), setName(setName), typeName(typeName), pageSize(pageSize), desiredSize(desiredSize), isMRU(isMRU), isTransient(isTransient), isSharedTensorBlockSet(isSharedTensorBlockSet) {}
+		  bool isSharedTensorBlockSet = false,
+                  PageCompressionType compressionType = NoPageCompression)
+        : dataBase(dataBase), setName(setName), typeName(typeName), pageSize(pageSize), desiredSize(desiredSize), isMRU(isMRU), isTransient(isTransient), isSharedTensorBlockSet(isSharedTensorBlockSet), compressionType(compressionType) {}
 
     std::string getDatabase() {
         return dataBase;
@@ -64,6 +66,14 @@ public:
         this->isSharedTensorBlockSet = isSharedTensorBlockSet;
     }
 
+    PageCompressionType getCompressionType() {
+        return this->compressionType;
+    }
+
+    void setCompressionType(PageCompressionType compressionType) {
+        this->compressionType = compressionType;
+    }
+
     ENABLE_DEEP_COPY
 
 private:
@@ -75,6 +85,7 @@ private:
     bool isMRU;
     bool isTransient;
     bool isSharedTensorBlockSet;
+    PageCompressionType compressionType;
 };
 }
 
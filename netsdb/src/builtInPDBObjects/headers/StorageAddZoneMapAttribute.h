@@ -0,0 +1,69 @@
+#ifndef STORAGE_ADD_ZONE_MAP_ATTRIBUTE_H
+#define STORAGE_ADD_ZONE_MAP_ATTRIBUTE_H
+
+#include "Object.h"
+#include "Handle.h"
+#include "PDBString.h"
+#include "DataTypes.h"
+
+// PRELOAD %StorageAddZoneMapAttribute%
+
+namespace pdb {
+
+// encapsulates a request to declare an attribute of a set to summarize in per-page zone maps
+class StorageAddZoneMapAttribute : public Object {
+
+public:
+    StorageAddZoneMapAttribute() {}
+    ~StorageAddZoneMapAttribute() {}
+
+    StorageAddZoneMapAttribute(std::string dataBase,
+                               std::string setName,
+                               std::string attributeName,
+                               size_t byteOffset,
+                               ZoneMapAttributeType attributeType,
+                               bool columnar)
+        : dataBase(dataBase),
+          setName(setName),
+          attributeName(attributeName),
+          byteOffset(byteOffset),
+          attributeType(attributeType),
+          columnar(columnar) {}
+
+    std::string getDatabase() {
+        return dataBase;
+    }
+
+    std::string getSetName() {
+        return setName;
+    }
+
+    std::string getAttributeName() {
+        return attributeName;
+    }
+
+    size_t getByteOffset() {
+        return byteOffset;
+    }
+
+    ZoneMapAttributeType getAttributeType() {
+        return attributeType;
+    }
+
+    bool isColumnar() {
+        return columnar;
+    }
+
+    ENABLE_DEEP_COPY
+
+private:
+    String dataBase;
+    String setName;
+    String attributeName;
+    size_t byteOffset;
+    ZoneMapAttributeType attributeType;
+    bool columnar;
+};
+}
+
+#endif
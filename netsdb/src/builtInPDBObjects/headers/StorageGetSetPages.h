@@ -4,6 +4,7 @@
 
 #include "Object.h"
 #include "DataTypes.h"
+#include "PDBString.h"
 
 //  PRELOAD %StorageGetSetPages%
 
@@ -13,7 +14,9 @@ class StorageGetSetPages : public pdb::Object {
 
 
 public:
-    StorageGetSetPages() {}
+    StorageGetSetPages() {
+        this->zoneMapPredicateOn = false;
+    }
     ~StorageGetSetPages() {}
     // get/set node Id
     NodeID getNodeID() {
@@ -47,6 +50,27 @@ public:
         this->setId = setId;
     }
 
+    // get/set the zone map predicate "attribute op value", so that pages whose zone maps can't
+    // satisfy it are skipped without loading them
+    bool hasZoneMapPredicate() {
+        return this->zoneMapPredicateOn;
+    }
+    void setZoneMapPredicate(std::string attributeName, ZoneMapComparisonOp op, double value) {
+        this->zoneMapPredicateOn = true;
+        this->zoneMapAttribute = attributeName;
+        this->zoneMapOp = op;
+        this->zoneMapValue = value;
+    }
+    std::string getZoneMapAttribute() {
+        return this->zoneMapAttribute;
+    }
+    ZoneMapComparisonOp getZoneMapOp() {
+        return this->zoneMapOp;
+    }
+    double getZoneMapValue() {
+        return this->zoneMapValue;
+    }
+
     ENABLE_DEEP_COPY
 
 
@@ -55,6 +79,10 @@ private:
     DatabaseID dbId;
     UserTypeID userTypeId;
     SetID setId;
+    bool zoneMapPredicateOn;
+    String zoneMapAttribute;
+    ZoneMapComparisonOp zoneMapOp;
+    double zoneMapValue;
 };
 }
 
@@ -309,6 +309,25 @@ public:
         this->partitionLambdaName = partitionLambdaName;
     }
 
+    // the hash set that is built from the other side of the join that this stage repartitions
+    // for, whose Bloom filter the scheduler ships with this stage
+    std::string getJoinFilterHashSetName() {
+        return this->joinFilterHashSetName;
+    }
+
+    void setJoinFilterHashSetName(std::string joinFilterHashSetName) {
+        this->joinFilterHashSetName = joinFilterHashSetName;
+    }
+
+    // the words of the Bloom filter over the join hashes of the other side, or nullptr
+    Handle<Vector<unsigned int>> getJoinFilter() {
+        return this->joinFilter;
+    }
+
+    void setJoinFilter(Handle<Vector<unsigned int>> joinFilter) {
+        this->joinFilter = joinFilter;
+    }
+
     void print() override {
 
         std::cout << "[JOB ID] jobId=" << jobId << std::endl;
@@ -331,6 +350,9 @@ public:
                   << this->partitionLambdaName << std::endl;
 	std::cout << "[JOINTYPE] joinType="
 		  << this->joinTypeStr << std::endl;
+        std::cout << "[JOIN FILTER] joinFilterHashSetName=" << this->joinFilterHashSetName
+                  << ", numWords=" << ((joinFilter == nullptr) ? 0 : joinFilter->size())
+                  << std::endl;
 
         if (buildTheseTupleSets != nullptr) {
             std::cout << "[PIPELINE]" << std::endl;
@@ -604,6 +626,12 @@ private:
 
     String joinTypeStr = "Unknown";
 
+    // the hash set whose Bloom filter is applied before repartitioning
+    String joinFilterHashSetName;
+
+    // the words of that Bloom filter
+    Handle<Vector<unsigned int>> joinFilter = nullptr;
+
 };
 }
 
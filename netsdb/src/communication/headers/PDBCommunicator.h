@@ -15,6 +15,7 @@
 #include "PDBLogger.h"
 #include <stdlib.h>
 #include <cstring>
+#include <vector>
 
 // This class the encoding/decoding of IPC sockets messages in PDB
 namespace pdb {
@@ -90,6 +91,11 @@ public:
 
     bool reconnect(std::string& errMsg);
 
+    // gives this the next message, whose type, size and bytes were read from the socket already
+    // (by a PDBConnectionReactor), so that the next reads return it instead of reading the socket;
+    // bytes are the bytes after the size, and are taken over by this
+    void setNextMessage(int16_t typeID, size_t size, std::vector<char>& bytes);
+
 private:
     // write from start to end to the output socket
     bool doTheWrite(char* start, char* end);
@@ -113,6 +119,10 @@ private:
     // record the type of the next object
     int16_t nextTypeID;
 
+    // the bytes of the next message, if they were read from the socket already
+    std::vector<char> nextMessageBytes;
+    bool hasNextMessageBytes;
+
     // This is for automatic connection tear-down.
     // Moved this logic from Chris' message-based communication framework to here.
     bool needToSendDisconnectMsg;
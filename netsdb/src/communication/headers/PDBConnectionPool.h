@@ -0,0 +1,126 @@
+#ifndef PDB_CONNECTION_POOL_H
+#define PDB_CONNECTION_POOL_H
+
+#include <pthread.h>
+#include <time.h>
+#include <deque>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "PDBCommunicator.h"
+#include "PDBLogger.h"
+
+// whether the connections of simple requests and of job stages are kept open after a request, so
+// that the next request to the same server reuses them, instead of connecting every time
+#ifndef USE_CONNECTION_POOL
+#define USE_CONNECTION_POOL true
+#endif
+
+// the number of idle connections that are kept for each server; an idle connection keeps a
+// worker of the server waiting for the next request, unless the server watches its connections
+// with a PDBConnectionReactor, so this is kept small
+#ifndef MAX_IDLE_CONNECTIONS_PER_SERVER
+#define MAX_IDLE_CONNECTIONS_PER_SERVER 4
+#endif
+
+// the number of seconds that a connection may stay idle before it is closed
+#ifndef MAX_CONNECTION_IDLE_SECONDS
+#define MAX_CONNECTION_IDLE_SECONDS 30
+#endif
+
+// the number of buckets of a latency histogram; bucket i counts the requests that took less than
+// 2^i microseconds, and the last bucket counts all longer requests
+#define NUM_LATENCY_BUCKETS 32
+
+namespace pdb {
+
+// the latencies of the requests of one message type
+class RequestLatencyHistogram {
+
+public:
+    size_t numRequests = 0;
+
+    size_t numFailures = 0;
+
+    size_t totalMicroseconds = 0;
+
+    size_t maxMicroseconds = 0;
+
+    size_t buckets[NUM_LATENCY_BUCKETS] = {0};
+
+    // adds the latency of a request
+    void add(size_t microseconds, bool success);
+
+    // returns the upper bound in microseconds of the bucket that has the given percentile (e.g. 0.99),
+    // or the longest latency if that is less
+    size_t getPercentile(double percentile) const;
+};
+
+// this class keeps the connections to other servers open after a request, and gives them to the
+// next request to the same server. A connection is used by one request at a time; requests that
+// run at the same time to the same server get different connections, as the server handles the
+// requests on a connection one after another. A connection that had an error is not given back,
+// so that it is closed. It also keeps a latency histogram for each message type
+class PDBConnectionPool {
+
+public:
+    PDBConnectionPool();
+
+    ~PDBConnectionPool();
+
+    // returns a connection to the server, which is an idle connection of the pool if there is one
+    // that is still open, or a new connection; returns nullptr and sets errMsg on error
+    PDBCommunicatorPtr getConnection(PDBLoggerPtr logger,
+                                     int port,
+                                     std::string address,
+                                     std::string& errMsg);
+
+    // gives back a connection to the server after a request that completed, so that the next
+    // request reuses it; it is closed if the pool has enough idle connections to that server
+    void releaseConnection(int port, std::string address, PDBCommunicatorPtr connection);
+
+    // closes all idle connections
+    void closeIdleConnections();
+
+    // adds the latency of a request of the given message type to its histogram
+    void recordLatency(std::string messageType, size_t microseconds, bool success);
+
+    // returns the latency histogram of a message type
+    RequestLatencyHistogram getLatencies(std::string messageType);
+
+    // returns the latencies of all message types as a table
+    std::string printLatencies();
+
+    size_t getNumIdleConnections();
+
+    size_t getNumConnectionsCreated();
+
+    size_t getNumConnectionsReused();
+
+private:
+    // returns true if the other side didn't close the connection, and didn't send anything that
+    // nobody has asked for
+    static bool isStillOpen(PDBCommunicatorPtr connection);
+
+    // an idle connection and the time since it is idle
+    typedef std::pair<PDBCommunicatorPtr, time_t> IdleConnection;
+
+    // the idle connections of each server, by address and port
+    std::map<std::pair<std::string, int>, std::deque<IdleConnection>> idleConnections;
+
+    // the latency histogram of each message type
+    std::map<std::string, RequestLatencyHistogram> latencies;
+
+    size_t numConnectionsCreated = 0;
+
+    size_t numConnectionsReused = 0;
+
+    pthread_mutex_t poolMutex;
+};
+
+// returns the connection pool of this process
+PDBConnectionPool& getConnectionPool();
+}
+
+#endif
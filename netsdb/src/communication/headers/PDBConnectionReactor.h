@@ -0,0 +1,127 @@
+#ifndef PDB_CONNECTION_REACTOR_H
+#define PDB_CONNECTION_REACTOR_H
+
+#include "PDBCommunicator.h"
+#include "PDBLogger.h"
+#include <pthread.h>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+// whether a server waits for the next request of all of its connections with one thread, and
+// only gives a connection to a worker when a request has arrived completely, instead of keeping a
+// worker blocked in read() on each connection while it is open
+#ifndef USE_CONNECTION_REACTOR
+#define USE_CONNECTION_REACTOR true
+#endif
+
+// the number of events that the reactor gets from epoll at once
+#ifndef MAX_REACTOR_EVENTS
+#define MAX_REACTOR_EVENTS 64
+#endif
+
+namespace pdb {
+
+class PDBConnectionReactor;
+typedef std::shared_ptr<PDBConnectionReactor> PDBConnectionReactorPtr;
+
+// this class owns the connections of a server between requests. Its thread waits on all of them
+// with epoll, and reads the next request of a connection as it arrives, without blocking: the
+// type and the size of the request, as PDBCommunicator writes them, and then the bytes of that
+// size. When the request is complete, the connection is given to handleRequest, with the request
+// set as its next message, so that the handler reads it from the PDBCommunicator as before. The
+// connection is not watched while the request is handled, as the handler may read more messages
+// from it; the handler gives it back with resumeConnection() or removeConnection().
+// So only the connections whose requests are being handled need a worker, and the number of
+// workers doesn't limit the number of open connections
+class PDBConnectionReactor {
+
+public:
+    // handleRequest is called by the thread of the reactor, with a connection whose next
+    // request has arrived; it is to give the connection to a worker, and return
+    PDBConnectionReactor(PDBLoggerPtr logger,
+                         std::function<void(PDBCommunicatorPtr)> handleRequest);
+
+    ~PDBConnectionReactor();
+
+    // creates the epoll instance and starts the thread of the reactor; returns false and sets
+    // errMsg on error
+    bool start(std::string& errMsg);
+
+    // stops the thread of the reactor, and closes the connections that it watches
+    void stop();
+
+    // watches a connection that was just accepted, for its first request
+    void addConnection(PDBCommunicatorPtr connection);
+
+    // watches a connection again after its request was handled, for its next request; the
+    // connection is dropped if it was closed
+    void resumeConnection(PDBCommunicatorPtr connection);
+
+    // drops a connection after its last request, which closes it if nobody else holds it
+    void removeConnection(PDBCommunicatorPtr connection);
+
+    size_t getNumConnections();
+
+    size_t getNumRequests();
+
+private:
+    // a connection, and how much of its next request has arrived
+    struct Connection {
+        PDBCommunicatorPtr communicator;
+
+        // the type and the size of the request
+        char header[sizeof(int16_t) + sizeof(size_t)];
+        size_t headerBytes = 0;
+
+        // the bytes of the request after its size, and the number of them that arrived
+        std::vector<char> body;
+        size_t bodyBytes = 0;
+        bool readingBody = false;
+    };
+    typedef std::shared_ptr<Connection> ConnectionPtr;
+
+    // the loop of the thread of the reactor
+    void run();
+
+    friend void* callReactorRun(void* reactor);
+
+    // reads what arrived of the next request of a connection; returns 1 if the request is
+    // complete, 0 if more is to arrive, and -1 if the connection is closed or broken
+    int readRequest(ConnectionPtr connection);
+
+    // watches a connection for the next bytes, once
+    bool watch(int fd, bool firstTime);
+
+    // drops a connection of the given socket, if it is the given connection
+    void drop(int fd, PDBCommunicatorPtr communicator, bool closed);
+
+    PDBLoggerPtr logger;
+
+    std::function<void(PDBCommunicatorPtr)> handleRequest;
+
+    int epollFD = -1;
+
+    // the eventfd that wakes the thread up to stop it
+    int wakeFD = -1;
+
+    pthread_t reactorThread;
+
+    bool started = false;
+
+    std::atomic<bool> stopped{false};
+
+    // the connections by their sockets, and the sockets by the connections, as the socket of a
+    // connection that is closed can't be asked from it any more
+    std::map<int, ConnectionPtr> connections;
+    std::map<PDBCommunicator*, int> sockets;
+
+    pthread_mutex_t connectionsMutex;
+
+    std::atomic<size_t> numRequests{0};
+};
+}
+
+#endif
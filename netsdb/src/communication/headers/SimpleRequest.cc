@@ -2,12 +2,15 @@
 #ifndef SIMPLE_REQUEST_CC
 #define SIMPLE_REQUEST_CC
 
+#include <chrono>
 #include <functional>
 #include <string>
 
 #include "InterfaceFunctions.h"
 #include "UseTemporaryAllocationBlock.h"
 #include "PDBCommunicator.h"
+#include "PDBConnectionPool.h"
+#include "TypeName.h"
 
 using std::function;
 using std::string;
@@ -29,17 +32,30 @@ ReturnType simpleRequest(PDBLoggerPtr myLogger,
 
     int numRetries = 0;
 
+    // the connection comes from the pool of this process, and is given back to it once the
+    // request completes, so that the next request to this server doesn't connect again
+    PDBConnectionPool& pool = getConnectionPool();
+    auto begin = std::chrono::high_resolution_clock::now();
+    auto recordLatency = [&](bool success) {
+        auto end = std::chrono::high_resolution_clock::now();
+        pool.recordLatency(
+            getTypeName<RequestType>(),
+            std::chrono::duration_cast<std::chrono::microseconds>(end - begin).count(),
+            success);
+    };
+
     while (numRetries <= MAX_RETRIES) {
-        PDBCommunicator temp;
         string errMsg;
         bool success;
 
-        if (temp.connectToInternetServer(myLogger, port, address, errMsg)) {
+        PDBCommunicatorPtr temp = pool.getConnection(myLogger, port, address, errMsg);
+        if (temp == nullptr) {
             myLogger->error(errMsg);
             myLogger->error("simpleRequest: not able to connect to server.\n");
             // return onErr;
             std::cout << "ERROR: can not connect to remote server with port=" << port
                       << " and address=" << address << std::endl;
+            recordLatency(false);
             return onErr;
         }
         myLogger->info(std::string("Successfully connected to remote server with port=") +
@@ -50,6 +66,7 @@ ReturnType simpleRequest(PDBLoggerPtr myLogger,
         PDB_COUT << "bytesForRequest=" << bytesForRequest << std::endl;
         if (bytesForRequest <= BLOCK_HEADER_SIZE) {
             std::cout << "ERROR: too small buffer size for processing simple request" << std::endl;
+            recordLatency(false);
             return onErr;
         }
         const UseTemporaryAllocationBlock tempBlock{bytesForRequest};
@@ -57,25 +74,27 @@ ReturnType simpleRequest(PDBLoggerPtr myLogger,
         Handle<RequestType> request = makeObject<RequestType>(args...);
         ;
         PDB_COUT << "to send object" << std::endl;
-        if (!temp.sendObject(request, errMsg)) {
+        if (!temp->sendObject(request, errMsg)) {
             myLogger->error(errMsg);
             myLogger->error("simpleRequest: not able to send request to server.\n");
             if (numRetries < MAX_RETRIES) {
                 numRetries++;
                 continue;
             } else {
+                recordLatency(false);
                 return onErr;
             }
         }
         PDB_COUT << "sent object..." << std::endl;
         // get the response and process it
         ReturnType finalResult;
-        size_t objectSize = temp.getSizeOfNextObject();
+        size_t objectSize = temp->getSizeOfNextObject();
         if (objectSize == 0) {
             if (numRetries < MAX_RETRIES) {
                 numRetries++;
                 continue;
             } else {
+                recordLatency(false);
                 return onErr;
             }
         }
@@ -87,7 +106,7 @@ ReturnType simpleRequest(PDBLoggerPtr myLogger,
             exit(-1);
         }
         {
-            Handle<ResponseType> result = temp.getNextObject<ResponseType>(memory, success, errMsg);
+            Handle<ResponseType> result = temp->getNextObject<ResponseType>(memory, success, errMsg);
             if (!success) {
                 myLogger->error(errMsg);
                 myLogger->error("simpleRequest: not able to get next object over the wire.\n");
@@ -98,6 +117,7 @@ ReturnType simpleRequest(PDBLoggerPtr myLogger,
                     numRetries++;
                     continue;
                 } else {
+                    recordLatency(false);
                     return onErr;
                 }
             }
@@ -105,8 +125,12 @@ ReturnType simpleRequest(PDBLoggerPtr myLogger,
             finalResult = processResponse(result);
         }
         free(memory);
+        // the whole response is read, so the connection can take the next request
+        pool.releaseConnection(port, address, temp);
+        recordLatency(true);
         return finalResult;
     }
+    recordLatency(false);
     return onErr;
 }
 
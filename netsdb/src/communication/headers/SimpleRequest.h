@@ -2,6 +2,8 @@
 #ifndef SIMPLE_REQUEST_H
 #define SIMPLE_REQUEST_H
 
+#include <functional>
+
 #include "PDBLogger.h"
 
 // This templated function makes it easy to write a simple network client that asks a request,
@@ -32,7 +34,7 @@ ReturnType simpleRequest(PDBLoggerPtr myLogger,
                          std::string address,
                          ReturnType onErr,
                          size_t bytesForRequest,
-                         function<ReturnType(Handle<ResponseType>)> processResponse,
+                         std::function<ReturnType(Handle<ResponseType>)> processResponse,
                          RequestTypeParams&&... args);
 }
 
@@ -65,7 +67,7 @@ ReturnType simpleDoubleRequest(PDBLoggerPtr myLogger,
                                std::string address,
                                ReturnType onErr,
                                size_t bytesForRequest,
-                               function<ReturnType(Handle<ResponseType>)> processResponse,
+                               std::function<ReturnType(Handle<ResponseType>)> processResponse,
                                Handle<RequestType>& firstRequest,
                                Handle<SecondRequestType>& secondRequest);
 }
@@ -21,8 +21,10 @@
 #include <arpa/inet.h>
 #include <sys/types.h>
 #include <sys/uio.h>
+#include <algorithm>
 #include <sys/un.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <unistd.h>
 
 
@@ -35,6 +37,7 @@ PDBCommunicator::PDBCommunicator() {
     readCurMsgSize = false;
     socketFD = -1;
     nextTypeID = NoMsg_TYPEID;
+    hasNextMessageBytes = false;
     socketClosed = true;
     // Jia: moved this logic from Chris' message-based communication framework to here
     needToSendDisconnectMsg = false;
@@ -61,6 +64,10 @@ bool PDBCommunicator::pointToInternet(PDBLoggerPtr logToMeIn, int socketFDIn, st
         return true;
     }
     socketClosed = false;
+    // a client may send many requests over this connection, and each response is written in
+    // several pieces, so we don't wait for the client to acknowledge a piece before the next
+    int noDelay = 1;
+    setsockopt(socketFD, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
     logToMe->info("PDBCommunicator: got request from Internet");
     return false;
 }
@@ -493,6 +500,14 @@ bool PDBCommunicator::doTheRead(char* dataIn) {
     }
     readCurMsgSize = false;
 
+    // the bytes may have been read from the socket already
+    if (hasNextMessageBytes) {
+        memcpy(dataIn, nextMessageBytes.data(), std::min((size_t)msgSize, nextMessageBytes.size()));
+        nextMessageBytes.clear();
+        hasNextMessageBytes = false;
+        return false;
+    }
+
     // now, read the rest of the bytes
     char* start = dataIn;
     char* cur = start;
@@ -536,6 +551,14 @@ bool PDBCommunicator::doTheRead(char* dataIn) {
     return false;
 }
 
+void PDBCommunicator::setNextMessage(int16_t typeID, size_t size, std::vector<char>& bytes) {
+    nextTypeID = typeID;
+    msgSize = size;
+    readCurMsgSize = true;
+    nextMessageBytes.swap(bytes);
+    hasNextMessageBytes = true;
+}
+
 // JiaNote: add following functions to enable a stable long connection:
 
 bool PDBCommunicator::isSocketClosed() {
@@ -548,6 +571,12 @@ bool PDBCommunicator::isLongConnection() {
 
 void PDBCommunicator::setLongConnection(bool longConnection) {
     this->longConnection = longConnection;
+    // a long connection sends many requests, each of them written in several pieces; with
+    // Nagle's algorithm every request after the first waits for a delayed ack of the server
+    if (longConnection && socketFD >= 0) {
+        int noDelay = 1;
+        setsockopt(socketFD, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    }
 }
 
 bool PDBCommunicator::reconnect(std::string& errMsg) {
@@ -0,0 +1,205 @@
+#ifndef PDB_CONNECTION_POOL_CC
+#define PDB_CONNECTION_POOL_CC
+
+#include "PDBConnectionPool.h"
+#include <errno.h>
+#include <math.h>
+#include <signal.h>
+#include <stdio.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <algorithm>
+
+namespace pdb {
+
+void RequestLatencyHistogram::add(size_t microseconds, bool success) {
+    numRequests++;
+    if (!success) {
+        numFailures++;
+    }
+    totalMicroseconds += microseconds;
+    if (microseconds > maxMicroseconds) {
+        maxMicroseconds = microseconds;
+    }
+    int bucket = 0;
+    while ((bucket < NUM_LATENCY_BUCKETS - 1) && (((size_t)1 << bucket) <= microseconds)) {
+        bucket++;
+    }
+    buckets[bucket]++;
+}
+
+size_t RequestLatencyHistogram::getPercentile(double percentile) const {
+    // the rank of the wanted request among all requests, from 1
+    size_t wanted = (size_t)ceil(percentile * numRequests);
+    if (wanted == 0) {
+        wanted = 1;
+    }
+    size_t count = 0;
+    for (int bucket = 0; bucket < NUM_LATENCY_BUCKETS - 1; bucket++) {
+        count += buckets[bucket];
+        if (count >= wanted) {
+            return std::min((size_t)1 << bucket, maxMicroseconds);
+        }
+    }
+    return maxMicroseconds;
+}
+
+PDBConnectionPool::PDBConnectionPool() {
+    pthread_mutex_init(&poolMutex, nullptr);
+    // the server may close an idle connection at any time; writing a request to it must fail
+    // and be retried, instead of killing a client process that didn't ignore SIGPIPE as the
+    // servers do
+    if (USE_CONNECTION_POOL) {
+        struct sigaction current;
+        if ((sigaction(SIGPIPE, nullptr, &current) == 0) && (current.sa_handler == SIG_DFL)) {
+            signal(SIGPIPE, SIG_IGN);
+        }
+    }
+}
+
+PDBConnectionPool::~PDBConnectionPool() {
+    closeIdleConnections();
+    pthread_mutex_destroy(&poolMutex);
+}
+
+bool PDBConnectionPool::isStillOpen(PDBCommunicatorPtr connection) {
+    if (connection->isSocketClosed() || (connection->getSocketFD() < 0)) {
+        return false;
+    }
+    char next;
+    ssize_t numBytes = recv(connection->getSocketFD(), &next, 1, MSG_PEEK | MSG_DONTWAIT);
+    return (numBytes < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK));
+}
+
+PDBCommunicatorPtr PDBConnectionPool::getConnection(PDBLoggerPtr logger,
+                                                    int port,
+                                                    std::string address,
+                                                    std::string& errMsg) {
+    if (USE_CONNECTION_POOL) {
+        time_t now = time(nullptr);
+        std::deque<IdleConnection> closing;
+        PDBCommunicatorPtr connection = nullptr;
+        pthread_mutex_lock(&poolMutex);
+        std::deque<IdleConnection>& idle = idleConnections[std::make_pair(address, port)];
+        // the connections that were used last are at the back
+        while (!idle.empty()) {
+            IdleConnection candidate = idle.back();
+            idle.pop_back();
+            if ((now - candidate.second <= MAX_CONNECTION_IDLE_SECONDS) &&
+                isStillOpen(candidate.first)) {
+                connection = candidate.first;
+                numConnectionsReused++;
+                break;
+            }
+            closing.push_back(candidate);
+        }
+        pthread_mutex_unlock(&poolMutex);
+        // the connections that are dropped are closed outside of the lock
+        closing.clear();
+        if (connection != nullptr) {
+            return connection;
+        }
+    }
+
+    PDBCommunicatorPtr connection = std::make_shared<PDBCommunicator>();
+    if (connection->connectToInternetServer(logger, port, address, errMsg)) {
+        return nullptr;
+    }
+    connection->setLongConnection(USE_CONNECTION_POOL);
+    pthread_mutex_lock(&poolMutex);
+    numConnectionsCreated++;
+    pthread_mutex_unlock(&poolMutex);
+    return connection;
+}
+
+void PDBConnectionPool::releaseConnection(int port,
+                                          std::string address,
+                                          PDBCommunicatorPtr connection) {
+    if ((!USE_CONNECTION_POOL) || (connection == nullptr)) {
+        return;
+    }
+    pthread_mutex_lock(&poolMutex);
+    std::deque<IdleConnection>& idle = idleConnections[std::make_pair(address, port)];
+    if (idle.size() < MAX_IDLE_CONNECTIONS_PER_SERVER) {
+        idle.push_back(std::make_pair(connection, time(nullptr)));
+    }
+    pthread_mutex_unlock(&poolMutex);
+}
+
+void PDBConnectionPool::closeIdleConnections() {
+    std::map<std::pair<std::string, int>, std::deque<IdleConnection>> closing;
+    pthread_mutex_lock(&poolMutex);
+    closing.swap(idleConnections);
+    pthread_mutex_unlock(&poolMutex);
+}
+
+void PDBConnectionPool::recordLatency(std::string messageType,
+                                      size_t microseconds,
+                                      bool success) {
+    pthread_mutex_lock(&poolMutex);
+    latencies[messageType].add(microseconds, success);
+    pthread_mutex_unlock(&poolMutex);
+}
+
+RequestLatencyHistogram PDBConnectionPool::getLatencies(std::string messageType) {
+    pthread_mutex_lock(&poolMutex);
+    RequestLatencyHistogram histogram = latencies[messageType];
+    pthread_mutex_unlock(&poolMutex);
+    return histogram;
+}
+
+std::string PDBConnectionPool::printLatencies() {
+    std::string out = "messageType, numRequests, numFailures, avg(us), p50(us), p99(us), max(us)\n";
+    pthread_mutex_lock(&poolMutex);
+    for (auto& entry : latencies) {
+        RequestLatencyHistogram& histogram = entry.second;
+        char line[256];
+        snprintf(line,
+                 sizeof(line),
+                 ", %zu, %zu, %zu, %zu, %zu, %zu\n",
+                 histogram.numRequests,
+                 histogram.numFailures,
+                 histogram.totalMicroseconds / histogram.numRequests,
+                 histogram.getPercentile(0.5),
+                 histogram.getPercentile(0.99),
+                 histogram.maxMicroseconds);
+        out += entry.first + line;
+    }
+    out += "connections created: " + std::to_string(numConnectionsCreated) +
+        ", connections reused: " + std::to_string(numConnectionsReused) + "\n";
+    pthread_mutex_unlock(&poolMutex);
+    return out;
+}
+
+size_t PDBConnectionPool::getNumIdleConnections() {
+    size_t numIdle = 0;
+    pthread_mutex_lock(&poolMutex);
+    for (auto& entry : idleConnections) {
+        numIdle += entry.second.size();
+    }
+    pthread_mutex_unlock(&poolMutex);
+    return numIdle;
+}
+
+size_t PDBConnectionPool::getNumConnectionsCreated() {
+    pthread_mutex_lock(&poolMutex);
+    size_t num = numConnectionsCreated;
+    pthread_mutex_unlock(&poolMutex);
+    return num;
+}
+
+size_t PDBConnectionPool::getNumConnectionsReused() {
+    pthread_mutex_lock(&poolMutex);
+    size_t num = numConnectionsReused;
+    pthread_mutex_unlock(&poolMutex);
+    return num;
+}
+
+PDBConnectionPool& getConnectionPool() {
+    static PDBConnectionPool pool;
+    return pool;
+}
+}
+
+#endif
@@ -0,0 +1,284 @@
+#ifndef PDB_CONNECTION_REACTOR_CC
+#define PDB_CONNECTION_REACTOR_CC
+
+#include "PDBConnectionReactor.h"
+#include "BuiltInObjectTypeIDs.h"
+#include <errno.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace pdb {
+
+void* callReactorRun(void* reactor) {
+    static_cast<PDBConnectionReactor*>(reactor)->run();
+    return nullptr;
+}
+
+PDBConnectionReactor::PDBConnectionReactor(PDBLoggerPtr logger,
+                                           std::function<void(PDBCommunicatorPtr)> handleRequest) {
+    this->logger = logger;
+    this->handleRequest = handleRequest;
+    pthread_mutex_init(&connectionsMutex, nullptr);
+}
+
+PDBConnectionReactor::~PDBConnectionReactor() {
+    stop();
+    pthread_mutex_destroy(&connectionsMutex);
+}
+
+bool PDBConnectionReactor::start(std::string& errMsg) {
+    epollFD = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFD < 0) {
+        errMsg = std::string("PDBConnectionReactor: could not create epoll: ") + strerror(errno);
+        return false;
+    }
+    wakeFD = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (wakeFD < 0) {
+        errMsg = std::string("PDBConnectionReactor: could not create eventfd: ") + strerror(errno);
+        return false;
+    }
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = wakeFD;
+    if (epoll_ctl(epollFD, EPOLL_CTL_ADD, wakeFD, &event) < 0) {
+        errMsg = std::string("PDBConnectionReactor: could not watch eventfd: ") + strerror(errno);
+        return false;
+    }
+    int returnCode = pthread_create(&reactorThread, nullptr, callReactorRun, this);
+    if (returnCode) {
+        errMsg = "PDBConnectionReactor: return code from pthread_create () is " +
+            std::to_string(returnCode);
+        return false;
+    }
+    started = true;
+    return true;
+}
+
+void PDBConnectionReactor::stop() {
+    if (started) {
+        stopped = true;
+        uint64_t one = 1;
+        if (write(wakeFD, &one, sizeof(one)) < 0) {
+            logger->error(std::string("PDBConnectionReactor: could not wake up: ") +
+                          strerror(errno));
+        }
+        pthread_join(reactorThread, nullptr);
+        started = false;
+    }
+    if (wakeFD >= 0) {
+        close(wakeFD);
+        wakeFD = -1;
+    }
+    if (epollFD >= 0) {
+        close(epollFD);
+        epollFD = -1;
+    }
+    // the connections are closed outside of the lock
+    std::map<int, ConnectionPtr> closing;
+    pthread_mutex_lock(&connectionsMutex);
+    closing.swap(connections);
+    sockets.clear();
+    pthread_mutex_unlock(&connectionsMutex);
+}
+
+void PDBConnectionReactor::addConnection(PDBCommunicatorPtr communicator) {
+    int fd = communicator->getSocketFD();
+    if (fd < 0) {
+        return;
+    }
+    ConnectionPtr connection = std::make_shared<Connection>();
+    connection->communicator = communicator;
+    pthread_mutex_lock(&connectionsMutex);
+    connections[fd] = connection;
+    sockets[communicator.get()] = fd;
+    pthread_mutex_unlock(&connectionsMutex);
+    if (!watch(fd, true)) {
+        drop(fd, communicator, false);
+    }
+}
+
+void PDBConnectionReactor::resumeConnection(PDBCommunicatorPtr communicator) {
+    pthread_mutex_lock(&connectionsMutex);
+    auto found = sockets.find(communicator.get());
+    if (found == sockets.end()) {
+        pthread_mutex_unlock(&connectionsMutex);
+        return;
+    }
+    int fd = found->second;
+    pthread_mutex_unlock(&connectionsMutex);
+    // the handler may have closed the connection, and its socket may be another connection's now
+    bool closed = communicator->isSocketClosed() || (communicator->getSocketFD() != fd);
+    if (closed || !watch(fd, false)) {
+        drop(fd, communicator, closed);
+    }
+}
+
+void PDBConnectionReactor::removeConnection(PDBCommunicatorPtr communicator) {
+    pthread_mutex_lock(&connectionsMutex);
+    auto found = sockets.find(communicator.get());
+    if (found == sockets.end()) {
+        pthread_mutex_unlock(&connectionsMutex);
+        return;
+    }
+    int fd = found->second;
+    pthread_mutex_unlock(&connectionsMutex);
+    drop(fd, communicator, communicator->isSocketClosed() || (communicator->getSocketFD() != fd));
+}
+
+size_t PDBConnectionReactor::getNumConnections() {
+    pthread_mutex_lock(&connectionsMutex);
+    size_t num = connections.size();
+    pthread_mutex_unlock(&connectionsMutex);
+    return num;
+}
+
+size_t PDBConnectionReactor::getNumRequests() {
+    return numRequests;
+}
+
+bool PDBConnectionReactor::watch(int fd, bool firstTime) {
+    // a connection is reported once, until it is watched again, so that it is not read by the
+    // reactor while its request is handled
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+    event.data.fd = fd;
+    if (epoll_ctl(epollFD, firstTime ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, fd, &event) < 0) {
+        logger->error(std::string("PDBConnectionReactor: could not watch socket ") +
+                      std::to_string(fd) + ": " + strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+void PDBConnectionReactor::drop(int fd, PDBCommunicatorPtr communicator, bool closed) {
+    ConnectionPtr dropped = nullptr;
+    pthread_mutex_lock(&connectionsMutex);
+    auto found = connections.find(fd);
+    if ((found != connections.end()) && (found->second->communicator == communicator)) {
+        dropped = found->second;
+        connections.erase(found);
+        if (!closed) {
+            epoll_ctl(epollFD, EPOLL_CTL_DEL, fd, nullptr);
+        }
+    }
+    sockets.erase(communicator.get());
+    pthread_mutex_unlock(&connectionsMutex);
+}
+
+int PDBConnectionReactor::readRequest(ConnectionPtr connection) {
+    int fd = connection->communicator->getSocketFD();
+    while (true) {
+        char* readToHere;
+        size_t bytesToRead;
+        if (!connection->readingBody) {
+            readToHere = connection->header + connection->headerBytes;
+            bytesToRead = sizeof(connection->header) - connection->headerBytes;
+        } else {
+            readToHere = connection->body.data() + connection->bodyBytes;
+            bytesToRead = connection->body.size() - connection->bodyBytes;
+        }
+        if (bytesToRead > 0) {
+            ssize_t numBytes = recv(fd, readToHere, bytesToRead, MSG_DONTWAIT);
+            if (numBytes == 0) {
+                logger->trace("PDBConnectionReactor: the other side closed the connection");
+                return -1;
+            } else if (numBytes < 0) {
+                if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+                    return 0;
+                } else if (errno == EINTR) {
+                    continue;
+                }
+                logger->error(std::string("PDBConnectionReactor: error reading socket: ") +
+                              strerror(errno));
+                return -1;
+            }
+            if (!connection->readingBody) {
+                connection->headerBytes += numBytes;
+            } else {
+                connection->bodyBytes += numBytes;
+            }
+            continue;
+        }
+
+        if (!connection->readingBody) {
+            // the size of an object counts the size itself, which is the start of its record,
+            // and the size of bytes doesn't
+            int16_t typeID;
+            size_t size;
+            memcpy(&typeID, connection->header, sizeof(int16_t));
+            memcpy(&size, connection->header + sizeof(int16_t), sizeof(size_t));
+            size_t bodySize = size;
+            if (typeID != NoMsg_TYPEID) {
+                if (size < sizeof(size_t)) {
+                    logger->error("PDBConnectionReactor: got a request with a wrong size " +
+                                  std::to_string(size));
+                    return -1;
+                }
+                bodySize = size - sizeof(size_t);
+            }
+            connection->body.resize(bodySize);
+            connection->bodyBytes = 0;
+            connection->readingBody = true;
+            continue;
+        }
+
+        // the request is complete
+        int16_t typeID;
+        size_t size;
+        memcpy(&typeID, connection->header, sizeof(int16_t));
+        memcpy(&size, connection->header + sizeof(int16_t), sizeof(size_t));
+        connection->communicator->setNextMessage(typeID, size, connection->body);
+        connection->body.clear();
+        connection->headerBytes = 0;
+        connection->bodyBytes = 0;
+        connection->readingBody = false;
+        return 1;
+    }
+}
+
+void PDBConnectionReactor::run() {
+    struct epoll_event events[MAX_REACTOR_EVENTS];
+    while (!stopped) {
+        int numEvents = epoll_wait(epollFD, events, MAX_REACTOR_EVENTS, -1);
+        if (numEvents < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            logger->error(std::string("PDBConnectionReactor: epoll_wait failed: ") +
+                          strerror(errno));
+            break;
+        }
+        for (int i = 0; i < numEvents; i++) {
+            int fd = events[i].data.fd;
+            if (fd == wakeFD) {
+                continue;
+            }
+            ConnectionPtr connection = nullptr;
+            pthread_mutex_lock(&connectionsMutex);
+            auto found = connections.find(fd);
+            if (found != connections.end()) {
+                connection = found->second;
+            }
+            pthread_mutex_unlock(&connectionsMutex);
+            if (connection == nullptr) {
+                continue;
+            }
+            int status = readRequest(connection);
+            if (status > 0) {
+                numRequests++;
+                handleRequest(connection->communicator);
+            } else if ((status < 0) || !watch(fd, false)) {
+                drop(fd, connection->communicator, false);
+            }
+        }
+    }
+}
+}
+
+#endif
@@ -71,6 +71,159 @@ using namespace std;
 #define DEFAULT_NUM_CORES 8 
 #endif
 
+// number of independently locked partitions of the page cache
+#ifndef DEFAULT_NUM_CACHE_SHARDS
+#define DEFAULT_NUM_CACHE_SHARDS 16
+#endif
+
+// number of pages to prefetch ahead of a sequential scan, 0 disables read-ahead
+#ifndef DEFAULT_READ_AHEAD_WINDOW
+#define DEFAULT_READ_AHEAD_WINDOW 4
+#endif
+
+// number of I/O threads serving read-ahead requests
+#ifndef DEFAULT_NUM_READ_AHEAD_THREADS
+#define DEFAULT_NUM_READ_AHEAD_THREADS 2
+#endif
+
+// replacement strategy of the page cache (see PageReplacementPolicy.h)
+#ifndef DEFAULT_CACHE_STRATEGY
+#define DEFAULT_CACHE_STRATEGY UnifiedMRU
+#endif
+
+// number of most recent accesses that the LRU-K replacement policy compares
+#ifndef DEFAULT_LRU_K
+#define DEFAULT_LRU_K 2
+#endif
+
+// file to record the page accesses of the page cache to, for CacheTraceReplay; empty disables it
+#ifndef DEFAULT_CACHE_TRACE_FILE
+#define DEFAULT_CACHE_TRACE_FILE ""
+#endif
+
+// number of slots of the ring in shared memory for the backend to pin and unpin pages, a power of 2
+#ifndef DEFAULT_SHM_RING_SLOTS
+#define DEFAULT_SHM_RING_SLOTS 256
+#endif
+
+// number of frontend threads polling that ring, 0 keeps all pins and unpins on the socket
+#ifndef DEFAULT_NUM_SHM_RING_POLLERS
+#define DEFAULT_NUM_SHM_RING_POLLERS 2
+#endif
+
+// number of page-sized buffers that each thread caches for each size in SharedMem, 0 disables it
+#ifndef DEFAULT_SHM_MAGAZINE_ROUNDS
+#define DEFAULT_SHM_MAGAZINE_ROUNDS 4
+#endif
+
+// smallest buffer that SharedMem caches in the magazines of threads
+#ifndef DEFAULT_SHM_MAGAZINE_MIN_SIZE
+#define DEFAULT_SHM_MAGAZINE_MIN_SIZE ((size_t)(64) * (size_t)(1024))
+#endif
+
+// the magazines of all threads hold at most 1/DEFAULT_SHM_MAGAZINE_MAX_FRACTION of shared memory
+#ifndef DEFAULT_SHM_MAGAZINE_MAX_FRACTION
+#define DEFAULT_SHM_MAGAZINE_MAX_FRACTION 32
+#endif
+
+// whether to back shared memory with explicit 2MB huge pages (MAP_HUGETLB)
+#ifndef DEFAULT_USE_HUGE_PAGES
+#define DEFAULT_USE_HUGE_PAGES false
+#endif
+
+// number of dirty pages that can wait in the flush buffer for the flushing threads
+#ifndef DEFAULT_FLUSH_BUFFER_SIZE
+#define DEFAULT_FLUSH_BUFFER_SIZE 32
+#endif
+
+// max number of pages that a flushing thread writes to its partition in one vectored write
+#ifndef DEFAULT_FLUSH_BATCH_SIZE
+#define DEFAULT_FLUSH_BATCH_SIZE 8
+#endif
+
+// new pages wait for the flushing threads while the flush buffer is at least this percent full,
+// 0 disables it
+#ifndef DEFAULT_FLUSH_BACK_PRESSURE_PERCENT
+#define DEFAULT_FLUSH_BACK_PRESSURE_PERCENT 75
+#endif
+
+// file on a fast local device to cache clean pages evicted from shared memory, empty disables it
+#ifndef DEFAULT_SECOND_TIER_CACHE_FILE
+#define DEFAULT_SECOND_TIER_CACHE_FILE ""
+#endif
+
+// max number of bytes in that file
+#ifndef DEFAULT_SECOND_TIER_CACHE_SIZE
+#define DEFAULT_SECOND_TIER_CACHE_SIZE ((size_t)(16) * (size_t)(1024) * (size_t)(1024) * (size_t)(1024))
+#endif
+
+// whether the workers of a pipeline stage that scans a user set take pages from per-worker
+// queues and steal pages from each other, instead of all waiting on the scan buffer
+#ifndef DEFAULT_USE_MORSEL_SCHEDULING
+#define DEFAULT_USE_MORSEL_SCHEDULING true
+#endif
+
+// whether the build of a hash partitioned join spills the records that don't fit in the hash page
+// of a partition to pages of a temp set, instead of failing the job; the probe stage pins all
+// spilled pages while it runs, so they must fit in the page cache together
+#ifndef DEFAULT_USE_JOIN_BUILD_SPILL
+#define DEFAULT_USE_JOIN_BUILD_SPILL true
+#endif
+
+// whether the aggregation of a partition spills its partial aggregates to pages of a temp set,
+// hash partitioned into this number of spill partitions, when they don't fit in the aggregation
+// page, instead of leaving the results not fully aggregated; 0 turns the spilling off
+#ifndef DEFAULT_NUM_AGGREGATION_SPILL_PARTITIONS
+#define DEFAULT_NUM_AGGREGATION_SPILL_PARTITIONS 8
+#endif
+
+// the number of times that the aggregation of a partition spills a spill partition again, before
+// it gives up on splitting keys that have the same hash
+#ifndef MAX_AGGREGATION_SPILL_LEVELS
+#define MAX_AGGREGATION_SPILL_LEVELS 8
+#endif
+
+// whether the build of a hash partitioned or broadcast join also builds a Bloom filter over the
+// join hashes, which the probe side uses to drop tuples that have no match before they are
+// shuffled or probed
+#ifndef DEFAULT_USE_JOIN_FILTER
+#define DEFAULT_USE_JOIN_FILTER true
+#endif
+
+// the size in bytes of the Bloom filter that each node builds; the scheduler folds the merged
+// filter to JOIN_FILTER_BITS_PER_KEY bits per key before it ships it to the probe side
+#ifndef DEFAULT_JOIN_FILTER_SIZE
+#define DEFAULT_JOIN_FILTER_SIZE ((size_t)(4) * (size_t)(1024) * (size_t)(1024))
+#endif
+
+#ifndef JOIN_FILTER_BITS_PER_KEY
+#define JOIN_FILTER_BITS_PER_KEY 16
+#endif
+
+// the number of shuffled pages that a sender may have sent to a node without an acknowledgement,
+// which is also the number of compressed pages that wait to be sent; with 0 the sink sends every
+// page and waits for its acknowledgement itself
+#ifndef DEFAULT_SHUFFLE_SEND_WINDOW
+#define DEFAULT_SHUFFLE_SEND_WINDOW 4
+#endif
+
+// the memory of the send buffers that all shuffle senders of a job stage share, whatever the
+// number of nodes and threads that they send for
+#ifndef DEFAULT_SHUFFLE_SEND_MEMORY
+#define DEFAULT_SHUFFLE_SEND_MEMORY ((size_t)(512) * (size_t)(1024) * (size_t)(1024))
+#endif
+
+// the codec of the shuffled pages: "none", "snappy", "lz4", "zstd", "zstd:<level>", or "auto" to
+// choose one for each stream by compressing its first pages with each of them
+#ifndef DEFAULT_SHUFFLE_CODEC
+#define DEFAULT_SHUFFLE_CODEC "auto"
+#endif
+
+// a filter with fewer bits per key than this has too many false positives to be worth shipping
+#ifndef JOIN_FILTER_MIN_BITS_PER_KEY
+#define JOIN_FILTER_MIN_BITS_PER_KEY 4
+#endif
+
 // create a smart pointer for Configuration objects
 class Configuration;
 typedef shared_ptr<Configuration> ConfigurationPtr;
@@ -92,12 +245,32 @@ private:
     size_t maxPageSize;
     bool useUnixDomainSock;
     size_t shmSize;
+    bool useHugePages;
     bool logEnabled;
     string dataDirs;
     string metaDir;
     string metaTempDir;
     string dataTempDirs;
     unsigned int numThreads;
+    unsigned int numCacheShards;
+    unsigned int readAheadWindow;
+    unsigned int numReadAheadThreads;
+    unsigned int numShmRingPollers;
+    unsigned int flushBufferSize;
+    unsigned int flushBatchSize;
+    unsigned int flushBackPressurePercent;
+    CacheStrategy cacheStrategy;
+    string cacheTraceFile;
+    string secondTierCacheFile;
+    size_t secondTierCacheSize;
+    bool useMorselScheduling;
+    bool useJoinBuildSpill;
+    int numAggregationSpillPartitions;
+    bool useJoinFilter;
+    size_t joinFilterSize;
+    int shuffleSendWindow;
+    size_t shuffleSendMemory;
+    string shuffleCodec;
     string backEndIpcFile;
     int batchSize;
     size_t hashPageSize;
@@ -130,8 +303,28 @@ public:
         assert(broadcastPageSize <= maxPageSize);
         useUnixDomainSock = false;
         shmSize = DEFAULT_SHAREDMEM_SIZE;
+        useHugePages = DEFAULT_USE_HUGE_PAGES;
         logEnabled = false;
         numThreads = DEFAULT_NUM_THREADS;
+        numCacheShards = DEFAULT_NUM_CACHE_SHARDS;
+        readAheadWindow = DEFAULT_READ_AHEAD_WINDOW;
+        numReadAheadThreads = DEFAULT_NUM_READ_AHEAD_THREADS;
+        numShmRingPollers = DEFAULT_NUM_SHM_RING_POLLERS;
+        flushBufferSize = DEFAULT_FLUSH_BUFFER_SIZE;
+        flushBatchSize = DEFAULT_FLUSH_BATCH_SIZE;
+        flushBackPressurePercent = DEFAULT_FLUSH_BACK_PRESSURE_PERCENT;
+        cacheStrategy = DEFAULT_CACHE_STRATEGY;
+        cacheTraceFile = DEFAULT_CACHE_TRACE_FILE;
+        secondTierCacheFile = DEFAULT_SECOND_TIER_CACHE_FILE;
+        secondTierCacheSize = DEFAULT_SECOND_TIER_CACHE_SIZE;
+        useMorselScheduling = DEFAULT_USE_MORSEL_SCHEDULING;
+        useJoinBuildSpill = DEFAULT_USE_JOIN_BUILD_SPILL;
+        numAggregationSpillPartitions = DEFAULT_NUM_AGGREGATION_SPILL_PARTITIONS;
+        useJoinFilter = DEFAULT_USE_JOIN_FILTER;
+        joinFilterSize = DEFAULT_JOIN_FILTER_SIZE;
+        shuffleSendWindow = DEFAULT_SHUFFLE_SEND_WINDOW;
+        shuffleSendMemory = DEFAULT_SHUFFLE_SEND_MEMORY;
+        shuffleCodec = DEFAULT_SHUFFLE_CODEC;
         ipcFile = "/tmp/ipcFile";
         backEndIpcFile = "/tmp/backEndIpcFile";
         batchSize = DEFAULT_BATCH_SIZE;
@@ -218,6 +411,10 @@ public:
         return shmSize;
     }
 
+    bool getUseHugePages() const {
+        return useHugePages;
+    }
+
     bool isLogEnabled() const {
         return logEnabled;
     }
@@ -246,6 +443,82 @@ public:
         return numThreads;
     }
 
+    unsigned int getNumCacheShards() const {
+        return numCacheShards;
+    }
+
+    unsigned int getReadAheadWindow() const {
+        return readAheadWindow;
+    }
+
+    unsigned int getNumReadAheadThreads() const {
+        return numReadAheadThreads;
+    }
+
+    unsigned int getNumShmRingPollers() const {
+        return numShmRingPollers;
+    }
+
+    unsigned int getFlushBufferSize() const {
+        return flushBufferSize;
+    }
+
+    unsigned int getFlushBatchSize() const {
+        return flushBatchSize;
+    }
+
+    unsigned int getFlushBackPressurePercent() const {
+        return flushBackPressurePercent;
+    }
+
+    CacheStrategy getCacheStrategy() const {
+        return cacheStrategy;
+    }
+
+    string getCacheTraceFile() const {
+        return cacheTraceFile;
+    }
+
+    string getSecondTierCacheFile() const {
+        return secondTierCacheFile;
+    }
+
+    size_t getSecondTierCacheSize() const {
+        return secondTierCacheSize;
+    }
+
+    bool getUseMorselScheduling() const {
+        return useMorselScheduling;
+    }
+
+    bool getUseJoinBuildSpill() const {
+        return useJoinBuildSpill;
+    }
+
+    int getNumAggregationSpillPartitions() const {
+        return numAggregationSpillPartitions;
+    }
+
+    bool getUseJoinFilter() const {
+        return useJoinFilter;
+    }
+
+    size_t getJoinFilterSize() const {
+        return joinFilterSize;
+    }
+
+    int getShuffleSendWindow() const {
+        return shuffleSendWindow;
+    }
+
+    size_t getShuffleSendMemory() const {
+        return shuffleSendMemory;
+    }
+
+    string getShuffleCodec() const {
+        return shuffleCodec;
+    }
+
     string getBackEndIpcFile() const {
         return backEndIpcFile;
     }
@@ -305,6 +578,10 @@ public:
         this->shmSize = shmSize;
     }
 
+    void setUseHugePages(bool useHugePages) {
+        this->useHugePages = useHugePages;
+    }
+
     void setUseUnixDomainSock(bool useUnixDomainSock) {
         this->useUnixDomainSock = useUnixDomainSock;
     }
@@ -333,6 +610,83 @@ public:
         this->numThreads = numThreads;
     }
 
+    void setNumCacheShards(unsigned int numCacheShards) {
+        assert(numCacheShards > 0);
+        this->numCacheShards = numCacheShards;
+    }
+
+    void setReadAheadWindow(unsigned int readAheadWindow) {
+        this->readAheadWindow = readAheadWindow;
+    }
+
+    void setNumReadAheadThreads(unsigned int numReadAheadThreads) {
+        this->numReadAheadThreads = numReadAheadThreads;
+    }
+
+    void setNumShmRingPollers(unsigned int numShmRingPollers) {
+        this->numShmRingPollers = numShmRingPollers;
+    }
+
+    void setFlushBufferSize(unsigned int flushBufferSize) {
+        this->flushBufferSize = flushBufferSize;
+    }
+
+    void setFlushBatchSize(unsigned int flushBatchSize) {
+        this->flushBatchSize = flushBatchSize;
+    }
+
+    void setFlushBackPressurePercent(unsigned int flushBackPressurePercent) {
+        this->flushBackPressurePercent = flushBackPressurePercent;
+    }
+
+    void setCacheStrategy(CacheStrategy cacheStrategy) {
+        this->cacheStrategy = cacheStrategy;
+    }
+
+    void setCacheTraceFile(string cacheTraceFile) {
+        this->cacheTraceFile = cacheTraceFile;
+    }
+
+    void setSecondTierCacheFile(string secondTierCacheFile) {
+        this->secondTierCacheFile = secondTierCacheFile;
+    }
+
+    void setSecondTierCacheSize(size_t secondTierCacheSize) {
+        this->secondTierCacheSize = secondTierCacheSize;
+    }
+
+    void setUseMorselScheduling(bool useMorselScheduling) {
+        this->useMorselScheduling = useMorselScheduling;
+    }
+
+    void setUseJoinBuildSpill(bool useJoinBuildSpill) {
+        this->useJoinBuildSpill = useJoinBuildSpill;
+    }
+
+    void setNumAggregationSpillPartitions(int numAggregationSpillPartitions) {
+        this->numAggregationSpillPartitions = numAggregationSpillPartitions;
+    }
+
+    void setUseJoinFilter(bool useJoinFilter) {
+        this->useJoinFilter = useJoinFilter;
+    }
+
+    void setJoinFilterSize(size_t joinFilterSize) {
+        this->joinFilterSize = joinFilterSize;
+    }
+
+    void setShuffleSendWindow(int shuffleSendWindow) {
+        this->shuffleSendWindow = shuffleSendWindow;
+    }
+
+    void setShuffleSendMemory(size_t shuffleSendMemory) {
+        this->shuffleSendMemory = shuffleSendMemory;
+    }
+
+    void setShuffleCodec(string shuffleCodec) {
+        this->shuffleCodec = shuffleCodec;
+    }
+
     void setBackEndIpcFile(string backEndIpcFile) {
         this->backEndIpcFile = backEndIpcFile;
     }
@@ -442,11 +796,31 @@ public:
         cout << "hashPageSize: " << hashPageSize << endl;
         cout << "useUnixDomainSock: " << useUnixDomainSock << endl;
         cout << "shmSize: " << shmSize << endl;
+        cout << "useHugePages: " << useHugePages << endl;
         cout << "dataDirs: " << dataDirs << endl;
         cout << "metaDir: " << metaDir << endl;
         cout << "metaTempDir: " << metaTempDir << endl;
         cout << "dataTempDirs: " << dataTempDirs << endl;
         cout << "numThreads: " << numThreads << endl;
+        cout << "numCacheShards: " << numCacheShards << endl;
+        cout << "readAheadWindow: " << readAheadWindow << endl;
+        cout << "numReadAheadThreads: " << numReadAheadThreads << endl;
+        cout << "numShmRingPollers: " << numShmRingPollers << endl;
+        cout << "flushBufferSize: " << flushBufferSize << endl;
+        cout << "flushBatchSize: " << flushBatchSize << endl;
+        cout << "flushBackPressurePercent: " << flushBackPressurePercent << endl;
+        cout << "cacheStrategy: " << cacheStrategy << endl;
+        cout << "cacheTraceFile: " << cacheTraceFile << endl;
+        cout << "secondTierCacheFile: " << secondTierCacheFile << endl;
+        cout << "secondTierCacheSize: " << secondTierCacheSize << endl;
+        cout << "useMorselScheduling: " << useMorselScheduling << endl;
+        cout << "useJoinBuildSpill: " << useJoinBuildSpill << endl;
+        cout << "numAggregationSpillPartitions: " << numAggregationSpillPartitions << endl;
+        cout << "useJoinFilter: " << useJoinFilter << endl;
+        cout << "joinFilterSize: " << joinFilterSize << endl;
+        cout << "shuffleSendWindow: " << shuffleSendWindow << endl;
+        cout << "shuffleSendMemory: " << shuffleSendMemory << endl;
+        cout << "shuffleCodec: " << shuffleCodec << endl;
         cout << "backEndIpcFile: " << backEndIpcFile << endl;
         cout << "isMaster: " << isMaster << endl;
         cout << "masterNodeHostName: " << masterNodeHostName << endl;
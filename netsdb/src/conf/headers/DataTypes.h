@@ -37,13 +37,19 @@ typedef enum { JobData,
 
 typedef enum { LRU,
                MRU,
-               Random } LocalitySetReplacementPolicy;
+               Random,
+               ARC,
+               ClockPro,
+               LRUK } LocalitySetReplacementPolicy;
 
 typedef enum { UnifiedLRU,
                UnifiedMRU,
                UnifiedCost,
                UnifiedIntelligent,
-               UnifiedDBMIN } CacheStrategy;
+               UnifiedDBMIN,
+               UnifiedARC,
+               UnifiedClockPro,
+               UnifiedLRUK } CacheStrategy;
 
 typedef enum { Read,
                RepeatedRead,
@@ -72,6 +78,25 @@ typedef enum { Direct,
 typedef enum { SequenceFileType,
                PartitionedFileType } FileType;
 
+// codec used to store the pages of a set on disk
+typedef enum { NoPageCompression,
+               SnappyPageCompression,
+               LZ4PageCompression,
+               ZstdPageCompression } PageCompressionType;
+
+// type of an attribute summarized in the per-page zone maps of a set
+typedef enum { ZoneMapInt,
+               ZoneMapLong,
+               ZoneMapFloat,
+               ZoneMapDouble } ZoneMapAttributeType;
+
+// comparison of a zone map attribute with a constant, as in "attribute op constant"
+typedef enum { ZoneMapLessThan,
+               ZoneMapLessEqual,
+               ZoneMapEqual,
+               ZoneMapGreaterEqual,
+               ZoneMapGreaterThan } ZoneMapComparisonOp;
+
 typedef enum { PeriodicTimer,
                OneshotTimer } TimerType;
 
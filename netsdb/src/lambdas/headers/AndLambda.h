@@ -80,6 +80,25 @@ public:
         return nullptr;
     }
 
+    std::function<bool(Handle<Object>&)> getObjectEvaluator() override {
+        std::function<LeftType(Handle<Object>&)> lhsEvaluator =
+            lhs.getPtr()->getObjectEvaluator();
+        std::function<RightType(Handle<Object>&)> rhsEvaluator =
+            rhs.getPtr()->getObjectEvaluator();
+        if ((lhsEvaluator == nullptr) || (rhsEvaluator == nullptr)) {
+            return nullptr;
+        }
+        return [lhsEvaluator, rhsEvaluator](Handle<Object>& input) {
+            // as in C++, the right side is only run if the left side holds
+            LeftType left = lhsEvaluator(input);
+            if (!checkAnd(left, true)) {
+                return false;
+            }
+            RightType right = rhsEvaluator(input);
+            return checkAnd(left, right);
+        };
+    }
+
 
     ComputeExecutorPtr getExecutor(TupleSpec& inputSchema,
                                    TupleSpec& attsToOperateOn,
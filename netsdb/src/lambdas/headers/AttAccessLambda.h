@@ -211,6 +211,15 @@ public:
         return nullptr;
     }
 
+    std::function<Ptr<Out>(Handle<Object>&)> getObjectEvaluator() override {
+        size_t offset = offsetOfAttToProcess;
+        return [offset](Handle<Object>& input) {
+            // the handle is only reinterpreted, so that its reference count is not touched
+            Handle<ClassType>& myIn = *((Handle<ClassType>*)&input);
+            return Ptr<Out>((Out*)((char*)&(*myIn) + offset));
+        };
+    }
+
     size_t getHash(Handle<Object> input) override {
 
         Handle<ClassType> myIn = unsafeCast<ClassType, Object>(input);
@@ -329,16 +338,45 @@ public:
                 // get the output column
                 std::vector<Ptr<Out>>& outColumn = output->getColumn<Ptr<Out>>(outAtt);
 
-                // loop down the columns, setting the output
+                // loop down the columns, setting the output; if the input has a selection
+                // vector, only the selected rows are set
                 int numTuples = inputColumn.size();
                 outColumn.resize(numTuples);
+                std::shared_ptr<std::vector<uint32_t>> selection = input->getSelection();
+
+                // if the attribute is stored in a contiguous array, we point into the array
+                // instead of dereferencing each object
+                ColumnarViewPtr view = input->getColumnarView(whichAtt);
+                char* array;
+                size_t width;
+                if ((view != nullptr) && (view->getArray(offsetOfAttToProcess, array, width)) &&
+                    (width == sizeof(Out))) {
+                    if (selection != nullptr) {
+                        for (uint32_t i : *selection) {
+                            outColumn[i] = (Out*)(array + view->getRow(i) * width);
+                        }
+                        return output;
+                    }
+                    for (int i = 0; i < numTuples; i++) {
+                        outColumn[i] = (Out*)(array + view->getRow(i) * width);
+                    }
+                    return output;
+                }
+
+                if (selection != nullptr) {
+                    for (uint32_t i : *selection) {
+                        outColumn[i] = (Out*)((char*)&(*(inputColumn[i])) + offsetOfAttToProcess);
+                    }
+                    return output;
+                }
                 for (int i = 0; i < numTuples; i++) {
                     outColumn[i] = (Out*)((char*)&(*(inputColumn[i])) + offsetOfAttToProcess);
                 }
 
                 return output;
             },
-            "attAccessLambda");
+            "attAccessLambda",
+            true);
     }
 };
 }
@@ -248,6 +248,20 @@ public:
         return 0;
     }
 
+    // only a lambda on one input object can be run on one object at a time
+    std::function<ReturnType(Handle<Object>&)> getObjectEvaluator() override {
+        if (this->numInputs != 1) {
+            return nullptr;
+        }
+        F func = myFunc;
+        return [func](Handle<Object>& input) mutable {
+            ReturnType myValue;
+            applyLambda<F, ReturnType, ParamOne, ParamTwo, ParamThree, ParamFour, ParamFive>(
+                func, myValue, *((Handle<ParamOne>*)&input));
+            return myValue;
+        };
+    }
+
     ~CPlusPlusLambda() {}
 
 
@@ -0,0 +1,97 @@
+
+#ifndef COLUMNAR_VIEW_H
+#define COLUMNAR_VIEW_H
+
+#include <map>
+#include <memory>
+#include <vector>
+#include <stdint.h>
+
+namespace pdb {
+
+class ColumnarView;
+typedef std::shared_ptr<ColumnarView> ColumnarViewPtr;
+
+// this class describes where to find attributes of the objects in a column of handles without
+// dereferencing the handles: each attribute is stored in a contiguous array (e.g. in the PAX
+// columns of the page holding the objects), with one value for each row of that page.  A view is
+// attached to a column of a TupleSet, and it is filtered, selected and replicated together with the
+// column
+class ColumnarView {
+
+private:
+    // the array and the width of a value for each attribute, keyed by the byte offset of the
+    // attribute in the objects
+    std::map<size_t, std::pair<char*, size_t>> arrays;
+
+    // the row of each tuple in the arrays; if empty, tuple i is in row firstRow + i
+    std::vector<uint32_t> rows;
+
+    // the row of the first tuple, if rows is empty
+    size_t firstRow;
+
+public:
+    ColumnarView(size_t firstRow) : firstRow(firstRow) {}
+
+    // adds the array that stores an attribute
+    void addArray(size_t byteOffset, char* array, size_t width) {
+        arrays[byteOffset] = std::make_pair(array, width);
+    }
+
+    // gets the array that stores an attribute; returns false if the attribute is not in the view
+    bool getArray(size_t byteOffset, char*& array, size_t& width) {
+        auto iter = arrays.find(byteOffset);
+        if (iter == arrays.end()) {
+            return false;
+        }
+        array = iter->second.first;
+        width = iter->second.second;
+        return true;
+    }
+
+    // gets the row of the ith tuple in the arrays
+    size_t getRow(size_t i) {
+        if (rows.size() == 0) {
+            return firstRow + i;
+        }
+        return rows[i];
+    }
+
+    // returns a view of the tuples that are retained by a filter
+    ColumnarViewPtr filter(std::vector<bool>& whichAreValid) {
+        ColumnarViewPtr newView = std::make_shared<ColumnarView>(0);
+        newView->arrays = arrays;
+        for (size_t i = 0; i < whichAreValid.size(); i++) {
+            if (whichAreValid[i]) {
+                newView->rows.push_back(getRow(i));
+            }
+        }
+        return newView;
+    }
+
+    // returns a view of the tuples at the given positions, in the given order
+    ColumnarViewPtr select(std::vector<uint32_t>& whichToKeep) {
+        ColumnarViewPtr newView = std::make_shared<ColumnarView>(0);
+        newView->arrays = arrays;
+        newView->rows.resize(whichToKeep.size());
+        for (size_t i = 0; i < whichToKeep.size(); i++) {
+            newView->rows[i] = getRow(whichToKeep[i]);
+        }
+        return newView;
+    }
+
+    // returns a view of the tuples replicated for a join
+    ColumnarViewPtr replicate(std::vector<uint32_t>& timesToReplicate) {
+        ColumnarViewPtr newView = std::make_shared<ColumnarView>(0);
+        newView->arrays = arrays;
+        for (size_t i = 0; i < timesToReplicate.size(); i++) {
+            for (uint32_t j = 0; j < timesToReplicate[i]; j++) {
+                newView->rows.push_back(getRow(i));
+            }
+        }
+        return newView;
+    }
+};
+}
+
+#endif
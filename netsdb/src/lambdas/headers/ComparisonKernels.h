@@ -0,0 +1,340 @@
+#ifndef COMPARISON_KERNELS_H
+#define COMPARISON_KERNELS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <type_traits>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define PDB_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+// this file has the kernels that compare the values behind two columns of pointers, as built by
+// attribute accesses and by method calls that return references, and produce a selection vector
+// with the rows where the comparison holds.  Each kernel has a scalar version, and AVX2 and
+// AVX-512 versions for the primitive types (int, long and double) that gather the values through
+// the pointers; the version to run is chosen at runtime from the features of the CPU, so that a
+// binary built on one machine runs everywhere
+
+namespace pdb {
+
+// the instruction sets that the kernels may use
+typedef enum { SimdScalar = 0, SimdAVX2 = 1, SimdAVX512 = 2 } SimdLevel;
+
+// finds the best instruction set supported by this CPU
+inline SimdLevel detectSimdLevel() {
+#ifdef PDB_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return SimdAVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdAVX2;
+    }
+#endif
+    return SimdScalar;
+}
+
+// the instruction set used by the kernels; it is detected the first time that it is needed, and
+// it may be lowered with the PDB_SIMD_LEVEL environment variable (scalar, avx2 or avx512), e.g.
+// to measure the kernels in the benchmarks
+inline SimdLevel& activeSimdLevel() {
+    static SimdLevel level = []() {
+        SimdLevel detected = detectSimdLevel();
+        const char* requested = getenv("PDB_SIMD_LEVEL");
+        if (requested == nullptr) {
+            return detected;
+        }
+        SimdLevel wanted = detected;
+        if (strcmp(requested, "scalar") == 0) {
+            wanted = SimdScalar;
+        } else if (strcmp(requested, "avx2") == 0) {
+            wanted = SimdAVX2;
+        }
+        return (wanted < detected) ? wanted : detected;
+    }();
+    return level;
+}
+
+inline SimdLevel getSimdLevel() {
+    return activeSimdLevel();
+}
+
+// lets benchmarks and tests run the kernels with a smaller instruction set than the detected one;
+// a larger one than the detected one is not used
+inline void setSimdLevel(SimdLevel level) {
+    if (level <= detectSimdLevel()) {
+        activeSimdLevel() = level;
+    }
+}
+
+inline const char* getSimdLevelName(SimdLevel level) {
+    if (level == SimdAVX512) {
+        return "AVX-512";
+    } else if (level == SimdAVX2) {
+        return "AVX2";
+    }
+    return "scalar";
+}
+
+// the scalar kernels, which work for any type with an ==; the row is always written, and the
+// output only advances if the comparison holds, so that there is no branch to mispredict
+template <typename T>
+size_t selectEqualScalar(T* const* lhs, T* const* rhs, uint32_t numRows, uint32_t* out) {
+    size_t numSelected = 0;
+    for (uint32_t i = 0; i < numRows; i++) {
+        out[numSelected] = i;
+        numSelected += (*lhs[i] == *rhs[i]);
+    }
+    return numSelected;
+}
+
+template <typename T>
+size_t selectEqualScalar(
+    T* const* lhs, T* const* rhs, const uint32_t* rows, uint32_t numRows, uint32_t* out) {
+    size_t numSelected = 0;
+    for (uint32_t i = 0; i < numRows; i++) {
+        uint32_t row = rows[i];
+        out[numSelected] = row;
+        numSelected += (*lhs[row] == *rhs[row]);
+    }
+    return numSelected;
+}
+
+#ifdef PDB_X86_KERNELS
+
+// writes the rows whose bit is set in a comparison mask
+inline size_t appendRows(uint32_t mask, uint32_t firstRow, uint32_t* out) {
+    size_t numSelected = 0;
+    while (mask != 0) {
+        out[numSelected++] = firstRow + __builtin_ctz(mask);
+        mask &= mask - 1;
+    }
+    return numSelected;
+}
+
+inline size_t appendRows(uint32_t mask, const uint32_t* rows, uint32_t* out) {
+    size_t numSelected = 0;
+    while (mask != 0) {
+        out[numSelected++] = rows[__builtin_ctz(mask)];
+        mask &= mask - 1;
+    }
+    return numSelected;
+}
+
+// AVX2: the values behind four pointers are gathered at once
+__attribute__((target("avx2"))) inline uint32_t equalMaskAVX2(__m256i lhsPtrs,
+                                                              __m256i rhsPtrs,
+                                                              int*) {
+    __m128i left = _mm256_i64gather_epi32((const int*)nullptr, lhsPtrs, 1);
+    __m128i right = _mm256_i64gather_epi32((const int*)nullptr, rhsPtrs, 1);
+    return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(left, right)));
+}
+
+__attribute__((target("avx2"))) inline uint32_t equalMaskAVX2(__m256i lhsPtrs,
+                                                              __m256i rhsPtrs,
+                                                              long*) {
+    __m256i left = _mm256_i64gather_epi64((const long long*)nullptr, lhsPtrs, 1);
+    __m256i right = _mm256_i64gather_epi64((const long long*)nullptr, rhsPtrs, 1);
+    return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(left, right)));
+}
+
+__attribute__((target("avx2"))) inline uint32_t equalMaskAVX2(__m256i lhsPtrs,
+                                                              __m256i rhsPtrs,
+                                                              double*) {
+    __m256d left = _mm256_i64gather_pd((const double*)nullptr, lhsPtrs, 1);
+    __m256d right = _mm256_i64gather_pd((const double*)nullptr, rhsPtrs, 1);
+    return _mm256_movemask_pd(_mm256_cmp_pd(left, right, _CMP_EQ_OQ));
+}
+
+template <typename T>
+__attribute__((target("avx2"))) size_t selectEqualAVX2(T* const* lhs,
+                                                       T* const* rhs,
+                                                       uint32_t numRows,
+                                                       uint32_t* out) {
+    size_t numSelected = 0;
+    uint32_t i = 0;
+    for (; i + 4 <= numRows; i += 4) {
+        __m256i lhsPtrs = _mm256_loadu_si256((const __m256i*)(lhs + i));
+        __m256i rhsPtrs = _mm256_loadu_si256((const __m256i*)(rhs + i));
+        uint32_t mask = equalMaskAVX2(lhsPtrs, rhsPtrs, (T*)nullptr);
+        numSelected += appendRows(mask, i, out + numSelected);
+    }
+    for (; i < numRows; i++) {
+        out[numSelected] = i;
+        numSelected += (*lhs[i] == *rhs[i]);
+    }
+    return numSelected;
+}
+
+template <typename T>
+__attribute__((target("avx2"))) size_t selectEqualAVX2(
+    T* const* lhs, T* const* rhs, const uint32_t* rows, uint32_t numRows, uint32_t* out) {
+    size_t numSelected = 0;
+    uint32_t i = 0;
+    for (; i + 4 <= numRows; i += 4) {
+        // the pointers of the selected rows are gathered first
+        __m128i which = _mm_loadu_si128((const __m128i*)(rows + i));
+        __m256i lhsPtrs = _mm256_i32gather_epi64((const long long*)lhs, which, 8);
+        __m256i rhsPtrs = _mm256_i32gather_epi64((const long long*)rhs, which, 8);
+        uint32_t mask = equalMaskAVX2(lhsPtrs, rhsPtrs, (T*)nullptr);
+        numSelected += appendRows(mask, rows + i, out + numSelected);
+    }
+    for (; i < numRows; i++) {
+        uint32_t row = rows[i];
+        out[numSelected] = row;
+        numSelected += (*lhs[row] == *rhs[row]);
+    }
+    return numSelected;
+}
+
+// AVX-512: the values behind eight pointers are gathered at once, and the selected rows are
+// written with a compress store
+__attribute__((target("avx512f"))) inline uint32_t equalMaskAVX512(__m512i lhsPtrs,
+                                                                   __m512i rhsPtrs,
+                                                                   int*) {
+    __m256i left = _mm512_i64gather_epi32(lhsPtrs, (const int*)nullptr, 1);
+    __m256i right = _mm512_i64gather_epi32(rhsPtrs, (const int*)nullptr, 1);
+    return _mm512_cmpeq_epi32_mask(_mm512_castsi256_si512(left), _mm512_castsi256_si512(right)) &
+           0xff;
+}
+
+__attribute__((target("avx512f"))) inline uint32_t equalMaskAVX512(__m512i lhsPtrs,
+                                                                   __m512i rhsPtrs,
+                                                                   long*) {
+    __m512i left = _mm512_i64gather_epi64(lhsPtrs, (const long long*)nullptr, 1);
+    __m512i right = _mm512_i64gather_epi64(rhsPtrs, (const long long*)nullptr, 1);
+    return _mm512_cmpeq_epi64_mask(left, right);
+}
+
+__attribute__((target("avx512f"))) inline uint32_t equalMaskAVX512(__m512i lhsPtrs,
+                                                                   __m512i rhsPtrs,
+                                                                   double*) {
+    __m512d left = _mm512_i64gather_pd(lhsPtrs, (const double*)nullptr, 1);
+    __m512d right = _mm512_i64gather_pd(rhsPtrs, (const double*)nullptr, 1);
+    return _mm512_cmp_pd_mask(left, right, _CMP_EQ_OQ);
+}
+
+template <typename T>
+__attribute__((target("avx512f"))) size_t selectEqualAVX512(T* const* lhs,
+                                                            T* const* rhs,
+                                                            uint32_t numRows,
+                                                            uint32_t* out) {
+    size_t numSelected = 0;
+    uint32_t i = 0;
+    __m512i offsets = _mm512_set_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    for (; i + 8 <= numRows; i += 8) {
+        __m512i lhsPtrs = _mm512_loadu_si512((const void*)(lhs + i));
+        __m512i rhsPtrs = _mm512_loadu_si512((const void*)(rhs + i));
+        __mmask16 mask = (__mmask16)equalMaskAVX512(lhsPtrs, rhsPtrs, (T*)nullptr);
+        _mm512_mask_compressstoreu_epi32(
+            out + numSelected, mask, _mm512_add_epi32(_mm512_set1_epi32(i), offsets));
+        numSelected += __builtin_popcount(mask);
+    }
+    for (; i < numRows; i++) {
+        out[numSelected] = i;
+        numSelected += (*lhs[i] == *rhs[i]);
+    }
+    return numSelected;
+}
+
+template <typename T>
+__attribute__((target("avx512f"))) size_t selectEqualAVX512(
+    T* const* lhs, T* const* rhs, const uint32_t* rows, uint32_t numRows, uint32_t* out) {
+    size_t numSelected = 0;
+    uint32_t i = 0;
+    for (; i + 8 <= numRows; i += 8) {
+        // the pointers of the selected rows are gathered first
+        __m256i which = _mm256_loadu_si256((const __m256i*)(rows + i));
+        __m512i lhsPtrs = _mm512_i32gather_epi64(which, (const long long*)lhs, 8);
+        __m512i rhsPtrs = _mm512_i32gather_epi64(which, (const long long*)rhs, 8);
+        __mmask16 mask = (__mmask16)equalMaskAVX512(lhsPtrs, rhsPtrs, (T*)nullptr);
+        _mm512_mask_compressstoreu_epi32(
+            out + numSelected, mask, _mm512_castsi256_si512(which));
+        numSelected += __builtin_popcount(mask);
+    }
+    for (; i < numRows; i++) {
+        uint32_t row = rows[i];
+        out[numSelected] = row;
+        numSelected += (*lhs[row] == *rhs[row]);
+    }
+    return numSelected;
+}
+
+#endif
+
+// the types that have vectorized kernels
+template <typename T>
+struct HasComparisonKernels {
+    static const bool value = false;
+};
+
+#ifdef PDB_X86_KERNELS
+template <>
+struct HasComparisonKernels<int> {
+    static const bool value = true;
+};
+
+template <>
+struct HasComparisonKernels<long> {
+    static const bool value = true;
+};
+
+template <>
+struct HasComparisonKernels<double> {
+    static const bool value = true;
+};
+#endif
+
+// writes into out the rows i < numRows where *lhs[i] == *rhs[i], and returns how many there are;
+// out must have room for numRows rows
+template <typename T>
+std::enable_if_t<HasComparisonKernels<T>::value, size_t> selectEqual(T* const* lhs,
+                                                                     T* const* rhs,
+                                                                     uint32_t numRows,
+                                                                     uint32_t* out) {
+#ifdef PDB_X86_KERNELS
+    SimdLevel level = getSimdLevel();
+    if (level == SimdAVX512) {
+        return selectEqualAVX512(lhs, rhs, numRows, out);
+    } else if (level == SimdAVX2) {
+        return selectEqualAVX2(lhs, rhs, numRows, out);
+    }
+#endif
+    return selectEqualScalar(lhs, rhs, numRows, out);
+}
+
+template <typename T>
+std::enable_if_t<!HasComparisonKernels<T>::value, size_t> selectEqual(T* const* lhs,
+                                                                      T* const* rhs,
+                                                                      uint32_t numRows,
+                                                                      uint32_t* out) {
+    return selectEqualScalar(lhs, rhs, numRows, out);
+}
+
+// the same, but only for the given rows, e.g. the selection vector of a TupleSet
+template <typename T>
+std::enable_if_t<HasComparisonKernels<T>::value, size_t> selectEqual(
+    T* const* lhs, T* const* rhs, const uint32_t* rows, uint32_t numRows, uint32_t* out) {
+#ifdef PDB_X86_KERNELS
+    SimdLevel level = getSimdLevel();
+    if (level == SimdAVX512) {
+        return selectEqualAVX512(lhs, rhs, rows, numRows, out);
+    } else if (level == SimdAVX2) {
+        return selectEqualAVX2(lhs, rhs, rows, numRows, out);
+    }
+#endif
+    return selectEqualScalar(lhs, rhs, rows, numRows, out);
+}
+
+template <typename T>
+std::enable_if_t<!HasComparisonKernels<T>::value, size_t> selectEqual(
+    T* const* lhs, T* const* rhs, const uint32_t* rows, uint32_t numRows, uint32_t* out) {
+    return selectEqualScalar(lhs, rhs, rows, numRows, out);
+}
+}
+
+#endif
@@ -19,6 +19,12 @@ public:
     // precess a tuple set
     virtual TupleSetPtr process(TupleSetPtr input) = 0;
 
+    // returns true if process () accepts a TupleSet with a selection vector, and only looks at the
+    // selected rows; otherwise, the pipeline compacts the TupleSet before calling process ()
+    virtual bool honorsSelection() {
+        return false;
+    }
+
     // JiaNote: add below function for debugging
     virtual std::string getType() {
         return "UNKNOWN";
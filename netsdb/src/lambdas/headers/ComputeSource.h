@@ -23,6 +23,12 @@ public:
 
     virtual size_t getChunkSize() = 0;
 
+    // whether the pipeline may change the chunk size while it runs, to fit the chunks to the
+    // output pages
+    virtual bool isChunkSizeAdaptive() {
+        return false;
+    }
+
     virtual ~ComputeSource() {}
 };
 }
@@ -9,6 +9,7 @@
 #include "TupleSet.h"
 #include "Ptr.h"
 #include "PDBMap.h"
+#include "ComparisonKernels.h"
 namespace pdb {
 
 // only one of these two versions is going to work... used to automatically hash on the underlying
@@ -54,6 +55,38 @@ checkEquals(LHS& lhs, RHS& rhs) {
     return lhs == rhs;
 }
 
+// only one of these two versions is going to work... if both sides are pointers to a primitive
+// type, the rows where they are equal are selected with the vectorized kernels; otherwise this
+// returns false, and the rows are compared one at a time
+template <class LHS, class RHS>
+bool selectEqualRows(std::vector<LHS>& lhs,
+                     std::vector<RHS>& rhs,
+                     std::vector<uint32_t>* rows,
+                     std::vector<uint32_t>& out) {
+    return false;
+}
+
+template <class T>
+bool selectEqualRows(std::vector<Ptr<T>>& lhs,
+                     std::vector<Ptr<T>>& rhs,
+                     std::vector<uint32_t>* rows,
+                     std::vector<uint32_t>& out) {
+    if (!HasComparisonKernels<T>::value) {
+        return false;
+    }
+    static_assert(sizeof(Ptr<T>) == sizeof(T*), "a Ptr must be a plain pointer");
+    T* const* left = (T* const*)lhs.data();
+    T* const* right = (T* const*)rhs.data();
+    if (rows == nullptr) {
+        out.resize(lhs.size());
+        out.resize(selectEqual(left, right, (uint32_t)lhs.size(), out.data()));
+    } else {
+        out.resize(rows->size());
+        out.resize(selectEqual(left, right, rows->data(), (uint32_t)rows->size(), out.data()));
+    }
+    return true;
+}
+
 template <class LeftType, class RightType>
 class EqualsLambda : public TypedLambdaObject<bool> {
 
@@ -309,6 +342,21 @@ public:
         return nullptr;
     }
 
+    std::function<bool(Handle<Object>&)> getObjectEvaluator() override {
+        std::function<LeftType(Handle<Object>&)> lhsEvaluator =
+            lhs.getPtr()->getObjectEvaluator();
+        std::function<RightType(Handle<Object>&)> rhsEvaluator =
+            rhs.getPtr()->getObjectEvaluator();
+        if ((lhsEvaluator == nullptr) || (rhsEvaluator == nullptr)) {
+            return nullptr;
+        }
+        return [lhsEvaluator, rhsEvaluator](Handle<Object>& input) {
+            LeftType left = lhsEvaluator(input);
+            RightType right = rhsEvaluator(input);
+            return checkEquals(left, right);
+        };
+    }
+
 
     ComputeExecutorPtr getExecutor(TupleSpec& inputSchema,
                                    TupleSpec& attsToOperateOn,
@@ -329,6 +377,9 @@ public:
         // this is the output attribute
         int outAtt = attsToIncludeInOutput.getAtts().size();
 
+        // the rows selected by the vectorized kernels
+        std::shared_ptr<std::vector<uint32_t>> equalRows = std::make_shared<std::vector<uint32_t>>();
+
         return std::make_shared<SimpleComputeExecutor>(
             output,
             [=](TupleSetPtr input) {
@@ -353,9 +404,27 @@ public:
                 // get the output column
                 std::vector<bool>& outColumn = output->getColumn<bool>(outAtt);
 
-                // loop down the columns, setting the output
+                // loop down the columns, setting the output; if the input has a selection
+                // vector, only the selected rows are set
                 int numTuples = leftColumn.size();
                 outColumn.resize(numTuples);
+                std::shared_ptr<std::vector<uint32_t>> selection = input->getSelection();
+
+                // if the kernels can select the equal rows, the output is cleared a word at a time
+                // and only the equal rows are set
+                if (selectEqualRows(leftColumn, rightColumn, selection.get(), *equalRows)) {
+                    outColumn.assign(numTuples, false);
+                    for (uint32_t i : *equalRows) {
+                        outColumn[i] = true;
+                    }
+                    return output;
+                }
+                if (selection != nullptr) {
+                    for (uint32_t i : *selection) {
+                        outColumn[i] = checkEquals(leftColumn[i], rightColumn[i]);
+                    }
+                    return output;
+                }
                 for (int i = 0; i < numTuples; i++) {
                     bool out = checkEquals(leftColumn[i], rightColumn[i]);
 
@@ -364,7 +433,8 @@ public:
                 return output;
             },
 
-            "equalsLambda");
+            "equalsLambda",
+            true);
     }
 
     ComputeExecutorPtr getRightHasher(TupleSpec& inputSchema,
@@ -58,15 +58,32 @@ public:
         // get the input column to use as a filter
         std::vector<bool>& inputColumn = input->getColumn<bool>(whichAtt);
 
-        // loop over the columns and filter
-        int numColumns = output->getNumColumns();
-        for (int i = 0; i < numColumns; i++) {
-            output->filterColumn(i, inputColumn);
+        // instead of filtering every column, we only record which rows are retained; the
+        // columns are compacted when an executor or a sink that needs them compacted sees them
+        std::shared_ptr<std::vector<uint32_t>> inputSelection = input->getSelection();
+        std::shared_ptr<std::vector<uint32_t>> selection =
+            std::make_shared<std::vector<uint32_t>>();
+        if (inputSelection == nullptr) {
+            uint32_t numTuples = inputColumn.size();
+            for (uint32_t i = 0; i < numTuples; i++) {
+                if (inputColumn[i])
+                    selection->push_back(i);
+            }
+        } else {
+            for (uint32_t i : *inputSelection) {
+                if (inputColumn[i])
+                    selection->push_back(i);
+            }
         }
+        output->setSelection(selection);
 
         return output;
     }
 
+    bool honorsSelection() override {
+        return true;
+    }
+
     std::string getType() override {
         return "FILTER";
     }
@@ -0,0 +1,86 @@
+#ifndef FUSED_FILTER_QUERY_EXEC_H
+#define FUSED_FILTER_QUERY_EXEC_H
+
+#include "ComputeExecutor.h"
+#include "TupleSetMachine.h"
+#include "TupleSet.h"
+#include "SimpleFilter.h"
+#include <vector>
+
+namespace pdb {
+
+// runs a selection predicate, i.e. a chain of applies that ends in a filter, as one operation:
+// the whole lambda tree of the predicate is run on each input object, so that no column is built
+// for the result of each lambda in the tree
+class FusedFilterExecutor : public ComputeExecutor {
+
+private:
+    // this is the output TupleSet that we return
+    TupleSetPtr output;
+
+    // the attribute holding the objects that the predicate runs on
+    int whichAtt;
+
+    // to setup the output tuple set
+    TupleSetSetupMachine myMachine;
+
+    // runs the lambda tree on one object
+    SimpleFilterPtr predicate;
+
+public:
+    FusedFilterExecutor(TupleSpec& inputSchema,
+                        TupleSpec& attsToOperateOn,
+                        TupleSpec& attsToIncludeInOutput,
+                        SimpleFilterPtr predicate)
+        : myMachine(inputSchema, attsToIncludeInOutput), predicate(predicate) {
+
+        // this is the input attribute that we will process
+        output = std::make_shared<TupleSet>();
+        std::vector<int> matches = myMachine.match(attsToOperateOn);
+        whichAtt = matches[0];
+    }
+
+    TupleSetPtr process(TupleSetPtr input) override {
+
+        if (input == nullptr) {
+            return nullptr;
+        }
+
+        // set up the output tuple set
+        myMachine.setup(input, output);
+
+        // get the objects to run the predicate on
+        std::vector<Handle<Object>>& inputColumn = input->getColumn<Handle<Object>>(whichAtt);
+
+        // as in FilterExecutor, we only record which rows are retained
+        std::shared_ptr<std::vector<uint32_t>> inputSelection = input->getSelection();
+        std::shared_ptr<std::vector<uint32_t>> selection =
+            std::make_shared<std::vector<uint32_t>>();
+        if (inputSelection == nullptr) {
+            uint32_t numTuples = inputColumn.size();
+            for (uint32_t i = 0; i < numTuples; i++) {
+                if (predicate->filter(inputColumn[i]))
+                    selection->push_back(i);
+            }
+        } else {
+            for (uint32_t i : *inputSelection) {
+                if (predicate->filter(inputColumn[i]))
+                    selection->push_back(i);
+            }
+        }
+        output->setSelection(selection);
+
+        return output;
+    }
+
+    bool honorsSelection() override {
+        return true;
+    }
+
+    std::string getType() override {
+        return "FUSED_FILTER";
+    }
+};
+}
+
+#endif
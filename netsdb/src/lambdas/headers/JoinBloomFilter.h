@@ -0,0 +1,158 @@
+#ifndef JOIN_BLOOM_FILTER_H
+#define JOIN_BLOOM_FILTER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <memory>
+#include <vector>
+
+// this file has the Bloom filter over the join hashes of the build side of a join.  The build
+// stage sets the bits of every hash that it puts to the join map, and the probe side drops the
+// tuples whose hash is surely not in the join map, before they are shuffled or probed.
+// It is a split block Bloom filter: a hash only sets and checks bits of one block of 256 bits
+// (eight words of 32 bits, one bit per word), so that a check touches one cache line.  The block
+// is chosen by the low bits of the mixed hash, so that a filter can be folded in half by OR-ing
+// its upper half to its lower half, which is how the filters of different sizes are merged
+
+namespace pdb {
+
+class JoinBloomFilter;
+typedef std::shared_ptr<JoinBloomFilter> JoinBloomFilterPtr;
+
+// the number of words in a block
+#define JOIN_FILTER_WORDS_PER_BLOCK 8
+
+class JoinBloomFilter {
+
+private:
+    // the bits of all blocks, eight words per block
+    std::vector<uint32_t> words;
+
+    // the number of blocks, which is a power of two
+    size_t numBlocks;
+
+    // the join hashes are not mixed well (e.g. the hash of an int is the int), so we mix them
+    // before taking the block and the bits from them
+    static inline uint64_t mix(uint64_t hash) {
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+        hash *= 0xc4ceb9fe1a85ec53ULL;
+        hash ^= hash >> 33;
+        return hash;
+    }
+
+    // the bit of each word of the block that a hash sets, which is taken from the high 32 bits
+    // of the mixed hash, times a different odd number for each word
+    static inline void makeMask(uint64_t mixed, uint32_t* mask) {
+        static const uint32_t salts[JOIN_FILTER_WORDS_PER_BLOCK] = {0x47b6137bU,
+                                                                    0x44974d91U,
+                                                                    0x8824ad5bU,
+                                                                    0xa2b7289dU,
+                                                                    0x705495c7U,
+                                                                    0x2df1424bU,
+                                                                    0x9efc4947U,
+                                                                    0x5c6bfb31U};
+        uint32_t key = (uint32_t)(mixed >> 32);
+        for (int i = 0; i < JOIN_FILTER_WORDS_PER_BLOCK; i++) {
+            mask[i] = ((uint32_t)1) << ((key * salts[i]) >> 27);
+        }
+    }
+
+public:
+    // creates an empty filter that has at least the given number of bytes
+    JoinBloomFilter(size_t numBytes) {
+        size_t blockSize = JOIN_FILTER_WORDS_PER_BLOCK * sizeof(uint32_t);
+        numBlocks = 1;
+        while (numBlocks * blockSize < numBytes) {
+            numBlocks = numBlocks * 2;
+        }
+        words.resize(numBlocks * JOIN_FILTER_WORDS_PER_BLOCK, 0);
+    }
+
+    // creates a filter from the words of another filter, e.g. of one that was sent to us
+    JoinBloomFilter(const uint32_t* fromWords, size_t numWords) {
+        words.assign(fromWords, fromWords + numWords);
+        numBlocks = numWords / JOIN_FILTER_WORDS_PER_BLOCK;
+    }
+
+    // adds a join hash; it can be called by multiple threads at the same time
+    void insert(size_t hash) {
+        uint64_t mixed = mix(hash);
+        uint32_t mask[JOIN_FILTER_WORDS_PER_BLOCK];
+        makeMask(mixed, mask);
+        uint32_t* block = &words[(mixed & (numBlocks - 1)) * JOIN_FILTER_WORDS_PER_BLOCK];
+        for (int i = 0; i < JOIN_FILTER_WORDS_PER_BLOCK; i++) {
+            if ((block[i] & mask[i]) != mask[i]) {
+                __atomic_fetch_or(&block[i], mask[i], __ATOMIC_RELAXED);
+            }
+        }
+    }
+
+    // returns false if the join hash has surely not been added
+    bool mayContain(size_t hash) const {
+        uint64_t mixed = mix(hash);
+        uint32_t mask[JOIN_FILTER_WORDS_PER_BLOCK];
+        makeMask(mixed, mask);
+        const uint32_t* block = &words[(mixed & (numBlocks - 1)) * JOIN_FILTER_WORDS_PER_BLOCK];
+        uint32_t missing = 0;
+        for (int i = 0; i < JOIN_FILTER_WORDS_PER_BLOCK; i++) {
+            missing |= mask[i] & ~block[i];
+        }
+        return missing == 0;
+    }
+
+    // halves the filter until it has no more than the given number of blocks; the filter still
+    // contains all hashes, with more false positives
+    void fold(size_t toNumBlocks) {
+        while ((numBlocks > toNumBlocks) && (numBlocks > 1)) {
+            size_t half = numBlocks / 2 * JOIN_FILTER_WORDS_PER_BLOCK;
+            for (size_t i = 0; i < half; i++) {
+                words[i] |= words[half + i];
+            }
+            numBlocks = numBlocks / 2;
+            words.resize(half);
+        }
+    }
+
+    // adds all hashes of another filter, given by its words; the bigger of the two filters is
+    // folded to the size of the smaller one
+    void merge(const uint32_t* otherWords, size_t numOtherWords) {
+        size_t numOtherBlocks = numOtherWords / JOIN_FILTER_WORDS_PER_BLOCK;
+        fold(numOtherBlocks);
+        size_t numMyWords = words.size();
+        for (size_t i = 0; i < numOtherWords; i++) {
+            words[i % numMyWords] |= otherWords[i];
+        }
+    }
+
+    // returns the number of blocks that gives at least the given number of bits to each of the
+    // given number of keys
+    static size_t getNumBlocksForKeys(size_t numKeys, size_t bitsPerKey) {
+        size_t blockBits = JOIN_FILTER_WORDS_PER_BLOCK * 32;
+        size_t numBlocks = 1;
+        while (numBlocks * blockBits < numKeys * bitsPerKey) {
+            numBlocks = numBlocks * 2;
+        }
+        return numBlocks;
+    }
+
+    size_t getNumBlocks() const {
+        return numBlocks;
+    }
+
+    size_t getNumBits() const {
+        return words.size() * 32;
+    }
+
+    const uint32_t* getWords() const {
+        return words.data();
+    }
+
+    size_t getNumWords() const {
+        return words.size();
+    }
+};
+}
+
+#endif
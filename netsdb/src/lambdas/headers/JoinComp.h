@@ -29,6 +29,13 @@ public:
     // the location of the partitioned hash table
     PartitionedHashSetPtr partitionedHashSet;
 
+    // the locations of the hash tables that the build of the partition spilled, which are
+    // probed together with the hash table at pageWhereHashTableIs
+    std::vector<void*> spilledHashTables;
+
+    // the Bloom filter over the hashes in the hash tables, if the build made one
+    JoinBloomFilterPtr joinFilter = nullptr;
+
 
     JoinArg(ComputePlan& plan, void* pageWhereHashTableIs, 
             PartitionedHashSetPtr partitionedHashSet)
@@ -67,6 +74,11 @@ protected:
     // JiaNote: the data proxy for accessing pages in frontend storage server.
     DataProxyPtr proxy = nullptr;
 
+    // the Bloom filter over the hashes of the other side of a hash partitioned join, which the
+    // sink uses to drop the tuples that have no match before they are shuffled.
+    // be careful here that we put JoinBloomFilterPtr in a pdb object.
+    JoinBloomFilterPtr joinFilter = nullptr;
+
     // batch size
     int batchSize;
 
@@ -125,6 +137,11 @@ public:
         this->proxy = proxy;
     }
 
+    // to set the Bloom filter that the partitioned sink applies (used in hash partition join)
+    void setJoinFilter(JoinBloomFilterPtr joinFilter) {
+        this->joinFilter = joinFilter;
+    }
+
     // to set chunk size for JoinSource (used in hash partition join)
     void setBatchSize(int batchSize) override {
         this->batchSize = batchSize;
@@ -454,7 +471,8 @@ public:
                                                         attsToOpOn,
                                                         projection,
                                                         whereEveryoneGoes,
-							this->joinType);
+							this->joinType,
+                                                        this->joinFilter);
         } else {
             return nullptr;
         }
@@ -761,7 +779,9 @@ public:
                                            pipelinedInputSchema,
                                            pipelinedAttsToOperateOn,
                                            pipelinedAttsToIncludeInOutput,
-                                           needToSwapAtts);
+                                           needToSwapAtts,
+                                           joinArg.spilledHashTables,
+                                           joinArg.joinFilter);
         } else {
 
             return correctJoinTuple->getPartitionedProber(joinArg.partitionedHashSet,
@@ -773,7 +793,8 @@ public:
                                                           pipelinedAttsToIncludeInOutput,
                                                           needToSwapAtts,
 							  joinType,
-							  threadId);
+							  threadId,
+                                                          joinArg.joinFilter);
 
         }
     }
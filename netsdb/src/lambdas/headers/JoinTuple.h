@@ -10,6 +10,7 @@
 #include "PDBPage.h"
 #include "RecordIterator.h"
 #include "PartitionedHashSet.h"
+#include "UseTemporaryAllocationBlock.h"
 
 namespace pdb {
 
@@ -274,6 +275,25 @@ typename std::enable_if<sizeof(TypeToTruncate::myOtherData) != 0, void>::type tr
     truncate<decltype(TypeToTruncate::myOtherData)>(i, whichVec + 1, us);
 }
 
+// this unpacks the matches of a hash in a map that the build of a partition spilled to the output
+// columns, and returns the number of matches
+template <typename RHSType>
+int probeSpilledJoinMap(JoinMap<RHSType>& spilledTable,
+                        size_t hash,
+                        int& overallCounter,
+                        void** columns) {
+    int numHits = spilledTable.count(hash);
+    if (numHits > 0) {
+        auto a = spilledTable.lookup(hash);
+        numHits = a.size();
+        for (int which = 0; which < numHits; which++) {
+            unpack(a[which], overallCounter, 0, columns);
+            overallCounter++;
+        }
+    }
+    return numHits;
+}
+
 // this clsas is used to encapaulte the computation that is responsible for probing a partitioned hash table
 template <typename RHSType>
 class PartitionedJoinProbe : public ComputeExecutor {
@@ -298,6 +318,9 @@ private:
     // the hash talbe we are processing
     std::vector<Handle<JoinMap<RHSType>>> inputTables;
 
+    // the maps that the build of each partition spilled, which are probed after inputTables
+    std::vector<std::vector<Handle<JoinMap<RHSType>>>> spilledTables;
+
     // the list of counts for matches of each of the input tuples
     std::vector<uint32_t> counts;
 
@@ -314,6 +337,9 @@ private:
 
     int threadId;
 
+    // the Bloom filter over the hashes in the partitioned hash table, if any
+    JoinBloomFilterPtr joinFilter;
+
 public:
     ~PartitionedJoinProbe() {
     }
@@ -336,7 +362,8 @@ public:
               TupleSpec& attsToIncludeInOutput,
               bool needToSwapLHSAndRhs,
 	      JoinType partitionedJoinType,
-	      int threadId)
+	      int threadId,
+              JoinBloomFilterPtr joinFilter = nullptr)
         : myMachine(inputSchema, attsToIncludeInOutput) {
         std::cout << "*****Created a PartitionedJoinProbe instance with numPartitionsPerNode=" 
                   << numPartitionsPerNode << ", numNodes=" << numNodes << std::endl; 
@@ -344,6 +371,9 @@ public:
         this->numNodes = numNodes;
 	this->partitionedJoinType = partitionedJoinType;
         this->threadId = threadId;
+        if (partitionedJoinType != CrossProduct) {
+            this->joinFilter = joinFilter;
+        }
 
         // extract the hash table we've been given
         for (int i = 0; i < partitionedHashTable->getNumPages(); i++) {
@@ -351,6 +381,12 @@ public:
            Record<JoinMap<RHSType>> * input = (Record<JoinMap<RHSType>>*)hashTable;
            Handle<JoinMap<RHSType>> inputTable = input->getRootObject();
            inputTables.push_back(inputTable);
+           std::vector<Handle<JoinMap<RHSType>>> mySpilledTables;
+           for (PDBPagePtr page : partitionedHashTable->getSpilledPages(i)) {
+               Record<JoinMap<RHSType>>* spilled = (Record<JoinMap<RHSType>>*)page->getBytes();
+               mySpilledTables.push_back(spilled->getRootObject());
+           }
+           spilledTables.push_back(mySpilledTables);
         }
 
         // set up the output tuple
@@ -391,6 +427,11 @@ public:
         int overallCounter = 0;
         for (int i = 0; i < inputHash.size(); i++) {
             size_t value = inputHash[i];
+            // skip the hash tables if the hash is surely not in them
+            if ((joinFilter != nullptr) && (joinFilter->mayContain(value) == false)) {
+                counts[i] = 0;
+                continue;
+            }
             //to see which hash the i-th element should go
             size_t index;
 	   
@@ -413,6 +454,9 @@ public:
                     overallCounter++;
                 }
             }
+            for (auto& spilledTable : spilledTables[index]) {
+                numHits += probeSpilledJoinMap(*spilledTable, value, overallCounter, columns);
+            }
             // remember how many matches we had
             counts[i] = numHits;
             std::cout << "hash=" << value <<", index=" << index << ", counts[" << i << "]=" << numHits << std::endl;
@@ -451,6 +495,12 @@ private:
     // the hash talbe we are processing
     Handle<JoinMap<RHSType>> inputTable;
 
+    // the maps that the build of the partition spilled, which are probed after inputTable
+    std::vector<Handle<JoinMap<RHSType>>> spilledTables;
+
+    // the Bloom filter over the hashes in inputTable and spilledTables, if any
+    JoinBloomFilterPtr joinFilter;
+
     // the list of counts for matches of each of the input tuples
     std::vector<uint32_t> counts;
 
@@ -480,8 +530,10 @@ public:
               TupleSpec& inputSchema,
               TupleSpec& attsToOperateOn,
               TupleSpec& attsToIncludeInOutput,
-              bool needToSwapLHSAndRhs)
-        : myMachine(inputSchema, attsToIncludeInOutput) {
+              bool needToSwapLHSAndRhs,
+              std::vector<void*> spilledHashTables = std::vector<void*>(),
+              JoinBloomFilterPtr joinFilter = nullptr)
+        : myMachine(inputSchema, attsToIncludeInOutput), joinFilter(joinFilter) {
 
         // extract the hash table we've been given
         Record<JoinMap<RHSType>>* input = (Record<JoinMap<RHSType>>*)hashTable;
@@ -490,6 +542,10 @@ public:
         } else {
             inputTable = input->getRootObject();
         }
+        for (void* spilledHashTable : spilledHashTables) {
+            Record<JoinMap<RHSType>>* spilled = (Record<JoinMap<RHSType>>*)spilledHashTable;
+            spilledTables.push_back(spilled->getRootObject());
+        }
         std::cout << "inputTable->size()=" << inputTable->size() << std::endl;
         // set up the output tuple
         output = std::make_shared<TupleSet>();
@@ -535,6 +591,12 @@ public:
         int overallCounter = 0;
         for (int i = 0; i < inputHash.size(); i++) {
 
+            // skip the hash tables if the hash is surely not in them
+            if ((joinFilter != nullptr) && (joinFilter->mayContain(inputHash[i]) == false)) {
+                counts[i] = 0;
+                continue;
+            }
+
             // deal with all of the matches
             int numHits = inputTableRef.count(inputHash[i]);
             if (numHits > 0) {
@@ -549,6 +611,9 @@ public:
                         overallCounter++;
                 }       
             }
+            for (auto& spilledTable : spilledTables) {
+                numHits += probeSpilledJoinMap(*spilledTable, inputHash[i], overallCounter, columns);
+            }
 
 
             // remember how many matches we had
@@ -588,8 +653,95 @@ public:
 
     int listIndex = 0;
 
+    // to get and write back the pages that we spill to, when the output map is full
+    std::function<std::pair<void*, size_t>()> getSpillPage = nullptr;
+
+    std::function<void(void*)> writeBackSpillPage = nullptr;
+
+    // true once the output map is full, so that all following records are spilled
+    bool outputFull = false;
+
+    // the page that we spill to, which has its own map, and the allocation block on it
+    void* spillPage = nullptr;
+
+    Handle<JoinMap<RHSType>> spillMap = nullptr;
+
+    UseTemporaryAllocationBlockPtr spillBlock = nullptr;
+
+    int numSpilledPages = 0;
+
+    // true once a build record is dropped, because it neither fits in the output map nor can be
+    // spilled, so that the build fails
+    bool failed = false;
+
+    // the Bloom filter that we add the hashes of the keys to, if any
+    JoinBloomFilterPtr joinFilter = nullptr;
+
     int getNumHashKeys() override { return this->numHashKeys; }
 
+    void setJoinFilter(JoinBloomFilterPtr joinFilter) override { this->joinFilter = joinFilter; }
+
+    int getNumSpilledPages() override { return this->numSpilledPages; }
+
+    bool hasFailed() override { return this->failed; }
+
+    void setSpillPages(std::function<std::pair<void*, size_t>()> getSpillPage,
+                       std::function<void(void*)> writeBackSpillPage) override {
+        this->getSpillPage = getSpillPage;
+        this->writeBackSpillPage = writeBackSpillPage;
+    }
+
+    void flushSpillPage() override {
+        if (spillPage == nullptr) {
+            return;
+        }
+        // make the spill map the root of the page, and leave the page without freeing the map
+        getRecord(spillMap);
+        spillMap.emptyOutContainingBlock();
+        spillBlock = nullptr;
+        writeBackSpillPage(spillPage);
+        spillPage = nullptr;
+        numSpilledPages++;
+    }
+
+    // to add a build record to the map on the spill page, and to move to a new spill page when
+    // that one is full
+    void spill(size_t myHash, RHSType& data) {
+        if (failed == true) {
+            return;
+        }
+        for (int tries = 0; tries < 2; tries++) {
+            if (spillPage == nullptr) {
+                std::pair<void*, size_t> page = getSpillPage();
+                if (page.first == nullptr) {
+                    std::cout << "ERROR: partition-" << partitionId << " can't get a spill page"
+                              << std::endl;
+                    failed = true;
+                    return;
+                }
+                spillPage = page.first;
+                spillBlock = std::make_shared<UseTemporaryAllocationBlock>(page.first, page.second);
+                spillMap = makeObject<JoinMap<RHSType>>();
+            }
+            RHSType* temp = nullptr;
+            try {
+                temp = &(spillMap->push(myHash));
+                packData(*temp, data);
+                return;
+            } catch (NotEnoughSpace& n) {
+                // only remove the record if it was pushed, as it would remove another record of
+                // the same hash otherwise
+                if (temp != nullptr) {
+                    spillMap->setUnused(myHash);
+                }
+                flushSpillPage();
+            }
+        }
+        std::cout << "ERROR: a build record of partition-" << partitionId
+                  << " doesn't fit in an empty spill page" << std::endl;
+        failed = true;
+    }
+
 
     Handle<Object> createNewOutputContainer() override {
 
@@ -620,6 +772,9 @@ public:
             size_t myHash = myList->getHash();
             if (mySize > 0) {
                 this->numHashKeys = this->numHashKeys + 1;
+                if (joinFilter != nullptr) {
+                    joinFilter->insert(myHash);
+                }
                 for (size_t i = listIndex; i < mySize; i++) {
                     try {
                         RHSType* temp = &(myMap.push(myHash));
@@ -643,6 +798,11 @@ public:
     //for hash partitioned join
     void writeVectorOut(Handle<Object> mergeMe, Handle<Object>& mergeToMe) override {
 
+        // the build already failed, and the rest of its records are dropped
+        if (failed == true) {
+            return;
+        }
+
         // get the map we are adding to
         Handle<JoinMap<RHSType>> mergedMap = unsafeCast<JoinMap<RHSType>>(mergeToMe);
         JoinMap<RHSType>& myMap = *mergedMap;
@@ -666,19 +826,35 @@ public:
                 size_t myHash = myList->getHash();
                 if (mySize > 0) {
                     this->numHashKeys = this->numHashKeys + 1;
+                    if (joinFilter != nullptr) {
+                        joinFilter->insert(myHash);
+                    }
                     for (size_t j = listIndex; j < mySize; j++) {
-                        try {
-                            RHSType* temp = &(myMap.push(myHash));
-                            packData(*temp, ((*myList)[j]));
-                        } catch (NotEnoughSpace& n) {
-                            myMap.setUnused(myHash);
-                            listIndex = j;
-                            mapIndex = counter;   
-                            std::cout << "FATAL ERROR: join data is too large to be built in one map, "
-                                         "results are truncated with listIndex=" << listIndex << ", mapIndex=" << mapIndex
-                                      << std::endl;
-                            exit(1);
+                        if (outputFull == false) {
+                            RHSType* temp = nullptr;
+                            try {
+                                temp = &(myMap.push(myHash));
+                                packData(*temp, ((*myList)[j]));
+                                continue;
+                            } catch (NotEnoughSpace& n) {
+                                if ((temp != nullptr) || (writeBackSpillPage == nullptr)) {
+                                    myMap.setUnused(myHash);
+                                }
+                                if (writeBackSpillPage == nullptr) {
+                                    listIndex = j;
+                                    mapIndex = counter;
+                                    std::cout << "ERROR: join data is too large to be built in one map, "
+                                                 "results are truncated with listIndex=" << listIndex << ", mapIndex=" << mapIndex
+                                              << std::endl;
+                                    failed = true;
+                                    return;
+                                }
+                                std::cout << "partition-" << partitionId << ": the hash map is full, "
+                                          << "to spill the rest of build records" << std::endl;
+                                outputFull = true;
+                            }
                         }
+                        spill(myHash, (*myList)[j]);
                     }
                     listIndex = 0;
                 }
@@ -1265,8 +1441,19 @@ private:
 
     int curPartitionId = 0;
 
+    // the Bloom filter over the hashes of the other side of the join, if it has been built; the
+    // tuples whose hash is surely not in it have no match, so they are not shuffled
+    JoinBloomFilterPtr joinFilter;
+
+    // the number of tuples that were dropped by the Bloom filter
+    size_t numFilteredOut = 0;
+
 public:
     ~PartitionedJoinSink() {
+        if (numFilteredOut > 0) {
+            std::cout << "PartitionedJoinSink: " << numFilteredOut
+                      << " tuples were dropped by the join filter" << std::endl;
+        }
     }
 
     PartitionedJoinSink(int numPartitionsPerNode,
@@ -1275,7 +1462,8 @@ public:
                         TupleSpec& attsToOperateOn,
                         TupleSpec& additionalAtts,
                         std::vector<int>& whereEveryoneGoes,
-			JoinType partitionedJoinType)
+			JoinType partitionedJoinType,
+                        JoinBloomFilterPtr joinFilter = nullptr)
         : whereEveryoneGoes(whereEveryoneGoes) {
 
         this->numPartitionsPerNode = numPartitionsPerNode;
@@ -1284,6 +1472,10 @@ public:
 
 	this->partitionedJoinType = partitionedJoinType;
 
+        if (partitionedJoinType != CrossProduct) {
+            this->joinFilter = joinFilter;
+        }
+
         // used to manage attributes and set up the output
         TupleSetSetupMachine myMachine(inputSchema);
 
@@ -1355,6 +1547,11 @@ public:
 	}
 
         for (size_t i = 0; i < length; i++) {
+            // drop the tuple if the other side has no match for it
+            if ((joinFilter != nullptr) && (joinFilter->mayContain(keyColumn[i]) == false)) {
+                numFilteredOut++;
+                continue;
+            }
 	    if (partitionedJoinType != CrossProduct) {
 #ifndef NO_MOD_PARTITION
                 index = keyColumn[i] % (this->numPartitionsPerNode * this->numNodes);
@@ -1586,7 +1783,9 @@ public:
                                          TupleSpec& inputSchema,
                                          TupleSpec& attsToOperateOn,
                                          TupleSpec& attsToIncludeInOutput,
-                                         bool needToSwapLHSAndRhs) = 0;
+                                         bool needToSwapLHSAndRhs,
+                                         std::vector<void*>& spilledHashTables,
+                                         JoinBloomFilterPtr joinFilter) = 0;
 
     virtual ComputeExecutorPtr getPartitionedProber(
               PartitionedHashSetPtr partitionedHashTable,
@@ -1598,7 +1797,8 @@ public:
               TupleSpec& attsToIncludeInOutput,
               bool needToSwapLHSAndRhs,
 	      JoinType partitionedJoinType,
-	      int threadId) = 0;
+	      int threadId,
+              JoinBloomFilterPtr joinFilter) = 0;
 
 
 
@@ -1613,7 +1813,8 @@ public:
                                               TupleSpec& attsToOpOn,
                                               TupleSpec& projection,
                                               std::vector<int>& whereEveryoneGoes,
-					      JoinType partitionedJoinType) = 0;
+					      JoinType partitionedJoinType,
+                                              JoinBloomFilterPtr joinFilter) = 0;
 
 
     virtual ComputeSourcePtr getPartitionedSource(size_t myPartitionId,
@@ -1642,13 +1843,17 @@ public:
                                  TupleSpec& inputSchema,
                                  TupleSpec& attsToOperateOn,
                                  TupleSpec& attsToIncludeInOutput,
-                                 bool needToSwapLHSAndRhs) override {
+                                 bool needToSwapLHSAndRhs,
+                                 std::vector<void*>& spilledHashTables,
+                                 JoinBloomFilterPtr joinFilter) override {
         return std::make_shared<JoinProbe<HoldMe>>(hashTable,
                                                    positions,
                                                    inputSchema,
                                                    attsToOperateOn,
                                                    attsToIncludeInOutput,
-                                                   needToSwapLHSAndRhs);
+                                                   needToSwapLHSAndRhs,
+                                                   spilledHashTables,
+                                                   joinFilter);
     }
 
 
@@ -1662,7 +1867,8 @@ public:
               TupleSpec& attsToIncludeInOutput,
               bool needToSwapLHSAndRhs,
 	      JoinType partitionedJoinType,
-              int threadId) override {
+              int threadId,
+              JoinBloomFilterPtr joinFilter) override {
 
         return std::make_shared<PartitionedJoinProbe<HoldMe>>(
                                                    partitionedHashTable,
@@ -1674,7 +1880,8 @@ public:
                                                    attsToIncludeInOutput,
                                                    needToSwapLHSAndRhs,
 						   partitionedJoinType,
-						   threadId);
+						   threadId,
+                                                   joinFilter);
 
   }
 
@@ -1696,9 +1903,10 @@ public:
                                       TupleSpec& attsToOpOn,
                                       TupleSpec& projection,
                                       std::vector<int>& whereEveryoneGoes,
-				      JoinType partitionedJoinType) override {
+				      JoinType partitionedJoinType,
+                                      JoinBloomFilterPtr joinFilter) override {
         return std::make_shared<PartitionedJoinSink<HoldMe>>(
-            numPartitionsPerNode, numNodes, consumeMe, attsToOpOn, projection, whereEveryoneGoes, partitionedJoinType);
+            numPartitionsPerNode, numNodes, consumeMe, attsToOpOn, projection, whereEveryoneGoes, partitionedJoinType, joinFilter);
     }
 
     // JiaNote: create a partitioned source for this particular type
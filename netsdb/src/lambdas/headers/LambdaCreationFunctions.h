@@ -251,10 +251,16 @@ makeLambdaUsingMethod(
     std::function<size_t(Handle<Object>)> getHash) {
     PDB_COUT << "makeLambdaFromMethod: input type code is " << var.getExactTypeInfoValue()
              << std::endl;
+    // the method output is converted into a pointer when the method is called on one object
+    std::function<Ptr<typename std::remove_reference<ReturnType>::type>(Handle<Object>&)>
+        objectEvaluator = [arg](Handle<Object>& input) {
+            Handle<ClassType>& myIn = *((Handle<ClassType>*)&input);
+            return Ptr<typename std::remove_reference<ReturnType>::type>(&(((*myIn).*arg)()));
+        };
     return LambdaTree<Ptr<typename std::remove_reference<ReturnType>::type>>(
         std::make_shared<
             MethodCallLambda<Ptr<typename std::remove_reference<ReturnType>::type>, ClassType>>(
-            inputTypeName, methodName, returnTypeName, var, columnBuilder, getExecutor, getPartitioner, getHash));
+            inputTypeName, methodName, returnTypeName, var, columnBuilder, getExecutor, getPartitioner, getHash, objectEvaluator));
 }
 
 template <typename ReturnType, typename ClassType>
@@ -271,8 +277,12 @@ makeLambdaUsingMethod(
     std::function<size_t(Handle<Object>)> getHash) {
     PDB_COUT << "makeLambdaFromMethod: input type code is " << var.getExactTypeInfoValue()
              << std::endl;
+    std::function<ReturnType(Handle<Object>&)> objectEvaluator = [arg](Handle<Object>& input) {
+        Handle<ClassType>& myIn = *((Handle<ClassType>*)&input);
+        return ((*myIn).*arg)();
+    };
     return LambdaTree<ReturnType>(std::make_shared<MethodCallLambda<ReturnType, ClassType>>(
-        inputTypeName, methodName, returnTypeName, var, columnBuilder, getExecutor, getPartitioner, getHash));
+        inputTypeName, methodName, returnTypeName, var, columnBuilder, getExecutor, getPartitioner, getHash, objectEvaluator));
 }
 
 // called if ReturnType is a reference
@@ -395,9 +405,19 @@ extern int mapToPartitionId (size_t hashVal, int numPartitions);
                             Ptr<typename std::remove_reference<decltype(VAR->METHOD())>::type>>(   \
                             outAtt);                                                               \
                                                                                                    \
-                    /* loop down the column, setting the output */                                 \
+                    /* loop down the column, setting the output; if the input has a selection      \
+                     * vector, only the selected rows are set */                                   \
                     int numTuples = inputColumn.size();                                            \
                     outColumn.resize(numTuples);                                                   \
+                    std::shared_ptr<std::vector<uint32_t>> selection = input->getSelection();      \
+                    if (selection != nullptr) {                                                    \
+                        for (uint32_t i : *selection) {                                            \
+                            outColumn[i] =                                                         \
+                                tryReference<std::is_reference<decltype(VAR->METHOD())>::value>(   \
+                                    inputColumn[i]->METHOD());                                     \
+                        }                                                                          \
+                        return output;                                                             \
+                    }                                                                              \
                     for (int i = 0; i < numTuples; i++) {                                          \
                         outColumn[i] =                                                             \
                             tryReference<std::is_reference<decltype(VAR->METHOD())>::value>(       \
@@ -441,15 +461,23 @@ extern int mapToPartitionId (size_t hashVal, int numPartitions);
                             typename std::remove_reference<decltype(VAR->METHOD())>::type>(        \
                             outAtt);                                                               \
                                                                                                    \
-                    /* loop down the column, setting the output */                                 \
+                    /* loop down the column, setting the output; if the input has a selection      \
+                     * vector, only the selected rows are set */                                   \
                     int numTuples = inputColumn.size();                                            \
                     outColumn.resize(numTuples);                                                   \
+                    std::shared_ptr<std::vector<uint32_t>> selection = input->getSelection();      \
+                    if (selection != nullptr) {                                                    \
+                        for (uint32_t i : *selection) {                                            \
+                            outColumn[i] = inputColumn[i]->METHOD();                               \
+                        }                                                                          \
+                        return output;                                                             \
+                    }                                                                              \
                     for (int i = 0; i < numTuples; i++) {                                          \
                         outColumn[i] = inputColumn[i]->METHOD();                                   \
                     }                                                                              \
                     return output;                                                                 \
                 }                                                                                  \
-            });                                                                                    \
+            }, "methodCallLambda", true);                                                          \
         },                                                                                         \
         []() {                                                                                     \
                                                                                                    \
@@ -133,6 +133,12 @@ public:
     // this returns a partitioner that decides the node for dispatching each input object
     virtual SimplePartitionerPtr getObjectPartitioner() {return nullptr;}
 
+    // if this lambda returns a bool, this returns a filter that runs the whole lambda tree on one
+    // input object at a time, so that a selection predicate can be fused into one executor
+    // instead of building a column for each lambda in the tree; returns nullptr if some lambda in
+    // the tree can not be run on one object
+    virtual SimpleFilterPtr getPredicate() { return nullptr; }
+
 
     // this gets a hash value directly
     virtual size_t getHash(Handle<Object> input) { return 0; }
@@ -468,6 +474,20 @@ public:
     virtual ~GenericLambdaObject() {}
 };
 
+// wraps the evaluator of a lambda that returns a bool into a filter
+inline SimpleFilterPtr makeObjectPredicate(std::function<bool(Handle<Object>&)> evaluator) {
+    if (evaluator == nullptr) {
+        return nullptr;
+    }
+    return std::make_shared<SimpleFilter>(evaluator);
+}
+
+// called instead for the lambdas that do not return a bool
+template <typename Out>
+SimpleFilterPtr makeObjectPredicate(std::function<Out(Handle<Object>&)> evaluator) {
+    return nullptr;
+}
+
 // this is the lamda type... queries are written by supplying code that
 // creates these objects
 template <typename Out>
@@ -478,6 +498,18 @@ public:
         return getTypeName<Out>();
     }
 
+    // this returns a function that runs this lambda, together with all of its children, on one
+    // input object; the function is composed from the evaluators of the children when the lambda
+    // tree is built, so it is specialized for the types of the tree.  Returns nullptr if this
+    // lambda, or one of its children, can not be run on one object
+    virtual std::function<Out(Handle<Object>&)> getObjectEvaluator() {
+        return nullptr;
+    }
+
+    SimpleFilterPtr getPredicate() override {
+        return makeObjectPredicate(getObjectEvaluator());
+    }
+
     virtual ~TypedLambdaObject() {}
 };
 }
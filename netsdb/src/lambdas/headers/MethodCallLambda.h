@@ -16,6 +16,7 @@ public:
     std::function<bool(std::string&, TupleSetPtr, int)> columnBuilder;
     std::function<SimpleVectorPartitionerPtr()> getPartitionerFunc;
     std::function<size_t(Handle<Object>)> getHashFunc;
+    std::function<Out(Handle<Object>&)> objectEvaluator;
     std::string inputTypeName;
     std::string methodName;
     std::string returnTypeName;
@@ -31,11 +32,13 @@ public:
         std::function<bool(std::string&, TupleSetPtr, int)> columnBuilder,
         std::function<ComputeExecutorPtr(TupleSpec&, TupleSpec&, TupleSpec&)> getExecutorFunc,
         std::function<SimpleVectorPartitionerPtr()> getPartitionerFunc,
-        std::function<size_t(Handle<Object>)> getHashFunc)
+        std::function<size_t(Handle<Object>)> getHashFunc,
+        std::function<Out(Handle<Object>&)> objectEvaluator = nullptr)
         : getExecutorFunc(getExecutorFunc),
           columnBuilder(columnBuilder),
           getPartitionerFunc(getPartitionerFunc),
           getHashFunc(getHashFunc),
+          objectEvaluator(objectEvaluator),
           inputTypeName(inputTypeName),
           methodName(methodName),
           returnTypeName(returnTypeName) {
@@ -217,6 +220,10 @@ public:
         return getHashFunc(input);
     }
 
+    std::function<Out(Handle<Object>&)> getObjectEvaluator() override {
+        return objectEvaluator;
+    }
+
 
 };
 }
@@ -157,6 +157,11 @@ public:
         return this->chunkSize;
     }
 
+    // each chunk is a slice of the objects in a page, so any size works
+    bool isChunkSizeAdaptive() override {
+        return true;
+    }
+
     // returns the next tuple set to process, or nullptr if there is not one to process
     TupleSetPtr getNextTupleSet() override {
 
@@ -17,6 +17,11 @@
 #define DELAY_VALUE 4
 #endif
 
+// the number of chunks that the chunk size of a pipeline is fit to write to one output page
+#ifndef TARGET_CHUNKS_PER_PAGE
+#define TARGET_CHUNKS_PER_PAGE 8
+#endif
+
 namespace pdb {
 
 // this is used to buffer unwritten pages
@@ -53,6 +58,64 @@ struct MemoryHolder {
 
 typedef std::shared_ptr<MemoryHolder> MemoryHolderPtr;
 
+// this sets the chunk size of a pipeline from the bytes that a row of a chunk takes in the output
+// page, so that a chunk takes about 1/TARGET_CHUNKS_PER_PAGE of a page: large objects, such as
+// tensor blocks, get small chunks that don't overflow a page, and small objects get chunks as
+// large as the batch size of the source
+class ChunkSizeController {
+
+private:
+    // the chunk size that we never go above, which is the batch size of the source
+    size_t maxChunkSize = 0;
+
+    // the chunk size that we use
+    size_t chunkSize = 0;
+
+    // the moving average of the bytes that a row takes, or 0 if we've not seen a chunk yet
+    double bytesPerRow = 0;
+
+public:
+    void setMaxChunkSize(size_t maxChunkSizeIn) {
+        maxChunkSize = (maxChunkSizeIn < MIN_BATCH_SIZE) ? MIN_BATCH_SIZE : maxChunkSizeIn;
+        chunkSize = maxChunkSize;
+    }
+
+    size_t getChunkSize() {
+        return chunkSize;
+    }
+
+    double getBytesPerRow() {
+        return bytesPerRow;
+    }
+
+    // records that a chunk of numRows rows took numBytes bytes in a page of pageSize bytes, and
+    // moves the chunk size towards the one that takes the target share of a page; it at most
+    // doubles per chunk, so that a few small rows don't make the next chunk overflow
+    void observe(size_t numBytes, int numRows, size_t pageSize) {
+        if (numRows <= 0) {
+            return;
+        }
+        double sample = (double)numBytes / numRows;
+        bytesPerRow = (bytesPerRow == 0) ? sample : 0.75 * bytesPerRow + 0.25 * sample;
+        size_t target = (size_t)(pageSize / TARGET_CHUNKS_PER_PAGE / bytesPerRow);
+        if (target > 2 * chunkSize) {
+            target = 2 * chunkSize;
+        }
+        if (target > maxChunkSize) {
+            target = maxChunkSize;
+        }
+        if (target < MIN_BATCH_SIZE) {
+            target = MIN_BATCH_SIZE;
+        }
+        chunkSize = target;
+    }
+
+    // halves the chunk size, when a chunk did not fit in a page
+    void shrink() {
+        chunkSize = (chunkSize / 2 < MIN_BATCH_SIZE) ? MIN_BATCH_SIZE : chunkSize / 2;
+    }
+};
+
 // this is a prototype for the pipeline
 class Pipeline {
 
@@ -85,6 +148,14 @@ private:
 
     int delay = DELAY_VALUE;
 
+    // fits the chunk size of the source to the output pages
+    ChunkSizeController chunkSizeController;
+
+    // the number of chunks that were split because they didn't fit in a page, and the number of
+    // splits whose halves are running
+    size_t numSplits = 0;
+    int numSplitsRunning = 0;
+
 public:
 
     int id;
@@ -190,8 +261,112 @@ public:
         }
     }
 
-    // runs the pipeline
-    void run() {
+    // gets a new output page after the current one ran out of memory, keeping the current one
+    // until no chunk can point into it; returns false if there is no more memory for a page
+    bool getNextOutputPage(MemoryHolderPtr& myRAM, int& iteration, int where) {
+        myRAM->setIteration(iteration);
+        unwrittenPages.push(myRAM);
+        std::cout << id << ": " << where << "- setIteration=" << iteration << std::endl;
+        iteration++;
+        // the halves of a split chunk may point into any page since the chunk was split
+        if (numSplitsRunning == 0) {
+            cleanPages(iteration);
+        }
+        std::cout << id << ": to get a new output page" << std::endl;
+        myRAM = std::make_shared<MemoryHolder>(getNewPage());
+        if (myRAM->location == nullptr) {
+            std::cout << id << ": ERROR: insufficient memory in heap or the corresponding "
+                      << "partition sink is used up" << std::endl;
+            return false;
+        }
+        std::cout << id << ": got a new output page" << std::endl;
+        return true;
+    }
+
+    // runs a chunk through the stages of the pipeline from firstStage on, and writes it out.
+    // If a stage runs out of memory on a fresh output page, the chunk that the stage got is
+    // split in two halves, which are run from that stage on one after the other, instead of
+    // giving up on the batch.  Returns false if the pipeline can't go on
+    bool runChunk(TupleSetPtr curChunk, size_t firstStage, MemoryHolderPtr& myRAM, int& iteration) {
+
+        // go through all of the pipeline stages
+        for (size_t stage = firstStage; stage < pipeline.size(); stage++) {
+
+            ComputeExecutorPtr& q = pipeline[stage];
+
+            // a filter only leaves a selection vector in the chunk, so we compact the
+            // columns just before the first executor that needs them compacted
+            if ((curChunk != nullptr) && (!q->honorsSelection())) {
+                curChunk->compact();
+            }
+
+            try {
+                curChunk = q->process(curChunk);
+
+            } catch (NotEnoughSpace& n) {
+                // and get a new page
+                if (!getNextOutputPage(myRAM, iteration, 2)) {
+                    return false;
+                }
+                myRAM->outputSink = dataSink->createNewOutputContainer();
+
+                // then try again
+                try {
+                    curChunk = q->process(curChunk);
+                } catch (NotEnoughSpace& n) {
+                    TupleSetPtr firstHalf;
+                    TupleSetPtr secondHalf;
+                    if ((curChunk == nullptr) || (!curChunk->split(firstHalf, secondHalf))) {
+                        std::cout << id << ": Pipeline Error: one row needs more memory than a "
+                                  << "page for executor type: " << q->getType()
+                                  << ", consider to increase page size. Current page size is "
+                                  << myRAM->getSize() << std::endl;
+                        return false;
+                    }
+                    std::cout << id << ": a chunk of " << curChunk->getNumSelectedRows()
+                              << " rows needs more memory than a page for executor type: "
+                              << q->getType() << ", so we run it in two halves" << std::endl;
+                    numSplits++;
+                    chunkSizeController.shrink();
+                    numSplitsRunning++;
+                    bool ret = runChunk(firstHalf, stage, myRAM, iteration) &&
+                        runChunk(secondHalf, stage, myRAM, iteration);
+                    numSplitsRunning--;
+                    return ret;
+                }
+            }
+        }
+
+        // the sinks write out all rows of the columns
+        if (curChunk != nullptr) {
+            curChunk->compact();
+        }
+
+        bool end = false;
+        while (!end) {
+            try {
+
+                if (myRAM->outputSink == nullptr) {
+                    myRAM->outputSink = dataSink->createNewOutputContainer();
+                }
+                dataSink->writeOut(curChunk, myRAM->outputSink);
+                end = true;
+
+            } catch (NotEnoughSpace& n) {
+
+                // again, we ran out of RAM here, so write back the page and then create a new
+                // output page
+                if (!getNextOutputPage(myRAM, iteration, 3)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // runs the pipeline; returns false if the pipeline stops before its source is processed, in
+    // which case the results are partial and the stage that runs it must fail
+    bool run() {
 
         // this is where we are outputting all of our results to
         std::cout << id << ": to get a new output page" << std::endl;
@@ -200,10 +375,13 @@ public:
 
         if (myRAM->location == nullptr) {
             std::cout << "ERROR: insufficient memory in heap" << std::endl;
-            exit(1);
+            return false;
         }
         myRAM->outputSink = dataSink->createNewOutputContainer();
 
+        // the chunk size of the source is the largest that we use
+        chunkSizeController.setMaxChunkSize(dataSource->getChunkSize());
+
         // and here is the chunk
         TupleSetPtr curChunk = nullptr;
 
@@ -219,17 +397,8 @@ public:
                curChunk = dataSource->getNextTupleSet();
            } catch (NotEnoughSpace& n) {
                curChunk = nullptr;
-               myRAM->setIteration(iteration);
-               unwrittenPages.push(myRAM);
-               std::cout << id << ": 1- setIteration=" << iteration << std::endl;
-               iteration++;
-               cleanPages(iteration);
-               std::cout << id <<": to get a new output page" << std::endl;
-               myRAM = std::make_shared<MemoryHolder>(getNewPage());
-               std::cout << id <<": got a new output page" << std::endl;
-               if (myRAM->location == nullptr) {
-                   std::cout << id << ": ERROR: insufficient memory in heap" << std::endl;
-                   return;
+               if (!getNextOutputPage(myRAM, iteration, 1)) {
+                   return false;
                }
                myRAM->outputSink = dataSink->createNewOutputContainer();
                curChunk = dataSource->getNextTupleSet();
@@ -239,87 +408,40 @@ public:
                std::cout << id << ": WARNING: get an empty chunk in pipeline" << std::endl;
                break;
            }
-           
-           //if (id==1)
-               //std::cout << id << ": got a chunk to feed to pipeline" << std::endl;
-            // go through all of the pipeline stages
-           for (ComputeExecutorPtr& q : pipeline) {
-
-                try {
-                    curChunk = q->process(curChunk);
-                //if (id==1)
-                    //std::cout << id << ": processed a chunk" << std::endl;
 
-                } catch (NotEnoughSpace& n) {
-                    // and get a new page
-                    myRAM->setIteration(iteration);
-                    unwrittenPages.push(myRAM);
-                    std::cout << id << ": 2- setIteration=" << iteration << std::endl;
-                    iteration++;
-                    cleanPages(iteration);
-                    std::cout << id <<": to get a new output page" << std::endl;
-                    myRAM = std::make_shared<MemoryHolder>(getNewPage());
-                    if (myRAM->location == nullptr) {
-                        std::cout << "ERROR: insufficient memory in heap or the corresponding partition sink is used up" << std::endl;
-                        return;
-                    }
-                    std::cout << id <<": got a new output page" << std::endl;
-                    myRAM->outputSink = dataSink->createNewOutputContainer();
+           // remember how much of the output page is free, to see how much the chunk takes
+           int numRows = curChunk->getNumSelectedRows();
+           MemoryHolderPtr pageBefore = myRAM;
+           size_t numSplitsBefore = numSplits;
+           size_t bytesBefore = getBytesAvailableInCurrentAllocatorBlock();
 
-                    // then try again
-                    try {
-                        curChunk = q->process(curChunk);
-                    } catch (NotEnoughSpace& n) {
-                        std::cout << id << ": curChunk contains " << curChunk->getNumRows(0) << " rows" 
-                                  << std::endl;
-                        std::cout << id << ": Pipeline Error: Batch processing memory exceeds page size "
-                                     "for executor type: "
-                                  << q->getType() << ", consider to reduce batch size or increase page size. Current batch size is "<<dataSource->getChunkSize() << ", current page size is "<< myRAM->getSize() << std::endl; 
-                        exit(1);
-                    }
-                }
+           if (!runChunk(curChunk, 0, myRAM, iteration)) {
+               return false;
            }
 
-           bool end = false;
-           while (!end) {
-                try {
-
-                   if (myRAM->outputSink == nullptr) {
-                       myRAM->outputSink = dataSink->createNewOutputContainer();
-                   }
-                   dataSink->writeOut(curChunk, myRAM->outputSink);
-                   //if (id==1)
-                        //std::cout << id << ": write out a chunk" << std::endl;
-                   end = true;                    
-
-                } catch (NotEnoughSpace& n) {
-
-                    // again, we ran out of RAM here, so write back the page and then create a new
-                    // output page
-                    myRAM->setIteration(iteration);
-                    unwrittenPages.push(myRAM);
-                    std::cout << id << ": 3- setIteration=" << iteration << std::endl;
-                    iteration++;
-                    cleanPages(iteration);
-                    std::cout << id <<": to get a new output page" << std::endl;
-                    myRAM = std::make_shared<MemoryHolder>(getNewPage());
-                    if (myRAM->location == nullptr) {
-                        std::cout << "ERROR: insufficient memory in heap or the corresponding partition sink is used up" << std::endl;
-                        return;
-                    }
-                    std::cout << id <<": got a new output page" << std::endl;
-                 }
+           // fit the chunk size to the bytes that a row takes, if the chunk ran on one page
+           if ((myRAM == pageBefore) && (numSplits == numSplitsBefore)) {
+               size_t bytesAfter = getBytesAvailableInCurrentAllocatorBlock();
+               if (bytesBefore > bytesAfter) {
+                   chunkSizeController.observe(bytesBefore - bytesAfter, numRows, myRAM->getSize());
+               }
+           }
+           if (dataSource->isChunkSizeAdaptive() &&
+               (dataSource->getChunkSize() != chunkSizeController.getChunkSize())) {
+               dataSource->setChunkSize(chunkSizeController.getChunkSize());
            }
-            // lastly, write back all of the output pages
         }
 
+        std::cout << id << ": ran with chunk size " << dataSource->getChunkSize() << ", "
+                  << numSplits << " chunks were split" << std::endl;
+
         // set the iteration
         myRAM->setIteration(iteration);
         std::cout << id << ": 4- setIteration=" << iteration << std::endl;
         // and remember the page
         unwrittenPages.push(myRAM);
         iteration++;
-
+        return true;
     }
 };
 
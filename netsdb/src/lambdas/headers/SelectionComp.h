@@ -6,6 +6,7 @@
 #include "VectorSink.h"
 #include "ScanUserSet.h"
 #include "TypeName.h"
+#include "DataTypes.h"
 
 namespace pdb {
 
@@ -22,6 +23,15 @@ public:
     // is inserted into the output set
     virtual Lambda<Handle<OutputClass>> getProjection(Handle<InputClass> checkMe) = 0;
 
+    // the planner calls this method to see if the selection can skip whole pages of the input
+    // set by their zone maps; override it to return a comparison "attribute op value" that every
+    // selected object satisfies, where attribute is declared as a zone map attribute of the set
+    virtual bool getZoneMapPredicate(std::string& attributeName,
+                                     ZoneMapComparisonOp& op,
+                                     double& value) {
+        return false;
+    }
+
     // calls getProjection and getSelection to extract the lambdas
     void extractLambdas(std::map<std::string, GenericLambdaObjectPtr>& returnVal) override {
         int suffix = 0;
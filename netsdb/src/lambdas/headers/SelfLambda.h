@@ -51,6 +51,13 @@ public:
         return nullptr;
     }
 
+    std::function<Ptr<ClassType>(Handle<Object>&)> getObjectEvaluator() override {
+        return [](Handle<Object>& input) {
+            Handle<ClassType>& myIn = *((Handle<ClassType>*)&input);
+            return Ptr<ClassType>((ClassType*)&(*myIn));
+        };
+    }
+
 
     //Assumption 1: Out type must have hash function defined
     //Assumption 2: numPartitions should be multiples of numNodes
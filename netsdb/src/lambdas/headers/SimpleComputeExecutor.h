@@ -24,14 +24,18 @@ private:
     // JiaNote: this is for debugging purpose
     std::string myType;
 
+    // whether processInput only looks at the rows in the selection vector of its input
+    bool selectionAware;
 
 public:
     SimpleComputeExecutor(TupleSetPtr outputIn,
                           std::function<TupleSetPtr(TupleSetPtr)> processInputIn,
-                          std::string myTypeIn = "SimpleComputeExecutor") {
+                          std::string myTypeIn = "SimpleComputeExecutor",
+                          bool selectionAwareIn = false) {
         output = outputIn;
         processInput = processInputIn;
         myType = myTypeIn;
+        selectionAware = selectionAwareIn;
     }
 
 
@@ -42,6 +46,10 @@ public:
         return processInput(input);
     }
 
+    bool honorsSelection() override {
+        return selectionAware;
+    }
+
     std::string getType() override {
         return myType;
     }
@@ -6,6 +6,8 @@
 
 #include "Object.h"
 #include "TupleSet.h"
+#include "JoinBloomFilter.h"
+#include <functional>
 
 
 namespace pdb {
@@ -31,6 +33,31 @@ public:
     // this returns number of hash keys
     virtual int getNumHashKeys() = 0;
 
+    // this lets writeVectorOut() spill what doesn't fit in the output container to pages that
+    // getSpillPage() returns, which are given to writeBackSpillPage() once they are full;
+    // without spill pages, writeVectorOut() fails when the output container is full
+    virtual void setSpillPages(std::function<std::pair<void*, size_t>()> getSpillPage,
+                               std::function<void(void*)> writeBackSpillPage) {}
+
+    // this writes back the spill page that is not full yet; it must be called before the
+    // output container is made a record
+    virtual void flushSpillPage() {}
+
+    // this returns number of pages that were spilled
+    virtual int getNumSpilledPages() {
+        return 0;
+    }
+
+    // this returns true if writeVectorOut() dropped records, because the output container was
+    // full and they couldn't be spilled
+    virtual bool hasFailed() {
+        return false;
+    }
+
+    // this lets the merger of a join add the hash of every key that it writes out to the given
+    // Bloom filter, which may be shared by the mergers of all partitions
+    virtual void setJoinFilter(JoinBloomFilterPtr joinFilter) {}
+
     virtual ~SinkMerger() {}
 };
 }
@@ -4,6 +4,7 @@
 
 #include "Handle.h"
 #include "PDBVector.h"
+#include "ColumnarView.h"
 #include <functional>
 
 namespace pdb {
@@ -48,79 +49,254 @@ class TupleSet;
 typedef std::shared_ptr<TupleSet> TupleSetPtr;
 
 // this structure contains type-specific information that will allow us to properly delete and/or
-// fliter
-// a column
+// fliter a column.  There is one instance for each column type, shared by all of the columns of
+// that type, and the functions are plain function pointers, so that nothing is copied when a
+// column is copied from one tuple set to another
 struct MaintenanceFuncs {
 
+    // this creates an empty column
+    void* (*create)();
+
     // this is a deleter for a particular column, stored as a void*
-    std::function<void(void*)> deleter;
+    void (*deleter)(void*);
+
+    // this empties a column, keeping its memory so that it can be reused
+    void (*clear)(void*);
 
-    // this is a filter function for a particular column
-    std::function<void*(void*, std::vector<bool>&)> filter;
+    // this is a filter function for a particular column, writing the rows that are retained to
+    // the second column
+    void (*filter)(void*, void*, std::vector<bool>&);
+
+    // this keeps the rows of a column at the given positions, to apply a selection vector
+    void (*select)(void*, void*, std::vector<uint32_t>&);
 
     // this replicates instances of a column to run a join
-    std::function<void*(void*, std::vector<uint32_t>&)> replicate;
+    void (*replicate)(void*, void*, std::vector<uint32_t>&);
 
     // JiaNote: this gets count for a particular column
-    std::function<size_t(void*)> getCount;
+    size_t (*getCount)(void*);
 
     // this is a function that creates and returns a pdb :: Vector for a column
-    std::function<Handle<Vector<Handle<Object>>>()> createPDBVector;
+    Handle<Vector<Handle<Object>>> (*createPDBVector)();
 
     // this function writes out the column to a pdb :: Vector
-    std::function<void(Handle<Vector<Handle<Object>>>&, void*, size_t&)> writeToVector;
+    void (*writeToVector)(Handle<Vector<Handle<Object>>>&, void*, size_t&);
 
     // this is the name of the type that we contain
     std::string typeContained;
 
-    // tells us if we need to delete
-    bool mustDelete;
-
     // tells us the serialized size of an object in this column
     size_t serializedSize;
+};
+
+// this is a column of a TupleSet
+struct TupleSetColumn {
+
+    // the column, which is a std :: vector of the type of the column, or nullptr if there is no
+    // such column
+    void* data = nullptr;
+
+    // the functions for the type of the column
+    MaintenanceFuncs* funcs = nullptr;
+
+    // tells us if we need to delete
+    bool mustDelete = false;
 
     // the last value that we wrote if we are writing out this column
     size_t lastWritten = 0;
 
-    // empty constructor
-    MaintenanceFuncs() {}
-
-    // fill all of the fields
-    MaintenanceFuncs(
-        std::function<void(void*)> deleter,
-        std::function<void*(void*, std::vector<bool>&)> filter,
-        std::function<void*(void*, std::vector<uint32_t>&)> replicate,
-        std::function<size_t(void*)> getCount,
-        std::function<Handle<Vector<Handle<Object>>>()> createPDBVector,
-        std::function<void(Handle<Vector<Handle<Object>>>&, void*, size_t&)> writeToVector,
-        bool mustDelete,
-        std::string typeContained,
-        size_t serializedSize)
-        : deleter(deleter),
-          filter(filter),
-          replicate(replicate),
-          getCount(getCount),
-          createPDBVector(createPDBVector),
-          writeToVector(writeToVector),
-          typeContained(typeContained),
-          mustDelete(mustDelete),
-          serializedSize(serializedSize) {}
+    // the columnar view of the objects in this column, if their attributes are also stored in
+    // contiguous arrays
+    ColumnarViewPtr view = nullptr;
+
+    // an empty column of the same type, which a filter, a selection, or a replication writes to
+    // instead of allocating a new column for every batch
+    void* spare = nullptr;
 };
 
+// gets the functions for a column type
+template <typename ColType>
+MaintenanceFuncs* getMaintenanceFuncs() {
+
+    static MaintenanceFuncs* funcs = []() {
+        MaintenanceFuncs* myFuncs = new MaintenanceFuncs;
+
+        myFuncs->create = []() {
+            std::vector<ColType>* newVec = new std::vector<ColType>;
+            if (newVec == nullptr) {
+                std::cout << "TupleSet.h: Failed to allocate memory " << std::endl;
+                exit(1);
+            }
+            return (void*)newVec;
+        };
+
+        myFuncs->deleter = [](void* deleteMe) {
+            std::vector<ColType>* killMe = (std::vector<ColType>*)deleteMe;
+            delete killMe;
+        };
+
+        myFuncs->clear = [](void* clearMe) {
+            ((std::vector<ColType>*)clearMe)->clear();
+        };
+
+        myFuncs->filter = [](void* filter, void* output, std::vector<bool>& whichAreValid) {
+            std::vector<ColType>& filterMe = *((std::vector<ColType>*)filter);
+            std::vector<ColType>& newVec = *((std::vector<ColType>*)output);
+
+            // count the number of rows that need to be retained
+            int counter = 0;
+            for (auto a : whichAreValid)
+                if (a)
+                    counter++;
+
+            // copy the ones that need to be retained over
+            newVec.resize(counter);
+            counter = 0;
+            for (size_t i = 0; i < filterMe.size(); i++) {
+                if (whichAreValid[i])
+                    newVec[counter++] = filterMe[i];
+            }
+        };
+
+        myFuncs->select = [](void* select, void* output, std::vector<uint32_t>& whichToKeep) {
+            std::vector<ColType>& selectFromMe = *((std::vector<ColType>*)select);
+            std::vector<ColType>& newVec = *((std::vector<ColType>*)output);
+            newVec.resize(whichToKeep.size());
+            for (size_t i = 0; i < whichToKeep.size(); i++) {
+                newVec[i] = selectFromMe[whichToKeep[i]];
+            }
+        };
+
+        myFuncs->replicate = [](void* replicate,
+                                void* output,
+                                std::vector<uint32_t>& timesToReplicate) {
+            std::vector<ColType>& replicateMe = *((std::vector<ColType>*)replicate);
+            std::vector<ColType>& newVec = *((std::vector<ColType>*)output);
+
+            // count the number of rows that need to be retained
+            int counter = 0;
+            for (auto& a : timesToReplicate)
+                counter += a;
+
+            // copy the ones that need to be retained over
+            newVec.resize(counter);
+            counter = 0;
+            for (size_t i = 0; i < timesToReplicate.size(); i++) {
+                for (uint32_t j = 0; j < timesToReplicate[i]; j++) {
+                    newVec[counter] = replicateMe[i];
+                    counter++;
+                }
+            }
+        };
+
+        // JiaNote: add getCount to get number of rows for a particular column at runtime
+        myFuncs->getCount = [](void* countMe) {
+            std::vector<ColType>* toCountRowsOfMe = (std::vector<ColType>*)countMe;
+            return toCountRowsOfMe->size();
+        };
+
+        // this is responsible for writing this column to an output vector
+        if (std::is_base_of<PtrBase, ColType>::value)
+            myFuncs->writeToVector =
+                [](Handle<Vector<Handle<Object>>>& writeToMe, void* writeMe, size_t& lastWritten) {
+                    std::vector<Ptr<Handle<Object>>>& writeMeOut =
+                        *((std::vector<Ptr<Handle<Object>>>*)writeMe);
+                    Vector<Handle<Object>>& outputToMe = *writeToMe;
+                    for (; lastWritten < writeMeOut.size(); lastWritten++) {
+                        Ptr<Handle<Object>> temp = writeMeOut[lastWritten];
+                        outputToMe.push_back(*(writeMeOut[lastWritten]));
+                    }
+                };
+        else
+            myFuncs->writeToVector = [](
+                Handle<Vector<Handle<Object>>>& writeToMe, void* writeMe, size_t& lastWritten) {
+                std::vector<Handle<Object>>& writeMeOut = *((std::vector<Handle<Object>>*)writeMe);
+                Vector<Handle<Object>>& outputToMe = *writeToMe;
+                for (; lastWritten < writeMeOut.size(); lastWritten++) {
+                    outputToMe.push_back(writeMeOut[lastWritten]);
+                }
+            };
+
+        // and this creates a pdb :: Vector to hold the column
+        myFuncs->createPDBVector = []() {
+            Handle<Vector<Handle<ColType>>> returnVal = makeObject<Vector<Handle<ColType>>>();
+            return unsafeCast<Vector<Handle<Object>>>(returnVal);
+        };
+
+        myFuncs->typeContained = getTypeName<ColType>();
+        myFuncs->serializedSize =
+            getSerializedSize<std::is_base_of<PtrBase, ColType>::value, ColType>();
+        return myFuncs;
+    }();
+    return funcs;
+}
+
 // this is the basic type that it pushed through the system during query processing
 class TupleSet {
 
 private:
-    // the key of this map is an integer (the identifier of the column)
-    // the value is a pair; the first is a pointer to the column, and the second is a pair of
-    // lambdas.  The first is a deleter (which frees the column) and the second is a condenser
-    // (that filters rows from the column)
-    std::map<int, std::pair<void*, MaintenanceFuncs>> columns;
+    // the columns, indexed by the identifier of the column; the identifiers are small and dense,
+    // so that an executor gets to a column without a lookup
+    std::vector<TupleSetColumn> columns;
+
+    // the number of columns that we have
+    int numColumns = 0;
+
+    // the selection vector: if not null, only the rows at these positions (in ascending order) are
+    // in the tuple set, and the other rows of the columns are garbage that is compacted away
+    // lazily.  A filter only sets the selection instead of copying every column, and executors
+    // that honor the selection only compute the selected rows
+    std::shared_ptr<std::vector<uint32_t>> selection = nullptr;
+
+    // gets the entry for a column, creating an empty one if needed
+    TupleSetColumn& getEntry(int whichColumn) {
+        if (whichColumn >= (int)columns.size()) {
+            columns.resize(whichColumn + 1);
+        }
+        return columns[whichColumn];
+    }
+
+    // gets rid of the data of a column, keeping it as the spare of the column if we own it, so
+    // that its memory is reused for the next version of the column
+    void releaseData(TupleSetColumn& value) {
+        if (value.data != nullptr && value.mustDelete) {
+            if (value.spare == nullptr) {
+                value.funcs->clear(value.data);
+                value.spare = value.data;
+            } else {
+                value.funcs->deleter(value.data);
+            }
+        }
+        value.data = nullptr;
+        value.mustDelete = false;
+    }
+
+    // changes the type of a column, getting rid of its spare if that has another type
+    void setType(TupleSetColumn& value, MaintenanceFuncs* funcs) {
+        if (value.funcs != funcs && value.spare != nullptr) {
+            value.funcs->deleter(value.spare);
+            value.spare = nullptr;
+        }
+        if (value.funcs == nullptr) {
+            numColumns++;
+        }
+        value.funcs = funcs;
+    }
+
+    // gets an empty column of the type of a column, to write a new version of the column to
+    void* getBuffer(TupleSetColumn& value) {
+        if (value.spare != nullptr) {
+            void* buffer = value.spare;
+            value.spare = nullptr;
+            return buffer;
+        }
+        return value.funcs->create();
+    }
 
 public:
     // get the number of columns in this TupleSet
     int getNumColumns() {
-        return columns.size();
+        return numColumns;
     }
 
     /* TODO: this will be needed to be able to do joins!!!
@@ -138,8 +314,8 @@ public:
     // this can be used at a later time to re-constitute the tuple set
     std::vector<std::string> getTypeNames() {
         std::vector<std::string> output;
-        for (int i = 0; columns.count(i) != 0; i++) {
-            output.push_back(columns[i].second.typeContained);
+        for (int i = 0; hasColumn(i); i++) {
+            output.push_back(columns[i].funcs->typeContained);
         }
         return output;
     }
@@ -157,7 +333,7 @@ public:
 
     //to tell whether a column exits
     bool existsColumn(int whichColumn) {
-       if (columns.count(whichColumn) == 0) {
+       if (!hasColumn(whichColumn)) {
             std::cout << "existsColumn: This is bad. Tried to get column " << whichColumn
                       << " but could not find it.\n";
             return false;
@@ -171,12 +347,12 @@ public:
     // return a specified column
     template <typename ColType>
     std::vector<ColType>& getColumn(int whichColumn) {
-        if (columns.count(whichColumn) == 0) {
+        if (!hasColumn(whichColumn)) {
             std::cout << "This is bad. Tried to get column " << whichColumn
                       << " but could not find it.\n";
             exit(1);
         }
-        return *((std::vector<ColType>*)columns[whichColumn].first);
+        return *((std::vector<ColType>*)columns[whichColumn].data);
     }
 
     // writes out a specified column... the boolean argument is true when we want to start from
@@ -185,7 +361,7 @@ public:
     void writeOutColumn(int whichColumn,
                         Handle<Vector<Handle<Object>>>& writeToMe,
                         bool startFromScratch) {
-        if (columns.count(whichColumn) == 0) {
+        if (!hasColumn(whichColumn)) {
             std::cout << "This is bad. Tried to write out column " << whichColumn
                       << " but could not find it.\n";
             exit(1);
@@ -194,52 +370,71 @@ public:
 
         // if we we need to start over, then do do
         if (startFromScratch)
-            which.second.lastWritten = 0;
+            which.lastWritten = 0;
 
-        which.second.writeToVector(writeToMe, which.first, which.second.lastWritten);
+        which.funcs->writeToVector(writeToMe, which.data, which.lastWritten);
     }
 
     // use the specified column to build pdb :: Vector of the correct type to hold the output
     // Note: this had better be a Vector <Handle <Something>> or we are going to have problems!!
     Handle<Vector<Handle<Object>>> getOutputVector(int whichColToOutput) {
-        return columns[whichColToOutput].second.createPDBVector();
+        return columns[whichColToOutput].funcs->createPDBVector();
     }
 
     // see if we have the specified column
     bool hasColumn(int whichColumn) {
-        return columns.count(whichColumn) != 0;
+        return whichColumn >= 0 && whichColumn < (int)columns.size() &&
+            columns[whichColumn].funcs != nullptr;
+    }
+
+    // attaches a columnar view to a column of objects; the view describes the objects that
+    // currently are in the column, in the same order
+    void setColumnarView(int whichColumn, ColumnarViewPtr view) {
+        if (hasColumn(whichColumn)) {
+            columns[whichColumn].view = view;
+        }
+    }
+
+    // returns the columnar view attached to a column, or nullptr if there is not one
+    ColumnarViewPtr getColumnarView(int whichColumn) {
+        if (!hasColumn(whichColumn)) {
+            return nullptr;
+        }
+        return columns[whichColumn].view;
     }
 
     ~TupleSet() {
 
-        // delete all of the columns
-        for (auto& a : columns) {
-            auto& res = a.second;
-            if (res.second.mustDelete)
-                res.second.deleter(res.first);
+        // delete all of the columns, and the spare ones
+        for (auto& res : columns) {
+            if (res.data != nullptr && res.mustDelete)
+                res.funcs->deleter(res.data);
+            if (res.spare != nullptr)
+                res.funcs->deleter(res.spare);
         }
     }
 
     // filters a column
     void filterColumn(int whichColToFilter, std::vector<bool>& usingMe) {
 
-        // kill the old one so we don't have a memory leak
         if (hasColumn(whichColToFilter)) {
 
             // filter the column, getting a new version
             auto& value = columns[whichColToFilter];
-            auto res = value.second.filter(value.first, usingMe);
+            void* res = getBuffer(value);
+            value.funcs->filter(value.data, res, usingMe);
 
-            // delete the old one, if necessary
-            if (value.second.mustDelete) {
-                value.second.deleter(value.first);
-            }
+            // get rid of the old one, recycling it if it is ours
+            releaseData(value);
 
-            // record the new column
-            value.first = res;
+            // record the new column, and remember that we need to delete it
+            value.data = res;
+            value.mustDelete = true;
 
-            // remember that we need to delete it
-            value.second.mustDelete = true;
+            // and keep the columnar view in line with the column
+            if (value.view != nullptr) {
+                value.view = value.view->filter(usingMe);
+            }
             return;
         }
 
@@ -253,190 +448,204 @@ public:
                    int whichColToCopyTo,
                    std::vector<uint32_t>& replications) {
 
-        // kill the old one so we don't have a memory leak
-        if (hasColumn(whichColToCopyTo)) {
-            // delete the existing column, if necessary
-            auto& value = columns[whichColToCopyTo];
-            if (value.second.mustDelete) {
-                value.second.deleter(value.first);
+        auto& from = fromMe->columns[whichColInFromMe];
+        ColumnarViewPtr view = from.view;
+        void* fromData = from.data;
+        MaintenanceFuncs* funcs = from.funcs;
+        size_t lastWritten = from.lastWritten;
+
+        // get the target column, which has the type of the column that we replicate
+        auto& value = getEntry(whichColToCopyTo);
+        if (value.funcs != funcs) {
+            if (value.funcs != nullptr) {
+                releaseData(value);
             }
+            setType(value, funcs);
         }
 
-        // create a copy of the maintenance funcs
-        auto& value = fromMe->columns[whichColInFromMe];
-        MaintenanceFuncs temp = value.second;
+        // and go ahead and replicate the column
+        void* newCol = getBuffer(value);
+        funcs->replicate(fromData, newCol, replications);
+
+        // get rid of the old one, recycling it if it is ours
+        releaseData(value);
 
         // remember that this is a deep copy... so we need to delete
-        temp.mustDelete = true;
+        value.data = newCol;
+        value.mustDelete = true;
+        value.lastWritten = lastWritten;
 
-        // and go ahead and replicate the column
-        void* newCol = temp.replicate(value.first, replications);
+        // and keep the columnar view in line with the column
+        value.view = (view != nullptr) ? view->replicate(replications) : nullptr;
+    }
 
-        // and go ahead and remember the column
-        columns[whichColToCopyTo] = std::make_pair(newCol, temp);
+    // tells us whether only the rows in a selection vector are in this tuple set
+    bool hasSelection() {
+        return selection != nullptr;
     }
 
-    // JiaNote: to get number of rows in a particular column
-    // returns -1 if column doesn't exist
-    int getNumRows(int whichColumn) {
-        if (hasColumn(whichColumn) == false) {
-            return -1;
+    // gets the selection vector, or nullptr if all rows of the columns are in this tuple set
+    std::shared_ptr<std::vector<uint32_t>> getSelection() {
+        return selection;
+    }
+
+    // sets the selection vector; nullptr means that all rows are in this tuple set
+    void setSelection(std::shared_ptr<std::vector<uint32_t>> selectMe) {
+        selection = selectMe;
+    }
+
+    // gets the number of rows in this tuple set, taking the selection vector into account
+    // returns -1 if the column doesn't exist
+    int getNumSelectedRows(int whichColumn) {
+        if (selection != nullptr) {
+            return hasColumn(whichColumn) ? (int)selection->size() : -1;
         }
-        return columns[whichColumn].second.getCount(columns[whichColumn].first);
+        return getNumRows(whichColumn);
     }
 
+    // gets the number of rows in this tuple set from its first column, taking the selection
+    // vector into account; returns -1 if there is no column
+    int getNumSelectedRows() {
+        for (int i = 0; i < (int)columns.size(); i++) {
+            if (columns[i].funcs != nullptr) {
+                return getNumSelectedRows(i);
+            }
+        }
+        return -1;
+    }
 
-    // copies a column from another TupleSet, deleting the target, if necessary
-    void copyColumn(TupleSetPtr fromMe, int whichColInFromMe, int whichColToCopyTo) {
+    // applies the selection vector to all of the columns, so that the columns only hold the
+    // selected rows, and then drops the selection vector; this is called before an executor or a
+    // sink that does not honor the selection vector sees this tuple set
+    void compact() {
 
-        if (fromMe == nullptr)
-             return;
+        if (selection == nullptr) {
+            return;
+        }
 
-        // kill the old one so we don't have a memory leak
-        if (hasColumn(whichColToCopyTo)) {
+        for (auto& value : columns) {
 
-            // delete the existing column, if necessary
-            auto& value = columns[whichColToCopyTo];
-            if (value.second.mustDelete) {
-                value.second.deleter(value.first);
+            if (value.funcs == nullptr) {
+                continue;
             }
-        }
 
-        // create a copy of the maintenance funcs
-        auto& value = fromMe->columns[whichColInFromMe];
-        MaintenanceFuncs temp = value.second;
+            // select the rows of the column, getting a new version
+            void* res = getBuffer(value);
+            value.funcs->select(value.data, res, *selection);
 
-        // remember that this is a shallow copy... no need to delete
-        temp.mustDelete = false;
+            // get rid of the old one, recycling it if it is ours
+            releaseData(value);
+
+            // record the new column, and remember that we need to delete it
+            value.data = res;
+            value.mustDelete = true;
 
-        // and go ahead and remember the column
-        columns[whichColToCopyTo] = std::make_pair(value.first, temp);
+            // and keep the columnar view in line with the column
+            if (value.view != nullptr) {
+                value.view = value.view->select(*selection);
+            }
+        }
+        selection = nullptr;
     }
 
-    // creates a new column, adding it to the tuple set
-    template <typename ColType>
-    void addColumn(int where, std::vector<ColType>* addMe, bool needToDelete) {
+    // creates a new tuple set with deep copies of the rows of the columns at the given positions
+    TupleSetPtr copyRows(std::vector<uint32_t>& rows) {
 
-        // delete the old one, if needed
-        if (columns.count(where) != 0) {
-            auto& value = columns[where];
-            if (value.second.mustDelete) {
-                value.second.deleter(value.first);
+        TupleSetPtr result = std::make_shared<TupleSet>();
+        for (int i = 0; i < (int)columns.size(); i++) {
+
+            auto& from = columns[i];
+            if (from.funcs == nullptr) {
+                continue;
             }
-        }
 
-        // now, add the new column... this reqires creating three lambdas to deal with
-        // column maintenance.  The first lamba deletes the column, correctly taking into
-        // account the type of the column...
-        std::function<void(void*)> deleter;
-        deleter = [](void* deleteMe) {
-            std::vector<ColType>* killMe = (std::vector<ColType>*)deleteMe;
-            delete killMe;
-        };
+            auto& value = result->getEntry(i);
+            result->setType(value, from.funcs);
+            value.data = from.funcs->create();
+            from.funcs->select(from.data, value.data, rows);
+            value.mustDelete = true;
+            value.view = (from.view != nullptr) ? from.view->select(rows) : nullptr;
+        }
+        return result;
+    }
 
-        // and the second lambda filters the column, again correctly taking into account
-        // the type of the column
-        std::function<void*(void*, std::vector<bool>&)> filter;
-        filter = [](void* filter, std::vector<bool>& whichAreValid) {
-            std::vector<ColType>& filterMe = *((std::vector<ColType>*)filter);
+    // splits the rows in this tuple set into two new tuple sets, the first half of the rows and
+    // the rest, so that a batch whose output doesn't fit in a page can be run in two halves;
+    // returns false if there are fewer than two rows to split
+    bool split(TupleSetPtr& firstHalf, TupleSetPtr& secondHalf) {
 
-            // count the number of rows that need to be retained
-            int counter = 0;
-            for (auto a : whichAreValid)
-                if (a)
-                    counter++;
+        int numRows = getNumSelectedRows();
+        if (numRows < 2) {
+            return false;
+        }
 
-            // copy the ones that need to be retained over
-            std::vector<ColType>* newVec = new std::vector<ColType>(counter);
-            if (newVec == nullptr) {
-                std::cout << "TupleSet.h: Failed to allocate memory " << std::endl; 
-                exit(1);
-            }
-            counter = 0;
-            for (int i = 0; i < filterMe.size(); i++) {
-                if (whichAreValid[i])
-                    (*newVec)[counter++] = filterMe[i];
+        std::vector<uint32_t> firstRows;
+        std::vector<uint32_t> secondRows;
+        for (int i = 0; i < numRows; i++) {
+            uint32_t row = (selection != nullptr) ? (*selection)[i] : i;
+            if (i < numRows / 2) {
+                firstRows.push_back(row);
+            } else {
+                secondRows.push_back(row);
             }
+        }
+        firstHalf = copyRows(firstRows);
+        secondHalf = copyRows(secondRows);
+        return true;
+    }
 
-            // and return the result
-            return (void*)newVec;
-        };
-        std::function<void*(void*, std::vector<uint32_t>&)> replicate;
-        replicate = [](void* replicate, std::vector<uint32_t>& timesToReplicate) {
+    // JiaNote: to get number of rows in a particular column, ignoring the selection vector
+    // returns -1 if column doesn't exist
+    int getNumRows(int whichColumn) {
+        if (hasColumn(whichColumn) == false) {
+            return -1;
+        }
+        return columns[whichColumn].funcs->getCount(columns[whichColumn].data);
+    }
 
-            std::vector<ColType>& replicateMe = *((std::vector<ColType>*)replicate);
 
-            // count the number of rows that need to be retained
-            int counter = 0;
-            for (auto& a : timesToReplicate)
-                counter += a;
+    // copies a column from another TupleSet, deleting the target, if necessary
+    void copyColumn(TupleSetPtr fromMe, int whichColInFromMe, int whichColToCopyTo) {
 
-            // copy the ones that need to be retained over
-            std::vector<ColType>* newVec = new std::vector<ColType>(counter);
-            if (newVec == nullptr) {
-                std::cout << "TupleSet.h: Failed to allocate memory " << std::endl;
-                exit(1);
-            }
-            counter = 0;
-            for (int i = 0; i < timesToReplicate.size(); i++) {
-                for (int j = 0; j < timesToReplicate[i]; j++) {
-                    (*newVec)[counter] = replicateMe[i];
-                    counter++;
-                }
-            }
+        if (fromMe == nullptr)
+             return;
 
-            // and return the result
-            return (void*)newVec;
-        };
-        // JiaNote: add getCount to get number of rows for a particular column at runtime
-        std::function<size_t(void*)> getCount;
-        getCount = [](void* countMe) {
-            std::vector<ColType>* toCountRowsOfMe = (std::vector<ColType>*)countMe;
-            return toCountRowsOfMe->size();
-        };
+        // get rid of the old one, keeping it for the next filter of this column
+        auto& from = fromMe->columns[whichColInFromMe];
+        void* fromData = from.data;
+        MaintenanceFuncs* funcs = from.funcs;
+        ColumnarViewPtr view = from.view;
+        size_t lastWritten = from.lastWritten;
+        auto& value = getEntry(whichColToCopyTo);
+        if (value.funcs != nullptr) {
+            releaseData(value);
+        }
+        setType(value, funcs);
 
-        // the third lambda is responsible for writing this column to an output vector
-        std::function<void(Handle<Vector<Handle<Object>>>&, void*, size_t&)> writeToVector;
-        if (std::is_base_of<PtrBase, ColType>::value)
-            writeToVector =
-                [](Handle<Vector<Handle<Object>>>& writeToMe, void* writeMe, size_t& lastWritten) {
-                    std::vector<Ptr<Handle<Object>>>& writeMeOut =
-                        *((std::vector<Ptr<Handle<Object>>>*)writeMe);
-                    Vector<Handle<Object>>& outputToMe = *writeToMe;
-                    for (; lastWritten < writeMeOut.size(); lastWritten++) {
-                        Ptr<Handle<Object>> temp = writeMeOut[lastWritten];
-                        outputToMe.push_back(*(writeMeOut[lastWritten]));
-                    }
-                };
-        else
-            writeToVector = [](
-                Handle<Vector<Handle<Object>>>& writeToMe, void* writeMe, size_t& lastWritten) {
-                std::vector<Handle<Object>>& writeMeOut = *((std::vector<Handle<Object>>*)writeMe);
-                Vector<Handle<Object>>& outputToMe = *writeToMe;
-                for (; lastWritten < writeMeOut.size(); lastWritten++) {
-                    outputToMe.push_back(writeMeOut[lastWritten]);
-                }
-            };
+        // remember that this is a shallow copy... no need to delete
+        value.data = fromData;
+        value.mustDelete = false;
+        value.lastWritten = lastWritten;
+        value.view = view;
+    }
 
+    // creates a new column, adding it to the tuple set
+    template <typename ColType>
+    void addColumn(int where, std::vector<ColType>* addMe, bool needToDelete) {
 
-        // finally, the sixth creates a pdb :: Vector to hold the column
-        std::function<Handle<Vector<Handle<Object>>>()> createPDBVector;
-        createPDBVector = []() {
-            Handle<Vector<Handle<ColType>>> returnVal = makeObject<Vector<Handle<ColType>>>();
-            return unsafeCast<Vector<Handle<Object>>>(returnVal);
-        };
+        // delete the old one, if needed
+        auto& value = getEntry(where);
+        if (value.data != nullptr && value.mustDelete && value.data != (void*)addMe) {
+            value.funcs->deleter(value.data);
+        }
 
-        MaintenanceFuncs myFuncs(
-            deleter,
-            filter,
-            replicate,
-            getCount,
-            createPDBVector,
-            writeToVector,
-            needToDelete,
-            getTypeName<ColType>(),
-            getSerializedSize<std::is_base_of<PtrBase, ColType>::value, ColType>());
-        columns[where] = std::make_pair((void*)addMe, myFuncs);
+        // now, add the new column, with the functions that deal with column maintenance for
+        // its type
+        setType(value, getMaintenanceFuncs<ColType>());
+        value.data = (void*)addMe;
+        value.mustDelete = needToDelete;
+        value.lastWritten = 0;
+        value.view = nullptr;
     }
 };
 }
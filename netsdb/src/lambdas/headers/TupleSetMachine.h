@@ -57,6 +57,9 @@ public:
             // copy the column over, deleting the old one, if necessary
             output->copyColumn(input, i, counter++);
         }
+
+        // the shallow copies have the same rows as the input, so they share its selection vector
+        output->setSelection(input->getSelection());
     }
 
     // this is used by a join to replicate a bunch of input columns
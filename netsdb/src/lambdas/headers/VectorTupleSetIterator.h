@@ -2,6 +2,10 @@
 #ifndef VECTOR_TUPLESET_ITER_H
 #define VECTOR_TUPLESET_ITER_H
 
+#include "ColumnarView.h"
+#include "PaxPage.h"
+#include <tuple>
+
 namespace pdb {
 
 // this class iterates over an input pdb :: Vector, breaking it up into a series of TupleSet objects
@@ -30,16 +34,56 @@ private:
     // and the tuple set we return
     TupleSetPtr output;
 
+    // whether the vectors are in pages that may have PAX columns
+    bool readPaxColumns;
+
+    // the record whose PAX columns we looked up last, and the arrays of those PAX columns as
+    // (byte offset of the attribute, array, width) triples
+    Record<Vector<Handle<Object>>>* paxRec = nullptr;
+    std::vector<std::tuple<size_t, char*, size_t>> paxColumns;
+
+    // attaches the PAX columns of the current page, if any, to the output column, so that
+    // attributes can be read without dereferencing the objects
+    void attachPaxColumns(size_t firstRow) {
+        if (paxRec != myRec) {
+            paxRec = myRec;
+            paxColumns.clear();
+            PaxFooter* footer = PaxPage::getFooter(myRec, PaxPage::getBytesSize(myRec));
+            if (footer != nullptr) {
+                for (size_t byteOffset : PaxPage::getByteOffsets(myRec, footer)) {
+                    size_t width;
+                    char* array = PaxPage::getColumn(myRec, footer, byteOffset, width);
+                    paxColumns.push_back(std::make_tuple(byteOffset, array, width));
+                }
+            }
+        }
+        if (paxColumns.size() == 0) {
+            output->setColumnarView(0, nullptr);
+            return;
+        }
+        ColumnarViewPtr view = std::make_shared<ColumnarView>(firstRow);
+        for (auto& column : paxColumns) {
+            view->addArray(std::get<0>(column), std::get<1>(column), std::get<2>(column));
+        }
+        output->setColumnarView(0, view);
+    }
+
 public:
     // the first param is a callback function that the iterator will call in order to obtain the
     // page holding the next vector to iterate
     // over.  The secomd param is a callback that the iterator will call when the specified page is
     // done being processed and can be
-    // freed.  The third param tells us how many objects to put into a tuple set
+    // freed.  The third param tells us how many objects to put into a tuple set.  The fourth param
+    // tells us whether the vectors are in pages of a user set, which may store attributes in PAX
+    // columns (see PaxPage.h)
     VectorTupleSetIterator(std::function<void*()> getAnotherVector,
                            std::function<void(void*)> doneWithVector,
-                           size_t chunkSize)
-        : getAnotherVector(getAnotherVector), doneWithVector(doneWithVector), chunkSize(chunkSize) {
+                           size_t chunkSize,
+                           bool readPaxColumns = false)
+        : getAnotherVector(getAnotherVector),
+          doneWithVector(doneWithVector),
+          chunkSize(chunkSize),
+          readPaxColumns(readPaxColumns) {
 
         // create the tuple set that we'll return during iteration
         output = std::make_shared<TupleSet>();
@@ -78,6 +122,11 @@ public:
     size_t getChunkSize() override {
         return this->chunkSize;
     }
+
+    // each chunk is a slice of the objects in a page, so any size works
+    bool isChunkSizeAdaptive() override {
+        return true;
+    }
     // returns the next tuple set to process, or nullptr if there is not one to process
     TupleSetPtr getNextTupleSet() override {
 
@@ -169,12 +218,17 @@ public:
         // resize the output vector as appropriate
         std::vector<Handle<Object>>& inputColumn = output->getColumn<Handle<Object>>(0);
         inputColumn.resize(numSlotsToIterate);
+        size_t firstRow = pos;
         // fill it up
         for (int i = 0; i < numSlotsToIterate; i++) {
             inputColumn[i] = myVec[pos];
             pos++;
         }
 
+        if (readPaxColumns) {
+            attachPaxColumns(firstRow);
+        }
+
         // and return the output TupleSet
         return output;
     }
@@ -78,7 +78,7 @@ public:
   /* Creates a set with a given type for an existing database, which can be applied with lambda-based dispatching policy */
   bool createSet(const std::string &databaseName, const std::string &setName,
                  const std::string &typeName, std::string &errMsg,
-                 size_t pageSize = DEFAULT_PAGE_SIZE, const std::string &createdJobId = "", Handle<Computation> dispatchComputation = nullptr, Handle<LambdaIdentifier> lambda = nullptr, bool isSharedTensorBlockSet = false, bool isModelSet = false);
+                 size_t pageSize = DEFAULT_PAGE_SIZE, const std::string &createdJobId = "", Handle<Computation> dispatchComputation = nullptr, Handle<LambdaIdentifier> lambda = nullptr, bool isSharedTensorBlockSet = false, bool isModelSet = false, PageCompressionType compressionType = NoPageCompression);
 
   /* Creates a set with a given type for an existing database, which can be applied with IR-based dispatching policy*/
   bool createSet(const std::string &databaseName, const std::string &setName,
@@ -92,7 +92,7 @@ public:
   bool createSet(const std::string &databaseName,
                             const std::string &setName, std::string &errMsg, 
                             size_t pageSize = DEFAULT_PAGE_SIZE,
-                            const std::string &createdJobId = "", Handle<Computation> dispatchComputation = nullptr, Handle<LambdaIdentifier> lambda = nullptr, bool isSharedTensorBlockSet = false, bool isModelSet = false);
+                            const std::string &createdJobId = "", Handle<Computation> dispatchComputation = nullptr, Handle<LambdaIdentifier> lambda = nullptr, bool isSharedTensorBlockSet = false, bool isModelSet = false, PageCompressionType compressionType = NoPageCompression);
 
  /* Creates a set with a given type (using a template) for an existing
    * database with page_size value, which can be applied with IR-based dispatching policy */
@@ -156,6 +156,19 @@ public:
   bool clearSet(const std::string &databaseName, const std::string &setName,
                 const std::string &typeName, std::string &errMsg);
 
+  /* Declares an attribute of a set to summarize in per-page zone maps, so that
+   * selections with a simple comparison on the attribute can skip pages. The
+   * attribute must be stored inline at byteOffset bytes from the start of each
+   * object, and only pages flushed after the declaration are summarized.
+   * If columnar is true, the attribute is also stored in a contiguous PAX column
+   * in each page of data sent to the set from now on, from which scans read it
+   * without dereferencing the objects. */
+  bool addZoneMapAttribute(const std::string &databaseName,
+                           const std::string &setName,
+                           const std::string &attributeName, size_t byteOffset,
+                           ZoneMapAttributeType attributeType,
+                           std::string &errMsg, bool columnar = false);
+
   /* Removes a temporary set given a type from an existing database (only goes
    * through storage). */
   bool removeTempSet(const std::string &databaseName,
@@ -8,10 +8,10 @@ namespace pdb {
 template <class DataType>
 bool PDBClient::createSet(const std::string &databaseName,
                           const std::string &setName, std::string &errMsg, 
-                          size_t pageSize, const std::string &createdJobId, Handle<Computation> dispatchComputation, Handle<LambdaIdentifier> lambda, bool isSharedTensorBlockSet, bool isModelSet) {
+                          size_t pageSize, const std::string &createdJobId, Handle<Computation> dispatchComputation, Handle<LambdaIdentifier> lambda, bool isSharedTensorBlockSet, bool isModelSet, PageCompressionType compressionType) {
 
   return distributedStorageClient.createSet<DataType>(
-        databaseName, setName, errMsg, pageSize, createdJobId, dispatchComputation, lambda, 0, false, isSharedTensorBlockSet, isModelSet);
+        databaseName, setName, errMsg, pageSize, createdJobId, dispatchComputation, lambda, 0, false, isSharedTensorBlockSet, isModelSet, compressionType);
 }
 
 
@@ -58,10 +58,10 @@ bool PDBClient::createDatabase(const std::string &databaseName,
 bool PDBClient::createSet(const std::string &databaseName,
                           const std::string &setName,
                           const std::string &typeName, std::string &errMsg,
-                          size_t pageSize, const std::string &createdJobId, Handle<Computation> dispatchComputation, Handle<LambdaIdentifier> lambda, bool isSharedTensorBlockSet, bool isModelSet) {
+                          size_t pageSize, const std::string &createdJobId, Handle<Computation> dispatchComputation, Handle<LambdaIdentifier> lambda, bool isSharedTensorBlockSet, bool isModelSet, PageCompressionType compressionType) {
 
   return distributedStorageClient.createSet(databaseName, setName, typeName,
-                                            errMsg, pageSize, createdJobId, dispatchComputation, lambda, 0, false, isSharedTensorBlockSet, isModelSet);
+                                            errMsg, pageSize, createdJobId, dispatchComputation, lambda, 0, false, isSharedTensorBlockSet, isModelSet, compressionType);
 }
 
 
@@ -130,6 +130,19 @@ bool PDBClient::clearSet(const std::string &databaseName,
 }
 
 
+bool PDBClient::addZoneMapAttribute(const std::string &databaseName,
+                                    const std::string &setName,
+                                    const std::string &attributeName,
+                                    size_t byteOffset,
+                                    ZoneMapAttributeType attributeType,
+                                    std::string &errMsg, bool columnar) {
+
+  return distributedStorageClient.addZoneMapAttribute(
+      databaseName, setName, attributeName, byteOffset, attributeType, errMsg,
+      columnar);
+}
+
+
 bool PDBClient::addSharedPage(std::string sharingDatabase,
                    std::string sharingSetName,
                    std::string sharingTypeName,
@@ -375,7 +375,8 @@ int main(int argc, char** argv) {
 
     cout << "Log Level is set to " << logger->getLoglevel() << endl;
 
-    SharedMemPtr shm = make_shared<SharedMem>(conf->getShmSize(), logger);
+    SharedMemPtr shm =
+        make_shared<SharedMem>(conf->getShmSize(), logger, conf->getUseHugePages());
 
 
     // STORAGE
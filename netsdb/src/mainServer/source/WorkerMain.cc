@@ -95,7 +95,8 @@ int main(int argc, char* argv[]) {
     pdb::PDBLoggerPtr logger = make_shared<pdb::PDBLogger>(frontendLoggerFile);
     conf->setNumThreads(numThreads);
     conf->setShmSize(sharedMemSize);
-    SharedMemPtr shm = make_shared<SharedMem>(conf->getShmSize(), logger);
+    SharedMemPtr shm =
+        make_shared<SharedMem>(conf->getShmSize(), logger, conf->getUseHugePages());
 
     std::string ipcFile =
         std::string("/tmp/") + localIp + std::string("_") + std::to_string(localPort);
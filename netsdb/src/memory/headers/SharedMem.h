@@ -5,29 +5,65 @@
 #include <pthread.h>
 #include "PDBLogger.h"
 #include "SlabAllocator.h"
+#include "SharedMemRing.h"
 
 #ifndef USE_MEMCACHED_SLAB_ALLOCATOR
 #include "tlsf.h"
 #endif
 
+#include <atomic>
 #include <memory>
+#include <vector>
 using namespace std;
 class SharedMem;
 typedef shared_ptr<SharedMem> SharedMemPtr;
 
 
+//the free buffers of one size that a thread keeps for reuse
+struct ShmMagazine {
+    size_t bufferSize;
+    std::vector<void*> buffers;
+};
+
+//the magazines of one thread, guarded by a mutex that only the owner thread takes, except when
+//the magazines of all threads are reclaimed
+struct ShmThreadCache {
+    pthread_mutex_t mutex;
+    std::vector<ShmMagazine> magazines;
+};
+
+
 //this class wraps a shared memory buffer pool for allocating pages
-//this class uses mmap system call
+//this class uses mmap system call, optionally backed by explicit huge pages
+//
+//page-sized buffers (of at least DEFAULT_SHM_MAGAZINE_MIN_SIZE bytes) are cached in per-thread
+//magazines of up to DEFAULT_SHM_MAGAZINE_ROUNDS buffers for each size, so that most allocations
+//and frees of pages don't take the pool lock. a magazine is refilled with, and returns, half of
+//its rounds at a time under one acquisition of the pool lock. all magazines together hold at
+//most 1/DEFAULT_SHM_MAGAZINE_MAX_FRACTION of the pool, and they are all returned to the pool
+//before an allocation fails. the magazines of a thread live until the pool is destroyed, as the
+//threads that allocate pages are pooled workers of the frontend.
 
 class SharedMem {
 public:
-    SharedMem(size_t shmMemSize, pdb::PDBLoggerPtr logger);
+    SharedMem(size_t shmMemSize, pdb::PDBLoggerPtr logger, bool useHugePages = false);
     ~SharedMem();
     void lock();
     void unlock();
     void* malloc(size_t size);
     void* mallocAlign(size_t size, size_t alignment, int& offset);
     void free(void* ptr, size_t size);
+    // set the number of buffers per magazine, 0 returns all cached buffers and disables magazines
+    void setMagazineRounds(unsigned int rounds);
+    // return all buffers cached in magazines to the pool
+    void reclaimMagazines();
+    // return the number of bytes held by callers, and the number of bytes cached in magazines
+    size_t getUsedBytes();
+    size_t getCachedBytes();
+    // return the fraction of free memory in the pool that is not in its largest free block
+    double getFragmentation();
+    // print the occupancy, magazine, and fragmentation counters
+    void printStats();
     long long computeOffset(void* shmAddress);
     void* getPointer(size_t offset);
     static char* addressRoundUp(char* address, size_t roundTo);
@@ -36,13 +72,19 @@ public:
     void* _malloc_unsafe(size_t size);
     void _free_unsafe(void* ptr, size_t size);
     size_t getShmSize();
+    // the ring for the backend to pin and unpin pages without sockets, or nullptr
+    SharedMemRingPtr getCommandRing();
 
 protected:
     int initialize();
     void destroy();
-    int getMem();
+    int getMem(bool useHugePages);
     int initMallocs();
     int initMutex();
+    int initCommandRing();
+    ShmThreadCache* getThreadCache();
+    void* mallocFromPool(size_t size, unsigned int numExtra, std::vector<void*>& extra);
+    void freeToPool(std::vector<void*>& buffers, size_t size);
 
 private:
     pthread_mutex_t* memLock;
@@ -55,6 +97,23 @@ private:
 #endif
     void* memPool;
     size_t shmMemSize;
+    bool usingHugePages;
+    SharedMemRingPtr commandRing;
+
+    // the id to find the thread caches of this pool among those of a thread
+    long id;
+    std::vector<ShmThreadCache*> threadCaches;
+    pthread_mutex_t threadCachesLock;
+    std::atomic<unsigned int> magazineRounds;
+    size_t maxCachedBytes;
+
+    // counters
+    std::atomic<size_t> usedBytes{0};
+    std::atomic<size_t> cachedBytes{0};
+    std::atomic_long numMagazineHits{0};
+    std::atomic_long numMagazineMisses{0};
+    std::atomic_long numPoolLocks{0};
+    std::atomic_long numReclaims{0};
 };
 
 #endif /* SHAREDMEM_H */
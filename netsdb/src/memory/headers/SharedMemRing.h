@@ -0,0 +1,102 @@
+#ifndef SHAREDMEM_RING_H
+#define SHAREDMEM_RING_H
+
+#include "DataTypes.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <stdint.h>
+using namespace std;
+class SharedMemRing;
+typedef shared_ptr<SharedMemRing> SharedMemRingPtr;
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "the command ring needs lock-free 64-bit atomics");
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "the command ring needs lock-free atomics");
+
+// the commands that the backend can send to the frontend through the ring
+typedef enum { ShmPinPage = 1, ShmUnpinPage = 2 } ShmCommandType;
+
+// a command and the response to it, both stored in a slot of the ring
+typedef struct {
+    // the request, filled by the backend
+    ShmCommandType type;
+    NodeID nodeId;
+    DatabaseID dbId;
+    UserTypeID typeId;
+    SetID setId;
+    PageID pageId;
+    bool wasNewPage;
+    bool wasDirty;
+    // the response, filled by the frontend
+    bool success;
+    PageID resultPageId;
+    size_t pageSize;
+    size_t sharedMemOffset;
+} ShmCommand;
+
+
+// this class implements a lock-free request/response ring in the shared memory buffer pool, so
+// that the threads of the backend can pin and unpin pages without a socket round trip per page
+//
+// the ring is a bounded queue of slots, each with a sequence number, in the style of Vyukov:
+// - a backend thread claims the slot at the head with a CAS, writes its command, and publishes
+// it by setting the sequence number of the slot to its position + 1;
+// - a poller thread of the frontend claims the published slot at the tail with a CAS, runs the
+// command, writes the response to the same slot, and marks the slot done;
+// - the backend thread reads the response and only then releases the slot for the next lap by
+// setting the sequence number to its position + the number of slots.
+// so a slot is never reused while its response is still being read, and any number of backend
+// threads and pollers can use the ring at the same time.
+//
+// the ring is created in the shared memory before the backend is forked, so that both processes
+// see it at the same address. a command is only submitted while a poller is servicing the ring,
+// otherwise (or when the ring is full) the caller must fall back to the socket.
+
+class SharedMemRing {
+public:
+    // initialize a ring with numSlots slots (a power of two) in memory of getMemSize(numSlots)
+    // bytes, which must be aligned to a cache line
+    SharedMemRing(void* memory, size_t numSlots);
+    ~SharedMemRing();
+
+    // return the number of bytes of memory to hold a ring with numSlots slots
+    static size_t getMemSize(size_t numSlots);
+
+    // submit a command, and wait until the frontend has filled the response in it;
+    // return false without submitting it if the ring is not serviced or is full
+    bool submit(ShmCommand& command);
+
+    // run the next submitted command with the given function, if there is any;
+    // return false if there is no submitted command
+    bool poll(const std::function<void(ShmCommand&)>& runCommand);
+
+    // mark whether pollers are servicing the ring
+    void setServiced(bool serviced);
+
+    // return whether pollers are servicing the ring
+    bool isServiced();
+
+    // return the number of slots
+    size_t getNumSlots();
+
+private:
+    typedef enum { SlotSubmitted = 0, SlotDone = 1 } SlotState;
+
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> sequence;
+        std::atomic<int> state;
+        ShmCommand command;
+    };
+
+    struct RingHeader {
+        alignas(64) std::atomic<uint64_t> head;
+        alignas(64) std::atomic<uint64_t> tail;
+        alignas(64) std::atomic<int> serviced;
+    };
+
+    RingHeader* header;
+    Slot* slots;
+    uint64_t mask;
+};
+
+#endif /* SHAREDMEM_RING_H */
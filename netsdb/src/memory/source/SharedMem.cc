@@ -13,15 +13,23 @@
 #include <stdio.h>
 #include <string>
 #include <iostream>
+#include <algorithm>
 
 #ifndef USE_MEMCACHED_SLAB_ALLOCATOR
 #include "tlsf.h"
 #endif
 
-SharedMem::SharedMem(size_t memSize, pdb::PDBLoggerPtr logger) {
+// each pool gets an id, so that a thread can tell its caches of different pools apart
+static std::atomic<long> nextSharedMemId{0};
+
+// the caches of the current thread, for each pool that it has used
+static thread_local std::vector<std::pair<long, ShmThreadCache*>> myThreadCaches;
+
+SharedMem::SharedMem(size_t memSize, pdb::PDBLoggerPtr logger, bool useHugePages) {
     this->shmMemSize = memSize;
     this->memPool = nullptr;
-    if (this->getMem() < 0) {
+    this->usingHugePages = false;
+    if (this->getMem(useHugePages) < 0) {
         std::cout << "Fatal error: initialize shared memory failed with size=" << memSize
                   << std::endl;
         logger->error(std::string("Fatal error: initialize shared memory failed with size=") +
@@ -36,6 +44,14 @@ SharedMem::SharedMem(size_t memSize, pdb::PDBLoggerPtr logger) {
 #endif
     this->initMutex();
     this->logger = logger;
+    this->id = nextSharedMemId++;
+    pthread_mutex_init(&this->threadCachesLock, nullptr);
+    this->magazineRounds = DEFAULT_SHM_MAGAZINE_ROUNDS;
+    this->maxCachedBytes = this->shmMemSize / DEFAULT_SHM_MAGAZINE_MAX_FRACTION;
+    if (this->initCommandRing() < 0) {
+        std::cout << "can't allocate the command ring, the backend will use sockets only"
+                  << std::endl;
+    }
 }
 
 SharedMem::~SharedMem() {
@@ -55,16 +71,188 @@ size_t SharedMem::getShmSize() {
 }
 
 
+// a page-sized buffer comes from the magazine of the thread for its size if it has one, otherwise
+// the magazine is refilled with half of its rounds under the same acquisition of the pool lock
 void* SharedMem::malloc(size_t size) {
+    unsigned int rounds = this->magazineRounds;
+    if ((size < DEFAULT_SHM_MAGAZINE_MIN_SIZE) || (rounds == 0)) {
+        std::vector<void*> extra;
+        void* ptr = this->mallocFromPool(size, 0, extra);
+        if (ptr != nullptr) {
+            this->usedBytes += size;
+        }
+        return ptr;
+    }
+    ShmThreadCache* cache = this->getThreadCache();
+    pthread_mutex_lock(&cache->mutex);
+    for (auto& magazine : cache->magazines) {
+        if ((magazine.bufferSize == size) && (magazine.buffers.size() > 0)) {
+            void* ptr = magazine.buffers.back();
+            magazine.buffers.pop_back();
+            pthread_mutex_unlock(&cache->mutex);
+            this->cachedBytes -= size;
+            this->usedBytes += size;
+            this->numMagazineHits++;
+            return ptr;
+        }
+    }
+    pthread_mutex_unlock(&cache->mutex);
+    this->numMagazineMisses++;
+    unsigned int numExtra = rounds / 2;
+    size_t cached = this->cachedBytes;
+    if (cached + (size_t)numExtra * size > this->maxCachedBytes) {
+        numExtra = (cached >= this->maxCachedBytes) ? 0 : (this->maxCachedBytes - cached) / size;
+    }
+    std::vector<void*> extra;
+    void* ptr = this->mallocFromPool(size, numExtra, extra);
+    if (ptr == nullptr) {
+        // the buffers that threads cache are free memory too
+        this->reclaimMagazines();
+        ptr = this->mallocFromPool(size, 0, extra);
+    }
+    if (ptr != nullptr) {
+        this->usedBytes += size;
+    }
+    if (extra.size() > 0) {
+        this->cachedBytes += extra.size() * size;
+        pthread_mutex_lock(&cache->mutex);
+        ShmMagazine* target = nullptr;
+        for (auto& magazine : cache->magazines) {
+            if (magazine.bufferSize == size) {
+                target = &magazine;
+                break;
+            }
+        }
+        if (target == nullptr) {
+            cache->magazines.push_back(ShmMagazine{size, std::vector<void*>()});
+            target = &(cache->magazines.back());
+        }
+        target->buffers.insert(target->buffers.end(), extra.begin(), extra.end());
+        pthread_mutex_unlock(&cache->mutex);
+    }
+    return ptr;
+}
+
+// allocate a buffer, and up to numExtra more buffers of the same size for a magazine, from the
+// pool under one acquisition of the pool lock
+void* SharedMem::mallocFromPool(size_t size, unsigned int numExtra, std::vector<void*>& extra) {
     void* ptr;
     this->lock();
+    this->numPoolLocks++;
+    ptr = this->_malloc_unsafe(size);
+    if (ptr != nullptr) {
+        for (unsigned int i = 0; i < numExtra; i++) {
+            void* buffer = this->_malloc_unsafe(size);
+            if (buffer == nullptr) {
+                break;
+            }
+            extra.push_back(buffer);
+        }
+    }
+    this->unlock();
+    return ptr;
+}
+
+void SharedMem::freeToPool(std::vector<void*>& buffers, size_t size) {
+    if (buffers.size() == 0) {
+        return;
+    }
+    this->lock();
+    this->numPoolLocks++;
+    for (auto buffer : buffers) {
+        this->_free_unsafe(buffer, size);
+    }
+    this->unlock();
+}
+
+ShmThreadCache* SharedMem::getThreadCache() {
+    for (auto& myCache : myThreadCaches) {
+        if (myCache.first == this->id) {
+            return myCache.second;
+        }
+    }
+    ShmThreadCache* cache = new ShmThreadCache();
+    pthread_mutex_init(&cache->mutex, nullptr);
+    pthread_mutex_lock(&this->threadCachesLock);
+    this->threadCaches.push_back(cache);
+    pthread_mutex_unlock(&this->threadCachesLock);
+    myThreadCaches.push_back(std::make_pair(this->id, cache));
+    return cache;
+}
+
+void SharedMem::reclaimMagazines() {
+    this->numReclaims++;
+    pthread_mutex_lock(&this->threadCachesLock);
+    for (auto cache : this->threadCaches) {
+        pthread_mutex_lock(&cache->mutex);
+        for (auto& magazine : cache->magazines) {
+            this->cachedBytes -= magazine.buffers.size() * magazine.bufferSize;
+            this->freeToPool(magazine.buffers, magazine.bufferSize);
+            magazine.buffers.clear();
+        }
+        pthread_mutex_unlock(&cache->mutex);
+    }
+    pthread_mutex_unlock(&this->threadCachesLock);
+}
+
+void SharedMem::setMagazineRounds(unsigned int rounds) {
+    this->magazineRounds = rounds;
+    this->reclaimMagazines();
+}
+
+size_t SharedMem::getUsedBytes() {
+    return this->usedBytes;
+}
+
+size_t SharedMem::getCachedBytes() {
+    return this->cachedBytes;
+}
+
+#ifndef USE_MEMCACHED_SLAB_ALLOCATOR
+typedef struct {
+    size_t freeBytes;
+    size_t largestFreeBlock;
+    size_t numFreeBlocks;
+} ShmPoolWalk;
+
+static void walkFreeBlocks(void* ptr, size_t size, int used, void* user) {
+    ShmPoolWalk* walk = (ShmPoolWalk*)user;
+    if (used == 0) {
+        walk->freeBytes += size;
+        walk->numFreeBlocks++;
+        walk->largestFreeBlock = std::max(walk->largestFreeBlock, size);
+    }
+}
+#endif
+
+double SharedMem::getFragmentation() {
 #ifdef USE_MEMCACHED_SLAB_ALLOCATOR
-    ptr = this->allocator->slabs_alloc_unsafe(size);
+    return 0;
 #else
-    ptr = this->allocator.tlsf_malloc(this->my_tlsf, size);
-#endif
+    ShmPoolWalk walk = {0, 0, 0};
+    this->lock();
+    this->allocator.tlsf_walk_pool(
+        this->allocator.tlsf_get_pool(this->my_tlsf), walkFreeBlocks, &walk);
     this->unlock();
-    return ptr;
+    if (walk.freeBytes == 0) {
+        return 0;
+    }
+    return 1 - (double)walk.largestFreeBlock / (double)walk.freeBytes;
+#endif
+}
+
+void SharedMem::printStats() {
+    std::cout << "*****************" << std::endl;
+    std::cout << "shmSize: " << this->shmMemSize << std::endl;
+    std::cout << "hugePages: " << this->usingHugePages << std::endl;
+    std::cout << "usedBytes: " << this->usedBytes << std::endl;
+    std::cout << "cachedBytes: " << this->cachedBytes << std::endl;
+    std::cout << "numMagazineHits: " << this->numMagazineHits << std::endl;
+    std::cout << "numMagazineMisses: " << this->numMagazineMisses << std::endl;
+    std::cout << "numPoolLocks: " << this->numPoolLocks << std::endl;
+    std::cout << "numReclaims: " << this->numReclaims << std::endl;
+    std::cout << "fragmentation: " << this->getFragmentation() << std::endl;
+    std::cout << "*****************" << std::endl;
 }
 
 
@@ -80,14 +268,51 @@ void* SharedMem::mallocAlign(size_t size, size_t alignment, int& offset) {
 }
 
 
+// a page-sized buffer goes to the magazine of the thread for its size, and a full magazine
+// returns half of its rounds to the pool together with the buffer
 void SharedMem::free(void* ptr, size_t size) {
-    this->lock();
-#ifdef USE_MEMCACHED_SLAB_ALLOCATOR
-    this->allocator->slabs_free_unsafe(ptr, size);
-#else
-    this->allocator.tlsf_free(this->my_tlsf, ptr);
+    this->usedBytes -= size;
+    std::vector<void*> buffers;
+    unsigned int rounds = this->magazineRounds;
+    bool cacheable = (size >= DEFAULT_SHM_MAGAZINE_MIN_SIZE) && (rounds > 0) &&
+        (this->cachedBytes + size <= this->maxCachedBytes);
+#ifndef USE_MEMCACHED_SLAB_ALLOCATOR
+    // never cache a buffer under a size larger than its block
+    cacheable = cacheable && (this->allocator.tlsf_block_size(ptr) >= size);
 #endif
-    this->unlock();
+    if (cacheable == false) {
+        buffers.push_back(ptr);
+        this->freeToPool(buffers, size);
+        return;
+    }
+    ShmThreadCache* cache = this->getThreadCache();
+    pthread_mutex_lock(&cache->mutex);
+    ShmMagazine* target = nullptr;
+    for (auto& magazine : cache->magazines) {
+        if (magazine.bufferSize == size) {
+            target = &magazine;
+            break;
+        }
+    }
+    if (target == nullptr) {
+        cache->magazines.push_back(ShmMagazine{size, std::vector<void*>()});
+        target = &(cache->magazines.back());
+    }
+    if (target->buffers.size() < rounds) {
+        target->buffers.push_back(ptr);
+        pthread_mutex_unlock(&cache->mutex);
+        this->cachedBytes += size;
+        return;
+    }
+    unsigned int numToReturn = std::max(rounds / 2, (unsigned int)1);
+    for (unsigned int i = 0; i < numToReturn; i++) {
+        buffers.push_back(target->buffers.back());
+        target->buffers.pop_back();
+    }
+    target->buffers.push_back(ptr);
+    pthread_mutex_unlock(&cache->mutex);
+    this->cachedBytes -= (numToReturn - 1) * size;
+    this->freeToPool(buffers, size);
 }
 
 
@@ -112,6 +337,13 @@ int SharedMem::initialize() {
 }
 
 void SharedMem::destroy() {
+    pthread_mutex_lock(&this->threadCachesLock);
+    for (auto cache : this->threadCaches) {
+        pthread_mutex_destroy(&cache->mutex);
+        delete cache;
+    }
+    this->threadCaches.clear();
+    pthread_mutex_unlock(&this->threadCachesLock);
     if (this->memLock) {
         pthread_mutex_destroy(this->memLock);
     }
@@ -121,14 +353,38 @@ void SharedMem::destroy() {
     }
 }
 
-int SharedMem::getMem() {
+// explicit huge pages need pages reserved in /proc/sys/vm/nr_hugepages, so without them the pool
+// falls back to normal pages, and asks for transparent huge pages instead
+int SharedMem::getMem(bool useHugePages) {
     if (this->memPool && (this->memPool != (void*)-1)) {
         return -1;
     }
+    if (useHugePages == true) {
+        size_t hugePageSize = (size_t)(2) * (size_t)(1024) * (size_t)(1024);
+        size_t hugeSize = this->roundUp(this->shmMemSize, hugePageSize);
+        this->memPool = mmap(0,
+                             hugeSize,
+                             PROT_READ | PROT_WRITE,
+                             MAP_ANON | MAP_SHARED | MAP_HUGETLB,
+                             -1,
+                             0);
+        if (this->memPool != (void*)-1) {
+            this->shmMemSize = hugeSize;
+            this->usingHugePages = true;
+            return 0;
+        }
+        std::cout << "can't map shared memory with huge pages: " << strerror(errno)
+                  << ", use normal pages" << std::endl;
+    }
     this->memPool = mmap(0, this->shmMemSize, PROT_READ | PROT_WRITE, MAP_ANON | MAP_SHARED, -1, 0);
     if (this->memPool == (void*)-1) {
         return -1;
     }
+#ifdef MADV_HUGEPAGE
+    if (useHugePages == true) {
+        madvise(this->memPool, this->shmMemSize, MADV_HUGEPAGE);
+    }
+#endif
     return 0;
 }
 
@@ -152,6 +408,28 @@ int SharedMem::initMutex() {
     return 0;
 }
 
+// the ring is allocated before the backend is forked, so that both processes find it at the same
+// address through their copies of this object
+int SharedMem::initCommandRing() {
+    this->commandRing = nullptr;
+    size_t numSlots = DEFAULT_SHM_RING_SLOTS;
+    if ((numSlots == 0) || ((numSlots & (numSlots - 1)) != 0)) {
+        return -1;
+    }
+    size_t cacheLineSize = 64;
+    void* memory = this->_malloc_unsafe(SharedMemRing::getMemSize(numSlots) + cacheLineSize);
+    if (memory == nullptr) {
+        return -1;
+    }
+    this->commandRing = make_shared<SharedMemRing>(
+        (void*)this->addressRoundUp((char*)memory, cacheLineSize), numSlots);
+    return 0;
+}
+
+SharedMemRingPtr SharedMem::getCommandRing() {
+    return this->commandRing;
+}
+
 void* SharedMem::_malloc_unsafe(size_t size) {
 #ifdef USE_MEMCACHED_SLAB_ALLOCATOR
     return this->allocator->slabs_alloc_unsafe(size);
@@ -0,0 +1,120 @@
+#ifndef SHAREDMEM_RING_CC
+#define SHAREDMEM_RING_CC
+
+#include "SharedMemRing.h"
+#include <new>
+#include <sched.h>
+#include <unistd.h>
+
+// number of times to poll a slot before yielding the cpu, and before sleeping
+#define RING_SPIN_COUNT 128
+#define RING_YIELD_COUNT 1024
+#define RING_SLEEP_MICROSECONDS 20
+
+static void backOff(unsigned int& numTries) {
+    numTries++;
+    if (numTries < RING_SPIN_COUNT) {
+        return;
+    } else if (numTries < RING_YIELD_COUNT) {
+        sched_yield();
+    } else {
+        usleep(RING_SLEEP_MICROSECONDS);
+    }
+}
+
+SharedMemRing::SharedMemRing(void* memory, size_t numSlots) {
+    this->header = new (memory) RingHeader();
+    this->slots = (Slot*)((char*)memory + sizeof(RingHeader));
+    this->mask = numSlots - 1;
+    this->header->head.store(0, std::memory_order_relaxed);
+    this->header->tail.store(0, std::memory_order_relaxed);
+    for (size_t i = 0; i < numSlots; i++) {
+        Slot* slot = new (&(this->slots[i])) Slot();
+        slot->sequence.store(i, std::memory_order_relaxed);
+        slot->state.store(SlotDone, std::memory_order_relaxed);
+    }
+    this->header->serviced.store(0, std::memory_order_release);
+}
+
+// the memory of the ring belongs to the shared memory buffer pool
+SharedMemRing::~SharedMemRing() {}
+
+size_t SharedMemRing::getMemSize(size_t numSlots) {
+    return sizeof(RingHeader) + numSlots * sizeof(Slot);
+}
+
+bool SharedMemRing::submit(ShmCommand& command) {
+    if (this->isServiced() == false) {
+        return false;
+    }
+    // claim the slot at the head
+    Slot* slot;
+    uint64_t pos = this->header->head.load(std::memory_order_relaxed);
+    while (true) {
+        slot = &(this->slots[pos & this->mask]);
+        uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+        int64_t diff = (int64_t)sequence - (int64_t)pos;
+        if (diff == 0) {
+            if (this->header->head.compare_exchange_weak(
+                    pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // the ring is full
+            return false;
+        } else {
+            pos = this->header->head.load(std::memory_order_relaxed);
+        }
+    }
+    // publish the command
+    slot->command = command;
+    slot->state.store(SlotSubmitted, std::memory_order_relaxed);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    // wait for the response, and release the slot for the next lap
+    unsigned int numTries = 0;
+    while (slot->state.load(std::memory_order_acquire) != SlotDone) {
+        backOff(numTries);
+    }
+    command = slot->command;
+    slot->sequence.store(pos + this->mask + 1, std::memory_order_release);
+    return true;
+}
+
+bool SharedMemRing::poll(const std::function<void(ShmCommand&)>& runCommand) {
+    // claim the published slot at the tail
+    Slot* slot;
+    uint64_t pos = this->header->tail.load(std::memory_order_relaxed);
+    while (true) {
+        slot = &(this->slots[pos & this->mask]);
+        uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+        int64_t diff = (int64_t)sequence - (int64_t)(pos + 1);
+        if (diff == 0) {
+            if (this->header->tail.compare_exchange_weak(
+                    pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // nothing is submitted
+            return false;
+        } else {
+            pos = this->header->tail.load(std::memory_order_relaxed);
+        }
+    }
+    runCommand(slot->command);
+    slot->state.store(SlotDone, std::memory_order_release);
+    return true;
+}
+
+void SharedMemRing::setServiced(bool serviced) {
+    this->header->serviced.store(serviced ? 1 : 0, std::memory_order_release);
+}
+
+bool SharedMemRing::isServiced() {
+    return this->header->serviced.load(std::memory_order_acquire) == 1;
+}
+
+size_t SharedMemRing::getNumSlots() {
+    return this->mask + 1;
+}
+
+#endif
@@ -51,118 +51,120 @@
 #define DistributedStorageAddSharedMapping_TYPEID 49
 #define DistributedStorageAddSharedPage_TYPEID 50
 #define DistributedStorageAddTempSet_TYPEID 51
-#define DistributedStorageCleanup_TYPEID 52
-#define DistributedStorageClearSet_TYPEID 53
-#define DistributedStorageExportSet_TYPEID 54
-#define DistributedStorageRemoveDatabase_TYPEID 55
-#define DistributedStorageRemoveHashSet_TYPEID 56
-#define DistributedStorageRemoveSet_TYPEID 57
-#define DistributedStorageRemoveTempSet_TYPEID 58
-#define DoneWithResult_TYPEID 59
-#define DoubleSumResult_TYPEID 60
-#define DoubleVector_TYPEID 61
-#define DoubleVectorResult_TYPEID 62
-#define Employee_TYPEID 63
-#define EnsembleTreeCompiledUDFDouble_TYPEID 64
-#define EnsembleTreeCompiledUDFFloat_TYPEID 65
-#define EnsembleTreeGenericUDFDouble_TYPEID 66
-#define EnsembleTreeGenericUDFFloat_TYPEID 67
-#define EnsembleTreeGenericUDFSparse_TYPEID 68
-#define EnsembleTreeGenericUDFSparseBlock_TYPEID 69
-#define EnsembleTreeUDFDouble_TYPEID 70
-#define EnsembleTreeUDFFloat_TYPEID 71
-#define ExecuteComputation_TYPEID 72
-#define ExecuteQuery_TYPEID 73
-#define Forest_TYPEID 74
-#define ForestObjectBased_TYPEID 75
-#define GenericBlock_TYPEID 76
-#define GetListOfNodes_TYPEID 77
-#define HashPartitionedJoinBuildHTJobStage_TYPEID 78
-#define Holder_TYPEID 79
-#define JoinMap_TYPEID 80
-#define JoinPairArray_TYPEID 81
-#define KMeansDoubleVector_TYPEID 82
-#define KeepGoing_TYPEID 83
-#define LambdaIdentifier_TYPEID 84
-#define ListOfNodes_TYPEID 85
-#define Map_TYPEID 86
-#define MyEmployee_TYPEID 87
-#define NodeDispatcherData_TYPEID 88
-#define NodeInfo_TYPEID 89
-#define Nothing_TYPEID 90
-#define Object_TYPEID 91
-#define OptimizedDepartmentEmployees_TYPEID 92
-#define OptimizedEmployee_TYPEID 93
-#define OptimizedSupervisor_TYPEID 94
-#define PairArray_TYPEID 95
-#define PlaceOfQueryPlanner_TYPEID 96
-#define QueriesAndPlan_TYPEID 97
-#define QueryDone_TYPEID 98
-#define QueryOutput_TYPEID 99
-#define QueryPermit_TYPEID 100
-#define QueryPermitResponse_TYPEID 101
-#define RequestResources_TYPEID 102
-#define ResourceInfo_TYPEID 103
-#define ScanDoubleVectorSet_TYPEID 104
-#define ScanUserSet_TYPEID 105
-#define Set_TYPEID 106
-#define SetIdentifier_TYPEID 107
-#define SetScan_TYPEID 108
-#define ShutDown_TYPEID 109
-#define SimpleRequestResult_TYPEID 110
-#define SparseMatrixBlock_TYPEID 111
-#define StorageAddData_TYPEID 112
-#define StorageAddDatabase_TYPEID 113
-#define StorageAddModel_TYPEID 114
-#define StorageAddModelResponse_TYPEID 115
-#define StorageAddObject_TYPEID 116
-#define StorageAddObjectInLoop_TYPEID 117
-#define StorageAddSet_TYPEID 118
-#define StorageAddSharedMapping_TYPEID 119
-#define StorageAddSharedPage_TYPEID 120
-#define StorageAddTempSet_TYPEID 121
-#define StorageAddTempSetResult_TYPEID 122
-#define StorageAddType_TYPEID 123
-#define StorageBytesPinned_TYPEID 124
-#define StorageCleanup_TYPEID 125
-#define StorageClearSet_TYPEID 126
-#define StorageCollectStats_TYPEID 127
-#define StorageCollectStatsResponse_TYPEID 128
-#define StorageExportSet_TYPEID 129
-#define StorageGetData_TYPEID 130
-#define StorageGetDataResponse_TYPEID 131
-#define StorageGetSetPages_TYPEID 132
-#define StorageGetStats_TYPEID 133
-#define StorageNoMorePage_TYPEID 134
-#define StoragePagePinned_TYPEID 135
-#define StoragePinBytes_TYPEID 136
-#define StoragePinPage_TYPEID 137
-#define StorageRemoveDatabase_TYPEID 138
-#define StorageRemoveHashSet_TYPEID 139
-#define StorageRemoveTempSet_TYPEID 140
-#define StorageRemoveUserSet_TYPEID 141
-#define StorageTestSetCopy_TYPEID 142
-#define StorageTestSetScan_TYPEID 143
-#define StorageUnpinPage_TYPEID 144
-#define StringIntPair_TYPEID 145
-#define SumResult_TYPEID 146
-#define Supervisor_TYPEID 147
-#define TensorBlock2D_TYPEID 148
-#define TensorBlockIdentifier_TYPEID 149
-#define TensorBlockMeta_TYPEID 150
-#define TensorData2D_TYPEID 151
-#define TensorMeta2D_TYPEID 152
-#define TopKQueue_TYPEID 153
-#define Tree_TYPEID 154
-#define TreeCrossProduct_TYPEID 155
-#define TreeNodeObjectBased_TYPEID 156
-#define TreeResult_TYPEID 157
-#define TreeResultAggregate_TYPEID 158
-#define TreeResultPostProcessing_TYPEID 159
-#define TupleSetExecuteQuery_TYPEID 160
-#define TupleSetJobStage_TYPEID 161
-#define Vector_TYPEID 162
-#define VectorDoubleWriter_TYPEID 163
-#define VectorFloatWriter_TYPEID 164
-#define WriteUserSet_TYPEID 165
-#define ZB_Company_TYPEID 166
+#define DistributedStorageAddZoneMapAttribute_TYPEID 52
+#define DistributedStorageCleanup_TYPEID 53
+#define DistributedStorageClearSet_TYPEID 54
+#define DistributedStorageExportSet_TYPEID 55
+#define DistributedStorageRemoveDatabase_TYPEID 56
+#define DistributedStorageRemoveHashSet_TYPEID 57
+#define DistributedStorageRemoveSet_TYPEID 58
+#define DistributedStorageRemoveTempSet_TYPEID 59
+#define DoneWithResult_TYPEID 60
+#define DoubleSumResult_TYPEID 61
+#define DoubleVector_TYPEID 62
+#define DoubleVectorResult_TYPEID 63
+#define Employee_TYPEID 64
+#define EnsembleTreeCompiledUDFDouble_TYPEID 65
+#define EnsembleTreeCompiledUDFFloat_TYPEID 66
+#define EnsembleTreeGenericUDFDouble_TYPEID 67
+#define EnsembleTreeGenericUDFFloat_TYPEID 68
+#define EnsembleTreeGenericUDFSparse_TYPEID 69
+#define EnsembleTreeGenericUDFSparseBlock_TYPEID 70
+#define EnsembleTreeUDFDouble_TYPEID 71
+#define EnsembleTreeUDFFloat_TYPEID 72
+#define ExecuteComputation_TYPEID 73
+#define ExecuteQuery_TYPEID 74
+#define Forest_TYPEID 75
+#define ForestObjectBased_TYPEID 76
+#define GenericBlock_TYPEID 77
+#define GetListOfNodes_TYPEID 78
+#define HashPartitionedJoinBuildHTJobStage_TYPEID 79
+#define Holder_TYPEID 80
+#define JoinMap_TYPEID 81
+#define JoinPairArray_TYPEID 82
+#define KMeansDoubleVector_TYPEID 83
+#define KeepGoing_TYPEID 84
+#define LambdaIdentifier_TYPEID 85
+#define ListOfNodes_TYPEID 86
+#define Map_TYPEID 87
+#define MyEmployee_TYPEID 88
+#define NodeDispatcherData_TYPEID 89
+#define NodeInfo_TYPEID 90
+#define Nothing_TYPEID 91
+#define Object_TYPEID 92
+#define OptimizedDepartmentEmployees_TYPEID 93
+#define OptimizedEmployee_TYPEID 94
+#define OptimizedSupervisor_TYPEID 95
+#define PairArray_TYPEID 96
+#define PlaceOfQueryPlanner_TYPEID 97
+#define QueriesAndPlan_TYPEID 98
+#define QueryDone_TYPEID 99
+#define QueryOutput_TYPEID 100
+#define QueryPermit_TYPEID 101
+#define QueryPermitResponse_TYPEID 102
+#define RequestResources_TYPEID 103
+#define ResourceInfo_TYPEID 104
+#define ScanDoubleVectorSet_TYPEID 105
+#define ScanUserSet_TYPEID 106
+#define Set_TYPEID 107
+#define SetIdentifier_TYPEID 108
+#define SetScan_TYPEID 109
+#define ShutDown_TYPEID 110
+#define SimpleRequestResult_TYPEID 111
+#define SparseMatrixBlock_TYPEID 112
+#define StorageAddData_TYPEID 113
+#define StorageAddDatabase_TYPEID 114
+#define StorageAddModel_TYPEID 115
+#define StorageAddModelResponse_TYPEID 116
+#define StorageAddObject_TYPEID 117
+#define StorageAddObjectInLoop_TYPEID 118
+#define StorageAddSet_TYPEID 119
+#define StorageAddSharedMapping_TYPEID 120
+#define StorageAddSharedPage_TYPEID 121
+#define StorageAddTempSet_TYPEID 122
+#define StorageAddTempSetResult_TYPEID 123
+#define StorageAddType_TYPEID 124
+#define StorageAddZoneMapAttribute_TYPEID 125
+#define StorageBytesPinned_TYPEID 126
+#define StorageCleanup_TYPEID 127
+#define StorageClearSet_TYPEID 128
+#define StorageCollectStats_TYPEID 129
+#define StorageCollectStatsResponse_TYPEID 130
+#define StorageExportSet_TYPEID 131
+#define StorageGetData_TYPEID 132
+#define StorageGetDataResponse_TYPEID 133
+#define StorageGetSetPages_TYPEID 134
+#define StorageGetStats_TYPEID 135
+#define StorageNoMorePage_TYPEID 136
+#define StoragePagePinned_TYPEID 137
+#define StoragePinBytes_TYPEID 138
+#define StoragePinPage_TYPEID 139
+#define StorageRemoveDatabase_TYPEID 140
+#define StorageRemoveHashSet_TYPEID 141
+#define StorageRemoveTempSet_TYPEID 142
+#define StorageRemoveUserSet_TYPEID 143
+#define StorageTestSetCopy_TYPEID 144
+#define StorageTestSetScan_TYPEID 145
+#define StorageUnpinPage_TYPEID 146
+#define StringIntPair_TYPEID 147
+#define SumResult_TYPEID 148
+#define Supervisor_TYPEID 149
+#define TensorBlock2D_TYPEID 150
+#define TensorBlockIdentifier_TYPEID 151
+#define TensorBlockMeta_TYPEID 152
+#define TensorData2D_TYPEID 153
+#define TensorMeta2D_TYPEID 154
+#define TopKQueue_TYPEID 155
+#define Tree_TYPEID 156
+#define TreeCrossProduct_TYPEID 157
+#define TreeNodeObjectBased_TYPEID 158
+#define TreeResult_TYPEID 159
+#define TreeResultAggregate_TYPEID 160
+#define TreeResultPostProcessing_TYPEID 161
+#define TupleSetExecuteQuery_TYPEID 162
+#define TupleSetJobStage_TYPEID 163
+#define Vector_TYPEID 164
+#define VectorDoubleWriter_TYPEID 165
+#define VectorFloatWriter_TYPEID 166
+#define WriteUserSet_TYPEID 167
+#define ZB_Company_TYPEID 168
@@ -50,121 +50,123 @@ objectTypeNamesList [getTypeName <DistributedStorageAddSetWithPartition> ()] = 4
 objectTypeNamesList [getTypeName <DistributedStorageAddSharedMapping> ()] = 49;
 objectTypeNamesList [getTypeName <DistributedStorageAddSharedPage> ()] = 50;
 objectTypeNamesList [getTypeName <DistributedStorageAddTempSet> ()] = 51;
-objectTypeNamesList [getTypeName <DistributedStorageCleanup> ()] = 52;
-objectTypeNamesList [getTypeName <DistributedStorageClearSet> ()] = 53;
-objectTypeNamesList [getTypeName <DistributedStorageExportSet> ()] = 54;
-objectTypeNamesList [getTypeName <DistributedStorageRemoveDatabase> ()] = 55;
-objectTypeNamesList [getTypeName <DistributedStorageRemoveHashSet> ()] = 56;
-objectTypeNamesList [getTypeName <DistributedStorageRemoveSet> ()] = 57;
-objectTypeNamesList [getTypeName <DistributedStorageRemoveTempSet> ()] = 58;
-objectTypeNamesList [getTypeName <DoneWithResult> ()] = 59;
-objectTypeNamesList [getTypeName <DoubleSumResult> ()] = 60;
-objectTypeNamesList [getTypeName <DoubleVector> ()] = 61;
-objectTypeNamesList [getTypeName <DoubleVectorResult> ()] = 62;
-objectTypeNamesList [getTypeName <Employee> ()] = 63;
-objectTypeNamesList [getTypeName <EnsembleTreeCompiledUDFDouble> ()] = 64;
-objectTypeNamesList [getTypeName <EnsembleTreeCompiledUDFFloat> ()] = 65;
-objectTypeNamesList [getTypeName <EnsembleTreeGenericUDFDouble> ()] = 66;
-objectTypeNamesList [getTypeName <EnsembleTreeGenericUDFFloat> ()] = 67;
-objectTypeNamesList [getTypeName <EnsembleTreeGenericUDFSparse> ()] = 68;
-objectTypeNamesList [getTypeName <EnsembleTreeGenericUDFSparseBlock> ()] = 69;
-objectTypeNamesList [getTypeName <EnsembleTreeUDFDouble> ()] = 70;
-objectTypeNamesList [getTypeName <EnsembleTreeUDFFloat> ()] = 71;
-objectTypeNamesList [getTypeName <ExecuteComputation> ()] = 72;
-objectTypeNamesList [getTypeName <ExecuteQuery> ()] = 73;
-objectTypeNamesList [getTypeName <Forest> ()] = 74;
-objectTypeNamesList [getTypeName <ForestObjectBased> ()] = 75;
-objectTypeNamesList [getTypeName <GenericBlock> ()] = 76;
-objectTypeNamesList [getTypeName <GetListOfNodes> ()] = 77;
-objectTypeNamesList [getTypeName <HashPartitionedJoinBuildHTJobStage> ()] = 78;
-objectTypeNamesList [getTypeName <Holder<Nothing>> ()] = 79;
-objectTypeNamesList [getTypeName <JoinMap <Nothing>> ()] = 80;
-objectTypeNamesList [getTypeName <JoinPairArray <Nothing>> ()] = 81;
-objectTypeNamesList [getTypeName <KMeansDoubleVector> ()] = 82;
-objectTypeNamesList [getTypeName <KeepGoing> ()] = 83;
-objectTypeNamesList [getTypeName <LambdaIdentifier> ()] = 84;
-objectTypeNamesList [getTypeName <ListOfNodes> ()] = 85;
-objectTypeNamesList [getTypeName <Map <Nothing>> ()] = 86;
-objectTypeNamesList [getTypeName <MyEmployee> ()] = 87;
-objectTypeNamesList [getTypeName <NodeDispatcherData> ()] = 88;
-objectTypeNamesList [getTypeName <NodeInfo> ()] = 89;
-objectTypeNamesList [getTypeName <Nothing> ()] = 90;
-objectTypeNamesList [getTypeName <Object> ()] = 91;
-objectTypeNamesList [getTypeName <OptimizedDepartmentEmployees> ()] = 92;
-objectTypeNamesList [getTypeName <OptimizedEmployee> ()] = 93;
-objectTypeNamesList [getTypeName <OptimizedSupervisor> ()] = 94;
-objectTypeNamesList [getTypeName <PairArray <Nothing>> ()] = 95;
-objectTypeNamesList [getTypeName <PlaceOfQueryPlanner> ()] = 96;
-objectTypeNamesList [getTypeName <QueriesAndPlan> ()] = 97;
-objectTypeNamesList [getTypeName <QueryDone> ()] = 98;
-objectTypeNamesList [getTypeName <QueryOutput <Nothing>> ()] = 99;
-objectTypeNamesList [getTypeName <QueryPermit> ()] = 100;
-objectTypeNamesList [getTypeName <QueryPermitResponse> ()] = 101;
-objectTypeNamesList [getTypeName <RequestResources> ()] = 102;
-objectTypeNamesList [getTypeName <ResourceInfo> ()] = 103;
-objectTypeNamesList [getTypeName <ScanDoubleVectorSet> ()] = 104;
-objectTypeNamesList [getTypeName <ScanUserSet <Nothing>> ()] = 105;
-objectTypeNamesList [getTypeName <Set <Nothing>> ()] = 106;
-objectTypeNamesList [getTypeName <SetIdentifier> ()] = 107;
-objectTypeNamesList [getTypeName <SetScan> ()] = 108;
-objectTypeNamesList [getTypeName <ShutDown> ()] = 109;
-objectTypeNamesList [getTypeName <SimpleRequestResult> ()] = 110;
-objectTypeNamesList [getTypeName <SparseMatrixBlock> ()] = 111;
-objectTypeNamesList [getTypeName <StorageAddData> ()] = 112;
-objectTypeNamesList [getTypeName <StorageAddDatabase> ()] = 113;
-objectTypeNamesList [getTypeName <StorageAddModel> ()] = 114;
-objectTypeNamesList [getTypeName <StorageAddModelResponse> ()] = 115;
-objectTypeNamesList [getTypeName <StorageAddObject> ()] = 116;
-objectTypeNamesList [getTypeName <StorageAddObjectInLoop> ()] = 117;
-objectTypeNamesList [getTypeName <StorageAddSet> ()] = 118;
-objectTypeNamesList [getTypeName <StorageAddSharedMapping> ()] = 119;
-objectTypeNamesList [getTypeName <StorageAddSharedPage> ()] = 120;
-objectTypeNamesList [getTypeName <StorageAddTempSet> ()] = 121;
-objectTypeNamesList [getTypeName <StorageAddTempSetResult> ()] = 122;
-objectTypeNamesList [getTypeName <StorageAddType> ()] = 123;
-objectTypeNamesList [getTypeName <StorageBytesPinned> ()] = 124;
-objectTypeNamesList [getTypeName <StorageCleanup> ()] = 125;
-objectTypeNamesList [getTypeName <StorageClearSet> ()] = 126;
-objectTypeNamesList [getTypeName <StorageCollectStats> ()] = 127;
-objectTypeNamesList [getTypeName <StorageCollectStatsResponse> ()] = 128;
-objectTypeNamesList [getTypeName <StorageExportSet> ()] = 129;
-objectTypeNamesList [getTypeName <StorageGetData> ()] = 130;
-objectTypeNamesList [getTypeName <StorageGetDataResponse> ()] = 131;
-objectTypeNamesList [getTypeName <StorageGetSetPages> ()] = 132;
-objectTypeNamesList [getTypeName <StorageGetStats> ()] = 133;
-objectTypeNamesList [getTypeName <StorageNoMorePage> ()] = 134;
-objectTypeNamesList [getTypeName <StoragePagePinned> ()] = 135;
-objectTypeNamesList [getTypeName <StoragePinBytes> ()] = 136;
-objectTypeNamesList [getTypeName <StoragePinPage> ()] = 137;
-objectTypeNamesList [getTypeName <StorageRemoveDatabase> ()] = 138;
-objectTypeNamesList [getTypeName <StorageRemoveHashSet> ()] = 139;
-objectTypeNamesList [getTypeName <StorageRemoveTempSet> ()] = 140;
-objectTypeNamesList [getTypeName <StorageRemoveUserSet> ()] = 141;
-objectTypeNamesList [getTypeName <StorageTestSetCopy> ()] = 142;
-objectTypeNamesList [getTypeName <StorageTestSetScan> ()] = 143;
-objectTypeNamesList [getTypeName <StorageUnpinPage> ()] = 144;
-objectTypeNamesList [getTypeName <StringIntPair> ()] = 145;
-objectTypeNamesList [getTypeName <SumResult> ()] = 146;
-objectTypeNamesList [getTypeName <Supervisor> ()] = 147;
-objectTypeNamesList [getTypeName <TensorBlock2D <Nothing>> ()] = 148;
-objectTypeNamesList [getTypeName <TensorBlockIdentifier> ()] = 149;
-objectTypeNamesList [getTypeName <TensorBlockMeta> ()] = 150;
-objectTypeNamesList [getTypeName <TensorData2D <Nothing>> ()] = 151;
-objectTypeNamesList [getTypeName <TensorMeta2D> ()] = 152;
-objectTypeNamesList [getTypeName <TopKQueue <Nothing>> ()] = 153;
-objectTypeNamesList [getTypeName <Tree> ()] = 154;
-objectTypeNamesList [getTypeName <TreeCrossProduct> ()] = 155;
-objectTypeNamesList [getTypeName <TreeNodeObjectBased> ()] = 156;
-objectTypeNamesList [getTypeName <TreeResult> ()] = 157;
-objectTypeNamesList [getTypeName <TreeResultAggregate> ()] = 158;
-objectTypeNamesList [getTypeName <TreeResultPostProcessing> ()] = 159;
-objectTypeNamesList [getTypeName <TupleSetExecuteQuery> ()] = 160;
-objectTypeNamesList [getTypeName <TupleSetJobStage> ()] = 161;
-objectTypeNamesList [getTypeName <Vector <Nothing>> ()] = 162;
-objectTypeNamesList [getTypeName <VectorDoubleWriter> ()] = 163;
-objectTypeNamesList [getTypeName <VectorFloatWriter> ()] = 164;
-objectTypeNamesList [getTypeName <WriteUserSet <Nothing>> ()] = 165;
-objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
+objectTypeNamesList [getTypeName <DistributedStorageAddZoneMapAttribute> ()] = 52;
+objectTypeNamesList [getTypeName <DistributedStorageCleanup> ()] = 53;
+objectTypeNamesList [getTypeName <DistributedStorageClearSet> ()] = 54;
+objectTypeNamesList [getTypeName <DistributedStorageExportSet> ()] = 55;
+objectTypeNamesList [getTypeName <DistributedStorageRemoveDatabase> ()] = 56;
+objectTypeNamesList [getTypeName <DistributedStorageRemoveHashSet> ()] = 57;
+objectTypeNamesList [getTypeName <DistributedStorageRemoveSet> ()] = 58;
+objectTypeNamesList [getTypeName <DistributedStorageRemoveTempSet> ()] = 59;
+objectTypeNamesList [getTypeName <DoneWithResult> ()] = 60;
+objectTypeNamesList [getTypeName <DoubleSumResult> ()] = 61;
+objectTypeNamesList [getTypeName <DoubleVector> ()] = 62;
+objectTypeNamesList [getTypeName <DoubleVectorResult> ()] = 63;
+objectTypeNamesList [getTypeName <Employee> ()] = 64;
+objectTypeNamesList [getTypeName <EnsembleTreeCompiledUDFDouble> ()] = 65;
+objectTypeNamesList [getTypeName <EnsembleTreeCompiledUDFFloat> ()] = 66;
+objectTypeNamesList [getTypeName <EnsembleTreeGenericUDFDouble> ()] = 67;
+objectTypeNamesList [getTypeName <EnsembleTreeGenericUDFFloat> ()] = 68;
+objectTypeNamesList [getTypeName <EnsembleTreeGenericUDFSparse> ()] = 69;
+objectTypeNamesList [getTypeName <EnsembleTreeGenericUDFSparseBlock> ()] = 70;
+objectTypeNamesList [getTypeName <EnsembleTreeUDFDouble> ()] = 71;
+objectTypeNamesList [getTypeName <EnsembleTreeUDFFloat> ()] = 72;
+objectTypeNamesList [getTypeName <ExecuteComputation> ()] = 73;
+objectTypeNamesList [getTypeName <ExecuteQuery> ()] = 74;
+objectTypeNamesList [getTypeName <Forest> ()] = 75;
+objectTypeNamesList [getTypeName <ForestObjectBased> ()] = 76;
+objectTypeNamesList [getTypeName <GenericBlock> ()] = 77;
+objectTypeNamesList [getTypeName <GetListOfNodes> ()] = 78;
+objectTypeNamesList [getTypeName <HashPartitionedJoinBuildHTJobStage> ()] = 79;
+objectTypeNamesList [getTypeName <Holder<Nothing>> ()] = 80;
+objectTypeNamesList [getTypeName <JoinMap <Nothing>> ()] = 81;
+objectTypeNamesList [getTypeName <JoinPairArray <Nothing>> ()] = 82;
+objectTypeNamesList [getTypeName <KMeansDoubleVector> ()] = 83;
+objectTypeNamesList [getTypeName <KeepGoing> ()] = 84;
+objectTypeNamesList [getTypeName <LambdaIdentifier> ()] = 85;
+objectTypeNamesList [getTypeName <ListOfNodes> ()] = 86;
+objectTypeNamesList [getTypeName <Map <Nothing>> ()] = 87;
+objectTypeNamesList [getTypeName <MyEmployee> ()] = 88;
+objectTypeNamesList [getTypeName <NodeDispatcherData> ()] = 89;
+objectTypeNamesList [getTypeName <NodeInfo> ()] = 90;
+objectTypeNamesList [getTypeName <Nothing> ()] = 91;
+objectTypeNamesList [getTypeName <Object> ()] = 92;
+objectTypeNamesList [getTypeName <OptimizedDepartmentEmployees> ()] = 93;
+objectTypeNamesList [getTypeName <OptimizedEmployee> ()] = 94;
+objectTypeNamesList [getTypeName <OptimizedSupervisor> ()] = 95;
+objectTypeNamesList [getTypeName <PairArray <Nothing>> ()] = 96;
+objectTypeNamesList [getTypeName <PlaceOfQueryPlanner> ()] = 97;
+objectTypeNamesList [getTypeName <QueriesAndPlan> ()] = 98;
+objectTypeNamesList [getTypeName <QueryDone> ()] = 99;
+objectTypeNamesList [getTypeName <QueryOutput <Nothing>> ()] = 100;
+objectTypeNamesList [getTypeName <QueryPermit> ()] = 101;
+objectTypeNamesList [getTypeName <QueryPermitResponse> ()] = 102;
+objectTypeNamesList [getTypeName <RequestResources> ()] = 103;
+objectTypeNamesList [getTypeName <ResourceInfo> ()] = 104;
+objectTypeNamesList [getTypeName <ScanDoubleVectorSet> ()] = 105;
+objectTypeNamesList [getTypeName <ScanUserSet <Nothing>> ()] = 106;
+objectTypeNamesList [getTypeName <Set <Nothing>> ()] = 107;
+objectTypeNamesList [getTypeName <SetIdentifier> ()] = 108;
+objectTypeNamesList [getTypeName <SetScan> ()] = 109;
+objectTypeNamesList [getTypeName <ShutDown> ()] = 110;
+objectTypeNamesList [getTypeName <SimpleRequestResult> ()] = 111;
+objectTypeNamesList [getTypeName <SparseMatrixBlock> ()] = 112;
+objectTypeNamesList [getTypeName <StorageAddData> ()] = 113;
+objectTypeNamesList [getTypeName <StorageAddDatabase> ()] = 114;
+objectTypeNamesList [getTypeName <StorageAddModel> ()] = 115;
+objectTypeNamesList [getTypeName <StorageAddModelResponse> ()] = 116;
+objectTypeNamesList [getTypeName <StorageAddObject> ()] = 117;
+objectTypeNamesList [getTypeName <StorageAddObjectInLoop> ()] = 118;
+objectTypeNamesList [getTypeName <StorageAddSet> ()] = 119;
+objectTypeNamesList [getTypeName <StorageAddSharedMapping> ()] = 120;
+objectTypeNamesList [getTypeName <StorageAddSharedPage> ()] = 121;
+objectTypeNamesList [getTypeName <StorageAddTempSet> ()] = 122;
+objectTypeNamesList [getTypeName <StorageAddTempSetResult> ()] = 123;
+objectTypeNamesList [getTypeName <StorageAddType> ()] = 124;
+objectTypeNamesList [getTypeName <StorageAddZoneMapAttribute> ()] = 125;
+objectTypeNamesList [getTypeName <StorageBytesPinned> ()] = 126;
+objectTypeNamesList [getTypeName <StorageCleanup> ()] = 127;
+objectTypeNamesList [getTypeName <StorageClearSet> ()] = 128;
+objectTypeNamesList [getTypeName <StorageCollectStats> ()] = 129;
+objectTypeNamesList [getTypeName <StorageCollectStatsResponse> ()] = 130;
+objectTypeNamesList [getTypeName <StorageExportSet> ()] = 131;
+objectTypeNamesList [getTypeName <StorageGetData> ()] = 132;
+objectTypeNamesList [getTypeName <StorageGetDataResponse> ()] = 133;
+objectTypeNamesList [getTypeName <StorageGetSetPages> ()] = 134;
+objectTypeNamesList [getTypeName <StorageGetStats> ()] = 135;
+objectTypeNamesList [getTypeName <StorageNoMorePage> ()] = 136;
+objectTypeNamesList [getTypeName <StoragePagePinned> ()] = 137;
+objectTypeNamesList [getTypeName <StoragePinBytes> ()] = 138;
+objectTypeNamesList [getTypeName <StoragePinPage> ()] = 139;
+objectTypeNamesList [getTypeName <StorageRemoveDatabase> ()] = 140;
+objectTypeNamesList [getTypeName <StorageRemoveHashSet> ()] = 141;
+objectTypeNamesList [getTypeName <StorageRemoveTempSet> ()] = 142;
+objectTypeNamesList [getTypeName <StorageRemoveUserSet> ()] = 143;
+objectTypeNamesList [getTypeName <StorageTestSetCopy> ()] = 144;
+objectTypeNamesList [getTypeName <StorageTestSetScan> ()] = 145;
+objectTypeNamesList [getTypeName <StorageUnpinPage> ()] = 146;
+objectTypeNamesList [getTypeName <StringIntPair> ()] = 147;
+objectTypeNamesList [getTypeName <SumResult> ()] = 148;
+objectTypeNamesList [getTypeName <Supervisor> ()] = 149;
+objectTypeNamesList [getTypeName <TensorBlock2D <Nothing>> ()] = 150;
+objectTypeNamesList [getTypeName <TensorBlockIdentifier> ()] = 151;
+objectTypeNamesList [getTypeName <TensorBlockMeta> ()] = 152;
+objectTypeNamesList [getTypeName <TensorData2D <Nothing>> ()] = 153;
+objectTypeNamesList [getTypeName <TensorMeta2D> ()] = 154;
+objectTypeNamesList [getTypeName <TopKQueue <Nothing>> ()] = 155;
+objectTypeNamesList [getTypeName <Tree> ()] = 156;
+objectTypeNamesList [getTypeName <TreeCrossProduct> ()] = 157;
+objectTypeNamesList [getTypeName <TreeNodeObjectBased> ()] = 158;
+objectTypeNamesList [getTypeName <TreeResult> ()] = 159;
+objectTypeNamesList [getTypeName <TreeResultAggregate> ()] = 160;
+objectTypeNamesList [getTypeName <TreeResultPostProcessing> ()] = 161;
+objectTypeNamesList [getTypeName <TupleSetExecuteQuery> ()] = 162;
+objectTypeNamesList [getTypeName <TupleSetJobStage> ()] = 163;
+objectTypeNamesList [getTypeName <Vector <Nothing>> ()] = 164;
+objectTypeNamesList [getTypeName <VectorDoubleWriter> ()] = 165;
+objectTypeNamesList [getTypeName <VectorFloatWriter> ()] = 166;
+objectTypeNamesList [getTypeName <WriteUserSet <Nothing>> ()] = 167;
+objectTypeNamesList [getTypeName <ZB_Company> ()] = 168;
 
 // now, record all of the vTables
 {
@@ -660,8 +662,18 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 {
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
-		DistributedStorageCleanup tempObject;
+		DistributedStorageAddZoneMapAttribute tempObject;
 		allVTables [52] = tempObject.getVTablePtr ();
+	} catch (NotEnoughSpace &e) {
+		std :: cout << "Not enough memory to allocate DistributedStorageAddZoneMapAttribute to extract the vTable.\n";
+	}
+}
+
+{
+	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
+	try {
+		DistributedStorageCleanup tempObject;
+		allVTables [53] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate DistributedStorageCleanup to extract the vTable.\n";
 	}
@@ -671,7 +683,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		DistributedStorageClearSet tempObject;
-		allVTables [53] = tempObject.getVTablePtr ();
+		allVTables [54] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate DistributedStorageClearSet to extract the vTable.\n";
 	}
@@ -681,7 +693,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		DistributedStorageExportSet tempObject;
-		allVTables [54] = tempObject.getVTablePtr ();
+		allVTables [55] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate DistributedStorageExportSet to extract the vTable.\n";
 	}
@@ -691,7 +703,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		DistributedStorageRemoveDatabase tempObject;
-		allVTables [55] = tempObject.getVTablePtr ();
+		allVTables [56] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate DistributedStorageRemoveDatabase to extract the vTable.\n";
 	}
@@ -701,7 +713,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		DistributedStorageRemoveHashSet tempObject;
-		allVTables [56] = tempObject.getVTablePtr ();
+		allVTables [57] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate DistributedStorageRemoveHashSet to extract the vTable.\n";
 	}
@@ -711,7 +723,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		DistributedStorageRemoveSet tempObject;
-		allVTables [57] = tempObject.getVTablePtr ();
+		allVTables [58] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate DistributedStorageRemoveSet to extract the vTable.\n";
 	}
@@ -721,7 +733,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		DistributedStorageRemoveTempSet tempObject;
-		allVTables [58] = tempObject.getVTablePtr ();
+		allVTables [59] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate DistributedStorageRemoveTempSet to extract the vTable.\n";
 	}
@@ -731,7 +743,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		DoneWithResult tempObject;
-		allVTables [59] = tempObject.getVTablePtr ();
+		allVTables [60] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate DoneWithResult to extract the vTable.\n";
 	}
@@ -741,7 +753,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		DoubleSumResult tempObject;
-		allVTables [60] = tempObject.getVTablePtr ();
+		allVTables [61] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate DoubleSumResult to extract the vTable.\n";
 	}
@@ -751,7 +763,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		DoubleVector tempObject;
-		allVTables [61] = tempObject.getVTablePtr ();
+		allVTables [62] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate DoubleVector to extract the vTable.\n";
 	}
@@ -761,7 +773,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		DoubleVectorResult tempObject;
-		allVTables [62] = tempObject.getVTablePtr ();
+		allVTables [63] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate DoubleVectorResult to extract the vTable.\n";
 	}
@@ -771,7 +783,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		Employee tempObject;
-		allVTables [63] = tempObject.getVTablePtr ();
+		allVTables [64] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate Employee to extract the vTable.\n";
 	}
@@ -781,7 +793,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		EnsembleTreeCompiledUDFDouble tempObject;
-		allVTables [64] = tempObject.getVTablePtr ();
+		allVTables [65] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate EnsembleTreeCompiledUDFDouble to extract the vTable.\n";
 	}
@@ -791,7 +803,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		EnsembleTreeCompiledUDFFloat tempObject;
-		allVTables [65] = tempObject.getVTablePtr ();
+		allVTables [66] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate EnsembleTreeCompiledUDFFloat to extract the vTable.\n";
 	}
@@ -801,7 +813,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		EnsembleTreeGenericUDFDouble tempObject;
-		allVTables [66] = tempObject.getVTablePtr ();
+		allVTables [67] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate EnsembleTreeGenericUDFDouble to extract the vTable.\n";
 	}
@@ -811,7 +823,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		EnsembleTreeGenericUDFFloat tempObject;
-		allVTables [67] = tempObject.getVTablePtr ();
+		allVTables [68] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate EnsembleTreeGenericUDFFloat to extract the vTable.\n";
 	}
@@ -821,7 +833,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		EnsembleTreeGenericUDFSparse tempObject;
-		allVTables [68] = tempObject.getVTablePtr ();
+		allVTables [69] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate EnsembleTreeGenericUDFSparse to extract the vTable.\n";
 	}
@@ -831,7 +843,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		EnsembleTreeGenericUDFSparseBlock tempObject;
-		allVTables [69] = tempObject.getVTablePtr ();
+		allVTables [70] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate EnsembleTreeGenericUDFSparseBlock to extract the vTable.\n";
 	}
@@ -841,7 +853,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		EnsembleTreeUDFDouble tempObject;
-		allVTables [70] = tempObject.getVTablePtr ();
+		allVTables [71] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate EnsembleTreeUDFDouble to extract the vTable.\n";
 	}
@@ -851,7 +863,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		EnsembleTreeUDFFloat tempObject;
-		allVTables [71] = tempObject.getVTablePtr ();
+		allVTables [72] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate EnsembleTreeUDFFloat to extract the vTable.\n";
 	}
@@ -861,7 +873,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		ExecuteComputation tempObject;
-		allVTables [72] = tempObject.getVTablePtr ();
+		allVTables [73] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate ExecuteComputation to extract the vTable.\n";
 	}
@@ -871,7 +883,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		ExecuteQuery tempObject;
-		allVTables [73] = tempObject.getVTablePtr ();
+		allVTables [74] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate ExecuteQuery to extract the vTable.\n";
 	}
@@ -881,7 +893,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		Forest tempObject;
-		allVTables [74] = tempObject.getVTablePtr ();
+		allVTables [75] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate Forest to extract the vTable.\n";
 	}
@@ -891,7 +903,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		ForestObjectBased tempObject;
-		allVTables [75] = tempObject.getVTablePtr ();
+		allVTables [76] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate ForestObjectBased to extract the vTable.\n";
 	}
@@ -901,7 +913,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		GenericBlock tempObject;
-		allVTables [76] = tempObject.getVTablePtr ();
+		allVTables [77] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate GenericBlock to extract the vTable.\n";
 	}
@@ -911,7 +923,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		GetListOfNodes tempObject;
-		allVTables [77] = tempObject.getVTablePtr ();
+		allVTables [78] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate GetListOfNodes to extract the vTable.\n";
 	}
@@ -921,7 +933,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		HashPartitionedJoinBuildHTJobStage tempObject;
-		allVTables [78] = tempObject.getVTablePtr ();
+		allVTables [79] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate HashPartitionedJoinBuildHTJobStage to extract the vTable.\n";
 	}
@@ -931,7 +943,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		Holder<Nothing> tempObject;
-		allVTables [79] = tempObject.getVTablePtr ();
+		allVTables [80] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate Holder<Nothing> to extract the vTable.\n";
 	}
@@ -941,7 +953,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		JoinMap <Nothing> tempObject;
-		allVTables [80] = tempObject.getVTablePtr ();
+		allVTables [81] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate JoinMap <Nothing> to extract the vTable.\n";
 	}
@@ -951,7 +963,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		JoinPairArray <Nothing> tempObject;
-		allVTables [81] = tempObject.getVTablePtr ();
+		allVTables [82] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate JoinPairArray <Nothing> to extract the vTable.\n";
 	}
@@ -961,7 +973,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		KMeansDoubleVector tempObject;
-		allVTables [82] = tempObject.getVTablePtr ();
+		allVTables [83] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate KMeansDoubleVector to extract the vTable.\n";
 	}
@@ -971,7 +983,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		KeepGoing tempObject;
-		allVTables [83] = tempObject.getVTablePtr ();
+		allVTables [84] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate KeepGoing to extract the vTable.\n";
 	}
@@ -981,7 +993,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		LambdaIdentifier tempObject;
-		allVTables [84] = tempObject.getVTablePtr ();
+		allVTables [85] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate LambdaIdentifier to extract the vTable.\n";
 	}
@@ -991,7 +1003,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		ListOfNodes tempObject;
-		allVTables [85] = tempObject.getVTablePtr ();
+		allVTables [86] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate ListOfNodes to extract the vTable.\n";
 	}
@@ -1001,7 +1013,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		Map <Nothing> tempObject;
-		allVTables [86] = tempObject.getVTablePtr ();
+		allVTables [87] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate Map <Nothing> to extract the vTable.\n";
 	}
@@ -1011,7 +1023,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		MyEmployee tempObject;
-		allVTables [87] = tempObject.getVTablePtr ();
+		allVTables [88] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate MyEmployee to extract the vTable.\n";
 	}
@@ -1021,7 +1033,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		NodeDispatcherData tempObject;
-		allVTables [88] = tempObject.getVTablePtr ();
+		allVTables [89] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate NodeDispatcherData to extract the vTable.\n";
 	}
@@ -1031,7 +1043,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		NodeInfo tempObject;
-		allVTables [89] = tempObject.getVTablePtr ();
+		allVTables [90] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate NodeInfo to extract the vTable.\n";
 	}
@@ -1041,7 +1053,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		Nothing tempObject;
-		allVTables [90] = tempObject.getVTablePtr ();
+		allVTables [91] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate Nothing to extract the vTable.\n";
 	}
@@ -1051,7 +1063,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		Object tempObject;
-		allVTables [91] = tempObject.getVTablePtr ();
+		allVTables [92] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate Object to extract the vTable.\n";
 	}
@@ -1061,7 +1073,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		OptimizedDepartmentEmployees tempObject;
-		allVTables [92] = tempObject.getVTablePtr ();
+		allVTables [93] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate OptimizedDepartmentEmployees to extract the vTable.\n";
 	}
@@ -1071,7 +1083,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		OptimizedEmployee tempObject;
-		allVTables [93] = tempObject.getVTablePtr ();
+		allVTables [94] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate OptimizedEmployee to extract the vTable.\n";
 	}
@@ -1081,7 +1093,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		OptimizedSupervisor tempObject;
-		allVTables [94] = tempObject.getVTablePtr ();
+		allVTables [95] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate OptimizedSupervisor to extract the vTable.\n";
 	}
@@ -1091,7 +1103,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		PairArray <Nothing> tempObject;
-		allVTables [95] = tempObject.getVTablePtr ();
+		allVTables [96] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate PairArray <Nothing> to extract the vTable.\n";
 	}
@@ -1101,7 +1113,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		PlaceOfQueryPlanner tempObject;
-		allVTables [96] = tempObject.getVTablePtr ();
+		allVTables [97] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate PlaceOfQueryPlanner to extract the vTable.\n";
 	}
@@ -1111,7 +1123,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		QueriesAndPlan tempObject;
-		allVTables [97] = tempObject.getVTablePtr ();
+		allVTables [98] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate QueriesAndPlan to extract the vTable.\n";
 	}
@@ -1121,7 +1133,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		QueryDone tempObject;
-		allVTables [98] = tempObject.getVTablePtr ();
+		allVTables [99] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate QueryDone to extract the vTable.\n";
 	}
@@ -1131,7 +1143,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		QueryOutput <Nothing> tempObject;
-		allVTables [99] = tempObject.getVTablePtr ();
+		allVTables [100] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate QueryOutput <Nothing> to extract the vTable.\n";
 	}
@@ -1141,7 +1153,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		QueryPermit tempObject;
-		allVTables [100] = tempObject.getVTablePtr ();
+		allVTables [101] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate QueryPermit to extract the vTable.\n";
 	}
@@ -1151,7 +1163,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		QueryPermitResponse tempObject;
-		allVTables [101] = tempObject.getVTablePtr ();
+		allVTables [102] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate QueryPermitResponse to extract the vTable.\n";
 	}
@@ -1161,7 +1173,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		RequestResources tempObject;
-		allVTables [102] = tempObject.getVTablePtr ();
+		allVTables [103] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate RequestResources to extract the vTable.\n";
 	}
@@ -1171,7 +1183,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		ResourceInfo tempObject;
-		allVTables [103] = tempObject.getVTablePtr ();
+		allVTables [104] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate ResourceInfo to extract the vTable.\n";
 	}
@@ -1181,7 +1193,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		ScanDoubleVectorSet tempObject;
-		allVTables [104] = tempObject.getVTablePtr ();
+		allVTables [105] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate ScanDoubleVectorSet to extract the vTable.\n";
 	}
@@ -1191,7 +1203,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		ScanUserSet <Nothing> tempObject;
-		allVTables [105] = tempObject.getVTablePtr ();
+		allVTables [106] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate ScanUserSet <Nothing> to extract the vTable.\n";
 	}
@@ -1201,7 +1213,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		Set <Nothing> tempObject;
-		allVTables [106] = tempObject.getVTablePtr ();
+		allVTables [107] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate Set <Nothing> to extract the vTable.\n";
 	}
@@ -1211,7 +1223,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		SetIdentifier tempObject;
-		allVTables [107] = tempObject.getVTablePtr ();
+		allVTables [108] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate SetIdentifier to extract the vTable.\n";
 	}
@@ -1221,7 +1233,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		SetScan tempObject;
-		allVTables [108] = tempObject.getVTablePtr ();
+		allVTables [109] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate SetScan to extract the vTable.\n";
 	}
@@ -1231,7 +1243,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		ShutDown tempObject;
-		allVTables [109] = tempObject.getVTablePtr ();
+		allVTables [110] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate ShutDown to extract the vTable.\n";
 	}
@@ -1241,7 +1253,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		SimpleRequestResult tempObject;
-		allVTables [110] = tempObject.getVTablePtr ();
+		allVTables [111] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate SimpleRequestResult to extract the vTable.\n";
 	}
@@ -1251,7 +1263,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		SparseMatrixBlock tempObject;
-		allVTables [111] = tempObject.getVTablePtr ();
+		allVTables [112] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate SparseMatrixBlock to extract the vTable.\n";
 	}
@@ -1261,7 +1273,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageAddData tempObject;
-		allVTables [112] = tempObject.getVTablePtr ();
+		allVTables [113] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageAddData to extract the vTable.\n";
 	}
@@ -1271,7 +1283,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageAddDatabase tempObject;
-		allVTables [113] = tempObject.getVTablePtr ();
+		allVTables [114] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageAddDatabase to extract the vTable.\n";
 	}
@@ -1281,7 +1293,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageAddModel tempObject;
-		allVTables [114] = tempObject.getVTablePtr ();
+		allVTables [115] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageAddModel to extract the vTable.\n";
 	}
@@ -1291,7 +1303,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageAddModelResponse tempObject;
-		allVTables [115] = tempObject.getVTablePtr ();
+		allVTables [116] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageAddModelResponse to extract the vTable.\n";
 	}
@@ -1301,7 +1313,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageAddObject tempObject;
-		allVTables [116] = tempObject.getVTablePtr ();
+		allVTables [117] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageAddObject to extract the vTable.\n";
 	}
@@ -1311,7 +1323,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageAddObjectInLoop tempObject;
-		allVTables [117] = tempObject.getVTablePtr ();
+		allVTables [118] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageAddObjectInLoop to extract the vTable.\n";
 	}
@@ -1321,7 +1333,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageAddSet tempObject;
-		allVTables [118] = tempObject.getVTablePtr ();
+		allVTables [119] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageAddSet to extract the vTable.\n";
 	}
@@ -1331,7 +1343,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageAddSharedMapping tempObject;
-		allVTables [119] = tempObject.getVTablePtr ();
+		allVTables [120] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageAddSharedMapping to extract the vTable.\n";
 	}
@@ -1341,7 +1353,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageAddSharedPage tempObject;
-		allVTables [120] = tempObject.getVTablePtr ();
+		allVTables [121] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageAddSharedPage to extract the vTable.\n";
 	}
@@ -1351,7 +1363,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageAddTempSet tempObject;
-		allVTables [121] = tempObject.getVTablePtr ();
+		allVTables [122] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageAddTempSet to extract the vTable.\n";
 	}
@@ -1361,7 +1373,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageAddTempSetResult tempObject;
-		allVTables [122] = tempObject.getVTablePtr ();
+		allVTables [123] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageAddTempSetResult to extract the vTable.\n";
 	}
@@ -1371,17 +1383,27 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageAddType tempObject;
-		allVTables [123] = tempObject.getVTablePtr ();
+		allVTables [124] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageAddType to extract the vTable.\n";
 	}
 }
 
+{
+	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
+	try {
+		StorageAddZoneMapAttribute tempObject;
+		allVTables [125] = tempObject.getVTablePtr ();
+	} catch (NotEnoughSpace &e) {
+		std :: cout << "Not enough memory to allocate StorageAddZoneMapAttribute to extract the vTable.\n";
+	}
+}
+
 {
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageBytesPinned tempObject;
-		allVTables [124] = tempObject.getVTablePtr ();
+		allVTables [126] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageBytesPinned to extract the vTable.\n";
 	}
@@ -1391,7 +1413,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageCleanup tempObject;
-		allVTables [125] = tempObject.getVTablePtr ();
+		allVTables [127] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageCleanup to extract the vTable.\n";
 	}
@@ -1401,7 +1423,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageClearSet tempObject;
-		allVTables [126] = tempObject.getVTablePtr ();
+		allVTables [128] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageClearSet to extract the vTable.\n";
 	}
@@ -1411,7 +1433,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageCollectStats tempObject;
-		allVTables [127] = tempObject.getVTablePtr ();
+		allVTables [129] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageCollectStats to extract the vTable.\n";
 	}
@@ -1421,7 +1443,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageCollectStatsResponse tempObject;
-		allVTables [128] = tempObject.getVTablePtr ();
+		allVTables [130] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageCollectStatsResponse to extract the vTable.\n";
 	}
@@ -1431,7 +1453,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageExportSet tempObject;
-		allVTables [129] = tempObject.getVTablePtr ();
+		allVTables [131] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageExportSet to extract the vTable.\n";
 	}
@@ -1441,7 +1463,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageGetData tempObject;
-		allVTables [130] = tempObject.getVTablePtr ();
+		allVTables [132] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageGetData to extract the vTable.\n";
 	}
@@ -1451,7 +1473,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageGetDataResponse tempObject;
-		allVTables [131] = tempObject.getVTablePtr ();
+		allVTables [133] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageGetDataResponse to extract the vTable.\n";
 	}
@@ -1461,7 +1483,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageGetSetPages tempObject;
-		allVTables [132] = tempObject.getVTablePtr ();
+		allVTables [134] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageGetSetPages to extract the vTable.\n";
 	}
@@ -1471,7 +1493,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageGetStats tempObject;
-		allVTables [133] = tempObject.getVTablePtr ();
+		allVTables [135] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageGetStats to extract the vTable.\n";
 	}
@@ -1481,7 +1503,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageNoMorePage tempObject;
-		allVTables [134] = tempObject.getVTablePtr ();
+		allVTables [136] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageNoMorePage to extract the vTable.\n";
 	}
@@ -1491,7 +1513,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StoragePagePinned tempObject;
-		allVTables [135] = tempObject.getVTablePtr ();
+		allVTables [137] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StoragePagePinned to extract the vTable.\n";
 	}
@@ -1501,7 +1523,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StoragePinBytes tempObject;
-		allVTables [136] = tempObject.getVTablePtr ();
+		allVTables [138] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StoragePinBytes to extract the vTable.\n";
 	}
@@ -1511,7 +1533,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StoragePinPage tempObject;
-		allVTables [137] = tempObject.getVTablePtr ();
+		allVTables [139] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StoragePinPage to extract the vTable.\n";
 	}
@@ -1521,7 +1543,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageRemoveDatabase tempObject;
-		allVTables [138] = tempObject.getVTablePtr ();
+		allVTables [140] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageRemoveDatabase to extract the vTable.\n";
 	}
@@ -1531,7 +1553,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageRemoveHashSet tempObject;
-		allVTables [139] = tempObject.getVTablePtr ();
+		allVTables [141] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageRemoveHashSet to extract the vTable.\n";
 	}
@@ -1541,7 +1563,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageRemoveTempSet tempObject;
-		allVTables [140] = tempObject.getVTablePtr ();
+		allVTables [142] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageRemoveTempSet to extract the vTable.\n";
 	}
@@ -1551,7 +1573,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageRemoveUserSet tempObject;
-		allVTables [141] = tempObject.getVTablePtr ();
+		allVTables [143] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageRemoveUserSet to extract the vTable.\n";
 	}
@@ -1561,7 +1583,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageTestSetCopy tempObject;
-		allVTables [142] = tempObject.getVTablePtr ();
+		allVTables [144] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageTestSetCopy to extract the vTable.\n";
 	}
@@ -1571,7 +1593,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageTestSetScan tempObject;
-		allVTables [143] = tempObject.getVTablePtr ();
+		allVTables [145] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageTestSetScan to extract the vTable.\n";
 	}
@@ -1581,7 +1603,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StorageUnpinPage tempObject;
-		allVTables [144] = tempObject.getVTablePtr ();
+		allVTables [146] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StorageUnpinPage to extract the vTable.\n";
 	}
@@ -1591,7 +1613,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		StringIntPair tempObject;
-		allVTables [145] = tempObject.getVTablePtr ();
+		allVTables [147] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate StringIntPair to extract the vTable.\n";
 	}
@@ -1601,7 +1623,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		SumResult tempObject;
-		allVTables [146] = tempObject.getVTablePtr ();
+		allVTables [148] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate SumResult to extract the vTable.\n";
 	}
@@ -1611,7 +1633,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		Supervisor tempObject;
-		allVTables [147] = tempObject.getVTablePtr ();
+		allVTables [149] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate Supervisor to extract the vTable.\n";
 	}
@@ -1621,7 +1643,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		TensorBlock2D <Nothing> tempObject;
-		allVTables [148] = tempObject.getVTablePtr ();
+		allVTables [150] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate TensorBlock2D <Nothing> to extract the vTable.\n";
 	}
@@ -1631,7 +1653,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		TensorBlockIdentifier tempObject;
-		allVTables [149] = tempObject.getVTablePtr ();
+		allVTables [151] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate TensorBlockIdentifier to extract the vTable.\n";
 	}
@@ -1641,7 +1663,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		TensorBlockMeta tempObject;
-		allVTables [150] = tempObject.getVTablePtr ();
+		allVTables [152] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate TensorBlockMeta to extract the vTable.\n";
 	}
@@ -1651,7 +1673,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		TensorData2D <Nothing> tempObject;
-		allVTables [151] = tempObject.getVTablePtr ();
+		allVTables [153] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate TensorData2D <Nothing> to extract the vTable.\n";
 	}
@@ -1661,7 +1683,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		TensorMeta2D tempObject;
-		allVTables [152] = tempObject.getVTablePtr ();
+		allVTables [154] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate TensorMeta2D to extract the vTable.\n";
 	}
@@ -1671,7 +1693,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		TopKQueue <Nothing> tempObject;
-		allVTables [153] = tempObject.getVTablePtr ();
+		allVTables [155] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate TopKQueue <Nothing> to extract the vTable.\n";
 	}
@@ -1681,7 +1703,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		Tree tempObject;
-		allVTables [154] = tempObject.getVTablePtr ();
+		allVTables [156] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate Tree to extract the vTable.\n";
 	}
@@ -1691,7 +1713,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		TreeCrossProduct tempObject;
-		allVTables [155] = tempObject.getVTablePtr ();
+		allVTables [157] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate TreeCrossProduct to extract the vTable.\n";
 	}
@@ -1701,7 +1723,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		TreeNodeObjectBased tempObject;
-		allVTables [156] = tempObject.getVTablePtr ();
+		allVTables [158] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate TreeNodeObjectBased to extract the vTable.\n";
 	}
@@ -1711,7 +1733,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		TreeResult tempObject;
-		allVTables [157] = tempObject.getVTablePtr ();
+		allVTables [159] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate TreeResult to extract the vTable.\n";
 	}
@@ -1721,7 +1743,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		TreeResultAggregate tempObject;
-		allVTables [158] = tempObject.getVTablePtr ();
+		allVTables [160] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate TreeResultAggregate to extract the vTable.\n";
 	}
@@ -1731,7 +1753,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		TreeResultPostProcessing tempObject;
-		allVTables [159] = tempObject.getVTablePtr ();
+		allVTables [161] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate TreeResultPostProcessing to extract the vTable.\n";
 	}
@@ -1741,7 +1763,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		TupleSetExecuteQuery tempObject;
-		allVTables [160] = tempObject.getVTablePtr ();
+		allVTables [162] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate TupleSetExecuteQuery to extract the vTable.\n";
 	}
@@ -1751,7 +1773,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		TupleSetJobStage tempObject;
-		allVTables [161] = tempObject.getVTablePtr ();
+		allVTables [163] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate TupleSetJobStage to extract the vTable.\n";
 	}
@@ -1761,7 +1783,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		Vector <Nothing> tempObject;
-		allVTables [162] = tempObject.getVTablePtr ();
+		allVTables [164] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate Vector <Nothing> to extract the vTable.\n";
 	}
@@ -1771,7 +1793,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		VectorDoubleWriter tempObject;
-		allVTables [163] = tempObject.getVTablePtr ();
+		allVTables [165] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate VectorDoubleWriter to extract the vTable.\n";
 	}
@@ -1781,7 +1803,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		VectorFloatWriter tempObject;
-		allVTables [164] = tempObject.getVTablePtr ();
+		allVTables [166] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate VectorFloatWriter to extract the vTable.\n";
 	}
@@ -1791,7 +1813,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		WriteUserSet <Nothing> tempObject;
-		allVTables [165] = tempObject.getVTablePtr ();
+		allVTables [167] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate WriteUserSet <Nothing> to extract the vTable.\n";
 	}
@@ -1801,7 +1823,7 @@ objectTypeNamesList [getTypeName <ZB_Company> ()] = 166;
 	const UseTemporaryAllocationBlock tempBlock{1024 * 24};
 	try {
 		ZB_Company tempObject;
-		allVTables [166] = tempObject.getVTablePtr ();
+		allVTables [168] = tempObject.getVTablePtr ();
 	} catch (NotEnoughSpace &e) {
 		std :: cout << "Not enough memory to allocate ZB_Company to extract the vTable.\n";
 	}
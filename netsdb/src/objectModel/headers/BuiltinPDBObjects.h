@@ -164,3 +164,5 @@
 #include "/root/netsdb/src/builtInPDBObjects/headers/CatCreateSetRequest.h"
 #include "/root/netsdb/src/builtInPDBObjects/headers/EnsembleTreeUDFDouble.h"
 #include "/root/netsdb/src/builtInPDBObjects/headers/TupleSetExecuteQuery.h"
+#include "/root/netsdb/src/builtInPDBObjects/headers/DistributedStorageAddZoneMapAttribute.h"
+#include "/root/netsdb/src/builtInPDBObjects/headers/StorageAddZoneMapAttribute.h"
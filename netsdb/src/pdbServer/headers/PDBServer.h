@@ -21,8 +21,12 @@ typedef std::shared_ptr<PDBServer> PDBServerPtr;
 #include "PDBLogger.h"
 #include "PDBWork.h"
 #include "PDBCommunicator.h"
+#include "PDBConnectionReactor.h"
 #include <string>
 #include <map>
+#include <set>
+#include <deque>
+#include <pthread.h>
 
 // This class encapsulates a multi-threaded sever in PDB.  The way it works is that one simply
 // registers
@@ -64,6 +68,11 @@ public:
     // type
     void registerHandler(int16_t typeID, PDBCommWorkPtr handledBy);
 
+    // asks the server to keep a worker on a connection once it sends a request of the given type,
+    // instead of giving the connection back to the reactor after each request, as the peers that
+    // send it hold the connection open and wait on it, e.g. the DataProxy of a backend
+    void registerLongConnectionRequest(int16_t typeID);
+
     // like registerHandler but repeat the work in a time interval
     // TODO: to be implemented later.
     //  void registerTimedHandler (uint32_t intervalInMilliseconds, PDBWorkPtr handledBy);
@@ -91,8 +100,11 @@ public:
     // this
     // is not the last request over this PDBCommunicator object; buzzMeWhenDone is sent to the
     // worker that
-    // is spawned to handle the request
-    bool handleOneRequest(PDBBuzzerPtr buzzMeWhenDone, PDBCommunicatorPtr myCommunicator);
+    // is spawned to handle the request; if inThisWorker, the request is handled by the calling
+    // worker instead, so that the request doesn't need a second worker
+    bool handleOneRequest(PDBBuzzerPtr buzzMeWhenDone,
+                          PDBCommunicatorPtr myCommunicator,
+                          bool inThisWorker = false);
 
     void stop();  // added by Jia
 
@@ -120,6 +132,31 @@ private:
     // handles a request using the given PDBCommunicator to obtain the data
     void handleRequest(PDBCommunicatorPtr myCommunicator);
 
+    // queues the connection whose request the reactor has read, for a worker to handle the request
+    // and to give the connection back to the reactor; this never waits, as it is called by the
+    // thread of the reactor
+    void handleReadyRequest(PDBCommunicatorPtr myCommunicator);
+
+    // gives the queued connections to workers, waiting for a worker if all are busy
+    void dispatchReadyRequests();
+
+    friend void* callDispatchReadyRequests(void* serverInstance);
+
+    // waits for the requests of the connections between their requests, if USE_CONNECTION_REACTOR
+    PDBConnectionReactorPtr reactor;
+
+    // the connections whose requests have arrived, which wait for a worker; a connection is in it
+    // at most once, as the reactor doesn't watch it again until its request is handled
+    std::deque<PDBCommunicatorPtr> readyConnections;
+    pthread_mutex_t readyMutex;
+    pthread_cond_t readyCond;
+
+    // the thread that gives the queued connections to workers
+    pthread_t dispatcherThread;
+
+    // the types of the requests whose connections keep a worker
+    std::set<int16_t> longConnectionRequests;
+
     // true when the server is done
     bool allDone;
 
@@ -24,6 +24,7 @@
 #include "ServerFunctionality.h"
 #include "UseTemporaryAllocationBlock.h"
 #include "SimpleRequestResult.h"
+#include "GenericWork.h"
 #include <memory>
 
 namespace pdb {
@@ -37,6 +38,8 @@ PDBServer::PDBServer(int portNumberIn, int numConnectionsIn, PDBLoggerPtr myLogg
     myLogger = myLoggerIn;
     isInternet = true;
     allDone = false;
+    pthread_mutex_init(&readyMutex, nullptr);
+    pthread_cond_init(&readyCond, nullptr);
     struct sigaction sa;
     memset(&sa, '\0', sizeof(sa));
     sa.sa_handler = SIG_IGN;
@@ -53,6 +56,8 @@ PDBServer::PDBServer(string unixFileIn, int numConnectionsIn, PDBLoggerPtr myLog
     myLogger = myLoggerIn;
     isInternet = false;
     allDone = false;
+    pthread_mutex_init(&readyMutex, nullptr);
+    pthread_cond_init(&readyCond, nullptr);
     struct sigaction sa;
     memset(&sa, '\0', sizeof(sa));
     sa.sa_handler = SIG_IGN;
@@ -65,6 +70,10 @@ void PDBServer::registerHandler(int16_t requestID, PDBCommWorkPtr handledBy) {
     handlers[requestID] = handledBy;
 }
 
+void PDBServer::registerLongConnectionRequest(int16_t requestID) {
+    longConnectionRequests.insert(requestID);
+}
+
 // this is the entry point for the listener to the port
 
 void* callListen(void* serverInstance) {
@@ -73,10 +82,35 @@ void* callListen(void* serverInstance) {
     return nullptr;
 }
 
+void* callDispatchReadyRequests(void* serverInstance) {
+    PDBServer* temp = static_cast<PDBServer*>(serverInstance);
+    temp->dispatchReadyRequests();
+    return nullptr;
+}
+
 void PDBServer::listen() {
 
     string errMsg;
 
+    // the connections are watched by the reactor between their requests, so that they don't keep
+    // workers waiting
+    if (USE_CONNECTION_REACTOR) {
+        reactor = make_shared<PDBConnectionReactor>(
+            myLogger, [this](PDBCommunicatorPtr myCommunicator) {
+                handleReadyRequest(myCommunicator);
+            });
+        if (!reactor->start(errMsg)) {
+            myLogger->error(errMsg + ", so a worker waits on each connection");
+            reactor = nullptr;
+        } else if (pthread_create(&dispatcherThread, nullptr, callDispatchReadyRequests, this) !=
+                   0) {
+            myLogger->error("PDBServer: can't start the dispatcher of the reactor, so a worker "
+                            "waits on each connection");
+            reactor->stop();
+            reactor = nullptr;
+        }
+    }
+
     // two cases: first, we are connecting to the internet
     if (isInternet) {
 
@@ -219,14 +253,77 @@ PDBLoggerPtr PDBServer::getLogger() {
 
 void PDBServer::handleRequest(PDBCommunicatorPtr myCommunicator) {
 
+    if (reactor != nullptr) {
+        reactor->addConnection(myCommunicator);
+        return;
+    }
     ServerWorkPtr tempWork{make_shared<ServerWork>(*this)};
     tempWork->setGuts(myCommunicator);
     PDBWorkerPtr tempWorker = myWorkers->getWorker();
     tempWorker->execute(tempWork, tempWork->getLinkedBuzzer());
 }
 
+void PDBServer::handleReadyRequest(PDBCommunicatorPtr myCommunicator) {
+
+    // the thread of the reactor only queues the connection, so that it goes on reading the
+    // requests of the other connections while all workers are busy
+    pthread_mutex_lock(&readyMutex);
+    readyConnections.push_back(myCommunicator);
+    pthread_cond_signal(&readyCond);
+    pthread_mutex_unlock(&readyMutex);
+}
+
+void PDBServer::dispatchReadyRequests() {
+
+    PDBConnectionReactorPtr myReactor = reactor;
+    while (true) {
+        pthread_mutex_lock(&readyMutex);
+        while (readyConnections.empty() && !allDone) {
+            // allDone is set without signaling us, so we look at it every second
+            struct timespec deadline;
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_sec += 1;
+            pthread_cond_timedwait(&readyCond, &readyMutex, &deadline);
+        }
+        if (readyConnections.empty()) {
+            pthread_mutex_unlock(&readyMutex);
+            break;
+        }
+        PDBCommunicatorPtr myCommunicator = readyConnections.front();
+        readyConnections.pop_front();
+        pthread_mutex_unlock(&readyMutex);
+
+        PDBWorkPtr myWork = make_shared<GenericWork>(
+            [this, myReactor, myCommunicator](PDBBuzzerPtr callerBuzzer) {
+                PDBBuzzerPtr myBuzzer = make_shared<PDBBuzzer>([&](PDBAlarm myAlarm) {});
+                // a connection whose peer holds it open and waits on it keeps this worker for
+                // the rest of its requests, as it did before the reactor, so that its requests
+                // never wait for a worker behind the requests that wait on them
+                if (longConnectionRequests.count(myCommunicator->getObjectTypeID()) > 0) {
+                    myCommunicator->setLongConnection(true);
+                }
+                bool keepGoing = handleOneRequest(myBuzzer, myCommunicator, true);
+                while (keepGoing && myCommunicator->isLongConnection() && !allDone) {
+                    keepGoing = handleOneRequest(myBuzzer, myCommunicator, true);
+                }
+                if (keepGoing && !allDone) {
+                    myReactor->resumeConnection(myCommunicator);
+                } else {
+                    myReactor->removeConnection(myCommunicator);
+                }
+                callerBuzzer->buzz(PDBAlarm::WorkAllDone);
+            });
+        // this waits if all workers are busy, which holds up the queued requests, but not the
+        // reactor
+        PDBWorkerPtr tempWorker = myWorkers->getWorker();
+        tempWorker->execute(myWork, make_shared<PDBBuzzer>([&](PDBAlarm myAlarm) {}));
+    }
+}
+
 // returns true while we need to keep going... false when this connection is done
-bool PDBServer::handleOneRequest(PDBBuzzerPtr callerBuzzer, PDBCommunicatorPtr myCommunicator) {
+bool PDBServer::handleOneRequest(PDBBuzzerPtr callerBuzzer,
+                                 PDBCommunicatorPtr myCommunicator,
+                                 bool inThisWorker) {
 
     // figure out what type of message the client is sending us
     int16_t requestID = myCommunicator->getObjectTypeID();
@@ -307,6 +404,16 @@ bool PDBServer::handleOneRequest(PDBBuzzerPtr callerBuzzer, PDBCommunicatorPtr m
 
         // End code replacement for testing
 
+        // a worker of the reactor runs the handler itself: if it waited for a second worker, the
+        // workers could all be waiting for each other
+        if (inThisWorker) {
+            PDBCommWorkPtr tempWork = handlers[requestID]->clone();
+            tempWork->setGuts(myCommunicator);
+            tempWork->execute(myWorkers.get(), callerBuzzer);
+            myLogger->trace("PDBServer: handler has completed its work");
+            return true;
+        }
+
         // Chris' old code: (Observed problem: sometimes, buzzer never get buzzed.)
         // get a worker to run the handler (this blocks if no workers available)
         PDBWorkerPtr tempWorker = myWorkers->getWorker();
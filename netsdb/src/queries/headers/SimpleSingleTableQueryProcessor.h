@@ -3,6 +3,7 @@
 #define SINGLE_TABLE_QP_H
 
 #include <memory>
+#include <functional>
 #include "Handle.h"
 
 namespace pdb {
@@ -51,6 +52,35 @@ public:
         return 0;
     }
 
+    // to give the processor the pages to spill to when the output page is full, so that
+    // fillNextOutputPage() spills instead of returning true; the spilled records are hash
+    // partitioned into numSpillPartitions spill partitions, and each spilled page holds one spill
+    // partition, which is given to writeBackSpillPage() with the page
+    virtual void setSpillPages(std::function<std::pair<void*, size_t>()> getSpillPage,
+                               std::function<void(void*, int)> writeBackSpillPage,
+                               int numSpillPartitions) {}
+
+    // to spill what is left in the output page, and to empty the output page
+    virtual void spillOutputPage() {}
+
+    // to set the level of the spill partitions that we spill to; each level partitions the
+    // records with another hash function, so that a spill partition is split at the next level
+    virtual void setSpillLevel(int spillLevel) {}
+
+    // to load the records in a spilled page to process
+    virtual void loadSpilledInput(void* spilledPage) {}
+
+    // the number of pages that the processor has spilled
+    virtual int getNumSpilledPages() {
+        return 0;
+    }
+
+    // true if the processor dropped records, because it couldn't spill them; the results are
+    // then incomplete
+    virtual bool hasFailed() {
+        return false;
+    }
+
 
 };
 }
@@ -3,6 +3,7 @@
 
 
 #include <memory>
+#include "JoinBloomFilter.h"
 
 namespace pdb {
 
@@ -39,12 +40,25 @@ public:
         return materialized;
     }
 
+    // set the Bloom filter over the join hashes that were built into this hash set on this node
+    void setJoinFilter(JoinBloomFilterPtr joinFilter) {
+        this->joinFilter = joinFilter;
+    }
+
+    // return the Bloom filter over the join hashes, or nullptr if there is none
+    JoinBloomFilterPtr getJoinFilter() {
+        return joinFilter;
+    }
+
 
 private:
 
     //is this HashSet materialized?
     bool materialized = false;
 
+    // the Bloom filter over the join hashes in this hash set
+    JoinBloomFilterPtr joinFilter = nullptr;
+
 
 
 
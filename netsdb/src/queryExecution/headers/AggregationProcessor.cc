@@ -95,6 +95,8 @@ void AggregationProcessor<KeyType, ValueType>::loadOutputPage(void* pageToWriteT
     blockPtr = nullptr;
     blockPtr = std::make_shared<UseTemporaryAllocationBlock>(pageToWriteTo, numBytesInPage);
     outputData = makeObject<Map<KeyType, ValueType>>(2);
+    outputPage = pageToWriteTo;
+    outputPageSize = numBytesInPage;
 }
 
 template <class KeyType, class ValueType>
@@ -113,56 +115,64 @@ bool AggregationProcessor<KeyType, ValueType>::fillNextOutputPage() {
 
 
 
-    // we are not finalized, so process the page
-    try {
+    // we are not finalized, so process the page; if we can spill when the output page is full,
+    // we spill it and go on with the same item in the emptied page, unless the page is empty
+    // already, as the item doesn't fit then
+    while (true) {
+        try {
 
-        // see if there are any more items in current map to iterate over
-        while (true) {
+            // see if there are any more items in current map to iterate over
+            while (true) {
 
-            if (!((*begin) != (*end))) {
-                return false;
-            }
-            KeyType curKey = (*(*begin)).key;
-            ValueType curValue = (*(*begin)).value;
-            // if the key is not there
-            if (outputData->count(curKey) == 0) {
-                ValueType* temp = nullptr;
-
-		try {
-                    temp = &((*outputData)[curKey]);
-		} catch (NotEnoughSpace& n) {
-		    throw n;
-		}
-                try {
-                    *temp = curValue;
-                    numHashKeys++;
-                    // if we couldn't fit the value
-                } catch (NotEnoughSpace& n) {
-                    outputData->setUnused(curKey);
-                    throw n;
+                if (!((*begin) != (*end))) {
+                    return false;
                 }
-                // the key is there
-            } else {
-                // get the value and copy of it
-                ValueType& temp = (*outputData)[curKey];
-                ValueType copy = temp;
-
-                // and add to old value, producing a new one
-                try {
-                    temp = copy + curValue;
-                    // if we got here, it means we run out of RAM and we need to restore the old
-                    // value in the destination hash map
-                } catch (NotEnoughSpace& n) {
-                    temp = copy;
-                    throw n;
+                KeyType curKey = (*(*begin)).key;
+                ValueType curValue = (*(*begin)).value;
+                // if the key is not there
+                if (outputData->count(curKey) == 0) {
+                    ValueType* temp = nullptr;
+
+                    try {
+                        temp = &((*outputData)[curKey]);
+                    } catch (NotEnoughSpace& n) {
+                        throw n;
+                    }
+                    try {
+                        *temp = curValue;
+                        numHashKeys++;
+                        // if we couldn't fit the value
+                    } catch (NotEnoughSpace& n) {
+                        outputData->setUnused(curKey);
+                        throw n;
+                    }
+                    // the key is there
+                } else {
+                    // get the value and copy of it
+                    ValueType& temp = (*outputData)[curKey];
+                    ValueType copy = temp;
+
+                    // and add to old value, producing a new one
+                    try {
+                        temp = copy + curValue;
+                        // if we got here, it means we run out of RAM and we need to restore the
+                        // old value in the destination hash map
+                    } catch (NotEnoughSpace& n) {
+                        temp = copy;
+                        throw n;
+                    }
                 }
+                ++(*begin);
             }
-            ++(*begin);
-        }
 
-    } catch (NotEnoughSpace& n) {
-        getRecord(outputData);
-        return true;
+        } catch (NotEnoughSpace& n) {
+            if ((getSpillPage != nullptr) && (failed == false) && (outputData->size() > 0)) {
+                spillOutputPage();
+                continue;
+            }
+            getRecord(outputData);
+            return true;
+        }
     }
 }
 
@@ -197,6 +207,142 @@ int AggregationProcessor<KeyType, ValueType>::getNumHashKeys() {
     return numHashKeys;
 }
 
+template <class KeyType, class ValueType>
+void AggregationProcessor<KeyType, ValueType>::setSpillPages(
+    std::function<std::pair<void*, size_t>()> getSpillPage,
+    std::function<void(void*, int)> writeBackSpillPage,
+    int numSpillPartitions) {
+    this->getSpillPage = getSpillPage;
+    this->writeBackSpillPage = writeBackSpillPage;
+    this->numSpillPartitions = numSpillPartitions;
+}
+
+// spills all keys in the output page with their partial aggregates, so that the output page and
+// the spilled pages never have the same key, and the spill partitions can be merged one by one;
+// the keys are spilled one spill partition after the other, so that each spilled page holds one
+// spill partition, and a merge only reads the pages of its spill partition
+template <class KeyType, class ValueType>
+void AggregationProcessor<KeyType, ValueType>::spillOutputPage() {
+    if ((outputData == nullptr) || (outputData->size() == 0)) {
+        return;
+    }
+    for (int i = 0; i < numSpillPartitions; i++) {
+        for (auto iter = outputData->begin(); iter != outputData->end(); ++iter) {
+            if (getSpillPartition((*iter).key) == i) {
+                spill((*iter).key, (*iter).value, i);
+            }
+        }
+        flushSpillPage();
+    }
+    // the spilled keys are counted again when their spill partition is merged
+    numHashKeys -= outputData->size();
+    clearOutputPage();
+    loadOutputPage(outputPage, outputPageSize);
+}
+
+template <class KeyType, class ValueType>
+void AggregationProcessor<KeyType, ValueType>::spill(const KeyType& key,
+                                                     const ValueType& value,
+                                                     int spillPartition) {
+    if (failed == true) {
+        return;
+    }
+    for (int tries = 0; tries < 2; tries++) {
+        if (spillPage == nullptr) {
+            std::pair<void*, size_t> page = getSpillPage();
+            if (page.first == nullptr) {
+                std::cout << "ERROR: partition-" << id << " can't get a spill page" << std::endl;
+                failed = true;
+                return;
+            }
+            spillPage = page.first;
+            this->spillPartition = spillPartition;
+            spillBlock = std::make_shared<UseTemporaryAllocationBlock>(page.first, page.second);
+            spillMap = makeObject<AggregationMap<KeyType, ValueType>>();
+            if (spillMap == nullptr) {
+                std::cout << "ERROR: partition-" << id
+                          << " can't create a spill map in a page with size=" << page.second
+                          << std::endl;
+                spillBlock = nullptr;
+                spillPage = nullptr;
+                failed = true;
+                return;
+            }
+            spillMap->setHashPartitionId(spillPartition);
+        }
+        ValueType* temp = nullptr;
+        try {
+            temp = &((*spillMap)[key]);
+            *temp = value;
+            return;
+        } catch (NotEnoughSpace& n) {
+            if (temp != nullptr) {
+                spillMap->setUnused(key);
+            }
+            flushSpillPage();
+        }
+    }
+    std::cout << "ERROR: a key of partition-" << id << " doesn't fit in an empty spill page"
+              << std::endl;
+    failed = true;
+}
+
+template <class KeyType, class ValueType>
+void AggregationProcessor<KeyType, ValueType>::flushSpillPage() {
+    if (spillPage == nullptr) {
+        return;
+    }
+    // make the spill map the root of the page, and leave the page without freeing the map
+    getRecord(spillMap);
+    spillMap.emptyOutContainingBlock();
+    spillMap = nullptr;
+    spillBlock = nullptr;
+    writeBackSpillPage(spillPage, spillPartition);
+    spillPage = nullptr;
+    numSpilledPages++;
+}
+
+// each level mixes the hash of the key with another seed, as the keys of a spill partition have
+// the same spill partition at the level where they were spilled
+template <class KeyType, class ValueType>
+int AggregationProcessor<KeyType, ValueType>::getSpillPartition(const KeyType& key) {
+    size_t hash = Hasher<KeyType>::hash(key) + (size_t)(spillLevel + 1) * 0x9e3779b97f4a7c15ULL;
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return (int)(hash % numSpillPartitions);
+}
+
+template <class KeyType, class ValueType>
+void AggregationProcessor<KeyType, ValueType>::setSpillLevel(int spillLevel) {
+    this->spillLevel = spillLevel;
+}
+
+template <class KeyType, class ValueType>
+void AggregationProcessor<KeyType, ValueType>::loadSpilledInput(void* spilledPage) {
+    Record<AggregationMap<KeyType, ValueType>>* myRec =
+        (Record<AggregationMap<KeyType, ValueType>>*)spilledPage;
+    curMap = myRec->getRootObject();
+    if (begin != nullptr) {
+        delete begin;
+    }
+    if (end != nullptr) {
+        delete end;
+    }
+    begin = new PDBMapIterator<KeyType, ValueType>(curMap->getArray(), true);
+    end = new PDBMapIterator<KeyType, ValueType>(curMap->getArray());
+}
+
+template <class KeyType, class ValueType>
+int AggregationProcessor<KeyType, ValueType>::getNumSpilledPages() {
+    return numSpilledPages;
+}
+
+template <class KeyType, class ValueType>
+bool AggregationProcessor<KeyType, ValueType>::hasFailed() {
+    return failed;
+}
+
 }
 
 
@@ -9,6 +9,7 @@
 #include "PDBVector.h"
 #include "Handle.h"
 #include "SimpleSingleTableQueryProcessor.h"
+#include <functional>
 
 namespace pdb {
 
@@ -29,8 +30,26 @@ public:
     void clearInputPage() override;
     bool needsProcessInput() override;
     int getNumHashKeys() override;
+    void setSpillPages(std::function<std::pair<void*, size_t>()> getSpillPage,
+                       std::function<void(void*, int)> writeBackSpillPage,
+                       int numSpillPartitions) override;
+    void spillOutputPage() override;
+    void setSpillLevel(int spillLevel) override;
+    void loadSpilledInput(void* spilledPage) override;
+    int getNumSpilledPages() override;
+    bool hasFailed() override;
 
 private:
+    // to add a key and its partial aggregate to the spill page of its spill partition, and to
+    // move to a new spill page when that one is full
+    void spill(const KeyType& key, const ValueType& value, int spillPartition);
+
+    // to make the spill map the root of the spill page, and to write back the page
+    void flushSpillPage();
+
+    // the spill partition of a key at the current spill level
+    int getSpillPartition(const KeyType& key);
+
     UseTemporaryAllocationBlockPtr blockPtr;
     Handle<Vector<Handle<AggregationMap<KeyType, ValueType>>>> inputData;
     Handle<Map<KeyType, ValueType>> outputData;
@@ -44,6 +63,27 @@ private:
 
     // statistics
     int numHashKeys;
+
+    // the output page, which we load again after we spill it
+    void* outputPage = nullptr;
+    size_t outputPageSize = 0;
+
+    // to get and write back the pages that we spill to, when the output page is full
+    std::function<std::pair<void*, size_t>()> getSpillPage = nullptr;
+    std::function<void(void*, int)> writeBackSpillPage = nullptr;
+    int numSpillPartitions = 0;
+    int spillLevel = 0;
+
+    // the page that we spill to, which has the map of one spill partition, and the allocation
+    // block on it
+    void* spillPage = nullptr;
+    int spillPartition = 0;
+    Handle<AggregationMap<KeyType, ValueType>> spillMap = nullptr;
+    UseTemporaryAllocationBlockPtr spillBlock = nullptr;
+    int numSpilledPages = 0;
+
+    // true once a key is dropped, because it couldn't be spilled
+    bool failed = false;
 };
 }
 
@@ -9,6 +9,7 @@
 #include "Handle.h"
 #include "TupleSetJobStage.h"
 #include "PipelineStage.h"
+#include "ShuffleSender.h"
 #include <memory>
 
 using namespace std;
@@ -24,8 +25,9 @@ namespace pdb {
 
 class HashPartitionWork : public pdb::PDBWork {
 public:
+    // sender is the sender of the pages to the id-th node, or nullptr if that is this node
     HashPartitionWork(int id, PageCircularBufferIteratorPtr iter, PipelineStage * stage, 
-         atomic_int& counter);
+         ShuffleSenderPtr sender, atomic_int& counter);
     ~HashPartitionWork();
 
     // do the actual work
@@ -35,6 +37,7 @@ private:
     int id;
     PageCircularBufferIteratorPtr iter;
     PipelineStage * stage;
+    ShuffleSenderPtr sender;
     Handle<TupleSetJobStage> jobStage;
     ConfigurationPtr conf;
     atomic_int& counter;
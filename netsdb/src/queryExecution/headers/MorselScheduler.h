@@ -0,0 +1,143 @@
+#ifndef MORSEL_SCHEDULER_H
+#define MORSEL_SCHEDULER_H
+
+#include "PDBLogger.h"
+#include "PDBPage.h"
+#include "PageCircularBufferIterator.h"
+#include <pthread.h>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pdb {
+
+class MorselScheduler;
+typedef std::shared_ptr<MorselScheduler> MorselSchedulerPtr;
+
+// this class schedules the pages that a pipeline stage scans, which we call morsels, to the
+// workers of the stage: a feeder deals the morsels to one queue per worker; each worker takes
+// morsels from the head of its own queue and, when that is empty, steals morsels from the tail of
+// the queues of the other workers, so that a slow worker doesn't hold up the stage while others
+// are idle; the stage is done when the feeder has closed the scheduler and all morsels are taken.
+// The scheduler also measures, for each worker, the time spent running morsels and the time spent
+// waiting for morsels, so that we can see the skew of a stage
+
+class MorselScheduler {
+
+public:
+    // to create a scheduler for numWorkers workers, which holds at most maxQueuedMorsels morsels
+    // that are not taken, so that the feeder doesn't pin more pages than the scan buffer would
+    MorselScheduler(int numWorkers, unsigned int maxQueuedMorsels, PDBLoggerPtr logger);
+
+    ~MorselScheduler();
+
+    // to add a morsel to the queue of the next worker in turn;
+    // it blocks while maxQueuedMorsels morsels are not taken
+    void addMorsel(PDBPagePtr morsel);
+
+    // to tell the workers that no more morsels will be added
+    void close();
+
+    // to take a morsel for the worker; it blocks while all queues are empty and the scheduler is
+    // not closed, and returns nullptr when all morsels are taken and the scheduler is closed.
+    // The time since the worker took its last morsel is counted as busy time, and the time in
+    // this call as idle time
+    PDBPagePtr getMorsel(int worker);
+
+    // to count the time since the worker took its last morsel as busy time, when the worker
+    // finds that there is no more morsel
+    void finishMorsel(int worker);
+
+    // true if the scheduler is closed and all morsels are taken
+    bool isDrained();
+
+    // to get an iterator that a scanner of the worker can take morsels from
+    PageCircularBufferIteratorPtr getIterator(int worker);
+
+    int getNumWorkers() {
+        return numWorkers;
+    }
+
+    // the nanoseconds that the worker spent running morsels
+    long getBusyNanos(int worker);
+
+    // the nanoseconds that the worker spent waiting for morsels
+    long getIdleNanos(int worker);
+
+    // the number of morsels that the worker ran
+    long getNumMorsels(int worker);
+
+    // the number of those morsels that the worker stole from others
+    long getNumStolenMorsels(int worker);
+
+    // to print the time and the morsels of each worker, and the ratio of the busy time of the
+    // busiest worker to the average busy time
+    std::string printWorkerStats();
+
+private:
+    // the morsels dealt to one worker, and what we measured about the worker
+    struct WorkerQueue {
+        pthread_mutex_t mutex;
+        std::deque<PDBPagePtr> morsels;
+        std::chrono::steady_clock::time_point lastTaken;
+        bool running = false;
+        long busyNanos = 0;
+        long idleNanos = 0;
+        long numMorsels = 0;
+        long numStolenMorsels = 0;
+    };
+
+    // to take a morsel from the head of the worker's own queue, or from the tail of another queue;
+    // the caller holds mutex
+    PDBPagePtr takeMorsel(int worker, bool& stolen);
+
+    int numWorkers;
+    unsigned int maxQueuedMorsels;
+    PDBLoggerPtr logger;
+    std::vector<WorkerQueue*> queues;
+
+    // the worker that gets the next morsel
+    int nextWorker = 0;
+
+    // the number of morsels in all queues
+    unsigned int numQueuedMorsels;
+    bool closed = false;
+
+    // workers wait on morselCond for morsels, and the feeder waits on spaceCond for space
+    pthread_mutex_t mutex;
+    pthread_cond_t morselCond;
+    pthread_cond_t spaceCond;
+};
+
+
+// this class wraps a worker's view of a MorselScheduler in the iterator that scanners take, so
+// that a scanner works the same on morsels as on a PageCircularBuffer
+class MorselIterator : public PageCircularBufferIterator {
+
+public:
+    MorselIterator(unsigned int id, MorselScheduler* scheduler, PDBLoggerPtr logger)
+        : PageCircularBufferIterator(id, nullptr, logger), scheduler(scheduler) {}
+
+    // return true if there may be more morsels
+    bool hasNext() override {
+        if (scheduler->isDrained()) {
+            scheduler->finishMorsel(getId());
+            return false;
+        }
+        return true;
+    }
+
+    // return the next morsel of the worker, or nullptr if there is no more
+    PDBPagePtr next() override {
+        return scheduler->getMorsel(getId());
+    }
+
+private:
+    // the scheduler outlives the iterator, as the stage waits for all workers to finish
+    MorselScheduler* scheduler;
+};
+}
+
+#endif
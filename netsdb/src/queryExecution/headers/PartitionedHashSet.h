@@ -3,7 +3,10 @@
 
 
 #include "AbstractHashSet.h"
+#include "PDBPage.h"
 #include <pthread.h>
+#include <functional>
+#include <vector>
 
 namespace pdb {
 
@@ -40,6 +43,16 @@ private:
     // mutex
     pthread_mutex_t myMutex;
 
+    // the pages of a temp set that each partition spilled the build records that don't fit in
+    // its page to; each spilled page holds a map of the same type as the partition page
+    std::vector<std::vector<PDBPagePtr>> spilledPages;
+
+    // the temp set that the spilled pages belong to
+    SetID spillSetId = 0;
+
+    // to remove the temp set of the spilled pages when this hash set is cleaned up
+    std::function<void(SetID)> removeSpillSet = nullptr;
+
 public:
     // constructor
     PartitionedHashSet(std::string myName, size_t pageSize) {
@@ -120,17 +133,75 @@ public:
             pthread_mutex_lock(&myMutex);
             partitionPages.push_back(block);
             partitionStatus.push_back(false);
+            spilledPages.push_back(std::vector<PDBPagePtr>());
             pthread_mutex_unlock(&myMutex);
         } 
         return block;
     }
 
+    // set the temp set that the partitions spill to, and how to remove it
+    void setSpillSet(SetID spillSetId, std::function<void(SetID)> removeSpillSet) {
+        pthread_mutex_lock(&myMutex);
+        this->spillSetId = spillSetId;
+        this->removeSpillSet = removeSpillSet;
+        pthread_mutex_unlock(&myMutex);
+    }
+
+    // get the temp set that the partitions spill to
+    SetID getSpillSetId() {
+        return spillSetId;
+    }
+
+    // add a page that a partition spilled build records to
+    void addSpilledPage(unsigned int partitionId, PDBPagePtr page) {
+        pthread_mutex_lock(&myMutex);
+        if (partitionId < spilledPages.size()) {
+            spilledPages[partitionId].push_back(page);
+        }
+        pthread_mutex_unlock(&myMutex);
+    }
+
+    // get the pages that a partition spilled build records to
+    std::vector<PDBPagePtr> getSpilledPages(unsigned int partitionId) {
+        std::vector<PDBPagePtr> ret;
+        pthread_mutex_lock(&myMutex);
+        if (partitionId < spilledPages.size()) {
+            ret = spilledPages[partitionId];
+        }
+        pthread_mutex_unlock(&myMutex);
+        return ret;
+    }
+
+    // replace the pages that a partition spilled, e.g. with the same pages pinned again
+    void setSpilledPages(unsigned int partitionId, std::vector<PDBPagePtr> pages) {
+        pthread_mutex_lock(&myMutex);
+        if (partitionId < spilledPages.size()) {
+            spilledPages[partitionId] = pages;
+        }
+        pthread_mutex_unlock(&myMutex);
+    }
+
+    // get the number of pages that all partitions spilled
+    size_t getNumSpilledPages() {
+        size_t retNum = 0;
+        pthread_mutex_lock(&myMutex);
+        for (auto& pages : spilledPages) {
+            retNum += pages.size();
+        }
+        pthread_mutex_unlock(&myMutex);
+        return retNum;
+    }
+
     // clean up all pages
     void cleanup() override {
         if (isCleaned == false) {
             for (int i = 0; i < partitionPages.size(); i++) {
                 free(partitionPages[i]);
             }
+            if (removeSpillSet != nullptr) {
+                removeSpillSet(spillSetId);
+                removeSpillSet = nullptr;
+            }
             isCleaned = true;
 #ifdef PROFILING
             std::cout << "partitioned hash set: " << this->setName << " is removed" << std::endl;
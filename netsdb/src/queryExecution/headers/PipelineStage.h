@@ -15,6 +15,9 @@
 #include "PartitionedHashSet.h"
 #include "SetSpecifier.h"
 #include "DataProxy.h"
+#include "PageZoneMap.h"
+#include "JoinBloomFilter.h"
+#include "ShuffleSender.h"
 #include <vector>
 #include <memory>
 #include <unordered_map>
@@ -75,6 +78,18 @@ private:
     // vector of nodeId for shuffling
     std::vector<int> nodeIds;
 
+    // the Bloom filter over the hashes of the other side of the join that this stage partitions
+    // for, which is shipped with the stage and shared by all threads
+    JoinBloomFilterPtr joinFilter = nullptr;
+
+    // the send buffers that all shuffle senders of this stage share
+    ShuffleSendBufferPoolPtr sendBufferPool;
+
+    // whether a thread of this stage failed, and why; the job stage fails if one did
+    bool failed = false;
+    std::string failureMsg;
+    pthread_mutex_t failureMutex;
+
 
 public:
     // destructor
@@ -103,23 +118,26 @@ public:
                                     std::string address,
                                     int port,
                                     std::string& errMsg);
-    // send Shuffle data
-    bool sendData(PDBCommunicatorPtr conn,
-                  char* bytes,
-                  size_t size,
-                  std::string databaseName,
-                  std::string setName,
-                  std::string& errMsg,
-                  int counter = 0);
+    // creates a sender of shuffle data to the i-th node, which sends the pages with a worker of
+    // the server, and stores them to the sink set, as pages if inLoop is true, or as objects
+    ShuffleSenderPtr createShuffleSender(HermesExecutionServer* server, int i, bool inLoop);
 
     // tuning the backend circular buffer size
     size_t getBackendCircularBufferSize(bool& success, std::string& errMsg);
 
-    // get iterators to scan a user set
-    std::vector<PageCircularBufferIteratorPtr> getUserSetIterators(HermesExecutionServer* server,
-                                                                   int numThreads,
-                                                                   bool& success,
-                                                                   std::string& errMsg);
+    // get iterators to scan a user set, skipping pages whose zone maps can't satisfy
+    // zoneMapPredicate if it is not nullptr
+    std::vector<PageCircularBufferIteratorPtr> getUserSetIterators(
+        HermesExecutionServer* server,
+        int numThreads,
+        bool& success,
+        std::string& errMsg,
+        const ZoneMapPredicate* zoneMapPredicate = nullptr);
+
+    // get the zone map predicate of a SelectionComp that directly consumes the scanned set
+    bool getZoneMapPredicate(Handle<ComputePlan> plan,
+                             std::vector<std::string>& buildTheseTupleSets,
+                             ZoneMapPredicate& predicate);
 
     // get bufferss to scan a user set in a sharing way, so that each iterator is linked to a buffer
     // and will scan all pages
@@ -134,6 +152,33 @@ public:
     // create proxy
     DataProxyPtr createProxy(int i, pthread_mutex_t connection_mutex, std::string& errMsg);
 
+    // get the partitioned hash sets that this stage probes, which spilled pages in their builds
+    std::vector<PartitionedHashSetPtr> getSpilledHashSets(HermesExecutionServer* server);
+
+    // pin the pages that the builds of the hash sets to probe spilled, so that probers can read
+    // them; all spilled pages of all partitions stay pinned until the stage is done, as the probe
+    // tuples are not spilled and each prober looks a hash up in every spilled map of its
+    // partition; proxy is set to the proxy that pinned them, or nullptr if no page was spilled;
+    // it returns false, with no page pinned, if a page can't be pinned, e.g. when the spilled
+    // pages don't fit in the page cache together
+    bool pinSpilledHashSets(HermesExecutionServer* server,
+                            pthread_mutex_t connection_mutex,
+                            DataProxyPtr& proxy,
+                            std::string& errMsg);
+
+    // unpin the pages that pinSpilledHashSets() pinned
+    void unpinSpilledHashSets(HermesExecutionServer* server, DataProxyPtr proxy);
+
+    // record that a thread of this stage failed, so that the job stage fails
+    void reportFailure(std::string errMsg);
+
+    // return whether a thread of this stage failed, and set errMsg to why
+    bool hasFailed(std::string& errMsg);
+
+    // unpin the pages that are left in the iterator of a thread that stopped early, so that the
+    // scanner that feeds them doesn't block on a full buffer
+    void drainIterator(PageCircularBufferIteratorPtr iterator, DataProxyPtr proxy);
+
     // execute pipeline
     void executePipelineWork(int i,
                              SetSpecifierPtr outputSet,
@@ -0,0 +1,205 @@
+#ifndef SHUFFLE_SENDER_H
+#define SHUFFLE_SENDER_H
+
+#include "PDBLogger.h"
+#include "PDBCommunicator.h"
+#include "GenericWork.h"
+#include "PDBWorker.h"
+#include "StreamCodecSelector.h"
+#include <pthread.h>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * This class sends the shuffled pages of one sink to one node over one connection.
+ * A sink gives it a page with send(), which compresses the page into one of a few send buffers
+ * that are reused, and queues it, so that the sink can go on with the next page at once. A
+ * worker of the server sends the queued pages one after another, and doesn't wait for the
+ * acknowledgement of a page before sending the next one, as long as no more than windowSize
+ * pages are not acknowledged. The node acknowledges the pages of a connection in the order that
+ * they are sent, so the acknowledgements are read in that order.
+ * The sink only waits when all send buffers are queued, i.e. when the node is slower than the
+ * sink, or when the senders of the job stage together take all memory of their shared
+ * ShuffleSendBufferPool, which bounds the memory of the pages that are not sent yet.
+ * With a windowSize of 0 or without a worker, send() sends the page and waits for its
+ * acknowledgement, as before.
+ * The pages are compressed with the codec that a StreamCodecSelector chooses for the stream, and
+ * the request of each page tells the node its codec.
+ */
+
+namespace pdb {
+
+class ShuffleSendBufferPool;
+typedef std::shared_ptr<ShuffleSendBufferPool> ShuffleSendBufferPoolPtr;
+
+/**
+ * This class holds the send buffers of all shuffle senders of a job stage, so that their memory
+ * is bounded by maxBytes however many senders there are. A buffer that is given back is kept for
+ * the next page, and freed when a larger one is needed and there is no room for both.
+ */
+class ShuffleSendBufferPool {
+
+public:
+    ShuffleSendBufferPool(size_t maxBytes);
+
+    ~ShuffleSendBufferPool();
+
+    // returns a buffer of at least size bytes and sets its capacity; waits while the buffers of
+    // the pool take maxBytes, but a buffer is always given when the pool has none out, so that a
+    // page larger than maxBytes is still sent
+    char* take(size_t size, size_t& capacity);
+
+    // gives back a buffer that take() returned
+    void give(char* bytes, size_t capacity);
+
+    // the most bytes that the buffers of the pool took at one time
+    size_t getPeakBytes();
+
+private:
+    size_t maxBytes;
+
+    // the bytes of all buffers of the pool, and of the buffers that are taken
+    size_t numBytes = 0;
+    size_t numBytesTaken = 0;
+    size_t peakBytes = 0;
+
+    // the buffers that are given back, with their capacities
+    std::vector<std::pair<char*, size_t>> freeBuffers;
+
+    pthread_mutex_t mutex;
+    pthread_cond_t bufferGiven;
+};
+
+class ShuffleSender;
+typedef std::shared_ptr<ShuffleSender> ShuffleSenderPtr;
+
+class ShuffleSender {
+
+public:
+    // inLoop is true to send the pages as one StorageAddObjectInLoop request, which stores each
+    // page as a page of the set, and false to send each page as a StorageAddData request of
+    // bytes, which stores the objects of each page to the set; codec is the spec of the codec of
+    // the pages, as StreamCodecSelector takes it; the send buffers are taken from pool, or from
+    // a pool of this sender alone, which only windowSize bounds, if pool is nullptr
+    ShuffleSender(PDBLoggerPtr logger,
+                  std::string address,
+                  int port,
+                  std::string databaseName,
+                  std::string setName,
+                  bool inLoop,
+                  int windowSize,
+                  std::string codec,
+                  ShuffleSendBufferPoolPtr pool = nullptr);
+
+    ~ShuffleSender();
+
+    // starts the worker that sends the queued pages, if windowSize is more than 0, so a worker
+    // is only to be taken for that; without a worker the pages are sent by send() itself
+    void start(PDBWorkerPtr ioWorker);
+
+    // compresses or copies the page to a send buffer and queues it; the page can be freed when
+    // this returns; returns false if an earlier page could not be sent
+    bool send(char* data, size_t size);
+
+    // sends the queued pages, ends the loop, and waits for all acknowledgements; returns false
+    // and sets errMsg if a page could not be sent or stored
+    bool finish(std::string& errMsg);
+
+    size_t getNumPagesSent();
+
+    // the number of bytes sent over the wire, and the number of bytes of the pages
+    size_t getNumBytesSent();
+
+    size_t getNumPageBytes();
+
+    // the time that send() waited for a free send buffer, in seconds
+    double getSecondsWaited();
+
+    // the codec that the pages are compressed with, once it is chosen
+    PageCompressionType getCodec();
+
+private:
+    // a buffer that holds a compressed page until it is sent
+    struct SendBuffer {
+        char* bytes = nullptr;
+        size_t capacity = 0;
+        size_t size = 0;
+
+        // the codec of the page, and its size before compression
+        PageCompressionType codec = NoPageCompression;
+        size_t uncompressedSize = 0;
+    };
+
+    // sends the queued pages until finish() is called
+    void run();
+
+    // connects to the node if we are not connected yet
+    bool connect(std::string& errMsg);
+
+    // sends the request of one page and its bytes
+    bool transmit(SendBuffer* page, std::string& errMsg);
+
+    // ends the loop of StorageAddObjectInLoop requests
+    bool transmitEnd(std::string& errMsg);
+
+    // reads the acknowledgement of the oldest page that is not acknowledged
+    bool readAck(std::string& errMsg);
+
+    // gives the bytes of a page that is sent back to the pool
+    void freeBuffer(SendBuffer* page);
+
+    // records the first error
+    void fail(std::string errMsg);
+
+    PDBLoggerPtr logger;
+    std::string address;
+    int port;
+    std::string databaseName;
+    std::string setName;
+    bool inLoop;
+    int windowSize;
+
+    // chooses the codec of the pages; it is only used by send()
+    StreamCodecSelector selector;
+
+    PDBCommunicatorPtr communicator = nullptr;
+
+    // the buffer that acknowledgements are read to
+    std::vector<char> ackBuffer;
+
+    // the pool that the send buffers are taken from
+    ShuffleSendBufferPoolPtr pool;
+
+    // the pages that are queued to be sent, and the number of send buffers that this sender has
+    // taken, which is at most windowSize
+    std::deque<SendBuffer*> queuedPages;
+    int numBuffers = 0;
+
+    // the number of pages that are sent and not acknowledged
+    int numUnacked = 0;
+
+    bool started = false;
+    bool finishing = false;
+    bool finished = false;
+    bool failed = false;
+    std::string firstErrMsg;
+
+    pthread_mutex_t queueMutex;
+    pthread_cond_t pageQueued;
+    pthread_cond_t bufferFreed;
+
+    // the buzzer that the worker buzzes when it has sent all pages
+    PDBBuzzerPtr doneBuzzer;
+    std::atomic_int doneCounter;
+
+    size_t numPagesSent = 0;
+    size_t numBytesSent = 0;
+    size_t numPageBytes = 0;
+    double secondsWaited = 0;
+};
+}
+
+#endif
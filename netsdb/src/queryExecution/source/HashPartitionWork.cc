@@ -17,11 +17,13 @@
 
 namespace pdb {
 
-HashPartitionWork :: HashPartitionWork(int id, PageCircularBufferIteratorPtr iter,  PipelineStage * stage, atomic_int& counter) 
+HashPartitionWork :: HashPartitionWork(int id, PageCircularBufferIteratorPtr iter,  PipelineStage * stage, 
+    ShuffleSenderPtr sender, atomic_int& counter) 
     : counter(counter) {
     this->id = id;
     this->iter = iter;
     this->stage = stage;
+    this->sender = sender;
     this->jobStage = stage->getJobStage();
     this->conf = stage->getConf();
     this->logger = std::make_shared<PDBLogger>("repartition"+std::to_string(id)+".log");
@@ -55,9 +57,6 @@ void HashPartitionWork :: execute(PDBBuzzerPtr callerBuzzer) {
     int port = this->jobStage->getPort(id);
     PDB_COUT << "port = " << port << std::endl;
 
-    PDBCommunicatorPtr communicator = std::make_shared<PDBCommunicator>();
-    communicator->connectToInternetServer(logger, port, address, errMsg);
-
     // get join computation
     PDB_COUT << id << ": to get compute plan" << std::endl;
     Handle<ComputePlan> plan = this->jobStage->getComputePlan();
@@ -137,13 +136,6 @@ void HashPartitionWork :: execute(PDBBuzzerPtr callerBuzzer) {
                                 std::cout << id << ": Alloc output buffer is full with size: " << numBytes << std::endl;
                                 logger->writeLn(": Alloc output buffer is full with size: ");
                                 logger->writeInt(numBytes);
-                                char* sendBuffer = (char*)malloc(numBytes);
-                                if (sendBuffer == nullptr) {
-                                    std::cout << "Out of memory on heap" << std::endl;
-                                    exit(-1);
-                                }
-                                memcpy(sendBuffer, output, numBytes);
-                                
                                 if (id != myNodeId) {
                                     //commented for debugging, needs to recover)
                                     std::cout << getAllocator().printCurrentBlock()
@@ -151,24 +143,19 @@ void HashPartitionWork :: execute(PDBBuzzerPtr callerBuzzer) {
                                     makeObjectAllocatorBlock(128 * 1024, true);
                                     std::cout << id << ": sendData to "<< jobStage->getSinkContext()->getDatabase()
                                           << ":" << jobStage->getSinkContext()->getSetName() << std::endl;
-                                    /*MD5_CTX md5;
-                                    MD5_Init(&md5);
-                                    MD5_Update(&md5, sendBuffer, numBytes);
-                                    unsigned char* output = nullptr;
-                                    MD5_Final(output, &md5);
-                                    std::cout << "Hash sent: " << output << std::endl;
-                                    logger->writeLn("Hash sent: "+string((char *)output));*/
-                                    stage->sendData(communicator,
-                                         sendBuffer,
-                                         numBytes,
-                                         jobStage->getSinkContext()->getDatabase(),
-                                         jobStage->getSinkContext()->getSetName(),
-                                         errMsg,
-                                         numPages);
-                                    std::cout << id << ": sent data to "<< jobStage->getSinkContext()->getDatabase()
+                                    // the sender copies the page to one of its send buffers, and
+                                    // sends it with another worker
+                                    sender->send(output, numBytes);
+                                    std::cout << id << ": queued data to "<< jobStage->getSinkContext()->getDatabase()
                                           << ":" << jobStage->getSinkContext()->getSetName() << std::endl;
-                                    logger->writeLn("sent data");    
+                                    logger->writeLn("queued data");    
                                 } else {
+                                    char* sendBuffer = (char*)malloc(numBytes);
+                                    if (sendBuffer == nullptr) {
+                                        std::cout << "Out of memory on heap" << std::endl;
+                                        exit(-1);
+                                    }
+                                    memcpy(sendBuffer, output, numBytes);
                                     makeObjectAllocatorBlock(128 * 1024, true);
                                     std::cout << id << ": pinBytes to " << jobStage->getSinkContext()->getDatabaseId() 
                                           << ":" << jobStage->getSinkContext()->getTypeId()
@@ -186,13 +173,13 @@ void HashPartitionWork :: execute(PDBBuzzerPtr callerBuzzer) {
                                     if (!ret) {
                                         std::cout << "Error: Failed to pin bytes" << std::endl;
                                     }
+                                    std::cout << id << ": to free the " << numPages << "-th sendBuffer" << std::endl;
+                                    free(sendBuffer);
+                                    std::cout << id << ": freed the " << numPages << "-th sendBuffer" << std::endl;
+                                    logger->writeLn(": freed the ");
+                                    logger->writeInt(numPages);
+                                    logger->writeLn( "-th sendBuffer");
                                  }//if (id != myNodeId) {
-                                 std::cout << id << ": to free the " << numPages << "-th sendBuffer" << std::endl;
-                                 free(sendBuffer);
-                                 std::cout << id << ": freed the " << numPages << "-th sendBuffer" << std::endl;
-                                 logger->writeLn(": freed the ");
-                                 logger->writeInt(numPages);
-                                 logger->writeLn( "-th sendBuffer");
                                  numPages++;
                                  // free the output page and reload a new output page
                                  char * buffer = (char*)calloc(conf->getNetBroadcastPageSize(), 1);
@@ -236,35 +223,18 @@ void HashPartitionWork :: execute(PDBBuzzerPtr callerBuzzer) {
         std::cout << id << ": Alloc output buffer not full with size: " << numBytes << std::endl;
         logger->writeLn(": Alloc output buffer not full with size: ");
         logger->writeInt(numBytes);
-        char* sendBuffer = (char*)malloc(numBytes);
-        if (sendBuffer == nullptr) {
-            std::cout << "Out of memory on heap" << std::endl;
-            exit(-1);
-        }
-        memcpy(sendBuffer, output, numBytes);
         if (id != myNodeId) {
-            //disable sending just for debugging, and we need to recover the below logic 
             makeObjectAllocatorBlock(128 * 1024, true);
             std::cout << id <<": sendData" << std::endl;
-
-           /* MD5_CTX md5;
-            MD5_Init(&md5);
-            MD5_Update(&md5, sendBuffer, numBytes);
-            unsigned char output[MD5_DIGEST_LENGTH];
-            MD5_Final(output, &md5);
-            std::cout << "Hash sent: " << output << std::endl;
-            logger->writeLn("Hash sent: "+string((char *)output));
-            */
-            stage->sendData(communicator,
-                sendBuffer,
-                numBytes,
-                jobStage->getSinkContext()->getDatabase(),
-                jobStage->getSinkContext()->getSetName(),
-                errMsg,
-                numPages);
-            
-            std::cout << id <<": sent data" << std::endl;
+            sender->send(output, numBytes);
+            std::cout << id <<": queued data" << std::endl;
         } else {
+            char* sendBuffer = (char*)malloc(numBytes);
+            if (sendBuffer == nullptr) {
+                std::cout << "Out of memory on heap" << std::endl;
+                exit(-1);
+            }
+            memcpy(sendBuffer, output, numBytes);
             makeObjectAllocatorBlock(128 * 1024, true);
             std::cout << id <<": pinBytes" << std::endl;
             bool ret = proxy->pinBytes(jobStage->getSinkContext()->getDatabaseId(),
@@ -278,13 +248,13 @@ void HashPartitionWork :: execute(PDBBuzzerPtr callerBuzzer) {
             if (!ret) {
                 std::cout << "Error: Failed to pin bytes" << std::endl;
             }
+            std::cout << id << ": to free the "<< numPages<<"-th send buffer" << std::endl;
+            free(sendBuffer);
+            std::cout << id << ": freed the "<< numPages<<"-th send buffer" << std::endl;
+            logger->writeLn(": freed the ");
+            logger->writeInt(numPages);
+            logger->writeLn("-th send buffer");
         }
-        std::cout << id << ": to free the "<< numPages<<"-th send buffer" << std::endl;
-        free(sendBuffer);
-        std::cout << id << ": freed the "<< numPages<<"-th send buffer" << std::endl;
-        logger->writeLn(": freed the ");
-        logger->writeInt(numPages);
-        logger->writeLn("-th send buffer");
         numPages++;
         myMaps = nullptr;
     }
@@ -305,13 +275,11 @@ void HashPartitionWork :: execute(PDBBuzzerPtr callerBuzzer) {
     logger->writeLn(" maps are written in total for partition-");
     logger->writeInt(id);
     if (id != myNodeId) {
+        // waits until all pages are sent and stored, and ends the loop
         makeObjectAllocatorBlock(128 * 1024, true);
-        stage->sendData(communicator,
-                 nullptr,
-                 conf->getNetBroadcastPageSize(),
-                 jobStage->getSinkContext()->getDatabase(),
-                 jobStage->getSinkContext()->getSetName(),
-                 errMsg);
+        if (!sender->finish(errMsg)) {
+            std::cout << id << ": Error: " << errMsg << std::endl;
+        }
     }
     callerBuzzer->buzz(PDBAlarm::WorkAllDone, counter);
     std::cout << "finished " << id << "-th HashPartition work on " << myNodeId << std::endl;
@@ -0,0 +1,185 @@
+#ifndef MORSEL_SCHEDULER_CC
+#define MORSEL_SCHEDULER_CC
+
+#include "MorselScheduler.h"
+#include <sstream>
+
+namespace pdb {
+
+MorselScheduler::MorselScheduler(int numWorkers,
+                                 unsigned int maxQueuedMorsels,
+                                 PDBLoggerPtr logger) {
+    this->numWorkers = numWorkers;
+    this->maxQueuedMorsels = (maxQueuedMorsels == 0) ? 1 : maxQueuedMorsels;
+    this->logger = logger;
+    this->numQueuedMorsels = 0;
+    for (int i = 0; i < numWorkers; i++) {
+        WorkerQueue* queue = new WorkerQueue();
+        pthread_mutex_init(&(queue->mutex), nullptr);
+        queues.push_back(queue);
+    }
+    pthread_mutex_init(&mutex, nullptr);
+    pthread_cond_init(&morselCond, nullptr);
+    pthread_cond_init(&spaceCond, nullptr);
+}
+
+MorselScheduler::~MorselScheduler() {
+    for (WorkerQueue* queue : queues) {
+        pthread_mutex_destroy(&(queue->mutex));
+        delete queue;
+    }
+    pthread_mutex_destroy(&mutex);
+    pthread_cond_destroy(&morselCond);
+    pthread_cond_destroy(&spaceCond);
+}
+
+void MorselScheduler::addMorsel(PDBPagePtr morsel) {
+    pthread_mutex_lock(&mutex);
+    while (numQueuedMorsels >= maxQueuedMorsels) {
+        pthread_cond_wait(&spaceCond, &mutex);
+    }
+    int worker = nextWorker;
+    nextWorker = (nextWorker + 1) % numWorkers;
+    WorkerQueue* queue = queues[worker];
+    pthread_mutex_lock(&(queue->mutex));
+    queue->morsels.push_back(morsel);
+    pthread_mutex_unlock(&(queue->mutex));
+    numQueuedMorsels++;
+    pthread_cond_signal(&morselCond);
+    pthread_mutex_unlock(&mutex);
+}
+
+void MorselScheduler::close() {
+    pthread_mutex_lock(&mutex);
+    closed = true;
+    pthread_cond_broadcast(&morselCond);
+    pthread_mutex_unlock(&mutex);
+}
+
+bool MorselScheduler::isDrained() {
+    pthread_mutex_lock(&mutex);
+    bool ret = closed && (numQueuedMorsels == 0);
+    pthread_mutex_unlock(&mutex);
+    return ret;
+}
+
+PDBPagePtr MorselScheduler::takeMorsel(int worker, bool& stolen) {
+    PDBPagePtr morsel = nullptr;
+    WorkerQueue* queue = queues[worker];
+    pthread_mutex_lock(&(queue->mutex));
+    if (!queue->morsels.empty()) {
+        morsel = queue->morsels.front();
+        queue->morsels.pop_front();
+    }
+    pthread_mutex_unlock(&(queue->mutex));
+    if (morsel != nullptr) {
+        stolen = false;
+        return morsel;
+    }
+    // steal from the tail, which the owner will take last
+    for (int i = 1; i < numWorkers; i++) {
+        WorkerQueue* victim = queues[(worker + i) % numWorkers];
+        pthread_mutex_lock(&(victim->mutex));
+        if (!victim->morsels.empty()) {
+            morsel = victim->morsels.back();
+            victim->morsels.pop_back();
+        }
+        pthread_mutex_unlock(&(victim->mutex));
+        if (morsel != nullptr) {
+            stolen = true;
+            return morsel;
+        }
+    }
+    return nullptr;
+}
+
+PDBPagePtr MorselScheduler::getMorsel(int worker) {
+    WorkerQueue* queue = queues[worker];
+    finishMorsel(worker);
+    auto begin = std::chrono::steady_clock::now();
+
+    PDBPagePtr morsel = nullptr;
+    bool stolen = false;
+    // the morsels are taken and counted under the same lock, so that while any morsel is
+    // counted, one of the queues has it, and we only wait when there is none
+    pthread_mutex_lock(&mutex);
+    while (true) {
+        morsel = takeMorsel(worker, stolen);
+        if (morsel != nullptr) {
+            numQueuedMorsels--;
+            pthread_cond_signal(&spaceCond);
+            break;
+        }
+        if (closed) {
+            break;
+        }
+        pthread_cond_wait(&morselCond, &mutex);
+    }
+    pthread_mutex_unlock(&mutex);
+
+    auto end = std::chrono::steady_clock::now();
+    queue->idleNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+    queue->lastTaken = end;
+    if (morsel != nullptr) {
+        queue->numMorsels++;
+        if (stolen) {
+            queue->numStolenMorsels++;
+        }
+        queue->running = true;
+    }
+    return morsel;
+}
+
+void MorselScheduler::finishMorsel(int worker) {
+    WorkerQueue* queue = queues[worker];
+    if (queue->running) {
+        queue->busyNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::steady_clock::now() - queue->lastTaken)
+                                .count();
+        queue->running = false;
+    }
+}
+
+PageCircularBufferIteratorPtr MorselScheduler::getIterator(int worker) {
+    return std::make_shared<MorselIterator>(worker, this, logger);
+}
+
+long MorselScheduler::getBusyNanos(int worker) {
+    return queues[worker]->busyNanos;
+}
+
+long MorselScheduler::getIdleNanos(int worker) {
+    return queues[worker]->idleNanos;
+}
+
+long MorselScheduler::getNumMorsels(int worker) {
+    return queues[worker]->numMorsels;
+}
+
+long MorselScheduler::getNumStolenMorsels(int worker) {
+    return queues[worker]->numStolenMorsels;
+}
+
+std::string MorselScheduler::printWorkerStats() {
+    std::stringstream out;
+    long maxBusyNanos = 0;
+    long totalBusyNanos = 0;
+    for (int i = 0; i < numWorkers; i++) {
+        WorkerQueue* queue = queues[i];
+        out << "worker-" << i << ": busy=" << queue->busyNanos / 1000000.0
+            << "ms, idle=" << queue->idleNanos / 1000000.0 << "ms, morsels=" << queue->numMorsels
+            << ", stolen=" << queue->numStolenMorsels << std::endl;
+        if (queue->busyNanos > maxBusyNanos) {
+            maxBusyNanos = queue->busyNanos;
+        }
+        totalBusyNanos += queue->busyNanos;
+    }
+    if (totalBusyNanos > 0) {
+        out << "busy skew (max/avg): " << (double)maxBusyNanos * numWorkers / totalBusyNanos
+            << std::endl;
+    }
+    return out.str();
+}
+}
+
+#endif
@@ -29,6 +29,7 @@
 #include "ShuffleSink.h"
 #include "HashPartitionWork.h"
 #include "PartitionComp.h"
+#include "MorselScheduler.h"
 #ifdef ENABLE_COMPRESSION
 #include <snappy.h>
 #endif
@@ -48,6 +49,7 @@ namespace pdb {
 PipelineStage::~PipelineStage() {
     this->jobStage = nullptr;
     this->nodeIds.clear();
+    pthread_mutex_destroy(&failureMutex);
 }
 
 PipelineStage::PipelineStage(Handle<TupleSetJobStage> stage,
@@ -65,10 +67,19 @@ PipelineStage::PipelineStage(Handle<TupleSetJobStage> stage,
     this->conf = conf;
     this->shm = shm;
     this->id = 0;
+    pthread_mutex_init(&failureMutex, nullptr);
+    this->sendBufferPool = std::make_shared<ShuffleSendBufferPool>(conf->getShuffleSendMemory());
     int numNodes = this->jobStage->getNumNodes();
     for (int i = 0; i < numNodes; i++) {
         nodeIds.push_back(i);
     }
+    Handle<Vector<unsigned int>> joinFilterWords = this->jobStage->getJoinFilter();
+    if ((joinFilterWords != nullptr) && (joinFilterWords->size() > 0)) {
+        this->joinFilter = std::make_shared<JoinBloomFilter>(joinFilterWords->c_ptr(),
+                                                             joinFilterWords->size());
+        std::cout << "PipelineStage: got a join filter of " << joinFilterWords->size() * 4
+                  << " bytes" << std::endl;
+    }
 }
 
 
@@ -156,53 +167,29 @@ bool PipelineStage::storeCompressedShuffleData(char* bytes,
         true);
 }
 
-// broadcast data
-bool PipelineStage::sendData(PDBCommunicatorPtr conn,
-                             char* data,
-                             size_t size,
-                             std::string databaseName,
-                             std::string setName,
-                             std::string& errMsg,
-                             int counter) {
-    bool success;
-    if (data != nullptr) {
-#ifdef DEBUG_SHUFFLING
-        // write the data to a test file
-        std::string fileName =
-            jobStage->getJobId() + "_" + std::to_string(jobStage->getStageId()) + "_shuffle-sent"+std::to_string(counter);
-        FILE* myFile = fopen(fileName.c_str(), "w");
-        fwrite(data, 1, size, myFile);
-        fclose(myFile);
-#endif
-
-        Handle<StorageAddObjectInLoop> request = makeObject<StorageAddObjectInLoop>(
-            databaseName, setName, "IntermediateData", false, false);
-        conn->sendObject(request, errMsg);
-#ifdef ENABLE_COMPRESSION
-        size_t maxSize = snappy::MaxCompressedLength(size);
-        char* compressedBytes = new char[maxSize];
-        if (compressedBytes == nullptr) {
-           std::cout << "PipelineStage.cc: failed to allocate memory with size=" << size << std::endl;
-           exit(1);
-        }
-        memset(compressedBytes, 0, maxSize);
-        size_t compressedSize = 0;
-        snappy::RawCompress((char*)data, size, compressedBytes, &compressedSize);
-        std::cout << "size before compression is " << size << " and size after compression is "
-                  << compressedSize << std::endl;
-        errMsg = "";
-        conn->sendBytes(compressedBytes, compressedSize, errMsg);
-        delete[] compressedBytes;
-#else
-        conn->sendBytes(data, size, errMsg);
-#endif
-    } else {
-        Handle<StorageAddObjectInLoop> request = makeObject<StorageAddObjectInLoop>();
-        request->setLoopEnded();
-        conn->sendObject(request, errMsg);
+// creates a sender of shuffle data to the i-th node, whose send buffers are taken from the pool
+// of this stage
+ShuffleSenderPtr PipelineStage::createShuffleSender(HermesExecutionServer* server,
+                                                    int i,
+                                                    bool inLoop) {
+    std::string address = this->jobStage->getIPAddress(i);
+    int port = this->jobStage->getPort(i);
+    if (port <= 0) {
+        port = conf->getPort();
     }
-    Handle<SimpleRequestResult> result = conn->getNextObject<SimpleRequestResult>(success, errMsg);
-    return true;
+    ShuffleSenderPtr sender = make_shared<ShuffleSender>(logger,
+                                                         address,
+                                                         port,
+                                                         jobStage->getSinkContext()->getDatabase(),
+                                                         jobStage->getSinkContext()->getSetName(),
+                                                         inLoop,
+                                                         conf->getShuffleSendWindow(),
+                                                         conf->getShuffleCodec(),
+                                                         sendBufferPool);
+    if (conf->getShuffleSendWindow() > 0) {
+        sender->start(server->getFunctionality<HermesExecutionServer>().getWorkers()->getWorker());
+    }
+    return sender;
 }
 
 // tuning the backend circular buffer size
@@ -228,7 +215,11 @@ size_t PipelineStage::getBackendCircularBufferSize(bool& success, std::string& e
 
 // to get iterators to scan a user set
 std::vector<PageCircularBufferIteratorPtr> PipelineStage::getUserSetIterators(
-    HermesExecutionServer* server, int numScanThreads, bool& success, std::string& errMsg) {
+    HermesExecutionServer* server,
+    int numScanThreads,
+    bool& success,
+    std::string& errMsg,
+    const ZoneMapPredicate* zoneMapPredicate) {
 
     // initialize the data proxy, scanner and set iterators
     PDBCommunicatorPtr communicatorToFrontend = make_shared<PDBCommunicator>();
@@ -259,13 +250,50 @@ std::vector<PageCircularBufferIteratorPtr> PipelineStage::getUserSetIterators(
     iterators = scanner->getSetIterators(nodeId,
                                          jobStage->getSourceContext()->getDatabaseId(),
                                          jobStage->getSourceContext()->getTypeId(),
-                                         jobStage->getSourceContext()->getSetId());
+                                         jobStage->getSourceContext()->getSetId(),
+                                         zoneMapPredicate);
     std::cout << "GetSetPages message is sent" << std::endl;
 
     // return iterators
     return iterators;
 }
 
+// to get the zone map predicate of a SelectionComp that directly consumes the scanned set, so
+// that the storage can skip pages that the selection would filter out entirely
+bool PipelineStage::getZoneMapPredicate(Handle<ComputePlan> plan,
+                                        std::vector<std::string>& buildTheseTupleSets,
+                                        ZoneMapPredicate& predicate) {
+    std::string sourceComputationName =
+        plan->getProducingComputationName(jobStage->getSourceTupleSetSpecifier());
+    for (auto& tupleSetName : buildTheseTupleSets) {
+        std::string computationName = plan->getProducingComputationName(tupleSetName);
+        if (computationName == sourceComputationName) {
+            continue;
+        }
+        // the first computation after the scan must be the selection
+        Handle<Computation> computation =
+            plan->getPlan()->getNode(computationName).getComputationHandle();
+        if (computation->getComputationType() != "SelectionComp") {
+            return false;
+        }
+        Handle<SelectionComp<Object, Object>> selection =
+            unsafeCast<SelectionComp<Object, Object>, Computation>(computation);
+        std::string attributeName;
+        ZoneMapComparisonOp op;
+        double value;
+        if (selection->getZoneMapPredicate(attributeName, op, value) == false) {
+            return false;
+        }
+        predicate.attributeName = attributeName;
+        predicate.op = op;
+        predicate.value = value;
+        std::cout << computationName << " skips pages by zone maps of " << attributeName
+                  << std::endl;
+        return true;
+    }
+    return false;
+}
+
 
 // to get iterators to scan a user set in a shared way so that each iterator gets all pages
 void PipelineStage::feedSharedBuffers(HermesExecutionServer* server,
@@ -330,7 +358,129 @@ DataProxyPtr PipelineStage::createProxy(int i,
     return proxy;
 }
 
+// to get the partitioned hash sets to probe, whose builds spilled pages
+std::vector<PartitionedHashSetPtr> PipelineStage::getSpilledHashSets(
+    HermesExecutionServer* server) {
+    std::vector<PartitionedHashSetPtr> spilledHashSets;
+    if ((this->jobStage->isProbing() == false) || (this->jobStage->getHashSets() == nullptr)) {
+        return spilledHashSets;
+    }
+    Handle<Map<String, String>> hashSetsToProbe = this->jobStage->getHashSets();
+    for (PDBMapIterator<String, String> mapIter = hashSetsToProbe->begin();
+         mapIter != hashSetsToProbe->end();
+         ++mapIter) {
+        std::string hashSetName = (*mapIter).value;
+        if (hashSetName.find(':') == 0) {
+            hashSetName = hashSetName.substr(1);
+        }
+        PartitionedHashSetPtr partitionedHashSet =
+            std::dynamic_pointer_cast<PartitionedHashSet>(server->getHashSet(hashSetName));
+        if ((partitionedHashSet != nullptr) && (partitionedHashSet->getNumSpilledPages() > 0)) {
+            spilledHashSets.push_back(partitionedHashSet);
+        }
+    }
+    return spilledHashSets;
+}
+
+// to pin the spilled pages of the hash sets to probe; if a page can't be pinned, the pages pinned
+// so far are unpinned, and the stage fails
+bool PipelineStage::pinSpilledHashSets(HermesExecutionServer* server,
+                                       pthread_mutex_t connection_mutex,
+                                       DataProxyPtr& proxy,
+                                       std::string& errMsg) {
+    proxy = nullptr;
+    std::vector<PartitionedHashSetPtr> spilledHashSets = getSpilledHashSets(server);
+    if (spilledHashSets.size() == 0) {
+        return true;
+    }
+    proxy = createProxy(-1, connection_mutex, errMsg);
+    std::vector<std::pair<SetID, PDBPagePtr>> pinnedPagesOfAllSets;
+    for (PartitionedHashSetPtr& hashSet : spilledHashSets) {
+        std::cout << "to pin " << hashSet->getNumSpilledPages() << " spilled pages of "
+                  << hashSet->getHashSetName() << std::endl;
+        for (unsigned int i = 0; i < hashSet->getNumPages(); i++) {
+            std::vector<PDBPagePtr> pinnedPages;
+            for (PDBPagePtr page : hashSet->getSpilledPages(i)) {
+                PDBPagePtr pinnedPage = nullptr;
+                if (proxy->pinTempPage(hashSet->getSpillSetId(), page->getPageID(), pinnedPage) ==
+                    false) {
+                    errMsg = "can't pin spilled page " + std::to_string(page->getPageID()) +
+                             " of " + hashSet->getHashSetName();
+                    std::cout << "ERROR: " << errMsg << std::endl;
+                    for (auto& pinned : pinnedPagesOfAllSets) {
+                        proxy->unpinTempPage(pinned.first, pinned.second);
+                    }
+                    proxy = nullptr;
+                    return false;
+                }
+                pinnedPages.push_back(pinnedPage);
+                pinnedPagesOfAllSets.push_back(
+                    std::make_pair(hashSet->getSpillSetId(), pinnedPage));
+            }
+            hashSet->setSpilledPages(i, pinnedPages);
+        }
+    }
+    return true;
+}
+
+// to unpin the spilled pages of the hash sets to probe
+void PipelineStage::unpinSpilledHashSets(HermesExecutionServer* server, DataProxyPtr proxy) {
+    if (proxy == nullptr) {
+        return;
+    }
+    for (PartitionedHashSetPtr& hashSet : getSpilledHashSets(server)) {
+        for (unsigned int i = 0; i < hashSet->getNumPages(); i++) {
+            for (PDBPagePtr page : hashSet->getSpilledPages(i)) {
+                proxy->unpinTempPage(hashSet->getSpillSetId(), page);
+            }
+        }
+    }
+}
+
 // to execute the pipeline work defined in a TupleSetJobStage
+// to record that a thread of this stage failed
+void PipelineStage::reportFailure(std::string errMsg) {
+    std::cout << "ERROR: " << errMsg << std::endl;
+    pthread_mutex_lock(&failureMutex);
+    if (failed == false) {
+        failed = true;
+        failureMsg = errMsg;
+    }
+    pthread_mutex_unlock(&failureMutex);
+}
+
+// to check whether a thread of this stage failed
+bool PipelineStage::hasFailed(std::string& errMsg) {
+    pthread_mutex_lock(&failureMutex);
+    bool ret = failed;
+    if (failed == true) {
+        errMsg = failureMsg;
+    }
+    pthread_mutex_unlock(&failureMutex);
+    return ret;
+}
+
+// to unpin the pages left in the iterator of a thread that stopped early; pages that the scanner
+// shares among threads are unpinned by the last thread that releases them
+void PipelineStage::drainIterator(PageCircularBufferIteratorPtr iterator, DataProxyPtr proxy) {
+    if ((iterator == nullptr) || (proxy == nullptr)) {
+        return;
+    }
+    while (iterator->hasNext()) {
+        PDBPagePtr page = iterator->next();
+        if (page == nullptr) {
+            continue;
+        }
+        if (page->getRefCount() > 0) {
+            page->decRefCount();
+        }
+        if (page->getRefCount() == 0) {
+            proxy->unpinUserPage(
+                nodeId, page->getDbID(), page->getTypeID(), page->getSetID(), page, false);
+        }
+    }
+}
+
 // iterators can be empty if hash input is used
 // combinerBuffers can be empty if no combining is required
 void PipelineStage::executePipelineWork(int i,
@@ -344,22 +494,10 @@ void PipelineStage::executePipelineWork(int i,
                                         std::string& errMsg) {
 
 #ifdef REUSE_CONNECTION_FOR_AGG_NO_COMBINER
-    // connections
-    std::vector<PDBCommunicatorPtr> connections;
+    // senders
+    std::vector<ShuffleSenderPtr> senders;
     for (int j = 0; j < jobStage->getNumNodes(); j++) {
-
-        // get the i-th address
-        std::string address = this->jobStage->getIPAddress(j);
-        PDB_COUT << "address = " << address << std::endl;
-
-        // get the i-th port
-        int port = this->jobStage->getPort(j);
-        PDB_COUT << "port = " << port << std::endl;
-
-        // get aggregate computation
-        PDBCommunicatorPtr communicator = std::make_shared<PDBCommunicator>();
-        communicator->connectToInternetServer(logger, port, address, errMsg);
-        connections.push_back(communicator);
+        senders.push_back(createShuffleSender(server, j, true));
     }
 #endif
 
@@ -458,8 +596,9 @@ void PipelineStage::executePipelineWork(int i,
             std::cout << i << ": PartitionComp's nodeId is set to be " << nodeId << std::endl;
 
         } else {
-            std::cout << "Error: we can't support source computation type "
-                      << computation->getComputationType() << std::endl;
+            reportFailure("we can't support source computation type " +
+                          computation->getComputationType());
+            drainIterator(iterators.at(i), proxy);
             return;
         }
 
@@ -525,14 +664,22 @@ void PipelineStage::executePipelineWork(int i,
             if (hashSet->getHashSetType() == "SharedHashSet") {
                 std::cout << "We are probing SharedHashSet" << std::endl;
                 SharedHashSetPtr sharedHashSet = std::dynamic_pointer_cast<SharedHashSet>(hashSet);
-                info[key] = std::make_shared<JoinArg>(*newPlan, sharedHashSet->getPage(), nullptr);
+                std::shared_ptr<JoinArg> joinArg =
+                    std::make_shared<JoinArg>(*newPlan, sharedHashSet->getPage(), nullptr);
+                joinArg->joinFilter = sharedHashSet->getJoinFilter();
+                info[key] = joinArg;
             } else if (hashSet->getHashSetType() == "PartitionedHashSet") {
                 std::cout << "We are probing PartitionedHashSet" << std::endl;
                 PartitionedHashSetPtr partitionedHashSet =
                         std::dynamic_pointer_cast<PartitionedHashSet>(hashSet);
                 if (!probePartitionedHashMap && !this->jobStage->isLocalJoinProbe()) {
                     std::cout << "info[key] = std::make_shared<JoinArg>(*newPlan, partitionedHashSet->getPage(i, true), nullptr);"<<std::endl;
-                    info[key] = std::make_shared<JoinArg>(*newPlan, partitionedHashSet->getPage(i, true), nullptr);
+                    std::shared_ptr<JoinArg> joinArg = std::make_shared<JoinArg>(*newPlan, partitionedHashSet->getPage(i, true), nullptr);
+                    for (PDBPagePtr page : partitionedHashSet->getSpilledPages(i)) {
+                        joinArg->spilledHashTables.push_back(page->getBytes());
+                    }
+                    joinArg->joinFilter = partitionedHashSet->getJoinFilter();
+                    info[key] = joinArg;
                 } else {
                     std::cout << "info[key] = std::make_shared<JoinArg>(*newPlan, nullptr, partitionedHashSet);" <<std::endl;
                     std::string joinComputationName =
@@ -544,8 +691,11 @@ void PipelineStage::executePipelineWork(int i,
                     join->setPartitionId(i);
                     join->setNumPartitions(this->jobStage->getNumTotalPartitions());
                     join->setNumNodes(this->jobStage->getNumNodes());
-                    info[key] = std::make_shared<JoinArg>(*newPlan, nullptr, partitionedHashSet);
-                    
+                    std::shared_ptr<JoinArg> joinArg =
+                        std::make_shared<JoinArg>(*newPlan, nullptr, partitionedHashSet);
+                    joinArg->joinFilter = partitionedHashSet->getJoinFilter();
+                    info[key] = joinArg;
+
                 }
             }
         }
@@ -592,6 +742,7 @@ void PipelineStage::executePipelineWork(int i,
         join = unsafeCast<JoinComp<Object, Object, Object>, Computation>(joinComputation);
         join->setNumPartitions(this->jobStage->getNumTotalPartitions());
         join->setNumNodes(this->jobStage->getNumNodes());
+        join->setJoinFilter(this->joinFilter);
         std::cout << i << ": Join set to have " << join->getNumPartitions() << " partitions" << std::endl;
         std::cout << i << ": Join set to have " << join->getNumNodes() << " nodes" << std::endl;
     } else if (targetSpecifier.find("PartitionComp") != std::string::npos) {
@@ -850,12 +1001,7 @@ void PipelineStage::executePipelineWork(int i,
                                   << std::endl;
                         if (objectToShuffle != nullptr) {
                             // to shuffle data
-                            sendData(connections[k],
-                                     myRecord,
-                                     myRecord->numBytes(),
-                                     jobStage->getSinkContext()->getDatabase(),
-                                     jobStage->getSinkContext()->getSetName(),
-                                     errMsg);
+                            senders[k]->send((char*)myRecord, myRecord->numBytes());
                         }
 #else
                         if (objectToShuffle != nullptr) {
@@ -913,19 +1059,20 @@ void PipelineStage::executePipelineWork(int i,
               << " secs." << std::endl;
     std::cout << i<<": Running Pipeline\n";
     curPipeline->id = i;
-    curPipeline->run();
+    if (curPipeline->run() == false) {
+        reportFailure(std::to_string(i) + "-th pipeline of " + sourceSpecifier +
+                      " stopped before its source was processed");
+        if (i < (int)iterators.size()) {
+            drainIterator(iterators.at(i), proxy);
+        }
+    }
     curPipeline = nullptr;
     newPlan->nullifyPlanPointer();
     getAllocator().setPolicy(AllocatorPolicy::defaultAllocator);
 #ifdef REUSE_CONNECTION_FOR_AGG_NO_COMBINER
     makeObjectAllocatorBlock(4 * 1024 * 1024, true);
     for (int j = 0; j < jobStage->getNumNodes(); j++) {
-        sendData(connections[j],
-                 nullptr,
-                 DEFAULT_NET_PAGE_SIZE,
-                 jobStage->getSinkContext()->getDatabase(),
-                 jobStage->getSinkContext()->getSetName(),
-                 errMsg);
+        senders[j]->finish(errMsg);
     }
     if (mem != nullptr) {
         free(mem);
@@ -967,6 +1114,8 @@ void PipelineStage::runPipeline(HermesExecutionServer* server,
     std::vector<PageCircularBufferPtr> sourceBuffers;
     // get user set iterators
     std::vector<PageCircularBufferIteratorPtr> iterators;
+    PageCircularBufferIteratorPtr scanIterator = nullptr;
+    MorselSchedulerPtr morselScheduler = nullptr;
     PartitionedHashSetPtr hashSet = nullptr;
     Handle<SetIdentifier> sourceContext = this->jobStage->getSourceContext();
 
@@ -997,6 +1146,19 @@ void PipelineStage::runPipeline(HermesExecutionServer* server,
         computation = newPlan->getPlan()->getNode(producerComputationName).getComputationHandle();
     }
 
+    // initialize mutextes
+    pthread_mutex_t connection_mutex;
+    pthread_mutex_init(&connection_mutex, nullptr);
+
+    // pin the pages that the builds of the hash sets to probe spilled, until all workers are done;
+    // this is done before the source is scanned, so that a failure leaves no scan behind
+    DataProxyPtr spillProxy = nullptr;
+    if (pinSpilledHashSets(server, connection_mutex, spillProxy, errMsg) == false) {
+        reportFailure(errMsg);
+        pthread_mutex_destroy(&connection_mutex);
+        return;
+    }
+
     if (((this->jobStage->isLocalJoinSink()) 
        && (computation->getComputationType() == "ScanUserSet")) 
        || ((sourceContext->getSetType() == UserSetType) 
@@ -1020,7 +1182,30 @@ void PipelineStage::runPipeline(HermesExecutionServer* server,
     } else if ((sourceContext->getSetType() == UserSetType) &&
         (computation->getComputationType() != "JoinComp")) {
         std::cout << "to prepare for vectorized source" << std::endl;
-        iterators = getUserSetIterators(server, numThreads, success, errMsg);
+        // with morsel scheduling, this thread is the only one to take pages from the scan buffer,
+        // and deals them to the workers
+        int numScanIterators = numThreads;
+        if (conf->getUseMorselScheduling() == true) {
+            numScanIterators = 1;
+        }
+        ZoneMapPredicate zoneMapPredicate;
+        if (getZoneMapPredicate(newPlan, buildTheseTupleSets, zoneMapPredicate) == true) {
+            iterators =
+                getUserSetIterators(server, numScanIterators, success, errMsg, &zoneMapPredicate);
+        } else {
+            iterators = getUserSetIterators(server, numScanIterators, success, errMsg);
+        }
+        if ((conf->getUseMorselScheduling() == true) && (iterators.size() > 0)) {
+            std::cout << "to schedule pages as morsels to " << numThreads << " workers"
+                      << std::endl;
+            scanIterator = iterators[0];
+            morselScheduler = make_shared<MorselScheduler>(
+                numThreads, getBackendCircularBufferSize(success, errMsg), logger);
+            iterators.clear();
+            for (int i = 0; i < numThreads; i++) {
+                iterators.push_back(morselScheduler->getIterator(i));
+            }
+        }
     } else {
         std::cout << "to prepare for hash source" << std::endl;
         std::string hashSetName = sourceContext->getDatabase() + ":" + sourceContext->getSetName();
@@ -1060,9 +1245,6 @@ void PipelineStage::runPipeline(HermesExecutionServer* server,
 
 
 
-    // initialize mutextes
-    pthread_mutex_t connection_mutex;
-    pthread_mutex_init(&connection_mutex, nullptr);
     
     atomic_int pipelineCounter;
     pipelineCounter = 0;
@@ -1191,16 +1373,40 @@ void PipelineStage::runPipeline(HermesExecutionServer* server,
 
     } else {
 
+        if (morselScheduler != nullptr) {
+            // deal the scanned pages to the workers, and close the scheduler when all are dealt
+            std::cout << "start dealing scanned pages to workers as morsels" << std::endl;
+            while (scanIterator->hasNext()) {
+                PDBPagePtr page = scanIterator->next();
+                if (page != nullptr) {
+                    morselScheduler->addMorsel(page);
+                }
+            }
+            morselScheduler->close();
+            std::cout << "Scanned all pages, now we wait for the workers to drain the morsels"
+                      << std::endl;
+        }
+
         while (pipelineCounter < numSourceThreads) {
             sched_yield();
             tempBuzzer->wait();
         }
 
+        if (morselScheduler != nullptr) {
+            std::string stats = morselScheduler->printWorkerStats();
+            std::cout << "morsel workers of " << jobStage->getSourceTupleSetSpecifier() << "-"
+                      << jobStage->getTargetComputationSpecifier() << ":" << std::endl
+                      << stats;
+            logger->info(stats);
+            morselScheduler = nullptr;
+        }
+
     }
 
     std::cout << "pipelineCounter = " << pipelineCounter << ": we will finish soon with runPipeline()" << std::endl;
     pipelineCounter = 0;
 
+    unpinSpilledHashSets(server, spillProxy);
     pthread_mutex_destroy(&connection_mutex);
 
 
@@ -1330,6 +1536,11 @@ void PipelineStage::runPipelineWithShuffleSink(HermesExecutionServer* server) {
                 port = this->jobStage->getPort(i % numNodesToCollect);
                 PDB_COUT << "port = " << port << std::endl;
             }
+#ifdef ENABLE_COMPRESSION
+            // the combined pages are compressed here and sent by another worker
+            ShuffleSenderPtr sender = createShuffleSender(
+                server, this->jobStage->isCollectAsMap() ? i % numNodesToCollect : i, false);
+#endif
             // get aggregate computation
 	    std::cout << i << ": to get compute plan" << std::endl;
 #ifdef ENABLE_LARGE_GRAPH
@@ -1394,28 +1605,7 @@ void PipelineStage::runPipelineWithShuffleSink(HermesExecutionServer* server) {
                                                port,
                                                errMsg);
 #else
-                        char* compressedBytes =
-                            new char[snappy::MaxCompressedLength(record->numBytes())];
-                        if (compressedBytes == nullptr) {
-                            std::cout << "PipelineStage.cc: failed to allocate memory" << std::endl;
-                            exit(1);
-                        }
-                        size_t compressedSize;
-                        snappy::RawCompress(
-                            (char*)record, record->numBytes(), compressedBytes, &compressedSize);
-                        std::cout << "size before compression is " << record->numBytes()
-                                  << " and size after compression is " << compressedSize
-                                  << std::endl;
-                        this->storeCompressedShuffleData(
-                            compressedBytes,
-                            compressedSize,
-                            this->jobStage->getSinkContext()->getDatabase(),
-                            this->jobStage->getSinkContext()->getSetName(),
-                            address,
-                            port,
-                            errMsg);
-                        delete[] compressedBytes;
-
+                        sender->send((char*)record, record->numBytes());
 #endif
 
 
@@ -1457,25 +1647,8 @@ void PipelineStage::runPipelineWithShuffleSink(HermesExecutionServer* server) {
                                    port,
                                    errMsg);
 #else
-            char* compressedBytes = new char[snappy::MaxCompressedLength(record->numBytes())];
-            if (compressedBytes == nullptr) {
-                std::cout << "PipelineStage.cc: failed to allocate memory" << std::endl;
-                exit(1);
-            }
-            size_t compressedSize;
-            snappy::RawCompress(
-                (char*)record, record->numBytes(), compressedBytes, &compressedSize);
-            std::cout << "size before compression is " << record->numBytes()
-                      << " and size after compression is " << compressedSize << std::endl;
-            this->storeCompressedShuffleData(compressedBytes,
-                                             compressedSize,
-                                             this->jobStage->getSinkContext()->getDatabase(),
-                                             this->jobStage->getSinkContext()->getSetName(),
-                                             address,
-                                             port,
-                                             errMsg);
-            delete[] compressedBytes;
-
+            sender->send((char*)record, record->numBytes());
+            sender->finish(errMsg);
 #endif
 
             // free the output page
@@ -1581,10 +1754,9 @@ void PipelineStage::runPipelineWithBroadcastSink(HermesExecutionServer* server)
             int port = this->jobStage->getPort(i);
 
             PDB_COUT << "port = " << port << std::endl;
-            // get aggregate computation
 
-            PDBCommunicatorPtr communicator = std::make_shared<PDBCommunicator>();
-            communicator->connectToInternetServer(logger, port, address, errMsg);
+            // the pages are sent by another worker, so that this one can go on with the next page
+            ShuffleSenderPtr sender = createShuffleSender(server, i, true);
 
             PageCircularBufferIteratorPtr myIter = shuffleIters[i];
             int numPages = 0;
@@ -1595,12 +1767,7 @@ void PipelineStage::runPipelineWithBroadcastSink(HermesExecutionServer* server)
                     numPages++;
                     // send out the page
                     Record<Object>* myRecord = (Record<Object>*)(page->getBytes());
-                    sendData(communicator,
-                             (char*)myRecord,
-                             myRecord->numBytes(),
-                             jobStage->getSinkContext()->getDatabase(),
-                             jobStage->getSinkContext()->getSetName(),
-                             errMsg);
+                    sender->send((char*)myRecord, myRecord->numBytes());
                     // unpin the input page
                     page->decRefCount();
                     if (page->getRefCount() == 0) {
@@ -1608,14 +1775,9 @@ void PipelineStage::runPipelineWithBroadcastSink(HermesExecutionServer* server)
                     }
                 }
             }
+            sender->finish(errMsg);
             std::cout << "broadcasted " << numPages << " pages to address: " << address
                       << std::endl;
-            sendData(communicator,
-                     nullptr,
-                     DEFAULT_NET_PAGE_SIZE,
-                     jobStage->getSinkContext()->getDatabase(),
-                     jobStage->getSinkContext()->getSetName(),
-                     errMsg);
 #ifdef PROFILING
             out = getAllocator().printInactiveBlocks();
             std::cout << "inactive blocks after sending data in this worker:" << std::endl;
@@ -1690,7 +1852,8 @@ void PipelineStage::runPipelineWithHashPartitionSink(HermesExecutionServer* serv
                     server->getFunctionality<HermesExecutionServer>().getWorkers()->getWorker();
                 std::cout << "to run the " << j << "-th hash partitioning work for local" << std::endl;
                 // start thread
-                PDBWorkPtr myWork = make_shared<HashPartitionWork>(i, iter, this, shuffleCounter);
+                PDBWorkPtr myWork =
+                    make_shared<HashPartitionWork>(i, iter, this, nullptr, shuffleCounter);
                 worker->execute(myWork, shuffleBuzzer);
             }
 
@@ -1699,7 +1862,8 @@ void PipelineStage::runPipelineWithHashPartitionSink(HermesExecutionServer* serv
                 server->getFunctionality<HermesExecutionServer>().getWorkers()->getWorker();
             std::cout << "to run the " << i << "-th hash partitioning work..." << std::endl;
             // start thread
-            PDBWorkPtr myWork = make_shared<HashPartitionWork>(i, iter, this, shuffleCounter); 
+            PDBWorkPtr myWork = make_shared<HashPartitionWork>(
+                i, iter, this, createShuffleSender(server, i, true), shuffleCounter);
             worker->execute(myWork, shuffleBuzzer);
         }
 
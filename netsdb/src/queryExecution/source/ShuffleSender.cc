@@ -0,0 +1,380 @@
+#ifndef SHUFFLE_SENDER_CC
+#define SHUFFLE_SENDER_CC
+
+#include "ShuffleSender.h"
+#include "PageCompressor.h"
+#include "InterfaceFunctions.h"
+#include "SimpleRequestResult.h"
+#include "StorageAddData.h"
+#include "StorageAddObjectInLoop.h"
+#include "UseTemporaryAllocationBlock.h"
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <iostream>
+
+namespace pdb {
+
+ShuffleSendBufferPool::ShuffleSendBufferPool(size_t maxBytes) {
+    this->maxBytes = maxBytes;
+    pthread_mutex_init(&mutex, nullptr);
+    pthread_cond_init(&bufferGiven, nullptr);
+}
+
+ShuffleSendBufferPool::~ShuffleSendBufferPool() {
+    for (auto& buffer : freeBuffers) {
+        free(buffer.first);
+    }
+    pthread_cond_destroy(&bufferGiven);
+    pthread_mutex_destroy(&mutex);
+}
+
+char* ShuffleSendBufferPool::take(size_t size, size_t& capacity) {
+    pthread_mutex_lock(&mutex);
+    while (true) {
+        for (size_t i = 0; i < freeBuffers.size(); i++) {
+            if (freeBuffers[i].second >= size) {
+                char* bytes = freeBuffers[i].first;
+                capacity = freeBuffers[i].second;
+                freeBuffers[i] = freeBuffers.back();
+                freeBuffers.pop_back();
+                numBytesTaken += capacity;
+                pthread_mutex_unlock(&mutex);
+                return bytes;
+            }
+        }
+        if (numBytes + size <= maxBytes) {
+            break;
+        }
+        if (!freeBuffers.empty()) {
+            // the free buffers are too small for this page, so one makes room for a larger one
+            free(freeBuffers.back().first);
+            numBytes -= freeBuffers.back().second;
+            freeBuffers.pop_back();
+        } else if (numBytesTaken == 0) {
+            break;
+        } else {
+            pthread_cond_wait(&bufferGiven, &mutex);
+        }
+    }
+    numBytes += size;
+    numBytesTaken += size;
+    if (numBytes > peakBytes) {
+        peakBytes = numBytes;
+    }
+    pthread_mutex_unlock(&mutex);
+    char* bytes = (char*)malloc(size);
+    if (bytes == nullptr) {
+        std::cout << "ShuffleSender.cc: failed to allocate memory with size=" << size << std::endl;
+        exit(1);
+    }
+    capacity = size;
+    return bytes;
+}
+
+void ShuffleSendBufferPool::give(char* bytes, size_t capacity) {
+    pthread_mutex_lock(&mutex);
+    freeBuffers.push_back(std::make_pair(bytes, capacity));
+    numBytesTaken -= capacity;
+    pthread_cond_broadcast(&bufferGiven);
+    pthread_mutex_unlock(&mutex);
+}
+
+size_t ShuffleSendBufferPool::getPeakBytes() {
+    pthread_mutex_lock(&mutex);
+    size_t ret = peakBytes;
+    pthread_mutex_unlock(&mutex);
+    return ret;
+}
+
+ShuffleSender::ShuffleSender(PDBLoggerPtr logger,
+                             std::string address,
+                             int port,
+                             std::string databaseName,
+                             std::string setName,
+                             bool inLoop,
+                             int windowSize,
+                             std::string codec,
+                             ShuffleSendBufferPoolPtr pool)
+    : selector(codec) {
+    this->logger = logger;
+    this->address = address;
+    this->port = port;
+    this->databaseName = databaseName;
+    this->setName = setName;
+    this->inLoop = inLoop;
+    this->windowSize = windowSize;
+    this->pool = pool;
+    if (this->pool == nullptr) {
+        this->pool = std::make_shared<ShuffleSendBufferPool>((size_t)(-1));
+    }
+    this->doneCounter = 0;
+    pthread_mutex_init(&queueMutex, nullptr);
+    pthread_cond_init(&pageQueued, nullptr);
+    pthread_cond_init(&bufferFreed, nullptr);
+}
+
+ShuffleSender::~ShuffleSender() {
+    std::string errMsg;
+    finish(errMsg);
+    pthread_cond_destroy(&bufferFreed);
+    pthread_cond_destroy(&pageQueued);
+    pthread_mutex_destroy(&queueMutex);
+}
+
+void ShuffleSender::start(PDBWorkerPtr ioWorker) {
+    if ((ioWorker == nullptr) || (windowSize <= 0)) {
+        return;
+    }
+    started = true;
+    doneBuzzer = make_shared<PDBBuzzer>([](PDBAlarm myAlarm, atomic_int& counter) { counter++; });
+    PDBWorkPtr myWork = make_shared<GenericWork>([this](PDBBuzzerPtr callerBuzzer) {
+        run();
+        callerBuzzer->buzz(PDBAlarm::WorkAllDone, doneCounter);
+    });
+    ioWorker->execute(myWork, doneBuzzer);
+}
+
+bool ShuffleSender::send(char* data, size_t size) {
+
+    // get a send buffer, or wait for one if all of them are queued, or if the senders of the
+    // pool take all its memory
+    auto begin = std::chrono::high_resolution_clock::now();
+    pthread_mutex_lock(&queueMutex);
+    while ((numBuffers >= windowSize) && (numBuffers > 0) && !failed) {
+        pthread_cond_wait(&bufferFreed, &queueMutex);
+    }
+    if (failed) {
+        pthread_mutex_unlock(&queueMutex);
+        return false;
+    }
+    numBuffers++;
+    pthread_mutex_unlock(&queueMutex);
+    SendBuffer* page = new SendBuffer();
+    page->bytes = pool->take(selector.getMaxCompressedLength(size), page->capacity);
+    auto end = std::chrono::high_resolution_clock::now();
+    secondsWaited += std::chrono::duration_cast<std::chrono::duration<double>>(end - begin).count();
+
+    page->codec = selector.compress(data, size, page->bytes, page->size);
+    page->uncompressedSize = size;
+    numPageBytes += size;
+
+    if (!started) {
+        // send the page and wait for its acknowledgement; the request is not made on the page
+        // that the caller may be writing to
+        const UseTemporaryAllocationBlock tempBlock{64 * 1024};
+        std::string errMsg;
+        if (!connect(errMsg) || !transmit(page, errMsg) || !readAck(errMsg)) {
+            fail(errMsg);
+        }
+        freeBuffer(page);
+        pthread_mutex_lock(&queueMutex);
+        bool ret = !failed;
+        pthread_mutex_unlock(&queueMutex);
+        return ret;
+    }
+
+    pthread_mutex_lock(&queueMutex);
+    queuedPages.push_back(page);
+    pthread_cond_signal(&pageQueued);
+    pthread_mutex_unlock(&queueMutex);
+    return true;
+}
+
+bool ShuffleSender::finish(std::string& errMsg) {
+    if (finished) {
+        errMsg = firstErrMsg;
+        return !failed;
+    }
+    finished = true;
+    if (started) {
+        pthread_mutex_lock(&queueMutex);
+        finishing = true;
+        pthread_cond_signal(&pageQueued);
+        pthread_mutex_unlock(&queueMutex);
+        while (doneCounter < 1) {
+            doneBuzzer->wait();
+        }
+    } else if (!failed && (inLoop || communicator != nullptr)) {
+        // a loop is ended even if no page was sent, as the node waits for the end
+        const UseTemporaryAllocationBlock tempBlock{64 * 1024};
+        std::string myErrMsg;
+        if (!connect(myErrMsg) || !transmitEnd(myErrMsg)) {
+            fail(myErrMsg);
+        }
+        while (!failed && (numUnacked > 0)) {
+            if (!readAck(myErrMsg)) {
+                fail(myErrMsg);
+            }
+        }
+    }
+    std::cout << "sent " << numPagesSent << " pages with " << numBytesSent << " bytes ("
+              << numPageBytes << " bytes before compression with "
+              << PageCompressor::getName(selector.getCodec()) << ") to " << address << ":" << port
+              << ", waited " << secondsWaited << " seconds for send buffers" << std::endl;
+    errMsg = firstErrMsg;
+    return !failed;
+}
+
+void ShuffleSender::run() {
+    const UseTemporaryAllocationBlock tempBlock{1024 * 1024};
+    std::string errMsg;
+    if (!connect(errMsg)) {
+        fail(errMsg);
+    }
+    while (true) {
+        pthread_mutex_lock(&queueMutex);
+        while (queuedPages.empty() && !finishing) {
+            pthread_cond_wait(&pageQueued, &queueMutex);
+        }
+        if (queuedPages.empty()) {
+            pthread_mutex_unlock(&queueMutex);
+            break;
+        }
+        SendBuffer* page = queuedPages.front();
+        queuedPages.pop_front();
+        bool isFailed = failed;
+        pthread_mutex_unlock(&queueMutex);
+
+        // the pages after an error are dropped, so that the sink doesn't wait for them
+        if (!isFailed) {
+            bool success = true;
+            while (success && (numUnacked >= windowSize)) {
+                success = readAck(errMsg);
+            }
+            if (!success || !transmit(page, errMsg)) {
+                fail(errMsg);
+            }
+        }
+
+        // the bytes are written to the socket, so the buffer can take the next page
+        freeBuffer(page);
+    }
+    if (!failed && !transmitEnd(errMsg)) {
+        fail(errMsg);
+    }
+    while (!failed && (numUnacked > 0)) {
+        if (!readAck(errMsg)) {
+            fail(errMsg);
+        }
+    }
+}
+
+bool ShuffleSender::connect(std::string& errMsg) {
+    if (communicator != nullptr) {
+        return true;
+    }
+    communicator = std::make_shared<PDBCommunicator>();
+    if (communicator->connectToInternetServer(logger, port, address, errMsg)) {
+        errMsg = "ShuffleSender: can't connect to " + address + ":" + std::to_string(port) +
+            ": " + errMsg;
+        return false;
+    }
+    // a page is written as a request and its bytes, which are not to wait for each other
+    communicator->setLongConnection(true);
+    return true;
+}
+
+bool ShuffleSender::transmit(SendBuffer* page, std::string& errMsg) {
+    bool success;
+    if (inLoop) {
+        Handle<StorageAddObjectInLoop> request = makeObject<StorageAddObjectInLoop>(
+            databaseName, setName, "IntermediateData", false, false);
+        request->setCompression(page->codec, page->uncompressedSize);
+        success = communicator->sendObject(request, errMsg);
+    } else {
+        // the bytes are sent as bytes even if they are not compressed
+        Handle<StorageAddData> request = makeObject<StorageAddData>(
+            databaseName, setName, "IntermediateData", false, false, true);
+        request->setCompression(page->codec, page->uncompressedSize);
+        success = communicator->sendObject(request, errMsg);
+    }
+    if (!success || !communicator->sendBytes(page->bytes, page->size, errMsg)) {
+        return false;
+    }
+    numUnacked++;
+    numPagesSent++;
+    numBytesSent += page->size;
+    return true;
+}
+
+bool ShuffleSender::transmitEnd(std::string& errMsg) {
+    if (!inLoop) {
+        return true;
+    }
+    Handle<StorageAddObjectInLoop> request = makeObject<StorageAddObjectInLoop>();
+    request->setLoopEnded();
+    if (!communicator->sendObject(request, errMsg)) {
+        return false;
+    }
+    // the node acknowledges the end of the loop, too
+    numUnacked++;
+    return true;
+}
+
+bool ShuffleSender::readAck(std::string& errMsg) {
+    size_t objectSize = communicator->getSizeOfNextObject();
+    if (objectSize == 0) {
+        errMsg = "ShuffleSender: the connection to " + address + " is closed";
+        return false;
+    }
+    if (ackBuffer.size() < objectSize) {
+        ackBuffer.resize(objectSize);
+    }
+    numUnacked--;
+    bool success;
+    Handle<SimpleRequestResult> result =
+        communicator->getNextObject<SimpleRequestResult>(ackBuffer.data(), success, errMsg);
+    if (!success) {
+        return false;
+    }
+    if (!result->getRes().first) {
+        errMsg = "ShuffleSender: " + address + " failed to store a page: " + result->getRes().second;
+        return false;
+    }
+    return true;
+}
+
+void ShuffleSender::freeBuffer(SendBuffer* page) {
+    pool->give(page->bytes, page->capacity);
+    delete page;
+    pthread_mutex_lock(&queueMutex);
+    numBuffers--;
+    pthread_cond_signal(&bufferFreed);
+    pthread_mutex_unlock(&queueMutex);
+}
+
+void ShuffleSender::fail(std::string errMsg) {
+    logger->error(errMsg);
+    std::cout << errMsg << std::endl;
+    pthread_mutex_lock(&queueMutex);
+    if (!failed) {
+        failed = true;
+        firstErrMsg = errMsg;
+    }
+    pthread_cond_broadcast(&bufferFreed);
+    pthread_mutex_unlock(&queueMutex);
+}
+
+size_t ShuffleSender::getNumPagesSent() {
+    return numPagesSent;
+}
+
+size_t ShuffleSender::getNumBytesSent() {
+    return numBytesSent;
+}
+
+size_t ShuffleSender::getNumPageBytes() {
+    return numPageBytes;
+}
+
+double ShuffleSender::getSecondsWaited() {
+    return secondsWaited;
+}
+
+PageCompressionType ShuffleSender::getCodec() {
+    return selector.getCodec();
+}
+}
+
+#endif
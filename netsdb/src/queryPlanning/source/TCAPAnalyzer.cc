@@ -1112,6 +1112,13 @@ bool TCAPAnalyzer::analyze(
                   std::cout << "JoinType = UnknownJoin" << std::endl;
               }
 
+              // the tuples that have no match in the hash set built from the other side are
+              // dropped before they are repartitioned, if its build made a Bloom filter
+              if ((join->getJoinType() == HashPartitionedJoin) && (hashSetsToProbe != nullptr) &&
+                  (hashSetsToProbe->count(outputName) > 0)) {
+                  joinPrepStage->setJoinFilterHashSetName((*hashSetsToProbe)[outputName]);
+              }
+
               joinPrepStage->setJoinTupleSourceOrNot(true);
               physicalPlanToOutput.push_back(joinPrepStage);
               interGlobalSets.push_back(sink);
@@ -40,7 +40,8 @@ public:
                    size_t desiredSize = 0,
                    bool isMRU = false,
 		   bool isSharedTensorBlockSet = false,
-		   bool isModelSet = false);
+		   bool isModelSet = false,
+                   PageCompressionType compressionType = NoPageCompression);
 
 
     bool createSet(const std::string& databaseName,
@@ -87,7 +88,8 @@ public:
                    size_t desiredSize = 0,
                    bool isMRU = false,
 		   bool isSharedTensorBlockSet = false,
-		   bool isModelSet = false);
+		   bool isModelSet = false,
+                   PageCompressionType compressionType = NoPageCompression);
 
 
     // templated createSet
@@ -160,6 +162,17 @@ public:
                   const std::string& typeName,
                   std::string& errMsg);
 
+    // declare an attribute of a set to summarize in per-page zone maps on all nodes; the
+    // attribute is stored inline at byteOffset bytes from the start of each object, and if
+    // columnar is true, it is also stored in the PAX columns of pages loaded to the set
+    bool addZoneMapAttribute(const std::string& databaseName,
+                             const std::string& setName,
+                             const std::string& attributeName,
+                             size_t byteOffset,
+                             ZoneMapAttributeType attributeType,
+                             std::string& errMsg,
+                             bool columnar = false);
+
     // remove a temp set that only goes through storage
     bool removeTempSet(const std::string& databaseName,
                        const std::string& setName,
@@ -29,7 +29,8 @@ namespace pdb {
                                                     size_t desiredSize,
                                                     bool isMRU,
 						    bool isSharedTensorBlockSet,
-						    bool isModelSet) {
+						    bool isModelSet,
+                                                    PageCompressionType compressionType) {
         std::string typeName = getTypeName<DataType>();
         int16_t typeId = getTypeID<DataType>();
         PDB_COUT << "typeName for set to create =" << typeName << ", typeId=" << typeId << std::endl;
@@ -50,7 +51,8 @@ namespace pdb {
             desiredSize,
             isMRU,
 	    isSharedTensorBlockSet,
-	    isModelSet);
+	    isModelSet,
+            compressionType);
     }
 
     template <class DataType>
@@ -182,7 +182,8 @@ public:
                 size_t desiredSize = 1,
                 bool isMRU = true,
                 bool isTransient = true,
-		bool isSharedTensorBlockSet = false);
+		bool isSharedTensorBlockSet = false,
+                PageCompressionType compressionType = NoPageCompression);
 
 
     /**
@@ -195,7 +196,8 @@ public:
                 size_t desiredSize = 1,
                 bool isMRU = true,
                 bool isTransient = true,
-		bool isSharedTensorBlockSet = false);
+		bool isSharedTensorBlockSet = false,
+                PageCompressionType compressionType = NoPageCompression);
 
     /**
      * Add a set using only database name and set name
@@ -206,7 +208,8 @@ public:
                 size_t desiredSize = 1,
                 bool isMRU = true,
                 bool isTransient = true,
-		bool isSharedTensorBlockSet = false);
+		bool isSharedTensorBlockSet = false,
+                PageCompressionType compressionType = NoPageCompression);
 
 
     /**
@@ -251,15 +254,38 @@ public:
     SetPtr getSet(DatabaseID dbId, UserTypeID typeId, SetID setId);
 
 
+    /**
+     * Pin a new page of a set if wasNewPage is true, otherwise the page with pageId,
+     * returns nullptr if the set or the page doesn't exist
+     */
+    PDBPagePtr pinPage(
+        DatabaseID dbId, UserTypeID typeId, SetID setId, PageID pageId, bool wasNewPage);
+
+
+    /**
+     * Unpin a page, returns false if the page is not in the cache
+     */
+    bool unpinPage(CacheKey key);
+
+
+    /**
+     * Run a pin or unpin command submitted by the backend through the shared-memory ring
+     */
+    void runShmCommand(ShmCommand& command);
+
+
     /**
      * Start flushing main threads, which are also consumer threads,
      * to flush data in the flush buffer to disk files.
+     * It also starts the read-ahead threads of the page cache, and the threads polling the
+     * shared-memory command ring.
      */
     void startFlushConsumerThreads();
 
 
     /**
      * Stop flushing main threads, and close flushBuffer.
+     * It also stops the read-ahead threads of the page cache, and the ring pollers.
      */
     void stopFlushConsumerThreads();
 
@@ -19,7 +19,10 @@
 #include "ShuffleInfo.h"
 #include "PreCompiledWorkload.h"
 #include "DistributedStorageManagerClient.h"
+#include "JoinBloomFilter.h"
 #include <vector>
+#include <map>
+#include <set>
 
 namespace pdb {
 
@@ -118,6 +121,10 @@ public:
                        PDBCommunicatorPtr communicator,
                        ObjectCreationMode mode);
 
+    // to fold the Bloom filter merged from the builds of a hash set on all nodes, so that it
+    // has JOIN_FILTER_BITS_PER_KEY bits per key, or to drop it if it has too few bits per key
+    void finishJoinFilter(std::string hashSetName);
+
     // to replace: void schedule()
     // to schedule the query plan on all available resources
     void scheduleQuery();
@@ -210,6 +217,14 @@ protected:
 
     int numHashKeys = 0;
 
+    // the Bloom filters over the join hashes of the hash sets built for hash partitioned joins,
+    // which are merged from the filters of all nodes, and the number of keys in each of them
+    std::map<std::string, JoinBloomFilterPtr> joinFilters;
+    std::map<std::string, size_t> joinFilterNumKeys;
+
+    // the hash sets that some node built without a Bloom filter
+    std::set<std::string> hashSetsWithoutJoinFilter;
+
 
     // logger
     PDBLoggerPtr logger;
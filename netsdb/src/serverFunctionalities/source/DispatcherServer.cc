@@ -16,6 +16,7 @@
 #include "DistributedStorageManagerServer.h"
 #include "PartitionPolicyFactory.h"
 #include "DispatcherRegisterPartitionPolicy.h"
+#include "PageReceiver.h"
 #include <snappy.h>
 #define MAX_CONCURRENT_REQUESTS 10
 
@@ -62,23 +63,28 @@ void DispatcherServer::registerHandlers(PDBServer& forMe) {
                 const UseTemporaryAllocationBlock tempBlock{(size_t)numBytes + (size_t)128*(size_t)1024*(size_t)1024};
                 dataToSend = sendUsingMe->getNextObject<Vector<Handle<Object>>>(res, errMsg);
             } else {
+                // the bytes are only forwarded, so they are received to a buffer of this worker
+                // that is reused by its next requests, instead of to a buffer of each request
 #ifdef ENABLE_COMPRESSION
-                tempPage = new char[numBytes];
+                tempPage = getThreadReceiveBuffer(numBytes);
                 sendUsingMe->receiveBytes(tempPage, errMsg);
 #else
-                readToHere = (char*)malloc(numBytes);
+                readToHere = getThreadReceiveBuffer(numBytes);
                 sendUsingMe->receiveBytes(readToHere, errMsg);
 #endif
+                getPageReceiveCounters().addPage(numBytes);
 
 #ifdef ENABLE_COMPRESSION
+                // the compressed bytes are forwarded, and only decompressed to check the objects
                 size_t uncompressedSize = 0;
                 snappy::GetUncompressedLength(tempPage, numBytes, &uncompressedSize);
-                readToHere = (char*)malloc(uncompressedSize);
+                readToHere = getThreadDecompressBuffer(uncompressedSize);
                 snappy::RawUncompress(tempPage, numBytes, (char*)(readToHere));
+                getPageReceiveCounters().addCopy(uncompressedSize);
+#endif
                 Record<Vector<Handle<Object>>>* myRecord =
                     (Record<Vector<Handle<Object>>>*)readToHere;
                 dataToSend = myRecord->getRootObject();
-#endif
             }
             if (dataToSend->size() == 0) {
                 errMsg = "Warning: client attemps to store zero object vector";
@@ -86,6 +92,7 @@ void DispatcherServer::registerHandlers(PDBServer& forMe) {
                     makeObject<SimpleRequestResult>(false, errMsg);
                 res = sendUsingMe->sendObject(response, errMsg);
                 std::cout << errMsg << std::endl;
+                releaseThreadReceiveBuffers();
                 pthread_mutex_lock(&mutex);
                 numRequestsInProcessing = numRequestsInProcessing - 1;
                 pthread_mutex_unlock(&mutex);
@@ -100,6 +107,7 @@ void DispatcherServer::registerHandlers(PDBServer& forMe) {
                     makeObject<SimpleRequestResult>(false, errMsg);
                 res = sendUsingMe->sendObject(response, errMsg);
                 std::cout << errMsg << std::endl;
+                releaseThreadReceiveBuffers();
                 pthread_mutex_lock(&mutex);
                 numRequestsInProcessing = numRequestsInProcessing - 1;
                 pthread_mutex_unlock(&mutex);
@@ -122,7 +130,6 @@ void DispatcherServer::registerHandlers(PDBServer& forMe) {
                               request->getTypeName(),
                               tempPage,
                               numBytes);
-                free(tempPage);
 #else
                 dispatchBytes(std::pair<std::string, std::string>(request->getSetName(),
                                                                   request->getDatabaseName()),
@@ -130,7 +137,7 @@ void DispatcherServer::registerHandlers(PDBServer& forMe) {
                               readToHere,
                               numBytes);
 #endif
-                free(readToHere);
+                releaseThreadReceiveBuffers();
             }
 
             // update stats
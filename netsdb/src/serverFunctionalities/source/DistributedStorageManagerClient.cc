@@ -14,6 +14,7 @@
 #include "DistributedStorageRemoveTempSet.h"
 #include "DistributedStorageExportSet.h"
 #include "DistributedStorageClearSet.h"
+#include "DistributedStorageAddZoneMapAttribute.h"
 #include "DistributedStorageCleanup.h"
 #include "DistributedStorageAddSharedPage.h"
 #include "DistributedStorageAddSharedMapping.h"
@@ -60,7 +61,8 @@ bool DistributedStorageManagerClient::createSet(const std::string& databaseName,
                                                 size_t desiredSize,
                                                 bool isMRU,
 	       bool isSharedTensorBlockSet,
-               bool isModelSet	       ) {
+               bool isModelSet,
+               PageCompressionType compressionType) {
     std::cout << "to create set for " << databaseName << ":" << setName << std::endl;
     if (lambdaIdentifier != nullptr) {
 
@@ -85,7 +87,8 @@ bool DistributedStorageManagerClient::createSet(const std::string& databaseName,
         desiredSize,
         isMRU,
 	isSharedTensorBlockSet,
-	isModelSet
+	isModelSet,
+        compressionType
         );
 }
 
@@ -261,6 +264,30 @@ bool DistributedStorageManagerClient::clearSet(const std::string& databaseName,
 }
 
 
+bool DistributedStorageManagerClient::addZoneMapAttribute(const std::string& databaseName,
+                                                          const std::string& setName,
+                                                          const std::string& attributeName,
+                                                          size_t byteOffset,
+                                                          ZoneMapAttributeType attributeType,
+                                                          std::string& errMsg,
+                                                          bool columnar) {
+    return simpleRequest<DistributedStorageAddZoneMapAttribute, SimpleRequestResult, bool>(
+        logger,
+        port,
+        address,
+        false,
+        1024,
+        generateResponseHandler("Could not add zone map attribute to distributed storage manager",
+                                errMsg),
+        databaseName,
+        setName,
+        attributeName,
+        byteOffset,
+        attributeType,
+        columnar);
+}
+
+
 bool DistributedStorageManagerClient::addSharedPage(std::string sharingDatabase,
                    std::string sharingSetName,
                    std::string sharingTypeName,
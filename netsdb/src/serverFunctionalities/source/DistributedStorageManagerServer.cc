@@ -20,6 +20,7 @@
 #include "DistributedStorageRemoveHashSet.h"
 #include "DistributedStorageExportSet.h"
 #include "DistributedStorageClearSet.h"
+#include "DistributedStorageAddZoneMapAttribute.h"
 #include "DistributedStorageCleanup.h"
 #include "DistributedStorageAddSharedPage.h"
 #include "DistributedStorageAddSharedMapping.h"
@@ -43,6 +44,7 @@
 #include "StorageRemoveHashSet.h"
 #include "StorageExportSet.h"
 #include "StorageClearSet.h"
+#include "StorageAddZoneMapAttribute.h"
 #include "StorageCleanup.h"
 #include "StorageAddModel.h"
 #include "StorageAddModelResponse.h"
@@ -325,6 +327,68 @@ void DistributedStorageManagerServer::registerHandlers(PDBServer& forMe) {
             }));
 
 
+    forMe.registerHandler(
+        DistributedStorageAddZoneMapAttribute_TYPEID,
+        make_shared<SimpleRequestHandler<DistributedStorageAddZoneMapAttribute>>(
+            [&](Handle<DistributedStorageAddZoneMapAttribute> request,
+                PDBCommunicatorPtr sendUsingMe) {
+                const UseTemporaryAllocationBlock tempBlock{1 * 1024 * 1024};
+                std::cout << "received DistributedStorageAddZoneMapAttribute message" << std::endl;
+                std::string errMsg;
+                bool res = true;
+                mutex lock;
+
+                auto successfulNodes = std::vector<std::string>();
+                auto failureNodes = std::vector<std::string>();
+
+                std::string database = request->getDatabase();
+                std::string set = request->getSetName();
+
+                if (getFunctionality<CatalogClient>().setExists(database, set)) {
+                    std::vector<std::string> allNodes;
+                    const auto nodes = getFunctionality<ResourceManagerServer>().getAllNodes();
+                    for (int i = 0; i < nodes->size(); i++) {
+                        std::string address = static_cast<std::string>((*nodes)[i]->getAddress());
+                        std::string port = std::to_string((*nodes)[i]->getPort());
+                        allNodes.push_back(address + ":" + port);
+                    }
+                    Handle<StorageAddZoneMapAttribute> storageCmd =
+                        makeObject<StorageAddZoneMapAttribute>(request->getDatabase(),
+                                                               request->getSetName(),
+                                                               request->getAttributeName(),
+                                                               request->getByteOffset(),
+                                                               request->getAttributeType(),
+                                                               request->isColumnar());
+                    getFunctionality<DistributedStorageManagerServer>()
+                        .broadcast<StorageAddZoneMapAttribute, Object, SimpleRequestResult>(
+                            storageCmd,
+                            nullptr,
+                            allNodes,
+                            generateAckHandler(successfulNodes, failureNodes, lock),
+                            [&](std::string errMsg, std::string serverName) {
+                                lock.lock();
+                                std::cout << "Server " << serverName
+                                          << " received an error: " << errMsg << std::endl;
+                                failureNodes.push_back(serverName);
+                                lock.unlock();
+                            });
+                    if (failureNodes.size() > 0) {
+                        res = false;
+                        errMsg = std::string("Failed to add zone map attribute on ") +
+                            std::to_string(failureNodes.size()) + " nodes";
+                    }
+                } else {
+                    res = false;
+                    errMsg = std::string("Set with name=") + database + ":" + set +
+                        std::string(" doesn't exist");
+                }
+
+                Handle<SimpleRequestResult> response = makeObject<SimpleRequestResult>(res, errMsg);
+                res = sendUsingMe->sendObject(response, errMsg);
+                return make_pair(res, errMsg);
+            }));
+
+
     forMe.registerHandler(
         DistributedStorageAddTempSet_TYPEID,
         make_shared<SimpleRequestHandler<DistributedStorageAddTempSet>>([&](
@@ -527,6 +591,7 @@ void DistributedStorageManagerServer::registerHandlers(PDBServer& forMe) {
                                                                          request->getMRUorNot(),
                                                                          request->getMRUorNot(),
 									 request->getSharedTensorBlockSet());
+            storageCmd->setCompressionType(request->getCompressionType());
             std::cout << "Page size is determined to be " << pageSize << std::endl;
             
 
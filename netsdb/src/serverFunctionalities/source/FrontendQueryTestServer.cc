@@ -139,6 +139,7 @@ void FrontendQueryTestServer::registerHandlers(PDBServer& forMe) {
                 std::cout << "WARNING: repartitioned data size is 0" << std::endl;
             }
             int numHashKeys = 0;
+            Handle<Vector<unsigned int>> joinFilter = nullptr;
             if (!communicatorToBackend->sendObject(newRequest, errMsg)) {
                 std::cout << errMsg << std::endl;
                 errMsg = std::string("can't send message to backend: ") + errMsg;
@@ -153,6 +154,11 @@ void FrontendQueryTestServer::registerHandlers(PDBServer& forMe) {
                     errMsg = std::string("backend failure: ") + errMsg;
                 }
                 numHashKeys = result->getNumHashKeys();
+                Handle<Vector<unsigned int>> backendJoinFilter = result->getJoinFilter();
+                if (success && (backendJoinFilter != nullptr)) {
+                    joinFilter =
+                        deepCopyToCurrentAllocationBlock<Vector<unsigned int>>(backendJoinFilter);
+                }
             }
 
             // remove sets
@@ -168,6 +174,7 @@ void FrontendQueryTestServer::registerHandlers(PDBServer& forMe) {
             result->setNumPages(inputSet->getNumPages()+inputSet->getNumSharedPages());
             result->setPageSize(inputSet->getPageSize());
             result->setNumHashKeys(numHashKeys);
+            result->setJoinFilter(joinFilter);
             if (success == true) {
                 PDB_COUT << "Stage is done. " << std::endl;
                 errMsg = std::string("execution complete");
@@ -27,9 +27,12 @@
 #include "PipelineStage.h"
 #include "PartitionedHashSet.h"
 #include "SharedHashSet.h"
+#include "JoinBloomFilter.h"
 #include "JoinMap.h"
 #include "RecordIterator.h"
 #include <vector>
+#include <deque>
+#include <functional>
 
 #ifndef JOIN_HASH_TABLE_SIZE_RATIO
 #define JOIN_HASH_TABLE_SIZE_RATIO 1.5
@@ -324,6 +327,14 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
             sourceTupleSetSpecifier, targetTupleSetSpecifier, targetComputationSpecifier);
         Handle<Object> myMap = merger->createNewOutputContainer();
 
+        // every node builds the whole broadcast hash table, so the Bloom filter over its join
+        // hashes stays with the hash set on this node, for the probes of this node
+        if (conf->getUseJoinFilter()) {
+          JoinBloomFilterPtr joinFilter = make_shared<JoinBloomFilter>(conf->getJoinFilterSize());
+          merger->setJoinFilter(joinFilter);
+          sharedHashSet->setJoinFilter(joinFilter);
+        }
+
         // setup an output page to store intermediate results and final output
         PageCircularBufferIteratorPtr iter = iterators.at(0);
         PDBPagePtr page = nullptr;
@@ -349,6 +360,10 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
         }
         getRecord(myMap);
         getAllocator().setPolicy(AllocatorPolicy::defaultAllocator);
+        if (sharedHashSet->getJoinFilter() != nullptr) {
+          sharedHashSet->getJoinFilter()->fold(
+              JoinBloomFilter::getNumBlocksForKeys(merger->getNumHashKeys(), JOIN_FILTER_BITS_PER_KEY));
+        }
 
         if (this->setCurPageScanner(nullptr) == false) {
           success = false;
@@ -376,7 +391,7 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
                                                                getAllocator().cleanInactiveBlocks((size_t) ((size_t) 32 * (size_t) 1024 * (size_t) 1024));
                                                                getAllocator().cleanInactiveBlocks((size_t) ((size_t) 256 * (size_t) 1024 * (size_t) 1024));
                                                                const UseTemporaryAllocationBlock block{32 * 1024 * 1024};
-                                                               bool success;
+                                                               bool success = true;
                                                                std::string errMsg;
 
                                                                std::cout << "Backend got Aggregation JobStage message with Id="
@@ -474,6 +489,8 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
                                                                }
 
                                                                int numHashKeys = 0;
+                                                               // why the aggregation of a partition failed, if one did
+                                                               std::string aggregationErrMsg = "";
                                                                // start multiple threads
                                                                // each thread creates a hash set as temp set, and put key-value pairs to the hash set
                                                                int i;
@@ -524,6 +541,116 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
                                                                    SimpleSingleTableQueryProcessorPtr aggregateProcessor =
                                                                        newAgg->getAggregationProcessor((HashPartitionID) (i));
                                                                    aggregateProcessor->initialize();
+                                                                   // when the aggregation of this partition doesn't fit in an aggregation page, the processor
+                                                                   // spills the partial aggregates to pages of a temp set, hash partitioned into spill
+                                                                   // partitions, which we merge one by one when all input is aggregated
+                                                                   int numSpillPartitions = conf->getNumAggregationSpillPartitions();
+                                                                   SetID spillSetId;
+                                                                   bool hasSpillSet = false;
+                                                                   PDBPagePtr spillPage = nullptr;
+                                                                   // the pages of the current spill, by spill partition
+                                                                   std::vector<std::vector<PDBPagePtr>> spilledPages(numSpillPartitions);
+                                                                   // why spilling failed, if it did
+                                                                   std::string spillErrMsg = "";
+                                                                   // an aggregation page that is full when nothing more can be spilled would leave results that
+                                                                   // are not fully aggregated, so the aggregation of this partition fails instead
+                                                                   auto failFullPage = [&]() {
+                                                                     if (spillErrMsg == "") {
+                                                                       spillErrMsg = "the aggregation page is full and can't be spilled, please increase hash "
+                                                                                     "page size or the number of aggregation spill partitions";
+                                                                     }
+                                                                     std::cout << "ERROR: aggregation of partition-" << i << " failed: " << spillErrMsg
+                                                                               << std::endl;
+                                                                     logger->error(std::string("aggregation of partition-") + std::to_string(i) +
+                                                                                   " failed: " + spillErrMsg);
+                                                                   };
+                                                                   if (numSpillPartitions > 0) {
+                                                                     aggregateProcessor->setSpillPages(
+                                                                         [&]() -> std::pair<void*, size_t> {
+                                                                           if (hasSpillSet == false) {
+                                                                             std::string spillSetName = request->getSinkContext()->getDatabase() + ":" +
+                                                                                                        request->getSinkContext()->getSetName() + "-spill-" +
+                                                                                                        std::to_string(i);
+                                                                             if (proxy->addTempSet(spillSetName, spillSetId) == false) {
+                                                                               spillErrMsg = "can't add temp set to spill partition-" + std::to_string(i);
+                                                                               return std::make_pair(nullptr, 0);
+                                                                             }
+                                                                             hasSpillSet = true;
+                                                                           }
+                                                                           if (proxy->addTempPage(spillSetId, spillPage) == false) {
+                                                                             spillErrMsg = "can't add a page to spill partition-" + std::to_string(i);
+                                                                             return std::make_pair(nullptr, 0);
+                                                                           }
+                                                                           return std::make_pair(spillPage->getBytes(), spillPage->getSize());
+                                                                         },
+                                                                         [&](void* bytes, int spillPartition) {
+                                                                           spilledPages[spillPartition].push_back(spillPage);
+                                                                           proxy->unpinTempPage(spillSetId, spillPage);
+                                                                         },
+                                                                         numSpillPartitions);
+                                                                   }
+
+                                                                   // to merge the spill partitions one by one: loadOutput loads an aggregation page, and
+                                                                   // writeOut writes out the aggregation page of a spill partition that fits in it; a spill
+                                                                   // partition that doesn't fit is spilled again at the next level, with another hash function
+                                                                   auto mergeSpillPartitions = [&](std::function<void()> loadOutput,
+                                                                                                   std::function<void()> writeOut) {
+                                                                     aggregateProcessor->spillOutputPage();
+                                                                     aggregateProcessor->clearOutputPage();
+                                                                     // each spill partition of the last spill is a run, which is merged from its own pages
+                                                                     std::deque<std::pair<int, std::vector<PDBPagePtr>>> runs;
+                                                                     auto addRuns = [&](int level) {
+                                                                       for (std::vector<PDBPagePtr>& pages : spilledPages) {
+                                                                         if (pages.size() > 0) {
+                                                                           runs.push_back(std::make_pair(level, pages));
+                                                                           pages.clear();
+                                                                         }
+                                                                       }
+                                                                     };
+                                                                     addRuns(0);
+                                                                     while ((runs.size() > 0) && (aggregateProcessor->hasFailed() == false)) {
+                                                                       std::pair<int, std::vector<PDBPagePtr>> run = runs.front();
+                                                                       runs.pop_front();
+                                                                       // keys that are still together after so many levels have the same hash, so that
+                                                                       // spilling them again doesn't split them
+                                                                       if (run.first + 1 >= MAX_AGGREGATION_SPILL_LEVELS) {
+                                                                         aggregateProcessor->setSpillPages(nullptr, nullptr, 0);
+                                                                       }
+                                                                       aggregateProcessor->setSpillLevel(run.first + 1);
+                                                                       std::cout << "to merge " << run.second.size() << " spilled pages of partition-" << i
+                                                                                 << " at level " << run.first << std::endl;
+                                                                       aggregateProcessor->initialize();
+                                                                       loadOutput();
+                                                                       int numSpilledPages = aggregateProcessor->getNumSpilledPages();
+                                                                       for (PDBPagePtr page : run.second) {
+                                                                         PDBPagePtr pinnedPage = nullptr;
+                                                                         if (proxy->pinTempPage(spillSetId, page->getPageID(), pinnedPage) == false) {
+                                                                           spillErrMsg = "can't pin spilled page " + std::to_string(page->getPageID()) +
+                                                                                         " of partition-" + std::to_string(i);
+                                                                           break;
+                                                                         }
+                                                                         aggregateProcessor->loadSpilledInput(pinnedPage->getBytes());
+                                                                         bool full = aggregateProcessor->fillNextOutputPage();
+                                                                         aggregateProcessor->clearInputPage();
+                                                                         proxy->unpinTempPage(spillSetId, pinnedPage);
+                                                                         if (full) {
+                                                                           failFullPage();
+                                                                           break;
+                                                                         }
+                                                                       }
+                                                                       if (spillErrMsg != "") {
+                                                                         aggregateProcessor->clearOutputPage();
+                                                                         break;
+                                                                       }
+                                                                       if (aggregateProcessor->getNumSpilledPages() > numSpilledPages) {
+                                                                         aggregateProcessor->spillOutputPage();
+                                                                         aggregateProcessor->clearOutputPage();
+                                                                         addRuns(run.first + 1);
+                                                                       } else {
+                                                                         writeOut();
+                                                                       }
+                                                                     }
+                                                                   };
                                                                    PageCircularBufferIteratorPtr myIter = hashIters[i];
                                                                    if (request->needsToMaterializeAggOut() == false) {
 
@@ -539,7 +666,7 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
                                                                          if (inputData != nullptr) {
                                                                            inputSize = inputData->size();
                                                                          }
-                                                                         for (int j = 0; j < inputSize; j++) {
+                                                                         for (int j = 0; (j < inputSize) && (spillErrMsg == ""); j++) {
                                                                            aggregateProcessor->loadInputObject((*inputData)[j]);
                                                                            if (aggregateProcessor->needsProcessInput() == false) {
                                                                              continue;
@@ -555,18 +682,8 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
                                                                                  outBytes, aggregationSet->getPageSize());
                                                                            }
                                                                            if (aggregateProcessor->fillNextOutputPage()) {
+                                                                             failFullPage();
                                                                              aggregateProcessor->clearOutputPage();
-                                                                             std::cout
-                                                                                 << "WARNING: aggregation for partition-" << i
-                                                                                 << " can't finish in one aggregation page with size="
-                                                                                 << aggregationSet->getPageSize() << std::endl;
-                                                                             std::cout << "WARNING: results may not be fully aggregated "
-                                                                                 "for partition-"
-                                                                                       << i << ", please increase hash page size!!"
-                                                                                       << std::endl;
-                                                                             logger->error(std::string(
-                                                                                 "Hash page size is too small or memory is "
-                                                                                     "insufficient, results are not fully aggregated!"));
                                                                              break;
                                                                            }
                                                                          }
@@ -582,10 +699,32 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
                                                                          }
                                                                        }
                                                                      }
-                                                                     if (outBytes != nullptr) {
+                                                                     if ((outBytes == nullptr) || (spillErrMsg != "")) {
+                                                                       // nothing to write out, or the aggregation of this partition failed
+                                                                     } else if (aggregateProcessor->getNumSpilledPages() == 0) {
                                                                        aggregateProcessor->finalize();
                                                                        aggregateProcessor->fillNextOutputPage();
                                                                        aggregateProcessor->clearOutputPage();
+                                                                     } else {
+                                                                       // each spill partition that fits is written out to its own page of the hash set,
+                                                                       // as the spill partitions have no key in common
+                                                                       mergeSpillPartitions(
+                                                                           [&]() {
+                                                                             if (outBytes == nullptr) {
+                                                                               outBytes = aggregationSet->addPage();
+                                                                               if (outBytes == nullptr) {
+                                                                                 std::cout << "insufficient memory in heap" << std::endl;
+                                                                                 exit(-1);
+                                                                               }
+                                                                             }
+                                                                             aggregateProcessor->loadOutputPage(outBytes, aggregationSet->getPageSize());
+                                                                           },
+                                                                           [&]() {
+                                                                             aggregateProcessor->finalize();
+                                                                             aggregateProcessor->fillNextOutputPage();
+                                                                             aggregateProcessor->clearOutputPage();
+                                                                             outBytes = nullptr;
+                                                                           });
                                                                      }
 
                                                                    } else {
@@ -619,7 +758,7 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
                                                                          if (inputData != nullptr) {
                                                                            inputSize = inputData->size();
                                                                          }
-                                                                         for (int j = 0; j < inputSize; j++) {
+                                                                         for (int j = 0; (j < inputSize) && (spillErrMsg == ""); j++) {
                                                                            aggregateProcessor->loadInputObject((*inputData)[j]);
                                                                            if (aggregateProcessor->needsProcessInput() == false) {
                                                                              continue;
@@ -636,52 +775,10 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
                                                                                                                 aggregationPageSize);
                                                                            }
                                                                            if (aggregateProcessor->fillNextOutputPage()) {
-                                                                             std::cout
-                                                                                 << "WARNING: aggregation for partition-" << i
-                                                                                 << " can't finish in one aggregation page with size="
-                                                                                 << aggregationPageSize << std::endl;
-                                                                             std::cout << "WARNING: results may not be fully aggregated "
-                                                                                 "for partition-"
-                                                                                       << i
-                                                                                       << ", please ask PDB admin to tune memory size!!"
-                                                                                       << std::endl;
-                                                                             logger->error(std::string(
-                                                                                 "Hash page size is too small or memory is "
-                                                                                     "insufficient, results are not fully aggregated!"));
-                                                                             // write to output set
-                                                                             // load input page
-                                                                             aggOutProcessor->loadInputPage(aggregationPage);
-                                                                             // get output page
-                                                                             if (output == nullptr) {
-                                                                               proxy->addUserPage(outputSet->getDatabaseId(),
-                                                                                                  outputSet->getTypeId(),
-                                                                                                  outputSet->getSetId(),
-                                                                                                  output);
-                                                                               aggOutProcessor->loadOutputPage(output->getBytes(),
-                                                                                                               output->getSize());
-                                                                             }
-                                                                             while (aggOutProcessor->fillNextOutputPage()) {
-                                                                               aggOutProcessor->clearOutputPage();
-                                                                               PDB_COUT << i << ": AggOutProcessor: we now filled an "
-                                                                                   "output page and unpin it"
-                                                                                        << std::endl;
-                                                                               // unpin the output page
-                                                                               proxy->unpinUserPage(nodeId,
-                                                                                                    outputSet->getDatabaseId(),
-                                                                                                    outputSet->getTypeId(),
-                                                                                                    outputSet->getSetId(),
-                                                                                                    output);
-                                                                               // pin a new output page
-                                                                               proxy->addUserPage(outputSet->getDatabaseId(),
-                                                                                                  outputSet->getTypeId(),
-                                                                                                  outputSet->getSetId(),
-                                                                                                  output);
-                                                                               // load output
-                                                                               aggOutProcessor->loadOutputPage(output->getBytes(),
-                                                                                                               output->getSize());
-                                                                             }
+                                                                             failFullPage();
                                                                              aggregateProcessor->clearOutputPage();
                                                                              free(aggregationPage);
+                                                                             aggregationPage = nullptr;
                                                                              break;
                                                                            }
                                                                          }
@@ -698,57 +795,82 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
                                                                        }
                                                                      }
                                                                      if (aggregationPage != nullptr) {
-                                                                       // finalize()
-                                                                       aggregateProcessor->finalize();
-                                                                       aggregateProcessor->fillNextOutputPage();
-                                                                       // load input page
-                                                                       aggOutProcessor->loadInputPage(aggregationPage);
-                                                                       // get output page
-                                                                       if (output == nullptr) {
-                                                                         proxy->addUserPage(outputSet->getDatabaseId(),
-                                                                                            outputSet->getTypeId(),
-                                                                                            outputSet->getSetId(),
-                                                                                            output);
-                                                                         aggOutProcessor->loadOutputPage(output->getBytes(),
-                                                                                                         output->getSize());
+                                                                       // to write the aggregation page out to the output set
+                                                                       auto writeOutAggregationPage = [&]() {
+                                                                           // finalize()
+                                                                           aggregateProcessor->finalize();
+                                                                           aggregateProcessor->fillNextOutputPage();
+                                                                           // load input page
+                                                                           aggOutProcessor->loadInputPage(aggregationPage);
+                                                                           // get output page
+                                                                           if (output == nullptr) {
+                                                                             proxy->addUserPage(outputSet->getDatabaseId(),
+                                                                                                outputSet->getTypeId(),
+                                                                                                outputSet->getSetId(),
+                                                                                                output);
+                                                                             aggOutProcessor->loadOutputPage(output->getBytes(),
+                                                                                                             output->getSize());
+                                                                           }
+                                                                           while (aggOutProcessor->fillNextOutputPage()) {
+                                                                             aggOutProcessor->clearOutputPage();
+                                                                             // unpin the output page
+                                                                             proxy->unpinUserPage(nodeId,
+                                                                                                  outputSet->getDatabaseId(),
+                                                                                                  outputSet->getTypeId(),
+                                                                                                  outputSet->getSetId(),
+                                                                                                  output);
+                                                                             // pin a new output page
+                                                                             proxy->addUserPage(outputSet->getDatabaseId(),
+                                                                                                outputSet->getTypeId(),
+                                                                                                outputSet->getSetId(),
+                                                                                                output);
+                                                                             // load output
+                                                                             aggOutProcessor->loadOutputPage(output->getBytes(),
+                                                                                                             output->getSize());
+                                                                           }
+                                                                         aggOutProcessor->clearInputPage();
+                                                                         aggregateProcessor->clearOutputPage();
+                                                                       };
+                                                                       if (aggregateProcessor->getNumSpilledPages() == 0) {
+                                                                         writeOutAggregationPage();
+                                                                       } else {
+                                                                         mergeSpillPartitions(
+                                                                             [&]() {
+                                                                               aggregateProcessor->loadOutputPage(aggregationPage, aggregationPageSize);
+                                                                             },
+                                                                             writeOutAggregationPage);
                                                                        }
-                                                                       while (aggOutProcessor->fillNextOutputPage()) {
+
+                                                                       // finalize() and unpin last output page; there is none if the merge of the spill
+                                                                       // partitions failed before writing anything out
+                                                                       if (output != nullptr) {
+                                                                         aggOutProcessor->finalize();
+                                                                         aggOutProcessor->fillNextOutputPage();
                                                                          aggOutProcessor->clearOutputPage();
-                                                                         // unpin the output page
                                                                          proxy->unpinUserPage(nodeId,
                                                                                               outputSet->getDatabaseId(),
                                                                                               outputSet->getTypeId(),
                                                                                               outputSet->getSetId(),
                                                                                               output);
-                                                                         // pin a new output page
-                                                                         proxy->addUserPage(outputSet->getDatabaseId(),
-                                                                                            outputSet->getTypeId(),
-                                                                                            outputSet->getSetId(),
-                                                                                            output);
-                                                                         // load output
-                                                                         aggOutProcessor->loadOutputPage(output->getBytes(),
-                                                                                                         output->getSize());
                                                                        }
-
-                                                                       // finalize() and unpin last output page
-                                                                       aggOutProcessor->finalize();
-                                                                       aggOutProcessor->fillNextOutputPage();
-                                                                       aggOutProcessor->clearOutputPage();
-                                                                       proxy->unpinUserPage(nodeId,
-                                                                                            outputSet->getDatabaseId(),
-                                                                                            outputSet->getTypeId(),
-                                                                                            outputSet->getSetId(),
-                                                                                            output);
                                                                        // free aggregation page
                                                                        aggregateProcessor->clearOutputPage();
                                                                        free(aggregationPage);
                                                                      }  // aggregationPage != nullptr
 
                                                                    }  // request->needsToMaterializeAggOut() == true
+                                                                   if (hasSpillSet == true) {
+                                                                     proxy->removeTempSet(spillSetId);
+                                                                   }
                                                                    getAllocator().setPolicy(AllocatorPolicy::defaultAllocator);
                                                                    int numHashKeysInCurPartition = aggregateProcessor->getNumHashKeys();
                                                                    pthread_mutex_lock(&connection_mutex);
                                                                    numHashKeys += numHashKeysInCurPartition;
+                                                                   if ((aggregateProcessor->hasFailed() == true) || (spillErrMsg != "")) {
+                                                                     success = false;
+                                                                     aggregationErrMsg = "Error: aggregation of partition-" + std::to_string(i) +
+                                                                                         " failed: " + spillErrMsg;
+                                                                   }
                                                                    pthread_mutex_unlock(&connection_mutex);
 #ifdef PROFILING
                                                                    std::cout << "partition-" << i << " has " << numHashKeysInCurPartition << " keys." << std::endl;
@@ -877,6 +999,10 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
                                                                while (hashCounter < numPartitions) {
                                                                  hashBuzzer->wait();
                                                                }
+                                                               if (aggregationErrMsg != "") {
+                                                                 errMsg = aggregationErrMsg;
+                                                                 std::cout << errMsg << std::endl;
+                                                               }
 
                                                                // reset scanner
                                                                pthread_mutex_destroy(&connection_mutex);
@@ -954,6 +1080,41 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
             exit(1);
           }
         }
+
+        // with build spilling, the build records that don't fit in the hash page of a partition
+        // are spilled to pages of a temp set, which the page cache can evict to disk until the
+        // probe stage pins them all; this is not a grace hash join, as the probe tuples are not
+        // spilled, so the spilled pages of all partitions must fit in the cache together
+        bool useJoinBuildSpill = conf->getUseJoinBuildSpill();
+        if (useJoinBuildSpill) {
+          PDBCommunicatorPtr spillCommunicator = make_shared<PDBCommunicator>();
+          spillCommunicator->connectToInternetServer(
+              logger, conf->getPort(), conf->getServerAddress(), errMsg);
+          DataProxyPtr spillProxy = make_shared<DataProxy>(nodeId, spillCommunicator, shm, logger);
+          SetID spillSetId;
+          if (spillProxy->addTempSet(hashSetName + "-spill", spillSetId) == true) {
+            partitionedSet->setSpillSet(spillSetId, [this](SetID spillSetId) {
+              std::string errMsg;
+              PDBCommunicatorPtr communicator = make_shared<PDBCommunicator>();
+              communicator->connectToInternetServer(
+                  logger, conf->getPort(), conf->getServerAddress(), errMsg);
+              DataProxyPtr proxy = make_shared<DataProxy>(nodeId, communicator, shm, logger);
+              proxy->removeTempSet(spillSetId);
+            });
+          } else {
+            std::cout << "Can't add temp set to spill hash set " << hashSetName << std::endl;
+            useJoinBuildSpill = false;
+          }
+        }
+
+        // the Bloom filter over the join hashes of all partitions on this node, which is used by
+        // the probes of this node, and is sent back to the scheduler to be merged with the
+        // filters of the other nodes and shipped to the probe side before it is repartitioned
+        JoinBloomFilterPtr joinFilter = nullptr;
+        if (conf->getUseJoinFilter()) {
+          joinFilter = make_shared<JoinBloomFilter>(conf->getJoinFilterSize());
+          partitionedSet->setJoinFilter(joinFilter);
+        }
         // create multiple page circular queues
         int buildingHTBufferSize = 2;
         std::vector<PageCircularBufferPtr> hashBuffers;
@@ -995,6 +1156,8 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
         // start multiple threads
         // each thread creates a hash set as temp set, and put key-value pairs to the hash set
         int numHashKeys = 0;
+        // why the build of a partition failed, if one did
+        std::string buildErrMsg = "";
         for (int i = 0; i < numPartitions; i++) {
             PDBLoggerPtr myLogger = make_shared<PDBLogger>(std::string("buildHT-") + std::to_string(i));
             PageCircularBufferPtr buffer = make_shared<PageCircularBuffer>(buildingHTBufferSize, myLogger);
@@ -1034,6 +1197,26 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
             std::cout << "hashSetSize = " << hashSetSize << std::endl;
             //getAllocator().setPolicy(AllocatorPolicy::noReuseAllocator);
             Handle<Object> myMap = merger->createNewOutputContainer();
+            merger->setJoinFilter(joinFilter);
+
+            // the page that the merger spills to, which is unpinned once it is full
+            PDBPagePtr spillPage = nullptr;
+            if (useJoinBuildSpill) {
+              merger->setSpillPages(
+                  [&]() -> std::pair<void*, size_t> {
+                    if (proxy->addTempPage(partitionedSet->getSpillSetId(), spillPage) == false) {
+                      std::cout << "ERROR: can't add a page to spill partition-" << i
+                                << std::endl;
+                      spillPage = nullptr;
+                      return std::make_pair(nullptr, 0);
+                    }
+                    return std::make_pair(spillPage->getBytes(), spillPage->getSize());
+                  },
+                  [&](void* bytes) {
+                    partitionedSet->addSpilledPage(i, spillPage);
+                    proxy->unpinTempPage(partitionedSet->getSpillSetId(), spillPage);
+                  });
+            }
 
             // setup an output page to store intermediate results and final output
             PageCircularBufferIteratorPtr myIter = hashIters[i];
@@ -1069,11 +1252,21 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
                 }
               }
             }
+            merger->flushSpillPage();
+            if (merger->getNumSpilledPages() > 0) {
+              std::cout << "partition-" << i << " spilled " << merger->getNumSpilledPages()
+                        << " pages" << std::endl;
+            }
             std::cout << "To get record" << std::endl;
             getRecord(myMap);
             int numHashKeysInCurPartition = merger->getNumHashKeys();
             pthread_mutex_lock(&connection_mutex);
             numHashKeys += numHashKeysInCurPartition;
+            if (merger->hasFailed() == true) {
+              success = false;
+              buildErrMsg = "Error: build records of partition-" + std::to_string(i) +
+                            " of " + hashSetName + " neither fit in its hash page nor can be spilled";
+            }
             pthread_mutex_unlock(&connection_mutex);
             getAllocator().setPolicy(AllocatorPolicy::defaultAllocator);
 #ifdef PROFILING
@@ -1200,6 +1393,10 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
         while (hashCounter < numPartitions) {
           hashBuzzer->wait();
         }
+        if (buildErrMsg != "") {
+          errMsg = buildErrMsg;
+          std::cout << errMsg << std::endl;
+        }
 
         // reset scanner
         pthread_mutex_destroy(&connection_mutex);
@@ -1214,9 +1411,23 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
 
         // return result to frontend
         PDB_COUT << "to send back reply" << std::endl;
-        const UseTemporaryAllocationBlock block1{1024};
+        size_t joinFilterSize = 0;
+        if ((joinFilter != nullptr) && (success == true)) {
+          joinFilterSize = joinFilter->getNumWords() * sizeof(unsigned int);
+        }
+        const UseTemporaryAllocationBlock block1{1024 + joinFilterSize};
         Handle<SimpleRequestResult> response = makeObject<SimpleRequestResult>(success, errMsg);
         response->setNumHashKeys(numHashKeys);
+        if (joinFilterSize > 0) {
+          Handle<Vector<unsigned int>> joinFilterWords = makeObject<Vector<unsigned int>>(
+              joinFilter->getNumWords(), joinFilter->getNumWords());
+          memcpy(joinFilterWords->c_ptr(), joinFilter->getWords(), joinFilterSize);
+          response->setJoinFilter(joinFilterWords);
+        }
+        // the probes of this node only need as many bits as the keys on this node
+        if (joinFilter != nullptr) {
+          joinFilter->fold(JoinBloomFilter::getNumBlocksForKeys(numHashKeys, JOIN_FILTER_BITS_PER_KEY));
+        }
         // return the result
         success = sendUsingMe->sendObject(response, errMsg);
         return make_pair(success, errMsg);
@@ -1276,6 +1487,11 @@ void HermesExecutionServer::registerHandlers(PDBServer &forMe) {
             std::cout << "run pipeline with combiner..." << std::endl;
             pipeline->runPipelineWithShuffleSink(this);
           }
+          // the stage fails if a thread stopped with partial results
+          if (pipeline->hasFailed(errMsg) == true) {
+            res = false;
+            std::cout << "pipeline stage failed: " << errMsg << std::endl;
+          }
           if ((sourceContext->isAggregationResult() == true) &&
               (sourceContext->getSetType() == PartitionedHashSetType)) {
               std::cout << "to remove hash set for aggregation result" << std::endl;
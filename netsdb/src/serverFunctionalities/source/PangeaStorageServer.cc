@@ -13,6 +13,8 @@
 #include "StorageAddDatabase.h"
 #include "StorageAddSet.h"
 #include "StorageClearSet.h"
+#include "StorageAddZoneMapAttribute.h"
+#include "PaxPage.h"
 #include "StorageGetData.h"
 #include "StorageGetStats.h"
 #include "StorageGetDataResponse.h"
@@ -40,6 +42,7 @@
 #include "StorageCollectStats.h"
 #include "StorageCollectStatsResponse.h"
 #include "PDBScanWork.h"
+#include "PartitionPageIterator.h"
 #include "UseTemporaryAllocationBlock.h"
 #include "SimpleRequestHandler.h"
 #include "Record.h"
@@ -50,6 +53,10 @@
 #include "SharedMem.h"
 #include "PDBFlushProducerWork.h"
 #include "PDBFlushConsumerWork.h"
+#include "PDBShmRingPollerWork.h"
+#include "PageCompressor.h"
+#include "PageReceiver.h"
+#include "StreamCodecSelector.h"
 #include "ExportableObject.h"
 #include "JoinTupleBase.h"
 #include "SharedFFMatrixBlockSet.h"
@@ -65,7 +72,6 @@
 #include <pthread.h>
 #include <snappy.h>
 
-#define FLUSH_BUFFER_SIZE 3
 
 
 namespace pdb {
@@ -107,10 +113,11 @@ PangeaStorageServer::PangeaStorageServer(SharedMemPtr shm,
 
     // initialize flush buffer
     // a producer work will periodically remove unpinned data from input buffer, and
-    this->flushBuffer = make_shared<PageCircularBuffer>(FLUSH_BUFFER_SIZE, logger);
+    this->flushBuffer = make_shared<PageCircularBuffer>(conf->getFlushBufferSize(), logger);
 
     // initialize cache, must be initialized before databases
-    this->cache = make_shared<PageCache>(conf, workers, flushBuffer, logger, shm, UnifiedLRU);
+    this->cache = make_shared<PageCache>(
+        conf, workers, flushBuffer, logger, shm, conf->getCacheStrategy());
 
     // initialize and load databases, must be initialized after cache
     this->dbs = new std::map<DatabaseID, DefaultDatabasePtr>();
@@ -226,6 +233,35 @@ void PangeaStorageServer::writeBackRecords(pair<std::string, std::string> databa
     }
     size_t pageSize = myPage->getSize();
     std::cout << "pageSize = " << pageSize << std::endl;
+
+    // for a set with columnar attributes, we leave room after the record of each page for the
+    // PAX columns of the objects that fit in the rest of the page
+    std::vector<ZoneMapAttribute> columnarAttributes =
+        getSet(databaseAndSet)->getColumnarAttributes();
+    auto getBlockSize = [&]() -> size_t {
+        if (columnarAttributes.size() == 0) {
+            return pageSize;
+        }
+        size_t bytesPerObject = 64;
+        if ((allRecs.size() > 0) && (allRecs[allRecs.size() - 1]->getRootObject()->size() > 0)) {
+            bytesPerObject = allRecs[allRecs.size() - 1]->numBytes() /
+                allRecs[allRecs.size() - 1]->getRootObject()->size();
+        }
+        size_t numRows =
+            pageSize / (bytesPerObject + PaxPage::getRowWidth(columnarAttributes)) + 1;
+        size_t columnsSize = PaxPage::getColumnsSize(numRows, columnarAttributes);
+        if (columnsSize >= pageSize / 2) {
+            columnsSize = pageSize / 2;
+        }
+        return pageSize - columnsSize;
+    };
+    auto buildPaxColumns = [&]() {
+        if ((columnarAttributes.size() > 0) &&
+            (PaxPage::build(myPage, columnarAttributes) == false)) {
+            std::cout << "PAX columns don't fit in page " << myPage->getPageID() << std::endl;
+        }
+    };
+
     // the position in the output vector
     int pos = 0;
 
@@ -237,7 +273,7 @@ void PangeaStorageServer::writeBackRecords(pair<std::string, std::string> databa
     while (true) {
 
         // all allocations will be done to the page
-        UseTemporaryAllocationBlock block(myPage->getBytes(), pageSize);
+        UseTemporaryAllocationBlock block(myPage->getBytes(), getBlockSize());
         Handle<Vector<Handle<Object>>> data = makeObject<Vector<Handle<Object>>>();
 
         try {
@@ -265,6 +301,7 @@ void PangeaStorageServer::writeBackRecords(pair<std::string, std::string> databa
             // comment the following three lines of code to allow Pangea to manage pages
             std::cout << "Write all of the bytes in the record.\n";
             getRecord(data);
+            buildPaxColumns();
 
             CacheKey key;
             key.dbId = myPage->getDbID();
@@ -283,6 +320,7 @@ void PangeaStorageServer::writeBackRecords(pair<std::string, std::string> databa
             // comment the following three lines of code to allow Pangea to manage pages
             std::cout << "Writing back a page!!\n";
             getRecord(data);
+            buildPaxColumns();
             if (data->size() == 0) {
                 std::cout
                     << "FATAL ERROR: object size is larger than a page, pleases increase page size"
@@ -523,7 +561,8 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
                                                                          request->getDesiredSize(),
                                                                          request->getMRUorNot(),
                                                                          request->getTransientOrNot(),
-									 request->getSharedTensorBlockSet());
+									 request->getSharedTensorBlockSet(),
+                                                                         request->getCompressionType());
                     if (res == false) {
                         errMsg = "Set " + request->getDatabase() + ":" + request->getSetName() +
                             ":" + request->getTypeName() + " already exists\n";
@@ -557,7 +596,8 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
                              request->getDesiredSize(),
                              request->getMRUorNot(),
                              request->getTransientOrNot(),
-			     request->getSharedTensorBlockSet())) == false) {
+			     request->getSharedTensorBlockSet(),
+                             request->getCompressionType())) == false) {
                         errMsg = "Set " + request->getDatabase() + ":" + request->getSetName() +
                             ":" + request->getTypeName() + " already exists\n";
                         cout << errMsg << endl;
@@ -776,6 +816,38 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
                                                            ));
 
 
+    // this handler accepts a request to declare an attribute of a set to summarize in zone maps
+    forMe.registerHandler(
+        StorageAddZoneMapAttribute_TYPEID,
+        make_shared<SimpleRequestHandler<StorageAddZoneMapAttribute>>(
+            [&](Handle<StorageAddZoneMapAttribute> request, PDBCommunicatorPtr sendUsingMe) {
+                std::string errMsg;
+                bool res = true;
+                SetPtr set = getSet(std::make_pair((std::string)request->getDatabase(),
+                                                   (std::string)request->getSetName()));
+                if (set == nullptr) {
+                    res = false;
+                    errMsg = "Set doesn't exist\n";
+                } else {
+                    ZoneMapAttribute attribute;
+                    attribute.name = request->getAttributeName();
+                    attribute.byteOffset = request->getByteOffset();
+                    attribute.type = request->getAttributeType();
+                    attribute.columnar = request->isColumnar();
+                    if ((res = set->addZoneMapAttribute(attribute)) == false) {
+                        errMsg = "Zone map attribute " + attribute.name + " already exists\n";
+                    }
+                }
+                // make the response
+                const UseTemporaryAllocationBlock tempBlock{1024};
+                Handle<SimpleRequestResult> response = makeObject<SimpleRequestResult>(res, errMsg);
+
+                // return the result
+                res = sendUsingMe->sendObject(response, errMsg);
+                return make_pair(res, errMsg);
+            }));
+
+
     // this handler requests to remove a temp set
     forMe.registerHandler(
         StorageRemoveTempSet_TYPEID,
@@ -867,7 +939,12 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
             std::string errMsg;
             bool everythingOK = true;
             Handle<StorageAddObjectInLoop> curRequest = request;
-            void* requestInLoop = nullptr;
+            // the pages of the loop are received to a page of the set that only this loop fills,
+            // and the requests to a buffer that is reused
+            auto databaseAndSet = make_pair((std::string)request->getDatabase(),
+                                            (std::string)request->getSetName());
+            PageReceiver receiver(getSet(databaseAndSet));
+            std::vector<char> requestInLoop;
             int counter = 0;
             while (curRequest->isLoopEnded() == false) {
                 bool typeCheckOrNot = request->isTypeCheck();
@@ -888,18 +965,12 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
                 }
 
                 // get the record
-                size_t numBytes = sendUsingMe->getSizeOfNextObject();
-                std::cout << "received " << numBytes << " bytes" << std::endl;
-#ifdef ENABLE_COMPRESSION
-                char* readToHere = new char[numBytes];
-#else
-                void* readToHere = malloc(numBytes);
-#endif
-                if (readToHere == nullptr) {
-                    std::cout << "PangeaStorageServer.cc: Failed to allocate memory with size=" << numBytes << std::endl;
-                    exit(1);
-                }
-                everythingOK = sendUsingMe->receiveBytes(readToHere, errMsg);
+                bool received = receiver.receive(sendUsingMe,
+                                                 curRequest->getCompressionType(),
+                                                 curRequest->getUncompressedSize(),
+                                                 errMsg);
+                everythingOK = received;
+                std::cout << "received a page" << std::endl;
 
                 {
                     const UseTemporaryAllocationBlock block{1024};
@@ -909,50 +980,22 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
                     // return the result
                     everythingOK = sendUsingMe->sendObject(response, errMsg);
                 }
-                if (everythingOK) {
-#ifdef ENABLE_COMPRESSION
-                    size_t sizeOfBytesToAdd = 0;
-                    snappy::GetUncompressedLength(readToHere, numBytes, &sizeOfBytesToAdd);
-#else
-                    size_t sizeOfBytesToAdd = numBytes;
-#endif
-
-                    auto databaseAndSet = make_pair((std::string)request->getDatabase(),
-                                                    (std::string)request->getSetName());
-                    // now, get a page to write to
-                    SetPtr mySet = getSet(databaseAndSet);
-                    if (mySet == nullptr) {
-                        std::cout << "FATAL ERROR: set to store data doesn't exist!" << std::endl;
+                if (everythingOK && received) {
+                    // now, store the page to the set, unless it is received there already
+                    char* myBytes = (char*)receiver.store(errMsg);
+                    if (myBytes == nullptr) {
+                        std::cout << "FATAL ERROR: " << errMsg << std::endl;
                         std::cout << "databaseName" << databaseAndSet.first << std::endl;
                         std::cout << "setName" << databaseAndSet.second << std::endl;
-                        return make_pair(
-                            false, std::string("FATAL ERROR: set to store data doesn't exist!"));
-                    }
-                    std::cout << "sizeOfBytesToAdd is " << sizeOfBytesToAdd << std::endl;
-                    char* myBytes = (char*)mySet->getNewBytes(sizeOfBytesToAdd);
-                    if (myBytes == nullptr) {
-                        return make_pair(false,
-                                         std::string("FATAL ERROR: can't get bytes from user set " +
-                                                     databaseAndSet.second));
+                        return make_pair(false, "FATAL ERROR: " + errMsg);
                     }
-#ifdef ENABLE_COMPRESSION
-                    snappy::RawUncompress(readToHere, numBytes, myBytes);
-#else
-                    memcpy(myBytes, readToHere, numBytes);
-#endif
-                    /*MD5_CTX md5;
-                    MD5_Init(&md5);
-                    MD5_Update(&md5, myBytes, numBytes);
-                    unsigned char output[MD5_DIGEST_LENGTH];
-                    MD5_Final(output, &md5);
-                    std::cout << "Hash received: " << output << std::endl;
-                    logger->writeLn("Hash received: "+string((char *)output));*/
+                    std::cout << "sizeOfBytesToAdd is " << receiver.getSizeOfLastPage() << std::endl;
 #ifdef DEBUG_SHUFFLING
                     // write the data to a test file
                     std::string fileName =
                       std::string(request->getDatabase()) + "_" + std::string(request->getSetName()) + "_shuffle-received"+std::to_string(counter);
                     FILE* myFile = fopen(fileName.c_str(), "w");
-                    fwrite(myBytes, 1, sizeOfBytesToAdd, myFile);
+                    fwrite(myBytes, 1, receiver.getSizeOfLastPage(), myFile);
                     fclose(myFile);
 #endif
                 } else {
@@ -961,28 +1004,20 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
                         "doesn't exit.\n";
                     everythingOK = false;
                 }
-#ifdef ENABLE_COMPRESSION
-                delete[] readToHere;
-#else
-                free(readToHere);
-#endif
                 counter++;
-                numBytes = sendUsingMe->getSizeOfNextObject();
-                if (requestInLoop != nullptr) {
-                    free(requestInLoop);
-                }
-                requestInLoop = malloc(numBytes);
-                if (requestInLoop == nullptr) {
-                    std::cout << "PangeaStorageServer.cc: Failed to allocate memory with size=" << numBytes << std::endl;
-                    exit(1);
+                size_t numBytes = sendUsingMe->getSizeOfNextObject();
+                if (requestInLoop.size() < numBytes) {
+                    requestInLoop.resize(numBytes);
                 }
                 curRequest = sendUsingMe->getNextObject<StorageAddObjectInLoop>(
-                    requestInLoop, everythingOK, errMsg);
+                    requestInLoop.data(), everythingOK, errMsg);
                 std::cout << "got new StorageAddObjectInLoop" << std::endl;
             }
-            if (requestInLoop != nullptr) {
-                free(requestInLoop);
-            }
+            receiver.finish();
+#ifdef PROFILING
+            std::cout << getPageReceiveCounters().toString() << std::endl;
+            std::cout << getStreamCodecMetrics().toString() << std::endl;
+#endif
             {
                 const UseTemporaryAllocationBlock block{1024};
                 Handle<SimpleRequestResult> response =
@@ -1129,38 +1164,83 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
             bool compressedOrNot = request->isCompressed();
             Handle<Vector<Handle<Object>>> objectsToStore = nullptr;
             char* readToHere = nullptr;
-            if (compressedOrNot == false) {
-                readToHere = (char*)malloc(numBytes);
+            char* compressedBytes = nullptr;
+            PageCompressionType codec = request->getCompressionType();
+            size_t uncompressedSize = numBytes;
+            if ((compressedOrNot == true) && (codec != NoPageCompression)) {
+                // the compressed bytes are received to a buffer of this worker that is reused
+                compressedBytes = getThreadReceiveBuffer(numBytes);
+                std::cout << "received " << numBytes << " bytes" << std::endl;
+                sendUsingMe->receiveBytes(compressedBytes, errMsg);
+                uncompressedSize = StreamCodecSelector::getUncompressedLength(
+                    codec, compressedBytes, numBytes, request->getUncompressedSize());
+                if (uncompressedSize == (size_t)(-1)) {
+                    errMsg = std::string("the size of the data is not known for ") +
+                        PageCompressor::getName(codec);
+                    std::cout << errMsg << std::endl;
+                    uncompressedSize = 0;
+                    everythingOK = false;
+                }
+            }
+            getPageReceiveCounters().addPage(numBytes);
+
+            // the data that is put directly to a page is received or decompressed to a new page
+            // of the set, instead of to a buffer that is copied to the page
+            PDBPagePtr directPage = nullptr;
+            if (request->isDirectPut() == true) {
+                const LockGuard guard{workingMutex};
+                auto databaseAndSet = make_pair((std::string)request->getDatabase(),
+                                                (std::string)request->getSetName());
+                SetPtr mySet = getFunctionality<PangeaStorageServer>().getSet(databaseAndSet);
+                if ((mySet != nullptr) && (uncompressedSize <= mySet->getPageSize())) {
+                    directPage = getFunctionality<PangeaStorageServer>().getNewPage(databaseAndSet);
+                }
+            }
+            if (directPage != nullptr) {
+                readToHere = (char*)directPage->getBytes();
+            } else {
+                readToHere = (char*)malloc(uncompressedSize);
                 if(readToHere == nullptr) {
-                    std::cout << "PangeaStorageServer.cc: Failed to allocate memory with size=" << numBytes << std::endl;
+                    std::cout << "PangeaStorageServer.cc: Failed to allocate memory with size=" << uncompressedSize << std::endl;
                     exit(1);
                 }
+                getPageReceiveCounters().numBufferAllocations++;
+            }
+            if (compressedOrNot == false) {
                 objectsToStore = sendUsingMe->getNextObject<Vector<Handle<Object>>>(
                     readToHere, everythingOK, errMsg);
                 std::cout << "received " << objectsToStore->size() << " objects to store " << numBytes << " bytes" << std::endl;
-            } else {
-                char* temp = new char[numBytes];
-                if(temp == nullptr) {
-                    std::cout << "PangeaStorageServer.cc: Failed to allocate memory with size=" << numBytes << std::endl;
-                    exit(1);
+            } else if (compressedBytes == nullptr) {
+                // the bytes are not compressed, so they are received to where they are stored
+                everythingOK = sendUsingMe->receiveBytes(readToHere, errMsg);
+                if (everythingOK) {
+                    Record<Vector<Handle<Object>>>* myRecord =
+                        (Record<Vector<Handle<Object>>>*)readToHere;
+                    objectsToStore = myRecord->getRootObject();
                 }
-                std::cout << "received " << numBytes << " bytes" << std::endl;
-                sendUsingMe->receiveBytes(temp, errMsg);
-                size_t uncompressedSize = 0;
-                snappy::GetUncompressedLength(temp, numBytes, &uncompressedSize);
-                readToHere = (char*)malloc(uncompressedSize);
-                if(readToHere == nullptr) {
-                    std::cout << "PangeaStorageServer.cc: Failed to allocate memory with size=" << numBytes << std::endl;
-                    exit(1);
+            } else if (everythingOK) {
+                if (StreamCodecSelector::decompress(codec,
+                                                    compressedBytes,
+                                                    numBytes,
+                                                    readToHere,
+                                                    uncompressedSize) != uncompressedSize) {
+                    errMsg = std::string("can't decompress the data with ") +
+                        PageCompressor::getName(codec);
+                    std::cout << errMsg << std::endl;
+                    everythingOK = false;
+                } else {
+                    getPageReceiveCounters().addCopy(uncompressedSize);
+                    Record<Vector<Handle<Object>>>* myRecord =
+                        (Record<Vector<Handle<Object>>>*)readToHere;
+                    objectsToStore = myRecord->getRootObject();
                 }
-                snappy::RawUncompress(temp, numBytes, (char*)(readToHere));
-                Record<Vector<Handle<Object>>>* myRecord =
-                    (Record<Vector<Handle<Object>>>*)readToHere;
-                objectsToStore = myRecord->getRootObject();
-                delete[] temp;
+            }
+            if (compressedBytes != nullptr) {
+                compressedBytes = nullptr;
+                releaseThreadReceiveBuffers();
             }
 
-            if (objectsToStore->size() == 0) {
+            if (everythingOK && (objectsToStore->size() == 0)) {
                 everythingOK = false;
                 errMsg =
                     "Warning: client attemps to store a vector that contains zero objects, simply "
@@ -1218,11 +1298,18 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
                 } else {
                     Record<Vector<Handle<Object>>>* myRecord =
                         (Record<Vector<Handle<Object>>>*)readToHere;
-                    if (myRecord->numBytes() <= myPageSize) {
-                        PDBPagePtr myPage =
-                            getFunctionality<PangeaStorageServer>().getNewPage(databaseAndSet);
-                        // memory copy
-                        memcpy(myPage->getBytes(), readToHere, myRecord->numBytes());
+                    if ((directPage != nullptr) || (myRecord->numBytes() <= myPageSize)) {
+                        PDBPagePtr myPage = directPage;
+                        if (myPage == nullptr) {
+                            myPage =
+                                getFunctionality<PangeaStorageServer>().getNewPage(databaseAndSet);
+                            // memory copy
+                            memcpy(myPage->getBytes(), readToHere, myRecord->numBytes());
+                            getPageReceiveCounters().addCopy(myRecord->numBytes());
+                            objectsToStore = nullptr;
+                            free(readToHere);
+                        }
+                        directPage = nullptr;
                         // unpin the page
                         CacheKey key;
                         key.dbId = myPage->getDbID();
@@ -1250,6 +1337,21 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
                     "Tried to add data of the wrong type to a database set or database set doesn't "
                     "exit.\n";
                 everythingOK = false;
+                if (directPage == nullptr) {
+                    objectsToStore = nullptr;
+                    free(readToHere);
+                }
+            }
+            if (directPage != nullptr) {
+                // the page that the data was received to is not stored, but it is in the set
+                // already, so it is unpinned like the others
+                CacheKey key;
+                key.dbId = directPage->getDbID();
+                key.typeId = directPage->getTypeID();
+                key.setId = directPage->getSetID();
+                key.pageId = directPage->getPageID();
+                getFunctionality<PangeaStorageServer>().getCache()->decPageRefCount(key);
+                directPage = nullptr;
             }
             if (request->isFlushing() == true) {  // this is a client query
                 const UseTemporaryAllocationBlock block{1024};
@@ -1353,6 +1455,16 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
                 Handle<SetIdentifier> setIdentifier = makeObject<SetIdentifier>(dbName, setName);
                 setIdentifier->setNumPages(numPages);
                 setIdentifier->setPageSize(set->getPageSize());
+                PartitionedFilePtr file = set->getFile();
+                if (file != nullptr) {
+                    setIdentifier->setNumStoredBytes(file->getNumStoredBytes());
+                    if (file->getCompressionType() != NoPageCompression) {
+                        std::cout << "set " << dbName << ":" << setName << " is stored with "
+                                  << PageCompressor::getName(file->getCompressionType())
+                                  << ", compression ratio=" << file->getCompressionRatio()
+                                  << std::endl;
+                    }
+                }
                 stats->push_back(setIdentifier);
             }
             response->setStats(stats);
@@ -1360,6 +1472,13 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
             return make_pair(res, errMsg);
         }));
 
+    // the backend pins and unpins pages over the connections of its DataProxy objects, which it
+    // holds open while the workers of this server wait for its job stages; so these connections
+    // keep a worker each, instead of waiting for one behind the requests that wait on them
+    forMe.registerLongConnectionRequest(StoragePinPage_TYPEID);
+    forMe.registerLongConnectionRequest(StoragePinBytes_TYPEID);
+    forMe.registerLongConnectionRequest(StorageUnpinPage_TYPEID);
+
     // this handler accepts a request to pin a page
     forMe.registerHandler(
         StoragePinPage_TYPEID,
@@ -1376,27 +1495,8 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
                 bool res;
                 string errMsg;
 
-                PDBPagePtr page = nullptr;
-                SetPtr set = nullptr;
-
-                if ((dbId == 0) && (typeId == 0)) {
-                    // temp set
-                    set = getFunctionality<PangeaStorageServer>().getTempSet(setId);
-                } else {
-                    // user set
-                    set = getFunctionality<PangeaStorageServer>().getSet(dbId, typeId, setId);
-                }
-
-                if (set != nullptr) {
-                    if (wasNewPage == true) {
-                        page = set->addPage();
-                    } else {
-                        PartitionedFilePtr file = set->getFile();
-                        PartitionedFileMetaDataPtr meta = file->getMetaData();
-                        PageIndex index = meta->getPageIndex(pageId);
-                        page = set->getPage(index.partitionId, index.pageSeqInPartition, pageId);
-                    }
-                }
+                PDBPagePtr page = getFunctionality<PangeaStorageServer>().pinPage(
+                    dbId, typeId, setId, pageId, wasNewPage);
 
                 if (page != nullptr) {
                     logger->debug(
@@ -1504,11 +1604,7 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
 
             bool res;
             std::string errMsg;
-            getFunctionality<PangeaStorageServer>().getCache()->evictionMutexLock();
-            getFunctionality<PangeaStorageServer>().getCache()->evictionLock();
-            if (getFunctionality<PangeaStorageServer>().getCache()->decPageRefCount(key) == false) {
-                getFunctionality<PangeaStorageServer>().getCache()->evictionUnlock();
-                getFunctionality<PangeaStorageServer>().getCache()->evictionMutexUnlock();
+            if (getFunctionality<PangeaStorageServer>().unpinPage(key) == false) {
                 res = false;
                 errMsg = "Fatal Error: Page doesn't exist for unpinning page.";
                 std::cout << "dbId=" << dbId << ", typeId=" << typeId << ", setId=" << setId
@@ -1516,13 +1612,8 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
                 std::cout << errMsg << std::endl;
                 logger->error(errMsg);
             } else {
-                getFunctionality<PangeaStorageServer>().getCache()->evictionUnlock();
-                getFunctionality<PangeaStorageServer>().getCache()->evictionMutexUnlock();
                 std::cout << "Unpin dbId=" << dbId << ", typeId=" << typeId << ", setId=" << setId
                           << ", pageId=" << pageId << std::endl;
-#ifdef ENABLE_EVICTION
-                getFunctionality<PangeaStorageServer>().getCache()->evictPage(key);
-#endif
                 res = true;
             }
 
@@ -1579,6 +1670,23 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
 		sharedSetPtr = getFunctionality<PangeaStorageServer>().getSet(sharedSet.dbId, sharedSet.typeId, sharedSet.setId);
 	        iterators = set->getIteratorsExtended(sharedSetPtr);
 	    }
+            // let the partition iterators skip the pages whose zone maps can't match the
+            // selection predicate of the scan
+            std::vector<PartitionPageIteratorPtr> partitionIterators;
+            if (request->hasZoneMapPredicate() == true) {
+                ZoneMapPredicate predicate;
+                predicate.attributeName = request->getZoneMapAttribute();
+                predicate.op = request->getZoneMapOp();
+                predicate.value = request->getZoneMapValue();
+                for (auto iterator : *iterators) {
+                    PartitionPageIteratorPtr partitionIterator =
+                        dynamic_pointer_cast<PartitionPageIterator>(iterator);
+                    if ((partitionIterator != nullptr) &&
+                        (partitionIterator->setZoneMapPredicate(predicate) == true)) {
+                        partitionIterators.push_back(partitionIterator);
+                    }
+                }
+            }
             getFunctionality<PangeaStorageServer>().getCache()->pin(set, set->getReplacementPolicy(), Read);
             set->setPinned(true);
 	    if (sharedSetPtr != nullptr){
@@ -1608,6 +1716,15 @@ void PangeaStorageServer::registerHandlers(PDBServer& forMe) {
             while (counter < numIterators) {
                 tempBuzzer->wait();
             }
+            if (partitionIterators.size() > 0) {
+                unsigned int numSkippedPages = 0;
+                for (auto partitionIterator : partitionIterators) {
+                    numSkippedPages += partitionIterator->getNumSkippedPages();
+                }
+                std::cout << "GetSetPages: skipped " << numSkippedPages
+                          << " pages by zone maps of " << request->getZoneMapAttribute()
+                          << std::endl;
+            }
             set->setPinned(false);
 
 	    if (sharedSetPtr != nullptr) {
@@ -2024,7 +2141,7 @@ bool PangeaStorageServer::removeType(std::string typeName) {
 
 // to add a new and empty set
 bool PangeaStorageServer::addSet(
-    std::string dbName, std::string typeName, std::string setName, SetID setId, size_t pageSize, size_t desiredSize, bool isMRU, bool isTransient, bool isSharedTensorBlockSet) {
+    std::string dbName, std::string typeName, std::string setName, SetID setId, size_t pageSize, size_t desiredSize, bool isMRU, bool isTransient, bool isSharedTensorBlockSet, PageCompressionType compressionType) {
     SetPtr set = getSet(std::pair<std::string, std::string>(dbName, setName));
     if (set != nullptr) {
         // set exists
@@ -2070,7 +2187,7 @@ bool PangeaStorageServer::addSet(
             return false;
         }
     }
-    type->addSet(setName, setId, pageSize, desiredSize, isMRU, isTransient, isSharedTensorBlockSet);
+    type->addSet(setName, setId, pageSize, desiredSize, isMRU, isTransient, isSharedTensorBlockSet, compressionType);
     std::cout << "to add set with dbName=" << dbName << ", typeName=" << typeName
               << ", setName=" << setName << ", setId=" << setId << ", pageSize=" << pageSize
               << std::endl;
@@ -2102,7 +2219,8 @@ bool PangeaStorageServer::addSet(std::string dbName,
                                  size_t desiredSize,
                                  bool isMRU,
                                  bool isTransient,
-				 bool isSharedTensorBlockSet) {
+				 bool isSharedTensorBlockSet,
+                                 PageCompressionType compressionType) {
     pthread_mutex_lock(&this->usersetLock);
     if (usersetSeqIds->count(dbName) == 0) {
         // database doesn't exist
@@ -2113,13 +2231,13 @@ bool PangeaStorageServer::addSet(std::string dbName,
     std::cout << "to add set with dbName=" << dbName << ", typeName=" << typeName
              << ", setName=" << setName << ", setId=" << setId << ", pageSize=" << pageSize << std::endl;
     pthread_mutex_unlock(&this->usersetLock);
-    return addSet(dbName, typeName, setName, setId, pageSize, desiredSize, isMRU, isTransient, isSharedTensorBlockSet);
+    return addSet(dbName, typeName, setName, setId, pageSize, desiredSize, isMRU, isTransient, isSharedTensorBlockSet, compressionType);
 }
 
 
 // to add a set using only database name and set name
-bool PangeaStorageServer::addSet(std::string dbName, std::string setName, size_t pageSize, size_t desiredSize, bool isMRU, bool isTransient, bool isSharedTensorBlockSet) {
-    return addSet(dbName, "UnknownUserData", setName, pageSize, desiredSize, isMRU, isTransient, isSharedTensorBlockSet);
+bool PangeaStorageServer::addSet(std::string dbName, std::string setName, size_t pageSize, size_t desiredSize, bool isMRU, bool isTransient, bool isSharedTensorBlockSet, PageCompressionType compressionType) {
+    return addSet(dbName, "UnknownUserData", setName, pageSize, desiredSize, isMRU, isTransient, isSharedTensorBlockSet, compressionType);
 }
 
 bool PangeaStorageServer::removeSet(std::string dbName, std::string setName) {
@@ -2276,6 +2394,75 @@ SetPtr PangeaStorageServer::getSet(DatabaseID dbId, UserTypeID typeId, SetID set
     return set;
 }
 
+/**
+ * Pin a new page of a set, or an existing page in the cache, for the backend.
+ * Both the StoragePinPage handler and the shared-memory command ring use this.
+ */
+PDBPagePtr PangeaStorageServer::pinPage(
+    DatabaseID dbId, UserTypeID typeId, SetID setId, PageID pageId, bool wasNewPage) {
+    SetPtr set = this->getSet(dbId, typeId, setId);
+    if (set == nullptr) {
+        return nullptr;
+    }
+    if (wasNewPage == true) {
+        return set->addPage();
+    }
+    PartitionedFilePtr file = set->getFile();
+    PartitionedFileMetaDataPtr meta = file->getMetaData();
+    PageIndex index = meta->getPageIndex(pageId);
+    return set->getPage(index.partitionId, index.pageSeqInPartition, pageId);
+}
+
+/**
+ * Unpin a page for the backend, returns false if the page is not in the cache.
+ * Both the StorageUnpinPage handler and the shared-memory command ring use this.
+ */
+bool PangeaStorageServer::unpinPage(CacheKey key) {
+    this->cache->evictionLock(key);
+    if (this->cache->decPageRefCount(key) == false) {
+        this->cache->evictionUnlock(key);
+        return false;
+    }
+    this->cache->evictionUnlock(key);
+#ifdef ENABLE_EVICTION
+    this->cache->evictPage(key);
+#endif
+    return true;
+}
+
+/**
+ * Run a command that the backend submitted through the shared-memory command ring.
+ */
+void PangeaStorageServer::runShmCommand(ShmCommand& command) {
+    command.success = false;
+    if (command.type == ShmPinPage) {
+        PDBPagePtr page = this->pinPage(
+            command.dbId, command.typeId, command.setId, command.pageId, command.wasNewPage);
+        if (page != nullptr) {
+            command.resultPageId = page->getPageID();
+            command.pageSize = page->getRawSize();
+            command.sharedMemOffset = page->getOffset();
+            command.success = true;
+        } else {
+            this->logger->error(std::string("PangeaStorageServer: can't pin page with setId=") +
+                                std::to_string(command.setId) + std::string(", pageId=") +
+                                std::to_string(command.pageId));
+        }
+    } else if (command.type == ShmUnpinPage) {
+        CacheKey key;
+        key.dbId = command.dbId;
+        key.typeId = command.typeId;
+        key.setId = command.setId;
+        key.pageId = command.pageId;
+        command.success = this->unpinPage(key);
+        if (command.success == false) {
+            this->logger->error(std::string("PangeaStorageServer: can't unpin page with setId=") +
+                                std::to_string(command.setId) + std::string(", pageId=") +
+                                std::to_string(command.pageId));
+        }
+    }
+}
+
 /**
  * Start flushing main threads, which are also consumer threads,
  * to flush data in the flush buffer to disk files.
@@ -2298,6 +2485,22 @@ void PangeaStorageServer::startFlushConsumerThreads() {
         worker->execute(flusher, flusher->getLinkedBuzzer());
         PDB_COUT << "flushing thread started for partition: " << i << "\n";
     }
+    // start the threads that read ahead for sequential scans
+    this->cache->startReadAheadThreads();
+    // start the threads that serve pins and unpins of the backend through shared memory
+    SharedMemRingPtr ring = this->shm->getCommandRing();
+    if ((ring != nullptr) && (this->conf->getNumShmRingPollers() > 0)) {
+        ring->setServiced(true);
+        for (unsigned int j = 0; j < this->conf->getNumShmRingPollers(); j++) {
+            PDBShmRingPollerWorkPtr poller = make_shared<PDBShmRingPollerWork>(ring, this);
+            while ((worker = this->getWorker()) == nullptr) {
+                sched_yield();
+            }
+            worker->execute(poller, poller->getLinkedBuzzer());
+        }
+        PDB_COUT << "shared memory ring pollers started: " << this->conf->getNumShmRingPollers()
+                 << "\n";
+    }
 }
 
 /**
@@ -2310,6 +2513,11 @@ void PangeaStorageServer::stopFlushConsumerThreads() {
         dynamic_pointer_cast<PDBFlushConsumerWork>(flushers.at(i))->stop();
     }
     this->flushBuffer->close();
+    this->cache->stopReadAheadThreads();
+    SharedMemRingPtr ring = this->shm->getCommandRing();
+    if (ring != nullptr) {
+        ring->setServiced(false);
+    }
 }
 
 /**
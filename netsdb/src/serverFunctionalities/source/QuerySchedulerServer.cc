@@ -33,6 +33,7 @@
 #include "Configuration.h"
 #include "SelfLearningServer.h"
 #include "SelfLearningWrapperServer.h"
+#include "PDBConnectionPool.h"
 #include <vector>
 #include <string>
 #include <unordered_map>
@@ -108,6 +109,14 @@ void QuerySchedulerServer::cleanup() {
     }
     this->interGlobalSets.clear();
 
+    this->joinFilters.clear();
+    this->joinFilterNumKeys.clear();
+    this->hashSetsWithoutJoinFilter.clear();
+
+#ifdef PROFILING
+    std::cout << getConnectionPool().printLatencies();
+#endif
+
     this->jobStageId = 0;
 }
 
@@ -506,14 +515,16 @@ void QuerySchedulerServer::scheduleStages(std::vector<Handle<AbstractJobStage>>&
                 std::string ip = (*(this->standardResources))[j]->getAddress();
                 PDB_COUT << "ip:" << ip << std::endl;
                 size_t memory = (*(this->standardResources))[j]->getMemSize();
-                // create PDBCommunicator
+                // get a PDBCommunicator from the connection pool, which reuses the connection
+                // of the previous stage to this node
+                auto requestBegin = std::chrono::high_resolution_clock::now();
                 pthread_mutex_lock(&connection_mutex);
                 PDB_COUT << "to connect to the remote node" << std::endl;
-                PDBCommunicatorPtr communicator = std::make_shared<PDBCommunicator>();
-
                 string errMsg;
                 bool success;
-                if (communicator->connectToInternetServer(logger, port, ip, errMsg)) {
+                PDBCommunicatorPtr communicator =
+                    getConnectionPool().getConnection(logger, port, ip, errMsg);
+                if (communicator == nullptr) {
                     success = false;
                     std::cout << errMsg << std::endl;
                     pthread_mutex_unlock(&connection_mutex);
@@ -576,6 +587,12 @@ void QuerySchedulerServer::scheduleStages(std::vector<Handle<AbstractJobStage>>&
                                  .count()
                           << " seconds." << std::endl;
 #endif
+                auto requestEnd = std::chrono::high_resolution_clock::now();
+                getConnectionPool().recordLatency(
+                    stage->getJobStageType(),
+                    std::chrono::duration_cast<std::chrono::microseconds>(requestEnd - requestBegin)
+                        .count(),
+                    success);
                 if (success == false) {
                     errMsg = std::string("Can't execute the ") + std::to_string(i) +
                         std::string("-th stage on the ") + std::to_string(j) +
@@ -584,6 +601,8 @@ void QuerySchedulerServer::scheduleStages(std::vector<Handle<AbstractJobStage>>&
                     callerBuzzer->buzz(PDBAlarm::GenericError, counter);
                     return;
                 }
+                // the response of the stage is read, so the next stage can use the connection
+                getConnectionPool().releaseConnection(port, ip, communicator);
                 callerBuzzer->buzz(PDBAlarm::WorkAllDone, counter);
             });
             myWorker->execute(myWork, tempBuzzer);
@@ -592,6 +611,12 @@ void QuerySchedulerServer::scheduleStages(std::vector<Handle<AbstractJobStage>>&
             tempBuzzer->wait();
         }
         counter = 0;
+        if (stagesToSchedule[i]->getJobStageType() == "HashPartitionedJoinBuildHTJobStage") {
+            Handle<HashPartitionedJoinBuildHTJobStage> hashPartitionedJoinStage =
+                unsafeCast<HashPartitionedJoinBuildHTJobStage, AbstractJobStage>(
+                    stagesToSchedule[i]);
+            finishJoinFilter(hashPartitionedJoinStage->getHashSetName());
+        }
         if (selfLearningOrNot == true) {
               //update the jobStage entry
               getFunctionality<SelfLearningServer>().updateJobStageForCompletion(jobInstanceStageId, "Succeeded");
@@ -645,6 +670,23 @@ bool QuerySchedulerServer::scheduleStage(int index,
         }
         stageToSend->setIPAddresses(addresses);
         stageToSend->setNodeId(index);
+        // ship the Bloom filter of the hash set that the other side of the join was built into
+        std::string joinFilterHashSetName = stageToSend->getJoinFilterHashSetName();
+        if (joinFilterHashSetName != "") {
+            pthread_mutex_lock(&connection_mutex);
+            auto joinFilterIter = joinFilters.find(joinFilterHashSetName);
+            JoinBloomFilterPtr joinFilter =
+                (joinFilterIter == joinFilters.end()) ? nullptr : joinFilterIter->second;
+            pthread_mutex_unlock(&connection_mutex);
+            if (joinFilter != nullptr) {
+                Handle<Vector<unsigned int>> joinFilterWords = makeObject<Vector<unsigned int>>(
+                    joinFilter->getNumWords(), joinFilter->getNumWords());
+                memcpy(joinFilterWords->c_ptr(),
+                       joinFilter->getWords(),
+                       joinFilter->getNumWords() * sizeof(unsigned int));
+                stageToSend->setJoinFilter(joinFilterWords);
+            }
+        }
         success = communicator->sendObject<TupleSetJobStage>(stageToSend, errMsg);
         if (!success) {
             std::cout << errMsg << std::endl;
@@ -797,6 +839,21 @@ bool QuerySchedulerServer::scheduleStage(int index,
         this->numHashKeys += result->getNumHashKeys();
         std::cout << "***result->getNumHashKeys()=" << result->getNumHashKeys() << std::endl;
         std::cout << "***this->numHashKeys=" << this->numHashKeys << std::endl;
+        // merge the Bloom filter of this node with those of the other nodes
+        std::string hashSetName = stage->getHashSetName();
+        Handle<Vector<unsigned int>> joinFilterWords = result->getJoinFilter();
+        if (joinFilterWords != nullptr) {
+            auto joinFilterIter = joinFilters.find(hashSetName);
+            if (joinFilterIter == joinFilters.end()) {
+                joinFilters[hashSetName] = std::make_shared<JoinBloomFilter>(
+                    joinFilterWords->c_ptr(), joinFilterWords->size());
+            } else {
+                joinFilterIter->second->merge(joinFilterWords->c_ptr(), joinFilterWords->size());
+            }
+            joinFilterNumKeys[hashSetName] += result->getNumHashKeys();
+        } else if (result->getNumHashKeys() > 0) {
+            hashSetsWithoutJoinFilter.insert(hashSetName);
+        }
         pthread_mutex_unlock(&connection_mutex);
         PDB_COUT << "HashPartitionedJoinBuildHTJobStage execute: wrote set:"
                  << result->getDatabase() << ":" << result->getSetName() << std::endl;
@@ -812,6 +869,32 @@ bool QuerySchedulerServer::scheduleStage(int index,
 
 
 
+void QuerySchedulerServer::finishJoinFilter(std::string hashSetName) {
+    pthread_mutex_lock(&connection_mutex);
+    auto joinFilterIter = joinFilters.find(hashSetName);
+    if (joinFilterIter != joinFilters.end()) {
+        size_t numKeys = joinFilterNumKeys[hashSetName];
+        JoinBloomFilterPtr joinFilter = joinFilterIter->second;
+        if (hashSetsWithoutJoinFilter.count(hashSetName) > 0) {
+            std::cout << "Not to use the join filter of " << hashSetName
+                      << ", which some nodes didn't build" << std::endl;
+            joinFilters.erase(joinFilterIter);
+        } else if (joinFilter->getNumBits() < numKeys * JOIN_FILTER_MIN_BITS_PER_KEY) {
+            std::cout << "Not to use the join filter of " << hashSetName << ", which has only "
+                      << joinFilter->getNumBits() << " bits for " << numKeys << " keys"
+                      << std::endl;
+            joinFilters.erase(joinFilterIter);
+        } else {
+            joinFilter->fold(JoinBloomFilter::getNumBlocksForKeys(numKeys, JOIN_FILTER_BITS_PER_KEY));
+            std::cout << "The join filter of " << hashSetName << " has "
+                      << joinFilter->getNumBits() << " bits for " << numKeys << " keys"
+                      << std::endl;
+        }
+    }
+    pthread_mutex_unlock(&connection_mutex);
+}
+
+
 bool QuerySchedulerServer::parseTCAPString(Handle<Vector<Handle<Computation>>> myComputations,
                                            std::string myTCAPString) {
     TCAPAnalyzer tcapAnalyzer(
@@ -13,6 +13,9 @@
 #include <unordered_map>
 #include "STLScopedAllocator.h"
 #include "STLSlabAllocator.h"
+#include "PDBString.h"
+#include "PDBMap.h"
+#include "InterfaceFunctions.h"
 #include <iostream>
 using namespace std;
 
@@ -92,7 +95,7 @@ int main(int argc, char ** argv) {
            cout << "std unordered_map random string time:"<<after-before<<"\n";
        }
 
-   } else {
+   } else if(atoi(argv[2])==2){
        cout << "unordered_map using SlabAllocator\n";
        STLSlabAllocator<std::pair<const char *, int64_t>> allocator = STLSlabAllocator<std::pair<const char *, int64_t>>(64*1024*1024);
        hash<const char*> hasher = hash<const char*>();
@@ -129,6 +132,34 @@ int main(int argc, char ** argv) {
            cout << "std unordered_map random string time:"<<after-before<<"\n";
        }
 
+   } else if(atoi(argv[2])==3) {
+       cout << "pdb::Map using an allocation block\n";
+       pdb::makeObjectAllocatorBlock((size_t)numKeysx1000000 * 256 * 1024 * 1024, true);
+       pdb::Handle<pdb::Map<pdb::String, int64_t>> str_hash = pdb::makeObject<pdb::Map<pdb::String, int64_t>>();
+       if(!strcmp(argv[3], "sequentialstring")) {
+           time_t before = time(0);
+           for(i = 0; i< numKeysx1000000; i++) {
+               for (j = 0; j < 1000000; j++ ) {
+                   char * str = new_string_from_integer(i*1000000+j);
+                   (*str_hash)[pdb::String(str)] = value;
+                   free(str);
+               }
+           }
+           time_t after = time(0);
+           cout << "pdb::Map sequential string time:"<<after-before<<"\n";
+       }
+       else if(!strcmp(argv[3], "randomstring")){
+           srandom(1);
+           time_t before = time(0);
+           for(i = 0; i< numKeysx1000000; i++) {
+               for (j = 0; j < 1000000; j++ ) {
+                   char * str = new_string_from_integer((int)random());
+                   (*str_hash)[pdb::String(str)] = value;
+                   free(str);
+               }
+           }
+           time_t after = time(0);
+           cout << "pdb::Map random string time:"<<after-before<<"\n";
+       }
    }
-
 }
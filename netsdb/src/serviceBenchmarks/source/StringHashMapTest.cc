@@ -17,6 +17,9 @@
 #include "TestVirtualHashMap.h"
 #include "TestVirtualHashMapWithSlabAllocator.h"
 #include "VariableSizeObjectIterator.h"
+#include "PDBString.h"
+#include "PDBMap.h"
+#include "InterfaceFunctions.h"
 #include <iostream>
 using namespace std;
 
@@ -289,6 +292,54 @@ int main(int argc, char ** argv) {
       storage->stopFlushConsumerThreads();
       cout << "count="<<count<<"\n";
   }
+  else if (atoi(argv[2])==6) {
+       cout << "pdb::Map using an allocation block\n";
+       logger->writeLn("pdb::Map using an allocation block\n");
+       pdb::makeObjectAllocatorBlock((size_t)numKeysx1000000 * 256 * 1024 * 1024, true);
+       pdb::Handle<pdb::Map<pdb::String, int>> str_hash = pdb::makeObject<pdb::Map<pdb::String, int>>();
+       if(!strcmp(argv[3], "sequentialstring")) {
+           time_t before = time(0);
+           for(i = 0; i< numKeysx1000000; i++) {
+               for (j = 0; j < 1000000; j++ ) {
+                   (*str_hash)[pdb::String(new_string_from_integer(i*1000000+j))] = value;
+               }
+               cout <<i << ":inserted 1000000 pairs\n";
+           }
+           time_t after = time(0);
+           cout << "pdb::Map sequential string time:"<<after-before<<"\n";
+           logger->writeLn("insertion time=");
+           logger->writeInt(after-before);
+       }
+       else if(!strcmp(argv[3], "randomstring")){
+           srandom(1);
+           time_t before = time(0);
+           for(i = 0; i< numKeysx1000000; i++) {
+               for (j = 0; j < 1000000; j++ ) {
+                   (*str_hash)[pdb::String(new_string_from_integer((int)random()))] = value;
+               }
+               cout << i<<":inserted 1000000 pairs\n";
+           }
+           time_t after = time(0);
+           cout << "pdb::Map random string time:"<<after-before<<"\n";
+           logger->writeLn("pdb::Map insertion time=");
+           logger->writeInt(after-before);
+       }
+       time_t beforeErase = time(0);
+       int count = 0;
+       i=0;
+       for (auto it = str_hash->begin(); it != str_hash->end(); ++it) {
+          count ++;
+          if(count%1000000 == 0) {
+             cout <<i<< ":iterated 1000000 key-value pairs\n";
+             i++;
+          }
+       }
+       time_t afterErase = time(0);
+       cout << "pdb::Map scanning time:"<<afterErase - beforeErase<<"\n";
+       logger->writeLn("pdb::Map iteration time=");
+       logger->writeInt(afterErase-beforeErase);
+       cout << "count="<<count<<"\n";
+  }
   else if (atoi(argv[2])==5) {
       /*
       cout << "Redis\n";
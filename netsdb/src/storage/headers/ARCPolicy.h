@@ -0,0 +1,74 @@
+#ifndef ARC_POLICY_H
+#define ARC_POLICY_H
+
+#include "PageReplacementPolicy.h"
+#include <list>
+#include <unordered_map>
+
+/**
+ * This class implements Adaptive Replacement Cache (Megiddo and Modha, FAST 2003).
+ *
+ * Cached pages are split into T1 (seen once recently) and T2 (seen at least twice recently), and
+ * the keys of pages evicted from T1 and T2 are remembered in the ghost lists B1 and B2. A page
+ * that is cached again while in B1 (or B2) shows that T1 (or T2) was too small, so the target
+ * size p of T1 is moved towards it. A scan only passes through T1, so it can't flush the pages
+ * that an iterative job keeps reusing in T2, while a workload that only reuses recent pages
+ * lets T1 grow to the whole cache.
+ *
+ * All lists are ordered from least to most recently used, and a hash map from CacheKey to the
+ * list and the position of a page makes every operation O(1).
+ */
+class ARCPolicy : public PageReplacementPolicy {
+
+public:
+    ARCPolicy(size_t capacity);
+
+    ~ARCPolicy();
+
+    void pageCached(CacheKey key) override;
+
+    void pageAccessed(CacheKey key) override;
+
+    void pageRemoved(CacheKey key) override;
+
+    bool selectVictim(const std::function<bool(const CacheKey&)>& isEvictable,
+                      CacheKey& victim) override;
+
+    size_t getNumCachedPages() override {
+        return this->lists[T1].size() + this->lists[T2].size();
+    }
+
+    std::string getName() override {
+        return "ARC";
+    }
+
+    // the target size of T1
+    double getTarget() {
+        return this->p;
+    }
+
+private:
+    enum { T1 = 0, T2 = 1, B1 = 2, B2 = 3 };
+
+    // move the page to the most recently used end of a list
+    void moveTo(CacheKey key, int which);
+
+    // drop the least recently used keys of the ghost lists beyond the capacity
+    void trimGhosts();
+
+    // return the first evictable page of a list, from the least recently used end
+    bool selectVictimIn(int which,
+                        const std::function<bool(const CacheKey&)>& isEvictable,
+                        CacheKey& victim);
+
+    size_t capacity;
+
+    double p;
+
+    list<CacheKey> lists[4];
+
+    unordered_map<CacheKey, pair<int, list<CacheKey>::iterator>, CacheKeyHash, CacheKeyEqual>
+        positions;
+};
+
+#endif
@@ -1,49 +1,134 @@
-
 #ifndef CACHESTATS_H
 #define CACHESTATS_H
 
+#include "DataTypes.h"
+#include <atomic>
 #include <pthread.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string>
 #include <iostream>
 
+/**
+ * Hit/miss/eviction counters of the page cache.
+ * The counters are updated by every scan thread on every page access, so they are kept lock-free
+ * to avoid introducing a global serialization point into the otherwise sharded cache.
+ *
+ * The page accesses can also be recorded to a trace file, to be replayed against each page
+ * replacement policy by CacheTraceReplay. The trace has one line for each access:
+ * "<R|N> dbId typeId setId pageId pageSize", where N is the access that creates a new (dirty)
+ * page, and R is any other access. Recording serializes the accesses, so it is off by default.
+ */
 class CacheStats {
 public:
     CacheStats() {
-        pthread_mutex_init(&hitLock, nullptr);
-        pthread_mutex_init(&missLock, nullptr);
-        pthread_mutex_init(&evictedLock, nullptr);
-        pthread_mutex_init(&cachedLock, nullptr);
+        pthread_mutex_init(&traceMutex, nullptr);
     }
 
     ~CacheStats() {
-        pthread_mutex_destroy(&hitLock);
-        pthread_mutex_destroy(&missLock);
-        pthread_mutex_destroy(&evictedLock);
-        pthread_mutex_destroy(&cachedLock);
+        stopTrace();
+        pthread_mutex_destroy(&traceMutex);
+    }
+
+    // Start recording page accesses to the file, return false if the file can't be opened.
+    bool startTrace(std::string path) {
+        pthread_mutex_lock(&traceMutex);
+        if (traceFile != nullptr) {
+            fclose(traceFile);
+        }
+        FILE* file = fopen(path.c_str(), "w");
+        traceFile = file;
+        pthread_mutex_unlock(&traceMutex);
+        if (file == nullptr) {
+            std::cout << "CacheStats: can't open trace file " << path << std::endl;
+            return false;
+        }
+        std::cout << "CacheStats: recording page accesses to " << path << std::endl;
+        return true;
+    }
+
+    // Stop recording page accesses.
+    void stopTrace() {
+        pthread_mutex_lock(&traceMutex);
+        if (traceFile != nullptr) {
+            fclose(traceFile);
+            traceFile = nullptr;
+        }
+        pthread_mutex_unlock(&traceMutex);
+    }
+
+    void recordAccess(CacheKey key, size_t pageSize, bool isNewPage) {
+        if (traceFile == nullptr) {
+            return;
+        }
+        pthread_mutex_lock(&traceMutex);
+        if (traceFile != nullptr) {
+            fprintf(traceFile,
+                    "%c %u %u %u %u %zu\n",
+                    isNewPage ? 'N' : 'R',
+                    (unsigned int)key.dbId,
+                    (unsigned int)key.typeId,
+                    (unsigned int)key.setId,
+                    (unsigned int)key.pageId,
+                    pageSize);
+        }
+        pthread_mutex_unlock(&traceMutex);
     }
 
     void incHits() {
-        pthread_mutex_lock(&hitLock);
-        numHits ++;
-        pthread_mutex_unlock(&hitLock);
+        numHits.fetch_add(1, std::memory_order_relaxed);
     }
 
     void incMisses() {
-        pthread_mutex_lock(&missLock);
-        numMisses ++;
-        pthread_mutex_unlock(&missLock);
+        numMisses.fetch_add(1, std::memory_order_relaxed);
     }
 
     void incEvicted() {
-        pthread_mutex_lock(&evictedLock);
-        numEvicted ++;
-        pthread_mutex_unlock(&evictedLock);
+        numEvicted.fetch_add(1, std::memory_order_relaxed);
     }
 
     void incCached() {
-        pthread_mutex_lock(&cachedLock);
-        numCached ++;
-        pthread_mutex_unlock(&cachedLock);
+        numCached.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void incReadAhead() {
+        numReadAhead.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void incReadAheadWaits() {
+        numReadAheadWaits.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void incFlushWaits() {
+        numFlushWaits.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void incSecondTierHits() {
+        numSecondTierHits.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void incSecondTierMisses() {
+        numSecondTierMisses.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void incSecondTierAdmissions() {
+        numSecondTierAdmissions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    long getNumHits() {
+        return numHits;
+    }
+
+    long getNumMisses() {
+        return numMisses;
+    }
+
+    long getNumEvicted() {
+        return numEvicted;
+    }
+
+    long getNumReadAhead() {
+        return numReadAhead;
     }
 
     void print() {
@@ -52,20 +137,28 @@ public:
         std::cout << "numMisses: " << numMisses << std::endl;
         std::cout << "numEvicted: " << numEvicted << std::endl;
         std::cout << "numCached: " << numCached << std::endl;
+        std::cout << "numReadAhead: " << numReadAhead << std::endl;
+        std::cout << "numReadAheadWaits: " << numReadAheadWaits << std::endl;
+        std::cout << "numFlushWaits: " << numFlushWaits << std::endl;
+        std::cout << "numSecondTierHits: " << numSecondTierHits << std::endl;
+        std::cout << "numSecondTierMisses: " << numSecondTierMisses << std::endl;
+        std::cout << "numSecondTierAdmissions: " << numSecondTierAdmissions << std::endl;
         std::cout << "*****************" << std::endl;
     }
 
 
 private:
-    int numHits = 0;
-    int numMisses = 0;
-    int numEvicted = 0;
-    int numCached = 0;
-    pthread_mutex_t hitLock;
-    pthread_mutex_t missLock;
-    pthread_mutex_t evictedLock;
-    pthread_mutex_t cachedLock;
-
-
+    std::atomic_long numHits{0};
+    std::atomic_long numMisses{0};
+    std::atomic_long numEvicted{0};
+    std::atomic_long numCached{0};
+    std::atomic_long numReadAhead{0};
+    std::atomic_long numReadAheadWaits{0};
+    std::atomic_long numFlushWaits{0};
+    std::atomic_long numSecondTierHits{0};
+    std::atomic_long numSecondTierMisses{0};
+    std::atomic_long numSecondTierAdmissions{0};
+    std::atomic<FILE*> traceFile{nullptr};
+    pthread_mutex_t traceMutex;
 };
 #endif /* CACHESTATS_H */
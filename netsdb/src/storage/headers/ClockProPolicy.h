@@ -0,0 +1,98 @@
+#ifndef CLOCK_PRO_POLICY_H
+#define CLOCK_PRO_POLICY_H
+
+#include "PageReplacementPolicy.h"
+#include <list>
+#include <unordered_map>
+
+/**
+ * This class implements CLOCK-Pro (Jiang, Chen and Zhang, USENIX ATC 2005).
+ *
+ * Pages are kept in one clock. A page is hot if it was reused within a short reuse distance, and
+ * cold otherwise. Only cold pages are evicted, and an evicted cold page stays in the clock as a
+ * non-resident test page for a while: if it is cached again during its test period, it becomes
+ * hot, and the target number of cold pages grows, since the cold pages were too few to keep it.
+ * A test period that ends without a reuse makes the target shrink. Three hands sweep the clock:
+ * the cold hand looks for a cold page to evict and promotes referenced cold pages, the hot hand
+ * demotes unreferenced hot pages when there are more hot pages than the target allows, and the
+ * test hand ends test periods.
+ *
+ * Caching, accessing and removing a page take O(1) time, and selecting a victim takes O(1)
+ * amortized time, since each step of a hand either finds a victim or changes a page that it
+ * won't change again before it is accessed.
+ */
+class ClockProPolicy : public PageReplacementPolicy {
+
+public:
+    ClockProPolicy(size_t capacity);
+
+    ~ClockProPolicy();
+
+    void pageCached(CacheKey key) override;
+
+    void pageAccessed(CacheKey key) override;
+
+    void pageRemoved(CacheKey key) override;
+
+    bool selectVictim(const std::function<bool(const CacheKey&)>& isEvictable,
+                      CacheKey& victim) override;
+
+    size_t getNumCachedPages() override {
+        return this->numHot + this->numCold;
+    }
+
+    std::string getName() override {
+        return "CLOCK-Pro";
+    }
+
+    // the target number of cold pages
+    size_t getColdTarget() {
+        return this->coldTarget;
+    }
+
+private:
+    typedef enum { HotPage, ColdPage, TestPage } ClockPageType;
+
+    typedef struct {
+        CacheKey key;
+        ClockPageType type;
+        bool referenced;
+    } ClockEntry;
+
+    // add a page just behind the hot hand, so that it is the last page the hands reach
+    void insert(CacheKey key, ClockPageType type);
+
+    // remove a page from the clock, moving the hands that point to it
+    void erase(list<ClockEntry>::iterator it);
+
+    void advance(list<ClockEntry>::iterator& hand);
+
+    void runHandHot();
+
+    void runHandTest();
+
+    // demote hot pages until there are no more hot pages than the target allows
+    void balanceHot();
+
+    list<ClockEntry> clock;
+
+    unordered_map<CacheKey, list<ClockEntry>::iterator, CacheKeyHash, CacheKeyEqual> positions;
+
+    list<ClockEntry>::iterator handHot;
+
+    list<ClockEntry>::iterator handCold;
+
+    list<ClockEntry>::iterator handTest;
+
+    size_t capacity;
+
+    size_t coldTarget;
+
+    size_t numHot = 0;
+
+    size_t numCold = 0;
+
+    size_t numTest = 0;
+};
+
+#endif
@@ -20,6 +20,8 @@ typedef shared_ptr<DataProxy> DataProxyPtr;
  *getScanner, and closeCleaner.
  * Because multiple threads can not share one communicator, a data proxy instance can only be
  *owned/accessed by one thread.
+ * Pins and unpins of pages go through the lock-free command ring in shared memory when the
+ *frontend polls it (see SharedMemRing.h), and fall back to the communicator otherwise.
  **/
 class DataProxy {
 public:
@@ -138,6 +140,12 @@ public:
 
 
 private:
+    /**
+     * Submit a pin or unpin command through the shared-memory command ring of the frontend.
+     * Return false if the ring is not serviced or is full, so that the caller uses the socket.
+     */
+    bool submitToRing(ShmCommand& command);
+
     pdb::PDBCommunicatorPtr communicator;
     SharedMemPtr shm;
     pdb::PDBLoggerPtr logger;
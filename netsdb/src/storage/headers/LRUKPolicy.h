@@ -0,0 +1,75 @@
+#ifndef LRU_K_POLICY_H
+#define LRU_K_POLICY_H
+
+#include "PageReplacementPolicy.h"
+#include <list>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * This class implements LRU-K (O'Neil, O'Neil and Weikum, SIGMOD 1993).
+ *
+ * The victim is the page whose K-th most recent access is the oldest; pages accessed fewer than K
+ * times come first, in LRU order. A page scanned once thus never displaces a page that has been
+ * reused K times. The access history of evicted pages is retained for up to capacity pages, so
+ * that a page that comes back soon after its eviction keeps its history.
+ *
+ * Pages are ordered in a map keyed by their K-th most recent and their last access, so caching,
+ * accessing and removing a page take O(log n) time, and selecting a victim takes O(1) time
+ * unless pinned pages have to be skipped.
+ */
+class LRUKPolicy : public PageReplacementPolicy {
+
+public:
+    LRUKPolicy(size_t capacity, unsigned int k = 2);
+
+    ~LRUKPolicy();
+
+    void pageCached(CacheKey key) override;
+
+    void pageAccessed(CacheKey key) override;
+
+    void pageRemoved(CacheKey key) override;
+
+    bool selectVictim(const std::function<bool(const CacheKey&)>& isEvictable,
+                      CacheKey& victim) override;
+
+    size_t getNumCachedPages() override {
+        return this->order.size();
+    }
+
+    std::string getName() override {
+        return "LRU-" + std::to_string(this->k);
+    }
+
+private:
+    typedef struct {
+        // the last k accesses, most recent first
+        vector<long> accesses;
+        bool cached;
+        // the position in retained, if not cached
+        list<CacheKey>::iterator retainedPosition;
+    } LRUKHistory;
+
+    // the key of a page in order: its k-th most recent access (-1 if it has fewer than k), and
+    // its last access
+    pair<long, long> getOrderKey(LRUKHistory& history);
+
+    void recordAccess(LRUKHistory& history);
+
+    unsigned int k;
+
+    size_t capacity;
+
+    long clock = 0;
+
+    unordered_map<CacheKey, LRUKHistory, CacheKeyHash, CacheKeyEqual> histories;
+
+    map<pair<long, long>, CacheKey> order;
+
+    // evicted pages whose history is retained, least recently evicted first
+    list<CacheKey> retained;
+};
+
+#endif
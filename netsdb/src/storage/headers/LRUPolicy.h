@@ -0,0 +1,48 @@
+#ifndef LRU_POLICY_H
+#define LRU_POLICY_H
+
+#include "PageReplacementPolicy.h"
+#include <list>
+#include <unordered_map>
+
+/**
+ * This class implements LRU and MRU replacement.
+ * Cached pages are kept in a list ordered by their last access, and a hash map from CacheKey to
+ * the position in the list, so that caching, accessing and removing a page take O(1) time, and
+ * selecting a victim only skips the pages that are pinned or being flushed.
+ */
+class LRUPolicy : public PageReplacementPolicy {
+
+public:
+    // if mru == true, the most recently used page is evicted first
+    LRUPolicy(bool mru = false);
+
+    ~LRUPolicy();
+
+    void pageCached(CacheKey key) override;
+
+    void pageAccessed(CacheKey key) override;
+
+    void pageRemoved(CacheKey key) override;
+
+    bool selectVictim(const std::function<bool(const CacheKey&)>& isEvictable,
+                      CacheKey& victim) override;
+
+    size_t getNumCachedPages() override {
+        return this->pages.size();
+    }
+
+    std::string getName() override {
+        return this->mru ? "MRU" : "LRU";
+    }
+
+private:
+    bool mru;
+
+    // least recently used page first
+    list<CacheKey> pages;
+
+    unordered_map<CacheKey, list<CacheKey>::iterator, CacheKeyHash, CacheKeyEqual> positions;
+};
+
+#endif
@@ -4,7 +4,9 @@
 
 #include "PDBPage.h"
 #include "DataTypes.h"
+#include "PageReplacementPolicy.h"
 #include <list>
+#include <unordered_map>
 #include <vector>
 #include <memory>
 using namespace std;
@@ -14,6 +16,8 @@ typedef shared_ptr<LocalitySet> LocalitySetPtr;
 /**
  * This class implements the interfaces for LocalitySet.
  * LocalitySet defines the set locality properties, and is mainly used for PageCache eviction.
+ * The choice of the pages to evict from the set is delegated to a PageReplacementPolicy that
+ * follows the replacement policy of the set.
  */
 
 class LocalitySet {
@@ -95,6 +99,18 @@ public:
 
     void setDesiredSize (size_t size);
 
+    /*
+     * To compute the cost of evicting the page that the set would evict next, as the write cost
+     * of the set plus the read cost weighted by the probability that the page is reused, which
+     * is estimated from its reference distance. The cost is kept for getEvictionCost(), so that
+     * sets can be ordered without selecting their victims again.
+     */
+    double computeEvictionCost();
+
+    double getEvictionCost() {
+        return this->evictionCost;
+    }
+
     /**
      * Get number of cached pages.
      */
@@ -153,11 +169,21 @@ public:
     }
 
 protected:
+    /*
+     * To replace the replacement policy of the set, handing the cached pages over to the new
+     * policy in the order of their last access. The caller must hold localitySetCacheMutex.
+     */
+    void rebuildPolicy();
+
+    /**
+     * Cached pages in the set
+     */
+    unordered_map<CacheKey, PDBPagePtr, CacheKeyHash, CacheKeyEqual>* cachedPages;
+
     /**
-     * Cached pages in the set, ordered by access sequenceId;
-     * So pop_front for LRU, pop_back for MRU
+     * Selects the cached pages to evict, guarded by localitySetCacheMutex
      */
-    list<PDBPagePtr>* cachedPages;
+    PageReplacementPolicyPtr policy;
 
 
     /*
@@ -175,7 +201,10 @@ protected:
      * Replacement policy in the set:
      * 1. LRU
      * 2. MRU
-     * 3. Random
+     * 3. Random (served by LRU)
+     * 4. ARC
+     * 5. ClockPro
+     * 6. LRUK
      *
      * This property should be set at construction time, and can be modified at pin time.
      */
@@ -229,6 +258,7 @@ protected:
 
     double writeCost = 0.0;
     double readCost = 0.0;
+    double evictionCost = 0.0;
     long accessSequenceId = 0;
 
     bool isShared = false;
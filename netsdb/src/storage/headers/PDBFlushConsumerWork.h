@@ -5,12 +5,16 @@
 #include "PDBWork.h"
 #include "PangeaStorageServer.h"
 #include <memory>
+#include <vector>
 using namespace std;
 class PDBFlushConsumerWork;
 typedef shared_ptr<PDBFlushConsumerWork> PDBFlushConsumerWorkPtr;
 
 
-//this class flushes pages to disk
+// this class flushes pages to disk: there is one instance for each data partition, which is the
+// only writer of that partition. it pops a batch of dirty pages from the flush buffer at a time,
+// and appends the pages of each set in the batch with one vectored write, and then writes the
+// meta partition of the set once for all of them
 
 class PDBFlushConsumerWork : public pdb::PDBWork {
 public:
@@ -20,9 +24,13 @@ public:
     void stop();
 
 private:
+    // append the pages of one set, sorted by page id, to the partition
+    void flushBatch(vector<PDBPagePtr>& batch);
+
     pdb::PangeaStorageServer* server;
     FilePartitionID partitionId;
     bool isStopped;
+    unsigned int batchSize;
 };
 
 
@@ -213,6 +213,20 @@ void * addRemainBytes(size_t& size) {
         return retPos;
     }
 
+    /**
+     * Gives back the area of the last addVariableBytes() with the given size, e.g. when it could
+     * not be filled.
+     */
+    inline void removeLastVariableBytes(size_t size) {
+        this->curAppendOffset -= size + sizeof(size_t);
+        pthread_mutex_lock(&this->refCountMutex);
+        char* refCountBytes =
+            this->rawBytes + (sizeof(NodeID) + sizeof(DatabaseID) + sizeof(UserTypeID) +
+                              sizeof(SetID) + sizeof(PageID));
+        *((int*)refCountBytes) = *((int*)refCountBytes) - 1;
+        pthread_mutex_unlock(&this->refCountMutex);
+    }
+
 
     /*****To Comply with Chris' interfaces******/
 
@@ -0,0 +1,30 @@
+#ifndef PDBREADAHEADWORK_H
+#define PDBREADAHEADWORK_H
+
+#include <memory>
+using namespace std;
+class PDBReadAheadWork;
+typedef shared_ptr<PDBReadAheadWork> PDBReadAheadWorkPtr;
+
+#include "PDBWork.h"
+#include "PDBBuzzer.h"
+#include "PageCache.h"
+#include "PageReadAheadQueue.h"
+
+/**
+ * This class implements an I/O thread that loads pages requested by sequential scans into the
+ * page cache ahead of time, until the read-ahead queue is closed.
+ */
+class PDBReadAheadWork : public pdb::PDBWork {
+public:
+    PDBReadAheadWork(PageCache* cache, PageReadAheadQueuePtr queue);
+    ~PDBReadAheadWork();
+
+    // do the actual work.
+    void execute(PDBBuzzerPtr callerBuzzer) override;
+
+private:
+    PageCache* cache;
+    PageReadAheadQueuePtr queue;
+};
+#endif /* PDBREADAHEADWORK_H */
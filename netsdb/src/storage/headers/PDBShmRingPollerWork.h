@@ -0,0 +1,28 @@
+#ifndef PDBSHMRINGPOLLERWORK_H
+#define PDBSHMRINGPOLLERWORK_H
+
+#include "PDBWork.h"
+#include "PangeaStorageServer.h"
+#include "SharedMemRing.h"
+#include <memory>
+using namespace std;
+class PDBShmRingPollerWork;
+typedef shared_ptr<PDBShmRingPollerWork> PDBShmRingPollerWorkPtr;
+
+/**
+ * This class implements a frontend thread that runs the pins and unpins that the backend submits
+ * through the shared-memory command ring, until the ring is no longer serviced.
+ */
+class PDBShmRingPollerWork : public pdb::PDBWork {
+public:
+    PDBShmRingPollerWork(SharedMemRingPtr ring, pdb::PangeaStorageServer* server);
+    ~PDBShmRingPollerWork();
+
+    // do the actual work.
+    void execute(PDBBuzzerPtr callerBuzzer) override;
+
+private:
+    SharedMemRingPtr ring;
+    pdb::PangeaStorageServer* server;
+};
+#endif /* PDBSHMRINGPOLLERWORK_H */
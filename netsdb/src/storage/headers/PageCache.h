@@ -14,14 +14,23 @@
 #include "SharedMem.h"
 #include "PageCircularBuffer.h"
 #include "LocalitySet.h"
+#include "PageReplacementPolicy.h"
+#include "SecondTierCache.h"
 #include <unordered_map>
+#include <list>
 #include <memory>
 #include <queue>
+#include <vector>
+#include <atomic>
 using namespace std;
 
 class PageCache;
 typedef shared_ptr<PageCache> PageCachePtr;
 
+class PageReadAheadQueue;
+typedef shared_ptr<PageReadAheadQueue> PageReadAheadQueuePtr;
+struct ReadAheadRequest;
+
 /**
  * How many cache policies we want to support?
  *
@@ -41,64 +50,50 @@ typedef shared_ptr<PageCache> PageCachePtr;
 
 
 /**
- * Hash function for CacheKey, used for caching and retrieving a page.
+ * One partition of the page cache.
+ * Each cached page belongs to exactly one shard, selected by hashing its CacheKey. A shard has its
+ * own hash map, its own mutex guarding the map, and its own eviction/flush rwlock, so that
+ * threads pinning, unpinning, flushing or evicting pages of different shards never contend.
+ *
+ * Lock order: evictionAndFlushLock is always acquired before cacheMutex, and a thread holds the
+ * locks of at most one shard at a time unless it locks all shards in index order through
+ * PageCache::evictionLock(). PageCache::readAheadMutex is only acquired after the shard locks.
+ *
+ * Unless the cache evicts through LocalitySets, each shard also has its own replacement policy,
+ * which tracks the pages of the shard and is guarded by cacheMutex.
  */
+struct PageCacheShard {
 
-struct CacheKeyHash {
-
-    std::size_t operator()(const CacheKey& key) const {
-        return (key.dbId << 24) + (key.typeId << 16) + (key.setId << 8) + key.pageId;
+    PageCacheShard() {
+        pthread_mutex_init(&cacheMutex, nullptr);
+        pthread_rwlock_init(&evictionAndFlushLock, nullptr);
     }
-};
 
-/**
- * Comparator for CacheKey, used for caching and retrieving a page.
- */
+    ~PageCacheShard() {
+        pthread_mutex_destroy(&cacheMutex);
+        pthread_rwlock_destroy(&evictionAndFlushLock);
+    }
 
-struct CacheKeyEqual {
+    // the pages cached in this shard
+    unordered_map<CacheKey, PDBPagePtr, CacheKeyHash, CacheKeyEqual> pages;
 
-    bool operator()(const CacheKey& lKey, const CacheKey& rKey) const {
-        if ((lKey.dbId == rKey.dbId) && (lKey.typeId == rKey.typeId) &&
-            (lKey.setId == rKey.setId) && (lKey.pageId == rKey.pageId)) {
-            return true;
-        } else {
-            return false;
-        }
-    }
-};
+    // guards pages
+    pthread_mutex_t cacheMutex;
 
-/**
- * Comparator for the last access time of two cached pages, used for eviction.
- */
-struct CompareCachedPages {
-
-    bool operator()(PDBPagePtr& lPage, PDBPagePtr& rPage) {
-        if (lPage->getAccessSequenceId() < rPage->getAccessSequenceId()) {
-            return false;
-        } else {
-            return true;
-        }
-    }
-};
+    // write-locked to pin or evict a page of this shard, read-locked when flushing a page
+    pthread_rwlock_t evictionAndFlushLock;
 
-/**
- * Comparator for the last access time of two cached pages, used for eviction.
- */
-struct CompareCachedPagesMRU {
-
-    bool operator()(PDBPagePtr& lPage, PDBPagePtr& rPage) {
-        if (lPage->getAccessSequenceId() > rPage->getAccessSequenceId()) {
-            return false;
-        } else {
-            return true;
-        }
-    }
+    // selects the pages of this shard to evict, nullptr if the cache evicts through LocalitySets
+    PageReplacementPolicyPtr policy = nullptr;
 };
 
-
 /**
  * This class wraps a global page cache adopting multiple eviction policy, and by default it uses
  * MRU.
+ * UnifiedLRU, UnifiedMRU, UnifiedARC, UnifiedClockPro and UnifiedLRUK evict the pages selected by
+ * the PageReplacementPolicy of each shard, visiting the shards in round robin, while UnifiedCost,
+ * UnifiedIntelligent and UnifiedDBMIN select LocalitySets first, which delegate the choice of
+ * their pages to their own PageReplacementPolicy.
  * Each slave node will have one page cache that
  * can be accessed by frontend and forked backend via shared memory.
  *
@@ -117,6 +112,9 @@ struct CompareCachedPagesMRU {
  * disk file, and needs to load it to cache first)
  * Step 5. Backend will tell frontend to unpin the page;
  * Step 6. Backend will tell frontend to remove a temp set.
+ *
+ * The cache is partitioned into PageCacheShard instances (see Configuration::getNumCacheShards()),
+ * and pin/unpin/evict/flush of a page only lock the shard that owns the page.
  */
 class PageCache {
 
@@ -148,7 +146,9 @@ public:
     // This function can also be used for backend to pin a flushed page that has been pinned and
     // unpinned before by the same backend.
     // It can be applied to all PDBFile instances.
-    // If sequential==true, we will invoke file's sequential read API that will not `seek` first.
+    // If sequential==true, the scan is expected to pin the following pages of the partition next,
+    // so the next Configuration::getReadAheadWindow() pages are loaded in background, and a
+    // page that is being loaded in background is waited for instead of being read again.
     PDBPagePtr getPage(PartitionedFilePtr file,
                        FilePartitionID partitionId,
                        unsigned int pageSeqInPartition,
@@ -217,29 +217,73 @@ public:
 
     // Load page specified from disk file to cache.
     // This function can be applied to all PDBFile instances.
-    // If sequential=true, we will invoke file's sequential read API if the file instance has
-    // provided such API.
+    // If sequential=true, we will invoke file's positional read API if the file instance has
+    // provided such API, so that the load does not race with the read-ahead threads.
     PDBPagePtr loadPage(PDBFilePtr file,
                         FilePartitionID partitionId,
                         unsigned int pageSeqInPartition,
                         bool sequential);
 
+    // Restore the page from the second cache tier into shared memory, if the tier is enabled and
+    // holds the page. Return nullptr otherwise.
+    PDBPagePtr loadPageFromSecondTier(PartitionedFilePtr file,
+                                      CacheKey key,
+                                      FilePartitionID partitionId,
+                                      unsigned int pageSeqInPartition);
+
+    // Drop the pages of a removed set from the second cache tier.
+    void invalidateSecondTier(DatabaseID dbId, UserTypeID typeId, SetID setId);
+
+    // Start the read-ahead threads, if read-ahead is enabled.
+    void startReadAheadThreads();
+
+    // Stop the read-ahead threads.
+    void stopReadAheadThreads();
+
+    // Queue the pages following pageSeqInPartition in the partition for read-ahead.
+    void scheduleReadAhead(PartitionedFilePtr file,
+                           FilePartitionID partitionId,
+                           unsigned int pageSeqInPartition);
+
+    // Load the requested page and cache it as an unpinned clean page.
+    // The page is skipped if it is cached already, or if it can not be loaded without eviction.
+    // This function is used by the read-ahead threads.
+    bool loadPageForReadAhead(ReadAheadRequest& request);
+
     // Remove page specified by Key from cache hashMap.
     // This function will be used by the flushConsumer thread.
     bool removePage(CacheKey key);
     bool freePage(PDBPagePtr page);
-    // Lock for eviction.
+    // Lock for eviction on all shards, in shard order.
     void evictionLock();
 
-    // Unlock for eviction.
+    // Unlock for eviction on all shards.
     void evictionUnlock();
 
-    // Lock for flushing.
+    // Lock for eviction on the shard that owns the page.
+    void evictionLock(CacheKey key);
+
+    // Unlock for eviction on the shard that owns the page.
+    void evictionUnlock(CacheKey key);
+
+    // Lock for flushing on all shards.
     void flushLock();
 
-    // Unlock for flushing.
+    // Unlock for flushing on all shards.
     void flushUnlock();
 
+    // Lock for flushing on the shard that owns the page.
+    void flushLock(CacheKey key);
+
+    // Unlock for flushing on the shard that owns the page.
+    void flushUnlock(CacheKey key);
+
+    // Lock for flushing on the shards that own the pages, once per shard and in shard order.
+    void flushLock(const vector<CacheKey>& keys);
+
+    // Unlock for flushing on the shards that own the pages.
+    void flushUnlock(const vector<CacheKey>& keys);
+
     // Lock for evictionMutex
     void evictionMutexLock() {
        pthread_mutex_lock(&this->evictionMutex);
@@ -254,8 +298,12 @@ public:
     bool flushPageWithoutEviction(CacheKey key);
 
     // Allocate buffer of required size from shared memory, if no room, block and run eviction
-    // thread.
-    char* allocateBufferFromSharedMemoryBlocking(size_t size, int& alignOffset);
+    // thread. If throttle is true, first block while the flush buffer is deeper than the
+    // back-pressure depth, so that writers of new pages slow down to the pace of the flushing
+    // threads, and leave the memory freed by eviction to readers.
+    char* allocateBufferFromSharedMemoryBlocking(size_t size,
+                                                 int& alignOffset,
+                                                 bool throttle = false);
 
     // TODO: Allocate buffer of required size from shared memory, if no room, block and evict only
     // one page.
@@ -306,27 +354,94 @@ public:
 
     void printStats() {
         this->stats.print();
+        this->shm->printStats();
     }
 
+    // Get the number of shards the cache is partitioned into
+    unsigned int getNumShards() {
+        return this->numShards;
+    }
+
+    // Get the hit/miss/eviction counters of the cache
+    CacheStats& getStats() {
+        return this->stats;
+    }
+
+    // Get the number of read-ahead pages that are cached and have not been pinned by a scan yet
+    size_t getNumUnclaimedReadAheadPages();
+
 
 private:
-    long accessCount;
-    unordered_map<CacheKey, PDBPagePtr, CacheKeyHash, CacheKeyEqual>* cache;
+    // Return the index of the shard that owns the page specified by the cache key.
+    unsigned int getShardIndex(CacheKey key);
+
+    // Return the shard that owns the page specified by the cache key.
+    PageCacheShard& getShard(CacheKey key);
+
+    // Return the indexes of the shards that own the pages, in ascending order without duplicates.
+    vector<unsigned int> getShardIndexes(const vector<CacheKey>& keys);
+
+    // Check whether the page is in the shard, the caller must hold the shard's cacheMutex.
+    bool containsPageInShard(PageCacheShard& shard, CacheKey key);
+
+    // Read the page from the second cache tier into pageData, and count the hit or miss.
+    bool readFromSecondTier(CacheKey key, char* pageData, size_t pageSize);
+
+    // Remove the page from the unclaimed read-ahead pages, return true if it was one of them.
+    // The caller must hold the shard's evictionAndFlushLock or cacheMutex, so that the page is
+    // claimed atomically with the reference count increment of the pin that claims it.
+    bool claimReadAheadPage(CacheKey key);
+
+    // Evict the unclaimed read-ahead pages, oldest first, until the cache is below
+    // evictStopSize, but at least one page if there is any; return the number of evicted pages.
+    // The caller must hold evictionMutex.
+    int evictUnclaimedReadAheadPages();
+
+    // Evict the page if it is still an unclaimed read-ahead page, and is not pinned.
+    bool evictUnclaimedReadAheadPage(CacheKey key);
+
+    // Offer a clean page that is evicted to the second cache tier.
+    void admitToSecondTier(CacheKey key, PDBPagePtr page, char* pageData, size_t pageSize);
+
+    // Evict pages selected by the replacement policies of the shards until the cache is below
+    // evictStopSize, the caller must hold evictionMutex.
+    void evictWithPolicies();
+
+    // Return the next access sequence id.
+    long nextAccessSequenceId() {
+        return this->accessCount.fetch_add(1);
+    }
+
+    std::atomic_long accessCount;
+    unsigned int numShards;
+    vector<PageCacheShard*> shards;
     pdb::PDBLoggerPtr logger;
     ConfigurationPtr conf;
-    size_t size;
+    std::atomic<size_t> size;
     size_t maxSize;
     size_t warnSize;       // the threshold to evict
     size_t evictStopSize;  // the threshold to stop eviction
-    pthread_rwlock_t evictionAndFlushLock;
-    pthread_mutex_t cacheMutex;
+    // only one thread runs eviction at a time; readers do not take this lock
     pthread_mutex_t evictionMutex;
     bool inEviction;
     pdb::PDBWorkerQueuePtr workers;
     pdb::PDBWorkPtr evictWork;
-    pthread_mutex_t countLock;
     SharedMemPtr shm;
     PageCircularBufferPtr flushBuffer;
+    // new pages wait while the flush buffer holds at least this many pages, 0 if disabled
+    unsigned int flushBackPressureDepth;
+    // number of pages to read ahead of a sequential scan, 0 if read-ahead is disabled
+    unsigned int readAheadWindow;
+    PageReadAheadQueuePtr readAheadQueue;
+    unsigned int numReadAheadThreads;
+    // the read-ahead pages that no scan has pinned yet, oldest first, and the position of each
+    // page in the list; these pages belong to no LocalitySet, so UnifiedCost,
+    // UnifiedIntelligent and UnifiedDBMIN evict them before asking the LocalitySets
+    list<CacheKey> unclaimedReadAheadPages;
+    unordered_map<CacheKey, list<CacheKey>::iterator, CacheKeyHash, CacheKeyEqual>
+        unclaimedReadAheadIndex;
+    // guards unclaimedReadAheadPages and unclaimedReadAheadIndex
+    pthread_mutex_t readAheadMutex;
     /*
      * index = 0, TransientLifetimeEnded
      * index = 1, PersistentLifetimeEnded
@@ -337,39 +452,24 @@ private:
      */
     vector<list<LocalitySetPtr>*>* priorityList;
     CacheStats stats;
+    // the cache of evicted clean pages on a fast local device, nullptr if disabled
+    SecondTierCachePtr secondTier;
+    // the shard that evictWithPolicies() visits first
+    unsigned int nextEvictionShard = 0;
 };
 
 
 
 /**
- * Comparator for the cost of two locality sets, used for eviction.
+ * Comparator for the cost of two locality sets, used for eviction; the cost of each set must have
+ * been computed by LocalitySet::computeEvictionCost() before the sets are compared.
  */
 struct CompareLocalitySets {
 
+   // a strict ordering, so that sets of the same cost are equivalent, as the heap of the
+   // eviction requires
    bool operator()(LocalitySetPtr& lSet, LocalitySetPtr& rSet) {
-       PDBPagePtr pageToEvictFromLSet = lSet->selectPageForReplacement();
-       if (pageToEvictFromLSet == nullptr) {
-           return false;
-       }
-       long lSetAccessSequenceId = pageToEvictFromLSet->getAccessSequenceId();
-       PDBPagePtr pageToEvictFromRSet = rSet->selectPageForReplacement();
-       if (pageToEvictFromRSet == nullptr) {
-           return false;
-       }
-       long rSetAccessSequenceId = pageToEvictFromRSet->getAccessSequenceId();
-       double lWriteCost = (lSet->getWriteCost());
-       double lReuseProb = (double)(1)/(double)(lSet->getReferenceDistance(lSetAccessSequenceId));
-       double lReadCost = (lSet->getReadCost());
-       double evictCostForLSet = lWriteCost + lReuseProb*lReadCost;
-       double rWriteCost = (rSet->getWriteCost());
-       double rReuseProb = (double)(1)/(double)(rSet->getReferenceDistance(rSetAccessSequenceId));
-       double rReadCost = (rSet->getReadCost());
-       double evictCostForRSet = rWriteCost + rReuseProb*rReadCost;
-       if (evictCostForLSet < evictCostForRSet) {
-           return false;
-       } else {
-           return true;
-       }
+       return lSet->getEvictionCost() > rSet->getEvictionCost();
    }
 };
 
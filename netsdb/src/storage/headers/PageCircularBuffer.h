@@ -6,6 +6,7 @@
 #include "PDBLogger.h"
 #include <pthread.h>
 #include <memory>
+#include <vector>
 using namespace std;
 class PageCircularBuffer;
 typedef shared_ptr<PageCircularBuffer> PageCircularBufferPtr;
@@ -36,6 +37,20 @@ public:
      */
     PDBPagePtr popPageFromHead();
 
+    /**
+     * Pop up to maxPages pages from the head of the circular buffer to pages, in FIFO order.
+     * If the buffer is empty, it will block until there is new page added to the buffer,
+     * or until the buffer is closed.
+     * Return the number of pages popped, which is 0 only if the buffer is empty and closed.
+     */
+    unsigned int popPagesFromHead(std::vector<PDBPagePtr>& pages, unsigned int maxPages);
+
+    /**
+     * Block until fewer than depth pages are in the buffer, or until the buffer is closed.
+     * Return true if it had to wait.
+     */
+    bool waitUntilBelow(unsigned int depth);
+
     /**
      * If the buffer is full, return true, otherwise, return false.
      */
@@ -51,6 +66,13 @@ public:
      */
     unsigned int getSize();
 
+    /**
+     * Return the maximum number of pages in the circular buffer.
+     */
+    unsigned int getCapacity() {
+        return maxArraySize - 1;
+    }
+
     /**
      * Close the buffer.
      * If the buffer is empty now, notify all consumer threads that the buffer is closed.
@@ -111,8 +133,10 @@ private:
     unsigned int pageArrayHead;
     unsigned int pageArrayTail;
     pthread_mutex_t mutex;
-    pthread_mutex_t addPageMutex;
+    // signaled when pages are added, to wake up consumers
     pthread_cond_t cond;
+    // signaled when pages are popped, to wake up producers
+    pthread_cond_t spaceCond;
     bool closed;
 };
 
@@ -0,0 +1,61 @@
+#ifndef PAGECOMPRESSOR_H
+#define PAGECOMPRESSOR_H
+
+#include "DataTypes.h"
+#include <stdlib.h>
+
+/**
+ * This class wraps the codecs that can be used to store pages of a PartitionedFile on disk.
+ *
+ * Snappy is always available, because it is linked for network payloads anyway.
+ * LZ4 is available if the tree is built with -DENABLE_LZ4 and linked with -llz4, and Zstd is
+ * available if the tree is built with -DENABLE_ZSTD and linked with -lzstd.
+ * Pages of a set configured with an unavailable codec are stored uncompressed.
+ */
+class PageCompressor {
+public:
+    /**
+     * Return true if the codec is compiled in.
+     */
+    static bool isAvailable(PageCompressionType type);
+
+    /**
+     * Return the name of the codec.
+     */
+    static const char* getName(PageCompressionType type);
+
+    /**
+     * Return the maximum size of compressing srcLength bytes with the codec.
+     */
+    static size_t getMaxCompressedLength(PageCompressionType type, size_t srcLength);
+
+    /**
+     * Compress srcLength bytes from src to dest, which must have getMaxCompressedLength() bytes.
+     * Return the compressed size, or 0 if the codec is not available or the compression failed.
+     */
+    static size_t compress(PageCompressionType type,
+                           const char* src,
+                           size_t srcLength,
+                           char* dest);
+
+    /**
+     * Compress as above, with the given level if the codec has levels (Zstd).
+     */
+    static size_t compress(PageCompressionType type,
+                           const char* src,
+                           size_t srcLength,
+                           char* dest,
+                           int level);
+
+    /**
+     * Decompress srcLength bytes from src to dest, which has destLength bytes.
+     * Return the decompressed size, or (size_t)(-1) on failure.
+     */
+    static size_t decompress(PageCompressionType type,
+                             const char* src,
+                             size_t srcLength,
+                             char* dest,
+                             size_t destLength);
+};
+
+#endif /* PAGECOMPRESSOR_H */
@@ -0,0 +1,86 @@
+
+#ifndef PAGEREADAHEADQUEUE_H
+#define PAGEREADAHEADQUEUE_H
+
+#include "PageCache.h"
+#include "PartitionedFile.h"
+#include "DataTypes.h"
+#include <pthread.h>
+#include <deque>
+#include <unordered_set>
+#include <memory>
+using namespace std;
+class PageReadAheadQueue;
+typedef shared_ptr<PageReadAheadQueue> PageReadAheadQueuePtr;
+
+/**
+ * A page that a sequential scan is expected to pin soon, and that should be loaded into the
+ * page cache in background.
+ */
+struct ReadAheadRequest {
+    PartitionedFilePtr file;
+    FilePartitionID partitionId;
+    unsigned int pageSeqInPartition;
+    CacheKey key;
+};
+
+/**
+ * This class implements a concurrent blocking queue of read-ahead requests.
+ * Scan threads add requests without blocking; if the queue is full, or the page is already
+ * queued or being loaded, the request is dropped.
+ * Read-ahead threads wait until there are requests available, and mark each request as completed
+ * after the page has been loaded and cached.
+ * A scan thread that misses a page that is being loaded can wait for the load to complete instead
+ * of reading the same page a second time.
+ */
+class PageReadAheadQueue {
+public:
+    PageReadAheadQueue(unsigned int maxNumRequests);
+    ~PageReadAheadQueue();
+
+    /**
+     * Add a request to the tail of the queue.
+     * Return false if the request is dropped.
+     */
+    bool addRequest(const ReadAheadRequest& request);
+
+    /**
+     * Pop a request from the head of the queue, and mark the page as in flight.
+     * If the queue is empty, it will block until there is new request, or until the queue is
+     * closed. Return false if the queue is closed.
+     */
+    bool getRequest(ReadAheadRequest& request);
+
+    /**
+     * Mark the page as loaded, and wake up the threads waiting for it.
+     */
+    void completeRequest(CacheKey key);
+
+    /**
+     * If the page is queued or in flight, block until it has been loaded and return true,
+     * otherwise return false immediately.
+     * A queued page that is not yet in flight is withdrawn from the queue, so that the caller
+     * loads it itself.
+     */
+    bool waitForPage(CacheKey key);
+
+    /**
+     * Close the queue, and wake up all waiting threads.
+     */
+    void close();
+
+private:
+    unsigned int maxNumRequests;
+    deque<ReadAheadRequest> requests;
+    // pages that are queued
+    unordered_set<CacheKey, CacheKeyHash, CacheKeyEqual> queuedPages;
+    // pages that are being loaded by read-ahead threads
+    unordered_set<CacheKey, CacheKeyHash, CacheKeyEqual> inFlightPages;
+    pthread_mutex_t queueMutex;
+    pthread_cond_t requestCond;
+    pthread_cond_t completeCond;
+    bool isClosed;
+};
+
+
+#endif /* PAGEREADAHEADQUEUE_H */
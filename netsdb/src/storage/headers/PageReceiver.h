@@ -0,0 +1,154 @@
+#ifndef PAGERECEIVER_H
+#define PAGERECEIVER_H
+
+#include "PDBCommunicator.h"
+#include "PDBPage.h"
+#include "UserSet.h"
+#include "DataTypes.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * The counters of the pages that this process receives from other nodes to store them.
+ * A byte is copied when it is written again after it is read from the socket, by memcpy or by
+ * decompression; a page that is received directly to its storage page is not copied at all, and
+ * a compressed page is copied once, when it is decompressed to its storage page.
+ */
+class PageReceiveCounters {
+public:
+    std::atomic<size_t> numPages{0};
+
+    // the bytes that are read from the sockets, which are compressed if the pages are
+    std::atomic<size_t> numBytesReceived{0};
+
+    // the number of times that a page is copied, and the bytes that are written by those copies
+    std::atomic<size_t> numCopies{0};
+
+    std::atomic<size_t> numBytesCopied{0};
+
+    // the number of buffers that are allocated from the heap to receive pages
+    std::atomic<size_t> numBufferAllocations{0};
+
+    void addPage(size_t numBytes) {
+        numPages++;
+        numBytesReceived += numBytes;
+    }
+
+    void addCopy(size_t numBytes) {
+        numCopies++;
+        numBytesCopied += numBytes;
+    }
+
+    /**
+     * Return the average number of copies of a page after it is received.
+     */
+    double getCopiesPerPage() const;
+
+    std::string toString() const;
+};
+
+/**
+ * Return the counters of this process.
+ */
+PageReceiveCounters& getPageReceiveCounters();
+
+// the largest receive buffer that a thread keeps for its next pages after it releases its buffers
+#ifndef MAX_KEPT_RECEIVE_BUFFER_SIZE
+#define MAX_KEPT_RECEIVE_BUFFER_SIZE ((size_t)(16) * (size_t)(1024) * (size_t)(1024))
+#endif
+
+/**
+ * Return a buffer of at least size bytes that belongs to the calling thread, and is reused by the
+ * next call of the thread, to receive a page that is not received to its storage page.
+ */
+char* getThreadReceiveBuffer(size_t size);
+
+/**
+ * Return another buffer of at least size bytes that belongs to the calling thread, to decompress
+ * a page that is received to the buffer of getThreadReceiveBuffer() but is not stored.
+ */
+char* getThreadDecompressBuffer(size_t size);
+
+/**
+ * Free the buffers of the calling thread that are larger than MAX_KEPT_RECEIVE_BUFFER_SIZE, so
+ * that a thread that once received a large page doesn't hold the memory for good. It is called
+ * when the thread no longer uses its buffers.
+ */
+void releaseThreadReceiveBuffers();
+
+/**
+ * This class receives the pages of a StorageAddObjectInLoop loop, i.e. the pages that are sent
+ * with PDBCommunicator::sendBytes() on one connection, to a set.
+ * Each page is stored as variable bytes on a page of the set that only this receiver fills, so
+ * an uncompressed page is read from the socket directly to where it is stored, without holding
+ * the lock of the set while the bytes arrive. A compressed page is read to a buffer that is
+ * reused for all pages, and decompressed to where it is stored. Each page may be compressed with
+ * another codec, which the request of the page tells.
+ * receive() only reads the page, so that it can be acknowledged before store() decompresses it.
+ */
+class PageReceiver {
+public:
+    /**
+     * set is the set to store the pages to, or nullptr if the pages are only to be read.
+     */
+    PageReceiver(SetPtr set);
+
+    /**
+     * Unpins the page that the last pages are stored to.
+     */
+    ~PageReceiver();
+
+    /**
+     * Read the next page from the connection, which is compressed with codec from
+     * uncompressedSize bytes (0 if it is not known). Return false and set errMsg if it can't be
+     * read.
+     */
+    bool receive(pdb::PDBCommunicatorPtr from,
+                 PageCompressionType codec,
+                 size_t uncompressedSize,
+                 std::string& errMsg);
+
+    /**
+     * Store the page that is received last, and return where its bytes are stored; return nullptr
+     * and set errMsg if there is no set, or the page doesn't fit in a page of the set.
+     */
+    void* store(std::string& errMsg);
+
+    /**
+     * Unpin the page that the last pages are stored to, so that it can be flushed.
+     */
+    void finish();
+
+    /**
+     * Return the size of the page that is stored last.
+     */
+    size_t getSizeOfLastPage();
+
+private:
+    SetPtr set;
+
+    // the codec of the last page, and its size before compression if it is known
+    PageCompressionType codec = NoPageCompression;
+    size_t uncompressedSize = 0;
+
+    // the page of the set that the pages are stored to
+    PDBPagePtr page = nullptr;
+
+    // the bytes of the last page: where they are stored if they are received directly to the
+    // page, otherwise the compressed bytes, or the bytes that can't be stored
+    char* bytes = nullptr;
+    size_t numBytes = 0;
+    bool storedAlready = false;
+
+    // the size of the last page after decompression
+    size_t sizeOfLastPage = 0;
+
+    // the buffer that the pages are read to, if they are not read to the page of the set
+    std::vector<char> buffer;
+};
+
+typedef std::shared_ptr<PageReceiver> PageReceiverPtr;
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef PAGE_REPLACEMENT_POLICY_H
+#define PAGE_REPLACEMENT_POLICY_H
+
+#include "DataTypes.h"
+#include <functional>
+#include <memory>
+#include <string>
+using namespace std;
+
+/**
+ * Hash function for CacheKey, used for caching and retrieving a page.
+ */
+
+struct CacheKeyHash {
+
+    std::size_t operator()(const CacheKey& key) const {
+        return (key.dbId << 24) + (key.typeId << 16) + (key.setId << 8) + key.pageId;
+    }
+};
+
+/**
+ * Comparator for CacheKey, used for caching and retrieving a page.
+ */
+
+struct CacheKeyEqual {
+
+    bool operator()(const CacheKey& lKey, const CacheKey& rKey) const {
+        if ((lKey.dbId == rKey.dbId) && (lKey.typeId == rKey.typeId) &&
+            (lKey.setId == rKey.setId) && (lKey.pageId == rKey.pageId)) {
+            return true;
+        } else {
+            return false;
+        }
+    }
+};
+
+class PageReplacementPolicy;
+typedef shared_ptr<PageReplacementPolicy> PageReplacementPolicyPtr;
+
+/**
+ * This class defines the interface of a page replacement policy, which PageCache (for each of its
+ * shards) and LocalitySet delegate the choice of the page to evict to.
+ *
+ * A policy only tracks CacheKeys, and is told about every page that enters the cache, every
+ * access to a cached page, and every page that leaves the cache. It never evicts a page by
+ * itself: the cache asks it for a victim, and tells it with pageRemoved() once the victim has
+ * actually been evicted. This way a policy can also be replayed against a recorded trace without
+ * a cache (see CacheTraceReplay.cc).
+ *
+ * Policies are not thread-safe; the caller must guard each policy instance with its own lock.
+ *
+ * The capacity of a policy is the number of pages it expects the cache to hold, which sizes the
+ * history that adaptive policies keep for evicted pages. Since the cache is bounded by bytes and
+ * not by pages, the capacity grows to the largest number of cached pages seen.
+ */
+class PageReplacementPolicy {
+
+public:
+    virtual ~PageReplacementPolicy() {}
+
+    // a page enters the cache; the policy may remember that it evicted the page recently
+    virtual void pageCached(CacheKey key) = 0;
+
+    // a cached page is accessed again
+    virtual void pageAccessed(CacheKey key) = 0;
+
+    // a page leaves the cache, either because it was evicted or because its set was removed
+    virtual void pageRemoved(CacheKey key) = 0;
+
+    // select the next page to evict among the cached pages for which isEvictable returns true,
+    // without removing it; return false if there is no such page
+    virtual bool selectVictim(const std::function<bool(const CacheKey&)>& isEvictable,
+                              CacheKey& victim) = 0;
+
+    // return the number of cached pages tracked by the policy
+    virtual size_t getNumCachedPages() = 0;
+
+    // return the name of the policy
+    virtual std::string getName() = 0;
+
+    // create a policy; Random is served by LRU, as LocalitySet always did
+    static PageReplacementPolicyPtr create(LocalitySetReplacementPolicy type, size_t capacity);
+
+    // create the policy used by each shard of a PageCache with the given strategy, or nullptr if
+    // the strategy evicts through LocalitySets instead
+    static PageReplacementPolicyPtr create(CacheStrategy strategy, size_t capacity);
+};
+
+#endif
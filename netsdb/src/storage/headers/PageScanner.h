@@ -14,6 +14,7 @@
 #include "SharedMem.h"
 #include "DataTypes.h"
 #include "StoragePagePinned.h"
+#include "PageZoneMap.h"
 #include <string.h>
 #include <pthread.h>
 #include <memory>
@@ -48,11 +49,15 @@ public:
      * Obtain a set of iterators given the specified set information and number of threads.
      * Each iterator work as a consumer, retrieving a page from the concurrent blocking buffer,
      * each time when next() is invoked.
+     * If zoneMapPredicate is not nullptr, the frontend skips pages whose zone maps can't satisfy
+     * the predicate.
      */
-    vector<PageCircularBufferIteratorPtr> getSetIterators(NodeID nodeId,
-                                                          DatabaseID dbId,
-                                                          UserTypeID typeId,
-                                                          SetID setId);
+    vector<PageCircularBufferIteratorPtr> getSetIterators(
+        NodeID nodeId,
+        DatabaseID dbId,
+        UserTypeID typeId,
+        SetID setId,
+        const ZoneMapPredicate* zoneMapPredicate = nullptr);
 
     /**
      * To receive PagePinned objects from frontend.
@@ -0,0 +1,84 @@
+#ifndef PAGEZONEMAP_H
+#define PAGEZONEMAP_H
+
+#include "DataTypes.h"
+#include "PDBPage.h"
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+/**
+ * An attribute declared by the user to be summarized in the zone maps of a set.
+ * Objects in the set must store the attribute inline, at byteOffset bytes from the start of each
+ * object (i.e. the attribute is a primitive member of a flat object type).
+ * If columnar is true, the attribute is also stored in a contiguous array in each page loaded to
+ * the set (see PaxPage.h).
+ */
+typedef struct {
+    std::string name;
+    size_t byteOffset;
+    ZoneMapAttributeType type;
+    bool columnar;
+} ZoneMapAttribute;
+
+/**
+ * The zone map of one attribute in one page: the range of the values, the number of values and
+ * nulls (objects stored as null handles), and a 64-bit linear counting sketch of the distinct
+ * values.
+ */
+typedef struct {
+    double minValue;
+    double maxValue;
+    unsigned int numValues;
+    unsigned int numNulls;
+    uint64_t distinctSketch;
+} PageZoneMap;
+
+/**
+ * A simple comparison predicate "attribute op value" that a scan can test against zone maps.
+ */
+typedef struct {
+    std::string attributeName;
+    ZoneMapComparisonOp op;
+    double value;
+} ZoneMapPredicate;
+
+/**
+ * This class builds and evaluates zone maps of pages.
+ */
+class PageSummarizer {
+public:
+    /**
+     * Summarize the given attributes of all objects in a sealed page, which stores a
+     * Record<Vector<Handle<Object>>>, into one zone map per attribute.
+     * Return false if the page doesn't hold such a record, and then no zone map is built.
+     */
+    static bool summarize(PDBPagePtr page,
+                          const std::vector<ZoneMapAttribute>& attributes,
+                          std::vector<PageZoneMap>& zoneMaps);
+
+    /**
+     * Return false if no value summarized in the zone map can satisfy "value op constant",
+     * so that the page can be skipped by a scan with the predicate.
+     * Comparisons are evaluated inclusively, so that rounding values to double never skips a
+     * page with a matching value.
+     */
+    static bool mayMatch(const PageZoneMap& zoneMap, ZoneMapComparisonOp op, double constant);
+
+    /**
+     * Return the estimated number of distinct values summarized in the zone map.
+     */
+    static double getEstimatedNumDistinctValues(const PageZoneMap& zoneMap);
+
+    /**
+     * Return an empty zone map.
+     */
+    static PageZoneMap getEmptyZoneMap();
+
+    /**
+     * Add a value to the zone map.
+     */
+    static void addValue(PageZoneMap& zoneMap, double value);
+};
+
+#endif /* PAGEZONEMAP_H */
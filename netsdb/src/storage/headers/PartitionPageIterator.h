@@ -12,6 +12,10 @@
 #include "PDBFile.h"
 #include "PageCache.h"
 #include "UserSet.h"
+#include "PageZoneMap.h"
+
+class PartitionPageIterator;
+typedef shared_ptr<PartitionPageIterator> PartitionPageIteratorPtr;
 
 class PartitionPageIterator : public PageIteratorInterface {
 
@@ -38,6 +42,20 @@ public:
      */
     bool hasNext();
 
+    /**
+     * To skip pages whose zone maps prove that no object satisfies the predicate, without
+     * loading them to cache. Return false if the predicate's attribute is not summarized in the
+     * file, and then no page is skipped.
+     */
+    bool setZoneMapPredicate(ZoneMapPredicate predicate);
+
+    /**
+     * To return the number of pages skipped by the zone map predicate.
+     */
+    unsigned int getNumSkippedPages() {
+        return numSkippedPages;
+    }
+
 private:
     PageCachePtr cache;
     PDBFilePtr file;
@@ -48,6 +66,11 @@ private:
     unsigned int numPages = 0;
     unsigned int numIteratedPages = 0;
     UserSet* set;
+    // the zone map predicate, which is disabled if zoneMapAttributeIndex is -1
+    int zoneMapAttributeIndex = -1;
+    ZoneMapComparisonOp zoneMapOp;
+    double zoneMapValue;
+    unsigned int numSkippedPages = 0;
 };
 
 
@@ -51,12 +51,42 @@ typedef shared_ptr<PartitionedFile> PartitionedFilePtr;
  * ...
  *
  *
+ * - PageCompressionType for new pages
+ * - Number of compressed pages
+ * - PartitionID for the 1st compressed page
+ * - PageSeqID in the partition for the 1st compressed page
+ * - Offset of the 1st compressed page in the partition
+ * - Length of the 1st compressed page
+ * - PageCompressionType of the 1st compressed page
+ * ...
+ *
+ *
+ * - Number of zone map attributes
+ * - Length of the name, name, byte offset and ZoneMapAttributeType of the 1st attribute
+ * ...
+ * - Number of summarized pages
+ * - PartitionID for the 1st summarized page
+ * - PageSeqID in the partition for the 1st summarized page
+ * - Number of zone maps of the 1st summarized page
+ * - Min, max, number of values, number of nulls and distinct sketch of each zone map
+ * ...
+ *
+ *
+ * - Number of columnar attributes
+ * - Index of the 1st columnar attribute in the zone map attributes
+ * ...
+ *
+ *
  * Data partition format:
  * - 1st pageId
  * - 1st page in the partition
  * - 2nd pageId
  * - 2nd page in the partition
  * - ...
+ *
+ * If the file is created with a PageCompressionType other than NoPageCompression, pages are
+ * instead appended back to back, each one compressed and padded to a multiple of 512 bytes, and
+ * located through the compressed page index in the meta partition.
  */
 class PartitionedFile : public PDBFileInterface {
 public:
@@ -71,7 +101,8 @@ public:
                     string metaPartitionPath,
                     vector<string> dataPartitionPaths,
                     pdb::PDBLoggerPtr logger,
-                    size_t pageSize);
+                    size_t pageSize,
+                    PageCompressionType compressionType = NoPageCompression);
 
 
     /**
@@ -135,6 +166,15 @@ public:
      */
     int appendPageDirect(FilePartitionID partitionId, PDBPagePtr page);
 
+    /**
+     * Append a batch of pages to the partition identified by partitionId, in the given order.
+     * Uncompressed pages are written with one vectored write, and all pages are appended under
+     * one hold of the file lock, so they get consecutive PageSeqInPartition.
+     * On success, the PageSeqInPartition of each page is put in seqs, and the number of
+     * appended pages is returned; -1 is returned on failure, and no page is appended.
+     */
+    int appendPages(FilePartitionID partitionId, vector<PDBPagePtr>& pages, vector<int>& seqs);
+
 
     /**
      * Set the shared page set that is related to this partitioned file instance
@@ -215,6 +255,15 @@ public:
                           char* pageInCache,
                           size_t length);
 
+    /**
+     * To load the page using positional read, without seeking or moving the file position.
+     * It is safe to call concurrently with any other load, and is used by the read-ahead threads.
+     */
+    size_t loadPageAt(FilePartitionID partitionId,
+                      unsigned int pageSeqInPartition,
+                      char* pageInCache,
+                      size_t length);
+
 
     /**
      * Similar with above method.
@@ -325,6 +374,28 @@ public:
      */
     unsigned int getNumPartitions();
 
+    /**
+     * To return the codec used for new pages
+     */
+    PageCompressionType getCompressionType();
+
+    /**
+     * To return the number of bytes used by flushed pages on disk
+     */
+    size_t getNumStoredBytes();
+
+    /**
+     * To return the uncompressed size of flushed pages divided by the size used on disk
+     */
+    double getCompressionRatio();
+
+    /**
+     * To declare an attribute to summarize in the zone maps of pages appended from now on, and
+     * persist the declaration in the meta partition.
+     * Return false if an attribute with the same name is already declared.
+     */
+    bool addZoneMapAttribute(ZoneMapAttribute attribute);
+
 protected:
     /**
      * Write data specified to the current file position.
@@ -336,6 +407,11 @@ protected:
      */
     int writeDataDirect(int handle, void* data, size_t length);
 
+    /**
+     * Write the buffers specified to the current file position with vectored writes.
+     */
+    int writeDataVector(int handle, struct iovec* buffers, int numBuffers);
+
     /**
      * Seek to the beginning of the page data of a page specified in the file.
      */
@@ -346,6 +422,27 @@ protected:
      */
     int seekPageDirect(int handle, unsigned int pageSeqInPartition);
 
+    /**
+     * Build the zone maps of the declared attributes for a sealed page to append.
+     * Return false if no attribute is declared or the page can't be summarized.
+     */
+    bool summarizePage(PDBPagePtr page, vector<PageZoneMap>& zoneMaps);
+
+    /**
+     * Compress the page, append it to the end of the partition, and describe where it is stored
+     * in info. The caller must hold fileMutex.
+     * Return 0 on success, or -1 on failure.
+     */
+    int writeCompressedPage(FilePartitionID partitionId, PDBPagePtr page, PageStorageInfo& info);
+
+    /**
+     * Load and decompress a page described by info into pageInCache.
+     */
+    size_t loadCompressedPage(FilePartitionID partitionId,
+                              const PageStorageInfo& info,
+                              char* pageInCache,
+                              size_t length);
+
     /**
      * Seek to the page size field in meta data.
      */
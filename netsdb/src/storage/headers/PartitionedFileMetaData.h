@@ -9,6 +9,7 @@
 #define SRC_CPP_MAIN_DATABASE_HEADERS_PARTITIONEDFILEMETADATA_H_
 
 #include "DataTypes.h"
+#include "PageZoneMap.h"
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -43,6 +44,18 @@ struct PageIndexEqual {
     }
 };
 
+/**
+ * Location of a page in a data partition of a compressed PartitionedFile instance.
+ * The page occupies length bytes starting at offset, padded to a multiple of the alignment
+ * required by direct I/O, and is encoded with compressionType (NoPageCompression if the page did
+ * not compress).
+ */
+typedef struct {
+    size_t offset;
+    size_t length;
+    PageCompressionType compressionType;
+} PageStorageInfo;
+
 /**
  * This class wraps the meta data format for PartitionedFile instance.
  */
@@ -55,8 +68,14 @@ public:
         this->pageSize = 0;
         this->numFlushedPages = 0;
 	this->numSharedPages = 0;
+        this->compressionType = NoPageCompression;
         this->pageIndexes = new unordered_map<PageID, PageIndex>();
+        this->pageStorageInfos =
+            new unordered_map<PageIndex, PageStorageInfo, PageIndexHash, PageIndexEqual>();
         this->pageIds = new unordered_map<PageIndex, PageID, PageIndexHash, PageIndexEqual>();
+        this->zoneMapAttributes = new vector<ZoneMapAttribute>();
+        this->pageZoneMaps =
+            new unordered_map<PageIndex, vector<PageZoneMap>, PageIndexHash, PageIndexEqual>();
         pthread_mutex_init(&(this->metaMutex), nullptr);
         pthread_mutex_init(&(this->indexMutex), nullptr);
 	pthread_mutex_init(&(this->sharedPageIndexMutex), nullptr);
@@ -76,6 +95,18 @@ public:
             pageIds->clear();
             delete pageIds;
         }
+        if (pageStorageInfos != nullptr) {
+            pageStorageInfos->clear();
+            delete pageStorageInfos;
+        }
+        if (zoneMapAttributes != nullptr) {
+            zoneMapAttributes->clear();
+            delete zoneMapAttributes;
+        }
+        if (pageZoneMaps != nullptr) {
+            pageZoneMaps->clear();
+            delete pageZoneMaps;
+        }
 	if (sharedPageIndexes != nullptr) {
 	    sharedPageIndexes->clear();
 	    delete sharedPageIndexes;
@@ -193,6 +224,149 @@ public:
         return pageIndexes;
     }
 
+    // APIs related to page compression
+
+    // Return the codec used for new pages
+    PageCompressionType getCompressionType() const {
+        return compressionType;
+    }
+
+    // Set the codec used for new pages
+    void setCompressionType(PageCompressionType compressionType) {
+        this->compressionType = compressionType;
+    }
+
+    // Record where a compressed page is stored in its partition
+    void addPageStorageInfo(FilePartitionID partitionId,
+                            unsigned int pageSeqInPartition,
+                            PageStorageInfo info) {
+        pthread_mutex_lock(&indexMutex);
+        PageIndex pageIndex;
+        pageIndex.partitionId = partitionId;
+        pageIndex.pageSeqInPartition = pageSeqInPartition;
+        (*this->pageStorageInfos)[pageIndex] = info;
+        pthread_mutex_unlock(&indexMutex);
+    }
+
+    // Return false if the page is stored uncompressed at its fixed offset
+    bool getPageStorageInfo(FilePartitionID partitionId,
+                            unsigned int pageSeqInPartition,
+                            PageStorageInfo& info) {
+        PageIndex pageIndex;
+        pageIndex.partitionId = partitionId;
+        pageIndex.pageSeqInPartition = pageSeqInPartition;
+        bool found = false;
+        pthread_mutex_lock(&indexMutex);
+        auto iter = this->pageStorageInfos->find(pageIndex);
+        if (iter != this->pageStorageInfos->end()) {
+            info = iter->second;
+            found = true;
+        }
+        pthread_mutex_unlock(&indexMutex);
+        return found;
+    }
+
+    unordered_map<PageIndex, PageStorageInfo, PageIndexHash, PageIndexEqual>*
+    getPageStorageInfos() {
+        return pageStorageInfos;
+    }
+
+    // APIs related to zone maps
+
+    // Declare an attribute to summarize in the zone maps of pages flushed from now on,
+    // return false if an attribute with the same name is already declared
+    bool addZoneMapAttribute(ZoneMapAttribute attribute) {
+        pthread_mutex_lock(&indexMutex);
+        for (auto& existing : *this->zoneMapAttributes) {
+            if (existing.name == attribute.name) {
+                pthread_mutex_unlock(&indexMutex);
+                return false;
+            }
+        }
+        this->zoneMapAttributes->push_back(attribute);
+        pthread_mutex_unlock(&indexMutex);
+        return true;
+    }
+
+    // Return a copy of the declared attributes
+    vector<ZoneMapAttribute> getZoneMapAttributes() {
+        pthread_mutex_lock(&indexMutex);
+        vector<ZoneMapAttribute> attributes = *this->zoneMapAttributes;
+        pthread_mutex_unlock(&indexMutex);
+        return attributes;
+    }
+
+    // Return a copy of the declared attributes that are also stored in PAX columns
+    vector<ZoneMapAttribute> getColumnarAttributes() {
+        pthread_mutex_lock(&indexMutex);
+        vector<ZoneMapAttribute> attributes;
+        for (auto& attribute : *this->zoneMapAttributes) {
+            if (attribute.columnar == true) {
+                attributes.push_back(attribute);
+            }
+        }
+        pthread_mutex_unlock(&indexMutex);
+        return attributes;
+    }
+
+    // Return the position of the attribute in the zone maps of a page, or -1 if not declared
+    int getZoneMapAttributeIndex(string attributeName) {
+        int index = -1;
+        pthread_mutex_lock(&indexMutex);
+        for (size_t i = 0; i < this->zoneMapAttributes->size(); i++) {
+            if (this->zoneMapAttributes->at(i).name == attributeName) {
+                index = i;
+                break;
+            }
+        }
+        pthread_mutex_unlock(&indexMutex);
+        return index;
+    }
+
+    // Record the zone maps of a flushed page, one for each declared attribute
+    void addPageZoneMaps(FilePartitionID partitionId,
+                         unsigned int pageSeqInPartition,
+                         const vector<PageZoneMap>& zoneMaps) {
+        pthread_mutex_lock(&indexMutex);
+        PageIndex pageIndex;
+        pageIndex.partitionId = partitionId;
+        pageIndex.pageSeqInPartition = pageSeqInPartition;
+        (*this->pageZoneMaps)[pageIndex] = zoneMaps;
+        pthread_mutex_unlock(&indexMutex);
+    }
+
+    // Return false only if the zone map of the attribute in the page proves that no object in the
+    // page satisfies "attribute op value"; pages without the zone map may always match
+    bool mayMatch(FilePartitionID partitionId,
+                  unsigned int pageSeqInPartition,
+                  int attributeIndex,
+                  ZoneMapComparisonOp op,
+                  double value) {
+        if (attributeIndex < 0) {
+            return true;
+        }
+        PageIndex pageIndex;
+        pageIndex.partitionId = partitionId;
+        pageIndex.pageSeqInPartition = pageSeqInPartition;
+        bool ret = true;
+        pthread_mutex_lock(&indexMutex);
+        auto iter = this->pageZoneMaps->find(pageIndex);
+        if ((iter != this->pageZoneMaps->end()) && ((size_t)attributeIndex < iter->second.size())) {
+            ret = PageSummarizer::mayMatch(iter->second.at(attributeIndex), op, value);
+        }
+        pthread_mutex_unlock(&indexMutex);
+        return ret;
+    }
+
+    vector<ZoneMapAttribute>* getZoneMapAttributesPtr() {
+        return zoneMapAttributes;
+    }
+
+    unordered_map<PageIndex, vector<PageZoneMap>, PageIndexHash, PageIndexEqual>*
+    getPageZoneMaps() {
+        return pageZoneMaps;
+    }
+
     // APIs related to shared page set 
     
     /**
@@ -298,6 +472,14 @@ private:
     // a map of PageID to PageIndex
     unordered_map<PageID, PageIndex>* pageIndexes = nullptr;
     unordered_map<PageIndex, PageID, PageIndexHash, PageIndexEqual>* pageIds = nullptr;
+    // the codec for new pages, and where each compressed page is stored
+    PageCompressionType compressionType;
+    unordered_map<PageIndex, PageStorageInfo, PageIndexHash, PageIndexEqual>* pageStorageInfos =
+        nullptr;
+    // the attributes summarized in zone maps, and the zone maps of each flushed page
+    vector<ZoneMapAttribute>* zoneMapAttributes = nullptr;
+    unordered_map<PageIndex, vector<PageZoneMap>, PageIndexHash, PageIndexEqual>* pageZoneMaps =
+        nullptr;
     pthread_mutex_t metaMutex;
     pthread_mutex_t indexMutex;
     pthread_mutex_t sharedPageIndexMutex;
@@ -335,6 +517,7 @@ public:
     // Create a new PartitionMetaData instance
     PartitionMetaData(string path, FilePartitionID partitionId) {
         this->numPages = 0;
+        this->dataSize = 0;
         this->path = path;
         this->partitionId = partitionId;
     }
@@ -362,6 +545,20 @@ public:
         this->numPages++;
     }
 
+    /**
+     * Return the number of bytes used by compressed pages in the partition
+     */
+    size_t getDataSize() const {
+        return dataSize;
+    }
+
+    /**
+     * Set the number of bytes used by compressed pages in the partition
+     */
+    void setDataSize(size_t dataSize) {
+        this->dataSize = dataSize;
+    }
+
     /**
      * Return the PartitionID of this partition
      */
@@ -401,6 +598,12 @@ private:
      */
     unsigned int numPages;
 
+    /**
+     * Number of bytes used by compressed pages in the partition, which is also the offset of the
+     * next compressed page
+     */
+    size_t dataSize = 0;
+
     /**
      * Path of this partition;
      */
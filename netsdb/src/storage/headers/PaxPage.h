@@ -0,0 +1,264 @@
+#ifndef PAX_PAGE_H
+#define PAX_PAGE_H
+
+#include "Object.h"
+#include "Handle.h"
+#include "PDBVector.h"
+#include "Record.h"
+#include "PDBPage.h"
+#include "PageZoneMap.h"
+#include "Configuration.h"
+#include <string.h>
+#include <stdint.h>
+#include <vector>
+
+#define PAX_FOOTER_MAGIC 0x31584150474150ULL
+
+#define PAX_ALIGNMENT 8
+
+/**
+ * Layout of the bytes of a page that stores its columnar attributes in PAX columns:
+ *
+ * - Record<Vector<Handle<Object>>> holding the objects, as in any other page
+ * - PaxColumnHeader of the 1st column: byte offset of the attribute in an object, width of a
+ *   value, and offset of the array of values from the start of the page bytes
+ * - ...
+ * - array of the values of the 1st column, with one value for each handle in the vector
+ * - ...
+ * - (free space)
+ * - PaxFooter at the end of the page bytes: magic, number of rows, number of columns, and offset
+ *   of the 1st column header from the start of the page bytes
+ *
+ * The record is left as is, so every reader of the row layout still works, while scans can read
+ * the columnar attributes from contiguous arrays instead of chasing the handle of each object.
+ * The values of a row with a null handle are all zeros.
+ */
+typedef struct {
+    uint64_t byteOffset;
+    uint64_t width;
+    uint64_t arrayOffset;
+} PaxColumnHeader;
+
+typedef struct {
+    uint64_t magic;
+    uint64_t numRows;
+    uint64_t numColumns;
+    uint64_t headerOffset;
+} PaxFooter;
+
+/**
+ * This class builds and reads the PAX columns of pages.
+ */
+class PaxPage {
+public:
+    /**
+     * Return the width of a value of the given type.
+     */
+    static size_t getWidth(ZoneMapAttributeType type) {
+        switch (type) {
+            case ZoneMapInt:
+                return sizeof(int);
+            case ZoneMapLong:
+                return sizeof(long);
+            case ZoneMapFloat:
+                return sizeof(float);
+            case ZoneMapDouble:
+                return sizeof(double);
+        }
+        return sizeof(double);
+    }
+
+    /**
+     * Return the number of bytes that the PAX columns of the given attributes take for each row.
+     */
+    static size_t getRowWidth(const std::vector<ZoneMapAttribute>& attributes) {
+        size_t rowWidth = 0;
+        for (auto& attribute : attributes) {
+            rowWidth += getWidth(attribute.type);
+        }
+        return rowWidth;
+    }
+
+    /**
+     * Return the number of bytes that the PAX columns of the given attributes take for numRows
+     * rows, including column headers, footer and padding.
+     */
+    static size_t getColumnsSize(size_t numRows, const std::vector<ZoneMapAttribute>& attributes) {
+        size_t size = PAX_ALIGNMENT + attributes.size() * sizeof(PaxColumnHeader);
+        for (auto& attribute : attributes) {
+            size += align(numRows * getWidth(attribute.type));
+        }
+        return size + sizeof(PaxFooter);
+    }
+
+    /**
+     * Store the given attributes of all objects in the record at the start of the page bytes in
+     * PAX columns after the record.
+     * Return false and leave the page without PAX columns if the attributes don't fit in the free
+     * space after the record, or if the objects are not stored in the record.
+     */
+    static bool build(void* bytes, size_t bytesSize, const std::vector<ZoneMapAttribute>& attributes) {
+        clear(bytes, bytesSize);
+        if ((bytes == nullptr) || (attributes.size() == 0) || (bytesSize < sizeof(PaxFooter))) {
+            return false;
+        }
+        pdb::Record<pdb::Vector<pdb::Handle<pdb::Object>>>* myRecord =
+            (pdb::Record<pdb::Vector<pdb::Handle<pdb::Object>>>*)bytes;
+        size_t numBytes = myRecord->numBytes();
+        if ((numBytes == 0) || (numBytes > bytesSize) ||
+            (myRecord->rootObjectOffset() >= numBytes)) {
+            return false;
+        }
+        char* recordBegin = (char*)bytes;
+        char* recordEnd = recordBegin + numBytes;
+        pdb::Handle<pdb::Vector<pdb::Handle<pdb::Object>>> objects = myRecord->getRootObject();
+        pdb::Handle<pdb::Object>* handles = objects->c_ptr();
+        size_t numRows = objects->size();
+        if (((char*)handles < recordBegin) || ((char*)(handles + numRows) > recordEnd)) {
+            return false;
+        }
+        if (align(numBytes) + getColumnsSize(numRows, attributes) > bytesSize) {
+            return false;
+        }
+
+        // lay out the column headers and the arrays
+        size_t headerOffset = align(numBytes);
+        PaxColumnHeader* headers = (PaxColumnHeader*)(recordBegin + headerOffset);
+        size_t arrayOffset = align(headerOffset + attributes.size() * sizeof(PaxColumnHeader));
+        for (size_t j = 0; j < attributes.size(); j++) {
+            headers[j].byteOffset = attributes[j].byteOffset;
+            headers[j].width = getWidth(attributes[j].type);
+            headers[j].arrayOffset = arrayOffset;
+            arrayOffset += align(numRows * headers[j].width);
+        }
+
+        // copy the attributes of each object, so that each object is visited only once
+        for (size_t i = 0; i < numRows; i++) {
+            char* object = nullptr;
+            if (!handles[i].isNullPtr()) {
+                object = (char*)(handles[i].getTarget()->getObject());
+            }
+            for (size_t j = 0; j < attributes.size(); j++) {
+                char* value = recordBegin + headers[j].arrayOffset + i * headers[j].width;
+                if (object == nullptr) {
+                    memset(value, 0, headers[j].width);
+                    continue;
+                }
+                char* attribute = object + headers[j].byteOffset;
+                if ((attribute < recordBegin) || (attribute + headers[j].width > recordEnd)) {
+                    return false;
+                }
+                memcpy(value, attribute, headers[j].width);
+            }
+        }
+
+        // the footer is written last, so that a page is never seen with partial columns
+        PaxFooter* footer = (PaxFooter*)(recordBegin + bytesSize - sizeof(PaxFooter));
+        footer->numRows = numRows;
+        footer->numColumns = attributes.size();
+        footer->headerOffset = headerOffset;
+        footer->magic = PAX_FOOTER_MAGIC;
+        return true;
+    }
+
+    /**
+     * Build the PAX columns of a sealed page.
+     */
+    static bool build(PDBPagePtr page, const std::vector<ZoneMapAttribute>& attributes) {
+        if ((page == nullptr) || (page->getRawBytes() == nullptr)) {
+            return false;
+        }
+        return build(page->getBytes(), page->getSize(), attributes);
+    }
+
+    /**
+     * Remove the PAX columns of a page, which must be done before a page buffer is reused, so
+     * that stale columns are never read with a new record.
+     */
+    static void clear(void* bytes, size_t bytesSize) {
+        if ((bytes == nullptr) || (bytesSize < sizeof(PaxFooter))) {
+            return;
+        }
+        PaxFooter* footer = (PaxFooter*)((char*)bytes + bytesSize - sizeof(PaxFooter));
+        footer->magic = 0;
+    }
+
+    static void clear(PDBPagePtr page) {
+        if ((page == nullptr) || (page->getRawBytes() == nullptr)) {
+            return;
+        }
+        clear(page->getBytes(), page->getSize());
+    }
+
+    /**
+     * Return the size of the page bytes that start at the given address, as recorded in the
+     * header of the page. This is used by scans that only have the bytes of a pinned page.
+     */
+    static size_t getBytesSize(void* bytes) {
+        char* sizeBytes = (char*)bytes - DEFAULT_PAGE_HEADER_SIZE + sizeof(NodeID) +
+            sizeof(DatabaseID) + sizeof(UserTypeID) + sizeof(SetID) + sizeof(PageID) + sizeof(int);
+        size_t pageSize = *((size_t*)sizeBytes);
+        if (pageSize <= DEFAULT_PAGE_HEADER_SIZE) {
+            return 0;
+        }
+        return pageSize - DEFAULT_PAGE_HEADER_SIZE;
+    }
+
+    /**
+     * Return the footer of the PAX columns of the page bytes, or nullptr if the page has no valid
+     * PAX columns for the record that it holds.
+     */
+    static PaxFooter* getFooter(void* bytes, size_t bytesSize) {
+        if ((bytes == nullptr) || (bytesSize < sizeof(PaxFooter))) {
+            return nullptr;
+        }
+        PaxFooter* footer = (PaxFooter*)((char*)bytes + bytesSize - sizeof(PaxFooter));
+        if (footer->magic != PAX_FOOTER_MAGIC) {
+            return nullptr;
+        }
+        pdb::Record<pdb::Vector<pdb::Handle<pdb::Object>>>* myRecord =
+            (pdb::Record<pdb::Vector<pdb::Handle<pdb::Object>>>*)bytes;
+        size_t numBytes = myRecord->numBytes();
+        if ((numBytes == 0) || (footer->headerOffset < numBytes) ||
+            (footer->headerOffset + footer->numColumns * sizeof(PaxColumnHeader) >
+             bytesSize - sizeof(PaxFooter)) ||
+            (footer->numRows != myRecord->getRootObject()->size())) {
+            return nullptr;
+        }
+        return footer;
+    }
+
+    /**
+     * Return the array that stores the attribute at the given byte offset, and its width, or
+     * nullptr if the attribute is not stored in the PAX columns.
+     */
+    static char* getColumn(void* bytes, PaxFooter* footer, size_t byteOffset, size_t& width) {
+        PaxColumnHeader* headers = (PaxColumnHeader*)((char*)bytes + footer->headerOffset);
+        for (uint64_t j = 0; j < footer->numColumns; j++) {
+            if (headers[j].byteOffset == byteOffset) {
+                width = headers[j].width;
+                return (char*)bytes + headers[j].arrayOffset;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Return the byte offsets of all attributes stored in the PAX columns.
+     */
+    static std::vector<size_t> getByteOffsets(void* bytes, PaxFooter* footer) {
+        std::vector<size_t> byteOffsets;
+        PaxColumnHeader* headers = (PaxColumnHeader*)((char*)bytes + footer->headerOffset);
+        for (uint64_t j = 0; j < footer->numColumns; j++) {
+            byteOffsets.push_back(headers[j].byteOffset);
+        }
+        return byteOffsets;
+    }
+
+private:
+    static size_t align(size_t offset) {
+        return (offset + PAX_ALIGNMENT - 1) / PAX_ALIGNMENT * PAX_ALIGNMENT;
+    }
+};
+
+#endif /* PAX_PAGE_H */
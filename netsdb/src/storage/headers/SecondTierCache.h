@@ -0,0 +1,117 @@
+#ifndef SECONDTIERCACHE_H
+#define SECONDTIERCACHE_H
+
+#include "PageReplacementPolicy.h"
+#include "PDBLogger.h"
+#include "DataTypes.h"
+#include <pthread.h>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <memory>
+using namespace std;
+class SecondTierCache;
+typedef shared_ptr<SecondTierCache> SecondTierCachePtr;
+
+/**
+ * This class implements a second cache tier for clean pages of persistent sets, in a file on a
+ * fast local device, e.g. an SSD, between the page cache in shared memory and the partition files
+ * of the sets.
+ *
+ * The file is divided into slots of slotSize bytes, each holding one page. When the page cache
+ * evicts a clean page, it offers the page to this tier, and when it misses a page, it tries to
+ * restore the page from this tier before loading it from the partition file.
+ *
+ * - Admission: a page is only admitted when it is evicted for the second time while its key is
+ * remembered from the previous eviction, or after it has been restored from this tier. The keys of
+ * the most recent evictions are remembered in a FIFO of as many keys as there are slots, so that
+ * pages scanned only once do not flush the tier.
+ * - Replacement: when there is no free slot, the slots are replaced in round-robin order.
+ * - The tier is exclusive: a restored page leaves the tier, so that a page that is modified again
+ * in the page cache never has a stale copy here.
+ *
+ * The pages are not persistent: the file is truncated when the tier is created.
+ * All functions are thread-safe, and the file I/O is done without holding the lock.
+ */
+class SecondTierCache {
+public:
+    SecondTierCache(string path, size_t capacity, size_t slotSize, pdb::PDBLoggerPtr logger);
+    ~SecondTierCache();
+
+    /**
+     * Return false if the file of the tier can not be used.
+     */
+    bool isOpen();
+
+    /**
+     * Offer a clean page that is being evicted from the page cache.
+     * Return true if the page is admitted and written to the tier.
+     */
+    bool admit(CacheKey key, char* data, size_t size);
+
+    /**
+     * Return true if the page is in the tier.
+     */
+    bool contains(CacheKey key);
+
+    /**
+     * If the page is in the tier, read it into buffer, remove it from the tier and return true.
+     * Otherwise return false.
+     */
+    bool restore(CacheKey key, char* buffer, size_t size);
+
+    /**
+     * Remove all pages of a set from the tier, e.g. when the set is removed.
+     */
+    void invalidateSet(DatabaseID dbId, UserTypeID typeId, SetID setId);
+
+    /**
+     * Return the number of pages in the tier.
+     */
+    size_t getNumPages();
+
+    /**
+     * Return the number of slots in the tier.
+     */
+    size_t getNumSlots() {
+        return numSlots;
+    }
+
+private:
+    typedef enum { SlotFree = 0, SlotWriting = 1, SlotCached = 2, SlotReading = 3 } SlotState;
+
+    struct Slot {
+        CacheKey key;
+        size_t size;
+        SlotState state;
+        // set if the set of the page is removed while the page is being written
+        bool invalidated;
+    };
+
+    // remember that a page was evicted or restored, the caller must hold mutex
+    void rememberKey(CacheKey key);
+
+    // find a free slot, or replace a cached page, the caller must hold mutex
+    // return -1 if all slots are being read or written
+    long findSlot();
+
+    string path;
+    int handle;
+    size_t slotSize;
+    size_t numSlots;
+    vector<Slot> slots;
+    vector<size_t> freeSlots;
+    // the next slot to replace
+    size_t clockHand;
+    unordered_map<CacheKey, size_t, CacheKeyHash, CacheKeyEqual> index;
+    // the keys of the most recently evicted or restored pages, for admission
+    deque<CacheKey> recentKeys;
+    unordered_set<CacheKey, CacheKeyHash, CacheKeyEqual> recentKeySet;
+    pthread_mutex_t mutex;
+    pdb::PDBLoggerPtr logger;
+};
+
+
+#endif /* SECONDTIERCACHE_H */
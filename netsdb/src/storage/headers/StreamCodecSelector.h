@@ -0,0 +1,163 @@
+#ifndef STREAM_CODEC_SELECTOR_H
+#define STREAM_CODEC_SELECTOR_H
+
+#include "DataTypes.h"
+#include <atomic>
+#include <string>
+#include <vector>
+
+// the number of the first pages of a stream that are compressed with every codec, to choose the
+// codec of the rest of the stream
+#ifndef CODEC_SAMPLE_PAGES
+#define CODEC_SAMPLE_PAGES 4
+#endif
+
+// the bandwidth that a byte sent over the network is weighed with against the time to compress
+// and decompress it, i.e. a codec is chosen if the time that it saves on the network is more
+// than the time that it takes
+#ifndef CODEC_NETWORK_BYTES_PER_SECOND
+#define CODEC_NETWORK_BYTES_PER_SECOND ((double)1024 * (double)1024 * (double)1024)
+#endif
+
+// the level of Zstd for streams that don't give one
+#ifndef STREAM_ZSTD_LEVEL
+#define STREAM_ZSTD_LEVEL 1
+#endif
+
+/**
+ * The counters of the pages that this process compresses and decompresses for streams, by codec.
+ */
+class StreamCodecMetrics {
+public:
+    std::atomic<size_t> numPages[ZstdPageCompression + 1];
+
+    // the bytes of the pages, and the bytes that they are compressed to
+    std::atomic<size_t> numRawBytes[ZstdPageCompression + 1];
+
+    std::atomic<size_t> numCompressedBytes[ZstdPageCompression + 1];
+
+    std::atomic<size_t> compressNanoseconds[ZstdPageCompression + 1];
+
+    std::atomic<size_t> numDecompressedPages[ZstdPageCompression + 1];
+
+    std::atomic<size_t> decompressNanoseconds[ZstdPageCompression + 1];
+
+    // the pages that are compressed with every codec to choose one, and the time that it took
+    std::atomic<size_t> numSampledPages{0};
+
+    std::atomic<size_t> sampleNanoseconds{0};
+
+    StreamCodecMetrics();
+
+    /**
+     * Return the bytes that are not sent because the pages are compressed.
+     */
+    long getBytesSaved() const;
+
+    std::string toString() const;
+};
+
+/**
+ * Return the counters of this process.
+ */
+StreamCodecMetrics& getStreamCodecMetrics();
+
+/**
+ * This class chooses the codec of the pages of one stream, e.g. the pages that a sink shuffles
+ * to one node. The codec is given by a spec: "none", "snappy", "lz4", "zstd", "zstd:N" for Zstd
+ * at level N, or "auto". With "auto", each of the first CODEC_SAMPLE_PAGES pages is compressed
+ * and decompressed with every codec that is available, and sent with the one that costs the
+ * least for it; the cost of a codec is the time to compress and decompress a page, plus the time
+ * to send its compressed bytes over the network. The rest of the stream uses the
+ * codec that cost the least for all sampled pages. So pages that barely compress, such as pages
+ * of doubles, are sent as they are, and redundant pages are compressed as much as pays off.
+ * The codec of each page is sent with it, so the receiver doesn't need to know the spec.
+ */
+class StreamCodecSelector {
+public:
+    /**
+     * A codec of the spec that is not available is replaced by Snappy; networkBytesPerSecond is
+     * the bandwidth that the sent bytes are weighed with.
+     */
+    StreamCodecSelector(std::string spec,
+                        double networkBytesPerSecond = CODEC_NETWORK_BYTES_PER_SECOND);
+
+    /**
+     * Return the size that a page of size bytes is compressed to at most.
+     */
+    size_t getMaxCompressedLength(size_t size);
+
+    /**
+     * Compress a page of the stream from src to dest, which has getMaxCompressedLength() bytes;
+     * return the codec that it is compressed with, and set compressedSize.
+     */
+    PageCompressionType compress(const char* src,
+                                 size_t size,
+                                 char* dest,
+                                 size_t& compressedSize);
+
+    /**
+     * Return whether the codec of the stream is chosen, i.e. it is not sampled any more.
+     */
+    bool isChosen();
+
+    /**
+     * Return the codec of the stream, or the codec that costs the least so far if it is sampled.
+     */
+    PageCompressionType getCodec();
+
+    std::string getSpec();
+
+    /**
+     * Parse a spec to a codec and a level; return false if it is not a valid spec.
+     */
+    static bool parseSpec(std::string spec, bool& isAuto, PageCompressionType& codec, int& level);
+
+    /**
+     * Return the size of a page that is compressed to src with codec: the given size if it is
+     * known, which it must be for LZ4 and Zstd, or the size in the bytes of Snappy, or srcLength
+     * if the page is not compressed; return (size_t)(-1) if it can't be known.
+     */
+    static size_t getUncompressedLength(PageCompressionType codec,
+                                        const char* src,
+                                        size_t srcLength,
+                                        size_t uncompressedSize);
+
+    /**
+     * Decompress a page of a stream from src to dest, which has destLength bytes; a page that
+     * is not compressed is copied. Return the size of the page, or (size_t)(-1) on failure.
+     */
+    static size_t decompress(PageCompressionType codec,
+                             const char* src,
+                             size_t srcLength,
+                             char* dest,
+                             size_t destLength);
+
+private:
+    // compresses a sampled page with every candidate, and copies the cheapest to dest
+    PageCompressionType sample(const char* src, size_t size, char* dest, size_t& compressedSize);
+
+    std::string spec;
+
+    bool isAuto;
+
+    PageCompressionType codec;
+
+    int level;
+
+    double networkBytesPerSecond;
+
+    // the codecs that are sampled, and the cost of each of them for the sampled pages so far
+    std::vector<PageCompressionType> candidates;
+
+    std::vector<double> costs;
+
+    int numSampled = 0;
+
+    // the buffers that sampled pages are compressed and decompressed to
+    std::vector<char> sampleBuffer;
+
+    std::vector<char> checkBuffer;
+};
+
+#endif
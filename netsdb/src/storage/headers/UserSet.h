@@ -175,6 +175,52 @@ public:
         return buffer;
     }
 
+    /**
+     * Like getNewBytes(), but on a page of the caller instead of the input buffer page of the set,
+     * so that the caller can fill the bytes without a lock, e.g. by receiving them from a socket.
+     * page is pinned and only used by the caller; when it is full, it is unpinned and replaced by
+     * a new page of the set. Returns nullptr if the bytes don't fit in a page.
+     */
+    inline void* getNewBytes(size_t size, PDBPagePtr& page) {
+        if (size == 0) {
+            return nullptr;
+        }
+        void* buffer = nullptr;
+        if (page != nullptr) {
+            buffer = page->addVariableBytes(size);
+        }
+        if (buffer == nullptr) {
+            unpinPage(page);
+            pthread_mutex_lock(&this->addBytesMutex);
+            page = this->addPage();
+            pthread_mutex_unlock(&this->addBytesMutex);
+            if (page != nullptr) {
+                buffer = page->addVariableBytes(size);
+            }
+        }
+        return buffer;
+    }
+
+    /**
+     * Unpins a page that was filled by getNewBytes(size, page), and flushes it if the set is
+     * cache-through.
+     */
+    inline void unpinPage(PDBPagePtr& page) {
+        if (page == nullptr) {
+            return;
+        }
+        page->decRefCount();
+        if (this->getDurabilityType() == CacheThrough) {
+            CacheKey key;
+            key.dbId = this->getDbID();
+            key.typeId = this->getTypeID();
+            key.setId = this->getSetID();
+            key.pageId = page->getPageID();
+            this->pageCache->flushPageWithoutEviction(key);
+        }
+        page = nullptr;
+    }
+
 
     /**
      * Get a set of iterators for scanning the data in the set.
@@ -250,6 +296,22 @@ public:
         return this->file->getNumSharedPages();
     }
 
+    /**
+     * Declare an attribute of the objects in the set to summarize in per-page zone maps.
+     * A page is summarized when it is sealed and appended to the file, so only pages flushed
+     * after the declaration can be skipped by scans.
+     */
+    bool addZoneMapAttribute(ZoneMapAttribute attribute) {
+        return this->file->addZoneMapAttribute(attribute);
+    }
+
+    /**
+     * Return the declared attributes to store in the PAX columns of pages loaded to the set.
+     */
+    vector<ZoneMapAttribute> getColumnarAttributes() {
+        return this->file->getMetaData()->getColumnarAttributes();
+    }
+
     /**
      * Returns file instance;
      */
@@ -67,7 +67,8 @@ public:
                size_t desiredSize = 1,
                bool isMRU = true,
                bool isTransient = true,
-	       bool isSharedTensorBlockSet = false);
+	       bool isSharedTensorBlockSet = false,
+               PageCompressionType compressionType = NoPageCompression);
 
     // Remove an existing set, including all the disk files associated with the set.
     // If successful, return 0.
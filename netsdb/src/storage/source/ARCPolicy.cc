@@ -0,0 +1,116 @@
+#ifndef ARC_POLICY_CC
+#define ARC_POLICY_CC
+
+#include "ARCPolicy.h"
+#include <algorithm>
+
+ARCPolicy::ARCPolicy(size_t capacity) {
+    this->capacity = (capacity == 0) ? 1 : capacity;
+    this->p = 0;
+}
+
+ARCPolicy::~ARCPolicy() {}
+
+void ARCPolicy::moveTo(CacheKey key, int which) {
+    auto iter = this->positions.find(key);
+    if (iter == this->positions.end()) {
+        this->lists[which].push_back(key);
+        this->positions[key] = make_pair(which, std::prev(this->lists[which].end()));
+        return;
+    }
+    this->lists[which].splice(
+        this->lists[which].end(), this->lists[iter->second.first], iter->second.second);
+    iter->second.first = which;
+}
+
+void ARCPolicy::trimGhosts() {
+    while ((this->lists[T1].size() + this->lists[B1].size() > this->capacity) &&
+           (this->lists[B1].size() > 0)) {
+        this->positions.erase(this->lists[B1].front());
+        this->lists[B1].pop_front();
+    }
+    while (this->positions.size() > 2 * this->capacity) {
+        int which = (this->lists[B2].size() > 0) ? B2 : B1;
+        if (this->lists[which].size() == 0) {
+            break;
+        }
+        this->positions.erase(this->lists[which].front());
+        this->lists[which].pop_front();
+    }
+}
+
+void ARCPolicy::pageCached(CacheKey key) {
+    auto iter = this->positions.find(key);
+    if (iter == this->positions.end()) {
+        this->moveTo(key, T1);
+    } else {
+        int which = iter->second.first;
+        double size1 = (double)this->lists[B1].size();
+        double size2 = (double)this->lists[B2].size();
+        if (which == B1) {
+            // T1 was too small to keep this page
+            this->p = std::min((double)this->capacity, this->p + std::max(size2 / size1, 1.0));
+        } else if (which == B2) {
+            // T2 was too small to keep this page
+            this->p = std::max(0.0, this->p - std::max(size1 / size2, 1.0));
+        }
+        this->moveTo(key, T2);
+    }
+    if (this->getNumCachedPages() > this->capacity) {
+        this->capacity = this->getNumCachedPages();
+    }
+    this->trimGhosts();
+}
+
+void ARCPolicy::pageAccessed(CacheKey key) {
+    auto iter = this->positions.find(key);
+    if ((iter == this->positions.end()) || (iter->second.first == B1) ||
+        (iter->second.first == B2)) {
+        this->pageCached(key);
+        return;
+    }
+    this->moveTo(key, T2);
+}
+
+void ARCPolicy::pageRemoved(CacheKey key) {
+    auto iter = this->positions.find(key);
+    if (iter == this->positions.end()) {
+        return;
+    }
+    if (iter->second.first == T1) {
+        this->moveTo(key, B1);
+    } else if (iter->second.first == T2) {
+        this->moveTo(key, B2);
+    }
+    this->trimGhosts();
+}
+
+bool ARCPolicy::selectVictimIn(int which,
+                               const std::function<bool(const CacheKey&)>& isEvictable,
+                               CacheKey& victim) {
+    for (auto it = this->lists[which].begin(); it != this->lists[which].end(); ++it) {
+        if (isEvictable(*it) == true) {
+            victim = *it;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ARCPolicy::selectVictim(const std::function<bool(const CacheKey&)>& isEvictable,
+                             CacheKey& victim) {
+    // REPLACE(p): evict from T1 while it is larger than its target
+    if ((this->lists[T1].size() > 0) &&
+        (((double)this->lists[T1].size() > this->p) || (this->lists[T2].size() == 0))) {
+        if (this->selectVictimIn(T1, isEvictable, victim) == true) {
+            return true;
+        }
+        return this->selectVictimIn(T2, isEvictable, victim);
+    }
+    if (this->selectVictimIn(T2, isEvictable, victim) == true) {
+        return true;
+    }
+    return this->selectVictimIn(T1, isEvictable, victim);
+}
+
+#endif
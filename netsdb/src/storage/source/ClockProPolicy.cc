@@ -0,0 +1,210 @@
+#ifndef CLOCK_PRO_POLICY_CC
+#define CLOCK_PRO_POLICY_CC
+
+#include "ClockProPolicy.h"
+#include <algorithm>
+
+ClockProPolicy::ClockProPolicy(size_t capacity) {
+    this->capacity = (capacity == 0) ? 1 : capacity;
+    // start with few cold pages, like the HIR pages of LIRS, and adapt from there
+    this->coldTarget = std::max((size_t)1, this->capacity / 100);
+    this->handHot = this->clock.end();
+    this->handCold = this->clock.end();
+    this->handTest = this->clock.end();
+}
+
+ClockProPolicy::~ClockProPolicy() {}
+
+void ClockProPolicy::advance(list<ClockEntry>::iterator& hand) {
+    ++hand;
+    if (hand == this->clock.end()) {
+        hand = this->clock.begin();
+    }
+}
+
+void ClockProPolicy::insert(CacheKey key, ClockPageType type) {
+    ClockEntry entry;
+    entry.key = key;
+    entry.type = type;
+    entry.referenced = false;
+    if (this->clock.size() == 0) {
+        this->clock.push_back(entry);
+        this->handHot = this->clock.begin();
+        this->handCold = this->clock.begin();
+        this->handTest = this->clock.begin();
+        this->positions[key] = this->clock.begin();
+        return;
+    }
+    this->positions[key] = this->clock.insert(this->handHot, entry);
+}
+
+void ClockProPolicy::erase(list<ClockEntry>::iterator it) {
+    if (this->clock.size() == 1) {
+        this->handHot = this->clock.end();
+        this->handCold = this->clock.end();
+        this->handTest = this->clock.end();
+    } else {
+        if (this->handHot == it) {
+            this->advance(this->handHot);
+        }
+        if (this->handCold == it) {
+            this->advance(this->handCold);
+        }
+        if (this->handTest == it) {
+            this->advance(this->handTest);
+        }
+    }
+    this->positions.erase(it->key);
+    this->clock.erase(it);
+}
+
+void ClockProPolicy::runHandHot() {
+    if (this->clock.size() == 0) {
+        return;
+    }
+    // the hot hand must not pass the test hand, which ends the test periods behind it
+    if (this->handHot == this->handTest) {
+        this->runHandTest();
+        if (this->clock.size() == 0) {
+            return;
+        }
+    }
+    ClockEntry& entry = *(this->handHot);
+    if (entry.type == HotPage) {
+        if (entry.referenced == true) {
+            entry.referenced = false;
+        } else {
+            entry.type = ColdPage;
+            this->numHot--;
+            this->numCold++;
+        }
+    }
+    this->advance(this->handHot);
+}
+
+void ClockProPolicy::runHandTest() {
+    if (this->clock.size() == 0) {
+        return;
+    }
+    if (this->handTest->type == TestPage) {
+        // the test period ended without a reuse, so fewer cold pages would have done
+        this->erase(this->handTest);
+        this->numTest--;
+        if (this->coldTarget > 1) {
+            this->coldTarget--;
+        }
+        return;
+    }
+    this->advance(this->handTest);
+}
+
+void ClockProPolicy::balanceHot() {
+    size_t maxHot = (this->capacity > this->coldTarget) ? this->capacity - this->coldTarget : 0;
+    // each hot page needs at most two steps to be demoted
+    size_t maxSteps = 2 * this->clock.size() + 2;
+    while ((this->numHot > maxHot) && (maxSteps > 0)) {
+        this->runHandHot();
+        maxSteps--;
+    }
+}
+
+void ClockProPolicy::pageCached(CacheKey key) {
+    auto iter = this->positions.find(key);
+    if (iter == this->positions.end()) {
+        this->insert(key, ColdPage);
+        this->numCold++;
+    } else if (iter->second->type == TestPage) {
+        // reused during its test period: the cold pages were too few to keep it
+        this->coldTarget = std::min(this->capacity, this->coldTarget + 1);
+        this->erase(iter->second);
+        this->numTest--;
+        this->insert(key, HotPage);
+        this->numHot++;
+    } else {
+        iter->second->referenced = true;
+    }
+    if (this->numHot + this->numCold > this->capacity) {
+        this->capacity = this->numHot + this->numCold;
+    }
+    this->balanceHot();
+}
+
+void ClockProPolicy::pageAccessed(CacheKey key) {
+    auto iter = this->positions.find(key);
+    if ((iter == this->positions.end()) || (iter->second->type == TestPage)) {
+        this->pageCached(key);
+        return;
+    }
+    iter->second->referenced = true;
+}
+
+void ClockProPolicy::pageRemoved(CacheKey key) {
+    auto iter = this->positions.find(key);
+    if (iter == this->positions.end()) {
+        return;
+    }
+    list<ClockEntry>::iterator it = iter->second;
+    if (it->type == ColdPage) {
+        // an evicted cold page starts its test period
+        it->type = TestPage;
+        it->referenced = false;
+        this->numCold--;
+        this->numTest++;
+        if (this->handCold == it) {
+            this->advance(this->handCold);
+        }
+        size_t maxSteps = 2 * this->clock.size() + 2;
+        while ((this->numTest > this->capacity) && (maxSteps > 0)) {
+            this->runHandTest();
+            maxSteps--;
+        }
+    } else if (it->type == HotPage) {
+        this->erase(it);
+        this->numHot--;
+    }
+}
+
+bool ClockProPolicy::selectVictim(const std::function<bool(const CacheKey&)>& isEvictable,
+                                  CacheKey& victim) {
+    if (this->numHot + this->numCold == 0) {
+        return false;
+    }
+    size_t maxSteps = 3 * this->clock.size() + 3;
+    while (maxSteps > 0) {
+        maxSteps--;
+        if (this->numCold == 0) {
+            // only hot pages are left, so demote one
+            this->runHandHot();
+            continue;
+        }
+        ClockEntry& entry = *(this->handCold);
+        if (entry.type == ColdPage) {
+            if (entry.referenced == true) {
+                // reused within its test period: promote it
+                entry.type = HotPage;
+                entry.referenced = false;
+                this->numCold--;
+                this->numHot++;
+                this->advance(this->handCold);
+                this->balanceHot();
+                continue;
+            }
+            if (isEvictable(entry.key) == true) {
+                // the hand stays here until the page is removed
+                victim = entry.key;
+                return true;
+            }
+        }
+        this->advance(this->handCold);
+    }
+    // all cold pages are pinned, so fall back to any evictable page
+    for (auto it = this->clock.begin(); it != this->clock.end(); ++it) {
+        if ((it->type != TestPage) && (isEvictable(it->key) == true)) {
+            victim = it->key;
+            return true;
+        }
+    }
+    return false;
+}
+
+#endif
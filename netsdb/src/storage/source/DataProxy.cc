@@ -41,6 +41,16 @@ DataProxy::DataProxy(NodeID nodeId,
 
 DataProxy::~DataProxy() {}
 
+// pins and unpins go through the shared-memory command ring while the frontend polls it, which
+// saves a socket round trip per page; returns false if the caller must use the socket instead
+bool DataProxy::submitToRing(ShmCommand& command) {
+    SharedMemRingPtr ring = this->shm->getCommandRing();
+    if (ring == nullptr) {
+        return false;
+    }
+    return ring->submit(command);
+}
+
 bool DataProxy::addTempSet(string setName, SetID& setId, bool needMem, int numTries) {
     if (numTries == MAX_RETRIES) {
         return false;
@@ -218,6 +228,33 @@ bool DataProxy::addUserPage(
         logger->error(std::string("DataProxy: addUserPage with numTries=") +
                       std::to_string(numTries));
     }
+    {
+        ShmCommand command;
+        command.type = ShmPinPage;
+        command.nodeId = this->nodeId;
+        command.dbId = dbId;
+        command.typeId = typeId;
+        command.setId = setId;
+        command.pageId = 0;
+        command.wasNewPage = true;
+        if (this->submitToRing(command) == true) {
+            if (command.success == false) {
+                return false;
+            }
+            char* dataIn = (char*)this->shm->getPointer(command.sharedMemOffset);
+            page = make_shared<PDBPage>(dataIn,
+                                        this->nodeId,
+                                        dbId,
+                                        typeId,
+                                        setId,
+                                        command.resultPageId,
+                                        command.pageSize,
+                                        command.sharedMemOffset);
+            page->setPinned(true);
+            page->setDirty(true);
+            return true;
+        }
+    }
     string errMsg;
     if (this->communicator->isSocketClosed() == true) {
         std::cout << "ERROR in DataProxy: connection is closed" << std::endl;
@@ -447,6 +484,26 @@ bool DataProxy::pinUserPage(NodeID nodeId,
         logger->error(std::string("DataProxy: pinUserPage with numTries=") +
                       std::to_string(numTries));
     }
+    if (nodeId == this->nodeId) {
+        ShmCommand command;
+        command.type = ShmPinPage;
+        command.nodeId = nodeId;
+        command.dbId = dbId;
+        command.typeId = typeId;
+        command.setId = setId;
+        command.pageId = pageId;
+        command.wasNewPage = false;
+        if (this->submitToRing(command) == true) {
+            if (command.success == false) {
+                return false;
+            }
+            char* dataIn = (char*)this->shm->getPointer(command.sharedMemOffset);
+            page = make_shared<PDBPage>(dataIn, command.sharedMemOffset, 0);
+            page->setPinned(true);
+            page->setDirty(false);
+            return true;
+        }
+    }
     std::string errMsg;
     if (this->communicator->isSocketClosed() == true) {
         std::cout << "ERROR in DataProxy: connection is closed" << std::endl;
@@ -565,6 +622,20 @@ bool DataProxy::unpinUserPage(NodeID nodeId,
         logger->error(std::string("DataProxy: unpinUserPage with numTries=") +
                       std::to_string(numTries));
     }
+    {
+        ShmCommand command;
+        command.type = ShmUnpinPage;
+        command.nodeId = nodeId;
+        command.dbId = dbId;
+        command.typeId = typeId;
+        command.setId = setId;
+        command.pageId = page->getPageID();
+        command.wasNewPage = false;
+        command.wasDirty = page->isDirty();
+        if (this->submitToRing(command) == true) {
+            return command.success;
+        }
+    }
     std::string errMsg;
     if (this->communicator->isSocketClosed() == true) {
         std::cout << "ERROR in DataProxy: connection is closed" << std::endl;
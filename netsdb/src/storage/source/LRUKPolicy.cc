@@ -0,0 +1,87 @@
+#ifndef LRU_K_POLICY_CC
+#define LRU_K_POLICY_CC
+
+#include "LRUKPolicy.h"
+
+LRUKPolicy::LRUKPolicy(size_t capacity, unsigned int k) {
+    this->capacity = (capacity == 0) ? 1 : capacity;
+    this->k = (k == 0) ? 1 : k;
+}
+
+LRUKPolicy::~LRUKPolicy() {}
+
+pair<long, long> LRUKPolicy::getOrderKey(LRUKHistory& history) {
+    long kthAccess = -1;
+    if (history.accesses.size() >= this->k) {
+        kthAccess = history.accesses[this->k - 1];
+    }
+    return make_pair(kthAccess, history.accesses[0]);
+}
+
+void LRUKPolicy::recordAccess(LRUKHistory& history) {
+    history.accesses.insert(history.accesses.begin(), this->clock++);
+    if (history.accesses.size() > this->k) {
+        history.accesses.pop_back();
+    }
+}
+
+void LRUKPolicy::pageCached(CacheKey key) {
+    auto iter = this->histories.find(key);
+    if (iter == this->histories.end()) {
+        LRUKHistory history;
+        history.cached = true;
+        this->recordAccess(history);
+        this->order[this->getOrderKey(history)] = key;
+        this->histories[key] = history;
+    } else if (iter->second.cached == false) {
+        this->retained.erase(iter->second.retainedPosition);
+        iter->second.cached = true;
+        this->recordAccess(iter->second);
+        this->order[this->getOrderKey(iter->second)] = key;
+    } else {
+        this->pageAccessed(key);
+        return;
+    }
+    if (this->order.size() > this->capacity) {
+        this->capacity = this->order.size();
+    }
+}
+
+void LRUKPolicy::pageAccessed(CacheKey key) {
+    auto iter = this->histories.find(key);
+    if ((iter == this->histories.end()) || (iter->second.cached == false)) {
+        this->pageCached(key);
+        return;
+    }
+    this->order.erase(this->getOrderKey(iter->second));
+    this->recordAccess(iter->second);
+    this->order[this->getOrderKey(iter->second)] = key;
+}
+
+void LRUKPolicy::pageRemoved(CacheKey key) {
+    auto iter = this->histories.find(key);
+    if ((iter == this->histories.end()) || (iter->second.cached == false)) {
+        return;
+    }
+    this->order.erase(this->getOrderKey(iter->second));
+    iter->second.cached = false;
+    this->retained.push_back(key);
+    iter->second.retainedPosition = std::prev(this->retained.end());
+    while (this->retained.size() > this->capacity) {
+        this->histories.erase(this->retained.front());
+        this->retained.pop_front();
+    }
+}
+
+bool LRUKPolicy::selectVictim(const std::function<bool(const CacheKey&)>& isEvictable,
+                              CacheKey& victim) {
+    for (auto it = this->order.begin(); it != this->order.end(); ++it) {
+        if (isEvictable(it->second) == true) {
+            victim = it->second;
+            return true;
+        }
+    }
+    return false;
+}
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef LRU_POLICY_CC
+#define LRU_POLICY_CC
+
+#include "LRUPolicy.h"
+
+LRUPolicy::LRUPolicy(bool mru) {
+    this->mru = mru;
+}
+
+LRUPolicy::~LRUPolicy() {}
+
+void LRUPolicy::pageCached(CacheKey key) {
+    auto iter = this->positions.find(key);
+    if (iter != this->positions.end()) {
+        this->pages.splice(this->pages.end(), this->pages, iter->second);
+        return;
+    }
+    this->pages.push_back(key);
+    this->positions[key] = std::prev(this->pages.end());
+}
+
+void LRUPolicy::pageAccessed(CacheKey key) {
+    this->pageCached(key);
+}
+
+void LRUPolicy::pageRemoved(CacheKey key) {
+    auto iter = this->positions.find(key);
+    if (iter == this->positions.end()) {
+        return;
+    }
+    this->pages.erase(iter->second);
+    this->positions.erase(iter);
+}
+
+bool LRUPolicy::selectVictim(const std::function<bool(const CacheKey&)>& isEvictable,
+                             CacheKey& victim) {
+    if (this->mru == true) {
+        for (auto it = this->pages.rbegin(); it != this->pages.rend(); ++it) {
+            if (isEvictable(*it) == true) {
+                victim = *it;
+                return true;
+            }
+        }
+    } else {
+        for (auto it = this->pages.begin(); it != this->pages.end(); ++it) {
+            if (isEvictable(*it) == true) {
+                victim = *it;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+#endif
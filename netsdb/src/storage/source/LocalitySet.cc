@@ -3,6 +3,7 @@
 #define LOCALITY_SET_CC
 
 #include "LocalitySet.h"
+#include <algorithm>
 #include <iostream>
 LocalitySet::LocalitySet(LocalityType localityType,
                          LocalitySetReplacementPolicy replacementPolicy,
@@ -12,7 +13,7 @@ LocalitySet::LocalitySet(LocalityType localityType,
                          size_t desiredSize,
 			 bool isShared) {
 
-    cachedPages = new list<PDBPagePtr>();
+    cachedPages = new unordered_map<CacheKey, PDBPagePtr, CacheKeyHash, CacheKeyEqual>();
     this->localityType = localityType;
     this->replacementPolicy = replacementPolicy;
     this->operationType = operationType;
@@ -21,6 +22,7 @@ LocalitySet::LocalitySet(LocalityType localityType,
     this->lifetimeEnded = false;
     this->desiredSize = desiredSize;
     this->isShared = isShared;
+    this->policy = PageReplacementPolicy::create(replacementPolicy, desiredSize);
     pthread_mutex_init(&localitySetCacheMutex, nullptr);
 
 }
@@ -30,103 +32,111 @@ LocalitySet::~LocalitySet() {
     delete cachedPages;
 }
 
+static CacheKey getCacheKey(PDBPagePtr page) {
+    CacheKey key;
+    key.dbId = page->getDbID();
+    key.typeId = page->getTypeID();
+    key.setId = page->getSetID();
+    key.pageId = page->getPageID();
+    return key;
+}
+
+// pages of one set may live in different PageCache shards, so the pages and the policy are guarded
+// by the set's own mutex instead of relying on a cache-wide lock
 void LocalitySet::addCachedPage(PDBPagePtr page) {
-    cachedPages->push_back(page);
+    CacheKey key = getCacheKey(page);
+    pthread_mutex_lock(&localitySetCacheMutex);
+    (*cachedPages)[key] = page;
+    policy->pageCached(key);
+    pthread_mutex_unlock(&localitySetCacheMutex);
 }
 
 void LocalitySet::updateCachedPage(PDBPagePtr page) {
-    for (list<PDBPagePtr>::iterator it = cachedPages->begin(); it != cachedPages->end(); ++it) {
-        if ((*it) == page) {
-            pthread_mutex_lock(&localitySetCacheMutex);
-            cachedPages->erase(it);
-            pthread_mutex_unlock(&localitySetCacheMutex);
-            break;
-        }
-    }
+    CacheKey key = getCacheKey(page);
     pthread_mutex_lock(&localitySetCacheMutex);
-    cachedPages->push_back(page);
+    if (cachedPages->find(key) == cachedPages->end()) {
+        (*cachedPages)[key] = page;
+        policy->pageCached(key);
+    } else {
+        (*cachedPages)[key] = page;
+        policy->pageAccessed(key);
+    }
     pthread_mutex_unlock(&localitySetCacheMutex);
 }
 
 void LocalitySet::removeCachedPage(PDBPagePtr page) {
-    for (list<PDBPagePtr>::iterator it = cachedPages->begin(); it != cachedPages->end(); ++it) {
-        if ((*it) == page) {
-            cachedPages->erase(it);
-            break;
-        }
+    CacheKey key = getCacheKey(page);
+    pthread_mutex_lock(&localitySetCacheMutex);
+    auto iter = cachedPages->find(key);
+    if ((iter != cachedPages->end()) && (iter->second == page)) {
+        cachedPages->erase(iter);
+        policy->pageRemoved(key);
     }
+    pthread_mutex_unlock(&localitySetCacheMutex);
 }
 
 bool LocalitySet::getShared() {
    return isShared;
 }
 
-
+void LocalitySet::rebuildPolicy() {
+    vector<PDBPagePtr> pages;
+    for (auto& cachedPage : *cachedPages) {
+        pages.push_back(cachedPage.second);
+    }
+    std::sort(pages.begin(), pages.end(), [](const PDBPagePtr& lPage, const PDBPagePtr& rPage) {
+        return lPage->getAccessSequenceId() < rPage->getAccessSequenceId();
+    });
+    policy = PageReplacementPolicy::create(replacementPolicy, std::max(desiredSize, pages.size()));
+    for (auto& page : pages) {
+        policy->pageCached(getCacheKey(page));
+    }
+}
 
 PDBPagePtr LocalitySet::selectPageForReplacement() {
     PDBPagePtr retPage = nullptr;
-    if (this->replacementPolicy == MRU) {
-        for (list<PDBPagePtr>::reverse_iterator it = cachedPages->rbegin();
-             it != cachedPages->rend();
-             ++it) {
-            if ((*it)->getRefCount() == 0) {
-                retPage = (*it);
-                break;
-            }
-        }
-    } else {
-        for (list<PDBPagePtr>::iterator it = cachedPages->begin(); it != cachedPages->end(); ++it) {
-            if ((*it)->getRefCount() == 0) {
-                retPage = (*it);
-                break;
-            }
-        }
+    pthread_mutex_lock(&localitySetCacheMutex);
+    CacheKey victim;
+    auto isEvictable = [&](const CacheKey& key) -> bool {
+        return cachedPages->at(key)->getRefCount() == 0;
+    };
+    if (policy->selectVictim(isEvictable, victim) == true) {
+        retPage = cachedPages->at(victim);
     }
+    pthread_mutex_unlock(&localitySetCacheMutex);
     return retPage;
 }
 
 vector<PDBPagePtr>* LocalitySet::selectPagesForReplacement() {
     vector<PDBPagePtr>* retPages = new vector<PDBPagePtr>();
+    pthread_mutex_lock(&localitySetCacheMutex);
     int totalPages = cachedPages->size();
     if (totalPages == 0) {
+        pthread_mutex_unlock(&localitySetCacheMutex);
         delete retPages;
         return nullptr;
     }
-    int numPages = 0;
-    if (this->replacementPolicy == MRU) {
-        for (list<PDBPagePtr>::reverse_iterator it = cachedPages->rbegin();
-             it != cachedPages->rend();
-             ++it) {
-            if ((*it)->getRefCount() == 0) {
-                retPages->push_back(*it);
-                numPages++;
-                if (this->operationType == Write) {
-                    break;
-                } else {
-                    if (numPages == 1) {
-                    /*if ((double)numPages / (double)totalPages >= (1-EVICT_STOP_THRESHOLD)) {*/
-                        break;
-                    }
-                }
-            }
-        }
-    } else {
-        for (list<PDBPagePtr>::iterator it = cachedPages->begin(); it != cachedPages->end(); ++it) {
-            if ((*it)->getRefCount() == 0) {
-                retPages->push_back(*it);
-                numPages++;
-                if (this->operationType == Write) {
-                    break;
-                } else {
-                    /*if (numPages == 1) {*/
-                    if ((double)numPages / (double)totalPages >= (1-EVICT_STOP_THRESHOLD)) {
-                        break;
-                    }
-                }
-            }
+    // an MRU set or a set being written gives up one page at a time, other sets give up the
+    // fraction of their pages that brings the cache back to the eviction stop size
+    int maxPages = 1;
+    if ((this->operationType != Write) && (this->replacementPolicy != MRU)) {
+        maxPages = (int)((double)totalPages * (1 - EVICT_STOP_THRESHOLD));
+        if (maxPages < 1) {
+            maxPages = 1;
         }
     }
-    if (numPages == 0) {
+    unordered_map<CacheKey, bool, CacheKeyHash, CacheKeyEqual> selected;
+    auto isEvictable = [&](const CacheKey& key) -> bool {
+        return (cachedPages->at(key)->getRefCount() == 0) && (selected.count(key) == 0);
+    };
+    CacheKey victim;
+    while (((int)retPages->size() < maxPages) &&
+           (policy->selectVictim(isEvictable, victim) == true)) {
+        selected[victim] = true;
+        retPages->push_back(cachedPages->at(victim));
+    }
+    pthread_mutex_unlock(&localitySetCacheMutex);
+    if (retPages->size() == 0) {
         delete retPages;
         return nullptr;
     } else {
@@ -134,9 +144,24 @@ vector<PDBPagePtr>* LocalitySet::selectPagesForReplacement() {
     }
 }
 
+double LocalitySet::computeEvictionCost() {
+    PDBPagePtr pageToEvict = this->selectPageForReplacement();
+    if (pageToEvict == nullptr) {
+        this->evictionCost = 0;
+        return this->evictionCost;
+    }
+    long referenceDistance = this->getReferenceDistance(pageToEvict->getAccessSequenceId());
+    if (referenceDistance < 1) {
+        referenceDistance = 1;
+    }
+    double reuseProb = (double)(1) / (double)(referenceDistance);
+    this->evictionCost = this->getWriteCost() + reuseProb * this->getReadCost();
+    return this->evictionCost;
+}
+
 
 void LocalitySet::pin(LocalitySetReplacementPolicy policy, OperationType operationType) {
-    this->replacementPolicy = policy;
+    this->setReplacementPolicy(policy);
     this->operationType = operationType;
     this->lifetimeEnded = false;
 }
@@ -159,7 +184,12 @@ LocalitySetReplacementPolicy LocalitySet::getReplacementPolicy() {
 }
 
 void LocalitySet::setReplacementPolicy(LocalitySetReplacementPolicy policy) {
-    this->replacementPolicy = policy;
+    pthread_mutex_lock(&localitySetCacheMutex);
+    if (this->replacementPolicy != policy) {
+        this->replacementPolicy = policy;
+        this->rebuildPolicy();
+    }
+    pthread_mutex_unlock(&localitySetCacheMutex);
 }
 
 OperationType LocalitySet::getOperationType() {
@@ -1,6 +1,7 @@
 #include "PDBDebug.h"
 #include "PDBFlushConsumerWork.h"
 #include "PageCircularBuffer.h"
+#include <algorithm>
 #include <chrono>
 #include <ctime>
 #include <fcntl.h>
@@ -12,6 +13,10 @@ PDBFlushConsumerWork::PDBFlushConsumerWork(FilePartitionID partitionId,
     this->partitionId = partitionId;
     this->server = server;
     this->isStopped = false;
+    this->batchSize = server->getConf()->getFlushBatchSize();
+    if (this->batchSize == 0) {
+        this->batchSize = 1;
+    }
 }
 
 void PDBFlushConsumerWork::stop() {
@@ -21,84 +26,115 @@ void PDBFlushConsumerWork::stop() {
 
 void PDBFlushConsumerWork::execute(PDBBuzzerPtr callerBuzzer) {
     PageCircularBufferPtr flushBuffer = this->server->getFlushBuffer();
-    PDBPagePtr page;
-    SetPtr set = nullptr;
+    vector<PDBPagePtr> pages;
+    vector<vector<PDBPagePtr>> batches;
     while (!isStopped) {
-        if ((page = flushBuffer->popPageFromHead()) != nullptr) {
-            // got a page from flush buffer
-            // find the set of the page
-          
-            std::cout << "Got a page with PageID " << page->getPageID()
-                     << " for partition:" << this->partitionId << "\n";
-            std::cout << "page dbId=" << page->getDbID() << "\n";
-            std::cout << "page typeId=" << page->getTypeID() << "\n";
-            std::cout << "page setId=" << page->getSetID() << "\n";
-            bool isTempSet = false;
-            if ((page->getDbID() == 0) && (page->getTypeID() == 0)) {
-                set = this->server->getTempSet(page->getSetID());
-                isTempSet = true;
-            } else {
-                set = this->server->getSet(page->getDbID(), page->getTypeID(), page->getSetID());
-                isTempSet = false;
-            }
-            CacheKey key;
-            key.dbId = page->getDbID();
-            key.typeId = page->getTypeID();
-            key.setId = page->getSetID();
-            key.pageId = page->getPageID();
-            this->server->getCache()->flushLock();
-            if ((set != nullptr) && (page->getRawBytes() != nullptr)) {
-
-                // append the page to the partition
-                int ret = set->getFile()->appendPage(this->partitionId, page);
-                if (ret < 0) {
-                    PDB_COUT << "Can't write page with below info:\n";
-                    PDB_COUT << "Got a page with PageID " << page->getPageID()
-                             << " for partition:" << this->partitionId << "\n";
-                    PDB_COUT << "page dbId=" << page->getDbID() << "\n";
-                    PDB_COUT << "page typeId=" << page->getTypeID() << "\n";
-                    PDB_COUT << "page setId=" << page->getSetID() << "\n";
-                }
-                set->lockDirtyPageSet();
-                if (isTempSet == false) {                    
-                    PDB_COUT << "to write meta" << std::endl;
-                    set->getFile()->writeMeta();
+        pages.clear();
+        if (flushBuffer->popPagesFromHead(pages, this->batchSize) == 0) {
+            continue;
+        }
+        // group the pages by set, and order them by page id, so that the pages of a set
+        // go to the partition in one write and are laid out in the order they are scanned
+        batches.clear();
+        for (PDBPagePtr& page : pages) {
+            bool found = false;
+            for (vector<PDBPagePtr>& batch : batches) {
+                if ((batch[0]->getDbID() == page->getDbID()) &&
+                    (batch[0]->getTypeID() == page->getTypeID()) &&
+                    (batch[0]->getSetID() == page->getSetID())) {
+                    batch.push_back(page);
+                    found = true;
+                    break;
                 }
-                set->removePageFromDirtyPageSet(page->getPageID(), this->partitionId, ret);
-                set->unlockDirtyPageSet();
-                std::cout << "page with PageID " << page->getPageID()
-                         << " appended to partition with PartitionID " << this->partitionId << "\n";
             }
+            if (found == false) {
+                batches.push_back(vector<PDBPagePtr>(1, page));
+            }
+        }
+        for (vector<PDBPagePtr>& batch : batches) {
+            std::sort(batch.begin(), batch.end(), [](const PDBPagePtr& a, const PDBPagePtr& b) {
+                return a->getPageID() < b->getPageID();
+            });
+            this->flushBatch(batch);
+        }
+    }
+    PDB_COUT << "flushing thread stopped running for partition: " << partitionId << "\n";
+}
+
+void PDBFlushConsumerWork::flushBatch(vector<PDBPagePtr>& batch) {
+    PDBPagePtr first = batch[0];
+    SetPtr set = nullptr;
+    bool isTempSet = false;
+    if ((first->getDbID() == 0) && (first->getTypeID() == 0)) {
+        set = this->server->getTempSet(first->getSetID());
+        isTempSet = true;
+    } else {
+        set = this->server->getSet(first->getDbID(), first->getTypeID(), first->getSetID());
+        isTempSet = false;
+    }
+    vector<CacheKey> keys;
+    vector<PDBPagePtr> pagesToWrite;
+    for (PDBPagePtr& page : batch) {
+        CacheKey key;
+        key.dbId = page->getDbID();
+        key.typeId = page->getTypeID();
+        key.setId = page->getSetID();
+        key.pageId = page->getPageID();
+        keys.push_back(key);
+        if ((set != nullptr) && (page->getRawBytes() != nullptr)) {
+            pagesToWrite.push_back(page);
+        }
+    }
+    PageCachePtr cache = this->server->getCache();
+    cache->flushLock(keys);
+    if (pagesToWrite.size() > 0) {
+        // append the pages to the partition
+        vector<int> seqs;
+        if (set->getFile()->appendPages(this->partitionId, pagesToWrite, seqs) < 0) {
+            PDB_COUT << "Can't write " << pagesToWrite.size() << " pages of set with dbId="
+                     << first->getDbID() << ", typeId=" << first->getTypeID()
+                     << ", setId=" << first->getSetID() << " to partition "
+                     << this->partitionId << "\n";
+            seqs.assign(pagesToWrite.size(), -1);
+        }
+        set->lockDirtyPageSet();
+        if (isTempSet == false) {
+            PDB_COUT << "to write meta" << std::endl;
+            set->getFile()->writeMeta();
+        }
+        for (size_t i = 0; i < pagesToWrite.size(); i++) {
+            set->removePageFromDirtyPageSet(
+                pagesToWrite[i]->getPageID(), this->partitionId, seqs[i]);
+        }
+        set->unlockDirtyPageSet();
+        PDB_COUT << pagesToWrite.size() << " pages appended to partition with PartitionID "
+                 << this->partitionId << "\n";
+    }
+    for (size_t i = 0; i < batch.size(); i++) {
+        PDBPagePtr page = batch[i];
 #ifndef UNPIN_FOR_NON_ZERO_REF_COUNT
-            if ((page->getRawBytes() != nullptr) && (page->getRefCount() == 0) &&
-                (page->isInEviction() == true)) {
+        if ((page->getRawBytes() != nullptr) && (page->getRefCount() == 0) &&
+            (page->isInEviction() == true)) {
 #else
-            if ((page->getRawBytes() != nullptr) && (page->isInEviction() == true)) {
+        if ((page->getRawBytes() != nullptr) && (page->isInEviction() == true)) {
 #endif
-                
-                // remove the page from cache!
-                this->server->getSharedMem()->free(page->getRawBytes() - page->getInternalOffset(),
-                                                   page->getSize() + 512);
-                PDB_COUT << "internalOffset=" << page->getInternalOffset() << "\n";
-                page->setOffset(0);
-                page->setRawBytes(nullptr);
-            }
-// remove the page from cache!
+            // remove the page from cache!
+            this->server->getSharedMem()->free(page->getRawBytes() - page->getInternalOffset(),
+                                               page->getSize() + 512);
+            PDB_COUT << "internalOffset=" << page->getInternalOffset() << "\n";
+            page->setOffset(0);
+            page->setRawBytes(nullptr);
+        }
 #ifndef UNPIN_FOR_NON_ZERO_REF_COUNT
-            if ((page->getRefCount() == 0) && (page->isInEviction() == true)) {
+        if ((page->getRefCount() == 0) && (page->isInEviction() == true)) {
 #else
-            if (page->isInEviction() == true) {
+        if (page->isInEviction() == true) {
 #endif
-                this->server->getCache()->removePage(key);
-            }  
-            page->setInFlush(false);
-            page->setDirty(false);
-            
-            std::cout << "PDBFlushConsumerWork: page freed from cache" << std::endl;
-            this->server->getCache()->flushUnlock();
-            this->server->getLogger()->writeLn(
-                "PDBFlushConsumerWork: unlocked for flushUnlock()...");
+            cache->removePage(keys[i]);
         }
+        page->setInFlush(false);
+        page->setDirty(false);
     }
-    PDB_COUT << "flushing thread stopped running for partition: " << partitionId << "\n";
+    cache->flushUnlock(keys);
+    this->server->getLogger()->writeLn("PDBFlushConsumerWork: unlocked for flushUnlock()...");
 }
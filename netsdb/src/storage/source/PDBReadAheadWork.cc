@@ -0,0 +1,25 @@
+#ifndef PDB_READ_AHEAD_WORK_CC
+#define PDB_READ_AHEAD_WORK_CC
+
+#include "PDBDebug.h"
+#include "PDBReadAheadWork.h"
+
+PDBReadAheadWork::PDBReadAheadWork(PageCache* cache, PageReadAheadQueuePtr queue) {
+    this->cache = cache;
+    this->queue = queue;
+}
+
+PDBReadAheadWork::~PDBReadAheadWork() {}
+
+void PDBReadAheadWork::execute(PDBBuzzerPtr callerBuzzer) {
+    ReadAheadRequest request;
+    while (this->queue->getRequest(request) == true) {
+        this->cache->loadPageForReadAhead(request);
+        this->queue->completeRequest(request.key);
+        request.file = nullptr;
+    }
+    PDB_COUT << "read-ahead thread stopped running\n";
+    callerBuzzer->buzz(PDBAlarm::WorkAllDone);
+}
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef PDB_SHM_RING_POLLER_WORK_CC
+#define PDB_SHM_RING_POLLER_WORK_CC
+
+#include "PDBDebug.h"
+#include "PDBShmRingPollerWork.h"
+#include <sched.h>
+#include <unistd.h>
+
+// number of empty polls before yielding the cpu, and before sleeping between polls
+#define POLLER_SPIN_COUNT 1024
+#define POLLER_YIELD_COUNT 16384
+#define POLLER_SLEEP_MICROSECONDS 50
+
+PDBShmRingPollerWork::PDBShmRingPollerWork(SharedMemRingPtr ring,
+                                           pdb::PangeaStorageServer* server) {
+    this->ring = ring;
+    this->server = server;
+}
+
+PDBShmRingPollerWork::~PDBShmRingPollerWork() {}
+
+// the poller spins while the backend is busy, and backs off to short sleeps when it is idle
+void PDBShmRingPollerWork::execute(PDBBuzzerPtr callerBuzzer) {
+    unsigned int numEmptyPolls = 0;
+    auto runCommand = [&](ShmCommand& command) { this->server->runShmCommand(command); };
+    while (this->ring->isServiced() == true) {
+        if (this->ring->poll(runCommand) == true) {
+            numEmptyPolls = 0;
+        } else if (++numEmptyPolls < POLLER_SPIN_COUNT) {
+            continue;
+        } else if (numEmptyPolls < POLLER_YIELD_COUNT) {
+            sched_yield();
+        } else {
+            usleep(POLLER_SLEEP_MICROSECONDS);
+        }
+    }
+    // run the commands submitted before the ring stopped being serviced
+    while (this->ring->poll(runCommand) == true) {
+    }
+    PDB_COUT << "shared memory ring poller stopped running\n";
+    callerBuzzer->buzz(PDBAlarm::WorkAllDone);
+}
+
+#endif
@@ -7,8 +7,12 @@
 #include "PDBDebug.h"
 #include "PageCache.h"
 #include "PDBEvictWork.h"
+#include "PageReadAheadQueue.h"
+#include "PDBReadAheadWork.h"
+#include "PaxPage.h"
 
 #include <queue>
+#include <algorithm>
 #include <stdlib.h>
 #include <sched.h>
 using namespace std;
@@ -24,13 +28,15 @@ PageCache::PageCache(ConfigurationPtr conf,
                      pdb::PDBLoggerPtr logger,
                      SharedMemPtr shm,
                      CacheStrategy strategy) {
-    this->cache = new unordered_map<CacheKey, PDBPagePtr, CacheKeyHash, CacheKeyEqual>();
     this->conf = conf;
     this->workers = workers;
-    pthread_mutex_init(&this->countLock, nullptr);
-    pthread_mutex_init(&this->cacheMutex, nullptr);
+    this->numShards = conf->getNumCacheShards();
+    for (unsigned int i = 0; i < this->numShards; i++) {
+        this->shards.push_back(new PageCacheShard());
+    }
+    std::cout << "PageCache: partitioned into " << this->numShards << " shards" << std::endl;
     pthread_mutex_init(&this->evictionMutex, nullptr);
-    pthread_rwlock_init(&this->evictionAndFlushLock, nullptr);
+    pthread_mutex_init(&this->readAheadMutex, nullptr);
     accessCount = 0;
     this->inEviction = false;
     this->maxSize = conf->getShmSize();
@@ -54,9 +60,52 @@ PageCache::PageCache(ConfigurationPtr conf,
     std::cout << "PageCache: EVICT_STOP_SIZE is automatically tuned to be " << this->evictStopSize
               << std::endl;
     this->flushBuffer = flushBuffer;
+    this->flushBackPressureDepth = 0;
+    if ((flushBuffer != nullptr) && (conf->getFlushBackPressurePercent() > 0)) {
+        this->flushBackPressureDepth =
+            flushBuffer->getCapacity() * conf->getFlushBackPressurePercent() / 100;
+        if (this->flushBackPressureDepth == 0) {
+            this->flushBackPressureDepth = 1;
+        }
+    }
     this->logger = logger;
     this->shm = shm;
     this->strategy = strategy;
+    this->readAheadWindow = conf->getReadAheadWindow();
+    this->numReadAheadThreads = conf->getNumReadAheadThreads();
+    if (this->numReadAheadThreads == 0) {
+        this->readAheadWindow = 0;
+    }
+    this->readAheadQueue = nullptr;
+    if (this->readAheadWindow > 0) {
+        // allow each read-ahead thread to have a few windows of requests queued
+        this->readAheadQueue = make_shared<PageReadAheadQueue>(
+            4 * this->readAheadWindow * this->numReadAheadThreads);
+    }
+    std::cout << "PageCache: read-ahead window is " << this->readAheadWindow << " pages"
+              << std::endl;
+    // each shard expects its share of the pages of the default size
+    size_t policyCapacity = this->maxSize / (conf->getPageSize() + 512) / this->numShards;
+    for (unsigned int i = 0; i < this->numShards; i++) {
+        this->shards[i]->policy = PageReplacementPolicy::create(strategy, policyCapacity);
+    }
+    if (this->shards[0]->policy != nullptr) {
+        std::cout << "PageCache: replacement policy is " << this->shards[0]->policy->getName()
+                  << std::endl;
+    }
+    if (conf->getCacheTraceFile() != "") {
+        this->stats.startTrace(conf->getCacheTraceFile());
+    }
+    this->secondTier = nullptr;
+    if (conf->getSecondTierCacheFile() != "") {
+        this->secondTier = make_shared<SecondTierCache>(conf->getSecondTierCacheFile(),
+                                                        conf->getSecondTierCacheSize(),
+                                                        conf->getPageSize(),
+                                                        logger);
+        if (this->secondTier->isOpen() == false) {
+            this->secondTier = nullptr;
+        }
+    }
     this->priorityList = new vector<list<LocalitySetPtr>*>();
     int i;
     for (i = 0; i < 6; i++) {
@@ -70,11 +119,41 @@ PageCache::PageCache(ConfigurationPtr conf,
 }
 
 PageCache::~PageCache() {
-    delete this->cache;
-    pthread_mutex_destroy(&this->countLock);
-    pthread_mutex_destroy(&this->cacheMutex);
+    this->stopReadAheadThreads();
+    for (unsigned int i = 0; i < this->numShards; i++) {
+        delete this->shards[i];
+    }
+    this->shards.clear();
     pthread_mutex_destroy(&this->evictionMutex);
-    pthread_rwlock_destroy(&this->evictionAndFlushLock);
+    pthread_mutex_destroy(&this->readAheadMutex);
+}
+
+// Select the shard of a page by mixing the bits of its CacheKeyHash, so that consecutive pages of
+// the same set are spread over all shards.
+unsigned int PageCache::getShardIndex(CacheKey key) {
+    uint64_t hash = CacheKeyHash()(key);
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return hash % this->numShards;
+}
+
+PageCacheShard& PageCache::getShard(CacheKey key) {
+    return *(this->shards[this->getShardIndex(key)]);
+}
+
+vector<unsigned int> PageCache::getShardIndexes(const vector<CacheKey>& keys) {
+    vector<unsigned int> indexes;
+    for (const CacheKey& key : keys) {
+        indexes.push_back(this->getShardIndex(key));
+    }
+    std::sort(indexes.begin(), indexes.end());
+    indexes.erase(std::unique(indexes.begin(), indexes.end()), indexes.end());
+    return indexes;
+}
+
+bool PageCache::containsPageInShard(PageCacheShard& shard, CacheKey key) {
+    return (shard.pages.find(key) != shard.pages.end());
 }
 
 // Cache the page with specified name and buffer;
@@ -87,10 +166,14 @@ void PageCache::cachePage(PDBPagePtr page, LocalitySet* set) {
     key.typeId = page->getTypeID();
     key.setId = page->getSetID();
     key.pageId = page->getPageID();
-    pthread_mutex_lock(&this->cacheMutex);
-    if (this->cache->find(key) == this->cache->end()) {
+    PageCacheShard& shard = this->getShard(key);
+    pthread_mutex_lock(&shard.cacheMutex);
+    if (this->containsPageInShard(shard, key) == false) {
         pair<CacheKey, PDBPagePtr> pair = make_pair(key, page);
-        this->cache->insert(pair);
+        shard.pages.insert(pair);
+        if (shard.policy != nullptr) {
+            shard.policy->pageCached(key);
+        }
         this->size += page->getRawSize() + 512;
         if (set != nullptr) {
             if (this->strategy == UnifiedDBMIN) {
@@ -103,16 +186,22 @@ void PageCache::cachePage(PDBPagePtr page, LocalitySet* set) {
         logger->writeLn("LRUPageCache: page was there already.");
     }
     
+    pthread_mutex_unlock(&shard.cacheMutex);
     if (set != nullptr) {
         set->addCachedPage(page);
     }
-    pthread_mutex_unlock(&this->cacheMutex);
 }
 
 // If there is sufficient room in shared memory, allocate the buffer as required
 // Otherwise, try to evict a page from shared memory.
 // It will block until data can be allocated.
-char* PageCache::allocateBufferFromSharedMemoryBlocking(size_t size, int& alignOffset) {
+char* PageCache::allocateBufferFromSharedMemoryBlocking(size_t size,
+                                                       int& alignOffset,
+                                                       bool throttle) {
+    if ((throttle == true) && (this->flushBackPressureDepth > 0) &&
+        (this->flushBuffer->waitUntilBelow(this->flushBackPressureDepth) == true)) {
+        this->stats.incFlushWaits();
+    }
     // below function is thread-safe
     char* data = (char*)this->shm->mallocAlign(size, 512, alignOffset);
     // Dangerous: dead loop
@@ -146,24 +235,68 @@ char* PageCache::tryAllocateBufferFromSharedMemory(size_t size, int& alignOffset
     return data;
 }
 
-// Lock for eviction.
+// Lock for eviction on all shards, always in the shard order to avoid deadlocks.
 void PageCache::evictionLock() {
-    pthread_rwlock_wrlock(&this->evictionAndFlushLock);
+    for (unsigned int i = 0; i < this->numShards; i++) {
+        pthread_rwlock_wrlock(&this->shards[i]->evictionAndFlushLock);
+    }
 }
 
-// Unlock for eviction.
+// Unlock for eviction on all shards.
 void PageCache::evictionUnlock() {
-    pthread_rwlock_unlock(&this->evictionAndFlushLock);
+    for (int i = this->numShards - 1; i >= 0; i--) {
+        pthread_rwlock_unlock(&this->shards[i]->evictionAndFlushLock);
+    }
+}
+
+// Lock for eviction on the shard of the page.
+void PageCache::evictionLock(CacheKey key) {
+    pthread_rwlock_wrlock(&this->getShard(key).evictionAndFlushLock);
 }
 
-// Lock for flushing.
+// Unlock for eviction on the shard of the page.
+void PageCache::evictionUnlock(CacheKey key) {
+    pthread_rwlock_unlock(&this->getShard(key).evictionAndFlushLock);
+}
+
+// Lock for flushing on all shards.
 void PageCache::flushLock() {
-    pthread_rwlock_rdlock(&this->evictionAndFlushLock);
+    for (unsigned int i = 0; i < this->numShards; i++) {
+        pthread_rwlock_rdlock(&this->shards[i]->evictionAndFlushLock);
+    }
 }
 
-// Unlock for flushing.
+// Unlock for flushing on all shards.
 void PageCache::flushUnlock() {
-    pthread_rwlock_unlock(&this->evictionAndFlushLock);
+    for (int i = this->numShards - 1; i >= 0; i--) {
+        pthread_rwlock_unlock(&this->shards[i]->evictionAndFlushLock);
+    }
+}
+
+// Lock for flushing on the shard of the page.
+void PageCache::flushLock(CacheKey key) {
+    pthread_rwlock_rdlock(&this->getShard(key).evictionAndFlushLock);
+}
+
+// Unlock for flushing on the shard of the page.
+void PageCache::flushUnlock(CacheKey key) {
+    pthread_rwlock_unlock(&this->getShard(key).evictionAndFlushLock);
+}
+
+// Lock for flushing on the shards of the pages, in the shard order as evictionLock() does,
+// and only once for each shard, to avoid deadlocks with writers waiting on the shard locks.
+void PageCache::flushLock(const vector<CacheKey>& keys) {
+    for (unsigned int index : this->getShardIndexes(keys)) {
+        pthread_rwlock_rdlock(&this->shards[index]->evictionAndFlushLock);
+    }
+}
+
+// Unlock for flushing on the shards of the pages.
+void PageCache::flushUnlock(const vector<CacheKey>& keys) {
+    vector<unsigned int> indexes = this->getShardIndexes(keys);
+    for (int i = indexes.size() - 1; i >= 0; i--) {
+        pthread_rwlock_unlock(&this->shards[indexes[i]]->evictionAndFlushLock);
+    }
 }
 
 PDBPagePtr PageCache::buildAndCachePageFromFileHandle(int handle,
@@ -247,7 +380,7 @@ PDBPagePtr PageCache::loadPage(PDBFilePtr file,
         char* pageData = this->allocateBufferFromSharedMemoryBlocking(pageSize, internalOffset);
         // seek to page
         if (sequential == true) {
-            curFile->loadPageFromCurPos(partitionId, pageSeqInPartition, pageData, pageSize);
+            curFile->loadPageAt(partitionId, pageSeqInPartition, pageData, pageSize);
         } else {
             curFile->loadPage(partitionId, pageSeqInPartition, pageData, pageSize);
         }
@@ -280,15 +413,20 @@ PDBPagePtr PageCache::loadPage(SequenceFilePtr file, PageID pageId) {
 // Remove page specified by Key from cache hashMap.
 // This function will be used by the flushConsumer thread.
 bool PageCache::removePage(CacheKey key) {
-    pthread_mutex_lock(&this->cacheMutex);
-    if (this->containsPage(key) == false) {
-        pthread_mutex_unlock(&this->cacheMutex);
+    PageCacheShard& shard = this->getShard(key);
+    pthread_mutex_lock(&shard.cacheMutex);
+    if (this->containsPageInShard(shard, key) == false) {
+        pthread_mutex_unlock(&shard.cacheMutex);
         return false;
     }
-    size_t pageSizeAllocated = this->cache->at(key)->getRawSize() + 512;
-    this->cache->erase(key);
+    size_t pageSizeAllocated = shard.pages.at(key)->getRawSize() + 512;
+    shard.pages.erase(key);
+    if (shard.policy != nullptr) {
+        shard.policy->pageRemoved(key);
+    }
+    this->claimReadAheadPage(key);
     this->size -= pageSizeAllocated;
-    pthread_mutex_unlock(&this->cacheMutex);
+    pthread_mutex_unlock(&shard.cacheMutex);
     return true;
 }
 
@@ -301,15 +439,20 @@ bool PageCache::freePage(PDBPagePtr curPage) {
     key.setId = curPage->getSetID();
     key.pageId = curPage->getPageID();
 
-    pthread_mutex_lock(&this->cacheMutex);
-    if (this->containsPage(key) == false) {
-        pthread_mutex_unlock(&this->cacheMutex);
+    PageCacheShard& shard = this->getShard(key);
+    pthread_mutex_lock(&shard.cacheMutex);
+    if (this->containsPageInShard(shard, key) == false) {
+        pthread_mutex_unlock(&shard.cacheMutex);
         return false;
     }
-    size_t pageSizeAllocated = this->cache->at(key)->getRawSize() + 512;
-    cache->erase(key);
+    size_t pageSizeAllocated = shard.pages.at(key)->getRawSize() + 512;
+    shard.pages.erase(key);
+    if (shard.policy != nullptr) {
+        shard.policy->pageRemoved(key);
+    }
+    this->claimReadAheadPage(key);
     this->size -= pageSizeAllocated;
-    pthread_mutex_unlock(&this->cacheMutex);
+    pthread_mutex_unlock(&shard.cacheMutex);
     this->shm->free(curPage->getRawBytes() - curPage->getInternalOffset(),
                     curPage->getRawSize() + 512);
     curPage->setOffset(0);
@@ -364,64 +507,345 @@ PDBPagePtr PageCache::getPage(PartitionedFilePtr file,
     key.setId = file->getSetId();
     key.pageId = pageId;
     PDBPagePtr page;
+    this->stats.recordAccess(key, file->getPageSize(), false);
 
     if ((partitionId == (unsigned int)(-1)) || (pageSeqInPartition == (unsigned int)(-1))) {
         PageIndex pageIndex = file->getMetaData()->getPageIndex(pageId);
         partitionId = pageIndex.partitionId;
         pageSeqInPartition = pageIndex.pageSeqInPartition;
     }
-    // Assumption: At one time, for a page, only one thread will try to load it.
-    // Above assumption is guaranteed by the front-end scan model.
-    pthread_mutex_lock(&this->evictionMutex);
-    this->evictionLock();
-    pthread_mutex_lock(&this->cacheMutex);
-    if (this->containsPage(key) != true) {
+    // Assumption: At one time, for a page, only one scan thread will try to load it.
+    // Above assumption is guaranteed by the front-end scan model. A read-ahead thread may load
+    // the same page concurrently though, so the loaded page is only cached if the read-ahead
+    // thread has not cached it first.
+    // Only the shard owning the page is locked, so that pinning pages of other shards and
+    // evicting pages of other shards can proceed in parallel.
+    PageCacheShard& shard = this->getShard(key);
+    bool checkReadAhead = (sequential == true) && (this->readAheadQueue != nullptr);
+    pthread_rwlock_wrlock(&shard.evictionAndFlushLock);
+    pthread_mutex_lock(&shard.cacheMutex);
+    if ((checkReadAhead == true) && (this->containsPageInShard(shard, key) != true)) {
+        // the page may be being loaded by a read-ahead thread, which needs the shard to cache it
+        pthread_mutex_unlock(&shard.cacheMutex);
+        pthread_rwlock_unlock(&shard.evictionAndFlushLock);
+        if (this->readAheadQueue->waitForPage(key) == true) {
+            this->stats.incReadAheadWaits();
+        }
+        pthread_rwlock_wrlock(&shard.evictionAndFlushLock);
+        pthread_mutex_lock(&shard.cacheMutex);
+    }
+    if (this->containsPageInShard(shard, key) != true) {
         this->stats.incMisses();
-        pthread_mutex_unlock(&this->cacheMutex);
-        this->evictionUnlock();
-        pthread_mutex_unlock(&this->evictionMutex);
-        page = this->loadPage(file, partitionId, pageSeqInPartition, sequential);
+        pthread_mutex_unlock(&shard.cacheMutex);
+        pthread_rwlock_unlock(&shard.evictionAndFlushLock);
+        page = this->loadPageFromSecondTier(file, key, partitionId, pageSeqInPartition);
+        if (page == nullptr) {
+            page = this->loadPage(file, partitionId, pageSeqInPartition, sequential);
+        }
         if (page == nullptr) {
             return nullptr;
         }
-        pthread_mutex_lock(&this->countLock);
-        page->setAccessSequenceId(this->accessCount);
-        this->accessCount++;
-        pthread_mutex_unlock(&this->countLock);
-
-        pthread_mutex_lock(&this->evictionMutex);
-        this->cachePage(page, set);
+        page->setAccessSequenceId(this->nextAccessSequenceId());
+
+        pthread_rwlock_wrlock(&shard.evictionAndFlushLock);
+        pthread_mutex_lock(&shard.cacheMutex);
+        bool claimed = false;
+        if (this->containsPageInShard(shard, key) == true) {
+            // a read-ahead thread has cached the page in the meantime
+            PDBPagePtr loadedPage = page;
+            page = shard.pages.at(key);
+            if (shard.policy != nullptr) {
+                shard.policy->pageAccessed(key);
+            }
+            pthread_mutex_unlock(&shard.cacheMutex);
+            this->shm->free(loadedPage->getRawBytes() - loadedPage->getInternalOffset(),
+                            loadedPage->getRawSize() + 512);
+            loadedPage->setOffset(0);
+            loadedPage->setRawBytes(nullptr);
+            page->setAccessSequenceId(this->nextAccessSequenceId());
+            claimed = this->claimReadAheadPage(key);
+            if (set != nullptr) {
+                set->updateCachedPage(page);
+            }
+        } else {
+            pthread_mutex_unlock(&shard.cacheMutex);
+            this->cachePage(page, set);
+            page->setDirty(false);
+        }
         page->setPinned(true);
-        page->setDirty(false);
         page->incRefCount();
-        pthread_mutex_unlock(&this->evictionMutex);
+        pthread_rwlock_unlock(&shard.evictionAndFlushLock);
+        if ((claimed == true) && (set != nullptr) && (this->strategy == UnifiedDBMIN)) {
+            set->setNumCachedPages(set->getNumCachedPages() + 1);
+        }
     } else {
-        page = this->cache->at(key);
-        pthread_mutex_unlock(&this->cacheMutex);
+        page = shard.pages.at(key);
+        if ((page != nullptr) && (shard.policy != nullptr)) {
+            shard.policy->pageAccessed(key);
+        }
+        pthread_mutex_unlock(&shard.cacheMutex);
         if (page == nullptr) {
             std::cout << "WARNING: PartitionPageIterator get nullptr in cache.\n" << std::endl;
             logger->warn("PartitionPageIterator get nullptr in cache.");
-            this->evictionUnlock();
-            pthread_mutex_unlock(&this->evictionMutex);
+            pthread_rwlock_unlock(&shard.evictionAndFlushLock);
             return nullptr;
         }
         page->setPinned(true);
         page->incRefCount();
-        this->evictionUnlock();
-        pthread_mutex_unlock(&this->evictionMutex);
-        pthread_mutex_lock(&this->countLock);
-        page->setAccessSequenceId(this->accessCount);
-        this->accessCount++;
-        pthread_mutex_unlock(&this->countLock);
+        // a read-ahead page joins the LocalitySet of the scan that pins it first
+        bool claimed = this->claimReadAheadPage(key);
+        pthread_rwlock_unlock(&shard.evictionAndFlushLock);
+        page->setAccessSequenceId(this->nextAccessSequenceId());
         if (set != nullptr) {
             set->updateCachedPage(page);
+            if ((claimed == true) && (this->strategy == UnifiedDBMIN)) {
+                set->setNumCachedPages(set->getNumCachedPages() + 1);
+            }
         }
         this->stats.incHits();
     }
+    if (this->readAheadQueue != nullptr) {
+        this->scheduleReadAhead(file, partitionId, pageSeqInPartition);
+    }
 
     return page;
 }
 
+PDBPagePtr PageCache::loadPageFromSecondTier(PartitionedFilePtr file,
+                                             CacheKey key,
+                                             FilePartitionID partitionId,
+                                             unsigned int pageSeqInPartition) {
+    if (this->secondTier == nullptr) {
+        return nullptr;
+    }
+    if (this->secondTier->contains(key) == false) {
+        this->stats.incSecondTierMisses();
+        return nullptr;
+    }
+    int internalOffset = 0;
+    size_t pageSize = file->getPageSize();
+    char* pageData = this->allocateBufferFromSharedMemoryBlocking(pageSize, internalOffset);
+    if (this->readFromSecondTier(key, pageData, pageSize) == false) {
+        this->shm->free(pageData - internalOffset, pageSize + 512);
+        return nullptr;
+    }
+    return this->buildPageFromSharedMemoryData(
+        file, pageData, partitionId, pageSeqInPartition, internalOffset, pageSize);
+}
+
+bool PageCache::readFromSecondTier(CacheKey key, char* pageData, size_t pageSize) {
+    if (this->secondTier == nullptr) {
+        return false;
+    }
+    if (this->secondTier->restore(key, pageData, pageSize) == false) {
+        this->stats.incSecondTierMisses();
+        return false;
+    }
+    this->stats.incSecondTierHits();
+    return true;
+}
+
+// Only clean pages of user sets are offered, which are also stored in the partition files of
+// their sets; pages of temporary sets (typeId=0), shuffle data (typeId=1) and hash data (typeId=2)
+// in database 0 are not.
+void PageCache::admitToSecondTier(CacheKey key, PDBPagePtr page, char* pageData, size_t pageSize) {
+    if ((this->secondTier == nullptr) || (page->isDirty() == true) ||
+        ((key.dbId == 0) && (key.typeId <= 2))) {
+        return;
+    }
+    if (this->secondTier->admit(key, pageData, pageSize) == true) {
+        this->stats.incSecondTierAdmissions();
+    }
+}
+
+void PageCache::invalidateSecondTier(DatabaseID dbId, UserTypeID typeId, SetID setId) {
+    if (this->secondTier != nullptr) {
+        this->secondTier->invalidateSet(dbId, typeId, setId);
+    }
+}
+
+void PageCache::startReadAheadThreads() {
+    if (this->readAheadQueue == nullptr) {
+        return;
+    }
+    for (unsigned int i = 0; i < this->numReadAheadThreads; i++) {
+        pdb::PDBWorkerPtr worker;
+        while ((worker = this->workers->getWorker()) == nullptr) {
+            sched_yield();
+        }
+        PDBReadAheadWorkPtr readAheadWork =
+            make_shared<PDBReadAheadWork>(this, this->readAheadQueue);
+        worker->execute(readAheadWork, readAheadWork->getLinkedBuzzer());
+    }
+}
+
+void PageCache::stopReadAheadThreads() {
+    if (this->readAheadQueue != nullptr) {
+        this->readAheadQueue->close();
+    }
+}
+
+void PageCache::scheduleReadAhead(PartitionedFilePtr file,
+                                  FilePartitionID partitionId,
+                                  unsigned int pageSeqInPartition) {
+    unsigned int numPagesInPartition =
+        (unsigned int)file->getMetaData()->getPartition(partitionId)->getNumPages();
+    ReadAheadRequest request;
+    request.file = file;
+    request.partitionId = partitionId;
+    request.key.dbId = file->getDbId();
+    request.key.typeId = file->getTypeId();
+    request.key.setId = file->getSetId();
+    for (unsigned int i = 1; i <= this->readAheadWindow; i++) {
+        unsigned int curPageSeq = pageSeqInPartition + i;
+        if (curPageSeq >= numPagesInPartition) {
+            break;
+        }
+        request.pageSeqInPartition = curPageSeq;
+        request.key.pageId = file->loadPageId(partitionId, curPageSeq);
+        if (this->containsPage(request.key) == true) {
+            continue;
+        }
+        if (this->readAheadQueue->addRequest(request) == false) {
+            // the queue is full, or the remaining pages have been queued by an earlier page
+            break;
+        }
+    }
+}
+
+// The page is cached with reference count 0, so that it can be evicted like any other clean
+// page if the scan does not reach it in time. It is not added to a LocalitySet before the scan
+// pins it, so until then it is kept in the unclaimed read-ahead pages, which the eviction through
+// LocalitySets evicts first.
+bool PageCache::loadPageForReadAhead(ReadAheadRequest& request) {
+    size_t pageSize = request.file->getPageSize();
+    if ((this->containsPage(request.key) == true) ||
+        (this->size + pageSize + 512 > this->warnSize)) {
+        return false;
+    }
+    int internalOffset = 0;
+    // never evict for read-ahead
+    char* pageData = (char*)this->shm->mallocAlign(pageSize, 512, internalOffset);
+    if (pageData == nullptr) {
+        return false;
+    }
+    size_t readSize = pageSize;
+    if (this->readFromSecondTier(request.key, pageData, pageSize) == false) {
+        readSize = request.file->loadPageAt(
+            request.partitionId, request.pageSeqInPartition, pageData, pageSize);
+    }
+    if ((readSize == (size_t)(-1)) || (readSize == 0)) {
+        this->shm->free(pageData - internalOffset, pageSize + 512);
+        return false;
+    }
+    PDBPagePtr page = this->buildPageFromSharedMemoryData(request.file,
+                                                          pageData,
+                                                          request.partitionId,
+                                                          request.pageSeqInPartition,
+                                                          internalOffset,
+                                                          pageSize);
+    page->setAccessSequenceId(this->nextAccessSequenceId());
+    page->setPinned(false);
+    page->setDirty(false);
+    PageCacheShard& shard = this->getShard(request.key);
+    pthread_rwlock_wrlock(&shard.evictionAndFlushLock);
+    pthread_mutex_lock(&shard.cacheMutex);
+    bool cached = this->containsPageInShard(shard, request.key);
+    pthread_mutex_unlock(&shard.cacheMutex);
+    if (cached == false) {
+        this->cachePage(page, nullptr);
+        pthread_mutex_lock(&this->readAheadMutex);
+        this->unclaimedReadAheadPages.push_back(request.key);
+        this->unclaimedReadAheadIndex[request.key] = std::prev(this->unclaimedReadAheadPages.end());
+        pthread_mutex_unlock(&this->readAheadMutex);
+        this->stats.incReadAhead();
+    }
+    pthread_rwlock_unlock(&shard.evictionAndFlushLock);
+    if (cached == true) {
+        this->shm->free(pageData - internalOffset, pageSize + 512);
+        page->setOffset(0);
+        page->setRawBytes(nullptr);
+        return false;
+    }
+    return true;
+}
+
+bool PageCache::claimReadAheadPage(CacheKey key) {
+    pthread_mutex_lock(&this->readAheadMutex);
+    auto found = this->unclaimedReadAheadIndex.find(key);
+    if (found == this->unclaimedReadAheadIndex.end()) {
+        pthread_mutex_unlock(&this->readAheadMutex);
+        return false;
+    }
+    this->unclaimedReadAheadPages.erase(found->second);
+    this->unclaimedReadAheadIndex.erase(found);
+    pthread_mutex_unlock(&this->readAheadMutex);
+    return true;
+}
+
+size_t PageCache::getNumUnclaimedReadAheadPages() {
+    pthread_mutex_lock(&this->readAheadMutex);
+    size_t numPages = this->unclaimedReadAheadPages.size();
+    pthread_mutex_unlock(&this->readAheadMutex);
+    return numPages;
+}
+
+int PageCache::evictUnclaimedReadAheadPages() {
+    int numEvicted = 0;
+    while ((numEvicted == 0) || (this->size > this->evictStopSize)) {
+        pthread_mutex_lock(&this->readAheadMutex);
+        if (this->unclaimedReadAheadPages.empty() == true) {
+            pthread_mutex_unlock(&this->readAheadMutex);
+            break;
+        }
+        CacheKey key = this->unclaimedReadAheadPages.front();
+        pthread_mutex_unlock(&this->readAheadMutex);
+        if (this->evictUnclaimedReadAheadPage(key) == true) {
+            numEvicted++;
+        }
+    }
+    return numEvicted;
+}
+
+// The page is checked and removed under the shard locks, in which a pin claims the page, so a page
+// that a scan has pinned, or pinned and unpinned, is left to the LocalitySet of the scan.
+bool PageCache::evictUnclaimedReadAheadPage(CacheKey key) {
+    PageCacheShard& shard = this->getShard(key);
+    pthread_rwlock_wrlock(&shard.evictionAndFlushLock);
+    pthread_mutex_lock(&shard.cacheMutex);
+    PDBPagePtr page = nullptr;
+    if ((this->claimReadAheadPage(key) == true) &&
+        (this->containsPageInShard(shard, key) == true)) {
+        page = shard.pages.at(key);
+        if ((page == nullptr) || (page->getRefCount() > 0) || (page->isDirty() == true) ||
+            (page->isInFlush() == true)) {
+            page = nullptr;
+        }
+    }
+    if (page == nullptr) {
+        pthread_mutex_unlock(&shard.cacheMutex);
+        pthread_rwlock_unlock(&shard.evictionAndFlushLock);
+        return false;
+    }
+    shard.pages.erase(key);
+    if (shard.policy != nullptr) {
+        shard.policy->pageRemoved(key);
+    }
+    char* pageData = page->getRawBytes();
+    size_t pageSize = page->getRawSize();
+    int internalOffset = page->getInternalOffset();
+    this->size -= pageSize + 512;
+    page->setPinned(false);
+    page->setOffset(0);
+    page->setRawBytes(nullptr);
+    pthread_mutex_unlock(&shard.cacheMutex);
+    pthread_rwlock_unlock(&shard.evictionAndFlushLock);
+    this->admitToSecondTier(key, page, pageData, pageSize);
+    this->shm->free(pageData - internalOffset, pageSize + 512);
+    this->stats.incEvicted();
+    return true;
+}
+
 // Below method is mainly to provide backward-compatibility for sequence files.
 // note that below method will cause cached page reference count ++;
 // NOT SUPPORTED ANY MORE, TO REMOVE THE METHOD
@@ -440,28 +864,34 @@ PDBPagePtr PageCache::getPage1(CacheKey key, LocalitySet* set) {
 // Below method will cause reference count ++;
 // It will only be used in SetCachePageIterator class to get dirty pages, and will be guarded there
 PDBPagePtr PageCache::getPage(CacheKey key, LocalitySet* set) {
-    pthread_mutex_lock(&this->cacheMutex);
-    if (this->containsPage(key) != true) {
-        pthread_mutex_unlock(&this->cacheMutex);
+    PageCacheShard& shard = this->getShard(key);
+    pthread_mutex_lock(&shard.cacheMutex);
+    if (this->containsPageInShard(shard, key) != true) {
+        pthread_mutex_unlock(&shard.cacheMutex);
         std::cout << "WARNING: SetCachePageIterator get nullptr in cache.\n" << std::endl;
         logger->warn("SetCachePageIterator get nullptr in cache.");
         return nullptr;
     } else {
-        PDBPagePtr page = this->cache->at(key);
+        PDBPagePtr page = shard.pages.at(key);
         if (page == nullptr) {
             std::cout << "WARNING: SetCachePageIterator get nullptr in cache.\n" << std::endl;
             logger->warn("SetCachePageIterator get nullptr in cache.");
-            pthread_mutex_unlock(&this->cacheMutex);
+            pthread_mutex_unlock(&shard.cacheMutex);
             return nullptr;
         }
         page->incRefCount();
-        pthread_mutex_unlock(&this->cacheMutex);
-        pthread_mutex_lock(&this->countLock);
-        page->setAccessSequenceId(this->accessCount);
-        this->accessCount++;
-        pthread_mutex_unlock(&this->countLock);
+        if (shard.policy != nullptr) {
+            shard.policy->pageAccessed(key);
+        }
+        bool claimed = this->claimReadAheadPage(key);
+        pthread_mutex_unlock(&shard.cacheMutex);
+        this->stats.recordAccess(key, page->getRawSize(), false);
+        page->setAccessSequenceId(this->nextAccessSequenceId());
         if (set != nullptr) {
             set->updateCachedPage(page);
+            if ((claimed == true) && (this->strategy == UnifiedDBMIN)) {
+                set->setNumCachedPages(set->getNumCachedPages() + 1);
+            }
         }
         return page;
     }
@@ -498,19 +928,17 @@ PDBPagePtr PageCache::getNewPageNonBlocking(NodeID nodeId,
                                            pageSize,
                                            shm->computeOffset(pageData),
                                            internalOffset);
+    // the buffer may still hold the PAX columns of the page that used it before
+    PaxPage::clear(page);
+    this->stats.recordAccess(key, pageSize, true);
 
-    pthread_mutex_lock(&this->countLock);
-    page->setAccessSequenceId(this->accessCount);
-    this->accessCount++;
-    pthread_mutex_unlock(&this->countLock);
+    page->setAccessSequenceId(this->nextAccessSequenceId());
     page->setPinned(true);
     page->setDirty(true);
-    pthread_mutex_lock(&evictionMutex);
-    this->evictionLock();
+    this->evictionLock(key);
     this->cachePage(page, set);
     page->incRefCount();
-    this->evictionUnlock();
-    pthread_mutex_unlock(&evictionMutex);
+    this->evictionUnlock(key);
     return page;
 }
 
@@ -519,21 +947,20 @@ PDBPagePtr PageCache::getNewPageNonBlocking(NodeID nodeId,
 // To allocate a new page, set it as pinned&dirty, add it to cache, and increment reference count
 PDBPagePtr PageCache::getNewPage(NodeID nodeId, CacheKey key, LocalitySet* set, size_t pageSize) {
 
-    pthread_mutex_lock(&evictionMutex);
     if (this->strategy == UnifiedDBMIN) {
+        pthread_mutex_lock(&evictionMutex);
         std::cout << "to run evictForDBMIN for getNewPage with Id=" << key.pageId << ", setId=" << key.setId << std::endl;
         evictForDBMIN(set);
+        pthread_mutex_unlock(&evictionMutex);
     }
 
     if (this->containsPage(key) == true) {
-        pthread_mutex_unlock(&evictionMutex);
         return nullptr;
     }
-    pthread_mutex_unlock(&evictionMutex);
     int internalOffset = 0;
     char* pageData;
     std::cout << "to allocate a page with size=" << pageSize << std::endl;
-    pageData = allocateBufferFromSharedMemoryBlocking(pageSize, internalOffset);
+    pageData = allocateBufferFromSharedMemoryBlocking(pageSize, internalOffset, true);
     if (pageData != nullptr) {
         std::cout << "PageCache: getNewPage: Page created for typeId=" << key.typeId
                  << ",setId=" << key.setId << ",pageId=" << key.pageId << "\n";
@@ -550,36 +977,42 @@ PDBPagePtr PageCache::getNewPage(NodeID nodeId, CacheKey key, LocalitySet* set,
                                            pageSize,
                                            shm->computeOffset(pageData),
                                            internalOffset);
+    // the buffer may still hold the PAX columns of the page that used it before
+    PaxPage::clear(page);
+    this->stats.recordAccess(key, pageSize, true);
 
-    pthread_mutex_lock(&this->countLock);
-    page->setAccessSequenceId(this->accessCount);
-    this->accessCount++;
-    pthread_mutex_unlock(&this->countLock);
+    page->setAccessSequenceId(this->nextAccessSequenceId());
     page->setPinned(true);
     page->setDirty(true);
-    pthread_mutex_lock(&evictionMutex);
-    this->evictionLock();
+    this->evictionLock(key);
     this->cachePage(page, set);
     page->incRefCount();
-    this->evictionUnlock();
-    pthread_mutex_unlock(&evictionMutex);
+    this->evictionUnlock(key);
     return page;
 }
 
 // please note that only below method will cause cached page reference count --
 
 bool PageCache::decPageRefCount(CacheKey key) {
-    if (this->containsPage(key) == false) {
+    PageCacheShard& shard = this->getShard(key);
+    pthread_mutex_lock(&shard.cacheMutex);
+    if (this->containsPageInShard(shard, key) == false) {
+        pthread_mutex_unlock(&shard.cacheMutex);
         return false;
     } else {
-        PDBPagePtr page = this->cache->at(key);
+        PDBPagePtr page = shard.pages.at(key);
+        pthread_mutex_unlock(&shard.cacheMutex);
         page->decRefCount();
         return true;
     }
 }
 
 bool PageCache::containsPage(CacheKey key) {
-    return (this->cache->find(key) != this->cache->end());
+    PageCacheShard& shard = this->getShard(key);
+    pthread_mutex_lock(&shard.cacheMutex);
+    bool ret = this->containsPageInShard(shard, key);
+    pthread_mutex_unlock(&shard.cacheMutex);
+    return ret;
 }
 
 
@@ -597,23 +1030,23 @@ int PageCache::unpinAndEvictAllDirtyPages() {
     PDBPagePtr page;
     unordered_map<CacheKey, PDBPagePtr, CacheKeyHash, CacheKeyEqual>::iterator cacheIter;
     vector<PDBPagePtr>* evictableDirtyPages = new vector<PDBPagePtr>();
-    this->evictionLock();
-    for (cacheIter = this->cache->begin(); cacheIter != this->cache->end(); cacheIter++) {
-        page = cacheIter->second;
-        if (page == nullptr) {
-            this->inEviction = false;
-            pthread_mutex_unlock(&this->evictionMutex);
-            return 0;
-        } else if ((page->isDirty() == true) && (page->isInFlush() == false)) {
-            while (page->getRefCount() > 0) {
-                page->decRefCount();
+    for (PageCacheShard* shard : this->shards) {
+        pthread_rwlock_wrlock(&shard->evictionAndFlushLock);
+        pthread_mutex_lock(&shard->cacheMutex);
+        for (cacheIter = shard->pages.begin(); cacheIter != shard->pages.end(); cacheIter++) {
+            page = cacheIter->second;
+            if ((page != nullptr) && (page->isDirty() == true) && (page->isInFlush() == false)) {
+                while (page->getRefCount() > 0) {
+                    page->decRefCount();
+                }
+                evictableDirtyPages->push_back(page);
+            } else {
+                // do nothing
             }
-            evictableDirtyPages->push_back(page);
-        } else {
-            // do nothing
         }
+        pthread_mutex_unlock(&shard->cacheMutex);
+        pthread_rwlock_unlock(&shard->evictionAndFlushLock);
     }
-    this->evictionUnlock();
     int i;
     for (i = 0; i < evictableDirtyPages->size(); i++) {
         page = evictableDirtyPages->at(i);
@@ -642,21 +1075,21 @@ int PageCache::evictAllDirtyPages() {
     PDBPagePtr page;
     unordered_map<CacheKey, PDBPagePtr, CacheKeyHash, CacheKeyEqual>::iterator cacheIter;
     vector<PDBPagePtr>* evictableDirtyPages = new vector<PDBPagePtr>();
-    this->evictionLock();
-    for (cacheIter = this->cache->begin(); cacheIter != this->cache->end(); cacheIter++) {
-        page = cacheIter->second;
-        if (page == nullptr) {
-            this->inEviction = false;
-            pthread_mutex_unlock(&this->evictionMutex);
-            return 0;
-        } else if ((page->isDirty() == true) && (page->getRefCount() == 0) &&
-                   (page->isInFlush() == false)) {
-            evictableDirtyPages->push_back(page);
-        } else {
-            // do nothing
+    for (PageCacheShard* shard : this->shards) {
+        pthread_rwlock_wrlock(&shard->evictionAndFlushLock);
+        pthread_mutex_lock(&shard->cacheMutex);
+        for (cacheIter = shard->pages.begin(); cacheIter != shard->pages.end(); cacheIter++) {
+            page = cacheIter->second;
+            if ((page != nullptr) && (page->isDirty() == true) && (page->getRefCount() == 0) &&
+                (page->isInFlush() == false)) {
+                evictableDirtyPages->push_back(page);
+            } else {
+                // do nothing
+            }
         }
+        pthread_mutex_unlock(&shard->cacheMutex);
+        pthread_rwlock_unlock(&shard->evictionAndFlushLock);
     }
-    this->evictionUnlock();
     int i;
     for (i = 0; i < evictableDirtyPages->size(); i++) {
         page = evictableDirtyPages->at(i);
@@ -674,20 +1107,27 @@ int PageCache::evictAllDirtyPages() {
 
 // Flush a page.
 bool PageCache::flushPageWithoutEviction(CacheKey key) {
-    if (this->containsPage(key) == true) {
-        PDBPagePtr page = this->cache->at(key);
-        if ((page->isDirty() == true) && (page->isInFlush() == false)) {
-            page->setInFlush(true);
-            page->setInEviction(false);
-            this->flushBuffer->addPageToTail(page);
-        } else {
-            // can't flush
-            return false;
-        }
-    } else {
+    PageCacheShard& shard = this->getShard(key);
+    pthread_rwlock_wrlock(&shard.evictionAndFlushLock);
+    pthread_mutex_lock(&shard.cacheMutex);
+    if (this->containsPageInShard(shard, key) == false) {
         // can't find page
+        pthread_mutex_unlock(&shard.cacheMutex);
+        pthread_rwlock_unlock(&shard.evictionAndFlushLock);
+        return false;
+    }
+    PDBPagePtr page = shard.pages.at(key);
+    pthread_mutex_unlock(&shard.cacheMutex);
+    if ((page->isDirty() == false) || (page->isInFlush() == true)) {
+        // can't flush
+        pthread_rwlock_unlock(&shard.evictionAndFlushLock);
         return false;
     }
+    page->setInFlush(true);
+    page->setInEviction(false);
+    // the flushing thread needs the shard's flush lock, so release it before handing the page over
+    pthread_rwlock_unlock(&shard.evictionAndFlushLock);
+    this->flushBuffer->addPageToTail(page);
     return true;
 }
 
@@ -695,8 +1135,14 @@ bool PageCache::flushPageWithoutEviction(CacheKey key) {
 // Evict a page
 
 bool PageCache::evictPage(CacheKey key, bool tryFlushOrNot) {
-    if (this->containsPage(key) == true) {
-        PDBPagePtr page = this->cache->at(key);
+    // The shard's eviction lock makes the reference count check and the removal atomic with
+    // respect to getPage() pinning the same page; pages of other shards are not affected.
+    PageCacheShard& shard = this->getShard(key);
+    pthread_rwlock_wrlock(&shard.evictionAndFlushLock);
+    pthread_mutex_lock(&shard.cacheMutex);
+    if (this->containsPageInShard(shard, key) == true) {
+        PDBPagePtr page = shard.pages.at(key);
+        pthread_mutex_unlock(&shard.cacheMutex);
         if (page->isDirty()==true) {
             std::cout << "the page is dirty" << std::endl;
         }
@@ -712,6 +1158,7 @@ bool PageCache::evictPage(CacheKey key, bool tryFlushOrNot) {
                 "LRUPageCache: can not evict page because it has been pinned by at least one "
                 "client");
             this->logger->writeInt(page->getPageID());
+            pthread_rwlock_unlock(&shard.evictionAndFlushLock);
             return false;
         } else
 #endif
@@ -730,30 +1177,34 @@ bool PageCache::evictPage(CacheKey key, bool tryFlushOrNot) {
                 page->setInEviction(true);
                 // flush the page
                 // first we release the lock so that the flushing thread can run.
+                pthread_rwlock_unlock(&shard.evictionAndFlushLock);
                 this->flushBuffer->addPageToTail(page);
 
             }  else if (page->isInFlush() == true) {
                 std::cout << "going to evict a page in flush" << std::endl;
                 page->setInEviction(true);
-            }  else if (page->isInFlush() == false) {
+                pthread_rwlock_unlock(&shard.evictionAndFlushLock);
+            }  else {
 #ifdef PROFILING_CACHE
                 std::cout << "going to unpin a clean page...\n";
 #endif
                 // free the page
-                // We use flush lock (which is a read write lock) to synchronize with getPage() that
-                // will be invoked in PartitionPageIterator;
+                // We hold the shard's eviction lock (which excludes the flush lock of the shard) to
+                // synchronize with getPage() that will be invoked in PartitionPageIterator;
                 // One scenario is: PDB load old data from disk to memory through iterators while
                 // application pins new pages that requires to evict data, then an old page in
                 // checking for loading may get evicted before it is pinned.
-                // Add flush lock is to guard for similar scenarios.
-                this->flushLock();
-                this->shm->free(page->getRawBytes() - page->getInternalOffset(),
-                                page->getRawSize() + 512);
-
+                char* pageData = page->getRawBytes();
+                size_t pageSize = page->getRawSize();
+                int internalOffset = page->getInternalOffset();
                 page->setOffset(0);
                 page->setRawBytes(nullptr);
                 removePage(key);
-                this->flushUnlock();
+                pthread_rwlock_unlock(&shard.evictionAndFlushLock);
+                // the page is not reachable from the cache any more, so it can be written to the
+                // second tier without holding the lock
+                this->admitToSecondTier(key, page, pageData, pageSize);
+                this->shm->free(pageData - internalOffset, pageSize + 512);
             }
 #ifdef PROFILING_CACHE
             std::cout << "Storage server: evicting page from cache for dbId:" << page->getDbID()
@@ -764,6 +1215,8 @@ bool PageCache::evictPage(CacheKey key, bool tryFlushOrNot) {
         }
 
     } else {
+        pthread_mutex_unlock(&shard.cacheMutex);
+        pthread_rwlock_unlock(&shard.evictionAndFlushLock);
         std::cout << "can not find page in cache!\n";
         this->logger->writeLn("LRUPageCache: can not evict page because it is not in cache");
         return false;
@@ -834,7 +1287,12 @@ void PageCache::evict() {
 #endif
     pthread_mutex_lock(&this->evictionMutex);
     this->inEviction = true;
-    if (this->strategy == UnifiedCost) {
+    bool evictThroughLocalitySets = (this->strategy == UnifiedCost) ||
+        (this->strategy == UnifiedIntelligent) || (this->strategy == UnifiedDBMIN);
+    if ((evictThroughLocalitySets == true) && (this->evictUnclaimedReadAheadPages() > 0)) {
+        // the read-ahead pages that no scan has pinned belong to no LocalitySet, and have never
+        // been used, so they are evicted first
+    } else if (this->strategy == UnifiedCost) {
         this->evictionLock();
     /*
      * index = 0, TransientLifetimeEnded, write cost = 0, read cost = 0
@@ -872,6 +1330,7 @@ void PageCache::evict() {
                          set->setReadCost(profiledReadCosts[i]);
 		    }
                     set->setSequenceId(this->accessCount+1);
+                    set->computeEvictionCost();
                     localitySets->push(set);
                 }
             }
@@ -950,65 +1409,8 @@ void PageCache::evict() {
 
     } else if (this->strategy == UnifiedDBMIN) { 
         return;
-    } else{
-        this->evictionLock();
-        this->logger->debug("PageCache::evict(): got the lock for evictionLock()...");
-        priority_queue<PDBPagePtr, vector<PDBPagePtr>, CompareCachedPagesMRU>* cachedPages =
-            new priority_queue<PDBPagePtr, vector<PDBPagePtr>, CompareCachedPagesMRU>();
-        unordered_map<CacheKey, PDBPagePtr, CacheKeyHash, CacheKeyEqual>::iterator cacheIter;
-        PDBPagePtr curPage;
-        for (cacheIter = this->cache->begin(); cacheIter != this->cache->end(); cacheIter++) {
-            curPage = cacheIter->second;
-            if (curPage == nullptr) {
-                this->logger->error("PageCache::evict(): got a null page, return!");
-                delete cachedPages;
-                this->inEviction = false;
-                this->evictionUnlock();
-                pthread_mutex_unlock(&this->evictionMutex);
-                return;
-            }
-            this->logger->debug(
-                "PageCache::evict(): got a page, check whether it can be evicted...");
-            if ((curPage->getRefCount() == 0) &&
-                ((curPage->isDirty() == false) ||
-                 ((curPage->isDirty() == true) && (curPage->isInFlush() == false)))) {
-                cachedPages->push(curPage);
-#ifdef PROFILING_CACHE
-                std::cout << "Add to eviction queue: curPage->getRefCount()="
-                          << curPage->getRefCount() << ", curPage->isDirty()=" << curPage->isDirty()
-                          << ", curPage->isInFlush)=" << curPage->isInFlush()
-                          << ", curPage->dbId=" << curPage->getDbID()
-                          << ", curPage->setId=" << curPage->getSetID() << std::endl;
-#endif
-            } else {
-                // do nothing
-            }
-        }
-        this->evictionUnlock();
-        PDBPagePtr page;
-        while ((this->size > this->evictStopSize) && (cachedPages->size() > 0)) {
-            page = cachedPages->top();
-            if (page == nullptr) {
-                PDB_COUT << "PageCache: nothing to evict, return!\n";
-                this->logger->debug("PageCache: nothing to evict, return!\n");
-                break;
-            }
-            if (this->evictPage(page) == true) {
-#ifdef PROFILING
-                std::cout << "Storage server: evicted page from cache passively for dbId:"
-                          << page->getDbID() << ", typeID:" << page->getTypeID()
-                          << ", setID=" << page->getSetID() << ", pageID: " << page->getPageID()
-                          << ".\n";
-#endif
-                this->logger->debug(
-                    std::string("Storage server: evicting page from cache for pageID:") +
-                    std::to_string(page->getPageID()));
-                cachedPages->pop();
-            } else {
-                cachedPages->pop();
-            }
-        }
-        delete cachedPages;
+    } else {
+        this->evictWithPolicies();
     }
     this->inEviction = false;
     pthread_mutex_unlock(&this->evictionMutex);
@@ -1018,6 +1420,39 @@ void PageCache::evict() {
     logger->debug("Storage server: finished cache eviction!\n");
 }
 
+// Each shard is only locked while its policy selects a victim, so readers of all other shards keep
+// running during eviction. The shards are visited in round robin, so that each shard gives up
+// pages in proportion, as in other sharded caches.
+void PageCache::evictWithPolicies() {
+    auto isEvictable = [](PageCacheShard* shard, const CacheKey& key) -> bool {
+        PDBPagePtr page = shard->pages.at(key);
+        return (page != nullptr) && (page->getRefCount() == 0) &&
+            ((page->isDirty() == false) || (page->isInFlush() == false));
+    };
+    unsigned int numShardsWithoutVictim = 0;
+    while ((this->size > this->evictStopSize) && (numShardsWithoutVictim < this->numShards)) {
+        PageCacheShard* shard = this->shards[this->nextEvictionShard];
+        this->nextEvictionShard = (this->nextEvictionShard + 1) % this->numShards;
+        CacheKey victim;
+        pthread_rwlock_wrlock(&shard->evictionAndFlushLock);
+        pthread_mutex_lock(&shard->cacheMutex);
+        bool found = shard->policy->selectVictim(
+            [&](const CacheKey& key) -> bool { return isEvictable(shard, key); }, victim);
+        pthread_mutex_unlock(&shard->cacheMutex);
+        pthread_rwlock_unlock(&shard->evictionAndFlushLock);
+        // evictPage() re-checks the reference count under the shard lock, in case the page
+        // has been pinned again since it was selected
+        if ((found == true) && (this->evictPage(victim) == true)) {
+            numShardsWithoutVictim = 0;
+            this->logger->debug(
+                std::string("Storage server: evicting page from cache for pageID:") +
+                std::to_string(victim.pageId));
+        } else {
+            numShardsWithoutVictim++;
+        }
+    }
+}
+
 void PageCache::getAndSetWarnSize(unsigned int numSets, double warnThreshold) {
     this->warnSize = (this->maxSize) * warnThreshold;
     this->logger->writeLn("LRUPageCache: warnSize was set to:");
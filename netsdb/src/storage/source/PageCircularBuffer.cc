@@ -16,8 +16,8 @@ PageCircularBuffer::PageCircularBuffer(unsigned int bufferSize, pdb::PDBLoggerPt
     this->closed = false;
     this->initArray();
     pthread_mutex_init(&(this->mutex), NULL);
-    pthread_mutex_init(&(this->addPageMutex), NULL);
     pthread_cond_init(&(this->cond), NULL);
+    pthread_cond_init(&(this->spaceCond), NULL);
 }
 
 PageCircularBuffer::~PageCircularBuffer() {
@@ -25,6 +25,7 @@ PageCircularBuffer::~PageCircularBuffer() {
     delete[] this->pageArray;
     pthread_mutex_destroy(&(this->mutex));
     pthread_cond_destroy(&(this->cond));
+    pthread_cond_destroy(&(this->spaceCond));
 }
 
 int PageCircularBuffer::initArray() {
@@ -46,30 +47,15 @@ int PageCircularBuffer::initArray() {
 
 // in our case, more than one producer will add pages to the tail of the blocking queue
 int PageCircularBuffer::addPageToTail(PDBPagePtr page) {
-    pthread_mutex_lock(&(this->addPageMutex));
-    int i = 0;
+    pthread_mutex_lock(&(this->mutex));
     while (this->isFull()) {
-        i++;
-        if (i % 10000000 == 0) {
-            this->logger->info(std::to_string(i) +
-                               std::string(":PageCircularBuffer: array is full."));
-            std::cout << i << ":PageCircularBuffer: array is full." << std::endl;
-        }
-        pthread_cond_signal(&(this->cond));
-        sched_yield();  // TODO: consider to use another conditional variable
+        this->logger->info("PageCircularBuffer: array is full.");
+        pthread_cond_wait(&(this->spaceCond), &(this->mutex));
     }
-
-    this->logger->writeLn("PageCircularBuffer:got a place.");
-    std::cout << "PageCircularBuffer:got a place." << std::endl;
+    PDB_COUT << "PageCircularBuffer: got a place for pageID=" << page->getPageID() << std::endl;
     this->pageArrayTail = (this->pageArrayTail + 1) % this->maxArraySize;
     this->pageArray[this->pageArrayTail] = page;
-    pthread_mutex_unlock(&(this->addPageMutex));
-    pthread_mutex_lock(&(this->mutex));
-    if (this->getSize() <= 2) {  // TODO <= numThreads? or not necessary
-        pthread_cond_broadcast(&(this->cond));
-    } else {
-        pthread_cond_signal(&(this->cond));
-    }
+    pthread_cond_signal(&(this->cond));
     pthread_mutex_unlock(&(this->mutex));
     return 0;
 }
@@ -77,27 +63,45 @@ int PageCircularBuffer::addPageToTail(PDBPagePtr page) {
 // there will be multiple consumers, so we need to guard the blocking queue
 
 PDBPagePtr PageCircularBuffer::popPageFromHead() {
+    std::vector<PDBPagePtr> pages;
+    if (this->popPagesFromHead(pages, 1) == 0) {
+        return nullptr;
+    }
+    return pages[0];
+}
+
+unsigned int PageCircularBuffer::popPagesFromHead(std::vector<PDBPagePtr>& pages,
+                                                  unsigned int maxPages) {
     pthread_mutex_lock(&(this->mutex));
-    if (this->isEmpty() && (this->closed == false)) {
-        this->logger->writeLn("PageCircularBuffer: array is empty.");
-        std::cout << "PageCircularBuffer: array is empty." << std::endl;
+    while (this->isEmpty() && (this->closed == false)) {
+        this->logger->debug("PageCircularBuffer: array is empty.");
         pthread_cond_wait(&(this->cond), &(this->mutex));
     }
-    if (!this->isEmpty()) {
-        this->logger->debug("PageCircularBuffer: not empty, return the head element");
-        std::cout << "PageCircularBuffer: not empty, return the head element" << std::endl;
+    unsigned int numPages = 0;
+    while ((numPages < maxPages) && (!this->isEmpty())) {
         this->pageArrayHead = (this->pageArrayHead + 1) % this->maxArraySize;
-        PDBPagePtr ret = this->pageArray[this->pageArrayHead];
-        std::cout << "Head pageID=" << ret->getPageID() << std::endl;
+        pages.push_back(this->pageArray[this->pageArrayHead]);
         this->pageArray[this->pageArrayHead] = nullptr;
-        pthread_mutex_unlock(&(this->mutex));
-        return ret;
-    } else {
-        pthread_mutex_unlock(&(this->mutex));
-        std::cout << "Head is nullptr" << std::endl;
-        return nullptr;
+        numPages++;
+    }
+    if (numPages > 0) {
+        pthread_cond_broadcast(&(this->spaceCond));
     }
+    pthread_mutex_unlock(&(this->mutex));
+    return numPages;
 }
+
+bool PageCircularBuffer::waitUntilBelow(unsigned int depth) {
+    bool waited = false;
+    pthread_mutex_lock(&(this->mutex));
+    while ((this->getSize() >= depth) && (this->closed == false)) {
+        waited = true;
+        pthread_cond_wait(&(this->spaceCond), &(this->mutex));
+    }
+    pthread_mutex_unlock(&(this->mutex));
+    return waited;
+}
+
 // not thread-safe
 
 bool PageCircularBuffer::isFull() {
@@ -106,10 +110,6 @@ bool PageCircularBuffer::isFull() {
 // not thread-safe
 
 bool PageCircularBuffer::isEmpty() {
-    PDB_COUT << "this->pageArrayHead=" << this->pageArrayHead << std::endl;
-    this->logger->debug(std::string("this->pageArrayHead=") + std::to_string(this->pageArrayHead));
-    this->logger->debug(std::string("this->pageArrayTail=") + std::to_string(this->pageArrayTail));
-    PDB_COUT << "this->pageArrayTail=" << this->pageArrayTail << std::endl;
     return (this->pageArrayHead == this->pageArrayTail);
 }
 // not thread-safe
@@ -122,11 +122,14 @@ void PageCircularBuffer::close() {
     pthread_mutex_lock(&(this->mutex));
     this->closed = true;
     pthread_cond_broadcast(&(this->cond));
+    pthread_cond_broadcast(&(this->spaceCond));
     pthread_mutex_unlock(&(this->mutex));
 }
 
 
 void PageCircularBuffer::open() {
+    pthread_mutex_lock(&(this->mutex));
     this->closed = false;
+    pthread_mutex_unlock(&(this->mutex));
 }
 #endif
@@ -0,0 +1,139 @@
+#ifndef PAGE_COMPRESSOR_CC
+#define PAGE_COMPRESSOR_CC
+
+#include "PageCompressor.h"
+#include <snappy.h>
+#ifdef ENABLE_LZ4
+#include <lz4.h>
+#endif
+#ifdef ENABLE_ZSTD
+#include <zstd.h>
+#endif
+
+// level used for Zstd, favoring decompression speed for scans
+#ifndef PAGE_ZSTD_LEVEL
+#define PAGE_ZSTD_LEVEL 1
+#endif
+
+bool PageCompressor::isAvailable(PageCompressionType type) {
+    switch (type) {
+        case NoPageCompression:
+        case SnappyPageCompression:
+            return true;
+        case LZ4PageCompression:
+#ifdef ENABLE_LZ4
+            return true;
+#else
+            return false;
+#endif
+        case ZstdPageCompression:
+#ifdef ENABLE_ZSTD
+            return true;
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+const char* PageCompressor::getName(PageCompressionType type) {
+    switch (type) {
+        case NoPageCompression:
+            return "none";
+        case SnappyPageCompression:
+            return "snappy";
+        case LZ4PageCompression:
+            return "lz4";
+        case ZstdPageCompression:
+            return "zstd";
+    }
+    return "unknown";
+}
+
+size_t PageCompressor::getMaxCompressedLength(PageCompressionType type, size_t srcLength) {
+    switch (type) {
+        case SnappyPageCompression:
+            return snappy::MaxCompressedLength(srcLength);
+#ifdef ENABLE_LZ4
+        case LZ4PageCompression:
+            return (size_t)LZ4_compressBound((int)srcLength);
+#endif
+#ifdef ENABLE_ZSTD
+        case ZstdPageCompression:
+            return ZSTD_compressBound(srcLength);
+#endif
+        default:
+            return srcLength;
+    }
+}
+
+size_t PageCompressor::compress(PageCompressionType type,
+                                const char* src,
+                                size_t srcLength,
+                                char* dest) {
+    return compress(type, src, srcLength, dest, PAGE_ZSTD_LEVEL);
+}
+
+size_t PageCompressor::compress(PageCompressionType type,
+                                const char* src,
+                                size_t srcLength,
+                                char* dest,
+                                int level) {
+    switch (type) {
+        case SnappyPageCompression: {
+            size_t compressedLength = 0;
+            snappy::RawCompress(src, srcLength, dest, &compressedLength);
+            return compressedLength;
+        }
+#ifdef ENABLE_LZ4
+        case LZ4PageCompression: {
+            int ret = LZ4_compress_default(
+                src, dest, (int)srcLength, LZ4_compressBound((int)srcLength));
+            return (ret <= 0) ? 0 : (size_t)ret;
+        }
+#endif
+#ifdef ENABLE_ZSTD
+        case ZstdPageCompression: {
+            size_t ret = ZSTD_compress(
+                dest, ZSTD_compressBound(srcLength), src, srcLength, level);
+            return ZSTD_isError(ret) ? 0 : ret;
+        }
+#endif
+        default:
+            return 0;
+    }
+}
+
+size_t PageCompressor::decompress(PageCompressionType type,
+                                  const char* src,
+                                  size_t srcLength,
+                                  char* dest,
+                                  size_t destLength) {
+    switch (type) {
+        case SnappyPageCompression: {
+            size_t uncompressedLength = 0;
+            if ((!snappy::GetUncompressedLength(src, srcLength, &uncompressedLength)) ||
+                (uncompressedLength > destLength) ||
+                (!snappy::RawUncompress(src, srcLength, dest))) {
+                return (size_t)(-1);
+            }
+            return uncompressedLength;
+        }
+#ifdef ENABLE_LZ4
+        case LZ4PageCompression: {
+            int ret = LZ4_decompress_safe(src, dest, (int)srcLength, (int)destLength);
+            return (ret < 0) ? (size_t)(-1) : (size_t)ret;
+        }
+#endif
+#ifdef ENABLE_ZSTD
+        case ZstdPageCompression: {
+            size_t ret = ZSTD_decompress(dest, destLength, src, srcLength);
+            return ZSTD_isError(ret) ? (size_t)(-1) : ret;
+        }
+#endif
+        default:
+            return (size_t)(-1);
+    }
+}
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef PAGE_READ_AHEAD_QUEUE_CC
+#define PAGE_READ_AHEAD_QUEUE_CC
+
+#include "PageReadAheadQueue.h"
+#include <pthread.h>
+
+PageReadAheadQueue::PageReadAheadQueue(unsigned int maxNumRequests) {
+    this->maxNumRequests = maxNumRequests;
+    this->isClosed = false;
+    pthread_mutex_init(&(this->queueMutex), nullptr);
+    pthread_cond_init(&(this->requestCond), nullptr);
+    pthread_cond_init(&(this->completeCond), nullptr);
+}
+
+PageReadAheadQueue::~PageReadAheadQueue() {
+    pthread_mutex_destroy(&(this->queueMutex));
+    pthread_cond_destroy(&(this->requestCond));
+    pthread_cond_destroy(&(this->completeCond));
+}
+
+bool PageReadAheadQueue::addRequest(const ReadAheadRequest& request) {
+    pthread_mutex_lock(&(this->queueMutex));
+    if ((this->isClosed == true) || (this->requests.size() >= this->maxNumRequests) ||
+        (this->queuedPages.count(request.key) > 0) ||
+        (this->inFlightPages.count(request.key) > 0)) {
+        pthread_mutex_unlock(&(this->queueMutex));
+        return false;
+    }
+    this->requests.push_back(request);
+    this->queuedPages.insert(request.key);
+    pthread_cond_signal(&(this->requestCond));
+    pthread_mutex_unlock(&(this->queueMutex));
+    return true;
+}
+
+bool PageReadAheadQueue::getRequest(ReadAheadRequest& request) {
+    pthread_mutex_lock(&(this->queueMutex));
+    while ((this->requests.empty() == true) && (this->isClosed == false)) {
+        pthread_cond_wait(&(this->requestCond), &(this->queueMutex));
+    }
+    if (this->isClosed == true) {
+        pthread_mutex_unlock(&(this->queueMutex));
+        return false;
+    }
+    request = this->requests.front();
+    this->requests.pop_front();
+    this->queuedPages.erase(request.key);
+    this->inFlightPages.insert(request.key);
+    pthread_mutex_unlock(&(this->queueMutex));
+    return true;
+}
+
+void PageReadAheadQueue::completeRequest(CacheKey key) {
+    pthread_mutex_lock(&(this->queueMutex));
+    this->inFlightPages.erase(key);
+    pthread_cond_broadcast(&(this->completeCond));
+    pthread_mutex_unlock(&(this->queueMutex));
+}
+
+bool PageReadAheadQueue::waitForPage(CacheKey key) {
+    pthread_mutex_lock(&(this->queueMutex));
+    if (this->queuedPages.count(key) > 0) {
+        // the page is not being loaded yet, so we withdraw the request and let the caller load it
+        CacheKeyEqual equal;
+        for (auto it = this->requests.begin(); it != this->requests.end(); ++it) {
+            if (equal(it->key, key)) {
+                this->requests.erase(it);
+                break;
+            }
+        }
+        this->queuedPages.erase(key);
+        pthread_mutex_unlock(&(this->queueMutex));
+        return false;
+    }
+    if (this->inFlightPages.count(key) == 0) {
+        pthread_mutex_unlock(&(this->queueMutex));
+        return false;
+    }
+    while ((this->inFlightPages.count(key) > 0) && (this->isClosed == false)) {
+        pthread_cond_wait(&(this->completeCond), &(this->queueMutex));
+    }
+    pthread_mutex_unlock(&(this->queueMutex));
+    return true;
+}
+
+void PageReadAheadQueue::close() {
+    pthread_mutex_lock(&(this->queueMutex));
+    this->isClosed = true;
+    this->requests.clear();
+    this->queuedPages.clear();
+    pthread_cond_broadcast(&(this->requestCond));
+    pthread_cond_broadcast(&(this->completeCond));
+    pthread_mutex_unlock(&(this->queueMutex));
+}
+
+#endif
@@ -0,0 +1,149 @@
+#ifndef PAGE_RECEIVER_CC
+#define PAGE_RECEIVER_CC
+
+#include "PageReceiver.h"
+#include "PageCompressor.h"
+#include "StreamCodecSelector.h"
+#include <string.h>
+
+double PageReceiveCounters::getCopiesPerPage() const {
+    if (numPages == 0) {
+        return 0;
+    }
+    return (double)numCopies / (double)numPages;
+}
+
+std::string PageReceiveCounters::toString() const {
+    return "received pages: " + std::to_string(numPages) +
+        ", received bytes: " + std::to_string(numBytesReceived) +
+        ", copies: " + std::to_string(numCopies) +
+        ", copied bytes: " + std::to_string(numBytesCopied) +
+        ", copies per page: " + std::to_string(getCopiesPerPage()) +
+        ", buffer allocations: " + std::to_string(numBufferAllocations);
+}
+
+PageReceiveCounters& getPageReceiveCounters() {
+    static PageReceiveCounters counters;
+    return counters;
+}
+
+// the buffers of the calling thread
+static thread_local std::vector<char> myReceiveBuffer;
+static thread_local std::vector<char> myDecompressBuffer;
+
+static char* growBuffer(std::vector<char>& buffer, size_t size) {
+    if (buffer.size() < size) {
+        buffer.resize(size);
+        getPageReceiveCounters().numBufferAllocations++;
+    }
+    return buffer.data();
+}
+
+static void releaseBuffer(std::vector<char>& buffer) {
+    if (buffer.capacity() > MAX_KEPT_RECEIVE_BUFFER_SIZE) {
+        std::vector<char>().swap(buffer);
+    }
+}
+
+char* getThreadReceiveBuffer(size_t size) {
+    return growBuffer(myReceiveBuffer, size);
+}
+
+char* getThreadDecompressBuffer(size_t size) {
+    return growBuffer(myDecompressBuffer, size);
+}
+
+void releaseThreadReceiveBuffers() {
+    releaseBuffer(myReceiveBuffer);
+    releaseBuffer(myDecompressBuffer);
+}
+
+PageReceiver::PageReceiver(SetPtr set) {
+    this->set = set;
+}
+
+PageReceiver::~PageReceiver() {
+    finish();
+}
+
+bool PageReceiver::receive(pdb::PDBCommunicatorPtr from,
+                           PageCompressionType codec,
+                           size_t uncompressedSize,
+                           std::string& errMsg) {
+    this->codec = codec;
+    this->uncompressedSize = uncompressedSize;
+    numBytes = from->getSizeOfNextObject();
+    if (numBytes == 0) {
+        errMsg = "PageReceiver: the connection is closed";
+        return false;
+    }
+    bytes = nullptr;
+    storedAlready = false;
+    if ((codec == NoPageCompression) && (set != nullptr)) {
+        bytes = (char*)set->getNewBytes(numBytes, page);
+        storedAlready = (bytes != nullptr);
+    }
+    if (bytes == nullptr) {
+        if (buffer.size() < numBytes) {
+            buffer.resize(numBytes);
+            getPageReceiveCounters().numBufferAllocations++;
+        }
+        bytes = buffer.data();
+    }
+    if (!from->receiveBytes(bytes, errMsg)) {
+        // the area is given back, as the bytes in it are not a page
+        if (storedAlready) {
+            page->removeLastVariableBytes(numBytes);
+            storedAlready = false;
+        }
+        return false;
+    }
+    getPageReceiveCounters().addPage(numBytes);
+    return true;
+}
+
+void* PageReceiver::store(std::string& errMsg) {
+    if (storedAlready) {
+        sizeOfLastPage = numBytes;
+        return bytes;
+    }
+    if (set == nullptr) {
+        errMsg = "PageReceiver: the set to store the data doesn't exist";
+        return nullptr;
+    }
+    size_t size =
+        StreamCodecSelector::getUncompressedLength(codec, bytes, numBytes, uncompressedSize);
+    if (size == (size_t)(-1)) {
+        errMsg = std::string("PageReceiver: the size of the received page is not known for ") +
+            PageCompressor::getName(codec);
+        return nullptr;
+    }
+    void* myBytes = set->getNewBytes(size, page);
+    if (myBytes == nullptr) {
+        errMsg = "PageReceiver: can't get " + std::to_string(size) + " bytes from set " +
+            set->getSetName();
+        return nullptr;
+    }
+    if (StreamCodecSelector::decompress(codec, bytes, numBytes, (char*)myBytes, size) != size) {
+        // the area is given back, as the bytes in it are not a page
+        page->removeLastVariableBytes(size);
+        errMsg = std::string("PageReceiver: can't decompress the received page with ") +
+            PageCompressor::getName(codec);
+        return nullptr;
+    }
+    getPageReceiveCounters().addCopy(size);
+    sizeOfLastPage = size;
+    return myBytes;
+}
+
+void PageReceiver::finish() {
+    if (set != nullptr) {
+        set->unpinPage(page);
+    }
+}
+
+size_t PageReceiver::getSizeOfLastPage() {
+    return sizeOfLastPage;
+}
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef PAGE_REPLACEMENT_POLICY_CC
+#define PAGE_REPLACEMENT_POLICY_CC
+
+#include "PageReplacementPolicy.h"
+#include "LRUPolicy.h"
+#include "ARCPolicy.h"
+#include "ClockProPolicy.h"
+#include "LRUKPolicy.h"
+#include "Configuration.h"
+
+PageReplacementPolicyPtr PageReplacementPolicy::create(LocalitySetReplacementPolicy type,
+                                                       size_t capacity) {
+    switch (type) {
+        case MRU:
+            return make_shared<LRUPolicy>(true);
+        case ARC:
+            return make_shared<ARCPolicy>(capacity);
+        case ClockPro:
+            return make_shared<ClockProPolicy>(capacity);
+        case LRUK:
+            return make_shared<LRUKPolicy>(capacity, DEFAULT_LRU_K);
+        default:
+            return make_shared<LRUPolicy>(false);
+    }
+}
+
+PageReplacementPolicyPtr PageReplacementPolicy::create(CacheStrategy strategy, size_t capacity) {
+    switch (strategy) {
+        case UnifiedLRU:
+            return create(LRU, capacity);
+        case UnifiedMRU:
+            return create(MRU, capacity);
+        case UnifiedARC:
+            return create(ARC, capacity);
+        case UnifiedClockPro:
+            return create(ClockPro, capacity);
+        case UnifiedLRUK:
+            return create(LRUK, capacity);
+        default:
+            return nullptr;
+    }
+}
+
+#endif
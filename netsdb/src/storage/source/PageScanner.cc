@@ -93,10 +93,12 @@ bool PageScanner::sendPagePinnedAck(pdb::PDBCommunicatorPtr myCommunicator,
 }
 
 
-vector<PageCircularBufferIteratorPtr> PageScanner::getSetIterators(NodeID nodeId,
-                                                                   DatabaseID dbId,
-                                                                   UserTypeID typeId,
-                                                                   SetID setId) {
+vector<PageCircularBufferIteratorPtr> PageScanner::getSetIterators(
+    NodeID nodeId,
+    DatabaseID dbId,
+    UserTypeID typeId,
+    SetID setId,
+    const ZoneMapPredicate* zoneMapPredicate) {
     // create an GetSetPages object
     string errMsg;
     const pdb::UseTemporaryAllocationBlock myBlock{1024};
@@ -105,6 +107,10 @@ vector<PageCircularBufferIteratorPtr> PageScanner::getSetIterators(NodeID nodeId
     getSetPagesRequest->setDatabaseID(dbId);
     getSetPagesRequest->setUserTypeID(typeId);
     getSetPagesRequest->setSetID(setId);
+    if (zoneMapPredicate != nullptr) {
+        getSetPagesRequest->setZoneMapPredicate(
+            zoneMapPredicate->attributeName, zoneMapPredicate->op, zoneMapPredicate->value);
+    }
 
     vector<PageCircularBufferIteratorPtr> vec;
     // send request to storage
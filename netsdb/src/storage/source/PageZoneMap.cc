@@ -0,0 +1,152 @@
+#ifndef PAGE_ZONE_MAP_CC
+#define PAGE_ZONE_MAP_CC
+
+#include "PageZoneMap.h"
+#include "Object.h"
+#include "Handle.h"
+#include "PDBVector.h"
+#include "Record.h"
+#include <functional>
+#include <math.h>
+#include <string.h>
+
+using namespace pdb;
+
+#define ZONE_MAP_SKETCH_BITS 64
+
+PageZoneMap PageSummarizer::getEmptyZoneMap() {
+    PageZoneMap zoneMap;
+    zoneMap.minValue = 0;
+    zoneMap.maxValue = 0;
+    zoneMap.numValues = 0;
+    zoneMap.numNulls = 0;
+    zoneMap.distinctSketch = 0;
+    return zoneMap;
+}
+
+// The tree is built with -ffast-math, which lets the compiler assume that there is no NaN and fold
+// both "value != value" and isnan() to false, so NaN is detected from the bits of the value.
+static bool isNaN(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(uint64_t));
+    return ((bits & 0x7ff0000000000000ULL) == 0x7ff0000000000000ULL) &&
+        ((bits & 0x000fffffffffffffULL) != 0);
+}
+
+void PageSummarizer::addValue(PageZoneMap& zoneMap, double value) {
+    if (isNaN(value)) {
+        // NaN never satisfies a comparison, so we count it as a null
+        zoneMap.numNulls++;
+        return;
+    }
+    if ((zoneMap.numValues == 0) || (value < zoneMap.minValue)) {
+        zoneMap.minValue = value;
+    }
+    if ((zoneMap.numValues == 0) || (value > zoneMap.maxValue)) {
+        zoneMap.maxValue = value;
+    }
+    zoneMap.numValues++;
+    size_t hash = std::hash<double>()(value);
+    zoneMap.distinctSketch |= ((uint64_t)1) << (hash % ZONE_MAP_SKETCH_BITS);
+}
+
+bool PageSummarizer::summarize(PDBPagePtr page,
+                               const std::vector<ZoneMapAttribute>& attributes,
+                               std::vector<PageZoneMap>& zoneMaps) {
+    if ((page == nullptr) || (page->getRawBytes() == nullptr) || (attributes.size() == 0)) {
+        return false;
+    }
+    Record<Vector<Handle<Object>>>* myRecord = (Record<Vector<Handle<Object>>>*)page->getBytes();
+    size_t numBytes = myRecord->numBytes();
+    if ((numBytes == 0) || (numBytes > page->getSize()) ||
+        (myRecord->rootObjectOffset() >= numBytes)) {
+        return false;
+    }
+    char* recordBegin = (char*)myRecord;
+    char* recordEnd = recordBegin + numBytes;
+    Handle<Vector<Handle<Object>>> objects = myRecord->getRootObject();
+    Handle<Object>* handles = objects->c_ptr();
+    size_t numObjects = objects->size();
+    if (((char*)handles < recordBegin) || ((char*)(handles + numObjects) > recordEnd)) {
+        return false;
+    }
+    zoneMaps.clear();
+    for (auto& attribute : attributes) {
+        PageZoneMap zoneMap = getEmptyZoneMap();
+        for (size_t i = 0; i < numObjects; i++) {
+            if (handles[i].isNullPtr()) {
+                zoneMap.numNulls++;
+                continue;
+            }
+            // we read the attribute through the raw object, so that the frontend never needs
+            // the vtable of the user type
+            char* object = (char*)(handles[i].getTarget()->getObject()) + attribute.byteOffset;
+            if ((object < recordBegin) || (object + sizeof(double) > recordEnd)) {
+                zoneMaps.clear();
+                return false;
+            }
+            switch (attribute.type) {
+                case ZoneMapInt: {
+                    int value;
+                    memcpy(&value, object, sizeof(int));
+                    addValue(zoneMap, (double)value);
+                    break;
+                }
+                case ZoneMapLong: {
+                    long value;
+                    memcpy(&value, object, sizeof(long));
+                    addValue(zoneMap, (double)value);
+                    break;
+                }
+                case ZoneMapFloat: {
+                    float value;
+                    memcpy(&value, object, sizeof(float));
+                    addValue(zoneMap, (double)value);
+                    break;
+                }
+                case ZoneMapDouble: {
+                    double value;
+                    memcpy(&value, object, sizeof(double));
+                    addValue(zoneMap, value);
+                    break;
+                }
+            }
+        }
+        zoneMaps.push_back(zoneMap);
+    }
+    return true;
+}
+
+bool PageSummarizer::mayMatch(const PageZoneMap& zoneMap, ZoneMapComparisonOp op, double constant) {
+    if (zoneMap.numValues == 0) {
+        // a page with only nulls never satisfies a comparison
+        return false;
+    }
+    switch (op) {
+        case ZoneMapLessThan:
+        case ZoneMapLessEqual:
+            return zoneMap.minValue <= constant;
+        case ZoneMapEqual:
+            return (zoneMap.minValue <= constant) && (constant <= zoneMap.maxValue);
+        case ZoneMapGreaterEqual:
+        case ZoneMapGreaterThan:
+            return zoneMap.maxValue >= constant;
+    }
+    return true;
+}
+
+double PageSummarizer::getEstimatedNumDistinctValues(const PageZoneMap& zoneMap) {
+    int numZeroBits = ZONE_MAP_SKETCH_BITS - __builtin_popcountll(zoneMap.distinctSketch);
+    if (numZeroBits == 0) {
+        // the sketch is saturated
+        return (double)zoneMap.numValues;
+    }
+    double estimate = -(double)ZONE_MAP_SKETCH_BITS *
+        log((double)numZeroBits / (double)ZONE_MAP_SKETCH_BITS);
+    if (estimate > (double)zoneMap.numValues) {
+        estimate = (double)zoneMap.numValues;
+    }
+    return estimate;
+}
+
+#endif
@@ -37,25 +37,39 @@ PDBPagePtr PartitionPageIterator::next() {
             pageToReturn = cache->getPage(this->sequenceFile, this->numIteratedPages);
             this->numIteratedPages++;
         } else {
+            // skip the pages that can't match the zone map predicate, so that they are never
+            // pinned in cache
+            while ((this->zoneMapAttributeIndex >= 0) &&
+                   (this->partitionedFile->getMetaData()->mayMatch(this->partitionId,
+                                                                   this->numIteratedPages,
+                                                                   this->zoneMapAttributeIndex,
+                                                                   this->zoneMapOp,
+                                                                   this->zoneMapValue) == false)) {
+                this->numIteratedPages++;
+                this->numSkippedPages++;
+                if (this->numIteratedPages >= this->numPages) {
+                    return nullptr;
+                }
+            }
             PageID curPageId =
                 this->partitionedFile->loadPageId(this->partitionId, this->numIteratedPages);
             std::cout << this->partitionId << ": PartitionedPageIterator: curTypeId=" << this->partitionedFile->getTypeId()
                      << ",curSetId=" << this->partitionedFile->getSetId()
                      << ",curPageId=" << curPageId << "\n";
-// page is pinned (ref count ++)
+// page is pinned (ref count ++), and the following pages of the partition are read ahead
 #ifdef USE_LOCALITY_SET
             pageToReturn = cache->getPage(this->partitionedFile,
                                           this->partitionId,
                                           this->numIteratedPages,
                                           curPageId,
-                                          false,
+                                          true,
                                           set);
 #else
             pageToReturn = cache->getPage(this->partitionedFile,
                                           this->partitionId,
                                           this->numIteratedPages,
                                           curPageId,
-                                          false,
+                                          true,
                                           nullptr);
 #endif
             PDB_COUT << "PartitionedPageIterator: got page" << std::endl;
@@ -75,3 +89,17 @@ bool PartitionPageIterator::hasNext() {
         return false;
     }
 }
+
+/**
+ * To skip pages whose zone maps prove that no object satisfies the predicate.
+ */
+bool PartitionPageIterator::setZoneMapPredicate(ZoneMapPredicate predicate) {
+    if (this->partitionedFile == nullptr) {
+        return false;
+    }
+    this->zoneMapAttributeIndex =
+        this->partitionedFile->getMetaData()->getZoneMapAttributeIndex(predicate.attributeName);
+    this->zoneMapOp = predicate.op;
+    this->zoneMapValue = predicate.value;
+    return (this->zoneMapAttributeIndex >= 0);
+}
@@ -1,5 +1,6 @@
 
 #include "PartitionedFile.h"
+#include "PageCompressor.h"
 #include "DataTypes.h"
 #include <stdio.h>
 #include <vector>
@@ -11,11 +12,22 @@
 #include <stdlib.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>
+#include <limits.h>
 #include <unistd.h>
 #include <sys/stat.h>
 #include <chrono>
 #include <ctime>
 using namespace std;
+
+// compressed pages are padded to this size, so that they can be written and read with direct I/O
+#define PAGE_STORAGE_ALIGNMENT 512
+
+static size_t roundUpToPageStorageAlignment(size_t length) {
+    return ((length + PAGE_STORAGE_ALIGNMENT - 1) / PAGE_STORAGE_ALIGNMENT) *
+        PAGE_STORAGE_ALIGNMENT;
+}
+
 /**
  * Create a new PartitionedFile instance.
  */
@@ -26,7 +38,8 @@ PartitionedFile::PartitionedFile(NodeID nodeId,
                                  string metaPartitionPath,
                                  vector<string> dataPartitionPaths,
                                  pdb::PDBLoggerPtr logger,
-                                 size_t pageSize) {
+                                 size_t pageSize,
+                                 PageCompressionType compressionType) {
     unsigned int i = 0;
 
     this->nodeId = nodeId;
@@ -45,6 +58,12 @@ PartitionedFile::PartitionedFile(NodeID nodeId,
     this->metaData->setNumFlushedPages(0);
     this->metaData->setVersion(0);
     this->metaData->setLatestPageId((unsigned int)(-1));
+    if (PageCompressor::isAvailable(compressionType) == false) {
+        std::cout << "PartitionedFile: " << PageCompressor::getName(compressionType)
+                  << " is not compiled in, pages will be stored uncompressed" << std::endl;
+        compressionType = NoPageCompression;
+    }
+    this->metaData->setCompressionType(compressionType);
     pthread_mutex_init(&this->fileMutex, nullptr);
     PartitionMetaDataPtr curPartitionMetaData;
     for (i = 0; i < dataPartitionPaths.size(); i++) {
@@ -259,13 +278,23 @@ int PartitionedFile::appendPage(FilePartitionID partitionId, PDBPagePtr page) {
     }
 
     PageID pageId = page->getPageID();
+    // the page is sealed now, summarize it before taking the file lock
+    vector<PageZoneMap> zoneMaps;
+    bool summarized = this->summarizePage(page, zoneMaps);
 
     pthread_mutex_lock(&this->fileMutex);
     if (this->cleared == true) {
         pthread_mutex_unlock(&this->fileMutex);
         return -1;
     }
-    if (this->writeData(curPartition, page->getRawBytes(), page->getRawSize()) < 0) {
+    PageStorageInfo info;
+    bool compressed = (this->metaData->getCompressionType() != NoPageCompression);
+    if (compressed == true) {
+        if (this->writeCompressedPage(partitionId, page, info) < 0) {
+            pthread_mutex_unlock(&this->fileMutex);
+            return -1;
+        }
+    } else if (this->writeData(curPartition, page->getRawBytes(), page->getRawSize()) < 0) {
         pthread_mutex_unlock(&this->fileMutex);
         return -1;
     }
@@ -279,6 +308,12 @@ int PartitionedFile::appendPage(FilePartitionID partitionId, PDBPagePtr page) {
 
     // update partition metadata
     int ret = (int)(this->metaData->getPartition(partitionId)->getNumPages());
+    if (compressed == true) {
+        this->metaData->addPageStorageInfo(partitionId, ret, info);
+    }
+    if (summarized == true) {
+        this->metaData->addPageZoneMaps(partitionId, ret, zoneMaps);
+    }
     this->metaData->addPageIndex(pageId, partitionId, ret);
     this->metaData->getPartition(partitionId)->incNumPages();
     pthread_mutex_unlock(&this->fileMutex);
@@ -295,12 +330,21 @@ int PartitionedFile::appendPageDirect(FilePartitionID partitionId, PDBPagePtr pa
     }
 
     PageID pageId = page->getPageID();
+    vector<PageZoneMap> zoneMaps;
+    bool summarized = this->summarizePage(page, zoneMaps);
     pthread_mutex_lock(&this->fileMutex);
     if (this->cleared == true) {
         pthread_mutex_unlock(&this->fileMutex);
         return -1;
     }
-    if (this->writeDataDirect(handle, page->getRawBytes(), page->getRawSize()) < 0) {
+    PageStorageInfo info;
+    bool compressed = (this->metaData->getCompressionType() != NoPageCompression);
+    if (compressed == true) {
+        if (this->writeCompressedPage(partitionId, page, info) < 0) {
+            pthread_mutex_unlock(&this->fileMutex);
+            return -1;
+        }
+    } else if (this->writeDataDirect(handle, page->getRawBytes(), page->getRawSize()) < 0) {
         pthread_mutex_unlock(&this->fileMutex);
         return -1;
     }
@@ -311,12 +355,215 @@ int PartitionedFile::appendPageDirect(FilePartitionID partitionId, PDBPagePtr pa
         this->metaData->setLatestPageId(pageId);
     }
     int ret = (int)(this->metaData->getPartition(partitionId)->getNumPages());
+    if (compressed == true) {
+        this->metaData->addPageStorageInfo(partitionId, ret, info);
+    }
+    if (summarized == true) {
+        this->metaData->addPageZoneMaps(partitionId, ret, zoneMaps);
+    }
     this->metaData->addPageIndex(pageId, partitionId, ret);
     this->metaData->getPartition(partitionId)->incNumPages();
     pthread_mutex_unlock(&this->fileMutex);
     return ret;
 }
 
+/**
+ * Append a batch of pages to the partition with one vectored write
+ */
+int PartitionedFile::appendPages(FilePartitionID partitionId,
+                                 vector<PDBPagePtr>& pages,
+                                 vector<int>& seqs) {
+    int handle = -1;
+    FILE* curPartition = nullptr;
+    if (usingDirect == true) {
+        handle = this->dataHandles.at(partitionId);
+    } else if ((curPartition = this->dataFiles.at(partitionId)) != nullptr) {
+        handle = fileno(curPartition);
+    }
+    if (handle < 0) {
+        return -1;
+    }
+    int numPages = pages.size();
+    if (numPages == 0) {
+        return 0;
+    }
+    vector<vector<PageZoneMap>> zoneMaps(numPages);
+    vector<bool> summarized(numPages);
+    for (int i = 0; i < numPages; i++) {
+        summarized[i] = this->summarizePage(pages[i], zoneMaps[i]);
+    }
+
+    pthread_mutex_lock(&this->fileMutex);
+    if (this->cleared == true) {
+        pthread_mutex_unlock(&this->fileMutex);
+        return -1;
+    }
+    vector<PageStorageInfo> infos(numPages);
+    bool compressed = (this->metaData->getCompressionType() != NoPageCompression);
+    if (compressed == true) {
+        // compressed pages have different lengths, and each gets its own aligned buffer
+        for (int i = 0; i < numPages; i++) {
+            if (this->writeCompressedPage(partitionId, pages[i], infos[i]) < 0) {
+                pthread_mutex_unlock(&this->fileMutex);
+                return -1;
+            }
+        }
+    } else {
+        vector<struct iovec> buffers(numPages);
+        for (int i = 0; i < numPages; i++) {
+            buffers[i].iov_base = pages[i]->getRawBytes();
+            buffers[i].iov_len = pages[i]->getRawSize();
+        }
+        if (curPartition != nullptr) {
+            // the file is opened for appending, so the write goes to the end of it
+            fflush(curPartition);
+        }
+        if (this->writeDataVector(handle, buffers.data(), numPages) < 0) {
+            pthread_mutex_unlock(&this->fileMutex);
+            return -1;
+        }
+    }
+    // update metadata;
+    seqs.clear();
+    PartitionMetaDataPtr partition = this->metaData->getPartition(partitionId);
+    for (int i = 0; i < numPages; i++) {
+        PageID pageId = pages[i]->getPageID();
+        this->metaData->incNumFlushedPages();
+        if ((pageId > this->metaData->getLatestPageId()) ||
+            (this->metaData->getLatestPageId() == (unsigned int)(-1))) {
+            this->metaData->setLatestPageId(pageId);
+        }
+        int seq = (int)(partition->getNumPages());
+        if (compressed == true) {
+            this->metaData->addPageStorageInfo(partitionId, seq, infos[i]);
+        }
+        if (summarized[i] == true) {
+            this->metaData->addPageZoneMaps(partitionId, seq, zoneMaps[i]);
+        }
+        this->metaData->addPageIndex(pageId, partitionId, seq);
+        partition->incNumPages();
+        seqs.push_back(seq);
+    }
+    pthread_mutex_unlock(&this->fileMutex);
+    return numPages;
+}
+
+/**
+ * Build the zone maps of the declared attributes for a page to append.
+ * Return false if no attribute is declared or the page can't be summarized.
+ */
+bool PartitionedFile::summarizePage(PDBPagePtr page, vector<PageZoneMap>& zoneMaps) {
+    vector<ZoneMapAttribute> attributes = this->metaData->getZoneMapAttributes();
+    if (attributes.size() == 0) {
+        return false;
+    }
+    return PageSummarizer::summarize(page, attributes, zoneMaps);
+}
+
+/**
+ * Compress the page, and append it to the end of the partition.
+ * If the page does not get smaller, it is stored uncompressed.
+ */
+int PartitionedFile::writeCompressedPage(FilePartitionID partitionId,
+                                         PDBPagePtr page,
+                                         PageStorageInfo& info) {
+    PageCompressionType compressionType = this->metaData->getCompressionType();
+    size_t rawSize = page->getRawSize();
+    size_t bufferSize = roundUpToPageStorageAlignment(
+        PageCompressor::getMaxCompressedLength(compressionType, rawSize));
+    char* buffer = nullptr;
+    if (posix_memalign((void**)&buffer, PAGE_STORAGE_ALIGNMENT, bufferSize) != 0) {
+        std::cout << "PartitionedFile: Failed to allocate compression buffer with size="
+                  << bufferSize << std::endl;
+        return -1;
+    }
+    size_t length = PageCompressor::compress(compressionType, page->getRawBytes(), rawSize, buffer);
+    char* data = buffer;
+    if ((length == 0) || (roundUpToPageStorageAlignment(length) >= rawSize)) {
+        // not worth it, store the page as it is
+        compressionType = NoPageCompression;
+        length = rawSize;
+        data = page->getRawBytes();
+    }
+    size_t paddedLength = roundUpToPageStorageAlignment(length);
+    if (data == buffer) {
+        memset(buffer + length, 0, paddedLength - length);
+    } else if (paddedLength != length) {
+        // the page data is not padded, so copy it to the aligned buffer
+        memcpy(buffer, data, length);
+        memset(buffer + length, 0, paddedLength - length);
+        data = buffer;
+    }
+    PartitionMetaDataPtr partition = this->metaData->getPartition(partitionId);
+    int ret;
+    if (usingDirect == true) {
+        ret = this->writeDataDirect(this->dataHandles.at(partitionId), data, paddedLength);
+    } else {
+        ret = this->writeData(this->dataFiles.at(partitionId), data, paddedLength);
+    }
+    free(buffer);
+    if (ret < 0) {
+        return -1;
+    }
+    info.offset = partition->getDataSize();
+    info.length = length;
+    info.compressionType = compressionType;
+    partition->setDataSize(info.offset + paddedLength);
+    return 0;
+}
+
+/**
+ * Load and decompress a page described by info into pageInCache, using positional read.
+ */
+size_t PartitionedFile::loadCompressedPage(FilePartitionID partitionId,
+                                           const PageStorageInfo& info,
+                                           char* pageInCache,
+                                           size_t length) {
+    int handle;
+    if (usingDirect == true) {
+        handle = this->dataHandles.at(partitionId);
+    } else {
+        FILE* curFile = this->dataFiles.at(partitionId);
+        if (curFile == nullptr) {
+            return (size_t)(-1);
+        }
+        handle = fileno(curFile);
+    }
+    if (handle < 0) {
+        return (size_t)(-1);
+    }
+    size_t paddedLength = roundUpToPageStorageAlignment(info.length);
+    if (info.compressionType == NoPageCompression) {
+        // read straight into the page, which is aligned by the shared memory allocator
+        if (paddedLength > length) {
+            return (size_t)(-1);
+        }
+        ssize_t ret = pread(handle, pageInCache, paddedLength, (off_t)info.offset);
+        if (ret < (ssize_t)info.length) {
+            return (size_t)(-1);
+        }
+        return info.length;
+    }
+    char* buffer = nullptr;
+    if (posix_memalign((void**)&buffer, PAGE_STORAGE_ALIGNMENT, paddedLength) != 0) {
+        std::cout << "PartitionedFile: Failed to allocate decompression buffer with size="
+                  << paddedLength << std::endl;
+        return (size_t)(-1);
+    }
+    ssize_t ret = pread(handle, buffer, paddedLength, (off_t)info.offset);
+    size_t loadedSize = (size_t)(-1);
+    if (ret >= (ssize_t)info.length) {
+        loadedSize = PageCompressor::decompress(
+            info.compressionType, buffer, info.length, pageInCache, length);
+    }
+    free(buffer);
+    if (loadedSize == (size_t)(-1)) {
+        std::cout << "PartitionedFile: Failed to load compressed page at offset=" << info.offset
+                  << " in partition " << partitionId << std::endl;
+    }
+    return loadedSize;
+}
+
 
 /**
   * Set the shared page set that is related to this partitioned file instance
@@ -413,6 +660,29 @@ int PartitionedFile::getNumSharedPages() {
  * - PartitionId for the 1st page
  * - PageSeqIdInPartition for the 1st page
  * - ...
+ * - PageCompressionType for new pages
+ * - Number of compressed pages
+ * - PartitionId for the 1st compressed page
+ * - PageSeqIdInPartition for the 1st compressed page
+ * - Offset of the 1st compressed page
+ * - Length of the 1st compressed page
+ * - PageCompressionType of the 1st compressed page
+ * - ...
+ * - Number of zone map attributes
+ * - Length of the name of the 1st attribute
+ * - Name of the 1st attribute
+ * - Byte offset of the 1st attribute in an object
+ * - ZoneMapAttributeType of the 1st attribute
+ * - ...
+ * - Number of summarized pages
+ * - PartitionId for the 1st summarized page
+ * - PageSeqIdInPartition for the 1st summarized page
+ * - Number of zone maps of the 1st summarized page
+ * - Min, max, number of values, number of nulls and distinct sketch of the 1st zone map
+ * - ...
+ * - Number of columnar attributes
+ * - Index of the 1st columnar attribute in the zone map attributes
+ * - ...
  */
 int PartitionedFile::writeMeta() {
     pthread_mutex_lock(&this->fileMutex);
@@ -440,8 +710,31 @@ int PartitionedFile::writeMeta() {
     metaSize += sizeof(DatabaseID)+sizeof(UserTypeID)+sizeof(SetID)+sizeof(unsigned int);
     unsigned int numSharedPages = this->metaData->getNumSharedPages();
     for (i = 0; i < numSharedPages; i++) {
-	 metaSize += sizeof(FilePartitionID) + sizeof(unsigned int);
+	 metaSize += sizeof(PageID) + sizeof(FilePartitionID) + sizeof(unsigned int);
+    }
+    unsigned int numCompressedPages = this->metaData->getPageStorageInfos()->size();
+    metaSize += sizeof(PageCompressionType) + sizeof(unsigned int);
+    metaSize += numCompressedPages * (sizeof(FilePartitionID) + sizeof(unsigned int) +
+                                      sizeof(size_t) + sizeof(size_t) + sizeof(PageCompressionType));
+    vector<ZoneMapAttribute>* zoneMapAttributes = this->metaData->getZoneMapAttributesPtr();
+    metaSize += sizeof(unsigned int);
+    for (auto& attribute : *zoneMapAttributes) {
+        metaSize += sizeof(size_t) + attribute.name.length() + 1 + sizeof(size_t) +
+            sizeof(ZoneMapAttributeType);
+    }
+    metaSize += sizeof(unsigned int);
+    for (auto& pageZoneMaps : *this->metaData->getPageZoneMaps()) {
+        metaSize += sizeof(FilePartitionID) + sizeof(unsigned int) + sizeof(unsigned int) +
+            pageZoneMaps.second.size() * (sizeof(double) + sizeof(double) + sizeof(unsigned int) +
+                                          sizeof(unsigned int) + sizeof(uint64_t));
+    }
+    unsigned int numColumnarAttributes = 0;
+    for (auto& attribute : *zoneMapAttributes) {
+        if (attribute.columnar == true) {
+            numColumnarAttributes++;
+        }
     }
+    metaSize += sizeof(unsigned int) + numColumnarAttributes * sizeof(unsigned int);
     // write meta size to meta partition
     fseek(this->metaFile, 0, SEEK_SET);
     fwrite((size_t*)(&metaSize), sizeof(size_t), 1, this->metaFile);
@@ -529,6 +822,69 @@ int PartitionedFile::writeMeta() {
 	      }
      }
     }
+    // write information for compressed pages
+    *((PageCompressionType*)cur) = this->metaData->getCompressionType();
+    cur = cur + sizeof(PageCompressionType);
+    *((unsigned int*)cur) = numCompressedPages;
+    cur = cur + sizeof(unsigned int);
+    for (auto iter = this->metaData->getPageStorageInfos()->begin();
+         iter != this->metaData->getPageStorageInfos()->end();
+         iter++) {
+        *((FilePartitionID*)cur) = iter->first.partitionId;
+        cur = cur + sizeof(FilePartitionID);
+        *((unsigned int*)cur) = iter->first.pageSeqInPartition;
+        cur = cur + sizeof(unsigned int);
+        *((size_t*)cur) = iter->second.offset;
+        cur = cur + sizeof(size_t);
+        *((size_t*)cur) = iter->second.length;
+        cur = cur + sizeof(size_t);
+        *((PageCompressionType*)cur) = iter->second.compressionType;
+        cur = cur + sizeof(PageCompressionType);
+    }
+    // write information for zone maps
+    *((unsigned int*)cur) = zoneMapAttributes->size();
+    cur = cur + sizeof(unsigned int);
+    for (auto& attribute : *zoneMapAttributes) {
+        *((size_t*)cur) = attribute.name.length() + 1;
+        cur = cur + sizeof(size_t);
+        memcpy(cur, attribute.name.c_str(), attribute.name.length() + 1);
+        cur = cur + attribute.name.length() + 1;
+        *((size_t*)cur) = attribute.byteOffset;
+        cur = cur + sizeof(size_t);
+        *((ZoneMapAttributeType*)cur) = attribute.type;
+        cur = cur + sizeof(ZoneMapAttributeType);
+    }
+    *((unsigned int*)cur) = this->metaData->getPageZoneMaps()->size();
+    cur = cur + sizeof(unsigned int);
+    for (auto& pageZoneMaps : *this->metaData->getPageZoneMaps()) {
+        *((FilePartitionID*)cur) = pageZoneMaps.first.partitionId;
+        cur = cur + sizeof(FilePartitionID);
+        *((unsigned int*)cur) = pageZoneMaps.first.pageSeqInPartition;
+        cur = cur + sizeof(unsigned int);
+        *((unsigned int*)cur) = pageZoneMaps.second.size();
+        cur = cur + sizeof(unsigned int);
+        for (auto& zoneMap : pageZoneMaps.second) {
+            *((double*)cur) = zoneMap.minValue;
+            cur = cur + sizeof(double);
+            *((double*)cur) = zoneMap.maxValue;
+            cur = cur + sizeof(double);
+            *((unsigned int*)cur) = zoneMap.numValues;
+            cur = cur + sizeof(unsigned int);
+            *((unsigned int*)cur) = zoneMap.numNulls;
+            cur = cur + sizeof(unsigned int);
+            *((uint64_t*)cur) = zoneMap.distinctSketch;
+            cur = cur + sizeof(uint64_t);
+        }
+    }
+    // write information for columnar attributes
+    *((unsigned int*)cur) = numColumnarAttributes;
+    cur = cur + sizeof(unsigned int);
+    for (i = 0; i < zoneMapAttributes->size(); i++) {
+        if (zoneMapAttributes->at(i).columnar == true) {
+            *((unsigned int*)cur) = i;
+            cur = cur + sizeof(unsigned int);
+        }
+    }
     // write meta data
     fseek(this->metaFile, sizeof(size_t), SEEK_SET);
     int ret = this->writeData(this->metaFile, (void*)buffer, metaSize);
@@ -586,6 +942,10 @@ size_t PartitionedFile::loadPage(FilePartitionID partitionId,
     if (usingDirect == true) {
         return loadPageDirect(partitionId, pageSeqInPartition, pageInCache, length);
     }
+    PageStorageInfo info;
+    if (this->metaData->getPageStorageInfo(partitionId, pageSeqInPartition, info) == true) {
+        return this->loadCompressedPage(partitionId, info, pageInCache, length);
+    }
     FILE* curFile = this->dataFiles.at(partitionId);
     if (curFile == nullptr) {
         return 0;
@@ -605,6 +965,10 @@ size_t PartitionedFile::loadPageDirect(FilePartitionID partitionId,
                                        unsigned int pageSeqInPartition,
                                        char* pageInCache,
                                        size_t length) {
+    PageStorageInfo info;
+    if (this->metaData->getPageStorageInfo(partitionId, pageSeqInPartition, info) == true) {
+        return this->loadCompressedPage(partitionId, info, pageInCache, length);
+    }
     int handle = this->dataHandles.at(partitionId);
     size_t ret;
     if (handle < 0) {
@@ -619,6 +983,42 @@ size_t PartitionedFile::loadPageDirect(FilePartitionID partitionId,
     return ret;
 }
 
+/**
+ * To load the page using positional read, without seeking or moving the file position.
+ */
+size_t PartitionedFile::loadPageAt(FilePartitionID partitionId,
+                                   unsigned int pageSeqInPartition,
+                                   char* pageInCache,
+                                   size_t length) {
+    PageStorageInfo info;
+    if (this->metaData->getPageStorageInfo(partitionId, pageSeqInPartition, info) == true) {
+        return this->loadCompressedPage(partitionId, info, pageInCache, length);
+    }
+    int handle;
+    if (usingDirect == true) {
+        handle = this->dataHandles.at(partitionId);
+    } else {
+        FILE* curFile = this->dataFiles.at(partitionId);
+        if (curFile == nullptr) {
+            return (size_t)(-1);
+        }
+        handle = fileno(curFile);
+    }
+    if (handle < 0) {
+        return (size_t)(-1);
+    }
+    if (pageSeqInPartition < this->getMetaData()->getPartition(partitionId)->getNumPages()) {
+        off_t offset = (off_t)pageSeqInPartition * (off_t)(this->metaData->getPageSize());
+        ssize_t ret = pread(handle, pageInCache, length, offset);
+        if (ret < 0) {
+            return (size_t)(-1);
+        }
+        return (size_t)ret;
+    } else {
+        return (size_t)(-1);
+    }
+}
+
 /**
  * To load the pageId for a specified page.
  * Return the pageId, if page exists, otherwise, return (unsigned int)(-1)
@@ -637,6 +1037,10 @@ size_t PartitionedFile::loadPageFromCurPos(FilePartitionID partitionId,
                                            unsigned int pageSeqInPartition,
                                            char* pageInCache,
                                            size_t length) {
+    PageStorageInfo info;
+    if (this->metaData->getPageStorageInfo(partitionId, pageSeqInPartition, info) == true) {
+        return this->loadCompressedPage(partitionId, info, pageInCache, length);
+    }
     FILE* curFile = this->dataFiles.at(partitionId);
     if (curFile == nullptr) {
         return 0;
@@ -765,6 +1169,53 @@ unsigned int PartitionedFile::getNumPartitions() {
     return this->dataPartitionPaths.size();
 }
 
+/**
+ * To return the codec used for new pages
+ */
+PageCompressionType PartitionedFile::getCompressionType() {
+    return this->metaData->getCompressionType();
+}
+
+/**
+ * To return the number of bytes used by flushed pages on disk
+ */
+size_t PartitionedFile::getNumStoredBytes() {
+    size_t numStoredBytes = 0;
+    unsigned int numUncompressedPages = this->metaData->getNumFlushedPages();
+    pthread_mutex_lock(&this->fileMutex);
+    for (auto iter = this->metaData->getPageStorageInfos()->begin();
+         iter != this->metaData->getPageStorageInfos()->end();
+         iter++) {
+        numStoredBytes += roundUpToPageStorageAlignment(iter->second.length);
+        numUncompressedPages--;
+    }
+    pthread_mutex_unlock(&this->fileMutex);
+    return numStoredBytes + (size_t)numUncompressedPages * this->getPageSize();
+}
+
+/**
+ * To return the uncompressed size of flushed pages divided by the size used on disk
+ */
+double PartitionedFile::getCompressionRatio() {
+    size_t numStoredBytes = this->getNumStoredBytes();
+    if (numStoredBytes == 0) {
+        return 1.0;
+    }
+    return (double)(this->metaData->getNumFlushedPages()) * (double)(this->getPageSize()) /
+        (double)numStoredBytes;
+}
+
+/**
+ * To declare an attribute to summarize in the zone maps of pages appended from now on
+ */
+bool PartitionedFile::addZoneMapAttribute(ZoneMapAttribute attribute) {
+    if (this->metaData->addZoneMapAttribute(attribute) == false) {
+        return false;
+    }
+    this->writeMeta();
+    return true;
+}
+
 /**
  * Set up meta data by parsing meta partition
  */
@@ -929,6 +1380,96 @@ void PartitionedFile::buildMetaDataFromMetaPartition(SharedMemPtr shm) {
 	cur = cur + sizeof(unsigned int);
 	this->metaData->addSharedPageIndex(pageId, partitionId, pageSeqInPartition);
     }
+
+    // reconstruct compressed page information, which is absent in meta partitions written
+    // before page compression was supported
+    if (cur + sizeof(PageCompressionType) + sizeof(unsigned int) <= buf + size) {
+        this->metaData->setCompressionType((PageCompressionType)(*(PageCompressionType*)cur));
+        cur = cur + sizeof(PageCompressionType);
+        unsigned int numCompressedPages = (unsigned int)(*(unsigned int*)cur);
+        cur = cur + sizeof(unsigned int);
+        PageStorageInfo info;
+        for (i = 0; i < numCompressedPages; i++) {
+            partitionId = (FilePartitionID)(*(FilePartitionID*)cur);
+            cur = cur + sizeof(FilePartitionID);
+            pageSeqInPartition = (unsigned int)(*(unsigned int*)cur);
+            cur = cur + sizeof(unsigned int);
+            info.offset = (size_t)(*(size_t*)cur);
+            cur = cur + sizeof(size_t);
+            info.length = (size_t)(*(size_t*)cur);
+            cur = cur + sizeof(size_t);
+            info.compressionType = (PageCompressionType)(*(PageCompressionType*)cur);
+            cur = cur + sizeof(PageCompressionType);
+            this->metaData->addPageStorageInfo(partitionId, pageSeqInPartition, info);
+            // new pages are appended after the last compressed page
+            PartitionMetaDataPtr partition = this->metaData->getPartition(partitionId);
+            size_t end = info.offset + roundUpToPageStorageAlignment(info.length);
+            if (end > partition->getDataSize()) {
+                partition->setDataSize(end);
+            }
+        }
+    }
+
+    // reconstruct zone maps, which are absent in meta partitions written before zone maps were
+    // supported
+    if (cur + sizeof(unsigned int) <= buf + size) {
+        unsigned int numAttributes = (unsigned int)(*(unsigned int*)cur);
+        cur = cur + sizeof(unsigned int);
+        ZoneMapAttribute attribute;
+        for (i = 0; i < numAttributes; i++) {
+            size_t nameLen = (size_t)(*(size_t*)cur);
+            cur = cur + sizeof(size_t);
+            attribute.name = string(cur);
+            cur = cur + nameLen;
+            attribute.byteOffset = (size_t)(*(size_t*)cur);
+            cur = cur + sizeof(size_t);
+            attribute.type = (ZoneMapAttributeType)(*(ZoneMapAttributeType*)cur);
+            cur = cur + sizeof(ZoneMapAttributeType);
+            attribute.columnar = false;
+            this->metaData->addZoneMapAttribute(attribute);
+        }
+        unsigned int numSummarizedPages = (unsigned int)(*(unsigned int*)cur);
+        cur = cur + sizeof(unsigned int);
+        for (i = 0; i < numSummarizedPages; i++) {
+            partitionId = (FilePartitionID)(*(FilePartitionID*)cur);
+            cur = cur + sizeof(FilePartitionID);
+            pageSeqInPartition = (unsigned int)(*(unsigned int*)cur);
+            cur = cur + sizeof(unsigned int);
+            unsigned int numZoneMaps = (unsigned int)(*(unsigned int*)cur);
+            cur = cur + sizeof(unsigned int);
+            vector<PageZoneMap> zoneMaps;
+            PageZoneMap zoneMap;
+            for (unsigned int j = 0; j < numZoneMaps; j++) {
+                zoneMap.minValue = (double)(*(double*)cur);
+                cur = cur + sizeof(double);
+                zoneMap.maxValue = (double)(*(double*)cur);
+                cur = cur + sizeof(double);
+                zoneMap.numValues = (unsigned int)(*(unsigned int*)cur);
+                cur = cur + sizeof(unsigned int);
+                zoneMap.numNulls = (unsigned int)(*(unsigned int*)cur);
+                cur = cur + sizeof(unsigned int);
+                zoneMap.distinctSketch = (uint64_t)(*(uint64_t*)cur);
+                cur = cur + sizeof(uint64_t);
+                zoneMaps.push_back(zoneMap);
+            }
+            this->metaData->addPageZoneMaps(partitionId, pageSeqInPartition, zoneMaps);
+        }
+    }
+
+    // reconstruct columnar attributes, which are absent in meta partitions written before
+    // columnar attributes were supported
+    if (cur + sizeof(unsigned int) <= buf + size) {
+        unsigned int numColumnarAttributes = (unsigned int)(*(unsigned int*)cur);
+        cur = cur + sizeof(unsigned int);
+        vector<ZoneMapAttribute>* zoneMapAttributes = this->metaData->getZoneMapAttributesPtr();
+        for (i = 0; i < numColumnarAttributes; i++) {
+            unsigned int index = (unsigned int)(*(unsigned int*)cur);
+            cur = cur + sizeof(unsigned int);
+            if (index < zoneMapAttributes->size()) {
+                zoneMapAttributes->at(index).columnar = true;
+            }
+        }
+    }
     free(buf);
 }
 
@@ -1020,6 +1561,36 @@ int PartitionedFile::writeDataDirect(int handle, void* data, size_t length) {
 }
 
 
+/**
+ * Write the buffers specified to the current file position with vectored writes,
+ * resuming after short writes.
+ */
+int PartitionedFile::writeDataVector(int handle, struct iovec* buffers, int numBuffers) {
+    if ((handle < 0) || (buffers == nullptr)) {
+        cout << "PartitionedFile: Error: invalid handle or buffers is nullptr.\n";
+        return -1;
+    }
+    while (numBuffers > 0) {
+        int numToWrite = (numBuffers < IOV_MAX) ? numBuffers : IOV_MAX;
+        ssize_t retSize = writev(handle, buffers, numToWrite);
+        if (retSize <= 0) {
+            cout << "PartitionedFile: Error: writev failed with " << retSize << "\n";
+            return -1;
+        }
+        size_t written = retSize;
+        while ((numBuffers > 0) && (written >= buffers->iov_len)) {
+            written -= buffers->iov_len;
+            buffers++;
+            numBuffers--;
+        }
+        if (written > 0) {
+            buffers->iov_base = (char*)buffers->iov_base + written;
+            buffers->iov_len -= written;
+        }
+    }
+    return 0;
+}
+
 /**
  * Seek to the beginning of the page data for a page specified in the file.
  */
@@ -0,0 +1,228 @@
+#ifndef SECOND_TIER_CACHE_CC
+#define SECOND_TIER_CACHE_CC
+
+#include "PDBDebug.h"
+#include "SecondTierCache.h"
+#include <fcntl.h>
+#include <iostream>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+SecondTierCache::SecondTierCache(string path,
+                                 size_t capacity,
+                                 size_t slotSize,
+                                 pdb::PDBLoggerPtr logger) {
+    this->path = path;
+    this->logger = logger;
+    this->slotSize = slotSize;
+    this->numSlots = (slotSize == 0) ? 0 : capacity / slotSize;
+    this->clockHand = 0;
+    pthread_mutex_init(&(this->mutex), nullptr);
+    this->handle = -1;
+    if (this->numSlots == 0) {
+        std::cout << "SecondTierCache: capacity " << capacity << " is smaller than a page of "
+                  << slotSize << " bytes, the second cache tier is disabled" << std::endl;
+        return;
+    }
+    this->handle = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    if (this->handle < 0) {
+        std::cout << "SecondTierCache: can't open " << path
+                  << ", the second cache tier is disabled" << std::endl;
+        this->logger->error("SecondTierCache: can't open " + path);
+        return;
+    }
+    this->slots.resize(this->numSlots);
+    for (size_t i = 0; i < this->numSlots; i++) {
+        this->slots[i].size = 0;
+        this->slots[i].state = SlotFree;
+        this->slots[i].invalidated = false;
+        // the first slots are used first
+        this->freeSlots.push_back(this->numSlots - 1 - i);
+    }
+    std::cout << "SecondTierCache: caching up to " << this->numSlots << " pages of " << slotSize
+              << " bytes in " << path << std::endl;
+}
+
+SecondTierCache::~SecondTierCache() {
+    if (this->handle >= 0) {
+        close(this->handle);
+        unlink(this->path.c_str());
+    }
+    pthread_mutex_destroy(&(this->mutex));
+}
+
+bool SecondTierCache::isOpen() {
+    return this->handle >= 0;
+}
+
+void SecondTierCache::rememberKey(CacheKey key) {
+    if (this->recentKeySet.count(key) > 0) {
+        return;
+    }
+    this->recentKeys.push_back(key);
+    this->recentKeySet.insert(key);
+    if (this->recentKeys.size() > this->numSlots) {
+        this->recentKeySet.erase(this->recentKeys.front());
+        this->recentKeys.pop_front();
+    }
+}
+
+long SecondTierCache::findSlot() {
+    if (this->freeSlots.empty() == false) {
+        size_t slot = this->freeSlots.back();
+        this->freeSlots.pop_back();
+        return slot;
+    }
+    for (size_t i = 0; i < this->numSlots; i++) {
+        size_t slot = this->clockHand;
+        this->clockHand = (this->clockHand + 1) % this->numSlots;
+        if (this->slots[slot].state == SlotCached) {
+            this->index.erase(this->slots[slot].key);
+            this->slots[slot].state = SlotFree;
+            return slot;
+        }
+    }
+    return -1;
+}
+
+bool SecondTierCache::admit(CacheKey key, char* data, size_t size) {
+    if ((this->handle < 0) || (data == nullptr) || (size == 0) || (size > this->slotSize)) {
+        return false;
+    }
+    pthread_mutex_lock(&(this->mutex));
+    auto iter = this->index.find(key);
+    if (iter != this->index.end()) {
+        // an older copy of the page, which is replaced below
+        this->slots[iter->second].state = SlotFree;
+        this->freeSlots.push_back(iter->second);
+        this->index.erase(iter);
+    } else if (this->recentKeySet.count(key) == 0) {
+        this->rememberKey(key);
+        pthread_mutex_unlock(&(this->mutex));
+        return false;
+    }
+    long slot = this->findSlot();
+    if (slot < 0) {
+        pthread_mutex_unlock(&(this->mutex));
+        return false;
+    }
+    this->slots[slot].key = key;
+    this->slots[slot].size = size;
+    this->slots[slot].state = SlotWriting;
+    this->slots[slot].invalidated = false;
+    pthread_mutex_unlock(&(this->mutex));
+
+    off_t offset = (off_t)slot * (off_t)this->slotSize;
+    size_t written = 0;
+    while (written < size) {
+        ssize_t ret = pwrite(this->handle, data + written, size - written, offset + written);
+        if (ret <= 0) {
+            break;
+        }
+        written += ret;
+    }
+
+    pthread_mutex_lock(&(this->mutex));
+    bool admitted = (written == size) && (this->slots[slot].invalidated == false);
+    if (admitted == true) {
+        this->slots[slot].state = SlotCached;
+        this->index[key] = slot;
+    } else {
+        this->slots[slot].state = SlotFree;
+        this->freeSlots.push_back(slot);
+    }
+    pthread_mutex_unlock(&(this->mutex));
+    if (written != size) {
+        this->logger->error("SecondTierCache: failed to write a page to " + this->path);
+    }
+    return admitted;
+}
+
+bool SecondTierCache::contains(CacheKey key) {
+    if (this->handle < 0) {
+        return false;
+    }
+    pthread_mutex_lock(&(this->mutex));
+    bool ret = (this->index.count(key) > 0);
+    pthread_mutex_unlock(&(this->mutex));
+    return ret;
+}
+
+bool SecondTierCache::restore(CacheKey key, char* buffer, size_t size) {
+    if (this->handle < 0) {
+        return false;
+    }
+    pthread_mutex_lock(&(this->mutex));
+    auto iter = this->index.find(key);
+    if (iter == this->index.end()) {
+        pthread_mutex_unlock(&(this->mutex));
+        return false;
+    }
+    size_t slot = iter->second;
+    this->index.erase(iter);
+    size_t pageSize = this->slots[slot].size;
+    if (pageSize != size) {
+        // the page size of the set changed, so the copy is useless
+        this->slots[slot].state = SlotFree;
+        this->freeSlots.push_back(slot);
+        pthread_mutex_unlock(&(this->mutex));
+        return false;
+    }
+    this->slots[slot].state = SlotReading;
+    // the page has been reused, so admit it right away when it is evicted again
+    this->rememberKey(key);
+    pthread_mutex_unlock(&(this->mutex));
+
+    off_t offset = (off_t)slot * (off_t)this->slotSize;
+    size_t numRead = 0;
+    while (numRead < size) {
+        ssize_t ret = pread(this->handle, buffer + numRead, size - numRead, offset + numRead);
+        if (ret <= 0) {
+            break;
+        }
+        numRead += ret;
+    }
+
+    pthread_mutex_lock(&(this->mutex));
+    this->slots[slot].state = SlotFree;
+    this->freeSlots.push_back(slot);
+    pthread_mutex_unlock(&(this->mutex));
+    if (numRead != size) {
+        this->logger->error("SecondTierCache: failed to read a page from " + this->path);
+        return false;
+    }
+    return true;
+}
+
+void SecondTierCache::invalidateSet(DatabaseID dbId, UserTypeID typeId, SetID setId) {
+    if (this->handle < 0) {
+        return;
+    }
+    pthread_mutex_lock(&(this->mutex));
+    for (size_t slot = 0; slot < this->numSlots; slot++) {
+        Slot& cur = this->slots[slot];
+        if ((cur.state == SlotFree) || (cur.key.dbId != dbId) || (cur.key.typeId != typeId) ||
+            (cur.key.setId != setId)) {
+            continue;
+        }
+        if (cur.state == SlotCached) {
+            this->index.erase(cur.key);
+            cur.state = SlotFree;
+            this->freeSlots.push_back(slot);
+        } else if (cur.state == SlotWriting) {
+            cur.invalidated = true;
+        }
+    }
+    pthread_mutex_unlock(&(this->mutex));
+}
+
+size_t SecondTierCache::getNumPages() {
+    pthread_mutex_lock(&(this->mutex));
+    size_t ret = this->index.size();
+    pthread_mutex_unlock(&(this->mutex));
+    return ret;
+}
+
+#endif
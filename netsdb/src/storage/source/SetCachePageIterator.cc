@@ -35,14 +35,15 @@ PDBPagePtr SetCachePageIterator::end() {
 }
 
 PDBPagePtr SetCachePageIterator::next() {
-    this->cache->evictionLock();
     if (this->iter != this->set->getDirtyPageSet()->end()) {
+        CacheKey key;
+        key.dbId = this->set->getDbID();
+        key.typeId = this->set->getTypeID();
+        key.setId = this->set->getSetID();
+        key.pageId = this->iter->first;
+        // only the cache shard that owns the page needs to be guarded against eviction
+        this->cache->evictionLock(key);
         if (this->iter->second.inCache == true) {
-            CacheKey key;
-            key.dbId = this->set->getDbID();
-            key.typeId = this->set->getTypeID();
-            key.setId = this->set->getSetID();
-            key.pageId = this->iter->first;
             std::cout << "SetCachePageIterator: in cache: curPageId=" << key.pageId << "\n";
 #ifdef USE_LOCALITY_SET
             PDBPagePtr page = this->cache->getPage1(key, this->set);
@@ -50,14 +51,14 @@ PDBPagePtr SetCachePageIterator::next() {
             PDBPagePtr page = this->cache->getPage1(key, nullptr);
 #endif
             ++iter;
-            this->cache->evictionUnlock();
+            this->cache->evictionUnlock(key);
             return page;
         } else {
             // the page is already flushed to file, so load from file
             PageID pageId = this->iter->first;
             std::cout << "SetCachePageIterator: not in cache: curPageId=" << pageId << "\n";
             FileSearchKey searchKey = this->iter->second;
-            this->cache->evictionUnlock();
+            this->cache->evictionUnlock(key);
 
 #ifdef USE_LOCALITY_SET
             PDBPagePtr page = this->cache->getPage(this->set->getFile(),
@@ -0,0 +1,300 @@
+#ifndef STREAM_CODEC_SELECTOR_CC
+#define STREAM_CODEC_SELECTOR_CC
+
+#include "StreamCodecSelector.h"
+#include "PageCompressor.h"
+#include <snappy.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+
+// the nanoseconds since begin
+static size_t nanosecondsSince(std::chrono::steady_clock::time_point begin) {
+    return (size_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - begin)
+        .count();
+}
+
+StreamCodecMetrics::StreamCodecMetrics() {
+    for (int i = 0; i <= ZstdPageCompression; i++) {
+        numPages[i] = 0;
+        numRawBytes[i] = 0;
+        numCompressedBytes[i] = 0;
+        compressNanoseconds[i] = 0;
+        numDecompressedPages[i] = 0;
+        decompressNanoseconds[i] = 0;
+    }
+}
+
+long StreamCodecMetrics::getBytesSaved() const {
+    long saved = 0;
+    for (int i = 0; i <= ZstdPageCompression; i++) {
+        saved += (long)numRawBytes[i] - (long)numCompressedBytes[i];
+    }
+    return saved;
+}
+
+std::string StreamCodecMetrics::toString() const {
+    std::string out = "codec, pages, raw bytes, compressed bytes, compress(ms), "
+                      "decompressed pages, decompress(ms)\n";
+    for (int i = 0; i <= ZstdPageCompression; i++) {
+        if ((numPages[i] == 0) && (numDecompressedPages[i] == 0)) {
+            continue;
+        }
+        out += std::string(PageCompressor::getName((PageCompressionType)i)) + ", " +
+            std::to_string(numPages[i]) + ", " + std::to_string(numRawBytes[i]) + ", " +
+            std::to_string(numCompressedBytes[i]) + ", " +
+            std::to_string(compressNanoseconds[i] / 1000000) + ", " +
+            std::to_string(numDecompressedPages[i]) + ", " +
+            std::to_string(decompressNanoseconds[i] / 1000000) + "\n";
+    }
+    out += "bytes saved: " + std::to_string(getBytesSaved()) +
+        ", sampled pages: " + std::to_string(numSampledPages) +
+        ", sampling(ms): " + std::to_string(sampleNanoseconds / 1000000) + "\n";
+    return out;
+}
+
+StreamCodecMetrics& getStreamCodecMetrics() {
+    static StreamCodecMetrics metrics;
+    return metrics;
+}
+
+StreamCodecSelector::StreamCodecSelector(std::string spec, double networkBytesPerSecond) {
+    this->spec = spec;
+    this->networkBytesPerSecond = networkBytesPerSecond;
+    if (!parseSpec(spec, isAuto, codec, level)) {
+        std::cout << "StreamCodecSelector: unknown codec " << spec << ", snappy is used"
+                  << std::endl;
+        isAuto = false;
+        codec = SnappyPageCompression;
+        level = STREAM_ZSTD_LEVEL;
+    }
+    if (!isAuto && !PageCompressor::isAvailable(codec)) {
+        std::cout << "StreamCodecSelector: " << PageCompressor::getName(codec)
+                  << " is not compiled in, snappy is used" << std::endl;
+        codec = SnappyPageCompression;
+    }
+    if (isAuto) {
+        for (int i = 0; i <= ZstdPageCompression; i++) {
+            if (PageCompressor::isAvailable((PageCompressionType)i)) {
+                candidates.push_back((PageCompressionType)i);
+            }
+        }
+        costs.assign(candidates.size(), 0);
+    }
+}
+
+bool StreamCodecSelector::parseSpec(std::string spec,
+                                    bool& isAuto,
+                                    PageCompressionType& codec,
+                                    int& level) {
+    isAuto = false;
+    codec = SnappyPageCompression;
+    level = STREAM_ZSTD_LEVEL;
+    if (spec == "auto") {
+        isAuto = true;
+    } else if (spec == "none") {
+        codec = NoPageCompression;
+    } else if (spec == "snappy") {
+        codec = SnappyPageCompression;
+    } else if (spec == "lz4") {
+        codec = LZ4PageCompression;
+    } else if (spec == "zstd") {
+        codec = ZstdPageCompression;
+    } else if (spec.compare(0, 5, "zstd:") == 0) {
+        codec = ZstdPageCompression;
+        level = atoi(spec.c_str() + 5);
+        if (level <= 0) {
+            return false;
+        }
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool StreamCodecSelector::isChosen() {
+    return (!isAuto) || (numSampled >= CODEC_SAMPLE_PAGES);
+}
+
+PageCompressionType StreamCodecSelector::getCodec() {
+    return codec;
+}
+
+std::string StreamCodecSelector::getSpec() {
+    return spec;
+}
+
+size_t StreamCodecSelector::getMaxCompressedLength(size_t size) {
+    if (isChosen()) {
+        return PageCompressor::getMaxCompressedLength(codec, size);
+    }
+    size_t maxLength = size;
+    for (PageCompressionType candidate : candidates) {
+        maxLength = std::max(maxLength, PageCompressor::getMaxCompressedLength(candidate, size));
+    }
+    return maxLength;
+}
+
+PageCompressionType StreamCodecSelector::compress(const char* src,
+                                                  size_t size,
+                                                  char* dest,
+                                                  size_t& compressedSize) {
+    if (!isChosen()) {
+        return sample(src, size, dest, compressedSize);
+    }
+    StreamCodecMetrics& metrics = getStreamCodecMetrics();
+    PageCompressionType myCodec = codec;
+    auto begin = std::chrono::steady_clock::now();
+    compressedSize = 0;
+    if (myCodec != NoPageCompression) {
+        compressedSize = PageCompressor::compress(myCodec, src, size, dest, level);
+    }
+    if (compressedSize == 0) {
+        // a page that can't be compressed is sent as it is
+        myCodec = NoPageCompression;
+        memcpy(dest, src, size);
+        compressedSize = size;
+    }
+    metrics.compressNanoseconds[myCodec] += nanosecondsSince(begin);
+    metrics.numPages[myCodec]++;
+    metrics.numRawBytes[myCodec] += size;
+    metrics.numCompressedBytes[myCodec] += compressedSize;
+    return myCodec;
+}
+
+PageCompressionType StreamCodecSelector::sample(const char* src,
+                                                size_t size,
+                                                char* dest,
+                                                size_t& compressedSize) {
+    // each candidate compresses to its own part of the buffer, and the cheapest one is copied
+    std::vector<size_t> offsets;
+    size_t totalLength = 0;
+    for (PageCompressionType candidate : candidates) {
+        offsets.push_back(totalLength);
+        totalLength += PageCompressor::getMaxCompressedLength(candidate, size);
+    }
+    if (sampleBuffer.size() < totalLength) {
+        sampleBuffer.resize(totalLength);
+    }
+    if (checkBuffer.size() < size) {
+        checkBuffer.resize(size);
+    }
+
+    auto sampleBegin = std::chrono::steady_clock::now();
+    int best = -1;
+    double bestCost = 0;
+    size_t bestSize = 0;
+    size_t bestNanoseconds = 0;
+    for (size_t i = 0; i < candidates.size(); i++) {
+        PageCompressionType candidate = candidates[i];
+        char* compressed = sampleBuffer.data() + offsets[i];
+        size_t length = size;
+        size_t compressNanoseconds = 0;
+        size_t decompressNanoseconds = 0;
+        if (candidate != NoPageCompression) {
+            auto begin = std::chrono::steady_clock::now();
+            length = PageCompressor::compress(candidate, src, size, compressed, level);
+            compressNanoseconds = nanosecondsSince(begin);
+            // a codec that can't compress the page, or doesn't give it back, is not used for the
+            // stream, as no cost makes up for a page that is lost
+            if (length == 0) {
+                costs[i] = std::numeric_limits<double>::infinity();
+                continue;
+            }
+            // the receiver pays for the decompression
+            begin = std::chrono::steady_clock::now();
+            size_t decompressed = PageCompressor::decompress(
+                candidate, compressed, length, checkBuffer.data(), size);
+            decompressNanoseconds = nanosecondsSince(begin);
+            if (decompressed != size) {
+                costs[i] = std::numeric_limits<double>::infinity();
+                continue;
+            }
+        }
+        double cost = (double)(compressNanoseconds + decompressNanoseconds) / 1000000000.0 +
+            (double)length / networkBytesPerSecond;
+        costs[i] += cost;
+        if ((best < 0) || (cost < bestCost)) {
+            best = i;
+            bestCost = cost;
+            bestSize = length;
+            bestNanoseconds = compressNanoseconds;
+        }
+    }
+
+    PageCompressionType bestCodec = candidates[best];
+    if (bestCodec == NoPageCompression) {
+        memcpy(dest, src, size);
+    } else {
+        memcpy(dest, sampleBuffer.data() + offsets[best], bestSize);
+    }
+    compressedSize = bestSize;
+
+    StreamCodecMetrics& metrics = getStreamCodecMetrics();
+    metrics.numSampledPages++;
+    metrics.sampleNanoseconds += nanosecondsSince(sampleBegin);
+    metrics.compressNanoseconds[bestCodec] += bestNanoseconds;
+    metrics.numPages[bestCodec]++;
+    metrics.numRawBytes[bestCodec] += size;
+    metrics.numCompressedBytes[bestCodec] += bestSize;
+
+    // the codec that costs the least for all sampled pages is used for the rest of the stream
+    numSampled++;
+    size_t cheapest = 0;
+    for (size_t i = 1; i < candidates.size(); i++) {
+        if (costs[i] < costs[cheapest]) {
+            cheapest = i;
+        }
+    }
+    codec = candidates[cheapest];
+    if (isChosen()) {
+        std::cout << "StreamCodecSelector: chose " << PageCompressor::getName(codec) << " after "
+                  << numSampled << " pages" << std::endl;
+    }
+    return bestCodec;
+}
+
+size_t StreamCodecSelector::getUncompressedLength(PageCompressionType codec,
+                                                  const char* src,
+                                                  size_t srcLength,
+                                                  size_t uncompressedSize) {
+    if (codec == NoPageCompression) {
+        return srcLength;
+    }
+    if (uncompressedSize > 0) {
+        return uncompressedSize;
+    }
+    size_t length = 0;
+    if ((codec == SnappyPageCompression) && snappy::GetUncompressedLength(src, srcLength, &length)) {
+        return length;
+    }
+    return (size_t)(-1);
+}
+
+size_t StreamCodecSelector::decompress(PageCompressionType codec,
+                                       const char* src,
+                                       size_t srcLength,
+                                       char* dest,
+                                       size_t destLength) {
+    auto begin = std::chrono::steady_clock::now();
+    size_t length;
+    if (codec == NoPageCompression) {
+        if (srcLength > destLength) {
+            return (size_t)(-1);
+        }
+        memcpy(dest, src, srcLength);
+        length = srcLength;
+    } else {
+        length = PageCompressor::decompress(codec, src, srcLength, dest, destLength);
+    }
+    StreamCodecMetrics& metrics = getStreamCodecMetrics();
+    metrics.decompressNanoseconds[codec] += nanosecondsSince(begin);
+    metrics.numDecompressedPages[codec]++;
+    return length;
+}
+
+#endif
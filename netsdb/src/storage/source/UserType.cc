@@ -73,7 +73,7 @@ string UserType::encodePath(string typePath, SetID setId, string setName) {
 
 // add new set
 // Not thread-safe
-int UserType::addSet(string setName, SetID setId, size_t pageSize, size_t desiredSize, bool isMRU, bool isTransient, bool isSharedFFMatrixBlockSet) {
+int UserType::addSet(string setName, SetID setId, size_t pageSize, size_t desiredSize, bool isMRU, bool isTransient, bool isSharedFFMatrixBlockSet, PageCompressionType compressionType) {
     if (this->sets->find(setId) != this->sets->end()) {
         this->logger->writeLn("UserType: set exists.");
         return -1;
@@ -93,7 +93,8 @@ int UserType::addSet(string setName, SetID setId, size_t pageSize, size_t desire
                                         metaFilePath,
                                         dataFilePaths,
                                         this->logger,
-                                        pageSize);
+                                        pageSize,
+                                        compressionType);
 
     SetPtr set = nullptr;
     LocalitySetReplacementPolicy policy = LRU;
@@ -134,6 +135,9 @@ int UserType::removeSet(SetID setId) {
         this->logger->writeInt(setId);
         this->logger->writeLn("\n");
         setIter->second->getFile()->clear();
+        if (this->cache != nullptr) {
+            this->cache->invalidateSecondTier(this->dbId, this->id, setId);
+        }
         pthread_mutex_lock(&setLock);
         this->sets->erase(setIter);
         pthread_mutex_unlock(&setLock);
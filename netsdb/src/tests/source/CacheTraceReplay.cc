@@ -0,0 +1,215 @@
+#ifndef CACHE_TRACE_REPLAY_CC
+#define CACHE_TRACE_REPLAY_CC
+
+// Trace replay for the page replacement policies of PageCache.
+// It replays a trace of page accesses, as recorded by CacheStats when the cache trace file is
+// configured, against a cache of the given size with each replacement policy, and reports the hit
+// rate, the number of evictions and write-backs, the eviction cost, and the time to select a
+// victim. Without a trace file, it replays a synthetic trace that mixes an iterative job, which
+// reads the same training set in every iteration, with a long sequential scan and with writes of
+// new pages.
+// The eviction cost uses the profiled read and write costs of transient data of UnifiedCost.
+//
+// usage: cacheTraceReplay [cacheSizeInMB] [traceFile]
+
+#include "PageReplacementPolicy.h"
+#include "DataTypes.h"
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <stdlib.h>
+#include <iostream>
+
+#define REPLAY_WRITE_COST 6.30
+#define REPLAY_READ_COST 4.26
+
+typedef struct {
+    CacheKey key;
+    size_t pageSize;
+    bool isNewPage;
+} TraceEntry;
+
+typedef struct {
+    long numHits;
+    long numMisses;
+    long numNewPages;
+    long numEvictions;
+    long numWriteBacks;
+    double selectionSeconds;
+} ReplayResult;
+
+CacheKey makeKey(SetID setId, PageID pageId) {
+    CacheKey key;
+    key.dbId = 1;
+    key.typeId = 1;
+    key.setId = setId;
+    key.pageId = pageId;
+    return key;
+}
+
+bool readTrace(std::string path, std::vector<TraceEntry>& trace) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        char op;
+        TraceEntry entry;
+        if (fields >> op >> entry.key.dbId >> entry.key.typeId >> entry.key.setId >>
+            entry.key.pageId >> entry.pageSize) {
+            entry.isNewPage = (op == 'N');
+            trace.push_back(entry);
+        }
+    }
+    return true;
+}
+
+// each round runs one iteration of the job, which reads its training set twice (to compute the
+// gradient and then the loss), scans the next part of a large set, and writes a few new pages
+void makeSyntheticTrace(size_t numCachePages, size_t pageSize, std::vector<TraceEntry>& trace) {
+    size_t numTrainingPages = numCachePages / 2;
+    size_t numScanPages = numCachePages * 4;
+    size_t numScanPagesPerRound = numCachePages;
+    size_t numNewPagesPerRound = numCachePages / 32 + 1;
+    size_t nextScanPage = 0;
+    PageID nextNewPage = 0;
+    TraceEntry entry;
+    entry.pageSize = pageSize;
+    for (int round = 0; round < 40; round++) {
+        entry.isNewPage = false;
+        for (int pass = 0; pass < 2; pass++) {
+            for (size_t i = 0; i < numTrainingPages; i++) {
+                entry.key = makeKey(1, i);
+                trace.push_back(entry);
+            }
+        }
+        for (size_t i = 0; i < numScanPagesPerRound; i++) {
+            entry.key = makeKey(2, nextScanPage);
+            trace.push_back(entry);
+            nextScanPage = (nextScanPage + 1) % numScanPages;
+        }
+        entry.isNewPage = true;
+        for (size_t i = 0; i < numNewPagesPerRound; i++) {
+            entry.key = makeKey(3, nextNewPage++);
+            trace.push_back(entry);
+        }
+    }
+}
+
+ReplayResult replay(PageReplacementPolicyPtr policy,
+                    std::vector<TraceEntry>& trace,
+                    size_t cacheSize) {
+    ReplayResult result = {0, 0, 0, 0, 0, 0};
+    // the size and the dirtiness of each cached page
+    std::unordered_map<CacheKey, std::pair<size_t, bool>, CacheKeyHash, CacheKeyEqual> pages;
+    size_t usedSize = 0;
+    auto isEvictable = [](const CacheKey& key) -> bool { return true; };
+    for (auto& entry : trace) {
+        auto iter = pages.find(entry.key);
+        if (iter != pages.end()) {
+            result.numHits++;
+            if (entry.isNewPage == true) {
+                iter->second.second = true;
+            }
+            policy->pageAccessed(entry.key);
+            continue;
+        }
+        if (entry.isNewPage == true) {
+            result.numNewPages++;
+        } else {
+            result.numMisses++;
+        }
+        while ((usedSize + entry.pageSize > cacheSize) && (pages.size() > 0)) {
+            CacheKey victim;
+            auto begin = std::chrono::high_resolution_clock::now();
+            bool found = policy->selectVictim(isEvictable, victim);
+            auto end = std::chrono::high_resolution_clock::now();
+            result.selectionSeconds +=
+                std::chrono::duration_cast<std::chrono::duration<double>>(end - begin).count();
+            if (found == false) {
+                break;
+            }
+            auto victimIter = pages.find(victim);
+            if (victimIter == pages.end()) {
+                std::cout << "policy selected a page that is not cached" << std::endl;
+                break;
+            }
+            result.numEvictions++;
+            if (victimIter->second.second == true) {
+                result.numWriteBacks++;
+            }
+            usedSize -= victimIter->second.first;
+            pages.erase(victimIter);
+            policy->pageRemoved(victim);
+        }
+        pages[entry.key] = std::make_pair(entry.pageSize, entry.isNewPage);
+        usedSize += entry.pageSize;
+        policy->pageCached(entry.key);
+    }
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+
+    size_t cacheSize = (size_t)(256) * (size_t)(1024) * (size_t)(1024);
+    size_t pageSize = (size_t)(1024) * (size_t)(1024);
+    if (argc > 1) {
+        cacheSize = (size_t)atoi(argv[1]) * (size_t)(1024) * (size_t)(1024);
+    }
+    std::vector<TraceEntry> trace;
+    if (argc > 2) {
+        if (readTrace(argv[2], trace) == false) {
+            std::cout << "can't read trace " << argv[2] << ", exit..." << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        std::cout << "trace=" << argv[2];
+    } else {
+        makeSyntheticTrace(cacheSize / pageSize, pageSize, trace);
+        std::cout << "trace=synthetic";
+    }
+    if (trace.size() == 0) {
+        std::cout << std::endl << "empty trace, exit..." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    size_t totalPageSize = 0;
+    for (auto& entry : trace) {
+        totalPageSize += entry.pageSize;
+    }
+    size_t numCachePages = cacheSize / (totalPageSize / trace.size());
+    std::cout << ", accesses=" << trace.size() << ", cacheSize=" << cacheSize
+              << ", cachePages=" << numCachePages << std::endl;
+
+    int numErrors = 0;
+    LocalitySetReplacementPolicy types[] = {LRU, MRU, ARC, ClockPro, LRUK};
+    for (auto type : types) {
+        PageReplacementPolicyPtr policy = PageReplacementPolicy::create(type, numCachePages);
+        ReplayResult result = replay(policy, trace, cacheSize);
+        if (result.numHits + result.numMisses + result.numNewPages != (long)trace.size()) {
+            std::cout << policy->getName() << " lost accesses" << std::endl;
+            numErrors++;
+        }
+        double hitRate = (double)result.numHits / (double)(result.numHits + result.numMisses);
+        double cost = result.numWriteBacks * REPLAY_WRITE_COST + result.numMisses * REPLAY_READ_COST;
+        double nanosPerEviction = (result.numEvictions == 0)
+            ? 0
+            : result.selectionSeconds * 1e9 / (double)result.numEvictions;
+        std::cout << policy->getName() << ": hitRate=" << hitRate << ", misses=" << result.numMisses
+                  << ", evictions=" << result.numEvictions
+                  << ", writeBacks=" << result.numWriteBacks << ", evictionCost=" << cost
+                  << ", nsPerVictim=" << nanosPerEviction << std::endl;
+    }
+    if (numErrors > 0) {
+        std::cout << "FAILED with " << numErrors << " errors" << std::endl;
+        return 1;
+    }
+    std::cout << "SUCCESS" << std::endl;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef COMPARISON_KERNELS_TEST_CC
+#define COMPARISON_KERNELS_TEST_CC
+
+// Test and benchmark for the comparison kernels of EqualsLambda.
+// It builds two columns of pointers into shuffled arrays of ints, longs and doubles, as attribute
+// accesses build them, and selects the rows where the values are equal with every instruction set
+// that this CPU supports, for all of the rows and for a selection vector of every other row. It
+// checks the selected rows against a plain loop, and reports the time per batch of each
+// instruction set and of the loop that EqualsLambda ran before, which writes a std::vector<bool>.
+//
+// usage: comparisonKernelsTest [numRowsPerBatch] [numBatches]
+
+#include "ComparisonKernels.h"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <string>
+#include <stdlib.h>
+#include <iostream>
+
+using namespace pdb;
+
+int numErrors = 0;
+
+// runs the kernels on one type; one row in four is equal
+template <typename T>
+void testType(std::string typeName, uint32_t numRows, int numBatches) {
+
+    std::mt19937 random(1);
+    std::vector<T> leftValues(numRows);
+    std::vector<T> rightValues(numRows);
+    for (uint32_t i = 0; i < numRows; i++) {
+        leftValues[i] = (T)(random() % 4);
+        rightValues[i] = (T)(random() % 4);
+    }
+
+    // the objects are not in the order of the rows
+    std::vector<uint32_t> order(numRows);
+    for (uint32_t i = 0; i < numRows; i++) {
+        order[i] = i;
+    }
+    std::shuffle(order.begin(), order.end(), random);
+    std::vector<T*> left(numRows);
+    std::vector<T*> right(numRows);
+    for (uint32_t i = 0; i < numRows; i++) {
+        left[i] = &leftValues[order[i]];
+        right[i] = &rightValues[order[i]];
+    }
+
+    // the rows selected by a previous filter
+    std::vector<uint32_t> rows;
+    for (uint32_t i = 0; i < numRows; i += 2) {
+        rows.push_back(i);
+    }
+
+    std::vector<uint32_t> expected;
+    std::vector<uint32_t> expectedForRows;
+    for (uint32_t i = 0; i < numRows; i++) {
+        if (*left[i] == *right[i]) {
+            expected.push_back(i);
+            if (i % 2 == 0) {
+                expectedForRows.push_back(i);
+            }
+        }
+    }
+
+    // the loop that EqualsLambda ran before the kernels
+    std::vector<bool> outColumn(numRows);
+    auto begin = std::chrono::high_resolution_clock::now();
+    for (int batch = 0; batch < numBatches; batch++) {
+        for (uint32_t i = 0; i < numRows; i++) {
+            outColumn[i] = (*left[i] == *right[i]);
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double seconds = std::chrono::duration_cast<std::chrono::duration<double>>(end - begin).count();
+    std::cout << typeName << ", std::vector<bool> loop: " << seconds * 1e6 / numBatches
+              << " us per batch" << std::endl;
+
+    std::vector<uint32_t> out(numRows);
+    SimdLevel detected = detectSimdLevel();
+    for (int level = SimdScalar; level <= detected; level++) {
+        setSimdLevel((SimdLevel)level);
+        size_t numSelected = 0;
+        begin = std::chrono::high_resolution_clock::now();
+        for (int batch = 0; batch < numBatches; batch++) {
+            numSelected = selectEqual(left.data(), right.data(), numRows, out.data());
+        }
+        end = std::chrono::high_resolution_clock::now();
+        seconds = std::chrono::duration_cast<std::chrono::duration<double>>(end - begin).count();
+        std::cout << typeName << ", " << getSimdLevelName((SimdLevel)level) << ": "
+                  << seconds * 1e6 / numBatches << " us per batch" << std::endl;
+        if (std::vector<uint32_t>(out.begin(), out.begin() + numSelected) != expected) {
+            std::cout << typeName << ", " << getSimdLevelName((SimdLevel)level)
+                      << " selected the wrong rows" << std::endl;
+            numErrors++;
+        }
+
+        numSelected =
+            selectEqual(left.data(), right.data(), rows.data(), (uint32_t)rows.size(), out.data());
+        if (std::vector<uint32_t>(out.begin(), out.begin() + numSelected) != expectedForRows) {
+            std::cout << typeName << ", " << getSimdLevelName((SimdLevel)level)
+                      << " selected the wrong rows from a selection vector" << std::endl;
+            numErrors++;
+        }
+    }
+    setSimdLevel(detected);
+}
+
+int main(int argc, char* argv[]) {
+
+    uint32_t numRows = 1024;
+    int numBatches = 10000;
+    if (argc > 1) {
+        numRows = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        numBatches = atoi(argv[2]);
+    }
+    std::cout << "numRowsPerBatch=" << numRows << ", numBatches=" << numBatches
+              << ", detected instruction set: " << getSimdLevelName(detectSimdLevel())
+              << std::endl;
+
+    testType<int>("int", numRows, numBatches);
+    testType<long>("long", numRows, numBatches);
+    testType<double>("double", numRows, numBatches);
+
+    if (numErrors > 0) {
+        std::cout << "FAILED with " << numErrors << " errors" << std::endl;
+        return 1;
+    }
+    std::cout << "SUCCESS" << std::endl;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,273 @@
+#ifndef CONNECTION_POOL_TEST_CC
+#define CONNECTION_POOL_TEST_CC
+
+// Test for the connection pool of simple requests.
+// It starts a small server in this process, which handles the requests of each connection one
+// after another with a worker, as a PDBServer does, and replies to a list of numbers with their sum. The test sends many
+// requests from several workers with simpleRequest, and checks that the responses are right, that
+// the connections are reused, that no more idle connections are kept than allowed, and that a
+// connection that the server has closed is not reused. It also checks the latency histogram.
+//
+// usage: connectionPoolTest [numThreads] [numRequestsPerThread]
+
+#include "PDBCommunicator.h"
+#include "PDBConnectionPool.h"
+#include "PDBLogger.h"
+#include "GenericWork.h"
+#include "PDBWorkerQueue.h"
+#include "SimpleRequest.h"
+#include "SimpleRequestResult.h"
+#include "TypeName.h"
+#include "InterfaceFunctions.h"
+#include "UseTemporaryAllocationBlock.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <atomic>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace pdb;
+
+// the workers of the server and of the clients; the objects are made with the allocator of a
+// worker, as each worker has its own
+PDBWorkerQueuePtr workers;
+
+// the number of connections that the server has accepted, and of those that it still serves
+std::atomic<int> numAccepted(0);
+std::atomic<int> numServing(0);
+
+// handles the requests of one connection until the client closes it; a request is a list of
+// numbers, and a request whose first number is -1 makes the server close the connection after the
+// response
+void serveConnection(PDBCommunicatorPtr connection) {
+    const UseTemporaryAllocationBlock block(1024 * 1024);
+    while (true) {
+        size_t objectSize = connection->getSizeOfNextObject();
+        if (objectSize == 0) {
+            break;
+        }
+        bool success;
+        std::string errMsg;
+        Handle<SimpleRequestResult> request =
+            connection->getNextObject<SimpleRequestResult>(success, errMsg);
+        if (!success) {
+            break;
+        }
+        std::istringstream numbers(request->getRes().second);
+        int sum = 0;
+        int number;
+        bool closeAfter = false;
+        bool first = true;
+        while (numbers >> number) {
+            closeAfter = closeAfter || (first && number == -1);
+            first = false;
+            sum += number;
+        }
+        Handle<SimpleRequestResult> response =
+            makeObject<SimpleRequestResult>(true, std::to_string(sum));
+        if (!connection->sendObject(response, errMsg) || closeAfter) {
+            break;
+        }
+    }
+    close(connection->getSocketFD());
+    numServing--;
+}
+
+// accepts connections and serves each of them with its own worker
+void serve(int listenFD) {
+    PDBLoggerPtr logger = std::make_shared<PDBLogger>("connectionPoolTestServer.log");
+    PDBBuzzerPtr noBuzzer = std::make_shared<PDBBuzzer>(nullptr);
+    while (true) {
+        PDBCommunicatorPtr connection = std::make_shared<PDBCommunicator>();
+        std::string errMsg;
+        if (connection->pointToInternet(logger, listenFD, errMsg)) {
+            break;
+        }
+        numAccepted++;
+        numServing++;
+        PDBWorkPtr work = std::make_shared<GenericWork>(
+            [connection](PDBBuzzerPtr callerBuzzer) { serveConnection(connection); });
+        workers->getWorker()->execute(work, noBuzzer);
+    }
+}
+
+// sends a request with the given numbers, and returns the sum that the server replies, or -1
+int sendRequest(PDBLoggerPtr logger, int port, std::vector<int> numbers) {
+    std::string request;
+    for (int number : numbers) {
+        request += std::to_string(number) + " ";
+    }
+    return simpleRequest<SimpleRequestResult, SimpleRequestResult, int>(
+        logger,
+        port,
+        "localhost",
+        -1,
+        1024 * 1024,
+        [&](Handle<SimpleRequestResult> result) {
+            if (result == nullptr || !result->getRes().first) {
+                return -1;
+            }
+            return atoi(result->getRes().second.c_str());
+        },
+        true,
+        request);
+}
+
+int main(int argc, char* argv[]) {
+
+    int numThreads = 4;
+    int numRequestsPerThread = 200;
+    if (argc > 1) {
+        numThreads = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        numRequestsPerThread = atoi(argv[2]);
+    }
+    std::cout << "numThreads=" << numThreads
+              << ", numRequestsPerThread=" << numRequestsPerThread << std::endl;
+
+    makeObjectAllocatorBlock((size_t)64 * 1024 * 1024, true);
+    int numErrors = 0;
+
+    // start the server on a free port
+    int listenFD = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in serverAddress;
+    bzero((char*)&serverAddress, sizeof(serverAddress));
+    serverAddress.sin_family = AF_INET;
+    serverAddress.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    serverAddress.sin_port = 0;
+    socklen_t addressLength = sizeof(serverAddress);
+    if (bind(listenFD, (struct sockaddr*)&serverAddress, sizeof(serverAddress)) < 0 ||
+        listen(listenFD, 100) < 0 ||
+        getsockname(listenFD, (struct sockaddr*)&serverAddress, &addressLength) < 0) {
+        std::cout << "FAILED to start the server" << std::endl;
+        return 1;
+    }
+    int port = ntohs(serverAddress.sin_port);
+
+    PDBLoggerPtr logger = std::make_shared<PDBLogger>("connectionPoolTest.log");
+    PDBConnectionPool& pool = getConnectionPool();
+    // a worker for each client, and for each connection that the server may serve at a time
+    workers = std::make_shared<PDBWorkerQueue>(logger, numThreads * 3 + 8);
+    atomic_int serverCounter;
+    serverCounter = 0;
+    PDBBuzzerPtr serverBuzzer = std::make_shared<PDBBuzzer>(
+        [&](PDBAlarm myAlarm, atomic_int& counter) { counter++; });
+    workers->getWorker()->execute(
+        std::make_shared<GenericWork>([&](PDBBuzzerPtr callerBuzzer) {
+            serve(listenFD);
+            callerBuzzer->buzz(PDBAlarm::WorkAllDone, serverCounter);
+        }),
+        serverBuzzer);
+
+    // send requests from several workers at the same time
+    std::atomic<int> numWrongResponses(0);
+    atomic_int counter;
+    counter = 0;
+    PDBBuzzerPtr clientBuzzer = std::make_shared<PDBBuzzer>(
+        [&](PDBAlarm myAlarm, atomic_int& counter) { counter++; });
+    for (int t = 0; t < numThreads; t++) {
+        PDBWorkPtr work = std::make_shared<GenericWork>([&, t](PDBBuzzerPtr callerBuzzer) {
+            for (int r = 0; r < numRequestsPerThread; r++) {
+                std::vector<int> numbers = {t, r, 1};
+                int sum = sendRequest(logger, port, numbers);
+                if (sum != t + r + 1) {
+                    numWrongResponses++;
+                }
+            }
+            callerBuzzer->buzz(PDBAlarm::WorkAllDone, counter);
+        });
+        workers->getWorker()->execute(work, clientBuzzer);
+    }
+    while (counter < numThreads) {
+        clientBuzzer->wait();
+    }
+    int numRequests = numThreads * numRequestsPerThread;
+    std::cout << "wrong responses: " << numWrongResponses << " of " << numRequests << std::endl;
+    std::cout << "connections created: " << pool.getNumConnectionsCreated()
+              << ", reused: " << pool.getNumConnectionsReused()
+              << ", accepted by the server: " << numAccepted << std::endl;
+    if (numWrongResponses > 0) {
+        numErrors++;
+    }
+    // every request either connects or reuses a connection; when the pool may keep a connection
+    // for each thread, at most one connection per thread is created
+    if ((pool.getNumConnectionsCreated() + pool.getNumConnectionsReused() != (size_t)numRequests) ||
+        ((numThreads <= MAX_IDLE_CONNECTIONS_PER_SERVER) &&
+         (pool.getNumConnectionsCreated() > (size_t)numThreads))) {
+        numErrors++;
+    }
+    if (pool.getNumIdleConnections() > MAX_IDLE_CONNECTIONS_PER_SERVER) {
+        std::cout << pool.getNumIdleConnections() << " idle connections are kept" << std::endl;
+        numErrors++;
+    }
+
+    // the server closes the connection after this request; the next request must find out that
+    // the idle connection is closed and connect again, instead of failing
+    pool.closeIdleConnections();
+    size_t numCreated = pool.getNumConnectionsCreated();
+    if (sendRequest(logger, port, {-1, 5}) != 4) {
+        std::cout << "the request that closes the connection failed" << std::endl;
+        numErrors++;
+    }
+    usleep(100000);
+    if (sendRequest(logger, port, {2, 3}) != 5) {
+        std::cout << "the request after the server closed the connection failed" << std::endl;
+        numErrors++;
+    }
+    if (pool.getNumConnectionsCreated() != numCreated + 2) {
+        std::cout << "a closed connection is reused" << std::endl;
+        numErrors++;
+    }
+
+    // the latencies of all requests are in the histogram of their message type
+    RequestLatencyHistogram histogram = pool.getLatencies(getTypeName<SimpleRequestResult>());
+    std::cout << pool.printLatencies();
+    if ((histogram.numRequests != (size_t)numRequests + 2) || (histogram.numFailures != 0)) {
+        numErrors++;
+    }
+    size_t numInBuckets = 0;
+    for (int i = 0; i < NUM_LATENCY_BUCKETS; i++) {
+        numInBuckets += histogram.buckets[i];
+    }
+    if ((numInBuckets != histogram.numRequests) ||
+        (histogram.getPercentile(0.5) > histogram.getPercentile(0.99)) ||
+        (histogram.getPercentile(1.0) != histogram.maxMicroseconds)) {
+        numErrors++;
+    }
+
+    // a failed request is counted as a failure
+    PDBConnectionPool failing;
+    failing.recordLatency("test", 3, false);
+    failing.recordLatency("test", 1000, true);
+    if ((failing.getLatencies("test").numFailures != 1) ||
+        (failing.getLatencies("test").getPercentile(0.5) != 4)) {
+        numErrors++;
+    }
+
+    // the server finishes before the workers are destroyed
+    pool.closeIdleConnections();
+    shutdown(listenFD, SHUT_RDWR);
+    while (serverCounter < 1) {
+        serverBuzzer->wait();
+    }
+    close(listenFD);
+    while (numServing > 0) {
+        usleep(1000);
+    }
+
+    if (numErrors > 0) {
+        std::cout << "FAILED with " << numErrors << " errors" << std::endl;
+        return 1;
+    }
+    std::cout << "SUCCESS" << std::endl;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,272 @@
+#ifndef CONNECTION_REACTOR_TEST_CC
+#define CONNECTION_REACTOR_TEST_CC
+
+// Test for the reactor that watches the connections of a server between their requests.
+// It starts a small server in this process, which accepts connections and gives them to a
+// PDBConnectionReactor, and handles each complete request with one of a few workers, as a
+// PDBServer does. The test opens many more connections than there are workers, and sends requests
+// on all of them round after round, so that the test would hang if a worker waited on each
+// connection. Some requests are followed by bytes that the handler reads itself, as the handlers
+// of loops do, and some are written in two pieces with a pause, so that the reactor gets them in
+// parts. It checks the responses, and that the connections are dropped when the clients close
+// them.
+//
+// usage: connectionReactorTest [numConnections] [numRounds]
+
+#include "PDBCommunicator.h"
+#include "PDBConnectionReactor.h"
+#include "PDBLogger.h"
+#include "GenericWork.h"
+#include "PDBWorkerQueue.h"
+#include "SimpleRequestResult.h"
+#include "InterfaceFunctions.h"
+#include "UseTemporaryAllocationBlock.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace pdb;
+
+// the number of workers that handle requests; the connections are many more
+#define NUM_HANDLING_WORKERS 4
+
+// the workers of the server; the objects are made with the allocator of a worker, as each worker
+// has its own
+PDBWorkerQueuePtr workers;
+
+PDBConnectionReactorPtr reactor;
+
+// handles the request of a connection: a request "bytes" is followed by bytes, and the response
+// tells their number and their sum, and any other request is echoed back
+void handleRequest(PDBCommunicatorPtr connection) {
+    const UseTemporaryAllocationBlock block(1024 * 1024);
+    std::vector<char> requestBytes(connection->getSizeOfNextObject());
+    bool success;
+    std::string errMsg;
+    Handle<SimpleRequestResult> request =
+        connection->getNextObject<SimpleRequestResult>(requestBytes.data(), success, errMsg);
+    if (!success) {
+        reactor->removeConnection(connection);
+        return;
+    }
+    std::string text = request->getRes().second;
+    if (text == "bytes") {
+        std::vector<char> bytes(connection->getSizeOfNextObject());
+        if (!connection->receiveBytes(bytes.data(), errMsg)) {
+            reactor->removeConnection(connection);
+            return;
+        }
+        size_t sum = 0;
+        for (char c : bytes) {
+            sum += (unsigned char)c;
+        }
+        text = std::to_string(bytes.size()) + ":" + std::to_string(sum);
+    }
+    Handle<SimpleRequestResult> response = makeObject<SimpleRequestResult>(true, text);
+    if (!connection->sendObject(response, errMsg)) {
+        reactor->removeConnection(connection);
+        return;
+    }
+    reactor->resumeConnection(connection);
+}
+
+// accepts connections and gives them to the reactor
+void serve(int listenFD, PDBLoggerPtr logger) {
+    while (true) {
+        PDBCommunicatorPtr connection = std::make_shared<PDBCommunicator>();
+        std::string errMsg;
+        if (connection->pointToInternet(logger, listenFD, errMsg)) {
+            break;
+        }
+        reactor->addConnection(connection);
+    }
+}
+
+// writes a request in two pieces, with a pause between them
+bool sendInPieces(PDBCommunicatorPtr connection, Handle<SimpleRequestResult> request) {
+    int16_t typeID = getTypeID<SimpleRequestResult>();
+    Record<SimpleRequestResult>* record = getRecord(request);
+    size_t half = record->numBytes() / 2;
+    int fd = connection->getSocketFD();
+    if (write(fd, &typeID, sizeof(int16_t)) != sizeof(int16_t) ||
+        write(fd, (char*)record, half) != (ssize_t)half) {
+        return false;
+    }
+    usleep(2000);
+    size_t rest = record->numBytes() - half;
+    return write(fd, (char*)record + half, rest) == (ssize_t)rest;
+}
+
+// the bytes that follow the i-th "bytes" request
+std::vector<char> makeBytes(int i, size_t& sum) {
+    std::vector<char> bytes(100 + (i * 7919) % 100000);
+    sum = 0;
+    for (size_t j = 0; j < bytes.size(); j++) {
+        bytes[j] = (char)((i + j) % 251);
+        sum += (unsigned char)bytes[j];
+    }
+    return bytes;
+}
+
+int main(int argc, char* argv[]) {
+
+    int numConnections = 64;
+    int numRounds = 10;
+    if (argc > 1) {
+        numConnections = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        numRounds = atoi(argv[2]);
+    }
+    std::cout << "numConnections=" << numConnections << ", numRounds=" << numRounds
+              << ", numWorkers=" << NUM_HANDLING_WORKERS << std::endl;
+
+    makeObjectAllocatorBlock((size_t)64 * 1024 * 1024, true);
+    signal(SIGPIPE, SIG_IGN);
+    int numErrors = 0;
+
+    // start the server on a free port
+    int listenFD = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in serverAddress;
+    bzero((char*)&serverAddress, sizeof(serverAddress));
+    serverAddress.sin_family = AF_INET;
+    serverAddress.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    serverAddress.sin_port = 0;
+    socklen_t addressLength = sizeof(serverAddress);
+    if (bind(listenFD, (struct sockaddr*)&serverAddress, sizeof(serverAddress)) < 0 ||
+        listen(listenFD, 1000) < 0 ||
+        getsockname(listenFD, (struct sockaddr*)&serverAddress, &addressLength) < 0) {
+        std::cout << "FAILED to start the server" << std::endl;
+        return 1;
+    }
+    int port = ntohs(serverAddress.sin_port);
+
+    PDBLoggerPtr logger = std::make_shared<PDBLogger>("connectionReactorTest.log");
+    // one worker accepts the connections, and the others handle the requests
+    workers = std::make_shared<PDBWorkerQueue>(logger, NUM_HANDLING_WORKERS + 1);
+    reactor = std::make_shared<PDBConnectionReactor>(logger, [](PDBCommunicatorPtr connection) {
+        PDBWorkPtr work = std::make_shared<GenericWork>(
+            [connection](PDBBuzzerPtr callerBuzzer) { handleRequest(connection); });
+        workers->getWorker()->execute(work, std::make_shared<PDBBuzzer>(nullptr));
+    });
+    std::string errMsg;
+    if (!reactor->start(errMsg)) {
+        std::cout << "FAILED to start the reactor: " << errMsg << std::endl;
+        return 1;
+    }
+    atomic_int serverCounter;
+    serverCounter = 0;
+    PDBBuzzerPtr serverBuzzer = std::make_shared<PDBBuzzer>(
+        [&](PDBAlarm myAlarm, atomic_int& counter) { counter++; });
+    workers->getWorker()->execute(
+        std::make_shared<GenericWork>([&](PDBBuzzerPtr callerBuzzer) {
+            serve(listenFD, logger);
+            callerBuzzer->buzz(PDBAlarm::WorkAllDone, serverCounter);
+        }),
+        serverBuzzer);
+
+    // all connections stay open for the whole test
+    std::vector<PDBCommunicatorPtr> connections;
+    for (int i = 0; i < numConnections; i++) {
+        PDBCommunicatorPtr connection = std::make_shared<PDBCommunicator>();
+        if (connection->connectToInternetServer(logger, port, "localhost", errMsg)) {
+            std::cout << "FAILED to connect: " << errMsg << std::endl;
+            return 1;
+        }
+        connections.push_back(connection);
+    }
+
+    // each round sends a request on every connection before reading any response
+    std::vector<char> responseBytes(1024 * 1024);
+    for (int round = 0; round < numRounds; round++) {
+        std::vector<std::string> expected;
+        for (int i = 0; i < numConnections; i++) {
+            const UseTemporaryAllocationBlock block(1024 * 1024);
+            int kind = (round * numConnections + i) % 3;
+            bool success;
+            if (kind == 0) {
+                std::string text = "request " + std::to_string(round) + "/" + std::to_string(i);
+                Handle<SimpleRequestResult> request = makeObject<SimpleRequestResult>(true, text);
+                success = connections[i]->sendObject(request, errMsg);
+                expected.push_back(text);
+            } else if (kind == 1) {
+                Handle<SimpleRequestResult> request =
+                    makeObject<SimpleRequestResult>(true, "bytes");
+                size_t sum;
+                std::vector<char> bytes = makeBytes(round * numConnections + i, sum);
+                success = connections[i]->sendObject(request, errMsg) &&
+                    connections[i]->sendBytes(bytes.data(), bytes.size(), errMsg);
+                expected.push_back(std::to_string(bytes.size()) + ":" + std::to_string(sum));
+            } else {
+                std::string text = "pieces " + std::to_string(round) + "/" + std::to_string(i);
+                Handle<SimpleRequestResult> request = makeObject<SimpleRequestResult>(true, text);
+                success = sendInPieces(connections[i], request);
+                expected.push_back(text);
+            }
+            if (!success) {
+                std::cout << "FAILED to send a request: " << errMsg << std::endl;
+                return 1;
+            }
+        }
+        for (int i = 0; i < numConnections; i++) {
+            bool success;
+            Handle<SimpleRequestResult> response =
+                connections[i]->getNextObject<SimpleRequestResult>(
+                    responseBytes.data(), success, errMsg);
+            if (!success) {
+                std::cout << "FAILED to get a response: " << errMsg << std::endl;
+                return 1;
+            }
+            if (response->getRes().second != expected[i]) {
+                std::cout << "got " << response->getRes().second << " instead of " << expected[i]
+                          << std::endl;
+                numErrors++;
+            }
+        }
+    }
+    if (reactor->getNumRequests() != (size_t)numConnections * numRounds) {
+        std::cout << "the reactor read " << reactor->getNumRequests() << " requests" << std::endl;
+        numErrors++;
+    }
+    if (reactor->getNumConnections() != (size_t)numConnections) {
+        std::cout << "the reactor watches " << reactor->getNumConnections() << " connections"
+                  << std::endl;
+        numErrors++;
+    }
+
+    // the connections that the clients close are dropped
+    connections.clear();
+    for (int i = 0; (i < 1000) && (reactor->getNumConnections() > 0); i++) {
+        usleep(1000);
+    }
+    if (reactor->getNumConnections() != 0) {
+        std::cout << "the reactor still watches " << reactor->getNumConnections()
+                  << " connections" << std::endl;
+        numErrors++;
+    }
+
+    // the server finishes before the workers are destroyed
+    shutdown(listenFD, SHUT_RDWR);
+    while (serverCounter < 1) {
+        serverBuzzer->wait();
+    }
+    close(listenFD);
+    reactor->stop();
+
+    if (numErrors > 0) {
+        std::cout << "FAILED with " << numErrors << " errors" << std::endl;
+        return 1;
+    }
+    std::cout << "SUCCESS" << std::endl;
+    return 0;
+}
+
+#endif
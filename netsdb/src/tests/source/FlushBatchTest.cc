@@ -0,0 +1,174 @@
+#ifndef FLUSH_BATCH_TEST_CC
+#define FLUSH_BATCH_TEST_CC
+
+// Test and benchmark for the batched flushing of dirty pages.
+// The main thread pushes pages to a PageCircularBuffer, while one consumer thread per partition
+// pops batches of pages, appends each batch to its partition of a PartitionedFile with one
+// vectored write, and writes the meta partition once per batch, as PDBFlushConsumerWork does.
+// It runs with a batch size of 1 and then the given one, reports the flush throughput, reloads
+// the file from its meta partition, and checks that every page reads back unchanged.
+// It also checks that a producer waiting for the buffer to drain below a depth is released.
+//
+// usage: flushBatchTest [numPages] [batchSize] [pageSizeInKB] [codec: 0=none, 1=snappy, ...]
+
+#include "PartitionedFile.h"
+#include "PageCircularBuffer.h"
+#include "PDBPage.h"
+#include "PDBLogger.h"
+
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <iostream>
+
+#define FLUSH_BATCH_TEST_NUM_PARTITIONS 2
+
+int main(int argc, char* argv[]) {
+
+    int numPages = 256;
+    unsigned int maxBatchSize = 8;
+    size_t pageSize = (size_t)(256) * (size_t)(1024);
+    PageCompressionType compressionType = NoPageCompression;
+    if (argc > 1) {
+        numPages = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        maxBatchSize = atoi(argv[2]);
+    }
+    if (argc > 3) {
+        pageSize = (size_t)atoi(argv[3]) * (size_t)(1024);
+    }
+    if (argc > 4) {
+        compressionType = (PageCompressionType)atoi(argv[4]);
+    }
+    std::cout << "numPages=" << numPages << ", batchSize=" << maxBatchSize
+              << ", pageSize=" << pageSize << std::endl;
+
+    pdb::PDBLoggerPtr logger = make_shared<pdb::PDBLogger>("flushBatchTest.log");
+    std::string metaPath = "/tmp/flushBatchTest.meta";
+    std::vector<std::string> dataPaths;
+    for (int i = 0; i < FLUSH_BATCH_TEST_NUM_PARTITIONS; i++) {
+        dataPaths.push_back("/tmp/flushBatchTest.data" + std::to_string(i));
+    }
+
+    // the pages to flush, each filled with its page id
+    std::vector<PDBPagePtr> pages;
+    for (int i = 0; i < numPages; i++) {
+        char* data = nullptr;
+        if (posix_memalign((void**)&data, 512, pageSize) != 0) {
+            std::cout << "can't allocate page " << i << ", exit..." << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        PDBPagePtr page = make_shared<PDBPage>(data, 0, 1, 1, 1, i, pageSize, 0, 0, 0);
+        page->preparePage();
+        for (char* cur = data + 1024; cur + sizeof(int) <= data + pageSize; cur += sizeof(int)) {
+            *((int*)cur) = i;
+        }
+        pages.push_back(page);
+    }
+
+    std::atomic<int> numErrors(0);
+    unsigned int batchSizes[2] = {1, maxBatchSize};
+    for (unsigned int batchSize : batchSizes) {
+        remove(metaPath.c_str());
+        for (auto path : dataPaths) {
+            remove(path.c_str());
+        }
+        PartitionedFilePtr file = make_shared<PartitionedFile>(
+            0, 1, 1, 1, metaPath, dataPaths, logger, pageSize, compressionType);
+        PageCircularBufferPtr buffer = make_shared<PageCircularBuffer>(4 * batchSize, logger);
+        // the partition and sequence of each page in the partition
+        std::vector<int> partitionOfPage(numPages, -1);
+        std::vector<int> seqOfPage(numPages, -1);
+        std::atomic<long> numBatches(0);
+
+        auto begin = std::chrono::high_resolution_clock::now();
+        std::vector<std::thread> consumers;
+        for (int p = 0; p < FLUSH_BATCH_TEST_NUM_PARTITIONS; p++) {
+            consumers.push_back(std::thread([&, p]() {
+                std::vector<PDBPagePtr> batch;
+                std::vector<int> seqs;
+                while (true) {
+                    batch.clear();
+                    if (buffer->popPagesFromHead(batch, batchSize) == 0) {
+                        break;
+                    }
+                    if (file->appendPages(p, batch, seqs) != (int)batch.size()) {
+                        std::cout << "can't append " << batch.size() << " pages" << std::endl;
+                        numErrors++;
+                        continue;
+                    }
+                    file->writeMeta();
+                    for (size_t i = 0; i < batch.size(); i++) {
+                        partitionOfPage[batch[i]->getPageID()] = p;
+                        seqOfPage[batch[i]->getPageID()] = seqs[i];
+                    }
+                    numBatches++;
+                }
+            }));
+        }
+        for (int i = 0; i < numPages; i++) {
+            buffer->addPageToTail(pages[i]);
+        }
+        // all pages are pushed, so the consumers drain the buffer
+        buffer->waitUntilBelow(1);
+        buffer->close();
+        for (auto& consumer : consumers) {
+            consumer.join();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        double seconds =
+            std::chrono::duration_cast<std::chrono::duration<double>>(end - begin).count();
+        std::cout << "batchSize=" << batchSize << ": " << numBatches << " writes, "
+                  << (double)numPages * pageSize / seconds / 1024 / 1024 << " MB/sec"
+                  << std::endl;
+        file = nullptr;
+
+        // reload the file from the meta partition, and read all pages back
+        file = make_shared<PartitionedFile>(0, 1, 1, 1, metaPath, logger);
+        file->buildMetaDataFromMetaPartition(nullptr);
+        file->initializeDataFiles();
+        file->openData();
+        if (file->getNumFlushedPages() != (unsigned int)numPages) {
+            std::cout << "meta partition has " << file->getNumFlushedPages() << " pages"
+                      << std::endl;
+            numErrors++;
+        }
+        char* loaded = nullptr;
+        if (posix_memalign((void**)&loaded, 512, pageSize) != 0) {
+            std::cout << "can't allocate page, exit..." << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        for (int i = 0; i < numPages; i++) {
+            memset(loaded, 0, pageSize);
+            size_t ret = (partitionOfPage[i] < 0)
+                ? (size_t)(-1)
+                : file->loadPageAt(partitionOfPage[i], seqOfPage[i], loaded, pageSize);
+            if ((ret == (size_t)(-1)) ||
+                (memcmp(loaded, pages[i]->getRawBytes(), pageSize) != 0)) {
+                std::cout << "page " << i << " is corrupted, ret=" << ret << std::endl;
+                numErrors++;
+            }
+        }
+        free(loaded);
+        file->clear();
+    }
+
+    for (auto page : pages) {
+        free(page->getRawBytes());
+        page->setRawBytes(nullptr);
+    }
+    if (numErrors > 0) {
+        std::cout << "FAILED with " << numErrors << " errors" << std::endl;
+        return 1;
+    }
+    std::cout << "SUCCESS" << std::endl;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,205 @@
+#ifndef FUSED_PREDICATE_TEST_CC
+#define FUSED_PREDICATE_TEST_CC
+
+// Test and benchmark for the fused selection predicates.
+// It builds the lambda tree of a selection predicate that compares two members, calls a method
+// and runs a native lambda, and runs it over batches of objects in two ways: as a chain of the
+// executors of the lambdas in the tree followed by a FilterExecutor, as the TCAP pipeline does
+// for each apply and filter, and as one FusedFilterExecutor that runs the predicate returned by
+// getPredicate () on each object. It checks that both select the same objects, and reports the
+// time per batch of both.
+//
+// usage: fusedPredicateTest [numRowsPerBatch] [numBatches]
+
+#include "TupleSpec.h"
+#include "Ptr.h"
+#include "ComputeInfo.h"
+#include "TupleSet.h"
+#include "Object.h"
+#include "InterfaceFunctions.h"
+#include "Lambda.h"
+#include "LambdaCreationFunctions.h"
+#include "FilterExecutor.h"
+#include "FusedFilterExecutor.h"
+
+#include <chrono>
+#include <list>
+#include <vector>
+#include <string>
+#include <stdlib.h>
+#include <iostream>
+
+using namespace pdb;
+
+class Supplier : public Object {
+
+public:
+    int nation;
+    int region;
+    double price;
+
+    ENABLE_DEEP_COPY
+
+    bool isCheap() {
+        return price < 50.0;
+    }
+};
+
+// builds a TupleSpec with the given attributes
+TupleSpec makeSpec(std::string setName, std::vector<std::string> atts) {
+    AttList attList;
+    for (auto& att : atts) {
+        attList.appendAttribute((char*)att.c_str());
+    }
+    return TupleSpec(setName, attList);
+}
+
+// adds the executors of a lambda tree to the chain, children first, as a TCAP pipeline has an
+// apply for each lambda; each executor keeps all of the columns built so far, and appends the
+// output of its lambda; returns the name of that output.  The executors keep references to their
+// TupleSpecs, so the specs are kept in a list
+std::string addExecutors(GenericLambdaObjectPtr lambda,
+                         std::vector<std::string>& atts,
+                         std::list<TupleSpec>& specs,
+                         std::vector<ComputeExecutorPtr>& chain) {
+    std::vector<std::string> inputs;
+    for (int i = 0; i < lambda->getNumChildren(); i++) {
+        inputs.push_back(addExecutors(lambda->getChild(i), atts, specs, chain));
+    }
+    if (inputs.size() == 0) {
+        inputs.push_back("in");
+    }
+    std::string setName = "set" + std::to_string(specs.size());
+    specs.push_back(makeSpec(setName, atts));
+    TupleSpec& inputSchema = specs.back();
+    specs.push_back(makeSpec(setName, inputs));
+    TupleSpec& attsToOperateOn = specs.back();
+    chain.push_back(lambda->getExecutor(inputSchema, attsToOperateOn, inputSchema));
+    atts.push_back("att" + std::to_string(atts.size()));
+    return atts.back();
+}
+
+int main(int argc, char* argv[]) {
+
+    int numRows = 1024;
+    int numBatches = 1000;
+    if (argc > 1) {
+        numRows = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        numBatches = atoi(argv[2]);
+    }
+    std::cout << "numRowsPerBatch=" << numRows << ", numBatches=" << numBatches << std::endl;
+
+    makeObjectAllocatorBlock((size_t)numRows * 256 + 1024 * 1024, true);
+
+    // nation == region && isCheap () && price > 10
+    Handle<Supplier> checkMe = nullptr;
+    LambdaTree<bool> selection =
+        (makeLambdaFromMember(checkMe, nation) == makeLambdaFromMember(checkMe, region)) &&
+        (makeLambdaFromMethod(checkMe, isCheap) &&
+         makeLambda(checkMe, [](Handle<Supplier>& checkMe) { return checkMe->price > 10.0; }));
+    GenericLambdaObjectPtr root = selection.getPtr();
+
+    // the chain of executors, with a filter on the output of the root
+    std::list<TupleSpec> specs;
+    std::vector<ComputeExecutorPtr> chain;
+    std::vector<std::string> atts = {"in"};
+    std::string rootAtt = addExecutors(root, atts, specs, chain);
+    specs.push_back(makeSpec("filtered", atts));
+    TupleSpec& filterSchema = specs.back();
+    specs.push_back(makeSpec("filtered", {rootAtt}));
+    TupleSpec& filterAtt = specs.back();
+    specs.push_back(makeSpec("filtered", {"in"}));
+    TupleSpec& filterProjection = specs.back();
+    chain.push_back(std::make_shared<FilterExecutor>(filterSchema, filterAtt, filterProjection));
+
+    // the fused executor
+    SimpleFilterPtr predicate = root->getPredicate();
+    if (predicate == nullptr) {
+        std::cout << "FAILED: the selection can not be run on one object" << std::endl;
+        return 1;
+    }
+    TupleSpec inputSchema = makeSpec("input", {"in"});
+    FusedFilterExecutor fused(inputSchema, inputSchema, inputSchema, predicate);
+
+    Handle<Vector<Handle<Supplier>>> suppliers = makeObject<Vector<Handle<Supplier>>>();
+    for (int i = 0; i < numRows; i++) {
+        Handle<Supplier> supplier = makeObject<Supplier>();
+        suppliers->push_back(supplier);
+    }
+    TupleSetPtr input = std::make_shared<TupleSet>();
+    std::vector<Handle<Supplier>>* column = new std::vector<Handle<Supplier>>(numRows);
+    for (int i = 0; i < numRows; i++) {
+        (*column)[i] = (*suppliers)[i];
+    }
+    input->addColumn(0, column, true);
+
+    int numErrors = 0;
+    double chainSeconds = 0;
+    double fusedSeconds = 0;
+    long numSelected = 0;
+    for (int batch = 0; batch < numBatches; batch++) {
+        int expected = 0;
+        for (int i = 0; i < numRows; i++) {
+            int key = batch * numRows + i;
+            Handle<Supplier>& supplier = (*column)[i];
+            supplier->nation = key % 5;
+            supplier->region = (key / 5) % 5;
+            supplier->price = key % 100;
+            if ((supplier->nation == supplier->region) && supplier->isCheap() &&
+                (supplier->price > 10.0)) {
+                expected++;
+            }
+        }
+
+        // run the chain as the pipeline does
+        auto begin = std::chrono::high_resolution_clock::now();
+        TupleSetPtr curChunk = input;
+        for (ComputeExecutorPtr& q : chain) {
+            if (!q->honorsSelection()) {
+                curChunk->compact();
+            }
+            curChunk = q->process(curChunk);
+        }
+        curChunk->compact();
+        auto end = std::chrono::high_resolution_clock::now();
+        chainSeconds +=
+            std::chrono::duration_cast<std::chrono::duration<double>>(end - begin).count();
+        std::vector<Handle<Supplier>> chainOutput = curChunk->getColumn<Handle<Supplier>>(0);
+
+        // run the fused executor
+        begin = std::chrono::high_resolution_clock::now();
+        curChunk = fused.process(input);
+        curChunk->compact();
+        end = std::chrono::high_resolution_clock::now();
+        fusedSeconds +=
+            std::chrono::duration_cast<std::chrono::duration<double>>(end - begin).count();
+        std::vector<Handle<Supplier>>& fusedOutput = curChunk->getColumn<Handle<Supplier>>(0);
+
+        bool same = (chainOutput.size() == expected) && (fusedOutput.size() == expected);
+        for (size_t i = 0; same && (i < fusedOutput.size()); i++) {
+            same = (&(*chainOutput[i]) == &(*fusedOutput[i]));
+        }
+        if (!same) {
+            std::cout << "batch " << batch << " is filtered wrong" << std::endl;
+            numErrors++;
+        }
+        numSelected += expected;
+    }
+    std::cout << "selected " << numSelected << " objects with " << chain.size() << " executors"
+              << std::endl;
+    std::cout << "chain of executors: " << chainSeconds * 1e6 / numBatches << " us per batch"
+              << std::endl;
+    std::cout << "fused executor: " << fusedSeconds * 1e6 / numBatches << " us per batch"
+              << std::endl;
+
+    if (numErrors > 0) {
+        std::cout << "FAILED with " << numErrors << " errors" << std::endl;
+        return 1;
+    }
+    std::cout << "SUCCESS" << std::endl;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,212 @@
+#ifndef JOIN_BUILD_SPILL_TEST_CC
+#define JOIN_BUILD_SPILL_TEST_CC
+
+// Test for the spilling of hash partitioned join builds.
+// It merges the JoinMaps of a shuffled build page into the hash page of a partition, as the
+// build of a hash partitioned join does, with a hash page that is too small for the build side,
+// so that the merger used to exit. The build records that don't fit are spilled to spill pages,
+// which stand for the pages of the temp set. It then probes the hash page and the spilled pages
+// with a JoinProbe, and checks that each probed key matches all of its build records exactly once,
+// and that the keys that are not built match nothing. Last, it merges the build side again with
+// spill pages that run out, and with no spill pages, and checks that the merger reports that the
+// build failed instead of exiting.
+//
+// usage: joinBuildSpillTest [numKeys] [valuesPerKey] [hashPageSizeInKB] [spillPageSizeInKB]
+
+#include "TupleSpec.h"
+#include "Ptr.h"
+#include "TupleSet.h"
+#include "TupleSetMachine.h"
+#include "ComputeExecutor.h"
+#include "ComputeSink.h"
+#include "ComputeSource.h"
+#include "JoinTuple.h"
+#include "InterfaceFunctions.h"
+#include "UseTemporaryAllocationBlock.h"
+
+#include <vector>
+#include <string>
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+
+using namespace pdb;
+
+typedef JoinTuple<int, char[0]> BuildTuple;
+
+// builds a TupleSpec with the given attributes
+TupleSpec makeSpec(std::string setName, std::vector<std::string> atts) {
+    AttList attList;
+    for (auto& att : atts) {
+        attList.appendAttribute((char*)att.c_str());
+    }
+    return TupleSpec(setName, attList);
+}
+
+int main(int argc, char* argv[]) {
+
+    int numKeys = 20000;
+    int valuesPerKey = 2;
+    size_t hashPageSize = 256 * 1024;
+    size_t spillPageSize = 256 * 1024;
+    if (argc > 1) {
+        numKeys = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        valuesPerKey = atoi(argv[2]);
+    }
+    if (argc > 3) {
+        hashPageSize = (size_t)atoi(argv[3]) * 1024;
+    }
+    if (argc > 4) {
+        spillPageSize = (size_t)atoi(argv[4]) * 1024;
+    }
+    std::cout << "numKeys=" << numKeys << ", valuesPerKey=" << valuesPerKey
+              << ", hashPageSize=" << hashPageSize << ", spillPageSize=" << spillPageSize
+              << std::endl;
+
+    makeObjectAllocatorBlock((size_t)256 * 1024 * 1024, true);
+
+    // the build side, as a shuffled page holds it: one JoinMap for each partition, and only
+    // partition 0 is built here
+    Handle<Vector<Handle<JoinMap<BuildTuple>>>> shuffled =
+        makeObject<Vector<Handle<JoinMap<BuildTuple>>>>();
+    for (int partition = 0; partition < 2; partition++) {
+        Handle<JoinMap<BuildTuple>> map = makeObject<JoinMap<BuildTuple>>();
+        map->setPartitionId(partition);
+        for (int key = 0; key < numKeys; key++) {
+            for (int j = 0; j < valuesPerKey; j++) {
+                BuildTuple& tuple = map->push(key);
+                Handle<int> value = makeObject<int>(partition == 0 ? key * 10 + j : -1);
+                tuple.copyDataFrom(value);
+            }
+        }
+        shuffled->push_back(map);
+    }
+
+    // merge it into the hash page of partition 0, and spill what doesn't fit
+    void* hashPage = calloc(hashPageSize, 1);
+    std::vector<void*> spilledPages;
+    JoinSinkMerger<BuildTuple> merger(0);
+    merger.setSpillPages(
+        [&]() -> std::pair<void*, size_t> {
+            return std::make_pair(calloc(spillPageSize, 1), spillPageSize);
+        },
+        [&](void* page) { spilledPages.push_back(page); });
+    size_t numKeysInHashPage = 0;
+    {
+        const UseTemporaryAllocationBlock tempBlock(hashPage, hashPageSize);
+        Handle<Object> myMap = merger.createNewOutputContainer();
+        merger.writeVectorOut(unsafeCast<Object>(shuffled), myMap);
+        merger.flushSpillPage();
+        getRecord(myMap);
+        numKeysInHashPage = unsafeCast<JoinMap<BuildTuple>>(myMap)->size();
+        myMap.emptyOutContainingBlock();
+    }
+    std::cout << numKeysInHashPage << " keys in the hash page, "
+              << merger.getNumSpilledPages() << " pages spilled" << std::endl;
+
+    int numErrors = 0;
+    if (merger.hasFailed() == true) {
+        std::cout << "the build fails although it can spill" << std::endl;
+        numErrors++;
+    }
+    if ((int)spilledPages.size() != merger.getNumSpilledPages()) {
+        std::cout << spilledPages.size() << " pages are written back" << std::endl;
+        numErrors++;
+    }
+    if (((size_t)numKeys * valuesPerKey * 2 > hashPageSize / sizeof(int)) &&
+        (spilledPages.size() == 0)) {
+        std::cout << "the build side doesn't fit in the hash page, but nothing is spilled"
+                  << std::endl;
+        numErrors++;
+    }
+
+    // probe the hash page and the spilled pages with the built keys and as many keys that
+    // are not built, in chunks as a pipeline does
+    TupleSpec input = makeSpec("input", {"hash"});
+    std::vector<int> positions = {0};
+    JoinProbe<BuildTuple> probe(hashPage, positions, input, input, input, false, spilledPages);
+    std::vector<int> numMatches(numKeys, 0);
+    int chunkSize = 1000;
+    for (int begin = 0; begin < numKeys * 2; begin += chunkSize) {
+        TupleSetPtr chunk = std::make_shared<TupleSet>();
+        std::vector<size_t>* hashes = new std::vector<size_t>;
+        for (int key = begin; (key < begin + chunkSize) && (key < numKeys * 2); key++) {
+            hashes->push_back(key);
+        }
+        chunk->addColumn(0, hashes, true);
+        TupleSetPtr output = probe.process(chunk);
+        std::vector<size_t>& outHashes = output->getColumn<size_t>(0);
+        std::vector<Handle<int>>& outValues = output->getColumn<Handle<int>>(1);
+        for (size_t i = 0; i < outHashes.size(); i++) {
+            int key = outHashes[i];
+            int value = *(outValues[i]);
+            if ((key >= numKeys) || (value / 10 != key) || (value % 10 >= valuesPerKey)) {
+                std::cout << "key " << key << " matches value " << value << std::endl;
+                numErrors++;
+                continue;
+            }
+            numMatches[key]++;
+        }
+    }
+    for (int key = 0; key < numKeys; key++) {
+        if (numMatches[key] != valuesPerKey) {
+            std::cout << "key " << key << " has " << numMatches[key] << " matches" << std::endl;
+            numErrors++;
+        }
+    }
+
+    // the build fails if it runs out of spill pages after one page, or can't spill at all
+    for (bool canSpill : {true, false}) {
+        int numSpillPagesLeft = 1;
+        std::vector<void*> pagesToFree;
+        JoinSinkMerger<BuildTuple> failingMerger(0);
+        if (canSpill == true) {
+            failingMerger.setSpillPages(
+                [&]() -> std::pair<void*, size_t> {
+                    if (numSpillPagesLeft == 0) {
+                        return std::make_pair(nullptr, 0);
+                    }
+                    numSpillPagesLeft--;
+                    void* page = calloc(spillPageSize, 1);
+                    pagesToFree.push_back(page);
+                    return std::make_pair(page, spillPageSize);
+                },
+                [&](void* page) {});
+        }
+        memset(hashPage, 0, hashPageSize);
+        {
+            const UseTemporaryAllocationBlock tempBlock(hashPage, hashPageSize);
+            Handle<Object> myMap = failingMerger.createNewOutputContainer();
+            failingMerger.writeVectorOut(unsafeCast<Object>(shuffled), myMap);
+            failingMerger.flushSpillPage();
+            getRecord(myMap);
+            myMap.emptyOutContainingBlock();
+        }
+        if ((spilledPages.size() > 1) && (failingMerger.hasFailed() == false)) {
+            std::cout << "the build doesn't fail "
+                      << (canSpill ? "when it runs out of spill pages"
+                                                 : "when it can't spill")
+                      << std::endl;
+            numErrors++;
+        }
+        for (void* page : pagesToFree) {
+            free(page);
+        }
+    }
+
+    free(hashPage);
+    for (void* page : spilledPages) {
+        free(page);
+    }
+
+    if (numErrors > 0) {
+        std::cout << "FAILED with " << numErrors << " errors" << std::endl;
+        return 1;
+    }
+    std::cout << "SUCCESS" << std::endl;
+    return 0;
+}
+
+#endif
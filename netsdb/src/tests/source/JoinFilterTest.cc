@@ -0,0 +1,259 @@
+#ifndef JOIN_FILTER_TEST_CC
+#define JOIN_FILTER_TEST_CC
+
+// Test for the Bloom filters over the join hashes of a join build.
+// Two nodes each merge the JoinMaps of their partition into a hash page, with a merger that adds
+// the hashes to the filter of the node, as the build of a hash partitioned join does. The filters
+// are merged and folded as the scheduler does, and the test checks that no built key is dropped
+// and that few keys that are not built pass. It then probes the hash page of the first node with
+// a JoinProbe that uses the filter of that node, and partitions keys with a PartitionedJoinSink
+// that uses the merged filter, and checks that the results are the same as without filters and
+// that the sink drops the keys that are not built.
+//
+// usage: joinFilterTest [numKeys] [filterSizeInKB]
+
+#include "TupleSpec.h"
+#include "Ptr.h"
+#include "TupleSet.h"
+#include "TupleSetMachine.h"
+#include "ComputeExecutor.h"
+#include "ComputeSink.h"
+#include "ComputeSource.h"
+#include "JoinTuple.h"
+#include "JoinBloomFilter.h"
+#include "Configuration.h"
+#include "InterfaceFunctions.h"
+#include "UseTemporaryAllocationBlock.h"
+
+#include <vector>
+#include <string>
+#include <stdlib.h>
+#include <iostream>
+
+using namespace pdb;
+
+typedef JoinTuple<int, char[0]> BuildTuple;
+
+// builds a TupleSpec with the given attributes
+TupleSpec makeSpec(std::string setName, std::vector<std::string> atts) {
+    AttList attList;
+    for (auto& att : atts) {
+        attList.appendAttribute((char*)att.c_str());
+    }
+    return TupleSpec(setName, attList);
+}
+
+// the hash of the i-th key of a node, so that the keys of the two nodes are different
+size_t getKeyHash(int node, int i) {
+    return (size_t)i * 2 + node;
+}
+
+// the hash of the i-th key that no node has
+size_t getMissingHash(int i) {
+    return (size_t)i * 2 + 1000000000;
+}
+
+int main(int argc, char* argv[]) {
+
+    int numKeys = 20000;
+    size_t filterSize = 1024 * 1024;
+    if (argc > 1) {
+        numKeys = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        filterSize = (size_t)atoi(argv[2]) * 1024;
+    }
+    std::cout << "numKeys=" << numKeys << ", filterSize=" << filterSize << std::endl;
+
+    makeObjectAllocatorBlock((size_t)256 * 1024 * 1024, true);
+    int numErrors = 0;
+
+    // build the hash pages of the two nodes, each with its own filter
+    size_t hashPageSize = (size_t)numKeys * 64 + 1024 * 1024;
+    std::vector<void*> hashPages;
+    std::vector<JoinBloomFilterPtr> nodeFilters;
+    for (int node = 0; node < 2; node++) {
+        Handle<Vector<Handle<JoinMap<BuildTuple>>>> shuffled =
+            makeObject<Vector<Handle<JoinMap<BuildTuple>>>>();
+        Handle<JoinMap<BuildTuple>> map = makeObject<JoinMap<BuildTuple>>();
+        map->setPartitionId(node);
+        for (int i = 0; i < numKeys; i++) {
+            BuildTuple& tuple = map->push(getKeyHash(node, i));
+            Handle<int> value = makeObject<int>(i);
+            tuple.copyDataFrom(value);
+        }
+        shuffled->push_back(map);
+
+        JoinBloomFilterPtr filter = std::make_shared<JoinBloomFilter>(filterSize);
+        JoinSinkMerger<BuildTuple> merger(node);
+        merger.setJoinFilter(filter);
+        void* hashPage = calloc(hashPageSize, 1);
+        {
+            const UseTemporaryAllocationBlock tempBlock(hashPage, hashPageSize);
+            Handle<Object> myMap = merger.createNewOutputContainer();
+            merger.writeVectorOut(unsafeCast<Object>(shuffled), myMap);
+            getRecord(myMap);
+            myMap.emptyOutContainingBlock();
+        }
+        if (merger.getNumHashKeys() != numKeys) {
+            std::cout << "node " << node << " built " << merger.getNumHashKeys() << " keys"
+                      << std::endl;
+            numErrors++;
+        }
+        hashPages.push_back(hashPage);
+        nodeFilters.push_back(filter);
+    }
+
+    // merge the filters of the nodes, with the second one smaller, and fold the result
+    JoinBloomFilter smallFilter(nodeFilters[1]->getWords(), nodeFilters[1]->getNumWords());
+    smallFilter.fold(smallFilter.getNumBlocks() / 2);
+    JoinBloomFilterPtr mergedFilter = std::make_shared<JoinBloomFilter>(
+        nodeFilters[0]->getWords(), nodeFilters[0]->getNumWords());
+    mergedFilter->merge(smallFilter.getWords(), smallFilter.getNumWords());
+    if (mergedFilter->getNumBits() >= (size_t)numKeys * 2 * JOIN_FILTER_MIN_BITS_PER_KEY) {
+        mergedFilter->fold(
+            JoinBloomFilter::getNumBlocksForKeys(numKeys * 2, JOIN_FILTER_BITS_PER_KEY));
+    } else {
+        std::cout << "the filter is too small for " << numKeys * 2 << " keys" << std::endl;
+    }
+    std::cout << "the merged filter has " << mergedFilter->getNumBits() << " bits" << std::endl;
+
+    // no built key may be dropped
+    for (int node = 0; node < 2; node++) {
+        for (int i = 0; i < numKeys; i++) {
+            if (nodeFilters[node]->mayContain(getKeyHash(node, i)) == false) {
+                std::cout << "node " << node << " drops key " << getKeyHash(node, i) << std::endl;
+                numErrors++;
+            }
+            if (mergedFilter->mayContain(getKeyHash(node, i)) == false) {
+                std::cout << "the merged filter drops key " << getKeyHash(node, i) << std::endl;
+                numErrors++;
+            }
+        }
+    }
+
+    // and few keys that are not built may pass
+    int numFalsePositives = 0;
+    for (int i = 0; i < numKeys * 10; i++) {
+        if (mergedFilter->mayContain(getMissingHash(i))) {
+            numFalsePositives++;
+        }
+    }
+    double falsePositiveRate = (double)numFalsePositives / (double)(numKeys * 10);
+    std::cout << "false positive rate: " << falsePositiveRate << std::endl;
+    if (falsePositiveRate > 0.01) {
+        numErrors++;
+    }
+
+    // probe the hash page of node 0 with its filter, with built keys, keys of node 1 and keys
+    // that are not built; each built key matches once and nothing else matches
+    TupleSpec probeInput = makeSpec("input", {"hash"});
+    std::vector<int> positions = {0};
+    JoinProbe<BuildTuple> probe(hashPages[0],
+                                positions,
+                                probeInput,
+                                probeInput,
+                                probeInput,
+                                false,
+                                std::vector<void*>(),
+                                nodeFilters[0]);
+    std::vector<int> numMatches(numKeys, 0);
+    int chunkSize = 1000;
+    for (int begin = 0; begin < numKeys; begin += chunkSize) {
+        TupleSetPtr chunk = std::make_shared<TupleSet>();
+        std::vector<size_t>* hashes = new std::vector<size_t>;
+        for (int i = begin; (i < begin + chunkSize) && (i < numKeys); i++) {
+            hashes->push_back(getKeyHash(0, i));
+            hashes->push_back(getKeyHash(1, i));
+            hashes->push_back(getMissingHash(i));
+        }
+        chunk->addColumn(0, hashes, true);
+        TupleSetPtr output = probe.process(chunk);
+        std::vector<size_t>& outHashes = output->getColumn<size_t>(0);
+        std::vector<Handle<int>>& outValues = output->getColumn<Handle<int>>(1);
+        for (size_t j = 0; j < outHashes.size(); j++) {
+            int value = *(outValues[j]);
+            if ((value < 0) || (value >= numKeys) || (outHashes[j] != getKeyHash(0, value))) {
+                std::cout << "hash " << outHashes[j] << " matches value " << value << std::endl;
+                numErrors++;
+                continue;
+            }
+            numMatches[value]++;
+        }
+    }
+    for (int i = 0; i < numKeys; i++) {
+        if (numMatches[i] != 1) {
+            std::cout << "key " << getKeyHash(0, i) << " has " << numMatches[i] << " matches"
+                      << std::endl;
+            numErrors++;
+        }
+    }
+
+    // partition the built keys and as many keys that are not built with the merged filter, so
+    // that only the built keys and the false positives are kept for the shuffle
+    TupleSpec sinkInput = makeSpec("input", {"hash", "value"});
+    TupleSpec sinkKey = makeSpec("input", {"hash"});
+    TupleSpec sinkValue = makeSpec("input", {"value"});
+    std::vector<int> whereEveryoneGoes = {0};
+    int numPartitionsPerNode = 2;
+    int numNodes = 2;
+    PartitionedJoinSink<BuildTuple> sink(numPartitionsPerNode,
+                                         numNodes,
+                                         sinkInput,
+                                         sinkKey,
+                                         sinkValue,
+                                         whereEveryoneGoes,
+                                         HashPartitionedJoin,
+                                         mergedFilter);
+    Handle<Object> sinkOutput = sink.createNewOutputContainer();
+    for (int begin = 0; begin < numKeys; begin += chunkSize) {
+        TupleSetPtr chunk = std::make_shared<TupleSet>();
+        std::vector<size_t>* hashes = new std::vector<size_t>;
+        std::vector<Handle<int>>* values = new std::vector<Handle<int>>;
+        for (int i = begin; (i < begin + chunkSize) && (i < numKeys); i++) {
+            hashes->push_back(getKeyHash(0, i));
+            values->push_back(makeObject<int>(i));
+            hashes->push_back(getMissingHash(i));
+            values->push_back(makeObject<int>(-1));
+        }
+        chunk->addColumn(0, hashes, true);
+        chunk->addColumn(1, values, true);
+        sink.writeOut(chunk, sinkOutput);
+    }
+    Handle<Vector<Handle<Vector<Handle<JoinMap<BuildTuple>>>>>> partitioned =
+        unsafeCast<Vector<Handle<Vector<Handle<JoinMap<BuildTuple>>>>>>(sinkOutput);
+    size_t numKept = 0;
+    for (int node = 0; node < numNodes; node++) {
+        for (int partition = 0; partition < numPartitionsPerNode; partition++) {
+            numKept += (*(*partitioned)[node])[partition]->size();
+        }
+    }
+    for (int i = 0; i < numKeys; i++) {
+        size_t hash = getKeyHash(0, i);
+        size_t index = hash % (numPartitionsPerNode * numNodes);
+        JoinMap<BuildTuple>& map =
+            *((*((*partitioned)[index / numPartitionsPerNode]))[index % numPartitionsPerNode]);
+        if (map.count(hash) != 1) {
+            std::cout << "the sink has " << map.count(hash) << " tuples of key " << hash
+                      << std::endl;
+            numErrors++;
+        }
+    }
+    std::cout << "the sink kept " << numKept << " of " << numKeys * 2 << " tuples" << std::endl;
+    if (numKept > numKeys + numKeys / 50) {
+        numErrors++;
+    }
+
+    for (void* page : hashPages) {
+        free(page);
+    }
+
+    if (numErrors > 0) {
+        std::cout << "FAILED with " << numErrors << " errors" << std::endl;
+        return 1;
+    }
+    std::cout << "SUCCESS" << std::endl;
+    return 0;
+}
+
+#endif
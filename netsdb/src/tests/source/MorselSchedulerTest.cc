@@ -0,0 +1,161 @@
+#ifndef MORSEL_SCHEDULER_TEST_CC
+#define MORSEL_SCHEDULER_TEST_CC
+
+// Test and benchmark for the morsel scheduling of pipeline stages.
+// The main thread feeds pages to a MorselScheduler through a bounded queue, as PipelineStage
+// does with the pages of the scan buffer, while worker threads take pages through their
+// MorselIterators, as ScanUserSet does, and sleep for the cost of each page, so that the times
+// don't depend on the number of cores of the machine. One page in numWorkers costs costRatio
+// times more than the others, so that dealing the pages in turn without stealing gives all
+// expensive pages to the same worker. It runs the pages once with
+// each worker taking only the pages dealt to it, and once with the scheduler, checks that every
+// page is run exactly once, and reports the time of both and the busy and idle time of the workers.
+//
+// usage: morselSchedulerTest [numPages] [numWorkers] [microsecondsPerPage] [costRatio]
+
+#include "MorselScheduler.h"
+#include "PDBPage.h"
+#include "PDBLogger.h"
+
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <stdlib.h>
+#include <iostream>
+
+using namespace pdb;
+
+// takes the given microseconds, as a pipeline runs on a page
+void runPage(int microseconds) {
+    std::this_thread::sleep_for(std::chrono::microseconds(microseconds));
+}
+
+int main(int argc, char* argv[]) {
+
+    int numPages = 512;
+    int numWorkers = 4;
+    int microsecondsPerPage = 100;
+    int costRatio = 8;
+    if (argc > 1) {
+        numPages = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        numWorkers = atoi(argv[2]);
+    }
+    if (argc > 3) {
+        microsecondsPerPage = atoi(argv[3]);
+    }
+    if (argc > 4) {
+        costRatio = atoi(argv[4]);
+    }
+    std::cout << "numPages=" << numPages << ", numWorkers=" << numWorkers
+              << ", microsecondsPerPage=" << microsecondsPerPage << ", costRatio=" << costRatio
+              << std::endl;
+
+    PDBLoggerPtr logger = make_shared<PDBLogger>("morselSchedulerTest.log");
+    size_t pageSize = 4096;
+    std::vector<PDBPagePtr> pages;
+    for (int i = 0; i < numPages; i++) {
+        char* data = (char*)malloc(pageSize);
+        pages.push_back(make_shared<PDBPage>(data, 0, 1, 1, 1, i, pageSize, 0, 0, 0));
+    }
+    auto costOf = [&](PageID pageId) -> int {
+        if (pageId % numWorkers == 0) {
+            return microsecondsPerPage * costRatio;
+        }
+        return microsecondsPerPage;
+    };
+
+    int numErrors = 0;
+
+    // each worker runs only the pages that are dealt to it
+    auto begin = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numWorkers; i++) {
+        threads.push_back(std::thread([&, i]() {
+            for (int j = i; j < numPages; j += numWorkers) {
+                runPage(costOf(pages[j]->getPageID()));
+            }
+        }));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+    double staticSeconds =
+        std::chrono::duration_cast<std::chrono::duration<double>>(end - begin).count();
+    std::cout << "pages dealt in turn: " << staticSeconds * 1000 << " ms" << std::endl;
+
+    // the workers take morsels from the scheduler, and steal when their queues are empty
+    std::vector<std::atomic<int>> timesRun(numPages);
+    for (auto& times : timesRun) {
+        times = 0;
+    }
+    MorselScheduler scheduler(numWorkers, 10, logger);
+    threads.clear();
+    begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < numWorkers; i++) {
+        threads.push_back(std::thread([&, i]() {
+            PageCircularBufferIteratorPtr iter = scheduler.getIterator(i);
+            while (iter->hasNext()) {
+                PDBPagePtr page = iter->next();
+                if (page != nullptr) {
+                    timesRun[page->getPageID()]++;
+                    runPage(costOf(page->getPageID()));
+                }
+            }
+        }));
+    }
+    for (auto& page : pages) {
+        scheduler.addMorsel(page);
+    }
+    scheduler.close();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    end = std::chrono::steady_clock::now();
+    double morselSeconds =
+        std::chrono::duration_cast<std::chrono::duration<double>>(end - begin).count();
+    std::cout << "morsels with stealing: " << morselSeconds * 1000 << " ms" << std::endl;
+    std::cout << scheduler.printWorkerStats();
+
+    for (int i = 0; i < numPages; i++) {
+        if (timesRun[i] != 1) {
+            std::cout << "page " << i << " is run " << timesRun[i] << " times" << std::endl;
+            numErrors++;
+        }
+    }
+    long numMorsels = 0;
+    long numStolenMorsels = 0;
+    for (int i = 0; i < numWorkers; i++) {
+        numMorsels += scheduler.getNumMorsels(i);
+        numStolenMorsels += scheduler.getNumStolenMorsels(i);
+        if (scheduler.getBusyNanos(i) <= 0) {
+            std::cout << "worker " << i << " has no busy time" << std::endl;
+            numErrors++;
+        }
+    }
+    if (numMorsels != numPages) {
+        std::cout << "the workers took " << numMorsels << " morsels" << std::endl;
+        numErrors++;
+    }
+    if ((numWorkers > 1) && (costRatio > 1) && (numStolenMorsels == 0)) {
+        std::cout << "no morsel is stolen from the worker with the expensive pages" << std::endl;
+        numErrors++;
+    }
+
+    for (auto& page : pages) {
+        free(page->getRawBytes());
+    }
+
+    if (numErrors > 0) {
+        std::cout << "FAILED with " << numErrors << " errors" << std::endl;
+        return 1;
+    }
+    std::cout << "SUCCESS" << std::endl;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,199 @@
+#ifndef PDB_MAP_TEST_CC
+#define PDB_MAP_TEST_CC
+
+// Test and benchmark for pdb::Map.
+// It inserts numKeys int keys in random order into a Map<int, int>, and numKeys / 4 long String
+// keys into a Map<String, String>, looks up all keys and as many keys that are not there,
+// iterates over the maps, and reports the nanoseconds per insert, lookup and iterated record.
+// Then it removes every other key with setUnused, which used to be safe only for the last key
+// added, checks that the removed keys are gone and that all other keys are still found, adds the
+// removed keys back, and checks a deep copy of each map.
+//
+// usage: pdbMapTest [numKeys]
+
+#include "PDBString.h"
+#include "PDBMap.h"
+#include "InterfaceFunctions.h"
+#include "UseTemporaryAllocationBlock.h"
+
+#include <chrono>
+#include <random>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <stdlib.h>
+#include <iostream>
+
+using namespace pdb;
+
+// the nanoseconds since begin, divided by the number of operations
+double nanosPerOp(std::chrono::steady_clock::time_point begin, size_t numOps) {
+    auto end = std::chrono::steady_clock::now();
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count() /
+        (double)numOps;
+}
+
+// a key that doesn't fit in a short String
+std::string makeStringKey(int i) {
+    return "key-" + std::to_string(i) + "-with-some-padding-to-make-it-long";
+}
+
+// checks that the keys at even positions are there with value = key + 1 and the keys at odd
+// positions are not, or that all keys are there if all is true; returns the number of errors
+template <class KeyType, class ValueType>
+int checkKeys(Handle<Map<KeyType, ValueType>> map,
+              std::vector<KeyType>& keys,
+              std::vector<ValueType>& values,
+              bool all) {
+    int numErrors = 0;
+    size_t expectedSize = 0;
+    for (size_t i = 0; i < keys.size(); i++) {
+        bool expected = all || (i % 2 == 0);
+        if (map->count(keys[i]) != (expected ? 1 : 0)) {
+            numErrors++;
+            continue;
+        }
+        if (expected) {
+            expectedSize++;
+            if (!((*map)[keys[i]] == values[i])) {
+                numErrors++;
+            }
+        }
+    }
+    if (map->size() != expectedSize) {
+        std::cout << "the map has " << map->size() << " keys instead of " << expectedSize
+                  << std::endl;
+        numErrors++;
+    }
+    size_t numIterated = 0;
+    for (auto iter = map->begin(); iter != map->end(); ++iter) {
+        numIterated++;
+    }
+    if (numIterated != expectedSize) {
+        std::cout << numIterated << " keys are iterated instead of " << expectedSize
+                  << std::endl;
+        numErrors++;
+    }
+    return numErrors;
+}
+
+// runs the benchmark and the checks on one map; returns the number of errors
+template <class KeyType, class ValueType>
+int runMap(std::string name,
+           std::vector<KeyType>& keys,
+           std::vector<ValueType>& values,
+           std::vector<KeyType>& absentKeys) {
+
+    int numErrors = 0;
+    Handle<Map<KeyType, ValueType>> map = makeObject<Map<KeyType, ValueType>>();
+
+    auto begin = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < keys.size(); i++) {
+        (*map)[keys[i]] = values[i];
+    }
+    double insertNanos = nanosPerOp(begin, keys.size());
+
+    begin = std::chrono::steady_clock::now();
+    size_t numFound = 0;
+    for (size_t i = 0; i < keys.size(); i++) {
+        numFound += map->count(keys[i]);
+    }
+    for (size_t i = 0; i < absentKeys.size(); i++) {
+        numFound += map->count(absentKeys[i]);
+    }
+    double lookupNanos = nanosPerOp(begin, keys.size() + absentKeys.size());
+    if (numFound != keys.size()) {
+        std::cout << numFound << " keys are found instead of " << keys.size() << std::endl;
+        numErrors++;
+    }
+
+    begin = std::chrono::steady_clock::now();
+    size_t numIterated = 0;
+    for (auto iter = map->begin(); iter != map->end(); ++iter) {
+        numIterated++;
+    }
+    double iterateNanos = nanosPerOp(begin, numIterated);
+
+    std::cout << name << ": " << keys.size() << " keys, " << insertNanos << " ns per insert, "
+              << lookupNanos << " ns per lookup, " << iterateNanos << " ns per iterated record"
+              << std::endl;
+    numErrors += checkKeys(map, keys, values, true);
+
+    // remove every other key, which moves other keys back in their probe sequences
+    for (size_t i = 1; i < keys.size(); i += 2) {
+        map->setUnused(keys[i]);
+    }
+    int numRemoveErrors = checkKeys(map, keys, values, false);
+    if (numRemoveErrors > 0) {
+        std::cout << name << ": " << numRemoveErrors << " errors after removing keys"
+                  << std::endl;
+    }
+    numErrors += numRemoveErrors;
+
+    // add them back, and check a deep copy
+    for (size_t i = 1; i < keys.size(); i += 2) {
+        (*map)[keys[i]] = values[i];
+    }
+    numErrors += checkKeys(map, keys, values, true);
+    int numCopyErrors = 0;
+    {
+        const UseTemporaryAllocationBlock tempBlock{(size_t)512 * 1024 * 1024};
+        Handle<Map<KeyType, ValueType>> copy =
+            deepCopyToCurrentAllocationBlock<Map<KeyType, ValueType>>(map);
+        numCopyErrors = checkKeys(copy, keys, values, true);
+    }
+    if (numCopyErrors > 0) {
+        std::cout << name << ": " << numCopyErrors << " errors in the copy" << std::endl;
+    }
+    numErrors += numCopyErrors;
+    return numErrors;
+}
+
+int main(int argc, char* argv[]) {
+
+    int numKeys = 1000000;
+    if (argc > 1) {
+        numKeys = atoi(argv[1]);
+    }
+    std::cout << "numKeys=" << numKeys << std::endl;
+
+    makeObjectAllocatorBlock((size_t)1024 * 1024 * 1024, true);
+
+    std::vector<int> order(numKeys * 2);
+    for (int i = 0; i < numKeys * 2; i++) {
+        order[i] = i;
+    }
+    std::shuffle(order.begin(), order.end(), std::mt19937(1));
+
+    int numErrors = 0;
+    {
+        std::vector<int> keys(order.begin(), order.begin() + numKeys);
+        std::vector<int> absentKeys(order.begin() + numKeys, order.end());
+        std::vector<int> values;
+        for (int key : keys) {
+            values.push_back(key + 1);
+        }
+        numErrors += runMap<int, int>("Map<int, int>", keys, values, absentKeys);
+    }
+    {
+        int numStringKeys = numKeys / 4;
+        std::vector<String> keys;
+        std::vector<String> absentKeys;
+        std::vector<String> values;
+        for (int i = 0; i < numStringKeys; i++) {
+            keys.push_back(String(makeStringKey(order[i])));
+            absentKeys.push_back(String(makeStringKey(order[numKeys + i])));
+            values.push_back(String(makeStringKey(order[i] + 1)));
+        }
+        numErrors += runMap<String, String>("Map<String, String>", keys, values, absentKeys);
+    }
+
+    if (numErrors > 0) {
+        std::cout << "FAILED with " << numErrors << " errors" << std::endl;
+        return 1;
+    }
+    std::cout << "SUCCESS" << std::endl;
+    return 0;
+}
+
+#endif
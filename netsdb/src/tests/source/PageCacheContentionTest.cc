@@ -0,0 +1,105 @@
+#ifndef PAGE_CACHE_CONTENTION_TEST_CC
+#define PAGE_CACHE_CONTENTION_TEST_CC
+
+// Benchmark for the lock contention in PageCache.
+// It caches a number of pages, and then lets an increasing number of threads pin and unpin
+// randomly selected cached pages, reporting the getPage() throughput for each thread count.
+//
+// usage: pageCacheContentionTest [numPages] [numOpsPerThread] [maxThreads] [numShards]
+
+#include "PageCache.h"
+#include "PageCircularBuffer.h"
+#include "SharedMem.h"
+#include "PDBLogger.h"
+#include "PDBWorkerQueue.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <stdlib.h>
+#include <iostream>
+
+#define CONTENTION_TEST_PAGE_SIZE ((size_t)(1024) * (size_t)(1024))
+
+int main(int argc, char* argv[]) {
+
+    int numPages = 256;
+    int numOpsPerThread = 1000000;
+    int maxThreads = 32;
+    unsigned int numShards = DEFAULT_NUM_CACHE_SHARDS;
+    if (argc > 1) {
+        numPages = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        numOpsPerThread = atoi(argv[2]);
+    }
+    if (argc > 3) {
+        maxThreads = atoi(argv[3]);
+    }
+    if (argc > 4) {
+        numShards = atoi(argv[4]);
+    }
+    std::cout << "numPages=" << numPages << ", numOpsPerThread=" << numOpsPerThread
+              << ", maxThreads=" << maxThreads << ", numShards=" << numShards << std::endl;
+
+    ConfigurationPtr conf = make_shared<Configuration>();
+    // twice the room of all pages, so that no eviction is triggered while measuring
+    conf->setShmSize((size_t)numPages * (CONTENTION_TEST_PAGE_SIZE + 1024) * 2 +
+                     6 * conf->getMaxPageSize());
+    conf->setNumCacheShards(numShards);
+    pdb::PDBLoggerPtr logger = make_shared<pdb::PDBLogger>("pageCacheContentionTest.log");
+    SharedMemPtr shm = make_shared<SharedMem>(conf->getShmSize(), logger);
+    pdb::PDBWorkerQueuePtr workers = make_shared<pdb::PDBWorkerQueue>(logger, 4);
+    PageCircularBufferPtr flushBuffer = make_shared<PageCircularBuffer>(8, logger);
+    PageCachePtr cache =
+        make_shared<PageCache>(conf, workers, flushBuffer, logger, shm, UnifiedLRU);
+
+    // populate the cache
+    CacheKey key;
+    key.dbId = 1;
+    key.typeId = 1;
+    key.setId = 1;
+    for (int i = 0; i < numPages; i++) {
+        key.pageId = i;
+        PDBPagePtr page = cache->getNewPage(conf->getNodeID(), key, nullptr,
+                                            CONTENTION_TEST_PAGE_SIZE);
+        if (page == nullptr) {
+            std::cout << "can't allocate page " << i << ", exit..." << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        cache->decPageRefCount(key);
+    }
+
+    for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+        std::vector<std::thread> threads;
+        auto begin = std::chrono::high_resolution_clock::now();
+        for (int t = 0; t < numThreads; t++) {
+            threads.push_back(std::thread([&cache, numPages, numOpsPerThread, t]() {
+                unsigned int seed = t + 1;
+                CacheKey myKey;
+                myKey.dbId = 1;
+                myKey.typeId = 1;
+                myKey.setId = 1;
+                for (int i = 0; i < numOpsPerThread; i++) {
+                    myKey.pageId = rand_r(&seed) % numPages;
+                    PDBPagePtr page = cache->getPage(myKey, nullptr);
+                    if (page != nullptr) {
+                        cache->decPageRefCount(myKey);
+                    }
+                }
+            }));
+        }
+        for (int t = 0; t < numThreads; t++) {
+            threads[t].join();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        double seconds = std::chrono::duration_cast<std::chrono::duration<double>>(end - begin).count();
+        double opsPerSecond = (double)numThreads * (double)numOpsPerThread / seconds;
+        std::cout << "threads=" << numThreads << ", time=" << seconds
+                  << " seconds, getPage throughput=" << opsPerSecond << " ops/second" << std::endl;
+    }
+    cache->printStats();
+    return 0;
+}
+
+#endif
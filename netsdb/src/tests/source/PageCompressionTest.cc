@@ -0,0 +1,131 @@
+#ifndef PAGE_COMPRESSION_TEST_CC
+#define PAGE_COMPRESSION_TEST_CC
+
+// Test for per-page compression of PartitionedFile.
+// It appends pages filled with repetitive tuples to a PartitionedFile stored with the given codec,
+// reloads the file from its meta partition, checks that every page reads back unchanged, and
+// reports the compression ratio.
+//
+// usage: pageCompressionTest [codec: 0=none, 1=snappy, 2=lz4, 3=zstd] [numPages] [pageSizeInKB]
+
+#include "PartitionedFile.h"
+#include "PageCompressor.h"
+#include "PDBPage.h"
+#include "PDBLogger.h"
+
+#include <chrono>
+#include <vector>
+#include <string>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <iostream>
+
+int main(int argc, char* argv[]) {
+
+    PageCompressionType compressionType = SnappyPageCompression;
+    int numPages = 16;
+    size_t pageSize = (size_t)(1024) * (size_t)(1024);
+    if (argc > 1) {
+        compressionType = (PageCompressionType)atoi(argv[1]);
+    }
+    if (argc > 2) {
+        numPages = atoi(argv[2]);
+    }
+    if (argc > 3) {
+        pageSize = (size_t)atoi(argv[3]) * (size_t)(1024);
+    }
+    std::cout << "codec=" << PageCompressor::getName(compressionType)
+              << ", numPages=" << numPages << ", pageSize=" << pageSize << std::endl;
+
+    pdb::PDBLoggerPtr logger = make_shared<pdb::PDBLogger>("pageCompressionTest.log");
+    std::string metaPath = "/tmp/pageCompressionTest.meta";
+    std::vector<std::string> dataPaths;
+    dataPaths.push_back("/tmp/pageCompressionTest.data0");
+    dataPaths.push_back("/tmp/pageCompressionTest.data1");
+    remove(metaPath.c_str());
+    for (auto path : dataPaths) {
+        remove(path.c_str());
+    }
+
+    // write pages, alternating between the two partitions
+    std::vector<char*> pages;
+    PartitionedFilePtr file = make_shared<PartitionedFile>(
+        0, 1, 1, 1, metaPath, dataPaths, logger, pageSize, compressionType);
+    auto begin = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < numPages; i++) {
+        char* data = nullptr;
+        if (posix_memalign((void**)&data, 512, pageSize) != 0) {
+            std::cout << "can't allocate page " << i << ", exit..." << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        PDBPagePtr page = make_shared<PDBPage>(data, 0, 1, 1, 1, i, pageSize, 0, 0, 0);
+        page->preparePage();
+        // fill the page with tuples of a few distinct values, like a typical TPC-H column
+        char* cur = data + 1024;
+        unsigned int seed = i + 1;
+        while (cur + 32 <= data + pageSize) {
+            snprintf(cur, 32, "%08d|%04d|BUILDING|", i, rand_r(&seed) % 100);
+            cur += 32;
+        }
+        if (file->appendPage(i % 2, page) < 0) {
+            std::cout << "can't append page " << i << ", exit..." << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        page->setRawBytes(nullptr);
+        pages.push_back(data);
+    }
+    file->writeMeta();
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "write time: "
+              << std::chrono::duration_cast<std::chrono::duration<double>>(end - begin).count()
+              << " seconds" << std::endl;
+    size_t numStoredBytes = file->getNumStoredBytes();
+    double compressionRatio = file->getCompressionRatio();
+    file = nullptr;
+
+    // reload the file from the meta partition, and read all pages back
+    file = make_shared<PartitionedFile>(0, 1, 1, 1, metaPath, logger);
+    file->buildMetaDataFromMetaPartition(nullptr);
+    file->initializeDataFiles();
+    file->openData();
+    char* loaded = nullptr;
+    if (posix_memalign((void**)&loaded, 512, pageSize) != 0) {
+        std::cout << "can't allocate page, exit..." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    int numErrors = 0;
+    begin = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < numPages; i++) {
+        memset(loaded, 0, pageSize);
+        size_t ret = file->loadPageAt(i % 2, i / 2, loaded, pageSize);
+        if ((ret == (size_t)(-1)) || (memcmp(loaded, pages[i], pageSize) != 0)) {
+            std::cout << "page " << i << " is corrupted, ret=" << ret << std::endl;
+            numErrors++;
+        }
+    }
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "read time: "
+              << std::chrono::duration_cast<std::chrono::duration<double>>(end - begin).count()
+              << " seconds" << std::endl;
+    if (file->getNumStoredBytes() != numStoredBytes) {
+        std::cout << "stored bytes changed after reload" << std::endl;
+        numErrors++;
+    }
+    std::cout << "stored bytes=" << numStoredBytes << ", compression ratio=" << compressionRatio
+              << std::endl;
+
+    free(loaded);
+    for (auto page : pages) {
+        free(page);
+    }
+    file->clear();
+    if (numErrors > 0) {
+        std::cout << "FAILED with " << numErrors << " errors" << std::endl;
+        return 1;
+    }
+    std::cout << "SUCCESS" << std::endl;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,316 @@
+#ifndef PAGE_RECEIVER_TEST_CC
+#define PAGE_RECEIVER_TEST_CC
+
+// Test for the receiver of the pages of a StorageAddObjectInLoop loop.
+// It sends pages over a loopback connection to a PageReceiver that stores them to a UserSet, and
+// checks that uncompressed pages are received straight to the pages of the set without a copy,
+// that compressed pages are decompressed to them with one copy, that the receiver moves to a new
+// page of the set when the current one is full, and that every page is stored unchanged. It then
+// checks that a page that can't be received, because the sender closes the connection in the
+// middle of it, and a page that can't be decompressed give their area of the page back, so that
+// the next page is stored where they would have been, and that a thread keeps only a small
+// receive buffer after it releases its buffers.
+//
+// usage: pageReceiverTest [numPages] [pageSizeInKB]
+
+#include "PageReceiver.h"
+#include "PageCompressor.h"
+#include "PageCache.h"
+#include "PageCircularBuffer.h"
+#include "UserSet.h"
+#include "SharedMem.h"
+#include "PDBCommunicator.h"
+#include "PDBLogger.h"
+#include "PDBWorkerQueue.h"
+#include "BuiltInObjectTypeIDs.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace pdb;
+
+PDBLoggerPtr logger;
+int listenFD = -1;
+int port = 0;
+
+// the i-th page that is sent; the pages have the same size, and compress well
+std::string makePage(int i, size_t size) {
+    std::string page(size, '\0');
+    for (size_t j = 0; j < page.size(); j++) {
+        page[j] = (char)((i + j / 64) % 251);
+    }
+    return page;
+}
+
+// connects a sender to the receiving side of a new loopback connection
+bool connect(PDBCommunicatorPtr& sender, PDBCommunicatorPtr& receiver) {
+    std::string errMsg;
+    sender = std::make_shared<PDBCommunicator>();
+    receiver = std::make_shared<PDBCommunicator>();
+    if (sender->connectToInternetServer(logger, port, "localhost", errMsg) ||
+        receiver->pointToInternet(logger, listenFD, errMsg)) {
+        std::cout << "can't connect: " << errMsg << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// sends a page with codec, and receives and stores it; returns where it is stored, or nullptr
+char* sendAndStore(PageReceiver& pageReceiver,
+                   PDBCommunicatorPtr sender,
+                   PDBCommunicatorPtr receiver,
+                   const std::string& page,
+                   PageCompressionType codec) {
+    std::string errMsg;
+    std::vector<char> bytes(page.begin(), page.end());
+    if (codec != NoPageCompression) {
+        bytes.resize(PageCompressor::getMaxCompressedLength(codec, page.size()));
+        bytes.resize(PageCompressor::compress(codec, page.data(), page.size(), bytes.data()));
+    }
+    if (!sender->sendBytes(bytes.data(), bytes.size(), errMsg) ||
+        !pageReceiver.receive(receiver, codec, page.size(), errMsg)) {
+        std::cout << "can't receive a page: " << errMsg << std::endl;
+        return nullptr;
+    }
+    char* stored = (char*)pageReceiver.store(errMsg);
+    if (stored == nullptr) {
+        std::cout << "can't store a page: " << errMsg << std::endl;
+        return nullptr;
+    }
+    return stored;
+}
+
+// the number of pages of the set, and the pages stored on each of them
+std::vector<int> getNumStoredPages(PageCachePtr cache, SetPtr set) {
+    std::vector<int> numStored;
+    CacheKey key;
+    key.dbId = set->getDbID();
+    key.typeId = set->getTypeID();
+    key.setId = set->getSetID();
+    for (int i = 0; i < set->getNumPages(); i++) {
+        key.pageId = i;
+        PDBPagePtr page = cache->getPage(key, set.get());
+        if (page == nullptr) {
+            numStored.push_back(-1);
+            continue;
+        }
+        numStored.push_back(page->getEmbeddedNumObjects());
+        cache->decPageRefCount(key);
+    }
+    return numStored;
+}
+
+int main(int argc, char* argv[]) {
+
+    int numPages = 32;
+    size_t setPageSize = (size_t)(64) * (size_t)(1024);
+    if (argc > 1) {
+        numPages = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        setPageSize = (size_t)atoi(argv[2]) * (size_t)(1024);
+    }
+    // a few received pages fit in a page of the set, so that the receiver moves to new pages
+    size_t receivedPageSize = setPageSize / 5;
+    std::cout << "numPages=" << numPages << ", setPageSize=" << setPageSize
+              << ", receivedPageSize=" << receivedPageSize << std::endl;
+
+    logger = std::make_shared<PDBLogger>("pageReceiverTest.log");
+    int numErrors = 0;
+
+    // the receiving side listens on a free port
+    listenFD = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in serverAddress;
+    bzero((char*)&serverAddress, sizeof(serverAddress));
+    serverAddress.sin_family = AF_INET;
+    serverAddress.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    serverAddress.sin_port = 0;
+    socklen_t addressLength = sizeof(serverAddress);
+    if (bind(listenFD, (struct sockaddr*)&serverAddress, sizeof(serverAddress)) < 0 ||
+        listen(listenFD, 100) < 0 ||
+        getsockname(listenFD, (struct sockaddr*)&serverAddress, &addressLength) < 0) {
+        std::cout << "FAILED to listen" << std::endl;
+        return 1;
+    }
+    port = ntohs(serverAddress.sin_port);
+
+    // room for all pages, so that no page of the set is evicted
+    ConfigurationPtr conf = make_shared<Configuration>();
+    conf->setShmSize((size_t)(numPages + 8) * (setPageSize + 1024) * 2);
+    SharedMemPtr shm = make_shared<SharedMem>(conf->getShmSize(), logger);
+    PDBWorkerQueuePtr workers = make_shared<PDBWorkerQueue>(logger, 2);
+    PageCircularBufferPtr flushBuffer = make_shared<PageCircularBuffer>(8, logger);
+    PageCachePtr cache =
+        make_shared<PageCache>(conf, workers, flushBuffer, logger, shm, UnifiedIntelligent);
+    SetPtr set = make_shared<UserSet>(
+        logger, shm, 0, 1, 1, 1, "pageReceiverTestSet", cache, JobData, LRU, Write, TryCache,
+        Transient, setPageSize);
+
+    PDBCommunicatorPtr sender;
+    PDBCommunicatorPtr receiver;
+    if (!connect(sender, receiver)) {
+        return 1;
+    }
+    PageReceiveCounters& counters = getPageReceiveCounters();
+
+    // the pages are received alternately uncompressed, straight to the page of the set, and
+    // compressed, which are decompressed to it
+    {
+        PageReceiver pageReceiver(set);
+        size_t numCopiesBefore = counters.numCopies;
+        size_t numAllocationsBefore = counters.numBufferAllocations;
+        int numCompressed = 0;
+        for (int i = 0; i < numPages; i++) {
+            PageCompressionType codec =
+                (i % 2 == 0) ? NoPageCompression : SnappyPageCompression;
+            std::string page = makePage(i, receivedPageSize);
+            char* stored = sendAndStore(pageReceiver, sender, receiver, page, codec);
+            if ((stored == nullptr) || (memcmp(stored, page.data(), page.size()) != 0) ||
+                (pageReceiver.getSizeOfLastPage() != page.size())) {
+                std::cout << "page " << i << " is not stored unchanged" << std::endl;
+                numErrors++;
+            }
+            if (codec != NoPageCompression) {
+                numCompressed++;
+            }
+        }
+        if (counters.numCopies - numCopiesBefore != (size_t)numCompressed) {
+            std::cout << counters.numCopies - numCopiesBefore << " copies for " << numCompressed
+                      << " compressed pages" << std::endl;
+            numErrors++;
+        }
+        // the compressed pages are received to a buffer that is reused, not one buffer per page
+        if ((numCompressed > 1) &&
+            (counters.numBufferAllocations - numAllocationsBefore >= (size_t)numCompressed)) {
+            std::cout << counters.numBufferAllocations - numAllocationsBefore
+                      << " buffers are allocated" << std::endl;
+            numErrors++;
+        }
+    }
+
+    // the pages are spread over pages of the set, which are all full but the last one
+    std::vector<int> numStored = getNumStoredPages(cache, set);
+    int maxPerPage = (int)(setPageSize / (receivedPageSize + sizeof(size_t)));
+    int total = 0;
+    for (size_t i = 0; i < numStored.size(); i++) {
+        total += numStored[i];
+        if ((numStored[i] <= 0) || (numStored[i] > maxPerPage) ||
+            ((i + 1 < numStored.size()) && (numStored[i] < maxPerPage - 1))) {
+            std::cout << "page " << i << " of the set stores " << numStored[i] << " pages"
+                      << std::endl;
+            numErrors++;
+        }
+    }
+    std::cout << numPages << " pages are stored on " << numStored.size() << " pages of the set"
+              << std::endl;
+    if ((total != numPages) || ((numPages > maxPerPage) && (numStored.size() < 2))) {
+        std::cout << total << " pages are stored on " << numStored.size()
+                  << " pages of the set" << std::endl;
+        numErrors++;
+    }
+
+    // a page that is cut off by the sender, and a page that can't be decompressed give their
+    // area back
+    {
+        int numSetPagesBefore = set->getNumPages();
+        PageReceiver pageReceiver(set);
+        std::string page = makePage(0, receivedPageSize);
+        char* first = sendAndStore(pageReceiver, sender, receiver, page, NoPageCompression);
+        char* next = first + page.size() + sizeof(size_t);
+
+        // the sender sends the header and half of the page, and closes the connection
+        int16_t recType = NoMsg_TYPEID;
+        size_t size = page.size();
+        std::string errMsg;
+        if ((write(sender->getSocketFD(), &recType, sizeof(int16_t)) != sizeof(int16_t)) ||
+            (write(sender->getSocketFD(), &size, sizeof(size_t)) != sizeof(size_t)) ||
+            (write(sender->getSocketFD(), page.data(), size / 2) != (ssize_t)(size / 2))) {
+            std::cout << "can't send half of a page" << std::endl;
+            numErrors++;
+        }
+        sender = nullptr;
+        if (pageReceiver.receive(receiver, NoPageCompression, size, errMsg)) {
+            std::cout << "half of a page is received" << std::endl;
+            numErrors++;
+        }
+        receiver = nullptr;
+        if (!connect(sender, receiver)) {
+            return 1;
+        }
+        char* stored = sendAndStore(pageReceiver, sender, receiver, page, NoPageCompression);
+        if (stored != next) {
+            std::cout << "the area of a page that is not received is not given back" << std::endl;
+            numErrors++;
+        }
+        next = stored + page.size() + sizeof(size_t);
+
+        // bytes that are not snappy
+        std::string garbage(page.size() / 2, '\xff');
+        if (!sender->sendBytes(&garbage[0], garbage.size(), errMsg) ||
+            !pageReceiver.receive(receiver, SnappyPageCompression, page.size(), errMsg)) {
+            std::cout << "can't receive a page that can't be decompressed: " << errMsg
+                      << std::endl;
+            numErrors++;
+        } else if (pageReceiver.store(errMsg) != nullptr) {
+            std::cout << "a page that can't be decompressed is stored" << std::endl;
+            numErrors++;
+        }
+        stored = sendAndStore(pageReceiver, sender, receiver, page, NoPageCompression);
+        if (stored != next) {
+            std::cout << "the area of a page that is not decompressed is not given back"
+                      << std::endl;
+            numErrors++;
+        }
+        pageReceiver.finish();
+        std::vector<int> numStoredNow = getNumStoredPages(cache, set);
+        if ((set->getNumPages() != numSetPagesBefore + 1) ||
+            (numStoredNow.size() == 0) || (numStoredNow.back() != 3)) {
+            std::cout << "the page of the set stores "
+                      << (numStoredNow.size() == 0 ? 0 : numStoredNow.back())
+                      << " pages instead of 3" << std::endl;
+            numErrors++;
+        }
+    }
+
+    // a thread keeps a small receive buffer after it releases its buffers, but not a large one
+    {
+        getThreadReceiveBuffer(receivedPageSize);
+        getThreadReceiveBuffer(MAX_KEPT_RECEIVE_BUFFER_SIZE + 1);
+        releaseThreadReceiveBuffers();
+        size_t numAllocationsBefore = counters.numBufferAllocations;
+        getThreadReceiveBuffer(receivedPageSize);
+        if (counters.numBufferAllocations != numAllocationsBefore + 1) {
+            std::cout << "a large receive buffer is kept after it is released" << std::endl;
+            numErrors++;
+        }
+        getThreadReceiveBuffer(receivedPageSize);
+        releaseThreadReceiveBuffers();
+        getThreadReceiveBuffer(receivedPageSize);
+        if (counters.numBufferAllocations != numAllocationsBefore + 1) {
+            std::cout << "a small receive buffer is not kept after it is released" << std::endl;
+            numErrors++;
+        }
+        releaseThreadReceiveBuffers();
+    }
+    std::cout << counters.toString() << std::endl;
+
+    sender = nullptr;
+    receiver = nullptr;
+    close(listenFD);
+
+    if (numErrors > 0) {
+        std::cout << "FAILED with " << numErrors << " errors" << std::endl;
+        return 1;
+    }
+    std::cout << "SUCCESS" << std::endl;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,263 @@
+#ifndef PAX_PAGE_TEST_CC
+#define PAX_PAGE_TEST_CC
+
+// Test for PAX columns of pages.
+// It loads flat objects into a page, leaving room for PAX columns as the storage server does for
+// a set with columnar attributes, builds the PAX columns, and checks that the columns and the
+// columnar view that a scan attaches to its tuple sets return the same values as the objects,
+// also after a filter. It then reports the time to read an attribute of all objects through the
+// handles and through the PAX column.
+//
+// usage: paxPageTest [pageSizeInKB] [numScans]
+
+#include "PDBPage.h"
+#include "PaxPage.h"
+#include "Object.h"
+#include "Handle.h"
+#include "PDBVector.h"
+#include "PDBString.h"
+#include "InterfaceFunctions.h"
+#include "UseTemporaryAllocationBlock.h"
+#include "Ptr.h"
+#include "ComputeSource.h"
+#include "VectorTupleSetIterator.h"
+
+#include <chrono>
+#include <vector>
+#include <string>
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+
+using namespace pdb;
+
+// a flat object, like a narrow TPC-H LineItem
+class PaxTestRow : public Object {
+
+public:
+    int quantity;
+    long orderKey;
+    double extendedPrice;
+    String comment;
+
+    ENABLE_DEEP_COPY
+
+    PaxTestRow() {}
+
+    PaxTestRow(int quantity, long orderKey, double extendedPrice, std::string comment)
+        : quantity(quantity), orderKey(orderKey), extendedPrice(extendedPrice), comment(comment) {}
+};
+
+int main(int argc, char* argv[]) {
+
+    size_t pageSize = (size_t)(1024) * (size_t)(1024);
+    int numScans = 100;
+    if (argc > 1) {
+        pageSize = (size_t)atoi(argv[1]) * (size_t)(1024);
+    }
+    if (argc > 2) {
+        numScans = atoi(argv[2]);
+    }
+    std::cout << "pageSize=" << pageSize << ", numScans=" << numScans << std::endl;
+
+    makeObjectAllocatorBlock(4 * 1024 * 1024, true);
+    Handle<PaxTestRow> sample = makeObject<PaxTestRow>();
+    char* sampleBytes = (char*)&(*sample);
+    std::vector<ZoneMapAttribute> attributes;
+    ZoneMapAttribute attribute;
+    attribute.columnar = true;
+    attribute.name = "quantity";
+    attribute.byteOffset = (char*)&(sample->quantity) - sampleBytes;
+    attribute.type = ZoneMapInt;
+    attributes.push_back(attribute);
+    attribute.name = "orderKey";
+    attribute.byteOffset = (char*)&(sample->orderKey) - sampleBytes;
+    attribute.type = ZoneMapLong;
+    attributes.push_back(attribute);
+    attribute.name = "extendedPrice";
+    attribute.byteOffset = (char*)&(sample->extendedPrice) - sampleBytes;
+    attribute.type = ZoneMapDouble;
+    attributes.push_back(attribute);
+
+    // load objects into the page, leaving room for the PAX columns, and every 97th object is null
+    char* data = (char*)malloc(pageSize);
+    if (data == nullptr) {
+        std::cout << "can't allocate page, exit..." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    PDBPagePtr page = make_shared<PDBPage>(data, 0, 1, 1, 1, 0, pageSize, 0, 0, 0);
+    page->preparePage();
+    size_t bytesSize = pageSize - DEFAULT_PAGE_HEADER_SIZE;
+    size_t bytesPerObject = sizeof(PaxTestRow) + 64;
+    size_t numRows = bytesSize / (bytesPerObject + PaxPage::getRowWidth(attributes)) + 1;
+    size_t blockSize = bytesSize - PaxPage::getColumnsSize(numRows, attributes);
+    int numObjects = 0;
+    {
+        UseTemporaryAllocationBlock block(page->getBytes(), blockSize);
+        Handle<Vector<Handle<Object>>> objects = makeObject<Vector<Handle<Object>>>();
+        try {
+            for (int i = 0; true; i++) {
+                if (i % 97 == 0) {
+                    objects->push_back(nullptr);
+                } else {
+                    Handle<PaxTestRow> row =
+                        makeObject<PaxTestRow>(i % 50, (long)i * 4, i * 1.5, "regular deposits");
+                    objects->push_back(row);
+                }
+                numObjects++;
+            }
+        } catch (NotEnoughSpace& n) {
+        }
+        getRecord(objects);
+    }
+    std::cout << "loaded " << numObjects << " objects" << std::endl;
+
+    int numErrors = 0;
+    if (PaxPage::build(page, attributes) == false) {
+        std::cout << "can't build PAX columns, exit..." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    void* bytes = page->getBytes();
+    PaxFooter* footer = PaxPage::getFooter(bytes, PaxPage::getBytesSize(bytes));
+    if ((footer == nullptr) || (footer->numColumns != attributes.size())) {
+        std::cout << "can't find PAX columns, exit..." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    Record<Vector<Handle<Object>>>* myRecord = (Record<Vector<Handle<Object>>>*)bytes;
+    Vector<Handle<Object>>& objects = *(myRecord->getRootObject());
+    size_t numVectorRows = objects.size();
+    if (footer->numRows != numVectorRows) {
+        std::cout << "PAX columns have " << footer->numRows << " rows" << std::endl;
+        numErrors++;
+    }
+
+    // check every value in the PAX columns against the objects
+    size_t width;
+    int* quantities =
+        (int*)PaxPage::getColumn(bytes, footer, attributes[0].byteOffset, width);
+    long* orderKeys =
+        (long*)PaxPage::getColumn(bytes, footer, attributes[1].byteOffset, width);
+    double* prices =
+        (double*)PaxPage::getColumn(bytes, footer, attributes[2].byteOffset, width);
+    for (size_t i = 0; i < numVectorRows; i++) {
+        if (objects[i] == nullptr) {
+            if ((quantities[i] != 0) || (orderKeys[i] != 0) || (prices[i] != 0)) {
+                std::cout << "row " << i << " is null, but has values" << std::endl;
+                numErrors++;
+            }
+            continue;
+        }
+        Handle<PaxTestRow> row = unsafeCast<PaxTestRow, Object>(objects[i]);
+        if ((quantities[i] != row->quantity) || (orderKeys[i] != row->orderKey) ||
+            (prices[i] != row->extendedPrice)) {
+            std::cout << "row " << i << " has wrong values" << std::endl;
+            numErrors++;
+        }
+    }
+
+    // scan the page, and check the columnar view of each tuple set, also after a filter
+    bool fetched = false;
+    VectorTupleSetIterator scan(
+        [&]() -> void* {
+            if (fetched) {
+                return nullptr;
+            }
+            fetched = true;
+            return bytes;
+        },
+        [](void*) {},
+        1000,
+        true);
+    size_t numScannedRows = 0;
+    TupleSetPtr tupleSet;
+    while ((tupleSet = scan.getNextTupleSet()) != nullptr) {
+        std::vector<Handle<Object>>& column = tupleSet->getColumn<Handle<Object>>(0);
+        ColumnarViewPtr view = tupleSet->getColumnarView(0);
+        char* array;
+        if ((view == nullptr) || (view->getArray(attributes[1].byteOffset, array, width) == false)) {
+            std::cout << "tuple set has no columnar view" << std::endl;
+            numErrors++;
+            break;
+        }
+        std::vector<bool> evenKeys;
+        for (size_t i = 0; i < column.size(); i++) {
+            long orderKey = *((long*)(array + view->getRow(i) * width));
+            if ((column[i] != nullptr) &&
+                (orderKey != unsafeCast<PaxTestRow, Object>(column[i])->orderKey)) {
+                std::cout << "tuple " << numScannedRows + i << " has a wrong view" << std::endl;
+                numErrors++;
+            }
+            evenKeys.push_back(orderKey % 8 == 0);
+        }
+        numScannedRows += column.size();
+        tupleSet->filterColumn(0, evenKeys);
+        std::vector<Handle<Object>>& filtered = tupleSet->getColumn<Handle<Object>>(0);
+        view = tupleSet->getColumnarView(0);
+        view->getArray(attributes[1].byteOffset, array, width);
+        for (size_t i = 0; i < filtered.size(); i++) {
+            long orderKey = *((long*)(array + view->getRow(i) * width));
+            if ((orderKey % 8 != 0) || ((filtered[i] != nullptr) &&
+                (orderKey != unsafeCast<PaxTestRow, Object>(filtered[i])->orderKey))) {
+                std::cout << "filtered tuple " << i << " has a wrong view" << std::endl;
+                numErrors++;
+            }
+        }
+    }
+    if (numScannedRows != numVectorRows) {
+        std::cout << "scanned " << numScannedRows << " rows" << std::endl;
+        numErrors++;
+    }
+
+    // compare the time to read an attribute through the handles and through the PAX column
+    long sum = 0;
+    auto begin = std::chrono::high_resolution_clock::now();
+    for (int j = 0; j < numScans; j++) {
+        for (size_t i = 0; i < numVectorRows; i++) {
+            if (objects[i] != nullptr) {
+                sum += unsafeCast<PaxTestRow, Object>(objects[i])->quantity;
+            }
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "read through handles: "
+              << std::chrono::duration_cast<std::chrono::duration<double>>(end - begin).count()
+              << " seconds" << std::endl;
+    long paxSum = 0;
+    begin = std::chrono::high_resolution_clock::now();
+    for (int j = 0; j < numScans; j++) {
+        for (size_t i = 0; i < numVectorRows; i++) {
+            paxSum += quantities[i];
+        }
+    }
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "read through PAX column: "
+              << std::chrono::duration_cast<std::chrono::duration<double>>(end - begin).count()
+              << " seconds" << std::endl;
+    if (sum != paxSum) {
+        std::cout << "sums don't match: " << sum << " vs " << paxSum << std::endl;
+        numErrors++;
+    }
+
+    // stale columns must never be found once the buffer is cleared for a new page
+    PaxPage::clear(page);
+    if (PaxPage::getFooter(bytes, PaxPage::getBytesSize(bytes)) != nullptr) {
+        std::cout << "found PAX columns after clear" << std::endl;
+        numErrors++;
+    }
+    // and columns that don't fit are not built
+    if (PaxPage::build(bytes, myRecord->numBytes() + sizeof(PaxFooter), attributes) == true) {
+        std::cout << "built PAX columns without room" << std::endl;
+        numErrors++;
+    }
+
+    page->setRawBytes(nullptr);
+    free(data);
+    if (numErrors > 0) {
+        std::cout << "FAILED with " << numErrors << " errors" << std::endl;
+        return 1;
+    }
+    std::cout << "SUCCESS" << std::endl;
+    return 0;
+}
+
+#endif
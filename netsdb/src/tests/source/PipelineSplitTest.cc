@@ -0,0 +1,250 @@
+#ifndef PIPELINE_SPLIT_TEST_CC
+#define PIPELINE_SPLIT_TEST_CC
+
+// Test for the splitting of chunks that don't fit in an output page, and the chunk size
+// controller of Pipeline.
+// It runs a Pipeline over numRows keys, which keeps the even keys with a filter and then makes a
+// block of blockBytes bytes for each key, as a pipeline over tensor blocks or images does, and
+// writes the blocks to a VectorSink. A chunk of the given batch size doesn't fit in an output
+// page, so that Pipeline::run used to exit. The pipeline runs once with the batch size fixed, and
+// once with the chunk size fit to the pages. It checks that each even key is written back exactly
+// once, and reports the number of chunks that were split, the final chunk size, and how much of
+// the written pages the blocks fill, as a chunk that overflows a page leaves garbage behind.
+// It then runs the pipeline with blocks larger than a page, and checks that Pipeline::run reports
+// the failure instead of returning as if the keys were all processed.
+//
+// usage: pipelineSplitTest [numRows] [batchSize] [blockBytes] [pageSizeInKB]
+
+#include "TupleSpec.h"
+#include "Ptr.h"
+#include "ComputeInfo.h"
+#include "TupleSet.h"
+#include "SimpleComputeExecutor.h"
+#include "FilterExecutor.h"
+#include "VectorSink.h"
+#include "Pipeline.h"
+#include "InterfaceFunctions.h"
+
+#include <vector>
+#include <string>
+#include <stdlib.h>
+#include <iostream>
+
+using namespace pdb;
+
+// builds a TupleSpec with the given attributes
+TupleSpec makeSpec(std::string setName, std::vector<std::string> atts) {
+    AttList attList;
+    for (auto& att : atts) {
+        attList.appendAttribute((char*)att.c_str());
+    }
+    return TupleSpec(setName, attList);
+}
+
+// a source of chunks of keys, as VectorTupleSetIterator slices the objects in a page
+class KeySource : public ComputeSource {
+
+private:
+    int numRows;
+    int pos = 0;
+    size_t chunkSize;
+    bool adaptive;
+    TupleSetPtr output;
+
+public:
+    KeySource(int numRows, size_t chunkSize, bool adaptive)
+        : numRows(numRows), chunkSize(chunkSize), adaptive(adaptive) {
+        output = std::make_shared<TupleSet>();
+        output->addColumn(0, new std::vector<int>, true);
+    }
+
+    TupleSetPtr getNextTupleSet() override {
+        if (pos == numRows) {
+            return nullptr;
+        }
+        std::vector<int>& keys = output->getColumn<int>(0);
+        keys.clear();
+        for (; (pos < numRows) && (keys.size() < chunkSize); pos++) {
+            keys.push_back(pos);
+        }
+        return output;
+    }
+
+    void setChunkSize(size_t chunkSize) override {
+        this->chunkSize = chunkSize;
+    }
+
+    size_t getChunkSize() override {
+        return chunkSize;
+    }
+
+    bool isChunkSizeAdaptive() override {
+        return adaptive;
+    }
+};
+
+// runs the pipeline, and returns the number of errors
+int runPipeline(int numRows, size_t batchSize, int blockBytes, size_t pageSize, bool adaptive) {
+
+    TupleSpec input = makeSpec("input", {"key"});
+    TupleSpec key = makeSpec("input", {"key"});
+    TupleSpec withIsEven = makeSpec("even", {"key", "isEven"});
+    TupleSpec isEven = makeSpec("even", {"isEven"});
+    TupleSpec evenKey = makeSpec("even", {"key"});
+    TupleSpec withBlock = makeSpec("blocks", {"key", "block"});
+    TupleSpec block = makeSpec("blocks", {"block"});
+
+    // keeps the even keys
+    TupleSetPtr evenOutput = std::make_shared<TupleSet>();
+    TupleSetSetupMachinePtr evenMachine = std::make_shared<TupleSetSetupMachine>(input, key);
+    ComputeExecutorPtr evenApply = std::make_shared<SimpleComputeExecutor>(
+        evenOutput,
+        [=](TupleSetPtr input) {
+            evenMachine->setup(input, evenOutput);
+            std::vector<int>& keys = input->getColumn<int>(0);
+            if (!evenOutput->hasColumn(1)) {
+                evenOutput->addColumn(1, new std::vector<bool>, true);
+            }
+            std::vector<bool>& out = evenOutput->getColumn<bool>(1);
+            out.resize(keys.size());
+            for (size_t i = 0; i < keys.size(); i++) {
+                out[i] = (keys[i] % 2 == 0);
+            }
+            return evenOutput;
+        },
+        "apply",
+        false);
+    ComputeExecutorPtr evenFilter = std::make_shared<FilterExecutor>(withIsEven, isEven, evenKey);
+
+    // makes a block for each selected key, which holds the key and takes blockBytes bytes
+    TupleSetPtr blockOutput = std::make_shared<TupleSet>();
+    TupleSetSetupMachinePtr blockMachine =
+        std::make_shared<TupleSetSetupMachine>(evenKey, evenKey);
+    ComputeExecutorPtr blockApply = std::make_shared<SimpleComputeExecutor>(
+        blockOutput,
+        [=](TupleSetPtr input) {
+            blockMachine->setup(input, blockOutput);
+            std::vector<int>& keys = input->getColumn<int>(0);
+            if (!blockOutput->hasColumn(1)) {
+                blockOutput->addColumn(1, new std::vector<Handle<Vector<int>>>, true);
+            }
+            std::vector<Handle<Vector<int>>>& out = blockOutput->getColumn<Handle<Vector<int>>>(1);
+            out.resize(keys.size());
+            auto makeBlock = [&](uint32_t i) {
+                out[i] = makeObject<Vector<int>>(blockBytes / sizeof(int));
+                out[i]->push_back(keys[i]);
+            };
+            std::shared_ptr<std::vector<uint32_t>> selection = input->getSelection();
+            if (selection != nullptr) {
+                for (uint32_t i : *selection) {
+                    makeBlock(i);
+                }
+            } else {
+                for (uint32_t i = 0; i < keys.size(); i++) {
+                    makeBlock(i);
+                }
+            }
+            return blockOutput;
+        },
+        "apply",
+        true);
+
+    bool succeeded = false;
+    std::vector<int> timesWritten(numRows, 0);
+    int numPagesWritten = 0;
+    size_t numBlocksWritten = 0;
+    size_t finalChunkSize = 0;
+    std::shared_ptr<KeySource> source = std::make_shared<KeySource>(numRows, batchSize, adaptive);
+    {
+        Pipeline pipeline(
+            [&]() -> std::pair<void*, size_t> {
+                return std::make_pair(calloc(pageSize, 1), pageSize);
+            },
+            [&](void* page) { free(page); },
+            [&](void* page) {
+                Record<Vector<Handle<Vector<int>>>>* record =
+                    (Record<Vector<Handle<Vector<int>>>>*)page;
+                Handle<Vector<Handle<Vector<int>>>> blocks = record->getRootObject();
+                for (size_t i = 0; i < blocks->size(); i++) {
+                    timesWritten[(*((*blocks)[i]))[0]]++;
+                }
+                numPagesWritten++;
+                numBlocksWritten += blocks->size();
+                free(page);
+            },
+            source,
+            std::make_shared<VectorSink<Vector<int>>>(withBlock, block));
+        pipeline.id = 0;
+        pipeline.addStage(evenApply);
+        pipeline.addStage(evenFilter);
+        pipeline.addStage(blockApply);
+        succeeded = pipeline.run();
+        finalChunkSize = source->getChunkSize();
+    }
+    makeObjectAllocatorBlock(1024 * 1024, true);
+
+    // a block that doesn't fit in a page can't be written, which must fail the pipeline
+    if ((size_t)blockBytes >= pageSize) {
+        if (succeeded == true) {
+            std::cout << "blocks larger than a page are reported as written" << std::endl;
+            return 1;
+        }
+        std::cout << "blocks larger than a page: the pipeline failed" << std::endl;
+        return 0;
+    }
+
+    int numErrors = 0;
+    if (succeeded == false) {
+        std::cout << "the pipeline failed" << std::endl;
+        numErrors++;
+    }
+    for (int i = 0; i < numRows; i++) {
+        int expected = (i % 2 == 0) ? 1 : 0;
+        if (timesWritten[i] != expected) {
+            std::cout << "key " << i << " is written " << timesWritten[i] << " times"
+                      << std::endl;
+            numErrors++;
+        }
+    }
+    std::cout << (adaptive ? "chunk size fit to pages" : "fixed batch size") << ": "
+              << numPagesWritten << " pages written, "
+              << (double)numBlocksWritten * blockBytes * 100 / ((double)numPagesWritten * pageSize)
+              << "% full of blocks, final chunk size " << finalChunkSize << std::endl;
+    return numErrors;
+}
+
+int main(int argc, char* argv[]) {
+
+    int numRows = 2000;
+    size_t batchSize = 100;
+    int blockBytes = 64 * 1024;
+    size_t pageSize = 1024 * 1024;
+    if (argc > 1) {
+        numRows = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        batchSize = atoi(argv[2]);
+    }
+    if (argc > 3) {
+        blockBytes = atoi(argv[3]);
+    }
+    if (argc > 4) {
+        pageSize = (size_t)atoi(argv[4]) * 1024;
+    }
+    std::cout << "numRows=" << numRows << ", batchSize=" << batchSize
+              << ", blockBytes=" << blockBytes << ", pageSize=" << pageSize << std::endl;
+
+    makeObjectAllocatorBlock(1024 * 1024, true);
+    int numErrors = runPipeline(numRows, batchSize, blockBytes, pageSize, false);
+    numErrors += runPipeline(numRows, batchSize, blockBytes, pageSize, true);
+    numErrors += runPipeline(numRows, batchSize, 2 * pageSize, pageSize, true);
+
+    if (numErrors > 0) {
+        std::cout << "FAILED with " << numErrors << " errors" << std::endl;
+        return 1;
+    }
+    std::cout << "SUCCESS" << std::endl;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,204 @@
+#ifndef READ_AHEAD_TEST_CC
+#define READ_AHEAD_TEST_CC
+
+// Test for the read-ahead of sequential PartitionedFile scans.
+// It writes pages to a PartitionedFile, and scans the first half of them through a PageCache that
+// evicts through LocalitySets, checking that the scan hits pages loaded by the read-ahead threads
+// and reads every page unchanged. The scan then stops early, as an aborted scan does, which
+// leaves read-ahead pages that no scan pins; it checks that the eviction frees these pages and
+// keeps the pages that the scan pinned, and that the rest of the file can still be scanned.
+//
+// usage: readAheadTest [numPages] [readAheadWindow] [pageSizeInKB]
+
+#include "PageCache.h"
+#include "PageCircularBuffer.h"
+#include "PartitionedFile.h"
+#include "LocalitySet.h"
+#include "SharedMem.h"
+#include "PDBLogger.h"
+#include "PDBWorkerQueue.h"
+
+#include <vector>
+#include <string>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <iostream>
+
+#define READ_AHEAD_TEST_NUM_THREADS 2
+
+// fill the page after its header with bytes derived from its page id
+void fillPage(char* data, size_t pageSize, PageID pageId) {
+    for (size_t i = 1024; i + sizeof(unsigned int) <= pageSize; i += sizeof(unsigned int)) {
+        *((unsigned int*)(data + i)) = pageId * 1000003 + i;
+    }
+}
+
+bool checkPage(char* data, size_t pageSize, PageID pageId) {
+    for (size_t i = 1024; i + sizeof(unsigned int) <= pageSize; i += sizeof(unsigned int)) {
+        if (*((unsigned int*)(data + i)) != pageId * 1000003 + i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// wait until the read-ahead threads have loaded the pages that they can
+void waitForReadAhead(PageCache& cache) {
+    long numReadAhead = -1;
+    while (numReadAhead != cache.getStats().getNumReadAhead()) {
+        numReadAhead = cache.getStats().getNumReadAhead();
+        usleep(50000);
+    }
+}
+
+int main(int argc, char* argv[]) {
+
+    int numPages = 32;
+    unsigned int readAheadWindow = 4;
+    size_t pageSize = (size_t)(256) * (size_t)(1024);
+    if (argc > 1) {
+        numPages = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        readAheadWindow = atoi(argv[2]);
+    }
+    if (argc > 3) {
+        pageSize = (size_t)atoi(argv[3]) * (size_t)(1024);
+    }
+    std::cout << "numPages=" << numPages << ", readAheadWindow=" << readAheadWindow
+              << ", pageSize=" << pageSize << std::endl;
+
+    pdb::PDBLoggerPtr logger = make_shared<pdb::PDBLogger>("readAheadTest.log");
+    std::string metaPath = "/tmp/readAheadTest.meta";
+    std::vector<std::string> dataPaths;
+    dataPaths.push_back("/tmp/readAheadTest.data0");
+    remove(metaPath.c_str());
+    remove(dataPaths[0].c_str());
+
+    // write the pages to one partition
+    PartitionedFilePtr file =
+        make_shared<PartitionedFile>(0, 1, 1, 1, metaPath, dataPaths, logger, pageSize);
+    char* data = nullptr;
+    if (posix_memalign((void**)&data, 512, pageSize) != 0) {
+        std::cout << "can't allocate page, exit..." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < numPages; i++) {
+        memset(data, 0, pageSize);
+        PDBPagePtr page = make_shared<PDBPage>(data, 0, 1, 1, 1, i, pageSize, 0, 0, 0);
+        page->preparePage();
+        fillPage(data, pageSize, i);
+        if (file->appendPage(0, page) < 0) {
+            std::cout << "can't append page " << i << ", exit..." << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        page->setRawBytes(nullptr);
+    }
+    file->writeMeta();
+    free(data);
+    file = make_shared<PartitionedFile>(0, 1, 1, 1, metaPath, logger);
+    file->buildMetaDataFromMetaPartition(nullptr);
+    file->initializeDataFiles();
+    file->openData();
+
+    // room for all pages, so that only the test triggers eviction
+    ConfigurationPtr conf = make_shared<Configuration>();
+    conf->setShmSize((size_t)numPages * (pageSize + 1024) * 2);
+    conf->setReadAheadWindow(readAheadWindow);
+    conf->setNumReadAheadThreads(READ_AHEAD_TEST_NUM_THREADS);
+    SharedMemPtr shm = make_shared<SharedMem>(conf->getShmSize(), logger);
+    pdb::PDBWorkerQueuePtr workers =
+        make_shared<pdb::PDBWorkerQueue>(logger, READ_AHEAD_TEST_NUM_THREADS + 2);
+    PageCircularBufferPtr flushBuffer = make_shared<PageCircularBuffer>(8, logger);
+    PageCachePtr cache =
+        make_shared<PageCache>(conf, workers, flushBuffer, logger, shm, UnifiedIntelligent);
+    cache->startReadAheadThreads();
+    LocalitySetPtr set = make_shared<LocalitySet>(JobData, MRU, Read, TryCache, Persistent);
+    int numErrors = 0;
+
+    // scan the first half, giving the read-ahead threads time to load the next pages
+    int numScanned = numPages / 2;
+    CacheKey key;
+    key.dbId = 1;
+    key.typeId = 1;
+    key.setId = 1;
+    for (int i = 0; i < numScanned; i++) {
+        key.pageId = file->loadPageId(0, i);
+        PDBPagePtr page = cache->getPage(file, 0, i, key.pageId, true, set.get());
+        if ((page == nullptr) || (checkPage(page->getRawBytes(), pageSize, key.pageId) == false)) {
+            std::cout << "page " << i << " is not read back" << std::endl;
+            numErrors++;
+        }
+        cache->decPageRefCount(key);
+        waitForReadAhead(*cache);
+    }
+    CacheStats& stats = cache->getStats();
+    std::cout << "hits=" << stats.getNumHits() << ", misses=" << stats.getNumMisses()
+              << ", read-ahead=" << stats.getNumReadAhead() << std::endl;
+    if ((stats.getNumHits() == 0) || (stats.getNumReadAhead() == 0)) {
+        std::cout << "the scan doesn't hit read-ahead pages" << std::endl;
+        numErrors++;
+    }
+
+    // the scan stops, and the pages read ahead of it are not pinned by any scan
+    size_t numUnclaimed = cache->getNumUnclaimedReadAheadPages();
+    size_t numCachedAhead = 0;
+    for (int i = numScanned; i < numPages; i++) {
+        key.pageId = file->loadPageId(0, i);
+        if (cache->containsPage(key) == true) {
+            numCachedAhead++;
+        }
+    }
+    std::cout << numUnclaimed << " unclaimed read-ahead pages" << std::endl;
+    if ((numUnclaimed == 0) || (numUnclaimed > readAheadWindow) ||
+        (numUnclaimed != numCachedAhead)) {
+        std::cout << numUnclaimed << " unclaimed read-ahead pages, " << numCachedAhead
+                  << " pages cached after the scan" << std::endl;
+        numErrors++;
+    }
+
+    // they are evicted, although they belong to no LocalitySet, while the scanned pages stay
+    long numEvictedBefore = stats.getNumEvicted();
+    cache->getAndSetEvictStopSize(0, 0.0);
+    cache->evict();
+    if ((cache->getNumUnclaimedReadAheadPages() != 0) ||
+        (stats.getNumEvicted() - numEvictedBefore != (long)numUnclaimed)) {
+        std::cout << cache->getNumUnclaimedReadAheadPages()
+                  << " unclaimed read-ahead pages are left, "
+                  << stats.getNumEvicted() - numEvictedBefore << " pages are evicted" << std::endl;
+        numErrors++;
+    }
+    for (int i = 0; i < numPages; i++) {
+        key.pageId = file->loadPageId(0, i);
+        if (cache->containsPage(key) != (i < numScanned)) {
+            std::cout << "page " << i << " is " << (i < numScanned ? "evicted" : "still cached")
+                      << std::endl;
+            numErrors++;
+        }
+    }
+
+    // the rest of the file is scanned without waiting for the read-ahead threads
+    for (int i = numScanned; i < numPages; i++) {
+        key.pageId = file->loadPageId(0, i);
+        PDBPagePtr page = cache->getPage(file, 0, i, key.pageId, true, set.get());
+        if ((page == nullptr) || (checkPage(page->getRawBytes(), pageSize, key.pageId) == false)) {
+            std::cout << "page " << i << " is not read back after the eviction" << std::endl;
+            numErrors++;
+        }
+        cache->decPageRefCount(key);
+    }
+    cache->printStats();
+
+    cache->stopReadAheadThreads();
+    file->clear();
+    if (numErrors > 0) {
+        std::cout << "FAILED with " << numErrors << " errors" << std::endl;
+        return 1;
+    }
+    std::cout << "SUCCESS" << std::endl;
+    return 0;
+}
+
+#endif
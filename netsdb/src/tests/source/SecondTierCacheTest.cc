@@ -0,0 +1,183 @@
+#ifndef SECOND_TIER_CACHE_TEST_CC
+#define SECOND_TIER_CACHE_TEST_CC
+
+// Test for the second cache tier of evicted clean pages.
+// It evicts pages of two sets to a SecondTierCache with room for a few pages, and checks that a
+// page is only admitted on its second eviction, that a restored page reads back unchanged and
+// leaves the tier, that pages are replaced when the tier is full, and that the pages of a removed
+// set are dropped. It then reports the read throughput of the tier for iterative scans.
+//
+// usage: secondTierCacheTest [numSlots] [pageSizeInKB] [path]
+
+#include "SecondTierCache.h"
+#include "PDBLogger.h"
+
+#include <chrono>
+#include <vector>
+#include <string>
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+
+// fill a page with bytes derived from its key
+void fillPage(char* data, size_t pageSize, CacheKey key) {
+    for (size_t i = 0; i < pageSize; i += sizeof(unsigned int)) {
+        *((unsigned int*)(data + i)) = key.setId * 1000003 + key.pageId * 31 + i;
+    }
+}
+
+int main(int argc, char* argv[]) {
+
+    size_t numSlots = 8;
+    size_t pageSize = (size_t)(256) * (size_t)(1024);
+    std::string path = "/tmp/secondTierCacheTest.cache";
+    if (argc > 1) {
+        numSlots = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        pageSize = (size_t)atoi(argv[2]) * (size_t)(1024);
+    }
+    if (argc > 3) {
+        path = argv[3];
+    }
+    std::cout << "numSlots=" << numSlots << ", pageSize=" << pageSize << ", path=" << path
+              << std::endl;
+
+    pdb::PDBLoggerPtr logger = make_shared<pdb::PDBLogger>("secondTierCacheTest.log");
+    SecondTierCachePtr tier =
+        make_shared<SecondTierCache>(path, numSlots * pageSize, pageSize, logger);
+    if (tier->isOpen() == false) {
+        std::cout << "FAILED: can't open " << path << std::endl;
+        return 1;
+    }
+    char* page = (char*)malloc(pageSize);
+    char* expected = (char*)malloc(pageSize);
+    int numErrors = 0;
+    CacheKey key;
+    key.dbId = 1;
+    key.typeId = 1;
+    key.setId = 1;
+
+    // the first eviction of a page is only remembered, the second one admits it
+    for (int round = 0; round < 2; round++) {
+        for (size_t i = 0; i < numSlots; i++) {
+            key.pageId = i;
+            fillPage(page, pageSize, key);
+            bool admitted = tier->admit(key, page, pageSize);
+            if (admitted != (round == 1)) {
+                std::cout << "page " << i << " admitted=" << admitted << " in round " << round
+                          << std::endl;
+                numErrors++;
+            }
+        }
+    }
+    if (tier->getNumPages() != numSlots) {
+        std::cout << "tier holds " << tier->getNumPages() << " pages" << std::endl;
+        numErrors++;
+    }
+
+    // a restored page is unchanged, and leaves the tier
+    key.pageId = 0;
+    fillPage(expected, pageSize, key);
+    memset(page, 0, pageSize);
+    if ((tier->restore(key, page, pageSize) == false) ||
+        (memcmp(page, expected, pageSize) != 0)) {
+        std::cout << "page 0 is not restored" << std::endl;
+        numErrors++;
+    }
+    if ((tier->contains(key) == true) || (tier->restore(key, page, pageSize) == true)) {
+        std::cout << "page 0 is still in the tier after it is restored" << std::endl;
+        numErrors++;
+    }
+    // a restored page is admitted on its next eviction
+    fillPage(page, pageSize, key);
+    if (tier->admit(key, page, pageSize) == false) {
+        std::cout << "restored page 0 is not admitted again" << std::endl;
+        numErrors++;
+    }
+
+    // pages of another set replace the pages in the tier
+    key.setId = 2;
+    for (int round = 0; round < 2; round++) {
+        for (size_t i = 0; i < numSlots / 2; i++) {
+            key.pageId = i;
+            fillPage(page, pageSize, key);
+            tier->admit(key, page, pageSize);
+        }
+    }
+    if (tier->getNumPages() != numSlots) {
+        std::cout << "tier holds " << tier->getNumPages() << " pages after replacement"
+                  << std::endl;
+        numErrors++;
+    }
+    size_t numFirstSetPages = 0;
+    key.setId = 1;
+    for (size_t i = 0; i < numSlots; i++) {
+        key.pageId = i;
+        if (tier->contains(key) == true) {
+            numFirstSetPages++;
+        }
+    }
+    if (numFirstSetPages != numSlots - numSlots / 2) {
+        std::cout << numFirstSetPages << " pages of set 1 are left" << std::endl;
+        numErrors++;
+    }
+
+    // removing set 2 drops its pages, and the remaining pages of set 1 are unchanged
+    tier->invalidateSet(1, 1, 2);
+    if (tier->getNumPages() != numFirstSetPages) {
+        std::cout << "tier holds " << tier->getNumPages() << " pages after invalidation"
+                  << std::endl;
+        numErrors++;
+    }
+    key.setId = 1;
+    for (size_t i = 0; i < numSlots; i++) {
+        key.pageId = i;
+        if (tier->contains(key) == false) {
+            continue;
+        }
+        fillPage(expected, pageSize, key);
+        if ((tier->restore(key, page, pageSize) == false) ||
+            (memcmp(page, expected, pageSize) != 0)) {
+            std::cout << "page " << i << " of set 1 is corrupted" << std::endl;
+            numErrors++;
+        }
+    }
+
+    // iterative scans over a working set that fits in the tier
+    int numScans = 10;
+    key.setId = 3;
+    auto begin = std::chrono::high_resolution_clock::now();
+    size_t numRestored = 0;
+    for (int scan = 0; scan < numScans; scan++) {
+        for (size_t i = 0; i < numSlots; i++) {
+            key.pageId = i;
+            if (tier->restore(key, page, pageSize) == true) {
+                numRestored++;
+            } else {
+                fillPage(page, pageSize, key);
+            }
+            tier->admit(key, page, pageSize);
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double seconds = std::chrono::duration_cast<std::chrono::duration<double>>(end - begin).count();
+    std::cout << numRestored << " of " << numScans * numSlots << " pages restored, "
+              << (double)numScans * numSlots * pageSize / seconds / 1024 / 1024
+              << " MB/sec restored and admitted" << std::endl;
+    if (numRestored != (numScans - 2) * numSlots) {
+        numErrors++;
+    }
+
+    free(page);
+    free(expected);
+    tier = nullptr;
+    if (numErrors > 0) {
+        std::cout << "FAILED with " << numErrors << " errors" << std::endl;
+        return 1;
+    }
+    std::cout << "SUCCESS" << std::endl;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,161 @@
+#ifndef SHM_MAGAZINE_TEST_CC
+#define SHM_MAGAZINE_TEST_CC
+
+// Benchmark for the per-thread magazines of SharedMem.
+// It lets an increasing number of threads allocate, write, check, and free page-sized buffers
+// from shared memory, with the magazines disabled and then enabled, reporting the throughput and
+// the number of acquisitions of the pool lock. Each thread keeps a few buffers, so that buffers
+// also move between magazines. After each run it checks that all memory returns to the pool.
+// It then fills the pool with buffers, to check that the buffers cached in magazines are
+// reclaimed before an allocation fails.
+//
+// usage: shmMagazineTest [numOpsPerThread] [maxThreads] [pageSizeInKB] [useHugePages]
+
+#include "SharedMem.h"
+#include "PDBLogger.h"
+#include "Configuration.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+
+int main(int argc, char* argv[]) {
+
+    int numOpsPerThread = 100000;
+    int maxThreads = 16;
+    size_t pageSize = (size_t)(1024) * (size_t)(1024);
+    bool useHugePages = false;
+    if (argc > 1) {
+        numOpsPerThread = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        maxThreads = atoi(argv[2]);
+    }
+    if (argc > 3) {
+        pageSize = (size_t)atoi(argv[3]) * (size_t)(1024);
+    }
+    if (argc > 4) {
+        useHugePages = (atoi(argv[4]) != 0);
+    }
+    std::cout << "numOpsPerThread=" << numOpsPerThread << ", maxThreads=" << maxThreads
+              << ", pageSize=" << pageSize << ", useHugePages=" << useHugePages << std::endl;
+
+    // room for 8 buffers per thread, and the magazines of all threads
+    size_t shmSize = (size_t)maxThreads * (pageSize + 512) * 8 * 2 +
+        (size_t)(64) * (size_t)(1024) * (size_t)(1024);
+    pdb::PDBLoggerPtr logger = make_shared<pdb::PDBLogger>("shmMagazineTest.log");
+    SharedMemPtr shm = make_shared<SharedMem>(shmSize, logger, useHugePages);
+    size_t baseUsedBytes = shm->getUsedBytes();
+    int numErrors = 0;
+
+    for (int useMagazines = 0; useMagazines < 2; useMagazines++) {
+        shm->setMagazineRounds(useMagazines == 1 ? DEFAULT_SHM_MAGAZINE_ROUNDS : 0);
+        std::cout << (useMagazines == 1 ? "with magazines" : "without magazines") << std::endl;
+        for (int numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+            std::atomic<long> errors(0);
+            std::vector<std::thread> threads;
+            auto begin = std::chrono::high_resolution_clock::now();
+            for (int t = 0; t < numThreads; t++) {
+                threads.push_back(std::thread([&shm, &errors, pageSize, numOpsPerThread, t]() {
+                    const int numKept = 4;
+                    std::vector<char*> kept(numKept, nullptr);
+                    for (int i = 0; i < numOpsPerThread; i++) {
+                        int offset;
+                        char* buffer = (char*)shm->mallocAlign(pageSize, 512, offset);
+                        if (buffer == nullptr) {
+                            errors++;
+                            continue;
+                        }
+                        // the first and the last bytes tell whether another thread also has it
+                        char mark = (char)(t * 31 + i);
+                        buffer[0] = mark;
+                        buffer[pageSize - 1] = mark;
+                        char*& slot = kept[i % numKept];
+                        if (slot != nullptr) {
+                            if (slot[0] != slot[pageSize - 1]) {
+                                errors++;
+                            }
+                            shm->free(slot - *((int*)(slot + 8)), pageSize + 512);
+                        }
+                        *((int*)(buffer + 8)) = offset;
+                        slot = buffer;
+                    }
+                    for (auto slot : kept) {
+                        if (slot != nullptr) {
+                            shm->free(slot - *((int*)(slot + 8)), pageSize + 512);
+                        }
+                    }
+                }));
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            double seconds =
+                std::chrono::duration_cast<std::chrono::duration<double>>(end - begin).count();
+            std::cout << "threads=" << numThreads << ": "
+                      << (double)numOpsPerThread * numThreads / seconds << " allocations/sec"
+                      << std::endl;
+            numErrors += errors;
+            shm->reclaimMagazines();
+            if ((shm->getUsedBytes() != baseUsedBytes) || (shm->getCachedBytes() != 0) ||
+                (shm->getFragmentation() != 0)) {
+                std::cout << "memory didn't return to the pool" << std::endl;
+                numErrors++;
+            }
+        }
+        shm->printStats();
+    }
+
+    // fill the pool without magazines, and then while another thread caches buffers, which must
+    // be reclaimed before an allocation fails. TLSF rounds a request up to the next size class,
+    // so a single hole of exactly one buffer, left by the reclaimed buffers, may not be reused.
+    size_t numFit[2] = {0, 0};
+    for (int useMagazines = 0; useMagazines < 2; useMagazines++) {
+        shm->setMagazineRounds(useMagazines == 1 ? DEFAULT_SHM_MAGAZINE_ROUNDS : 0);
+        if (useMagazines == 1) {
+            std::thread cacher([&shm, pageSize]() {
+                std::vector<void*> mine;
+                for (int i = 0; i < DEFAULT_SHM_MAGAZINE_ROUNDS; i++) {
+                    mine.push_back(shm->malloc(pageSize + 512));
+                }
+                for (auto buffer : mine) {
+                    shm->free(buffer, pageSize + 512);
+                }
+            });
+            cacher.join();
+        }
+        std::vector<void*> buffers;
+        void* buffer;
+        while ((buffer = shm->malloc(pageSize + 512)) != nullptr) {
+            buffers.push_back(buffer);
+        }
+        numFit[useMagazines] = buffers.size();
+        if (shm->getCachedBytes() != 0) {
+            std::cout << "allocation failed with buffers cached in magazines" << std::endl;
+            numErrors++;
+        }
+        for (auto buffer : buffers) {
+            shm->free(buffer, pageSize + 512);
+        }
+        shm->reclaimMagazines();
+    }
+    std::cout << "pool holds " << numFit[0] << " buffers without magazines, and " << numFit[1]
+              << " with magazines" << std::endl;
+    if (numFit[1] + 1 < numFit[0]) {
+        numErrors++;
+    }
+
+    if (numErrors > 0) {
+        std::cout << "FAILED with " << numErrors << " errors" << std::endl;
+        return 1;
+    }
+    std::cout << "SUCCESS" << std::endl;
+    return 0;
+}
+
+#endif
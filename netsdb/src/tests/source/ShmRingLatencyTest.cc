@@ -0,0 +1,230 @@
+#ifndef SHM_RING_LATENCY_TEST_CC
+#define SHM_RING_LATENCY_TEST_CC
+
+// Benchmark for the round-trip latency of pins and unpins from the backend.
+// Like the server, it creates the shared memory, forks a backend process, and runs frontend
+// threads that serve the commands of the backend both through local sockets, one per backend
+// thread as DataProxy uses, and through the shared-memory command ring. The backend threads then
+// send pin/unpin pairs through each path, check every response, and report the mean round-trip
+// latency. The socket path only writes and reads the raw command, so it is a lower bound of the
+// cost of the PDBCommunicator path, which also serializes an object per message.
+//
+// usage: shmRingLatencyTest [numOpsPerThread] [numThreads] [numPollers]
+
+#include "SharedMem.h"
+#include "SharedMemRing.h"
+#include "PDBLogger.h"
+#include "Configuration.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <iostream>
+
+// the frontend's answer to a command, which the backend can check
+void runCommand(ShmCommand& command) {
+    if (command.type == ShmPinPage) {
+        command.resultPageId = command.pageId;
+        command.pageSize = 4096;
+        command.sharedMemOffset = (size_t)command.pageId * 4096 + command.setId;
+        command.success = true;
+    } else {
+        command.success = (command.wasDirty == (command.pageId % 2 == 0));
+    }
+}
+
+bool readFully(int fd, void* buffer, size_t size) {
+    size_t done = 0;
+    while (done < size) {
+        ssize_t n = read(fd, (char*)buffer + done, size - done);
+        if (n <= 0) {
+            return false;
+        }
+        done += n;
+    }
+    return true;
+}
+
+bool writeFully(int fd, void* buffer, size_t size) {
+    size_t done = 0;
+    while (done < size) {
+        ssize_t n = write(fd, (char*)buffer + done, size - done);
+        if (n <= 0) {
+            return false;
+        }
+        done += n;
+    }
+    return true;
+}
+
+// pin and unpin pages through the ring, or through the socket if fd is not negative;
+// returns the number of wrong responses
+long pinAndUnpin(SharedMemRingPtr ring, int fd, SetID setId, int numOps) {
+    long numErrors = 0;
+    for (int i = 0; i < numOps; i++) {
+        ShmCommand command;
+        command.type = (i % 2 == 0) ? ShmPinPage : ShmUnpinPage;
+        command.dbId = 1;
+        command.typeId = 1;
+        command.setId = setId;
+        command.pageId = i;
+        command.wasNewPage = false;
+        command.wasDirty = (i % 2 == 0);
+        command.success = false;
+        if (fd >= 0) {
+            if ((writeFully(fd, &command, sizeof(ShmCommand)) == false) ||
+                (readFully(fd, &command, sizeof(ShmCommand)) == false)) {
+                return numOps;
+            }
+        } else {
+            while (ring->submit(command) == false) {
+                sched_yield();
+            }
+        }
+        if ((command.success == false) ||
+            ((command.type == ShmPinPage) &&
+             (command.sharedMemOffset != (size_t)i * 4096 + setId))) {
+            numErrors++;
+        }
+    }
+    return numErrors;
+}
+
+// runs in the backend process, returns the exit status
+int runBackend(SharedMemRingPtr ring, std::vector<int>& fds, int numOpsPerThread) {
+    int numThreads = fds.size();
+    long numErrors = 0;
+    for (int useRing = 0; useRing < 2; useRing++) {
+        std::vector<std::thread> threads;
+        std::atomic<long> errors(0);
+        auto begin = std::chrono::high_resolution_clock::now();
+        for (int t = 0; t < numThreads; t++) {
+            int fd = (useRing == 1) ? -1 : fds[t];
+            threads.push_back(std::thread([ring, fd, t, numOpsPerThread, &errors]() {
+                errors += pinAndUnpin(ring, fd, t, numOpsPerThread);
+            }));
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        double seconds = std::chrono::duration_cast<std::chrono::duration<double>>(end - begin).count();
+        double numOps = (double)numOpsPerThread * (double)numThreads;
+        std::cout << ((useRing == 1) ? "ring" : "socket") << ": "
+                  << seconds * 1e9 * numThreads / numOps << " ns per round trip, "
+                  << numOps / seconds << " ops/sec" << std::endl;
+        numErrors += errors;
+    }
+    if (numErrors > 0) {
+        std::cout << "backend got " << numErrors << " wrong responses" << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+
+    int numOpsPerThread = 100000;
+    int numThreads = 4;
+    int numPollers = DEFAULT_NUM_SHM_RING_POLLERS;
+    if (argc > 1) {
+        numOpsPerThread = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        numThreads = atoi(argv[2]);
+    }
+    if (argc > 3) {
+        numPollers = atoi(argv[3]);
+    }
+    std::cout << "numOpsPerThread=" << numOpsPerThread << ", numThreads=" << numThreads
+              << ", numPollers=" << numPollers << std::endl;
+
+    pdb::PDBLoggerPtr logger = make_shared<pdb::PDBLogger>("shmRingLatencyTest.log");
+    SharedMemPtr shm = make_shared<SharedMem>((size_t)(64) * (size_t)(1024) * (size_t)(1024), logger);
+    SharedMemRingPtr ring = shm->getCommandRing();
+    if (ring == nullptr) {
+        std::cout << "FAILED: no command ring in shared memory" << std::endl;
+        return 1;
+    }
+    ShmCommand probe;
+    probe.type = ShmUnpinPage;
+    if (ring->submit(probe) == true) {
+        std::cout << "FAILED: submitted a command to a ring that is not serviced" << std::endl;
+        return 1;
+    }
+    ring->setServiced(true);
+
+    std::vector<int> frontendFds;
+    std::vector<int> backendFds;
+    for (int t = 0; t < numThreads; t++) {
+        int fds[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0) {
+            std::cout << "can't create socket pair, exit..." << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        frontendFds.push_back(fds[0]);
+        backendFds.push_back(fds[1]);
+    }
+
+    pid_t child_pid = fork();
+    if (child_pid == 0) {
+        // I'm the backend
+        for (int fd : frontendFds) {
+            close(fd);
+        }
+        int status = runBackend(ring, backendFds, numOpsPerThread);
+        for (int fd : backendFds) {
+            close(fd);
+        }
+        _exit(status);
+    } else if (child_pid == -1) {
+        std::cout << "fork failed, exit..." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    // I'm the frontend: one thread per socket, and the ring pollers
+    for (int fd : backendFds) {
+        close(fd);
+    }
+    std::vector<std::thread> threads;
+    for (int fd : frontendFds) {
+        threads.push_back(std::thread([fd]() {
+            ShmCommand command;
+            while (readFully(fd, &command, sizeof(ShmCommand)) == true) {
+                runCommand(command);
+                if (writeFully(fd, &command, sizeof(ShmCommand)) == false) {
+                    break;
+                }
+            }
+            close(fd);
+        }));
+    }
+    for (int p = 0; p < numPollers; p++) {
+        threads.push_back(std::thread([ring]() {
+            while (ring->isServiced() == true) {
+                if (ring->poll(runCommand) == false) {
+                    sched_yield();
+                }
+            }
+        }));
+    }
+    int status;
+    waitpid(child_pid, &status, 0);
+    ring->setServiced(false);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    if ((WIFEXITED(status) == false) || (WEXITSTATUS(status) != 0)) {
+        std::cout << "FAILED" << std::endl;
+        return 1;
+    }
+    std::cout << "SUCCESS" << std::endl;
+    return 0;
+}
+
+#endif
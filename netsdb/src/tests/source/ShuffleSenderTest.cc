@@ -0,0 +1,382 @@
+#ifndef SHUFFLE_SENDER_TEST_CC
+#define SHUFFLE_SENDER_TEST_CC
+
+// Test for the sender of shuffle data.
+// It starts a small server in this process, which handles the StorageAddObjectInLoop and
+// StorageAddData requests of a connection as the storage server does: it acknowledges each page
+// right after receiving it. The test sends pages of different sizes with a sender of each kind,
+// with a window and without (synchronously), to a fast server and to a slow one, and checks that
+// all pages arrive in order and unchanged, that the slow server makes the sink wait for send
+// buffers instead of queueing all pages, and that an error of the server is returned by finish().
+// The pages are sent with each codec, and with the codec that the sender chooses, and the server
+// decompresses each page with the codec that its request tells. At last, senders that share a
+// pool of send buffers that is smaller than their windows send all pages within its memory.
+//
+// usage: shuffleSenderTest [numPages] [windowSize]
+
+#include "PDBCommunicator.h"
+#include "PDBLogger.h"
+#include "GenericWork.h"
+#include "PDBWorkerQueue.h"
+#include "ShuffleSender.h"
+#include "SimpleRequestResult.h"
+#include "StorageAddData.h"
+#include "StorageAddObjectInLoop.h"
+#include "StreamCodecSelector.h"
+#include "InterfaceFunctions.h"
+#include "UseTemporaryAllocationBlock.h"
+
+#include <arpa/inet.h>
+#include <signal.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace pdb;
+
+// the workers of the server, of the sink and of the senders; the objects are made with the
+// allocator of a worker, as each worker has its own
+PDBWorkerQueuePtr workers;
+
+// the pages that the server received on the last connection, in the order that they arrived
+std::vector<std::string> receivedPages;
+
+// whether the server gets a loop of StorageAddObjectInLoop requests or StorageAddData requests,
+// the number of microseconds that it waits after each page, and whether it fails to store the pages
+std::atomic<bool> serverInLoop(true);
+std::atomic<int> serverDelay(0);
+std::atomic<bool> serverFails(false);
+
+std::atomic<int> numServing(0);
+
+// handles the requests of one connection until the client closes it
+void serveConnection(PDBCommunicatorPtr connection) {
+    const UseTemporaryAllocationBlock block(4 * 1024 * 1024);
+    std::vector<std::string> pages;
+    bool loopEnded = false;
+    while (!loopEnded) {
+        size_t objectSize = connection->getSizeOfNextObject();
+        if (objectSize == 0) {
+            break;
+        }
+        bool success;
+        std::string errMsg;
+        std::vector<char> requestBytes(objectSize);
+        PageCompressionType codec = NoPageCompression;
+        size_t uncompressedSize = 0;
+        if (serverInLoop) {
+            Handle<StorageAddObjectInLoop> request =
+                connection->getNextObject<StorageAddObjectInLoop>(
+                    requestBytes.data(), success, errMsg);
+            loopEnded = success && request->isLoopEnded();
+            if (success) {
+                codec = request->getCompressionType();
+                uncompressedSize = request->getUncompressedSize();
+            }
+        } else {
+            Handle<StorageAddData> request =
+                connection->getNextObject<StorageAddData>(requestBytes.data(), success, errMsg);
+            if (success) {
+                codec = request->getCompressionType();
+                uncompressedSize = request->getUncompressedSize();
+            }
+        }
+        if (!success) {
+            break;
+        }
+        if (!loopEnded) {
+            size_t numBytes = connection->getSizeOfNextObject();
+            std::string bytes(numBytes, '\0');
+            if (!connection->receiveBytes(&bytes[0], errMsg)) {
+                break;
+            }
+            size_t size = StreamCodecSelector::getUncompressedLength(
+                codec, bytes.data(), bytes.size(), uncompressedSize);
+            std::string page(size == (size_t)(-1) ? 0 : size, '\0');
+            if ((size == (size_t)(-1)) ||
+                (StreamCodecSelector::decompress(
+                     codec, bytes.data(), bytes.size(), &page[0], page.size()) != size)) {
+                page = "can't decompress";
+            }
+            pages.push_back(page);
+        }
+        Handle<SimpleRequestResult> response = makeObject<SimpleRequestResult>(
+            !serverFails, serverFails ? "can't store the page" : "");
+        if (!connection->sendObject(response, errMsg)) {
+            break;
+        }
+        if (serverDelay > 0) {
+            usleep(serverDelay);
+        }
+    }
+    receivedPages = pages;
+    close(connection->getSocketFD());
+    numServing--;
+}
+
+// accepts connections and serves each of them with its own worker
+void serve(int listenFD) {
+    PDBLoggerPtr logger = std::make_shared<PDBLogger>("shuffleSenderTestServer.log");
+    PDBBuzzerPtr noBuzzer = std::make_shared<PDBBuzzer>(nullptr);
+    while (true) {
+        PDBCommunicatorPtr connection = std::make_shared<PDBCommunicator>();
+        std::string errMsg;
+        if (connection->pointToInternet(logger, listenFD, errMsg)) {
+            break;
+        }
+        numServing++;
+        PDBWorkPtr work = std::make_shared<GenericWork>(
+            [connection](PDBBuzzerPtr callerBuzzer) { serveConnection(connection); });
+        workers->getWorker()->execute(work, noBuzzer);
+    }
+}
+
+// the codec spec of the senders
+std::string senderCodec = "auto";
+
+// the i-th page that is sent; the pages have different sizes and contents
+std::string makePage(int i) {
+    std::string page(1024 + (i * 7919) % (64 * 1024), '\0');
+    for (size_t j = 0; j < page.size(); j++) {
+        page[j] = (char)((i + j / 16) % 251);
+    }
+    return page;
+}
+
+// sends numPages pages from a worker with a sender, and waits for all of them; returns the
+// number of errors
+int runSender(PDBLoggerPtr logger,
+              int port,
+              int numPages,
+              bool inLoop,
+              int windowSize,
+              bool expectWait,
+              bool expectFailure) {
+    std::cout << "inLoop=" << inLoop << ", windowSize=" << windowSize
+              << ", serverDelay=" << serverDelay << ", serverFails=" << serverFails
+              << ", codec=" << senderCodec << std::endl;
+    serverInLoop = inLoop;
+    int numErrors = 0;
+    atomic_int counter;
+    counter = 0;
+    PDBBuzzerPtr buzzer =
+        std::make_shared<PDBBuzzer>([&](PDBAlarm myAlarm, atomic_int& counter) { counter++; });
+    PDBWorkPtr work = std::make_shared<GenericWork>([&](PDBBuzzerPtr callerBuzzer) {
+        ShuffleSenderPtr sender = std::make_shared<ShuffleSender>(
+            logger, "localhost", port, "testDB", "testSet", inLoop, windowSize, senderCodec);
+        if (windowSize > 0) {
+            sender->start(workers->getWorker());
+        }
+        bool success = true;
+        for (int i = 0; i < numPages; i++) {
+            // the page is freed right after it is given to the sender
+            std::string page = makePage(i);
+            success = sender->send(&page[0], page.size()) && success;
+        }
+        std::string errMsg;
+        success = sender->finish(errMsg) && success;
+        if (success == expectFailure) {
+            std::cout << "the sender returned " << success << ": " << errMsg << std::endl;
+            numErrors++;
+        }
+        if (!expectFailure && (sender->getNumPagesSent() != (size_t)numPages)) {
+            std::cout << "sent " << sender->getNumPagesSent() << " pages" << std::endl;
+            numErrors++;
+        }
+        // the sink waits for send buffers when the node is slower than the sink
+        if (expectWait && (sender->getSecondsWaited() < 0.01)) {
+            std::cout << "the sink waited " << sender->getSecondsWaited() << " seconds" << std::endl;
+            numErrors++;
+        }
+        callerBuzzer->buzz(PDBAlarm::WorkAllDone, counter);
+    });
+    workers->getWorker()->execute(work, buzzer);
+    while (counter < 1) {
+        buzzer->wait();
+    }
+    while (numServing > 0) {
+        usleep(1000);
+    }
+    if (expectFailure) {
+        return numErrors;
+    }
+    if (receivedPages.size() != (size_t)numPages) {
+        std::cout << "received " << receivedPages.size() << " of " << numPages << " pages"
+                  << std::endl;
+        return numErrors + 1;
+    }
+    for (int i = 0; i < numPages; i++) {
+        if (receivedPages[i] != makePage(i)) {
+            std::cout << "the " << i << "-th page is wrong" << std::endl;
+            return numErrors + 1;
+        }
+    }
+    return numErrors;
+}
+
+// sends numPages pages with each of numSenders senders of a slow node, which share a pool that
+// is too small for all their windows, and checks that they stay within the memory of the pool;
+// returns the number of errors
+int runSharedPool(PDBLoggerPtr logger, int port, int numPages, int numSenders, int windowSize) {
+    size_t maxPageSize = makePage(0).size();
+    for (int i = 0; i < numPages; i++) {
+        maxPageSize = std::max(maxPageSize, makePage(i).size());
+    }
+    size_t maxBytes = 2 * StreamCodecSelector("none").getMaxCompressedLength(maxPageSize);
+    std::cout << "numSenders=" << numSenders << ", windowSize=" << windowSize
+              << ", maxBytes=" << maxBytes << std::endl;
+    serverInLoop = true;
+    serverDelay = 1000;
+    int numErrors = 0;
+    atomic_int counter;
+    counter = 0;
+    PDBBuzzerPtr buzzer =
+        std::make_shared<PDBBuzzer>([&](PDBAlarm myAlarm, atomic_int& counter) { counter++; });
+    PDBWorkPtr work = std::make_shared<GenericWork>([&](PDBBuzzerPtr callerBuzzer) {
+        ShuffleSendBufferPoolPtr pool = std::make_shared<ShuffleSendBufferPool>(maxBytes);
+        std::vector<ShuffleSenderPtr> senders;
+        for (int j = 0; j < numSenders; j++) {
+            senders.push_back(std::make_shared<ShuffleSender>(
+                logger, "localhost", port, "testDB", "testSet", true, windowSize, "none", pool));
+            senders[j]->start(workers->getWorker());
+        }
+        bool success = true;
+        for (int i = 0; i < numPages; i++) {
+            for (ShuffleSenderPtr sender : senders) {
+                std::string page = makePage(i);
+                success = sender->send(&page[0], page.size()) && success;
+            }
+        }
+        for (ShuffleSenderPtr sender : senders) {
+            std::string errMsg;
+            success = sender->finish(errMsg) && success;
+            if (sender->getNumPagesSent() != (size_t)numPages) {
+                std::cout << "sent " << sender->getNumPagesSent() << " pages" << std::endl;
+                numErrors++;
+            }
+        }
+        if (!success) {
+            std::cout << "the senders of a shared pool failed" << std::endl;
+            numErrors++;
+        }
+        if ((pool->getPeakBytes() > maxBytes) || (pool->getPeakBytes() == 0)) {
+            std::cout << "the send buffers took " << pool->getPeakBytes() << " bytes" << std::endl;
+            numErrors++;
+        }
+        callerBuzzer->buzz(PDBAlarm::WorkAllDone, counter);
+    });
+    workers->getWorker()->execute(work, buzzer);
+    while (counter < 1) {
+        buzzer->wait();
+    }
+    while (numServing > 0) {
+        usleep(1000);
+    }
+    serverDelay = 0;
+    return numErrors;
+}
+
+int main(int argc, char* argv[]) {
+
+    int numPages = 200;
+    int windowSize = 4;
+    if (argc > 1) {
+        numPages = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        windowSize = atoi(argv[2]);
+    }
+    std::cout << "numPages=" << numPages << ", windowSize=" << windowSize << std::endl;
+
+    makeObjectAllocatorBlock((size_t)64 * 1024 * 1024, true);
+    int numErrors = 0;
+
+    // the server acknowledges the pages that were sent before an error, after the sender has
+    // closed the connection, as the servers do, which ignore SIGPIPE
+    signal(SIGPIPE, SIG_IGN);
+
+    // start the server on a free port
+    int listenFD = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in serverAddress;
+    bzero((char*)&serverAddress, sizeof(serverAddress));
+    serverAddress.sin_family = AF_INET;
+    serverAddress.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    serverAddress.sin_port = 0;
+    socklen_t addressLength = sizeof(serverAddress);
+    if (bind(listenFD, (struct sockaddr*)&serverAddress, sizeof(serverAddress)) < 0 ||
+        listen(listenFD, 100) < 0 ||
+        getsockname(listenFD, (struct sockaddr*)&serverAddress, &addressLength) < 0) {
+        std::cout << "FAILED to start the server" << std::endl;
+        return 1;
+    }
+    int port = ntohs(serverAddress.sin_port);
+
+    PDBLoggerPtr logger = std::make_shared<PDBLogger>("shuffleSenderTest.log");
+    workers = std::make_shared<PDBWorkerQueue>(logger, 8);
+    atomic_int serverCounter;
+    serverCounter = 0;
+    PDBBuzzerPtr serverBuzzer = std::make_shared<PDBBuzzer>(
+        [&](PDBAlarm myAlarm, atomic_int& counter) { counter++; });
+    workers->getWorker()->execute(
+        std::make_shared<GenericWork>([&](PDBBuzzerPtr callerBuzzer) {
+            serve(listenFD);
+            callerBuzzer->buzz(PDBAlarm::WorkAllDone, serverCounter);
+        }),
+        serverBuzzer);
+
+    // pages of a loop, and compressed pages of objects, with a window and synchronously
+    for (bool inLoop : {true, false}) {
+        numErrors += runSender(logger, port, numPages, inLoop, windowSize, false, false);
+        numErrors += runSender(logger, port, numPages, inLoop, 0, false, false);
+    }
+
+    // the pages of each codec that is compiled in, and of an unknown codec, which is snappy
+    for (std::string codec : {"none", "snappy", "lz4", "zstd:3", "unknown"}) {
+        senderCodec = codec;
+        for (bool inLoop : {true, false}) {
+            numErrors += runSender(logger, port, numPages / 4, inLoop, windowSize, false, false);
+        }
+    }
+    senderCodec = "auto";
+
+    // a slow node makes the sink wait for the send buffers, and still gets all pages in order
+    serverDelay = 2000;
+    numErrors += runSender(logger, port, numPages / 4, true, windowSize, windowSize > 0, false);
+    serverDelay = 0;
+
+    // the senders of a stage share the memory of their send buffers
+    if (windowSize > 0) {
+        numErrors += runSharedPool(logger, port, numPages / 4, 2, windowSize);
+    }
+
+    // no page is sent at all, but the loop is ended
+    numErrors += runSender(logger, port, 0, true, windowSize, false, false);
+
+    // a node that can't store the pages makes finish() fail
+    serverFails = true;
+    numErrors += runSender(logger, port, 10, true, windowSize, false, true);
+    numErrors += runSender(logger, port, 10, false, 0, false, true);
+    serverFails = false;
+
+    // the server finishes before the workers are destroyed
+    shutdown(listenFD, SHUT_RDWR);
+    while (serverCounter < 1) {
+        serverBuzzer->wait();
+    }
+    close(listenFD);
+
+    if (numErrors > 0) {
+        std::cout << "FAILED with " << numErrors << " errors" << std::endl;
+        return 1;
+    }
+    std::cout << "SUCCESS" << std::endl;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,256 @@
+#ifndef SPILLABLE_AGGREGATION_TEST_CC
+#define SPILLABLE_AGGREGATION_TEST_CC
+
+// Test for the spilling of hash aggregations.
+// It aggregates the shuffled maps of numInputs pages, which each have a count of one for every
+// key, into an aggregation page that is too small for all keys, so that the aggregation used to
+// stop with results that are not fully aggregated. The partial aggregates that don't fit are
+// spilled to spill pages in numSpillPartitions spill partitions, and the spill partitions are
+// merged one by one from their own pages, as the aggregation job stage does; a spill partition
+// that still doesn't fit is spilled again at the next level. It checks that each spilled page
+// holds one spill partition, that each key is written out exactly once with a count of numInputs,
+// and reports the number of spilled pages and of levels. At last, it checks that an aggregation
+// that can't get spill pages fails instead of exiting.
+//
+// usage: spillableAggregationTest [numKeys] [numInputs] [aggregationPageSizeInKB]
+//                                 [numSpillPartitions] [spillPageSizeInKB]
+
+#include "DataTypes.h"
+#include "AggregationProcessor.h"
+#include "AggregationMap.h"
+#include "InterfaceFunctions.h"
+#include "UseTemporaryAllocationBlock.h"
+
+#include <deque>
+#include <vector>
+#include <string>
+#include <stdlib.h>
+#include <iostream>
+
+using namespace pdb;
+
+int main(int argc, char* argv[]) {
+
+    int numKeys = 100000;
+    int numInputs = 3;
+    size_t aggregationPageSize = 256 * 1024;
+    int numSpillPartitions = 4;
+    size_t spillPageSize = 256 * 1024;
+    if (argc > 1) {
+        numKeys = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        numInputs = atoi(argv[2]);
+    }
+    if (argc > 3) {
+        aggregationPageSize = (size_t)atoi(argv[3]) * 1024;
+    }
+    if (argc > 4) {
+        numSpillPartitions = atoi(argv[4]);
+    }
+    if (argc > 5) {
+        spillPageSize = (size_t)atoi(argv[5]) * 1024;
+    }
+    std::cout << "numKeys=" << numKeys << ", numInputs=" << numInputs
+              << ", aggregationPageSize=" << aggregationPageSize
+              << ", numSpillPartitions=" << numSpillPartitions
+              << ", spillPageSize=" << spillPageSize << std::endl;
+
+    makeObjectAllocatorBlock((size_t)256 * 1024 * 1024, true);
+
+    // the shuffled maps, as the pages of a shuffled set hold them: one map for each partition,
+    // and only partition 0 is aggregated here
+    std::vector<Handle<Vector<Handle<AggregationMap<int, int>>>>> inputs;
+    for (int i = 0; i < numInputs; i++) {
+        Handle<Vector<Handle<AggregationMap<int, int>>>> shuffled =
+            makeObject<Vector<Handle<AggregationMap<int, int>>>>();
+        for (int partition = 0; partition < 2; partition++) {
+            Handle<AggregationMap<int, int>> map = makeObject<AggregationMap<int, int>>();
+            map->setHashPartitionId(partition);
+            for (int key = 0; key < numKeys; key++) {
+                (*map)[key] = (partition == 0) ? 1 : -1;
+            }
+            shuffled->push_back(map);
+        }
+        inputs.push_back(shuffled);
+    }
+
+    int numErrors = 0;
+
+    // the pages that the current spill wrote, by spill partition
+    std::vector<std::vector<void*>> spilledPages(numSpillPartitions);
+    int numWrittenBack = 0;
+    AggregationProcessor<int, int> processor(0);
+    processor.initialize();
+    processor.setSpillPages(
+        [&]() -> std::pair<void*, size_t> {
+            return std::make_pair(calloc(spillPageSize, 1), spillPageSize);
+        },
+        [&](void* page, int spillPartition) {
+            Handle<AggregationMap<int, int>> spillMap =
+                ((Record<AggregationMap<int, int>>*)page)->getRootObject();
+            if ((int)spillMap->getHashPartitionId() != spillPartition) {
+                std::cout << "a page of spill partition " << spillPartition
+                          << " holds the map of spill partition " << spillMap->getHashPartitionId()
+                          << std::endl;
+                numErrors++;
+            }
+            spillMap = nullptr;
+            spilledPages[spillPartition].push_back(page);
+            numWrittenBack++;
+        },
+        numSpillPartitions);
+
+    std::vector<int> counts(numKeys, 0);
+    std::vector<int> timesWritten(numKeys, 0);
+    int numOutputPages = 0;
+
+    // writes out the keys in the aggregation page
+    void* aggregationPage = calloc(aggregationPageSize, 1);
+    auto writeOut = [&]() {
+        processor.finalize();
+        processor.fillNextOutputPage();
+        Handle<Map<int, int>> output = ((Record<Map<int, int>>*)aggregationPage)->getRootObject();
+        for (auto iter = output->begin(); iter != output->end(); ++iter) {
+            int key = (*iter).key;
+            if ((key < 0) || (key >= numKeys)) {
+                std::cout << "key " << key << " is written out" << std::endl;
+                numErrors++;
+                continue;
+            }
+            counts[key] += (*iter).value;
+            timesWritten[key]++;
+        }
+        output = nullptr;
+        processor.clearOutputPage();
+        numOutputPages++;
+    };
+
+    // aggregate the inputs
+    processor.loadOutputPage(aggregationPage, aggregationPageSize);
+    for (auto& shuffled : inputs) {
+        for (size_t j = 0; j < shuffled->size(); j++) {
+            Handle<Object> input = unsafeCast<Object>((*shuffled)[j]);
+            processor.loadInputObject(input);
+            if (processor.needsProcessInput() == false) {
+                continue;
+            }
+            if (processor.fillNextOutputPage()) {
+                std::cout << "the aggregation page is full, though it can spill" << std::endl;
+                numErrors++;
+            }
+        }
+    }
+
+    // merge the spill partitions one by one
+    int maxLevel = 0;
+    if (processor.getNumSpilledPages() == 0) {
+        writeOut();
+    } else {
+        processor.spillOutputPage();
+        processor.clearOutputPage();
+        // each spill partition of the last spill is a run
+        std::deque<std::pair<int, std::vector<void*>>> runs;
+        auto addRuns = [&](int level) {
+            for (std::vector<void*>& pages : spilledPages) {
+                if (pages.size() > 0) {
+                    runs.push_back(std::make_pair(level, pages));
+                    pages.clear();
+                }
+            }
+        };
+        addRuns(0);
+        while (runs.size() > 0) {
+            std::pair<int, std::vector<void*>> run = runs.front();
+            runs.pop_front();
+            if (run.first > maxLevel) {
+                maxLevel = run.first;
+            }
+            processor.setSpillLevel(run.first + 1);
+            processor.initialize();
+            processor.loadOutputPage(aggregationPage, aggregationPageSize);
+            int numSpilledPagesBefore = processor.getNumSpilledPages();
+            for (void* page : run.second) {
+                processor.loadSpilledInput(page);
+                if (processor.fillNextOutputPage()) {
+                    std::cout << "the aggregation page is full, though it can spill" << std::endl;
+                    numErrors++;
+                }
+                processor.clearInputPage();
+            }
+            if (processor.getNumSpilledPages() > numSpilledPagesBefore) {
+                processor.spillOutputPage();
+                processor.clearOutputPage();
+                addRuns(run.first + 1);
+            } else {
+                writeOut();
+            }
+            for (void* page : run.second) {
+                free(page);
+            }
+        }
+    }
+    std::cout << processor.getNumSpilledPages() << " pages spilled in " << maxLevel + 1
+              << " levels, " << numOutputPages << " aggregation pages written out" << std::endl;
+
+    if (numWrittenBack != processor.getNumSpilledPages()) {
+        std::cout << numWrittenBack << " pages are written back" << std::endl;
+        numErrors++;
+    }
+    if (((size_t)numKeys * 2 * sizeof(int) > aggregationPageSize) &&
+        (processor.getNumSpilledPages() == 0)) {
+        std::cout << "the keys don't fit in the aggregation page, but nothing is spilled"
+                  << std::endl;
+        numErrors++;
+    }
+    if (processor.hasFailed()) {
+        std::cout << "the aggregation failed, though it can spill" << std::endl;
+        numErrors++;
+    }
+    if (processor.getNumHashKeys() != numKeys) {
+        std::cout << processor.getNumHashKeys() << " keys are counted" << std::endl;
+        numErrors++;
+    }
+    for (int key = 0; key < numKeys; key++) {
+        if ((timesWritten[key] != 1) || (counts[key] != numInputs)) {
+            std::cout << "key " << key << " is written out " << timesWritten[key]
+                      << " times with count " << counts[key] << std::endl;
+            numErrors++;
+        }
+    }
+
+    // an aggregation that can't get spill pages fails instead of exiting
+    if (((size_t)numKeys * 2 * sizeof(int) > aggregationPageSize) && (numSpillPartitions > 0)) {
+        AggregationProcessor<int, int> failingProcessor(0);
+        failingProcessor.initialize();
+        failingProcessor.setSpillPages(
+            []() -> std::pair<void*, size_t> { return std::make_pair(nullptr, 0); },
+            [](void* page, int spillPartition) {},
+            numSpillPartitions);
+        failingProcessor.loadOutputPage(aggregationPage, aggregationPageSize);
+        bool full = false;
+        for (size_t j = 0; (j < inputs[0]->size()) && (full == false); j++) {
+            Handle<Object> input = unsafeCast<Object>((*inputs[0])[j]);
+            failingProcessor.loadInputObject(input);
+            if (failingProcessor.needsProcessInput()) {
+                full = failingProcessor.fillNextOutputPage();
+            }
+        }
+        if ((full == false) || (failingProcessor.hasFailed() == false)) {
+            std::cout << "an aggregation without spill pages doesn't fail" << std::endl;
+            numErrors++;
+        }
+        failingProcessor.clearOutputPage();
+    }
+
+    free(aggregationPage);
+
+    if (numErrors > 0) {
+        std::cout << "FAILED with " << numErrors << " errors" << std::endl;
+        return 1;
+    }
+    std::cout << "SUCCESS" << std::endl;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,165 @@
+#ifndef STREAM_CODEC_SELECTOR_TEST_CC
+#define STREAM_CODEC_SELECTOR_TEST_CC
+
+// Test for the choice of the codec of a stream of pages.
+// It sends streams of pages of random doubles, which barely compress, and of repeated strings,
+// which compress well, through selectors with "auto" and with each codec, and checks that every
+// page is decompressed back to itself with the codec that it was compressed with, that "auto"
+// compresses the redundant pages over a slow network and sends the pages of doubles as they are
+// over a fast one, and that the metrics count the pages, the sampled pages and the bytes saved.
+//
+// usage: streamCodecSelectorTest [numPages] [pageSize]
+
+#include "StreamCodecSelector.h"
+#include "PageCompressor.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// a page of random doubles
+std::vector<char> makeDoublePage(size_t pageSize, int seed) {
+    std::vector<char> page(pageSize);
+    srand(seed);
+    for (size_t i = 0; i + sizeof(double) <= pageSize; i += sizeof(double)) {
+        double value = (double)rand() / (double)RAND_MAX * (double)rand();
+        memcpy(page.data() + i, &value, sizeof(double));
+    }
+    return page;
+}
+
+// a page of the same few strings, again and again
+std::vector<char> makeStringPage(size_t pageSize, int seed) {
+    const char* words[] = {"netsdb", "shuffle", "aaaaaaaaaaaaaaaa", "page"};
+    std::vector<char> page(pageSize, '\0');
+    size_t pos = 0;
+    for (int i = 0; pos < pageSize; i++) {
+        const char* word = words[(seed + i / 64) % 4];
+        for (size_t j = 0; (word[j] != '\0') && (pos < pageSize); j++) {
+            page[pos++] = word[j];
+        }
+    }
+    return page;
+}
+
+// sends numPages pages through a selector, and checks that each of them comes back; returns the
+// number of errors, and sets the codec that the selector chose
+int runStream(std::string spec,
+              double networkBytesPerSecond,
+              bool doubles,
+              int numPages,
+              size_t pageSize,
+              PageCompressionType& chosen) {
+    StreamCodecSelector selector(spec, networkBytesPerSecond);
+    int numErrors = 0;
+    std::vector<char> compressed;
+    std::vector<char> decompressed(pageSize);
+    for (int i = 0; i < numPages; i++) {
+        std::vector<char> page = doubles ? makeDoublePage(pageSize, i) : makeStringPage(pageSize, i);
+        compressed.resize(selector.getMaxCompressedLength(pageSize));
+        size_t compressedSize = 0;
+        PageCompressionType codec =
+            selector.compress(page.data(), pageSize, compressed.data(), compressedSize);
+        if (!PageCompressor::isAvailable(codec)) {
+            std::cout << spec << ": page " << i << " is compressed with "
+                      << PageCompressor::getName(codec) << ", which is not compiled in" << std::endl;
+            numErrors++;
+            continue;
+        }
+        // the receiver only knows the codec and the size of the page
+        size_t size = StreamCodecSelector::getUncompressedLength(
+            codec, compressed.data(), compressedSize, pageSize);
+        if ((size != pageSize) ||
+            (StreamCodecSelector::decompress(
+                 codec, compressed.data(), compressedSize, decompressed.data(), pageSize) !=
+             pageSize) ||
+            (memcmp(decompressed.data(), page.data(), pageSize) != 0)) {
+            std::cout << spec << ": page " << i << " with " << PageCompressor::getName(codec)
+                      << " is not decompressed back" << std::endl;
+            numErrors++;
+        }
+    }
+    if (!selector.isChosen() && (numPages >= CODEC_SAMPLE_PAGES)) {
+        std::cout << spec << ": no codec is chosen after " << numPages << " pages" << std::endl;
+        numErrors++;
+    }
+    chosen = selector.getCodec();
+    std::cout << spec << (doubles ? " of doubles" : " of strings") << ": "
+              << PageCompressor::getName(chosen) << std::endl;
+    return numErrors;
+}
+
+int main(int argc, char* argv[]) {
+
+    int numPages = 20;
+    size_t pageSize = 256 * 1024;
+    if (argc > 1) {
+        numPages = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        pageSize = (size_t)atol(argv[2]);
+    }
+    std::cout << "numPages=" << numPages << ", pageSize=" << pageSize << std::endl;
+    int numErrors = 0;
+
+    // the specs
+    bool isAuto;
+    PageCompressionType codec;
+    int level;
+    if (!StreamCodecSelector::parseSpec("zstd:5", isAuto, codec, level) || isAuto ||
+        (codec != ZstdPageCompression) || (level != 5) ||
+        !StreamCodecSelector::parseSpec("auto", isAuto, codec, level) || !isAuto ||
+        StreamCodecSelector::parseSpec("zstd:x", isAuto, codec, level) ||
+        StreamCodecSelector::parseSpec("gzip", isAuto, codec, level)) {
+        std::cout << "the specs are not parsed right" << std::endl;
+        numErrors++;
+    }
+
+    // every codec gives the pages back, and a codec that is not compiled in is replaced
+    PageCompressionType chosen;
+    for (std::string spec : {"none", "snappy", "lz4", "zstd", "zstd:9", "bad"}) {
+        for (bool doubles : {true, false}) {
+            numErrors += runStream(
+                spec, CODEC_NETWORK_BYTES_PER_SECOND, doubles, numPages / 4, pageSize, chosen);
+        }
+    }
+
+    // over a slow network the redundant pages are compressed
+    StreamCodecMetrics& metrics = getStreamCodecMetrics();
+    size_t sampledBefore = metrics.numSampledPages;
+    long savedBefore = metrics.getBytesSaved();
+    numErrors += runStream("auto", 1024 * 1024, false, numPages, pageSize, chosen);
+    if (chosen == NoPageCompression) {
+        std::cout << "the redundant pages are not compressed" << std::endl;
+        numErrors++;
+    }
+    if (metrics.getBytesSaved() <= savedBefore) {
+        std::cout << "no bytes are saved" << std::endl;
+        numErrors++;
+    }
+    // over a fast network the doubles are sent as they are, as the few bytes that a codec saves
+    // don't pay for its time
+    numErrors += runStream("auto", CODEC_NETWORK_BYTES_PER_SECOND, true, numPages, pageSize, chosen);
+    if (chosen != NoPageCompression) {
+        std::cout << "the doubles are compressed with " << PageCompressor::getName(chosen)
+                  << std::endl;
+        numErrors++;
+    }
+    numErrors += runStream("auto", CODEC_NETWORK_BYTES_PER_SECOND, false, numPages, pageSize, chosen);
+    if (metrics.numSampledPages - sampledBefore != (size_t)(3 * CODEC_SAMPLE_PAGES)) {
+        std::cout << "sampled " << metrics.numSampledPages - sampledBefore << " pages" << std::endl;
+        numErrors++;
+    }
+    std::cout << metrics.toString();
+
+    if (numErrors > 0) {
+        std::cout << "FAILED with " << numErrors << " errors" << std::endl;
+        return 1;
+    }
+    std::cout << "SUCCESS" << std::endl;
+    return 0;
+}
+
+#endif
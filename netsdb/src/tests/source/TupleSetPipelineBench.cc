@@ -0,0 +1,153 @@
+#ifndef TUPLE_SET_PIPELINE_BENCH_CC
+#define TUPLE_SET_PIPELINE_BENCH_CC
+
+// Microbenchmark for the per-batch overhead of TupleSets in a selection pipeline.
+// It pushes batches of a TupleSet with a key column through five executors, as Pipeline::run
+// does: an apply that computes a price, an apply that compares the price, a filter, an apply
+// that does not honor selection vectors (so that the batch is compacted), and a second filter.
+// The batch is then compacted as before a sink, and the sum of the keys that pass both filters
+// is checked. It reports the time per batch, which is dominated by the bookkeeping of the
+// columns for small batches.
+//
+// usage: tupleSetPipelineBench [numRowsPerBatch] [numBatches]
+
+#include "TupleSpec.h"
+#include "Ptr.h"
+#include "ComputeInfo.h"
+#include "TupleSet.h"
+#include "SimpleComputeExecutor.h"
+#include "FilterExecutor.h"
+
+#include <chrono>
+#include <vector>
+#include <string>
+#include <stdlib.h>
+#include <iostream>
+
+using namespace pdb;
+
+// builds a TupleSpec with the given attributes
+TupleSpec makeSpec(std::string setName, std::vector<std::string> atts) {
+    AttList attList;
+    for (auto& att : atts) {
+        attList.appendAttribute((char*)att.c_str());
+    }
+    return TupleSpec(setName, attList);
+}
+
+// builds an executor that appends a column computed from one input column, for each row, or
+// only for the selected rows if it honors selection vectors
+template <typename InType, typename OutType>
+ComputeExecutorPtr makeApply(TupleSpec& inputSchema,
+                             TupleSpec& attsToOperateOn,
+                             TupleSpec& attsToIncludeInOutput,
+                             std::function<OutType(InType)> compute,
+                             bool honorsSelection) {
+    TupleSetPtr output = std::make_shared<TupleSet>();
+    TupleSetSetupMachinePtr myMachine =
+        std::make_shared<TupleSetSetupMachine>(inputSchema, attsToIncludeInOutput);
+    int whichAtt = myMachine->match(attsToOperateOn)[0];
+    int outAtt = attsToIncludeInOutput.getAtts().size();
+    return std::make_shared<SimpleComputeExecutor>(
+        output,
+        [=](TupleSetPtr input) {
+            myMachine->setup(input, output);
+            std::vector<InType>& inColumn = input->getColumn<InType>(whichAtt);
+            if (!output->hasColumn(outAtt)) {
+                output->addColumn(outAtt, new std::vector<OutType>, true);
+            }
+            std::vector<OutType>& outColumn = output->getColumn<OutType>(outAtt);
+            int numTuples = inColumn.size();
+            outColumn.resize(numTuples);
+            std::shared_ptr<std::vector<uint32_t>> selection = input->getSelection();
+            if (selection != nullptr) {
+                for (uint32_t i : *selection) {
+                    outColumn[i] = compute(inColumn[i]);
+                }
+                return output;
+            }
+            for (int i = 0; i < numTuples; i++) {
+                outColumn[i] = compute(inColumn[i]);
+            }
+            return output;
+        },
+        "apply",
+        honorsSelection);
+}
+
+int main(int argc, char* argv[]) {
+
+    int numRows = 100;
+    int numBatches = 100000;
+    if (argc > 1) {
+        numRows = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        numBatches = atoi(argv[2]);
+    }
+    std::cout << "numRowsPerBatch=" << numRows << ", numBatches=" << numBatches << std::endl;
+
+    TupleSpec input = makeSpec("input", {"key"});
+    TupleSpec key = makeSpec("input", {"key"});
+    TupleSpec withPrice = makeSpec("priced", {"key", "price"});
+    TupleSpec price = makeSpec("priced", {"price"});
+    TupleSpec withIsCheap = makeSpec("compared", {"key", "price", "isCheap"});
+    TupleSpec isCheap = makeSpec("compared", {"isCheap"});
+    TupleSpec cheapOutput = makeSpec("compared", {"key", "price"});
+    TupleSpec cheap = makeSpec("cheap", {"key", "price"});
+    TupleSpec cheapKey = makeSpec("cheap", {"key"});
+    TupleSpec withIsOdd = makeSpec("odd", {"key", "price", "isOdd"});
+    TupleSpec isOdd = makeSpec("odd", {"isOdd"});
+    TupleSpec oddOutput = makeSpec("odd", {"key", "price"});
+
+    std::vector<ComputeExecutorPtr> pipeline;
+    pipeline.push_back(makeApply<int, double>(
+        input, key, key, [](int k) { return k * 1.5; }, true));
+    pipeline.push_back(makeApply<double, bool>(
+        withPrice, price, withPrice, [](double p) { return ((long)p) % 3 == 0; }, true));
+    pipeline.push_back(std::make_shared<FilterExecutor>(withIsCheap, isCheap, cheapOutput));
+    pipeline.push_back(makeApply<int, bool>(
+        cheap, cheapKey, cheap, [](int k) { return k % 2 == 1; }, false));
+    pipeline.push_back(std::make_shared<FilterExecutor>(withIsOdd, isOdd, oddOutput));
+
+    TupleSetPtr source = std::make_shared<TupleSet>();
+    std::vector<int>* keys = new std::vector<int>(numRows);
+    source->addColumn(0, keys, true);
+
+    long expectedSum = 0;
+    long sum = 0;
+    auto begin = std::chrono::high_resolution_clock::now();
+    for (int batch = 0; batch < numBatches; batch++) {
+        for (int i = 0; i < numRows; i++) {
+            int k = (batch * numRows + i) % 1000000;
+            (*keys)[i] = k;
+            if ((((long)(k * 1.5)) % 3 == 0) && (k % 2 == 1)) {
+                expectedSum += k;
+            }
+        }
+        TupleSetPtr curChunk = source;
+        for (ComputeExecutorPtr& q : pipeline) {
+            if (!q->honorsSelection()) {
+                curChunk->compact();
+            }
+            curChunk = q->process(curChunk);
+        }
+        curChunk->compact();
+        for (int k : curChunk->getColumn<int>(0)) {
+            sum += k;
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double seconds = std::chrono::duration_cast<std::chrono::duration<double>>(end - begin).count();
+    std::cout << seconds * 1e9 / numBatches << " ns per batch, "
+              << seconds * 1e9 / numBatches / numRows << " ns per row" << std::endl;
+
+    if (sum != expectedSum) {
+        std::cout << "FAILED: sum is " << sum << " instead of " << expectedSum << std::endl;
+        return 1;
+    }
+    std::cout << "SUCCESS" << std::endl;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,167 @@
+#ifndef TUPLE_SET_SELECTION_TEST_CC
+#define TUPLE_SET_SELECTION_TEST_CC
+
+// Test and benchmark for the selection vectors of TupleSets.
+// It runs two chained FilterExecutors over batches of a TupleSet with a few columns, so that the
+// filters only leave a selection vector, compacts the output as the pipeline does before a sink,
+// and checks it against filtering every column with TupleSet::filterColumn, as the filters did
+// before. It also checks that a compacted TupleSet keeps its columnar view in line. It then
+// reports the time per batch of both ways to filter.
+//
+// usage: tupleSetSelectionTest [numRowsPerBatch] [numBatches] [numExtraColumns]
+
+#include "TupleSpec.h"
+#include "Ptr.h"
+#include "ComputeInfo.h"
+#include "TupleSet.h"
+#include "FilterExecutor.h"
+
+#include <chrono>
+#include <vector>
+#include <string>
+#include <stdlib.h>
+#include <iostream>
+
+using namespace pdb;
+
+// builds a TupleSpec with the given attributes
+TupleSpec makeSpec(std::string setName, std::vector<std::string> atts) {
+    AttList attList;
+    for (auto& att : atts) {
+        attList.appendAttribute((char*)att.c_str());
+    }
+    return TupleSpec(setName, attList);
+}
+
+int main(int argc, char* argv[]) {
+
+    int numRows = 1024;
+    int numBatches = 1000;
+    int numExtraColumns = 6;
+    if (argc > 1) {
+        numRows = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        numBatches = atoi(argv[2]);
+    }
+    if (argc > 3) {
+        numExtraColumns = atoi(argv[3]);
+    }
+    std::cout << "numRowsPerBatch=" << numRows << ", numBatches=" << numBatches
+              << ", numExtraColumns=" << numExtraColumns << std::endl;
+
+    // the input has a key, a value, the two filter predicates, and a few extra columns
+    std::vector<std::string> inputAtts = {"key", "value", "isEven", "isSmall"};
+    for (int i = 0; i < numExtraColumns; i++) {
+        inputAtts.push_back("extra" + std::to_string(i));
+    }
+    std::vector<std::string> firstOutputAtts = inputAtts;
+    firstOutputAtts.erase(firstOutputAtts.begin() + 2);
+    std::vector<std::string> secondOutputAtts = firstOutputAtts;
+    secondOutputAtts.erase(secondOutputAtts.begin() + 2);
+
+    TupleSpec inputSchema = makeSpec("input", inputAtts);
+    TupleSpec firstPredicate = makeSpec("input", {"isEven"});
+    TupleSpec firstOutput = makeSpec("input", firstOutputAtts);
+    TupleSpec firstSchema = makeSpec("filtered", firstOutputAtts);
+    TupleSpec secondPredicate = makeSpec("filtered", {"isSmall"});
+    TupleSpec secondOutput = makeSpec("filtered", secondOutputAtts);
+    FilterExecutor firstFilter(inputSchema, firstPredicate, firstOutput);
+    FilterExecutor secondFilter(firstSchema, secondPredicate, secondOutput);
+
+    TupleSetPtr input = std::make_shared<TupleSet>();
+    std::vector<int>* keys = new std::vector<int>(numRows);
+    std::vector<double>* values = new std::vector<double>(numRows);
+    std::vector<bool>* isEven = new std::vector<bool>(numRows);
+    std::vector<bool>* isSmall = new std::vector<bool>(numRows);
+    input->addColumn(0, keys, true);
+    input->addColumn(1, values, true);
+    input->addColumn(2, isEven, true);
+    input->addColumn(3, isSmall, true);
+    for (int i = 0; i < numExtraColumns; i++) {
+        input->addColumn(4 + i, new std::vector<long>(numRows, i), true);
+    }
+
+    int numErrors = 0;
+    double selectionSeconds = 0;
+    double filterSeconds = 0;
+    for (int batch = 0; batch < numBatches; batch++) {
+        for (int i = 0; i < numRows; i++) {
+            int key = batch * numRows + i;
+            (*keys)[i] = key;
+            (*values)[i] = key * 0.5;
+            (*isEven)[i] = (key % 2 == 0);
+            (*isSmall)[i] = ((key / 2) % 3 == 0);
+        }
+
+        // filter with selection vectors, and compact as the pipeline does before a sink
+        auto begin = std::chrono::high_resolution_clock::now();
+        TupleSetPtr output = secondFilter.process(firstFilter.process(input));
+        output->compact();
+        auto end = std::chrono::high_resolution_clock::now();
+        selectionSeconds +=
+            std::chrono::duration_cast<std::chrono::duration<double>>(end - begin).count();
+
+        // filter every column with each predicate
+        begin = std::chrono::high_resolution_clock::now();
+        TupleSetPtr expected = std::make_shared<TupleSet>();
+        for (int i = 0; i < input->getNumColumns(); i++) {
+            expected->copyColumn(input, i, i);
+        }
+        for (int i = 0; i < expected->getNumColumns(); i++) {
+            expected->filterColumn(i, *isEven);
+        }
+        std::vector<bool> isSmallAfterFirst = expected->getColumn<bool>(3);
+        for (int i = 0; i < expected->getNumColumns(); i++) {
+            expected->filterColumn(i, isSmallAfterFirst);
+        }
+        end = std::chrono::high_resolution_clock::now();
+        filterSeconds +=
+            std::chrono::duration_cast<std::chrono::duration<double>>(end - begin).count();
+
+        if (output->hasSelection() ||
+            (output->getNumColumns() != (int)secondOutputAtts.size()) ||
+            (output->getColumn<int>(0) != expected->getColumn<int>(0)) ||
+            (output->getColumn<double>(1) != expected->getColumn<double>(1)) ||
+            (output->getNumRows(2) != expected->getNumRows(4))) {
+            std::cout << "batch " << batch << " is filtered wrong" << std::endl;
+            numErrors++;
+        }
+    }
+    std::cout << "selection vectors: " << selectionSeconds * 1e6 / numBatches << " us per batch"
+              << std::endl;
+    std::cout << "filtering every column: " << filterSeconds * 1e6 / numBatches
+              << " us per batch" << std::endl;
+
+    // a filter only sets a selection vector, and keeps all rows of the columns
+    TupleSetPtr output = firstFilter.process(input);
+    std::shared_ptr<std::vector<uint32_t>> selection = output->getSelection();
+    if ((selection == nullptr) || (output->getNumSelectedRows(0) != (numRows + 1) / 2) ||
+        (output->getNumRows(0) != numRows)) {
+        std::cout << "the first filter didn't set a selection vector" << std::endl;
+        numErrors++;
+    }
+
+    // compacting a column with a columnar view also selects the rows of the view
+    TupleSetPtr viewed = std::make_shared<TupleSet>();
+    viewed->addColumn(0, new std::vector<int>(8, 0), true);
+    ColumnarViewPtr view = std::make_shared<ColumnarView>(100);
+    viewed->setColumnarView(0, view);
+    viewed->setSelection(std::make_shared<std::vector<uint32_t>>(std::vector<uint32_t>{1, 5, 6}));
+    viewed->compact();
+    view = viewed->getColumnarView(0);
+    if ((viewed->getNumRows(0) != 3) || (view->getRow(0) != 101) || (view->getRow(1) != 105) ||
+        (view->getRow(2) != 106)) {
+        std::cout << "the columnar view is not compacted with its column" << std::endl;
+        numErrors++;
+    }
+
+    if (numErrors > 0) {
+        std::cout << "FAILED with " << numErrors << " errors" << std::endl;
+        return 1;
+    }
+    std::cout << "SUCCESS" << std::endl;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,191 @@
+#ifndef ZONE_MAP_TEST_CC
+#define ZONE_MAP_TEST_CC
+
+// Test for per-page zone maps of PartitionedFile.
+// It appends pages to a PartitionedFile with a declared zone map attribute, records the zone map
+// of each page, reloads the file from its meta partition, and checks that range predicates skip
+// exactly the pages whose values can't match.
+//
+// usage: zoneMapTest [numPages] [numValuesPerPage]
+
+#include "PartitionedFile.h"
+#include "PageZoneMap.h"
+#include "PDBPage.h"
+#include "PDBLogger.h"
+
+#include <vector>
+#include <string>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <iostream>
+
+int main(int argc, char* argv[]) {
+
+    int numPages = 32;
+    int numValuesPerPage = 1000;
+    size_t pageSize = (size_t)(64) * (size_t)(1024);
+    if (argc > 1) {
+        numPages = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        numValuesPerPage = atoi(argv[2]);
+    }
+    std::cout << "numPages=" << numPages << ", numValuesPerPage=" << numValuesPerPage
+              << std::endl;
+
+    pdb::PDBLoggerPtr logger = make_shared<pdb::PDBLogger>("zoneMapTest.log");
+    std::string metaPath = "/tmp/zoneMapTest.meta";
+    std::vector<std::string> dataPaths;
+    dataPaths.push_back("/tmp/zoneMapTest.data0");
+    dataPaths.push_back("/tmp/zoneMapTest.data1");
+    remove(metaPath.c_str());
+    for (auto path : dataPaths) {
+        remove(path.c_str());
+    }
+
+    PartitionedFilePtr file =
+        make_shared<PartitionedFile>(0, 1, 1, 1, metaPath, dataPaths, logger, pageSize);
+    ZoneMapAttribute attribute;
+    attribute.name = "orderKey";
+    attribute.byteOffset = 8;
+    attribute.type = ZoneMapLong;
+    attribute.columnar = false;
+    if (file->addZoneMapAttribute(attribute) == false) {
+        std::cout << "can't declare zone map attribute, exit..." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    if (file->addZoneMapAttribute(attribute) == true) {
+        std::cout << "declared the same zone map attribute twice, exit..." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    // page i holds the keys in [i * numValuesPerPage, (i + 1) * numValuesPerPage), like a set
+    // loaded in key order, and every 8th page also holds a null
+    char* data = nullptr;
+    if (posix_memalign((void**)&data, 512, pageSize) != 0) {
+        std::cout << "can't allocate page, exit..." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    memset(data, 0, pageSize);
+    for (int i = 0; i < numPages; i++) {
+        PDBPagePtr page = make_shared<PDBPage>(data, 0, 1, 1, 1, i, pageSize, 0, 0, 0);
+        page->preparePage();
+        int ret = file->appendPage(i % 2, page);
+        if (ret < 0) {
+            std::cout << "can't append page " << i << ", exit..." << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        page->setRawBytes(nullptr);
+        PageZoneMap zoneMap = PageSummarizer::getEmptyZoneMap();
+        for (int j = 0; j < numValuesPerPage; j++) {
+            PageSummarizer::addValue(zoneMap, (double)((long)i * numValuesPerPage + j));
+        }
+        if (i % 8 == 0) {
+            zoneMap.numNulls++;
+        }
+        std::vector<PageZoneMap> zoneMaps;
+        zoneMaps.push_back(zoneMap);
+        file->getMetaData()->addPageZoneMaps(i % 2, ret, zoneMaps);
+    }
+    free(data);
+    file->writeMeta();
+    file = nullptr;
+
+    // reload the file from the meta partition
+    file = make_shared<PartitionedFile>(0, 1, 1, 1, metaPath, logger);
+    file->buildMetaDataFromMetaPartition(nullptr);
+    file->initializeDataFiles();
+    file->openData();
+    PartitionedFileMetaDataPtr meta = file->getMetaData();
+    int numErrors = 0;
+    int attributeIndex = meta->getZoneMapAttributeIndex("orderKey");
+    if ((attributeIndex != 0) || (meta->getZoneMapAttributes().at(0).byteOffset != 8) ||
+        (meta->getZoneMapAttributes().at(0).type != ZoneMapLong)) {
+        std::cout << "zone map attribute is not reloaded" << std::endl;
+        numErrors++;
+    }
+    if (meta->getZoneMapAttributeIndex("partKey") != -1) {
+        std::cout << "undeclared zone map attribute is found" << std::endl;
+        numErrors++;
+    }
+
+    // count the pages a scan with each predicate would load
+    long key = (long)(numPages / 2) * numValuesPerPage + numValuesPerPage / 2;
+    ZoneMapComparisonOp ops[] = {
+        ZoneMapLessThan, ZoneMapLessEqual, ZoneMapEqual, ZoneMapGreaterEqual, ZoneMapGreaterThan};
+    int expected[] = {numPages / 2 + 1, numPages / 2 + 1, 1, numPages / 2, numPages / 2};
+    for (int k = 0; k < 5; k++) {
+        int numLoadedPages = 0;
+        for (int i = 0; i < numPages; i++) {
+            if (meta->mayMatch(i % 2, i / 2, attributeIndex, ops[k], (double)key) == true) {
+                numLoadedPages++;
+            }
+        }
+        std::cout << "op=" << ops[k] << ", loaded pages=" << numLoadedPages << std::endl;
+        if (numLoadedPages != expected[k]) {
+            std::cout << "expected " << expected[k] << " pages to load" << std::endl;
+            numErrors++;
+        }
+    }
+    // pages without zone maps, or predicates on undeclared attributes, never skip pages
+    if ((meta->mayMatch(0, numPages, attributeIndex, ZoneMapEqual, -1) == false) ||
+        (meta->mayMatch(0, 0, -1, ZoneMapEqual, -1) == false)) {
+        std::cout << "skipped a page that is not summarized" << std::endl;
+        numErrors++;
+    }
+
+    // check the distinct value estimate of a page with few distinct values
+    PageZoneMap zoneMap = PageSummarizer::getEmptyZoneMap();
+    for (int j = 0; j < numValuesPerPage; j++) {
+        PageSummarizer::addValue(zoneMap, (double)(j % 5));
+    }
+    double numDistinctValues = PageSummarizer::getEstimatedNumDistinctValues(zoneMap);
+    std::cout << "estimated distinct values=" << numDistinctValues << std::endl;
+    if ((numDistinctValues < 1) || (numDistinctValues > 10)) {
+        std::cout << "bad distinct value estimate" << std::endl;
+        numErrors++;
+    }
+
+    // NaNs, which the tree's -ffast-math must not hide, are counted as nulls and never become the
+    // bounds of a zone map, also when a page starts with one; they are made from their bits, as
+    // a scan reads them from a page
+    uint64_t nanBits = 0x7ff8000000000000ULL;
+    double nan;
+    memcpy(&nan, &nanBits, sizeof(double));
+    uint32_t floatNanBits = 0x7fc00001U;
+    float floatNan;
+    memcpy(&floatNan, &floatNanBits, sizeof(float));
+    zoneMap = PageSummarizer::getEmptyZoneMap();
+    PageSummarizer::addValue(zoneMap, nan);
+    for (int j = 1; j <= 10; j++) {
+        PageSummarizer::addValue(zoneMap, (double)j);
+        PageSummarizer::addValue(zoneMap, (j % 2 == 0) ? -nan : (double)floatNan);
+    }
+    std::cout << "zone map with NaNs: min=" << zoneMap.minValue << ", max=" << zoneMap.maxValue
+              << ", values=" << zoneMap.numValues << ", nulls=" << zoneMap.numNulls << std::endl;
+    if ((zoneMap.numNulls != 11) || (zoneMap.numValues != 10) || (zoneMap.minValue != 1) ||
+        (zoneMap.maxValue != 10) ||
+        (PageSummarizer::mayMatch(zoneMap, ZoneMapEqual, 5) == false) ||
+        (PageSummarizer::mayMatch(zoneMap, ZoneMapGreaterThan, 10.5) == true) ||
+        (PageSummarizer::mayMatch(zoneMap, ZoneMapLessThan, 0.5) == true)) {
+        std::cout << "NaNs corrupt the zone map" << std::endl;
+        numErrors++;
+    }
+    zoneMap = PageSummarizer::getEmptyZoneMap();
+    PageSummarizer::addValue(zoneMap, nan);
+    if ((zoneMap.numValues != 0) || (PageSummarizer::mayMatch(zoneMap, ZoneMapEqual, 0) == true)) {
+        std::cout << "a page of NaNs may match" << std::endl;
+        numErrors++;
+    }
+
+    file->clear();
+    if (numErrors > 0) {
+        std::cout << "FAILED with " << numErrors << " errors" << std::endl;
+        return 1;
+    }
+    std::cout << "SUCCESS" << std::endl;
+    return 0;
+}
+
+#endif
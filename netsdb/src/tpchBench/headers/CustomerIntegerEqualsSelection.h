@@ -0,0 +1,32 @@
+#ifndef CUSTOMER_INTEGER_EQUALS_SELECT_H
+#define CUSTOMER_INTEGER_EQUALS_SELECT_H
+
+#include "Lambda.h"
+#include "LambdaCreationFunctions.h"
+#include "SelectionComp.h"
+
+#include "Customer.h"
+
+using namespace pdb;
+class CustomerIntegerEqualsSelection : public SelectionComp<Customer, Customer> {
+
+public:
+    ENABLE_DEEP_COPY
+
+    CustomerIntegerEqualsSelection() {}
+
+    // Select the Customer Objects whose custKey equals their nationKey; the two members are
+    // compared with the vectorized kernels of EqualsLambda
+    Lambda<bool> getSelection(Handle<Customer> checkMe) override {
+        return makeLambdaFromMember(checkMe, custKey) == makeLambdaFromMember(checkMe, nationKey);
+    }
+
+    // Return the Customer object
+    Lambda<Handle<Customer>> getProjection(Handle<Customer> checkMe) override {
+
+        return makeLambda(checkMe, [](Handle<Customer>& checkMe) {
+            return checkMe;
+        });
+    }
+};
+#endif
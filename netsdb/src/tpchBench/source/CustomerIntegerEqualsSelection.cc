@@ -0,0 +1,9 @@
+#ifndef CUSTOMER_INTEGER_EQUALS_SELECT_CC
+#define CUSTOMER_INTEGER_EQUALS_SELECT_CC
+
+#include "CustomerIntegerEqualsSelection.h"
+#include "GetVTable.h"
+
+GET_V_TABLE(CustomerIntegerEqualsSelection)
+
+#endif
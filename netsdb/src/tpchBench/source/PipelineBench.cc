@@ -40,6 +40,7 @@
 #include "CustomerIntegerSelectionVirtual.h"
 #include "CustomerIntegerSelectionNot.h"
 #include "CustomerIntegerSelectionVirtualNot.h"
+#include "CustomerIntegerEqualsSelection.h"
 #include "Handle.h"
 #include "Lambda.h"
 #include "LambdaCreationFunctions.h"
@@ -75,7 +76,7 @@ using namespace std;
 int main(int argc, char* argv[]) {
 
     if (argc < 6) { 
-        std::cout << "[Usage] #SelectionType (String/Integer) #SelectionRatio (low/high) #virtualOrNot (Y/N)  #batchSize #printResultOrNot (Y/N)" << std::endl;
+        std::cout << "[Usage] #SelectionType (String/Integer/IntegerEquals) #SelectionRatio (low/high) #virtualOrNot (Y/N)  #batchSize #printResultOrNot (Y/N)" << std::endl;
     }
 
 
@@ -148,9 +149,13 @@ int main(int argc, char* argv[]) {
         mySelection = makeObject<CustomerIntegerSelectionNot>();
     } else if ((SelectionType == "Integer") && (SelectionRatio == "high") && (virtualOrNot == true)) {
         mySelection = makeObject<CustomerIntegerSelectionVirtualNot>();
+    } else if ((SelectionType == "IntegerEquals") && (SelectionRatio == "low") && (virtualOrNot == false)) {
+        // the comparison kernels of EqualsLambda can be measured by starting the workers with
+        // PDB_SIMD_LEVEL=scalar, avx2 or avx512
+        mySelection = makeObject<CustomerIntegerEqualsSelection>();
     } else {
         std::cout << "error in program inputs" << std::endl;
-        std::cout << "[Usage] #SelectionType (String/Integer) #SelectionRatio (low/high) #virtualOrNot (Y/N)  #batchSize" << std::endl;
+        std::cout << "[Usage] #SelectionType (String/Integer/IntegerEquals) #SelectionRatio (low/high) #virtualOrNot (Y/N)  #batchSize" << std::endl;
         exit(1);
     }
 
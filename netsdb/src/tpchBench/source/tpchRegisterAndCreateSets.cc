@@ -175,6 +175,9 @@ int main(int argc, char* argv[]) {
     if (!pdbClient.registerType("libraries/libCustomerIntegerSelectionVirtualNot.so", errMsg))
         cout << "Not able to register type libCustomerIntegerSelectionVirtualNot. \n";
 
+    if (!pdbClient.registerType("libraries/libCustomerIntegerEqualsSelection.so", errMsg))
+        cout << "Not able to register type libCustomerIntegerEqualsSelection. \n";
+
 
     if (!pdbClient.registerType("libraries/libCustomerSupplierPartGroupBy.so", errMsg))
         cout << "Not able to register type libCustomerSupplierPartGroupBy.\n";